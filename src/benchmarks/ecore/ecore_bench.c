@@ -0,0 +1,106 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#define CHURN_ROUNDS 20
+#define _ECORE_BENCH_TIMES(Start, Repeat, Jump) (Start), ((Start) + ((Jump) * (Repeat))), (Jump)
+
+static Eina_Bool
+_bench_timer_cb(void *data EINA_UNUSED)
+{
+   return ECORE_CALLBACK_RENEW;
+}
+
+/* like connection inactivity timeouts: many long timers that keep being
+ * pushed back, some of them going away and new ones coming in.
+ */
+static void
+bench_timer_churn(int request)
+{
+   Ecore_Timer **timers;
+   int i, r;
+
+   timers = malloc(request * sizeof(Ecore_Timer *));
+   if (!timers) return;
+
+   srand(request);
+   for (i = 0; i < request; i++)
+     timers[i] = ecore_timer_add(30.0 + (rand() % 1000) / 100.0,
+                                 _bench_timer_cb, NULL);
+
+   for (r = 0; r < CHURN_ROUNDS; r++)
+     {
+        for (i = 0; i < request; i++)
+          {
+             int idx = rand() % request;
+
+             if ((i % 16) == 0)
+               {
+                  ecore_timer_del(timers[idx]);
+                  timers[idx] = ecore_timer_add(30.0 + (rand() % 1000) / 100.0,
+                                                _bench_timer_cb, NULL);
+               }
+             else
+               ecore_timer_reset(timers[idx]);
+          }
+        ecore_main_loop_iterate();
+     }
+
+   for (i = 0; i < request; i++)
+     ecore_timer_del(timers[i]);
+   free(timers);
+}
+
+/* many timers expiring together, each renewing itself */
+static void
+bench_timer_expire(int request)
+{
+   Ecore_Timer **timers;
+   int i, r;
+
+   timers = malloc(request * sizeof(Ecore_Timer *));
+   if (!timers) return;
+
+   for (i = 0; i < request; i++)
+     timers[i] = ecore_timer_loop_add(0.0, _bench_timer_cb, NULL);
+
+   for (r = 0; r < CHURN_ROUNDS; r++)
+     ecore_main_loop_iterate();
+
+   for (i = 0; i < request; i++)
+     ecore_timer_del(timers[i]);
+   free(timers);
+}
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+
+   if (argc != 2)
+     return -1;
+
+   ecore_init();
+
+   test = eina_benchmark_new("ecore_timer", argv[1]);
+   if (test)
+     {
+        eina_benchmark_register(test, "churn",
+                                EINA_BENCHMARK(bench_timer_churn),
+                                _ECORE_BENCH_TIMES(1000, 5, 10000));
+        eina_benchmark_register(test, "expire",
+                                EINA_BENCHMARK(bench_timer_expire),
+                                _ECORE_BENCH_TIMES(1000, 5, 10000));
+        eina_benchmark_run(test);
+        eina_benchmark_free(test);
+     }
+
+   ecore_shutdown();
+
+   return 0;
+}
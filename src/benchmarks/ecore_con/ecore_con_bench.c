@@ -0,0 +1,266 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_Con.h>
+
+#define CLIENT_THREADS 4
+#define _ECORE_CON_BENCH_TIMES(Start, Repeat, Jump) (Start), ((Start) + ((Jump) * (Repeat))), (Jump)
+
+static const char ping[] = "ping\n";
+static const char pong[] = "pong\n";
+
+typedef struct _Bench_Client
+{
+   struct sockaddr_in addr;
+   int count;
+} Bench_Client;
+
+static int clients_running = 0;
+
+static void
+_bench_client_done(void *data EINA_UNUSED)
+{
+   clients_running--;
+   if (clients_running == 0) ecore_main_loop_quit();
+}
+
+/* each connection is a short request/reply, like a health check. The
+ * client resets the connection so no TIME_WAIT piles up on either side.
+ */
+static void *
+_bench_client_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Bench_Client *bc = data;
+   struct linger lin = { 1, 0 };
+   char buf[sizeof(pong)];
+   int i;
+
+   for (i = 0; i < bc->count; i++)
+     {
+        ssize_t r, done = 0;
+        int fd;
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) break;
+
+        if ((connect(fd, (struct sockaddr *)&bc->addr, sizeof(bc->addr)) == 0) &&
+            (write(fd, ping, sizeof(ping) - 1) == sizeof(ping) - 1))
+          {
+             while (done < (ssize_t)sizeof(pong) - 1)
+               {
+                  r = read(fd, buf + done, sizeof(pong) - 1 - done);
+                  if (r <= 0) break;
+                  done += r;
+               }
+          }
+
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, &lin, sizeof(lin));
+        close(fd);
+     }
+
+   ecore_main_loop_thread_safe_call_async(_bench_client_done, NULL);
+   return NULL;
+}
+
+static void _bench_server_client_can_read(void *data, const Efl_Event *event);
+static void _bench_server_client_eos(void *data, const Efl_Event *event);
+
+EFL_CALLBACKS_ARRAY_DEFINE(bench_client_cbs,
+                           { EFL_IO_READER_EVENT_CAN_READ_CHANGED, _bench_server_client_can_read },
+                           { EFL_IO_READER_EVENT_EOS, _bench_server_client_eos });
+
+/* reading the reset may also emit "eos", only finish once */
+static void
+_bench_server_client_finish(Eo *client)
+{
+   efl_event_callback_array_del(client, bench_client_cbs(), NULL);
+   if (!efl_io_closer_closed_get(client))
+     efl_io_closer_close(client);
+   efl_unref(client);
+}
+
+static void
+_bench_server_client_can_read(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Eo *client = event->object;
+   char buf[64];
+   Eina_Rw_Slice rw_slice = { .mem = buf, .len = sizeof(buf) };
+   Eina_Slice slice = { .mem = pong, .len = sizeof(pong) - 1 };
+   Eina_Error err;
+
+   if (!efl_io_reader_can_read_get(client)) return;
+
+   err = efl_io_reader_read(client, &rw_slice);
+   if (err == EAGAIN) return;
+   if (err || (rw_slice.len == 0))
+     {
+        _bench_server_client_finish(client);
+        return;
+     }
+
+   efl_io_writer_write(client, &slice, NULL);
+}
+
+static void
+_bench_server_client_eos(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   _bench_server_client_finish(event->object);
+}
+
+static void
+_bench_server_client_add(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Eo *client = event->info;
+
+   efl_ref(client);
+   efl_event_callback_array_add(client, bench_client_cbs(), NULL);
+}
+
+static void
+_bench_server_setup(void *data EINA_UNUSED, Eo *server, unsigned int shard EINA_UNUSED)
+{
+   efl_event_callback_add(server, EFL_NET_SERVER_EVENT_CLIENT_ADD,
+                          _bench_server_client_add, NULL);
+}
+
+static void
+_bench_serving(void *data EINA_UNUSED, const Efl_Event *event EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+static void
+_bench_connect(const char *address, int request)
+{
+   Bench_Client bc[CLIENT_THREADS];
+   Eina_Thread threads[CLIENT_THREADS];
+   const char *port;
+   int i, started = 0;
+
+   port = strrchr(address, ':');
+   if (!port) return;
+
+   for (i = 0; i < CLIENT_THREADS; i++)
+     {
+        memset(&bc[i].addr, 0, sizeof(bc[i].addr));
+        bc[i].addr.sin_family = AF_INET;
+        bc[i].addr.sin_port = htons(atoi(port + 1));
+        bc[i].addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bc[i].count = request / CLIENT_THREADS;
+        if (i < (request % CLIENT_THREADS)) bc[i].count++;
+
+        if (!eina_thread_create(threads + i, EINA_THREAD_NORMAL, -1,
+                                _bench_client_thread, bc + i))
+          break;
+        started++;
+     }
+
+   /* the main loop serves in single mode and is woken by the clients */
+   clients_running = started;
+   if (started) ecore_main_loop_begin();
+
+   for (i = 0; i < started; i++)
+     eina_thread_join(threads[i]);
+}
+
+static void
+bench_single(int request)
+{
+   Eo *server;
+
+   server = efl_add(EFL_NET_SERVER_TCP_CLASS, efl_main_loop_get(),
+                    efl_net_server_fd_reuse_address_set(efl_added, EINA_TRUE));
+   if (!server) return;
+
+   _bench_server_setup(NULL, server, 0);
+   if (efl_net_server_serve(server, "127.0.0.1:0") == 0)
+     _bench_connect(efl_net_server_address_get(server), request);
+
+   efl_del(server);
+}
+
+static void
+_bench_sharded(int request, unsigned int shards)
+{
+   Eo *server;
+
+   server = efl_add(EFL_NET_SERVER_TCP_SHARDED_CLASS, efl_main_loop_get(),
+                    efl_net_server_tcp_sharded_shards_set(efl_added, shards),
+                    efl_net_server_tcp_sharded_shard_setup_set(efl_added, NULL, _bench_server_setup, NULL),
+                    efl_event_callback_add(efl_added, EFL_NET_SERVER_TCP_SHARDED_EVENT_SERVING, _bench_serving, NULL));
+   if (!server) return;
+
+   if (efl_net_server_tcp_sharded_serve(server, "127.0.0.1:0") == 0)
+     {
+        ecore_main_loop_begin();
+        if (efl_net_server_tcp_sharded_serving_get(server))
+          _bench_connect(efl_net_server_tcp_sharded_address_get(server), request);
+     }
+
+   efl_del(server);
+}
+
+static void
+bench_sharded_2(int request)
+{
+   _bench_sharded(request, 2);
+}
+
+static void
+bench_sharded_4(int request)
+{
+   _bench_sharded(request, 4);
+}
+
+static void
+bench_sharded_cpu(int request)
+{
+   _bench_sharded(request, eina_cpu_count());
+}
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+
+   if (argc != 2)
+     return -1;
+
+   ecore_init();
+   ecore_con_init();
+
+   test = eina_benchmark_new("ecore_con_accept", argv[1]);
+   if (test)
+     {
+        eina_benchmark_register(test, "single",
+                                EINA_BENCHMARK(bench_single),
+                                _ECORE_CON_BENCH_TIMES(1000, 5, 2000));
+        eina_benchmark_register(test, "sharded_2",
+                                EINA_BENCHMARK(bench_sharded_2),
+                                _ECORE_CON_BENCH_TIMES(1000, 5, 2000));
+        eina_benchmark_register(test, "sharded_4",
+                                EINA_BENCHMARK(bench_sharded_4),
+                                _ECORE_CON_BENCH_TIMES(1000, 5, 2000));
+        eina_benchmark_register(test, "sharded_cpu",
+                                EINA_BENCHMARK(bench_sharded_cpu),
+                                _ECORE_CON_BENCH_TIMES(1000, 5, 2000));
+        eina_benchmark_run(test);
+        eina_benchmark_free(test);
+     }
+
+   ecore_con_shutdown();
+   ecore_shutdown();
+
+   return 0;
+}
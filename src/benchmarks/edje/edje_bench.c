@@ -0,0 +1,159 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_Evas.h>
+#include <Edje.h>
+
+#define CELLS 40
+#define _EDJE_BENCH_TIMES(Start, Repeat, Jump) (Start), ((Start) + ((Jump) * (Repeat))), (Jump)
+
+static const char *edj_file = NULL;
+
+static Evas_Object *
+_bench_layout_new(Ecore_Evas **ee)
+{
+   Evas_Object *o;
+   int i;
+
+   *ee = ecore_evas_buffer_new(800, 600);
+   if (!*ee) return NULL;
+
+   o = edje_object_add(ecore_evas_get(*ee));
+   if (!edje_object_file_set(o, edj_file, "bench/grid"))
+     {
+        fprintf(stderr, "Could not load 'bench/grid' from %s\n", edj_file);
+        ecore_evas_free(*ee);
+        *ee = NULL;
+        return NULL;
+     }
+   for (i = 0; i < CELLS; i++)
+     {
+        Evas_Object *icon;
+        char buf[32];
+
+        icon = evas_object_rectangle_add(ecore_evas_get(*ee));
+        snprintf(buf, sizeof(buf), "c%d.icon", i);
+        edje_object_part_swallow(o, buf, icon);
+        snprintf(buf, sizeof(buf), "c%d.label", i);
+        edje_object_part_text_set(o, buf, "label");
+     }
+   evas_object_resize(o, 800, 600);
+   evas_object_show(o);
+   evas_smart_objects_calculate(ecore_evas_get(*ee));
+
+   return o;
+}
+
+/* Change one label, only that text and its shadow depend on it. */
+static void
+bench_recalc_one_part(int request)
+{
+   Ecore_Evas *ee;
+   Evas_Object *o;
+   int i;
+
+   o = _bench_layout_new(&ee);
+   if (!o) return;
+
+   for (i = 0; i < request; i++)
+     {
+        edje_object_part_text_set(o, "c20.label", (i & 1) ? "one" : "two");
+        evas_smart_objects_calculate(ecore_evas_get(ee));
+     }
+
+   ecore_evas_free(ee);
+}
+
+/* Same change, but forcing the whole collection to be walked again. */
+static void
+bench_recalc_all_parts(int request)
+{
+   Ecore_Evas *ee;
+   Evas_Object *o;
+   int i;
+
+   o = _bench_layout_new(&ee);
+   if (!o) return;
+
+   for (i = 0; i < request; i++)
+     {
+        edje_object_part_text_set(o, "c20.label", (i & 1) ? "one" : "two");
+        edje_object_calc_force(o);
+     }
+
+   ecore_evas_free(ee);
+}
+
+/* Create many instances of the same group, the way item lists do. */
+static void
+bench_instantiate(int request)
+{
+   Ecore_Evas *ee;
+   Evas_Object **objs;
+   int i;
+
+   ee = ecore_evas_buffer_new(800, 600);
+   if (!ee) return;
+   objs = calloc(request, sizeof (Evas_Object *));
+   if (!objs) goto end;
+
+   for (i = 0; i < request; i++)
+     {
+        objs[i] = edje_object_add(ecore_evas_get(ee));
+        edje_object_file_set(objs[i], edj_file, "bench/grid");
+     }
+   for (i = 0; i < request; i++)
+     evas_object_del(objs[i]);
+
+   free(objs);
+ end:
+   ecore_evas_free(ee);
+}
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+
+   if (argc != 3)
+     return -1;
+
+   edj_file = argv[2];
+
+   ecore_evas_init();
+   edje_init();
+
+   test = eina_benchmark_new("edje_recalc", argv[1]);
+   if (test)
+     {
+        eina_benchmark_register(test, "one_part",
+                                EINA_BENCHMARK(bench_recalc_one_part),
+                                _EDJE_BENCH_TIMES(100, 10, 500));
+        eina_benchmark_register(test, "all_parts",
+                                EINA_BENCHMARK(bench_recalc_all_parts),
+                                _EDJE_BENCH_TIMES(100, 10, 500));
+        eina_benchmark_run(test);
+        eina_benchmark_free(test);
+     }
+
+   test = eina_benchmark_new("edje_instantiate", argv[1]);
+   if (test)
+     {
+        eina_benchmark_register(test, "same_group",
+                                EINA_BENCHMARK(bench_instantiate),
+                                _EDJE_BENCH_TIMES(10, 10, 50));
+        eina_benchmark_run(test);
+        eina_benchmark_free(test);
+     }
+
+   edje_shutdown();
+   ecore_evas_shutdown();
+
+   return 0;
+}
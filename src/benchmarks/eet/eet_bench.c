@@ -0,0 +1,266 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <Eina.h>
+#include <Emile.h>
+#include <Eet.h>
+
+#define SAMPLES 1024
+#define _EET_BENCH_TIMES(Start, Repeat, Jump) (Start), ((Start) + ((Jump) * (Repeat))), (Jump)
+
+static Eina_Array *samples = NULL;
+static Eina_Binbuf *dict = NULL;
+
+/* Small, very alike entries, the kind of thing edje_cc writes for every
+ * group of a theme. */
+static void
+_bench_samples_init(void)
+{
+   char buf[256];
+   int i;
+
+   samples = eina_array_new(64);
+   for (i = 0; i < SAMPLES; i++)
+     {
+        Eina_Binbuf *sample = eina_binbuf_new();
+        int size;
+
+        size = snprintf(buf, sizeof(buf),
+                        "collections { group { name: \"elm/button/base/%i\"; "
+                        "parts { image { \"bg\"; desc { image.normal: \"bt_%i.png\"; "
+                        "color: %i %i %i 255; rel1.offset: %i %i; } } } } }",
+                        i, i % 7, i & 0xff, (i * 3) & 0xff, (i * 7) & 0xff,
+                        i % 5, i % 3);
+        eina_binbuf_append_length(sample, (unsigned char *)buf, size + 1);
+        eina_array_push(samples, sample);
+     }
+
+   dict = emile_compress_dict_train(EMILE_ZSTD, samples, 16 * 1024);
+}
+
+static void
+_bench_samples_shutdown(void)
+{
+   while (eina_array_count(samples))
+     eina_binbuf_free(eina_array_pop(samples));
+   eina_array_free(samples);
+   eina_binbuf_free(dict);
+}
+
+static void
+_bench_write(const char *file, int request, int comp, Eina_Bool use_dict)
+{
+   Eet_File *ef;
+   char key[64];
+   int i;
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   if (!ef) return;
+
+   if (use_dict && dict)
+     eet_compression_dict_set(ef, eina_binbuf_string_get(dict),
+                              eina_binbuf_length_get(dict));
+
+   for (i = 0; i < request; i++)
+     {
+        Eina_Binbuf *sample = eina_array_data_get(samples, i % SAMPLES);
+
+        snprintf(key, sizeof(key), "edje/collections/%i", i);
+        eet_write(ef, key, eina_binbuf_string_get(sample),
+                  eina_binbuf_length_get(sample), comp);
+     }
+
+   eet_close(ef);
+}
+
+static void
+_bench_read(const char *file, int request)
+{
+   Eet_File *ef;
+   char key[64];
+   int i;
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   if (!ef) return;
+
+   for (i = 0; i < request; i++)
+     {
+        void *data;
+        int size;
+
+        snprintf(key, sizeof(key), "edje/collections/%i", i);
+        data = eet_read(ef, key, &size);
+        free(data);
+     }
+
+   eet_close(ef);
+}
+
+static void
+_bench_write_read(int request, int comp, Eina_Bool use_dict)
+{
+   char file[] = "/tmp/eet_benchXXXXXX";
+   int fd;
+
+   fd = mkstemp(file);
+   if (fd < 0) return;
+   close(fd);
+
+   _bench_write(file, request, comp, use_dict);
+   _bench_read(file, request);
+
+   unlink(file);
+}
+
+static void
+bench_zlib(int request)
+{
+   _bench_write_read(request, EET_COMPRESSION_DEFAULT, EINA_FALSE);
+}
+
+static void
+bench_lz4(int request)
+{
+   _bench_write_read(request, EET_COMPRESSION_SUPERFAST, EINA_FALSE);
+}
+
+static void
+bench_lz4hc(int request)
+{
+   _bench_write_read(request, EET_COMPRESSION_VERYFAST, EINA_FALSE);
+}
+
+static void
+bench_zstd(int request)
+{
+   _bench_write_read(request, EET_COMPRESSION_ZSTD, EINA_FALSE);
+}
+
+static void
+bench_zstd_dict(int request)
+{
+   _bench_write_read(request, EET_COMPRESSION_ZSTD, EINA_TRUE);
+}
+
+/* Page faults taken to open a theme sized file and read all of it, the
+ * count that eina_file mapping policies are about. The file is dropped from
+ * the page cache first when possible so that major faults show up too.
+ * Each run gets its own process as eina only looks at EINA_FILE_NOADVISE
+ * when it starts. */
+static void
+_bench_faults_run(Eina_Bool advise)
+{
+   char file[] = "/tmp/eet_benchXXXXXX";
+   struct rusage before, after;
+   int fd;
+
+   if (advise) unsetenv("EINA_FILE_NOADVISE");
+   else setenv("EINA_FILE_NOADVISE", "1", 1);
+
+   eet_init();
+   _bench_samples_init();
+
+   fd = mkstemp(file);
+   if (fd < 0) goto end;
+   close(fd);
+
+   _bench_write(file, 8 * 4096, EET_COMPRESSION_NONE, EINA_FALSE);
+
+#ifdef HAVE_POSIX_FADVISE
+   fd = open(file, O_RDONLY);
+   if (fd >= 0)
+     {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+     }
+#endif
+
+   getrusage(RUSAGE_SELF, &before);
+   _bench_read(file, 8 * 4096);
+   getrusage(RUSAGE_SELF, &after);
+
+   printf("eet_read_faults (advise %s): minor %li major %li\n",
+          advise ? "on" : "off",
+          after.ru_minflt - before.ru_minflt,
+          after.ru_majflt - before.ru_majflt);
+
+   unlink(file);
+
+ end:
+   _bench_samples_shutdown();
+   eet_shutdown();
+}
+
+static void
+_bench_faults_report(void)
+{
+   Eina_Bool advise[] = { EINA_FALSE, EINA_TRUE };
+   unsigned int i;
+
+   for (i = 0; i < sizeof (advise) / sizeof (advise[0]); i++)
+     {
+        pid_t pid;
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0)
+          {
+             _bench_faults_run(advise[i]);
+             fflush(stdout);
+             _exit(0);
+          }
+        if (pid > 0) waitpid(pid, NULL, 0);
+     }
+}
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+
+   if (argc != 2)
+     return -1;
+
+   /* before anything is initialized, see _bench_faults_run() */
+   _bench_faults_report();
+
+   eet_init();
+   _bench_samples_init();
+
+   test = eina_benchmark_new("eet_small_entries", argv[1]);
+   if (test)
+     {
+        eina_benchmark_register(test, "zlib",
+                                EINA_BENCHMARK(bench_zlib),
+                                _EET_BENCH_TIMES(100, 10, 500));
+        eina_benchmark_register(test, "lz4",
+                                EINA_BENCHMARK(bench_lz4),
+                                _EET_BENCH_TIMES(100, 10, 500));
+        eina_benchmark_register(test, "lz4hc",
+                                EINA_BENCHMARK(bench_lz4hc),
+                                _EET_BENCH_TIMES(100, 10, 500));
+        eina_benchmark_register(test, "zstd",
+                                EINA_BENCHMARK(bench_zstd),
+                                _EET_BENCH_TIMES(100, 10, 500));
+        if (dict)
+          eina_benchmark_register(test, "zstd_dict",
+                                  EINA_BENCHMARK(bench_zstd_dict),
+                                  _EET_BENCH_TIMES(100, 10, 500));
+        eina_benchmark_run(test);
+        eina_benchmark_free(test);
+     }
+
+   _bench_samples_shutdown();
+   eet_shutdown();
+
+   return 0;
+}
@@ -46,6 +46,8 @@ static const Eina_Benchmark_Case etc[] = {
    { "Sort", eina_bench_sort, EINA_TRUE },
    { "Mempool", eina_bench_mempool, EINA_TRUE },
    { "Rectangle_Pool", eina_bench_rectangle_pool, EINA_TRUE },
+   { "Strbuf", eina_bench_strbuf, EINA_TRUE },
+   { "Promise", eina_bench_promise, EINA_TRUE },
    { "Render Loop", eina_bench_quadtree, EINA_FALSE },
    { NULL, NULL, EINA_FALSE }
 };
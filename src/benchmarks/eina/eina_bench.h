@@ -33,6 +33,7 @@ void eina_bench_convert(Eina_Benchmark *bench);
 void eina_bench_sort(Eina_Benchmark *bench);
 void eina_bench_mempool(Eina_Benchmark *bench);
 void eina_bench_rectangle_pool(Eina_Benchmark *bench);
+void eina_bench_strbuf(Eina_Benchmark *bench);
 void eina_bench_quadtree(Eina_Benchmark *bench);
 void eina_bench_promise(Eina_Benchmark *bench);
 
@@ -0,0 +1,251 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/* Futures are resolved from a scheduler that runs the whole batch queued
+ * since the last dispatch, like the main loop does on idle enter. */
+#define BATCH 256
+
+typedef struct _Bench_Entry Bench_Entry;
+struct _Bench_Entry
+{
+   Eina_Future_Schedule_Entry base;
+   Eina_Future_Scheduler_Cb cb;
+   Eina_Future *future;
+   Eina_Value value;
+   Bench_Entry *next;
+   Eina_Bool recalled : 1;
+};
+
+static Bench_Entry *_queue = NULL;
+static Bench_Entry *_queue_last = NULL;
+static Eina_Trash *_entries_trash = NULL;
+
+#ifdef __GLIBC__
+/* Count every allocation done while the futures run, the bench interposes
+ * the libc allocator for all the libraries it links to. */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long _allocs = 0;
+
+void *
+malloc(size_t size)
+{
+   _allocs++;
+   return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+   _allocs++;
+   return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+   _allocs++;
+   return __libc_realloc(ptr, size);
+}
+#endif
+
+static Eina_Future_Schedule_Entry *
+_bench_schedule(Eina_Future_Scheduler *scheduler,
+                Eina_Future_Scheduler_Cb cb,
+                Eina_Future *f,
+                Eina_Value value)
+{
+   Bench_Entry *entry;
+
+   entry = eina_trash_pop(&_entries_trash);
+   if (!entry) entry = malloc(sizeof (Bench_Entry));
+   if (!entry) return NULL;
+
+   entry->base.scheduler = scheduler;
+   entry->cb = cb;
+   entry->future = f;
+   entry->value = value;
+   entry->next = NULL;
+   entry->recalled = EINA_FALSE;
+
+   if (_queue_last) _queue_last->next = entry;
+   else _queue = entry;
+   _queue_last = entry;
+
+   return &entry->base;
+}
+
+static void
+_bench_recall(Eina_Future_Schedule_Entry *s_entry)
+{
+   Bench_Entry *entry = (Bench_Entry *)s_entry;
+
+   eina_value_flush(&entry->value);
+   entry->recalled = EINA_TRUE;
+}
+
+static Eina_Future_Scheduler _bench_scheduler = {
+   .schedule = _bench_schedule,
+   .recall = _bench_recall
+};
+
+static void
+_bench_dispatch(void)
+{
+   Bench_Entry *entry;
+
+   while (_queue)
+     {
+        entry = _queue;
+        _queue = NULL;
+        _queue_last = NULL;
+
+        while (entry)
+          {
+             Bench_Entry *next = entry->next;
+
+             if (!entry->recalled) entry->cb(entry->future, entry->value);
+             eina_trash_push(&_entries_trash, entry);
+             entry = next;
+          }
+     }
+}
+
+static void
+_bench_trash_flush(void)
+{
+   Bench_Entry *entry;
+
+   while ((entry = eina_trash_pop(&_entries_trash)))
+     free(entry);
+}
+
+static double
+_time_get(void)
+{
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + (((double)t.tv_nsec) / 1000000000.0);
+}
+
+static void
+_bench_report(const char *name, int futures, double t, unsigned long allocs)
+{
+   if ((futures <= 0) || (t <= 0.0)) return;
+#ifdef __GLIBC__
+   fprintf(stderr, "%s: %.0f futures/s, %.3f allocations/future\n",
+           name, futures / t, (double)allocs / futures);
+#else
+   (void)allocs;
+   fprintf(stderr, "%s: %.0f futures/s\n", name, futures / t);
+#endif
+}
+
+static unsigned long
+_bench_allocs_get(void)
+{
+#ifdef __GLIBC__
+   return _allocs;
+#else
+   return 0;
+#endif
+}
+
+static void
+_bench_cancel(void *data EINA_UNUSED, const Eina_Promise *dead EINA_UNUSED)
+{
+}
+
+static Eina_Value
+_bench_step(void *data EINA_UNUSED, const Eina_Value v,
+            const Eina_Future *dead EINA_UNUSED)
+{
+   return v;
+}
+
+/* A promise followed by a few steps, like an Efl.Model property fetch
+ * going through a couple of conversions. */
+static void
+eina_bench_promise_chain(int request)
+{
+   unsigned long allocs;
+   double t;
+   int i, j;
+
+   /* warm up the pools */
+   for (i = 0; i < BATCH; i++)
+     eina_future_then(eina_future_resolved(&_bench_scheduler, eina_value_int_init(i)),
+                      _bench_step, NULL, NULL);
+   _bench_dispatch();
+
+   allocs = _bench_allocs_get();
+   t = _time_get();
+   for (i = 0; i < request; i++)
+     {
+        Eina_Promise *p;
+        Eina_Future *f;
+
+        p = eina_promise_new(&_bench_scheduler, _bench_cancel, NULL);
+        f = eina_future_new(p);
+        for (j = 0; j < 4; j++)
+          f = eina_future_then(f, _bench_step, NULL, NULL);
+        eina_promise_resolve(p, eina_value_int_init(i));
+
+        if ((i % BATCH) == (BATCH - 1)) _bench_dispatch();
+     }
+   _bench_dispatch();
+   t = _time_get() - t;
+
+   _bench_report("promise chain", request * 5, t, _bench_allocs_get() - allocs);
+   _bench_trash_flush();
+}
+
+/* Already resolved futures with a single step, like efl_loop_job(). */
+static void
+eina_bench_promise_resolved(int request)
+{
+   unsigned long allocs;
+   double t;
+   int i;
+
+   for (i = 0; i < BATCH; i++)
+     eina_future_then(eina_future_resolved(&_bench_scheduler, eina_value_int_init(i)),
+                      _bench_step, NULL, NULL);
+   _bench_dispatch();
+
+   allocs = _bench_allocs_get();
+   t = _time_get();
+   for (i = 0; i < request; i++)
+     {
+        eina_future_then(eina_future_resolved(&_bench_scheduler, eina_value_int_init(i)),
+                         _bench_step, NULL, NULL);
+
+        if ((i % BATCH) == (BATCH - 1)) _bench_dispatch();
+     }
+   _bench_dispatch();
+   t = _time_get() - t;
+
+   _bench_report("resolved future", request * 2, t, _bench_allocs_get() - allocs);
+   _bench_trash_flush();
+}
+
+void eina_bench_promise(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "chain",
+                           EINA_BENCHMARK(
+                              eina_bench_promise_chain),    1000, 200000, 10000);
+   eina_benchmark_register(bench, "resolved",
+                           EINA_BENCHMARK(
+                              eina_bench_promise_resolved), 1000, 200000, 10000);
+}
@@ -0,0 +1,93 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/* The way markup and edje build a short string they throw away right
+ * after. */
+static void
+eina_bench_strbuf_short(int request)
+{
+   int i;
+
+   for (i = 0; i < request; ++i)
+     {
+        Eina_Strbuf *buf;
+
+        buf = eina_strbuf_new();
+        eina_strbuf_append(buf, "<font_size=");
+        eina_strbuf_append_printf(buf, "%i", i & 0x3f);
+        eina_strbuf_append_char(buf, '>');
+        eina_strbuf_free(buf);
+     }
+}
+
+/* Same, but keeping the result like eina_strbuf_release() users do. */
+static void
+eina_bench_strbuf_release(int request)
+{
+   int i;
+
+   for (i = 0; i < request; ++i)
+     {
+        Eina_Strbuf *buf;
+        char *s;
+
+        buf = eina_strbuf_new();
+        eina_strbuf_append(buf, "elm/button/base/");
+        eina_strbuf_append_printf(buf, "%i", i);
+        s = eina_strbuf_release(buf);
+        free(s);
+     }
+}
+
+/* Escaping a paragraph of text, a bit longer than the inline storage. */
+static void
+eina_bench_strbuf_escaped(int request)
+{
+   int i;
+
+   for (i = 0; i < request; ++i)
+     {
+        Eina_Strbuf *buf;
+
+        buf = eina_strbuf_new();
+        eina_strbuf_append_escaped(buf, "Some text with spaces, \"quotes\" and 'more' of them");
+        eina_strbuf_append_escaped(buf, " to get past the first allocation");
+        eina_strbuf_free(buf);
+     }
+}
+
+/* One buffer getting a lot of data appended, like a log or a file dump. */
+static void
+eina_bench_strbuf_big(int request)
+{
+   Eina_Strbuf *buf;
+   int i;
+
+   buf = eina_strbuf_new();
+   for (i = 0; i < request * 16; ++i)
+     eina_strbuf_append_length(buf, "0123456789abcdef0123456789abcdef", 32);
+   eina_strbuf_free(buf);
+}
+
+void eina_bench_strbuf(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "short",
+                           EINA_BENCHMARK(
+                              eina_bench_strbuf_short),   1000, 200000, 500);
+   eina_benchmark_register(bench, "release",
+                           EINA_BENCHMARK(
+                              eina_bench_strbuf_release), 1000, 200000, 500);
+   eina_benchmark_register(bench, "escaped",
+                           EINA_BENCHMARK(
+                              eina_bench_strbuf_escaped), 1000, 200000, 500);
+   eina_benchmark_register(bench, "big",
+                           EINA_BENCHMARK(
+                              eina_bench_strbuf_big),     1000, 200000, 500);
+}
@@ -0,0 +1,202 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Eldbus.h>
+
+#define BENCH_PATH "/org/enlightenment/Bench"
+#define BENCH_IFACE "org.enlightenment.Bench"
+#define BENCH_BYTES (64 * 1024)
+#define BENCH_PAIRS 64
+#define _ELDBUS_BENCH_TIMES(Start, Repeat, Jump) (Start), ((Start) + ((Jump) * (Repeat))), (Jump)
+
+/* both ends are the same connection, the signals go through the bus
+ * daemon and come back, run it with dbus-launch for a local daemon.
+ */
+static Eldbus_Connection *conn = NULL;
+static int received = 0;
+static int expected = 0;
+
+typedef struct _Bench_Bytes
+{
+   Eina_Value_Array bytes;
+} Bench_Bytes;
+
+typedef struct _Bench_Pair
+{
+   const char *key;
+   const char *value;
+} Bench_Pair;
+
+typedef struct _Bench_Map
+{
+   Eina_Value_Array pairs;
+} Bench_Map;
+
+static void
+_bench_signal_cb(void *data EINA_UNUSED, const Eldbus_Message *msg)
+{
+   Eina_Value *value;
+
+   value = eldbus_message_to_eina_value(msg);
+   if (value) eina_value_free(value);
+
+   received++;
+   if (received == expected) ecore_main_loop_quit();
+}
+
+static void
+_bench_run(const char *member, const char *signature, const Eina_Value *value, int request)
+{
+   Eldbus_Signal_Handler *handler;
+   int i;
+
+   handler = eldbus_signal_handler_add(conn, NULL, BENCH_PATH, BENCH_IFACE,
+                                       member, _bench_signal_cb, NULL);
+   if (!handler) return;
+
+   received = 0;
+   expected = 0;
+   for (i = 0; i < request; i++)
+     {
+        Eldbus_Message *msg;
+
+        msg = eldbus_message_signal_new(BENCH_PATH, BENCH_IFACE, member);
+        if (!msg) break;
+        if (!eldbus_message_from_eina_value(signature, msg, value))
+          {
+             eldbus_message_unref(msg);
+             break;
+          }
+        if (!eldbus_connection_send(conn, msg, NULL, NULL, -1)) break;
+        expected++;
+     }
+
+   if (expected > 0) ecore_main_loop_begin();
+
+   eldbus_signal_handler_del(handler);
+}
+
+static void
+bench_byte_array(int request)
+{
+   Eina_Value_Struct_Member members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Bench_Bytes, bytes)
+   };
+   Eina_Value_Struct_Desc desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      members,
+      EINA_C_ARRAY_LENGTH(members),
+      sizeof(Bench_Bytes)
+   };
+   Eina_Value *value;
+   Eina_Value bytes;
+   unsigned int i;
+
+   value = eina_value_struct_new(&desc);
+   if (!value) return;
+
+   eina_value_array_setup(&bytes, EINA_VALUE_TYPE_UCHAR, BENCH_BYTES);
+   for (i = 0; i < BENCH_BYTES; i++)
+     eina_value_array_append(&bytes, (unsigned char)i);
+   eina_value_struct_value_set(value, "bytes", &bytes);
+   eina_value_flush(&bytes);
+
+   _bench_run("Bytes", "ay", value, request);
+
+   eina_value_free(value);
+}
+
+static void
+bench_property_map(int request)
+{
+   Eina_Value_Struct_Member pair_members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_STRING, Bench_Pair, key),
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_STRING, Bench_Pair, value)
+   };
+   Eina_Value_Struct_Desc pair_desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      pair_members,
+      EINA_C_ARRAY_LENGTH(pair_members),
+      sizeof(Bench_Pair)
+   };
+   Eina_Value_Struct_Member members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Bench_Map, pairs)
+   };
+   Eina_Value_Struct_Desc desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      members,
+      EINA_C_ARRAY_LENGTH(members),
+      sizeof(Bench_Map)
+   };
+   Eina_Value *value;
+   Eina_Value pairs;
+   unsigned int i;
+
+   value = eina_value_struct_new(&desc);
+   if (!value) return;
+
+   eina_value_array_setup(&pairs, EINA_VALUE_TYPE_STRUCT, BENCH_PAIRS);
+   for (i = 0; i < BENCH_PAIRS; i++)
+     {
+        Eina_Value pair;
+        char key[32];
+
+        snprintf(key, sizeof(key), "property%u", i);
+        eina_value_struct_setup(&pair, &pair_desc);
+        eina_value_struct_set(&pair, "key", key);
+        eina_value_struct_set(&pair, "value", "some property value");
+        eina_value_array_append(&pairs, *(Eina_Value_Struct *)eina_value_memory_get(&pair));
+        eina_value_flush(&pair);
+     }
+   eina_value_struct_value_set(value, "pairs", &pairs);
+   eina_value_flush(&pairs);
+
+   _bench_run("Map", "a{ss}", value, request);
+
+   eina_value_free(value);
+}
+
+int
+main(int argc, char **argv)
+{
+   Eina_Benchmark *test;
+
+   if (argc != 2)
+     return -1;
+
+   eldbus_init();
+
+   conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
+   if (!conn)
+     {
+        fprintf(stderr, "no session bus, run with dbus-launch\n");
+        eldbus_shutdown();
+        return -1;
+     }
+
+   test = eina_benchmark_new("eldbus_message", argv[1]);
+   if (test)
+     {
+        eina_benchmark_register(test, "byte_array_64k",
+                                EINA_BENCHMARK(bench_byte_array),
+                                _ELDBUS_BENCH_TIMES(100, 5, 200));
+        eina_benchmark_register(test, "property_map",
+                                EINA_BENCHMARK(bench_property_map),
+                                _ELDBUS_BENCH_TIMES(100, 5, 200));
+        eina_benchmark_run(test);
+        eina_benchmark_free(test);
+     }
+
+   eldbus_connection_unref(conn);
+   eldbus_shutdown();
+
+   return 0;
+}
@@ -126,6 +126,7 @@ efl_main(void *data EINA_UNUSED, const Efl_Event *ev EINA_UNUSED)
    const char *part;
    int c;
    int items = 5000;
+   double build_time;
    Eina_Bool grid = EINA_FALSE;
 
    printf("Started on pid: %d\n", getpid());
@@ -160,11 +161,15 @@ efl_main(void *data EINA_UNUSED, const Efl_Event *ev EINA_UNUSED)
                  efl_ui_win_autodel_set(efl_added, EINA_TRUE)
                 );
    printf("Building %d objects\n", items);
+   build_time = ecore_time_get();
    if (grid)
      _build_grid(items);
    else
      _build_list(items);
+   build_time = ecore_time_get() - build_time;
    printf("Done!\n");
+   printf("Realized %d items in %f s (%f items/s)\n",
+          items, build_time, ((double)items / build_time));
    efl_gfx_entity_size_set(win, EINA_SIZE2D(500, 500));
 
    efl_event_callback_add(evas_object_evas_get(win), EFL_CANVAS_SCENE_EVENT_RENDER_POST, _first_frame_cb, collection);
@@ -30,11 +30,24 @@ _a_set(Eo *obj EINA_UNUSED, void *class_data, int a)
 
 EAPI EFL_VOID_FUNC_BODYV(simple_a_set, EFL_FUNC_CALL(a), int a);
 
+static int
+_a_get(const Eo *obj EINA_UNUSED, void *class_data)
+{
+   const Simple_Public_Data *pd = class_data;
+   return pd->a;
+}
+
+EAPI EFL_FUNC_BODY_CONST(simple_a_get, int, 0);
+/* same as simple_a_get(), but generated the way eolian does for @final classes */
+EAPI EFL_FUNC_BODY_CONST_FINAL(simple_a_direct_get, SIMPLE_CLASS, _a_get, int, 0);
+
 static Eina_Bool
 _class_initializer(Efl_Class *klass)
 {
    EFL_OPS_DEFINE(ops,
          EFL_OBJECT_OP_FUNC(simple_a_set, _a_set),
+         EFL_OBJECT_OP_FUNC(simple_a_get, _a_get),
+         EFL_OBJECT_OP_FUNC(simple_a_direct_get, _a_get),
          EFL_OBJECT_OP_FUNC(simple_other_call, _other_call),
    );
 
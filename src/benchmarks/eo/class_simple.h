@@ -7,6 +7,8 @@ typedef struct
 } Simple_Public_Data;
 
 EAPI void simple_a_set(Eo *self, int a);
+EAPI int simple_a_get(const Eo *self);
+EAPI int simple_a_direct_get(const Eo *self);
 /* Calls simple_other_call(other, obj) and then simple_other_call(obj, other)
  * for 'times' times in order to grow the call stack on other objects. */
 EAPI void simple_other_call(Eo*self, Eo *other, int times);
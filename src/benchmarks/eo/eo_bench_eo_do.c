@@ -19,6 +19,34 @@ bench_eo_do_simple(int request)
    efl_unref(obj);
 }
 
+static void
+bench_eo_do_get(int request)
+{
+   int i;
+   Eo *obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   simple_a_set(obj, 1);
+   for (i = 0 ; i < request ; i++)
+     {
+        simple_a_get(obj);
+     }
+
+   efl_unref(obj);
+}
+
+static void
+bench_eo_do_direct_get(int request)
+{
+   int i;
+   Eo *obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   simple_a_set(obj, 1);
+   for (i = 0 ; i < request ; i++)
+     {
+        simple_a_direct_get(obj);
+     }
+
+   efl_unref(obj);
+}
+
 static void
 bench_eo_do_two_objs(int request)
 {
@@ -96,6 +124,10 @@ void eo_bench_eo_do(Eina_Benchmark *bench)
 {
    eina_benchmark_register(bench, "simple",
          EINA_BENCHMARK(bench_eo_do_simple), _EO_BENCH_TIMES(1000, 10, 500000));
+   eina_benchmark_register(bench, "get",
+         EINA_BENCHMARK(bench_eo_do_get), _EO_BENCH_TIMES(1000, 10, 500000));
+   eina_benchmark_register(bench, "direct_get",
+         EINA_BENCHMARK(bench_eo_do_direct_get), _EO_BENCH_TIMES(1000, 10, 500000));
    eina_benchmark_register(bench, "super",
          EINA_BENCHMARK(bench_eo_do_super),  _EO_BENCH_TIMES(1000, 10, 500000));
    eina_benchmark_register(bench, "two_objs",
@@ -21,6 +21,10 @@ struct _Evas_Benchmark_Case
 static const Evas_Benchmark_Case etc[] = {
    { "Loader", evas_bench_loader, EINA_TRUE },
    { "Saver", evas_bench_saver, EINA_TRUE },
+   { "Yuv", evas_bench_yuv, EINA_TRUE },
+   { "Scale", evas_bench_scale, EINA_TRUE },
+   { "Map", evas_bench_map, EINA_TRUE },
+   { "Clip", evas_bench_clip, EINA_TRUE },
    { NULL, NULL, EINA_FALSE }
 };
 
@@ -5,6 +5,10 @@
 
 void evas_bench_loader(Eina_Benchmark *bench);
 void evas_bench_saver(Eina_Benchmark *bench);
+void evas_bench_yuv(Eina_Benchmark *bench);
+void evas_bench_scale(Eina_Benchmark *bench);
+void evas_bench_map(Eina_Benchmark *bench);
+void evas_bench_clip(Eina_Benchmark *bench);
 
 #endif
 
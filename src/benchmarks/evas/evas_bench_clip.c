@@ -0,0 +1,131 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "Evas.h"
+#include "Evas_Engine_Buffer.h"
+#include "evas_bench.h"
+
+#define OBJECTS 50000
+
+static Evas *
+_setup_evas(void)
+{
+   Evas *evas;
+   Evas_Engine_Info_Buffer *einfo;
+
+   evas = evas_new();
+
+   evas_output_method_set(evas, evas_render_method_lookup("buffer"));
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(evas);
+
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_RGB32;
+   einfo->info.dest_buffer = malloc(sizeof (char) * 500 * 500 * 4);
+   einfo->info.dest_buffer_row_bytes = 500 * sizeof (char) * 4;
+
+   evas_engine_info_set(evas, (Evas_Engine_Info *)einfo);
+
+   evas_output_size_set(evas, 500, 500);
+   evas_output_viewport_set(evas, 0, 0, 500, 500);
+
+   return evas;
+}
+
+/* OBJECTS small rectangles all clipped by the same clipper, like the
+ * members of a big smart object. */
+static Evas_Object *
+_setup_clipped(Evas *e, Evas_Object **objs)
+{
+   Evas_Object *clip;
+   int i;
+
+   clip = evas_object_rectangle_add(e);
+   evas_object_geometry_set(clip, 0, 0, 500, 500);
+   evas_object_show(clip);
+
+   for (i = 0; i < OBJECTS; i++)
+     {
+        objs[i] = evas_object_rectangle_add(e);
+        evas_object_geometry_set(objs[i], (i * 7) % 490, (i / 70) % 490, 10, 10);
+        evas_object_color_set(objs[i], i & 0xff, 0x80, 0x80, 0xff);
+        evas_object_clip_set(objs[i], clip);
+        evas_object_show(objs[i]);
+     }
+
+   return clip;
+}
+
+static void
+_teardown(Evas *e)
+{
+   Evas_Engine_Info_Buffer *einfo;
+
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(e);
+   free(einfo->info.dest_buffer);
+   evas_free(e);
+}
+
+/* Objects leaving and joining the clipper in no particular order, which
+ * used to walk the clipees list on each removal. */
+static void
+evas_bench_clip_churn(int request)
+{
+   Evas_Object **objs;
+   Evas_Object *clip;
+   Evas *e;
+   int i;
+
+   objs = malloc(OBJECTS * sizeof (Evas_Object *));
+   if (!objs) return;
+
+   e = _setup_evas();
+   clip = _setup_clipped(e, objs);
+
+   for (i = 0; i < request; i++)
+     {
+        Evas_Object *o = objs[(i * 7919) % OBJECTS];
+
+        evas_object_clip_unset(o);
+        evas_object_clip_set(o, clip);
+     }
+
+   _teardown(e);
+   free(objs);
+}
+
+/* Moving the clipper marks all its clipees dirty and rendering walks them
+ * again, the list is only read here. */
+static void
+evas_bench_clip_move(int request)
+{
+   Evas_Object **objs;
+   Evas_Object *clip;
+   Evas *e;
+   int i;
+
+   objs = malloc(OBJECTS * sizeof (Evas_Object *));
+   if (!objs) return;
+
+   e = _setup_evas();
+   clip = _setup_clipped(e, objs);
+   evas_render(e);
+
+   for (i = 0; i < request; i++)
+     {
+        evas_object_move(clip, i & 0xf, 0);
+        evas_render(e);
+     }
+
+   _teardown(e);
+   free(objs);
+}
+
+void evas_bench_clip(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "clip-churn-50k",
+                           EINA_BENCHMARK(evas_bench_clip_churn), 1000, 50000, 7000);
+   eina_benchmark_register(bench, "clip-move-render-50k",
+                           EINA_BENCHMARK(evas_bench_clip_move), 5, 50, 15);
+}
@@ -0,0 +1,101 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "evas_common_private.h"
+#include "evas_bench.h"
+
+static double
+_time_get(void)
+{
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + (((double)t.tv_nsec) / 1000000000.0);
+}
+
+/* a 4k image rotated by 30 degrees into a size x size box, the dynamic
+ * scale hint keeps it away from the scalecache and its mipmaps */
+static void
+_map_bench(const char *name, int size, Evas_Image_Scale_Hint hint, int request)
+{
+   RGBA_Image *src, *dst;
+   RGBA_Map_Point p[4];
+   double t, c, s, r;
+   int sw = 3840, sh = 2160;
+   int i;
+
+   src = evas_common_image_new(sw, sh, 1);
+   dst = evas_common_image_new(size, size, 1);
+   if ((!src) || (!dst)) goto end;
+   src->cache_entry.scale_hint = hint;
+
+   for (i = 0; i < sw * sh; i++)
+     {
+        DATA32 a = (i >> 4) & 0xff;
+
+        src->image.data[i] = (a << 24) | ((((i * 7) & 0xff) * a / 255) << 16) |
+          ((((i >> 3) & 0xff) * a / 255) << 8) | (((i ^ (i >> 9)) & 0xff) * a / 255);
+     }
+
+   memset(p, 0, sizeof(p));
+   c = cos(M_PI / 6.0);
+   s = sin(M_PI / 6.0);
+   r = (size / 2) * 0.9;
+   for (i = 0; i < 4; i++)
+     {
+        double x = ((i == 1) || (i == 2)) ? r : -r;
+        double y = (i < 2) ? -r * sh / sw : r * sh / sw;
+
+        p[i].x = (FPc)(((size / 2) + (x * c) - (y * s)) * FP1);
+        p[i].y = (FPc)(((size / 2) + (x * s) + (y * c)) * FP1);
+        p[i].u = (((i == 1) || (i == 2)) ? sw : 0) << FP;
+        p[i].v = ((i < 2) ? 0 : sh) << FP;
+        p[i].col = 0xffffffff;
+     }
+
+   t = _time_get();
+   for (i = 0; i < request; i++)
+     evas_common_map_rgba_draw(src, dst, 0, 0, size, size,
+                               0xffffffff, EVAS_RENDER_BLEND,
+                               4, p, 1, EINA_FALSE, 0, NULL, 0, 0);
+   t = _time_get() - t;
+
+   if (request > 0)
+     fprintf(stderr, "%s: %.2f ms/frame\n", name, (t * 1000.0) / request);
+
+ end:
+   if (dst) evas_cache_image_drop(&dst->cache_entry);
+   if (src) evas_cache_image_drop(&src->cache_entry);
+}
+
+static void
+evas_bench_map_down_4k(int request)
+{
+   _map_bench("map 4k -> 256 mipmapped", 256, EVAS_IMAGE_SCALE_HINT_NONE, request);
+}
+
+static void
+evas_bench_map_down_4k_nomip(int request)
+{
+   _map_bench("map 4k -> 256", 256, EVAS_IMAGE_SCALE_HINT_DYNAMIC, request);
+}
+
+static void
+evas_bench_map_down_half_4k(int request)
+{
+   _map_bench("map 4k -> 2048 mipmapped", 2048, EVAS_IMAGE_SCALE_HINT_NONE, request);
+}
+
+void evas_bench_map(Eina_Benchmark *bench)
+{
+   evas_common_init();
+
+   eina_benchmark_register(bench, "smooth-map-down-4k", EINA_BENCHMARK(evas_bench_map_down_4k), 10, 50, 10);
+   eina_benchmark_register(bench, "smooth-map-down-4k-nomip", EINA_BENCHMARK(evas_bench_map_down_4k_nomip), 10, 50, 10);
+   eina_benchmark_register(bench, "smooth-map-down-half-4k", EINA_BENCHMARK(evas_bench_map_down_half_4k), 5, 25, 5);
+}
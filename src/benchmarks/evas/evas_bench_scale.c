@@ -0,0 +1,82 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <time.h>
+
+#include "evas_common_private.h"
+#include "evas_bench.h"
+
+static double
+_time_get(void)
+{
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + (((double)t.tv_nsec) / 1000000000.0);
+}
+
+static void
+_scale_bench(const char *name, int sw, int sh, int dw, int dh, int request)
+{
+   RGBA_Image *src, *dst;
+   double t;
+   int i;
+
+   src = evas_common_image_new(sw, sh, 1);
+   dst = evas_common_image_new(dw, dh, 1);
+   if ((!src) || (!dst)) goto end;
+
+   for (i = 0; i < sw * sh; i++)
+     {
+        DATA32 a = (i >> 4) & 0xff;
+
+        /* premultiplied gradient with some noise */
+        src->image.data[i] = (a << 24) | ((((i * 7) & 0xff) * a / 255) << 16) |
+          ((((i >> 3) & 0xff) * a / 255) << 8) | (((i ^ (i >> 9)) & 0xff) * a / 255);
+     }
+
+   t = _time_get();
+   for (i = 0; i < request; i++)
+     evas_common_scale_rgba_smooth_draw(src, dst, 0, 0, dw, dh,
+                                        0xffffffff, EVAS_RENDER_BLEND,
+                                        0, 0, sw, sh, 0, 0, dw, dh,
+                                        NULL, 0, 0);
+   t = _time_get() - t;
+
+   if (request > 0)
+     fprintf(stderr, "%s: %.2f ms/frame\n", name, (t * 1000.0) / request);
+
+ end:
+   if (dst) evas_cache_image_drop(&dst->cache_entry);
+   if (src) evas_cache_image_drop(&src->cache_entry);
+}
+
+static void
+evas_bench_scale_up_4k(int request)
+{
+   _scale_bench("up 1080p -> 4k", 1920, 1080, 3840, 2160, request);
+}
+
+static void
+evas_bench_scale_down_4k(int request)
+{
+   _scale_bench("down 4k -> 720p", 3840, 2160, 1280, 720, request);
+}
+
+static void
+evas_bench_scale_down_half_4k(int request)
+{
+   _scale_bench("down 4k -> 1440p", 3840, 2160, 2560, 1440, request);
+}
+
+void evas_bench_scale(Eina_Benchmark *bench)
+{
+   /* the scalers use the image cache and the cpu features */
+   evas_common_init();
+
+   eina_benchmark_register(bench, "smooth-up-4k", EINA_BENCHMARK(evas_bench_scale_up_4k), 5, 25, 5);
+   eina_benchmark_register(bench, "smooth-down-4k", EINA_BENCHMARK(evas_bench_scale_down_4k), 5, 25, 5);
+   eina_benchmark_register(bench, "smooth-down-half-4k", EINA_BENCHMARK(evas_bench_scale_down_half_4k), 5, 25, 5);
+}
@@ -0,0 +1,111 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "evas_common_private.h"
+#include "evas_bench.h"
+
+#define YUV_W 1920
+#define YUV_H 1080
+
+typedef void (*Yuv_Convert)(DATA8 **src, DATA8 *dst, int w, int h);
+
+typedef enum _Yuv_Layout
+{
+   YUV_PACKED,
+   YUV_SEMI_PLANAR,
+   YUV_PLANAR
+} Yuv_Layout;
+
+/* one frame shared by all the cases, so that only the conversion is timed */
+static DATA8 *planes = NULL;
+static DATA8 *dst = NULL;
+
+static Eina_Bool
+_yuv_frame_init(void)
+{
+   int i;
+
+   if (planes) return EINA_TRUE;
+
+   /* packed rows are 2 bytes per pixel, planar ones 1.5 */
+   planes = malloc(YUV_W * YUV_H * 2);
+   dst = malloc(YUV_W * YUV_H * sizeof (DATA32));
+   if ((!planes) || (!dst))
+     {
+        free(planes);
+        free(dst);
+        planes = NULL;
+        dst = NULL;
+        return EINA_FALSE;
+     }
+
+   for (i = 0; i < YUV_W * YUV_H * 2; i++)
+     planes[i] = (i * 7) ^ (i >> 9);
+
+   return EINA_TRUE;
+}
+
+static void
+_yuv_bench(Yuv_Convert convert, Yuv_Layout layout, int request)
+{
+   DATA8 *rows[YUV_H * 2];
+   int i, n = 0;
+
+   if (!_yuv_frame_init()) return;
+
+   switch (layout)
+     {
+      case YUV_PACKED:
+         for (i = 0; i < YUV_H; i++) rows[n++] = planes + (i * YUV_W * 2);
+         break;
+      case YUV_SEMI_PLANAR:
+         for (i = 0; i < YUV_H; i++) rows[n++] = planes + (i * YUV_W);
+         for (i = 0; i < YUV_H / 2; i++) rows[n++] = planes + (YUV_W * YUV_H) + (i * YUV_W);
+         break;
+      case YUV_PLANAR:
+         for (i = 0; i < YUV_H; i++) rows[n++] = planes + (i * YUV_W);
+         for (i = 0; i < YUV_H; i++) rows[n++] = planes + (YUV_W * YUV_H) + (i * YUV_W / 2);
+         break;
+     }
+
+   for (i = 0; i < request; i++)
+     convert(rows, dst, YUV_W, YUV_H);
+}
+
+static void
+evas_bench_yuv_nv12(int request)
+{
+   _yuv_bench(evas_common_convert_yuv_420_601_rgba, YUV_SEMI_PLANAR, request);
+}
+
+static void
+evas_bench_yuv_yuy2(int request)
+{
+   _yuv_bench(evas_common_convert_yuv_422_601_rgba, YUV_PACKED, request);
+}
+
+static void
+evas_bench_yuv_yv12_601(int request)
+{
+   _yuv_bench(evas_common_convert_yuv_422p_601_rgba, YUV_PLANAR, request);
+}
+
+static void
+evas_bench_yuv_yv12_709(int request)
+{
+   _yuv_bench(evas_common_convert_yuv_422p_709_rgba, YUV_PLANAR, request);
+}
+
+void evas_bench_yuv(Eina_Benchmark *bench)
+{
+   /* the converters pick their SIMD row functions from the cpu features */
+   evas_common_cpu_init();
+
+   eina_benchmark_register(bench, "nv12-1080p", EINA_BENCHMARK(evas_bench_yuv_nv12), 10, 110, 20);
+   eina_benchmark_register(bench, "yuy2-1080p", EINA_BENCHMARK(evas_bench_yuv_yuy2), 10, 110, 20);
+   eina_benchmark_register(bench, "yv12-601-1080p", EINA_BENCHMARK(evas_bench_yuv_yv12_601), 10, 110, 20);
+   eina_benchmark_register(bench, "yv12-709-1080p", EINA_BENCHMARK(evas_bench_yuv_yv12_709), 10, 110, 20);
+}
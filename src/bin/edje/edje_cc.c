@@ -48,6 +48,8 @@ int min_quality = 0;
 int max_quality = 100;
 int compress_mode = EET_COMPRESSION_HI;
 int threads = 0;
+int threads_max = 0;
+int timings = 0;
 int annotate = 0;
 int no_etc1 = 0;
 int no_etc2 = 0;
@@ -132,8 +134,9 @@ main_help(void)
       "-Ddefine_val=to          CPP style define to define input macro definitions to the .edc source\n"
       "-fastcomp                Use a faster compression algorithm (LZ4) (mutually exclusive with -fastdecomp)\n"
       "-fastdecomp              Use a faster decompression algorithm (LZ4HC) (mutually exclusive with -fastcomp)\n"
-      "-threads                 Compile the edje file using multiple parallel threads (by default)\n"
+      "-threads [N]             Compile the edje file using multiple parallel threads, at most N at once (by default)\n"
       "-nothreads               Compile the edje file using only the main loop\n"
+      "-timings                 Print the time spent in each compilation phase\n"
       "-N                       Use the first segment of each group name as a namespace to verify parts/signals\n"
       "-V [--version]           show program version\n"
      , progname);
@@ -291,11 +294,22 @@ main(int argc, char **argv)
         else if (!strcmp(argv[i], "-threads"))
           {
              threads = 1;
+             if ((i < (argc - 1)) &&
+                 (argv[i + 1][0] >= '0') && (argv[i + 1][0] <= '9'))
+               {
+                  i++;
+                  threads_max = atoi(argv[i]);
+                  if (threads_max == 1) threads = 0;
+               }
           }
         else if (!strcmp(argv[i], "-nothreads"))
           {
              threads = 0;
           }
+        else if (!strcmp(argv[i], "-timings"))
+          {
+             timings = 1;
+          }
         else if (!strncmp(argv[i], "-D", 2))
           {
              defines = eina_list_append(defines, mem_strdup(argv[i]));
@@ -437,14 +451,18 @@ main(int argc, char **argv)
    ecore_evas_init();
 
    source_edd();
+   phase_begin(PHASE_PARSE);
    source_fetch();
 
    data_setup();
    compile();
+   phase_done(PHASE_PARSE);
+   phase_begin(PHASE_PROCESS);
    reorder_parts();
    data_process_scripts();
    data_process_lookups();
    data_process_script_lookups();
+   phase_done(PHASE_PROCESS);
    data_write();
 
    eina_prefix_free(pfx);
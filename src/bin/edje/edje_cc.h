@@ -209,9 +209,32 @@ typedef struct
    Edje_Part_Anchor fill;
 } Edje_Part_Description_Anchors;
 
+typedef enum
+{
+   PHASE_PARSE,
+   PHASE_PROCESS,
+   PHASE_GROUPS,
+   PHASE_SCRIPTS,
+   PHASE_LUA_SCRIPTS,
+   PHASE_SOURCE,
+   PHASE_FONTMAP,
+   PHASE_VECTORS,
+   PHASE_FONTS,
+   PHASE_SOUNDS,
+   PHASE_MO,
+   PHASE_VIBRATIONS,
+   PHASE_LICENSE,
+   PHASE_AUTHORS,
+   PHASE_IMAGES,
+   PHASE_HEADER,
+   PHASE_LAST
+} Compile_Phase;
+
 /* global fn calls */
 void    data_setup(void);
 void    data_write(void);
+void    phase_begin(Compile_Phase phase);
+void    phase_done(Compile_Phase phase);
 void    data_queue_face_group_lookup(const char *name);
 void    data_queue_group_lookup(const char *name, Edje_Part *part);
 void    data_queue_part_lookup(Edje_Part_Collection *pc, const char *name, int *dest);
@@ -342,6 +365,8 @@ extern New_Nested_Handler     nested_handlers[];
 extern New_Nested_Handler     nested_handlers_short[];
 extern int                    compress_mode;
 extern int                    threads;
+extern int                    threads_max;
+extern int                    timings;
 extern int                    annotate;
 extern Eina_Bool current_group_inherit;
 extern Eina_List             *color_tree_root;
@@ -210,6 +210,33 @@ typedef struct _Image_Unused_Ids Image_Unused_Ids;
 
 static int pending_threads = 0;
 static int pending_image_threads = 0;
+static int pending_commands_max = 0;
+
+static struct
+{
+   const char *name;
+   double      begin;
+   double      done;
+   int         jobs;
+} phases[PHASE_LAST] =
+{
+   [PHASE_PARSE] = { "parse", 0.0, 0.0, 0 },
+   [PHASE_PROCESS] = { "process", 0.0, 0.0, 0 },
+   [PHASE_GROUPS] = { "groups", 0.0, 0.0, 0 },
+   [PHASE_SCRIPTS] = { "scripts", 0.0, 0.0, 0 },
+   [PHASE_LUA_SCRIPTS] = { "lua scripts", 0.0, 0.0, 0 },
+   [PHASE_SOURCE] = { "source", 0.0, 0.0, 0 },
+   [PHASE_FONTMAP] = { "fontmap", 0.0, 0.0, 0 },
+   [PHASE_VECTORS] = { "vectors", 0.0, 0.0, 0 },
+   [PHASE_FONTS] = { "fonts", 0.0, 0.0, 0 },
+   [PHASE_SOUNDS] = { "sounds", 0.0, 0.0, 0 },
+   [PHASE_MO] = { "mo", 0.0, 0.0, 0 },
+   [PHASE_VIBRATIONS] = { "vibrations", 0.0, 0.0, 0 },
+   [PHASE_LICENSE] = { "license", 0.0, 0.0, 0 },
+   [PHASE_AUTHORS] = { "authors", 0.0, 0.0, 0 },
+   [PHASE_IMAGES] = { "images", 0.0, 0.0, 0 },
+   [PHASE_HEADER] = { "header", 0.0, 0.0, 0 },
+};
 
 static void data_process_string(Edje_Part_Collection *pc, const char *prefix, char *s, void (*func)(Edje_Part_Collection *pc, char *name, char *ptr, int len));
 
@@ -258,6 +285,70 @@ error_and_abort(Eet_File *ef EINA_UNUSED, const char *fmt, ...)
    exit(-1);
 }
 
+void
+phase_begin(Compile_Phase phase)
+{
+   if (phases[phase].begin > 0.0) return;
+   phases[phase].begin = phases[phase].done = ecore_time_get();
+}
+
+/* called from the main loop each time one job of the phase is finished,
+ * so the phase spans from the first dispatch to the last completion */
+void
+phase_done(Compile_Phase phase)
+{
+   phases[phase].done = ecore_time_get();
+   phases[phase].jobs++;
+}
+
+static void
+phase_report(double total)
+{
+   char buf[256];
+   int i;
+
+   if ((!timings) &&
+       (!eina_log_domain_level_check(_edje_cc_log_dom, EINA_LOG_LEVEL_INFO)))
+     return;
+
+   for (i = 0; i < PHASE_LAST; i++)
+     {
+        if (!phases[i].jobs) continue;
+        snprintf(buf, sizeof(buf), "%-12s %6i jobs %10.5f s",
+                 phases[i].name, phases[i].jobs,
+                 phases[i].done - phases[i].begin);
+        if (timings) printf("%s\n", buf);
+        else INF("%s", buf);
+     }
+   if (timings) printf("%-12s %6s      %10.5f s\n", "total", "", total);
+   else INF("total: %3.5f", total);
+}
+
+/* Worker threads finish in any order and eet keeps the order in which
+ * keys are first added, so when threaded put a placeholder for the key
+ * from the main loop before dispatching the job. The worker then only
+ * replaces the data and the output is the same from one build to the
+ * next. */
+static void
+data_key_reserve(Eet_File *ef, const char *fmt, ...)
+{
+   char buf[PATH_MAX];
+   va_list ap;
+
+   if (!threads) return;
+   va_start(ap, fmt);
+   vsnprintf(buf, sizeof(buf), fmt, ap);
+   va_end(ap);
+   eet_write(ef, buf, "", 1, EET_COMPRESSION_NONE);
+}
+
+/* for jobs that can fail without aborting, drop the placeholder again */
+static void
+data_key_release(Eet_File *ef, const char *key)
+{
+   if (threads) eet_delete(ef, key);
+}
+
 static void
 thread_end(Eina_Bool img)
 {
@@ -869,6 +960,7 @@ data_thread_head_end(void *data, Ecore_Thread *thread EINA_UNUSED)
         free(hw->errstr);
      }
    free(hw);
+   phase_done(PHASE_HEADER);
    thread_end(0);
 }
 
@@ -968,6 +1060,7 @@ data_thread_fonts_end(void *data, Ecore_Thread *thread EINA_UNUSED)
         free(fc->errstr);
      }
    free(fc);
+   phase_done(PHASE_FONTS);
    thread_end(0);
 }
 
@@ -979,6 +1072,7 @@ data_write_fonts(Eet_File *ef, int *font_num)
 
    if (!edje_file->fonts) return;
 
+   phase_begin(PHASE_FONTS);
    it = eina_hash_iterator_data_new(edje_file->fonts);
    EINA_ITERATOR_FOREACH(it, fn)
      {
@@ -988,6 +1082,7 @@ data_write_fonts(Eet_File *ef, int *font_num)
         if (!fc) continue;
         fc->ef = ef;
         fc->fn = fn;
+        data_key_reserve(ef, "edje/fonts/%s", fn->name);
         pending_threads++;
         if (threads)
           ecore_thread_run(data_thread_fonts, data_thread_fonts_end, NULL, fc);
@@ -1236,6 +1331,7 @@ data_thread_image_end(void *data, Ecore_Thread *thread EINA_UNUSED)
    free(iw->path);
    evas_object_del(iw->im);
    free(iw);
+   phase_done(PHASE_IMAGES);
    thread_end(1);
 }
 
@@ -1284,6 +1380,7 @@ tgv_file_thread_end(void *data, Ecore_Thread *thread EINA_UNUSED)
    eina_file_map_free(iw->f, iw->data);
    eina_file_close(iw->f);
    free(iw);
+   phase_done(PHASE_IMAGES);
    thread_end(1);
 }
 
@@ -1357,6 +1454,7 @@ tgv_file_check_and_add(Eet_File *ef, Edje_Image_Directory_Entry *img)
    image_num += 1;
    iw->path = strdup(img->entry);
 
+   data_key_reserve(ef, "edje/images/%i", img->id);
    pending_image_threads++;
    if (threads)
      ecore_thread_run(tgv_file_thread, tgv_file_thread_end, NULL, iw);
@@ -1548,6 +1646,7 @@ data_write_images(void)
                {
                   image_num += 1;
                   iw->path = strdup(buf);
+                  data_key_reserve(cur_ef, "edje/images/%i", img->id);
                   pending_image_threads++;
                   if (threads)
                     evas_object_image_preload(im, 0);
@@ -1565,6 +1664,7 @@ data_write_images(void)
                {
                   image_num += 1;
                   iw->path = strdup(img->entry);
+                  data_key_reserve(cur_ef, "edje/images/%i", img->id);
                   pending_image_threads++;
                   if (threads)
                     evas_object_image_preload(im, 0);
@@ -1687,6 +1787,7 @@ data_thread_sounds_end(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
    Sound_Write *sw = data;
    free(sw);
+   phase_done(PHASE_SOUNDS);
    thread_end(0);
 }
 
@@ -1697,6 +1798,7 @@ data_write_sounds(Eet_File *ef, int *sound_num)
      {
         int i;
 
+        phase_begin(PHASE_SOUNDS);
         for (i = 0; i < (int)edje_file->sound_dir->samples_count; i++)
           {
              Sound_Write *sw;
@@ -1707,6 +1809,7 @@ data_write_sounds(Eet_File *ef, int *sound_num)
              sw->sample = &edje_file->sound_dir->samples[i];
              sw->i = i;
              *sound_num += 1;
+             data_key_reserve(ef, "edje/sounds/%i", sw->sample->id);
              pending_threads++;
              if (threads)
                ecore_thread_run(data_thread_sounds, data_thread_sounds_end, NULL, sw);
@@ -1797,6 +1900,7 @@ data_thread_mo_end(void *data, Ecore_Thread *thread EINA_UNUSED)
    if (mw->mo_path)
      free(mw->mo_path);
    free(mw);
+   phase_done(PHASE_MO);
    thread_end(0);
 }
 
@@ -1842,6 +1946,7 @@ data_write_mo(Eet_File *ef, int *mo_num)
         char mo_path[PATH_MAX];
         char po_path[PATH_MAX];
 
+        phase_begin(PHASE_MO);
         for (i = 0; i < (int)edje_file->mo_dir->mo_entries_count; i++)
           {
              Mo_Write *mw, *mw2;
@@ -1850,6 +1955,8 @@ data_write_mo(Eet_File *ef, int *mo_num)
              mw->ef = ef;
              mw->mo_entry = &edje_file->mo_dir->mo_entries[i];
              *mo_num += 1;
+             data_key_reserve(ef, "edje/mo/%i/%s/LC_MESSAGES",
+                              mw->mo_entry->id, mw->mo_entry->locale);
              pending_threads++;
 
              po_entry = strdup(mw->mo_entry->mo_src);
@@ -1957,6 +2064,7 @@ data_thread_vibrations_end(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
    Vibration_Write *sw = data;
    free(sw);
+   phase_done(PHASE_VIBRATIONS);
    thread_end(0);
 }
 
@@ -1967,6 +2075,7 @@ data_write_vibrations(Eet_File *ef, int *num)
      {
         int i;
 
+        phase_begin(PHASE_VIBRATIONS);
         for (i = 0; i < (int)edje_file->vibration_dir->samples_count; i++)
           {
              Vibration_Write *vw;
@@ -1977,6 +2086,7 @@ data_write_vibrations(Eet_File *ef, int *num)
              vw->sample = &edje_file->vibration_dir->samples[i];
              vw->i = i;
              *num += 1;
+             data_key_reserve(ef, "edje/vibrations/%i", vw->sample->id);
              pending_threads++;
              if (threads)
                ecore_thread_run(data_thread_vibrations, data_thread_vibrations_end, NULL, vw);
@@ -2037,6 +2147,7 @@ data_thread_group_end(void *data, Ecore_Thread *thread EINA_UNUSED)
         free(gw->errstr);
      }
    free(gw);
+   phase_done(PHASE_GROUPS);
    thread_end(0);
 }
 
@@ -2045,11 +2156,25 @@ data_write_groups(Eet_File *ef, int *collection_num)
 {
    Eina_List *l;
    Edje_Part_Collection *pc;
+   char buf[PATH_MAX];
 
+   phase_begin(PHASE_GROUPS);
    EINA_LIST_FOREACH(edje_collections, l, pc)
      {
         Group_Write *gw;
 
+        /* collections share the eet string dictionary, which numbers
+         * strings in the order they are first encoded: encode them once
+         * uncompressed in order here, so string ids and entry order do
+         * not depend on which worker finishes first. The compressed
+         * encode of the worker then only finds known strings. */
+        if (threads)
+          {
+             snprintf(buf, sizeof(buf), "edje/collections/%i", pc->id);
+             eet_data_write(ef, edd_edje_part_collection, buf, pc,
+                            EET_COMPRESSION_NONE);
+          }
+
         gw = calloc(1, sizeof(Group_Write));
         if (!gw)
           {
@@ -2203,6 +2328,11 @@ data_thread_script(void *data, Ecore_Thread *thread EINA_UNUSED)
              return;
           }
      }
+   else
+     {
+        snprintf(buf, sizeof(buf), "edje/scripts/embryo/compiled/%i", sc->i);
+        data_key_release(sc->ef, buf);
+     }
 
    if (no_save)
      WRN("You are removing the source from this Edje file. This may break some use cases.\nBe aware of your choice and the poor kitten you are harming with it!");
@@ -2259,6 +2389,7 @@ data_thread_script_end(void *data, Ecore_Thread *thread EINA_UNUSED)
         free(sc->errstr);
      }
    free(sc);
+   phase_done(PHASE_SCRIPTS);
    thread_end(0);
 }
 
@@ -2271,7 +2402,7 @@ data_scripts_exe_del_cb(void *data EINA_UNUSED, int evtype EINA_UNUSED, void *ev
    if (!ev->exe) return ECORE_CALLBACK_RENEW;
    if (ecore_exe_data_get(ev->exe) != sc) return ECORE_CALLBACK_RENEW;
    pending_write_commands--;
-   if (pending_write_commands < PENDING_COMMANDS_MAX)
+   if (pending_write_commands < pending_commands_max)
      {
         if (pending_script_writes)
           {
@@ -2305,7 +2436,7 @@ data_scripts_exe_del_cb(void *data EINA_UNUSED, int evtype EINA_UNUSED, void *ev
 static void
 data_write_script_queue(Script_Write *sc, const char *exeline)
 {
-   if (pending_write_commands >= PENDING_COMMANDS_MAX)
+   if (pending_write_commands >= pending_commands_max)
      {
         Pending_Script_Write *pend = malloc(sizeof(Pending_Script_Write));
         if (pend)
@@ -2337,6 +2468,24 @@ data_write_script_queue(Script_Write *sc, const char *exeline)
      }
 }
 
+static void
+data_write_script_reserve(const Script_Write *sc)
+{
+   Eina_List *ll;
+   Code_Program *cp;
+
+   data_key_reserve(sc->ef, "edje/scripts/embryo/compiled/%i", sc->i);
+   if (no_save) return;
+   if (sc->cd->original)
+     data_key_reserve(sc->ef, "edje/scripts/embryo/source/%i", sc->i);
+   EINA_LIST_FOREACH(sc->cd->programs, ll, cp)
+     {
+        if (!cp->original) continue;
+        data_key_reserve(sc->ef, "edje/scripts/embryo/source/%i/%i",
+                         sc->i, cp->id);
+     }
+}
+
 static void
 data_write_scripts(Eet_File *ef)
 {
@@ -2374,6 +2523,18 @@ data_write_scripts(Eet_File *ef)
      }
 #undef BIN_EXT
 
+   /* embryo_cc runs as external processes, allow as many at once as we
+    * have cpus (or the -threads limit) */
+   if (threads_max > 0)
+     pending_commands_max = threads_max;
+   else
+     {
+        pending_commands_max = eina_cpu_count();
+        if (pending_commands_max < PENDING_COMMANDS_MAX)
+          pending_commands_max = PENDING_COMMANDS_MAX;
+     }
+
+   phase_begin(PHASE_SCRIPTS);
    for (i = 0, l = codes; l; l = eina_list_next(l), i++)
      {
         Code *cd = eina_list_data_get(l);
@@ -2389,6 +2550,7 @@ data_write_scripts(Eet_File *ef)
         sc->ef = ef;
         sc->cd = cd;
         sc->i = i;
+        data_write_script_reserve(sc);
         sc->tmpn_fd = eina_file_mkstemp("edje_cc.sma-tmp-XXXXXX", &sc->tmpn);
         if (sc->tmpn_fd < 0)
           error_and_abort(ef, "Unable to open temp file \"%s\" for script "
@@ -2578,6 +2740,7 @@ data_thread_lua_script_end(void *data, Ecore_Thread *thread EINA_UNUSED)
         free(sc->errstr);
      }
    free(sc);
+   phase_done(PHASE_LUA_SCRIPTS);
    thread_end(0);
 }
 
@@ -2587,6 +2750,7 @@ data_write_lua_scripts(Eet_File *ef)
    Eina_List *l;
    int i;
 
+   phase_begin(PHASE_LUA_SCRIPTS);
    for (i = 0, l = codes; l; l = eina_list_next(l), i++)
      {
         Code *cd;
@@ -2602,6 +2766,7 @@ data_write_lua_scripts(Eet_File *ef)
         sc->ef = ef;
         sc->cd = cd;
         sc->i = i;
+        data_key_reserve(ef, "edje/scripts/lua/%i", i);
         pending_threads++;
         if (threads)
           ecore_thread_run(data_thread_lua_script, data_thread_lua_script_end, NULL, sc);
@@ -2621,39 +2786,67 @@ data_thread_source(void *data, Ecore_Thread *thread EINA_UNUSED)
 }
 
 static void
-data_thread_source_end(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+data_thread_fontmap(void *data, Ecore_Thread *thread);
+static void
+data_thread_fontmap_end(void *data, Ecore_Thread *thread);
+
+static void
+data_thread_source_end(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
+   Eet_File *ef = data;
+
+   phase_done(PHASE_SOURCE);
+   /* the fontmap adds to the same eet dictionary, so only start it once
+    * the sources are in to keep the string ids stable */
+   if (threads)
+     {
+        phase_begin(PHASE_FONTMAP);
+        ecore_thread_run(data_thread_fontmap, data_thread_fontmap_end, NULL, ef);
+     }
    thread_end(0);
 }
 
+static void
+license_key(const License_Write *lw, char *buf, size_t len)
+{
+   char *s;
+
+   if (lw->master)
+     {
+        snprintf(buf, len, "edje/license");
+        return;
+     }
+   s = alloca(strlen(lw->file) + 1);
+   strcpy(s, lw->file);
+   snprintf(buf, len, "edje/license/%s", basename(s));
+}
+
 static void
 data_thread_license(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
    License_Write *lw = data;
    Eet_File *ef = lw->ef;
    Eina_File *f;
+   char key[PATH_MAX];
    void *m;
    int bytes;
 
+   license_key(lw, key, sizeof(key));
    f = eina_file_open(lw->file, 0);
-   if (!f) return;
+   if (!f)
+     {
+        data_key_release(ef, key);
+        return;
+     }
 
    m = eina_file_map_all(f, EINA_FILE_WILLNEED);
-   if (!m) goto on_error;
-
-   if (lw->master)
+   if (!m)
      {
-        bytes = eet_write(ef, "edje/license", m, eina_file_size_get(f), compress_mode);
+        data_key_release(ef, key);
+        goto on_error;
      }
-   else
-     {
-        char *s = alloca(strlen(lw->file) + 1 + 13);
-
-        strcpy(s, lw->file);
-        sprintf(s, "edje/license/%s", basename(s));
 
-        bytes = eet_write(ef, s, m, eina_file_size_get(f), compress_mode);
-     }
+   bytes = eet_write(ef, key, m, eina_file_size_get(f), compress_mode);
 
    if ((bytes <= 0) || eina_file_map_faulted(f, m))
      {
@@ -2679,6 +2872,7 @@ static void
 data_thread_license_end(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
    free(data);
+   phase_done(PHASE_LICENSE);
    thread_end(0);
 }
 
@@ -2688,9 +2882,11 @@ data_write_license(Eet_File *ef)
    License_Write *lw;
    Eina_List *l;
    const char *file;
+   char key[PATH_MAX];
 
    if (!license) return;
 
+   phase_begin(PHASE_LICENSE);
    lw = calloc(1, sizeof (License_Write));
    if (!lw) return;
 
@@ -2698,6 +2894,8 @@ data_write_license(Eet_File *ef)
    lw->file = license;
    lw->master = EINA_TRUE;
 
+   license_key(lw, key, sizeof(key));
+   data_key_reserve(ef, "%s", key);
    pending_threads++;
    if (threads)
      ecore_thread_run(data_thread_license, data_thread_license_end, NULL, lw);
@@ -2716,6 +2914,8 @@ data_write_license(Eet_File *ef)
         lw->file = file;
         lw->master = EINA_FALSE;
 
+        license_key(lw, key, sizeof(key));
+        data_key_reserve(ef, "%s", key);
         pending_threads++;
         if (threads)
           ecore_thread_run(data_thread_license, data_thread_license_end, NULL, lw);
@@ -2736,10 +2936,18 @@ data_thread_authors(void *data, Ecore_Thread *thread EINA_UNUSED)
    int bytes;
 
    f = eina_file_open(authors, 0);
-   if (!f) return;
+   if (!f)
+     {
+        data_key_release(ef, "edje/authors");
+        return;
+     }
 
    m = eina_file_map_all(f, EINA_FILE_WILLNEED);
-   if (!m) goto on_error;
+   if (!m)
+     {
+        data_key_release(ef, "edje/authors");
+        goto on_error;
+     }
 
    bytes = eet_write(ef, "edje/authors", m, eina_file_size_get(f), compress_mode);
    if ((bytes <= 0) || eina_file_map_faulted(f, m))
@@ -2765,6 +2973,7 @@ on_error:
 static void
 data_thread_authors_end(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
 {
+   phase_done(PHASE_AUTHORS);
    thread_end(0);
 }
 
@@ -2778,6 +2987,7 @@ data_thread_fontmap(void *data, Ecore_Thread *thread EINA_UNUSED)
 static void
 data_thread_fontmap_end(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
 {
+   phase_done(PHASE_FONTMAP);
    thread_end(0);
 }
 
@@ -2836,21 +3046,25 @@ data_write(void)
 
    check_groups(ef);
 
-   ecore_thread_max_set(ecore_thread_max_get() * 2);
+   if (threads_max > 0)
+     ecore_thread_max_set(threads_max);
+   else
+     ecore_thread_max_set(ecore_thread_max_get() * 2);
 
    pending_threads++;
-   t = ecore_time_get();
+   t = phases[PHASE_PARSE].begin;
+   if (t <= 0.0) t = ecore_time_get();
 
-   INF("header: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_groups(ef, &collection_num);
-   INF("groups: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_scripts(ef);
-   INF("scripts: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_lua_scripts(ef);
-   INF("lua scripts: %3.5f", ecore_time_get() - t); t = ecore_time_get();
 
+   /* the fontmap is started once the source is written when threaded */
+   pending_threads++;
    if (!no_save)
      {
+        phase_begin(PHASE_SOURCE);
+        data_key_reserve(ef, "edje_sources");
         pending_threads++;
         if (threads)
           ecore_thread_run(data_thread_source, data_thread_source_end, NULL, ef);
@@ -2860,30 +3074,30 @@ data_write(void)
              data_thread_source_end(ef, NULL);
           }
      }
-   INF("source: %3.5f", ecore_time_get() - t); t = ecore_time_get();
-   pending_threads++;
-   if (threads)
-     ecore_thread_run(data_thread_fontmap, data_thread_fontmap_end, NULL, ef);
-   else
+   data_key_reserve(ef, "edje_source_fontmap");
+   if (!threads)
      {
+        phase_begin(PHASE_FONTMAP);
         data_thread_fontmap(ef, NULL);
         data_thread_fontmap_end(ef, NULL);
      }
-   INF("fontmap: %3.5f", ecore_time_get() - t); t = ecore_time_get();
+   else if (no_save)
+     {
+        phase_begin(PHASE_FONTMAP);
+        ecore_thread_run(data_thread_fontmap, data_thread_fontmap_end, NULL, ef);
+     }
+   phase_begin(PHASE_VECTORS);
    data_write_vectors(ef, &vector_num);
-   INF("vectors: %3.5f", ecore_time_get() - t); t = ecore_time_get();
+   if (vector_num) phase_done(PHASE_VECTORS);
    data_write_fonts(ef, &font_num);
-   INF("fonts: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_sounds(ef, &sound_num);
-   INF("sounds: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_mo(ef, &mo_num);
-   INF("mo: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_vibrations(ef, &vibration_num);
-   INF("vibrations: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    data_write_license(ef);
-   INF("license: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    if (authors)
      {
+        phase_begin(PHASE_AUTHORS);
+        data_key_reserve(ef, "edje/authors");
         pending_threads++;
         if (threads)
           ecore_thread_run(data_thread_authors, data_thread_authors_end, NULL, ef);
@@ -2893,15 +3107,14 @@ data_write(void)
              data_thread_authors_end(ef, NULL);
           }
      }
+   phase_begin(PHASE_IMAGES);
    data_write_images();
    data_image_sets_init();
-   INF("images: %3.5f", ecore_time_get() - t); t = ecore_time_get();
    pending_threads--;
    if (pending_threads + pending_image_threads > 0) ecore_main_loop_begin();
-   INF("THREADS: %3.5f", ecore_time_get() - t);
+   phase_begin(PHASE_HEADER);
    data_write_header(ef);
    if (pending_threads + pending_image_threads > 0) ecore_main_loop_begin();
-   INF("THREADS: %3.5f", ecore_time_get() - t);
 
    if (threads)
      {
@@ -2916,6 +3129,7 @@ data_write(void)
         exit(-1);
      }
 
+   phase_report(ecore_time_get() - t);
    if (eina_log_domain_level_check(_edje_cc_log_dom, EINA_LOG_LEVEL_INFO))
      {
         printf("Summary:\n"
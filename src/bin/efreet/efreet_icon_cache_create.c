@@ -927,6 +927,9 @@ main(int argc, char **argv)
         theme->changed = check_changed(theme);
         if (flush)
             theme->changed = EINA_TRUE;
+        /* the index is only written with a full scan, make sure we get one */
+        if (!ecore_file_exists(efreet_icon_index_file(theme->theme.name.internal)))
+            theme->changed = EINA_TRUE;
 
         INF("open icon file");
         /* open icon file */
@@ -981,6 +984,11 @@ main(int argc, char **argv)
                     eet_data_write(icon_ef, icon_edd, tuple->key, tuple->data, 1);
                 eina_iterator_free(icons_it);
 
+                if (efreet_icon_index_write(efreet_icon_index_file(theme->theme.name.internal), icons, EINA_FALSE))
+                    efreet_setowner(efreet_icon_index_file(theme->theme.name.internal));
+                else
+                    ERR("Failed to write icon index for '%s'", theme->theme.name.internal);
+
                 INF("theme change: %s %lld", theme->theme.name.internal, theme->last_cache_check);
                 eet_data_write(theme_ef, theme_edd, theme->theme.name.internal, theme, 1);
             }
@@ -1005,6 +1013,8 @@ main(int argc, char **argv)
     }
     if (flush)
         theme->changed = EINA_TRUE;
+    if (!ecore_file_exists(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK)))
+        theme->changed = EINA_TRUE;
 
     INF("open fallback file");
     /* open icon file */
@@ -1063,6 +1073,11 @@ main(int argc, char **argv)
             EINA_ITERATOR_FOREACH(icons_it, tuple)
                 eet_data_write(icon_ef, fallback_edd, tuple->key, tuple->data, 1);
             eina_iterator_free(icons_it);
+
+            if (efreet_icon_index_write(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK), icons, EINA_TRUE))
+                efreet_setowner(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK));
+            else
+                ERR("Failed to write fallback icon index");
         }
         eina_hash_free(icons);
 
@@ -891,11 +891,30 @@ _gen_func(const Eolian_Class *cl, const Eolian_Function *fid,
         if (fallback_free_ownership)
           eina_strbuf_append(buf, "_FALLBACK");
 
+        /* final classes can't be inherited, so their own functions are
+         * always resolved to the implementation right above: call it
+         * directly for plain instances of the class */
+        Eina_Bool is_direct = impl_need && eolian_class_is_final_get(cl);
+        if (is_direct)
+          eina_strbuf_append(buf, "_FINAL");
+
         eina_strbuf_append_char(buf, '(');
 
         Eina_Stringshare *eofn = eolian_function_full_c_name_get(fid, ftype);
         eina_strbuf_append(buf, eofn);
 
+        if (is_direct)
+          {
+             Eina_Stringshare *mname = eolian_class_c_macro_get(cl);
+             eina_strbuf_append_printf(buf, ", %s, ", mname);
+             eina_stringshare_del(mname);
+             if (is_empty || is_auto || eina_strbuf_length_get(params_init))
+               eina_strbuf_append(buf, "__eolian");
+             eina_strbuf_append_printf(buf, "_%s_", cnamel);
+             eina_strbuf_append(buf, eolian_function_name_get(fid));
+             eina_strbuf_append(buf, func_suffix);
+          }
+
         if (strcmp(rtpn, "void"))
           {
              eina_strbuf_append_printf(buf, ", %s, ", rtpn);
@@ -44,6 +44,7 @@
 #include <Ethumb_Client.h>
 
 #include "ethumbd_private.h"
+#include "../../static_libs/buildsystem/buildsystem.h"
 
 #ifndef PATH_MAX
 #define PATH_MAX 4096
@@ -121,8 +122,12 @@ struct _Ethumbd_Setup
 struct _Ethumbd_Request
 {
    int id;
+   int priority;
+   double queued; // when it was received
+   double started; // when a slave got it
    const char *file, *key;
    const char *thumb, *thumb_key;
+   Eina_List *dups; // same thumbnail asked again, answered together
    Ethumbd_Setup setup;
 };
 
@@ -132,7 +137,10 @@ struct _Ethumbd_Object
    const char *path;
    const char *client;
    Eina_List *queue;
+   Eina_Hash *pending; // file -> request waiting or being generated
+   Ethumbd_Setup setup; // everything set so far, for respawned slaves
    int nqueue;
+   int nprocessing;
    int id_count;
    int max_id;
    int min_id;
@@ -145,14 +153,17 @@ struct _Ethumbd_Queue
    int max_count;
    int nqueue;
    int last;
-   int current;
    Ethumbd_Object *table;
    int *list;
 };
 
 struct _Ethumbd_Slave
 {
+   Ethumbd *ed;
    Ecore_Exe *exe;
+   Ethumbd_Request *processing;
+   int idx; // object processing belongs to, -1 if it was deleted
+   Ecore_Timer *hang_timer;
    char *bufcmd; // buffer to read commands from slave
    int scmd; // size of command to read
    int pcmd; // position in the command buffer
@@ -162,12 +173,12 @@ struct _Ethumbd
 {
    Eldbus_Connection *conn;
    Ecore_Idle_Enterer *idle_enterer;
-   Ethumbd_Request *processing;
    Ethumbd_Queue queue;
    double timeout;
    Ecore_Timer *timeout_timer;
-   Ecore_Timer *hang_timer;
-   Ethumbd_Slave slave;
+   Ethumbd_Slave *slaves;
+   int nslaves;
+   int nprocessing;
 
    Ecore_Event_Handler *data_cb;
    Ecore_Event_Handler *del_cb;
@@ -193,6 +204,8 @@ const Ecore_Getopt optdesc = {
   {
     ECORE_GETOPT_STORE_DOUBLE
     ('t', "timeout", "finish ethumbd after <timeout> seconds of no activity."),
+    ECORE_GETOPT_STORE_INT
+    ('s', "slaves", "number of thumbnails generated in parallel, defaults to the number of CPUs."),
     ECORE_GETOPT_LICENSE('L', "license"),
     ECORE_GETOPT_COPYRIGHT('C', "copyright"),
     ECORE_GETOPT_VERSION('V', "version"),
@@ -203,6 +216,7 @@ const Ecore_Getopt optdesc = {
 
 static Eldbus_Message *_ethumb_dbus_queue_add_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_ethumb_dbus_queue_remove_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
+static Eldbus_Message *_ethumb_dbus_queue_priority_set_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_ethumb_dbus_queue_clear_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_ethumb_dbus_ethumb_setup_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_ethumb_dbus_delete_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
@@ -217,6 +231,10 @@ static const Eldbus_Method _ethumb_dbus_objects_methods[] = {
    "queue_remove", ELDBUS_ARGS({"i", "queue_id"}), ELDBUS_ARGS({"b", "result"}),
    _ethumb_dbus_queue_remove_cb, 0
   },
+  {
+   "queue_priority_set", ELDBUS_ARGS({"i", "queue_id"}, {"i", "priority"}),
+   ELDBUS_ARGS({"b", "result"}), _ethumb_dbus_queue_priority_set_cb, 0
+  },
   {
    "clear_queue", NULL, NULL, _ethumb_dbus_queue_clear_cb, 0
   },
@@ -233,17 +251,22 @@ static const Eldbus_Method _ethumb_dbus_objects_methods[] = {
 enum
 {
    ETHUMB_DBUS_OBJECTS_SIGNAL_GENERATED = 0,
+   ETHUMB_DBUS_OBJECTS_SIGNAL_GENERATED_TIMING,
 };
 
 static const Eldbus_Signal _ethumb_dbus_objects_signals[] = {
   [ETHUMB_DBUS_OBJECTS_SIGNAL_GENERATED] = { "generated",
        ELDBUS_ARGS({ "i", "id" }, { "ay", "paths" }, { "ay", "keys" },
                   { "b", "success" }), 0 },
+  [ETHUMB_DBUS_OBJECTS_SIGNAL_GENERATED_TIMING] = { "generated_timing",
+       ELDBUS_ARGS({ "i", "id" }, { "d", "queued" }, { "d", "generation" }), 0 },
   { }
 };
 
-static void _ethumb_dbus_generated_signal(Ethumbd *ed, int *id, const char *thumb_path, const char *thumb_key, Eina_Bool success);
-static Eina_Bool _ethumbd_slave_spawn(Ethumbd_Slave *slave, Ethumbd *ed);
+static void _ethumb_dbus_generated_signal(Ethumbd *ed, int idx, int *id, const char *thumb_path, const char *thumb_key, Eina_Bool success);
+static void _ethumb_dbus_generated_timing_signal(Ethumbd *ed, int idx, int id, double queued, double generation);
+static Eina_Bool _ethumbd_slave_spawn(Ethumbd_Slave *slave);
+static void _process_queue_start(Ethumbd *ed);
 
 static Eina_Bool
 _ethumbd_timeout_cb(void *data)
@@ -281,21 +304,21 @@ _ethumbd_timeout_redo(Ethumbd *ed)
 static Eina_Bool
 _ethumbd_hang_cb(void *data)
 {
-   Ethumbd *ed = data;
+   Ethumbd_Slave *slave = data;
    
-   ed->hang_timer = NULL;
-   if (ed->processing)
+   slave->hang_timer = NULL;
+   if (slave->processing)
      {
         ERR("timeout while processing thumb");
-        if (ed->slave.exe) ecore_exe_kill(ed->slave.exe);
+        if (slave->exe) ecore_exe_kill(slave->exe);
      }
    return EINA_FALSE;
 }
 
 static void
-_ethumbd_hang_start(Ethumbd *ed)
+_ethumbd_hang_start(Ethumbd_Slave *slave)
 {
-   double tim = ed->timeout;
+   double tim = slave->ed->timeout;
    
    if (tim < 0) tim = 10.0;
    else
@@ -303,23 +326,23 @@ _ethumbd_hang_start(Ethumbd *ed)
         tim = tim / 3.0;
         if (tim > 10.0) tim = 10.0;
      }
-   if (!ed->hang_timer)
-     ed->hang_timer = ecore_timer_add(tim, _ethumbd_hang_cb, ed);
+   if (!slave->hang_timer)
+     slave->hang_timer = ecore_timer_add(tim, _ethumbd_hang_cb, slave);
 }
 
 static void
-_ethumbd_hang_stop(Ethumbd *ed)
+_ethumbd_hang_stop(Ethumbd_Slave *slave)
 {
-   if (!ed->hang_timer) return;
-   ecore_timer_del(ed->hang_timer);
-   ed->hang_timer = NULL;
+   if (!slave->hang_timer) return;
+   ecore_timer_del(slave->hang_timer);
+   slave->hang_timer = NULL;
 }
 
 static void
-_ethumbd_hang_redo(Ethumbd *ed)
+_ethumbd_hang_redo(Ethumbd_Slave *slave)
 {
-   _ethumbd_hang_stop(ed);
-   _ethumbd_hang_start(ed);
+   _ethumbd_hang_stop(slave);
+   _ethumbd_hang_start(slave);
 }
 
 static int
@@ -431,29 +454,145 @@ _ethumbd_child_write_op_generate(Ethumbd_Slave *slave,
 }
 
 static void
-_generated_cb(Ethumbd *ed, Eina_Bool success, const char *thumb_path, const char *thumb_key)
+_ethumbd_setup_clear(Ethumbd_Setup *setup)
 {
-   int i = ed->queue.current;
+   eina_stringshare_del(setup->directory);
+   eina_stringshare_del(setup->category);
+   eina_stringshare_del(setup->theme_file);
+   eina_stringshare_del(setup->group);
+   eina_stringshare_del(setup->swallow);
+   memset(setup, 0, sizeof(*setup));
+}
 
-   DBG("thumbnail ready at: \"%s:%s\"", thumb_path, thumb_key);
+static void
+_ethumbd_setup_merge(Ethumbd_Setup *dst, const Ethumbd_Setup *src)
+{
+#define MERGE(_flag, _field)                    \
+   if (src->flags._flag)                        \
+     {                                          \
+        dst->flags._flag = 1;                   \
+        dst->_field = src->_field;              \
+     }
+#define MERGE_STR(_flag, _field)                                \
+   if (src->flags._flag)                                        \
+     {                                                          \
+        dst->flags._flag = 1;                                   \
+        eina_stringshare_replace(&dst->_field, src->_field);    \
+     }
+
+   MERGE(fdo, fdo);
+   MERGE(size, tw);
+   MERGE(size, th);
+   MERGE(format, format);
+   MERGE(aspect, aspect);
+   MERGE(orientation, orientation);
+   MERGE(crop, cx);
+   MERGE(crop, cy);
+   MERGE(quality, quality);
+   MERGE(compress, compress);
+   MERGE_STR(directory, directory);
+   MERGE_STR(category, category);
+   MERGE_STR(frame, theme_file);
+   MERGE_STR(frame, group);
+   MERGE_STR(frame, swallow);
+   MERGE(video_time, video_time);
+   MERGE(video_start, video_start);
+   MERGE(video_interval, video_interval);
+   MERGE(video_ntimes, video_ntimes);
+   MERGE(video_fps, video_fps);
+   MERGE(document_page, document_page);
+
+#undef MERGE_STR
+#undef MERGE
+}
+
+static void
+_ethumbd_request_free(Ethumbd_Request *request)
+{
+   Ethumbd_Request *dup;
+
+   EINA_LIST_FREE(request->dups, dup)
+     _ethumbd_request_free(dup);
+   eina_stringshare_del(request->file);
+   eina_stringshare_del(request->key);
+   eina_stringshare_del(request->thumb);
+   eina_stringshare_del(request->thumb_key);
+   _ethumbd_setup_clear(&request->setup);
+   free(request);
+}
+
+static void
+_ethumbd_request_pending_del(Ethumbd_Object *eobject, Ethumbd_Request *request)
+{
+   if (eina_hash_find(eobject->pending, request->file) == request)
+     eina_hash_del_by_key(eobject->pending, request->file);
+}
+
+static void
+_ethumbd_request_signal(Ethumbd *ed, int idx, Ethumbd_Request *request,
+                        double started, double now,
+                        const char *thumb_path, const char *thumb_key,
+                        Eina_Bool success)
+{
+   /* duplicates may have arrived after the generation started */
+   if (started < request->queued) started = request->queued;
 
-   if (ed->queue.table[i].used)
-     _ethumb_dbus_generated_signal
-       (ed, &ed->processing->id, thumb_path, thumb_key, success);
-   eina_stringshare_del(ed->processing->file);
-   eina_stringshare_del(ed->processing->key);
-   eina_stringshare_del(ed->processing->thumb);
-   eina_stringshare_del(ed->processing->thumb_key);
-   free(ed->processing);
-   ed->processing = NULL;
+   DBG("request %d for \"%s\" waited %.3fs, generated in %.3fs",
+       request->id, request->file, started - request->queued, now - started);
+
+   _ethumb_dbus_generated_signal
+     (ed, idx, &request->id, thumb_path, thumb_key, success);
+   _ethumb_dbus_generated_timing_signal
+     (ed, idx, request->id, started - request->queued, now - started);
+}
+
+static void
+_ethumbd_request_done(Ethumbd_Slave *slave, Eina_Bool success, const char *thumb_path, const char *thumb_key)
+{
+   Ethumbd *ed = slave->ed;
+   Ethumbd_Request *request = slave->processing;
+   Ethumbd_Request *dup;
+   Eina_List *l;
+   double now = ecore_time_get();
+
+   if (slave->idx >= 0)
+     {
+        Ethumbd_Object *eobject = &(ed->queue.table[slave->idx]);
+
+        _ethumbd_request_signal(ed, slave->idx, request, request->started,
+                                now, thumb_path, thumb_key, success);
+        EINA_LIST_FOREACH(request->dups, l, dup)
+          _ethumbd_request_signal(ed, slave->idx, dup, request->started,
+                                  now, thumb_path, thumb_key, success);
+        _ethumbd_request_pending_del(eobject, request);
+        eobject->nprocessing--;
+     }
+   _ethumbd_request_free(request);
+   slave->processing = NULL;
+   slave->idx = -1;
+   ed->nprocessing--;
    _ethumbd_timeout_redo(ed);
-   _ethumbd_hang_stop(ed);
+   _ethumbd_hang_stop(slave);
 }
 
 static void
-_ethumbd_slave_cmd_ready(Ethumbd *ed)
+_generated_cb(Ethumbd_Slave *slave, Eina_Bool success, const char *thumb_path, const char *thumb_key)
 {
-   const char *bufcmd = ed->slave.bufcmd;
+   DBG("thumbnail ready at: \"%s:%s\"", thumb_path, thumb_key);
+
+   if (!slave->processing)
+     {
+        ERR("slave answered but was not processing anything.");
+        return;
+     }
+   _ethumbd_request_done(slave, success, thumb_path, thumb_key);
+   _process_queue_start(slave->ed);
+}
+
+static void
+_ethumbd_slave_cmd_ready(Ethumbd_Slave *slave)
+{
+   const char *bufcmd = slave->bufcmd;
    Eina_Bool success;
    const char *thumb_path = NULL;
    const char *thumb_key = NULL;
@@ -482,19 +621,19 @@ _ethumbd_slave_cmd_ready(Ethumbd *ed)
 
 #undef READVAL
 
-   _generated_cb(ed, success, thumb_path, thumb_key);
+   _generated_cb(slave, success, thumb_path, thumb_key);
 
-   free(ed->slave.bufcmd);
-   ed->slave.bufcmd = NULL;
-   ed->slave.scmd = 0;
+   free(slave->bufcmd);
+   slave->bufcmd = NULL;
+   slave->scmd = 0;
 }
 
 static int
-_ethumbd_slave_alloc_cmd(Ethumbd *ed, int ssize, char *sdata)
+_ethumbd_slave_alloc_cmd(Ethumbd_Slave *slave, int ssize, char *sdata)
 {
    int *scmd;
 
-   if (ed->slave.bufcmd)
+   if (slave->bufcmd)
      return 0;
 
    scmd = (int *)sdata;
@@ -502,24 +641,38 @@ _ethumbd_slave_alloc_cmd(Ethumbd *ed, int ssize, char *sdata)
 	ERR("could not read size of command.");
 	return 0;
    }
-   ed->slave.bufcmd = malloc(*scmd);
-   ed->slave.scmd = *scmd;
-   ed->slave.pcmd = 0;
+   slave->bufcmd = malloc(*scmd);
+   slave->scmd = *scmd;
+   slave->pcmd = 0;
 
    return sizeof(*scmd);
 }
 
+static Ethumbd_Slave *
+_ethumbd_slave_find(Ethumbd *ed, const Ecore_Exe *exe)
+{
+   int i;
+
+   for (i = 0; i < ed->nslaves; i++)
+     if (ed->slaves[i].exe == exe)
+       return &ed->slaves[i];
+
+   return NULL;
+}
+
 static Eina_Bool
 _ethumbd_slave_data_read_cb(void *data, int type EINA_UNUSED, void *event)
 {
    Ethumbd *ed = data;
    Ecore_Exe_Event_Data *ev = event;
+   Ethumbd_Slave *slave;
    int ssize;
    char *sdata;
 
-   if (ev->exe != ed->slave.exe)
+   slave = _ethumbd_slave_find(ed, ev->exe);
+   if (!slave)
      {
-	ERR("PARENT ERROR: slave != ev->exe");
+	ERR("PARENT ERROR: ev->exe is not a slave");
 	return 0;
      }
 
@@ -528,10 +681,10 @@ _ethumbd_slave_data_read_cb(void *data, int type EINA_UNUSED, void *event)
 
    while (ssize > 0)
      {
-	if (!ed->slave.bufcmd)
+	if (!slave->bufcmd)
 	  {
 	     int n;
-	     n = _ethumbd_slave_alloc_cmd(ed, ssize, sdata);
+	     n = _ethumbd_slave_alloc_cmd(slave, ssize, sdata);
 	     ssize -= n;
 	     sdata += n;
 	  }
@@ -539,71 +692,22 @@ _ethumbd_slave_data_read_cb(void *data, int type EINA_UNUSED, void *event)
 	  {
 	     char *bdata;
 	     int nbytes;
-	     bdata = ed->slave.bufcmd + ed->slave.pcmd;
-	     nbytes = ed->slave.scmd - ed->slave.pcmd;
+	     bdata = slave->bufcmd + slave->pcmd;
+	     nbytes = slave->scmd - slave->pcmd;
 	     nbytes = ssize < nbytes ? ssize : nbytes;
 	     memcpy(bdata, sdata, nbytes);
 	     sdata += nbytes;
 	     ssize -= nbytes;
-	     ed->slave.pcmd += nbytes;
+	     slave->pcmd += nbytes;
 
-	     if (ed->slave.pcmd == ed->slave.scmd)
-	       _ethumbd_slave_cmd_ready(ed);
+	     if (slave->pcmd == slave->scmd)
+	       _ethumbd_slave_cmd_ready(slave);
 	  }
      }
    _ethumbd_timeout_redo(ed);
    return 1;
 }
 
-static Eina_Bool
-_ethumbd_slave_del_cb(void *data, int type EINA_UNUSED, void *event)
-{
-   Ethumbd *ed = data;
-   Ecore_Exe_Event_Del *ev = event;
-   int i;
-
-   if (ev->exe != ed->slave.exe)
-     return 1;
-
-   _ethumbd_hang_stop(ed);
-
-   if (ev->exited)
-     ERR("slave exited with code: %d", ev->exit_code);
-   else if (ev->signalled)
-     ERR("slave exited by signal: %d", ev->exit_signal);
-
-   if (!ed->processing)
-     goto end;
-
-   i = ed->queue.current;
-   ERR("failed to generate thumbnail for: \"%s:%s\"",
-       ed->processing->file, ed->processing->key);
-
-   if (ed->queue.table[i].used)
-     _ethumb_dbus_generated_signal
-       (ed, &ed->processing->id, NULL, NULL, EINA_FALSE);
-   eina_stringshare_del(ed->processing->file);
-   eina_stringshare_del(ed->processing->key);
-   eina_stringshare_del(ed->processing->thumb);
-   eina_stringshare_del(ed->processing->thumb_key);
-   free(ed->processing);
-   ed->processing = NULL;
-
-end:
-   ed->slave.exe = NULL;
-   if (ed->slave.bufcmd)
-     free(ed->slave.bufcmd);
-
-   if (!_ethumbd_slave_spawn(&ed->slave, ed))
-     return EINA_FALSE;
-
-   /* restart all queue */
-   for (i = 0; i < ed->queue.count; ++i)
-     _ethumbd_child_write_op_new(&ed->slave, ed->queue.list[i]);
-
-   return EINA_TRUE;
-}
-
 static void
 _ethumbd_pipe_write_setup(Ethumbd_Slave *slave, int type, const void *data)
 {
@@ -651,13 +755,9 @@ _ethumbd_pipe_write_setup(Ethumbd_Slave *slave, int type, const void *data)
 }
 
 static void
-_process_setup(Ethumbd *ed)
+_ethumbd_slave_write_setup(Ethumbd_Slave *slave, int idx, const Ethumbd_Setup *setup)
 {
    int op_id = ETHUMBD_OP_SETUP;
-   int idx = ed->queue.current;
-
-   Ethumbd_Setup *setup = &ed->processing->setup;
-   Ethumbd_Slave *slave = &ed->slave;
 
    _ethumbd_write_safe(slave, &op_id, sizeof(op_id));
    _ethumbd_write_safe(slave, &idx, sizeof(idx));
@@ -709,93 +809,182 @@ _process_setup(Ethumbd *ed)
      _ethumbd_pipe_write_setup(slave, ETHUMBD_DOCUMENT_PAGE,
 			       &setup->document_page);
    _ethumbd_pipe_write_setup(slave, ETHUMBD_SETUP_FINISHED, NULL);
+}
+
+static Eina_Bool
+_ethumbd_slave_del_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   Ethumbd *ed = data;
+   Ecore_Exe_Event_Del *ev = event;
+   Ethumbd_Slave *slave;
+   int i;
+
+   slave = _ethumbd_slave_find(ed, ev->exe);
+   if (!slave)
+     return 1;
+
+   _ethumbd_hang_stop(slave);
+
+   if (ev->exited)
+     ERR("slave exited with code: %d", ev->exit_code);
+   else if (ev->signalled)
+     ERR("slave exited by signal: %d", ev->exit_signal);
+
+   if (slave->processing)
+     {
+        ERR("failed to generate thumbnail for: \"%s:%s\"",
+            slave->processing->file, slave->processing->key);
+        _ethumbd_request_done(slave, EINA_FALSE, NULL, NULL);
+     }
 
+   slave->exe = NULL;
+   if (slave->bufcmd)
+     free(slave->bufcmd);
 
-   if (setup->directory) eina_stringshare_del(setup->directory);
-   if (setup->category) eina_stringshare_del(setup->category);
-   if (setup->theme_file) eina_stringshare_del(setup->theme_file);
-   if (setup->group) eina_stringshare_del(setup->group);
-   if (setup->swallow) eina_stringshare_del(setup->swallow);
+   if (!_ethumbd_slave_spawn(slave))
+     return EINA_FALSE;
 
-   free(ed->processing);
-   ed->processing = NULL;
+   /* restart all queue, with the setup the other slaves already have */
+   for (i = 0; i < ed->queue.count; ++i)
+     {
+        int idx = ed->queue.list[i];
+
+        _ethumbd_child_write_op_new(slave, idx);
+        _ethumbd_slave_write_setup(slave, idx, &ed->queue.table[idx].setup);
+     }
+   _process_queue_start(ed);
+
+   return EINA_TRUE;
 }
 
 static void
-_process_file(Ethumbd *ed)
+_process_setup(Ethumbd *ed, int idx, Ethumbd_Request *request)
 {
-   _ethumbd_hang_redo(ed);
+   int i;
+
+   _ethumbd_setup_merge(&ed->queue.table[idx].setup, &request->setup);
+   for (i = 0; i < ed->nslaves; i++)
+     _ethumbd_slave_write_setup(&ed->slaves[i], idx, &request->setup);
+
+   _ethumbd_request_free(request);
+}
+
+static void
+_process_file(Ethumbd_Slave *slave, int idx, Ethumbd_Request *request)
+{
+   Ethumbd *ed = slave->ed;
+
+   slave->processing = request;
+   slave->idx = idx;
+   request->started = ecore_time_get();
+   ed->queue.table[idx].nprocessing++;
+   ed->nprocessing++;
+
+   _ethumbd_hang_redo(slave);
    _ethumbd_child_write_op_generate
-     (&ed->slave, ed->queue.current, ed->processing->file,
-      ed->processing->key, ed->processing->thumb, ed->processing->thumb_key);
+     (slave, idx, request->file, request->key,
+      request->thumb, request->thumb_key);
 }
 
 static int
 _get_next_on_queue(Ethumbd_Queue *queue)
 {
-   int i, idx;
+   int i, j, idx, priority;
+   int best = -1, best_priority = 0;
    Ethumbd_Object *eobject;
+   Ethumbd_Request *request;
 
-   i = queue->last;
-   i++;
-   if (i >= queue->count)
-     i = 0;
-
-   idx = queue->list[i];
-   eobject = &(queue->table[idx]);
-   while (!eobject->nqueue)
+   /* highest priority first, round robin between clients otherwise */
+   for (j = 1; j <= queue->count; j++)
      {
-	i = (i + 1) % queue->count;
+	i = (queue->last + j) % queue->count;
 
 	idx = queue->list[i];
 	eobject = &(queue->table[idx]);
+	if (!eobject->nqueue) continue;
+
+	request = eina_list_data_get(eobject->queue);
+	if (request->id < 0)
+	  {
+	     /* slaves may still be generating with the previous setup */
+	     if (eobject->nprocessing) continue;
+	     priority = INT_MAX;
+	  }
+	else
+	  priority = request->priority;
+
+	if ((best < 0) || (priority > best_priority))
+	  {
+	     best = i;
+	     best_priority = priority;
+	  }
      }
 
-   return queue->list[i];
+   return best;
+}
+
+static Ethumbd_Slave *
+_ethumbd_slave_idle_get(Ethumbd *ed)
+{
+   int i;
+
+   for (i = 0; i < ed->nslaves; i++)
+     if ((ed->slaves[i].exe) && (!ed->slaves[i].processing))
+       return &ed->slaves[i];
+
+   return NULL;
 }
 
 static Eina_Bool
 _process_queue_cb(void *data)
 {
    Ethumbd_Object *eobject;
-   int i;
+   Ethumbd_Slave *slave = NULL;
+   int i, idx;
    Ethumbd *ed = data;
    Ethumbd_Queue *queue = &ed->queue;
    Ethumbd_Request *request;
 
-   if (ed->processing)
-     return 1;
+   while (queue->nqueue)
+     {
+	i = _get_next_on_queue(queue);
+	if (i < 0)
+	  break;
+
+	idx = queue->list[i];
+	eobject = &(queue->table[idx]);
+	request = eina_list_data_get(eobject->queue);
+	if (request->id >= 0)
+	  {
+	     slave = _ethumbd_slave_idle_get(ed);
+	     if (!slave)
+	       break;
+	  }
+
+	eobject->queue = eina_list_remove_list(eobject->queue, eobject->queue);
+	DBG("processing file: \"%s:%s\"...", request->file,
+	    request->key);
+
+	eobject->nqueue--;
+	queue->nqueue--;
+	queue->last = i;
+
+	if (request->id < 0)
+	  _process_setup(ed, idx, request);
+	else
+	  {
+	     _process_file(slave, idx, request);
+	     _ethumb_dbus_inc_min_id(eobject);
+	  }
+     }
 
    if (!queue->nqueue)
      {
-	ed->idle_enterer = NULL;
         _ethumbd_timeout_redo(ed);
 	ed->idle_enterer = NULL;
 	return 0;
      }
 
-   i = _get_next_on_queue(queue);
-   eobject = &(queue->table[i]);
-
-   request = eina_list_data_get(eobject->queue);
-   eobject->queue = eina_list_remove_list(eobject->queue, eobject->queue);
-   ed->queue.current = i;
-   DBG("processing file: \"%s:%s\"...", request->file,
-       request->key);
-   ed->processing = request;
-
-   if (request->id < 0)
-     _process_setup(ed);
-   else
-     {
-	_process_file(ed);
-	_ethumb_dbus_inc_min_id(eobject);
-     }
-   eobject->nqueue--;
-   queue->nqueue--;
-
-   queue->last = i;
-
    return 1;
 }
 
@@ -816,6 +1005,26 @@ _process_queue_stop(Ethumbd *ed)
      }
 }
 
+/* Requests of the same priority keep their order and none is moved
+ * across a setup, it applies to everything queued after it. */
+static Eina_List *
+_ethumbd_request_insert(Eina_List *queue, Eina_List *last, Ethumbd_Request *request)
+{
+   Eina_List *l;
+
+   for (l = last; l; l = eina_list_prev(l))
+     {
+        Ethumbd_Request *r = eina_list_data_get(l);
+
+        if ((r->id < 0) || (r->priority >= request->priority))
+          break;
+     }
+
+   if (l)
+     return eina_list_append_relative_list(queue, request, l);
+   return eina_list_prepend(queue, request);
+}
+
 static int
 _ethumb_table_append(Ethumbd *ed)
 {
@@ -871,6 +1080,7 @@ _ethumb_table_append(Ethumbd *ed)
    q->table[i].path = eina_stringshare_add(buf);
    q->table[i].max_id = -1;
    q->table[i].min_id = -1;
+   q->table[i].pending = eina_hash_stringshared_new(NULL);
    q->list[q->count] = i;
    q->count++;
    DBG("new object: %s, idx = %d, count = %d", buf, i, q->count);
@@ -893,15 +1103,17 @@ _ethumb_table_del(Ethumbd *ed, int i)
    l = q->table[i].queue;
    while (l)
      {
-	Ethumbd_Request *request = l->data;
-	eina_stringshare_del(request->file);
-	eina_stringshare_del(request->key);
-	eina_stringshare_del(request->thumb);
-	eina_stringshare_del(request->thumb_key);
-	free(request);
+	_ethumbd_request_free(l->data);
 	l = eina_list_remove_list(l, l);
      }
    q->nqueue -= q->table[i].nqueue;
+   eina_hash_free(q->table[i].pending);
+   _ethumbd_setup_clear(&q->table[i].setup);
+
+   /* whatever is still being generated for it has nobody to report to */
+   for (j = 0; j < ed->nslaves; j++)
+     if ((ed->slaves[j].processing) && (ed->slaves[j].idx == i))
+       ed->slaves[j].idx = -1;
 
    odata = eldbus_service_object_data_del(q->table[i].iface, ODATA);
    eldbus_name_owner_changed_callback_del(ed->conn, ed->queue.table[i].client,
@@ -919,8 +1131,9 @@ _ethumb_table_del(Ethumbd *ed, int i)
      }
 
    q->count--;
-   _ethumbd_child_write_op_del(&ed->slave, i);
-   if (!q->count && !ed->processing)
+   for (j = 0; j < ed->nslaves; j++)
+     _ethumbd_child_write_op_del(&ed->slaves[j], i);
+   if (!q->count && !ed->nprocessing)
      _ethumbd_timeout_redo(ed);
 }
 
@@ -957,7 +1170,7 @@ _ethumb_dbus_ethumb_new_cb(const Eldbus_Service_Interface *interface, const Eldb
    Eldbus_Message *reply;
    Eldbus_Service_Interface *iface;
    Ethumbd_Object_Data *odata;
-   int i;
+   int i, j;
    const char *return_path = "";
    const char *client;
    Ethumbd *ed;
@@ -992,9 +1205,9 @@ _ethumb_dbus_ethumb_new_cb(const Eldbus_Service_Interface *interface, const Eldb
    eldbus_name_owner_changed_callback_add(ed->conn, client,
                                          _name_owner_changed_cb, odata,
                                          EINA_TRUE);
-   _ethumbd_child_write_op_new(&ed->slave, i);
+   for (j = 0; j < ed->nslaves; j++)
+     _ethumbd_child_write_op_new(&ed->slaves[j], i);
    _ethumbd_timeout_redo(ed);
-   _ethumbd_hang_redo(ed);
 
  end_new:
    reply = eldbus_message_method_return_new(msg);
@@ -1051,7 +1264,7 @@ _ethumb_dbus_queue_add_cb(const Eldbus_Service_Interface *iface, const Eldbus_Me
    Ethumbd_Object_Data *odata;
    Ethumbd_Object *eobject;
    Ethumbd *ed;
-   Ethumbd_Request *request;
+   Ethumbd_Request *request, *pending;
    int id = -1;
    Eldbus_Message_Iter *file_iter, *key_iter, *thumb_iter, *thumb_key_iter;
 
@@ -1090,16 +1303,31 @@ _ethumb_dbus_queue_add_cb(const Eldbus_Service_Interface *iface, const Eldbus_Me
    eobject = &(ed->queue.table[odata->idx]);
    if (!_ethumb_dbus_check_id(eobject, id))
      goto end;
+   _ethumb_dbus_inc_max_id(eobject, id);
+
    request = calloc(1, sizeof(*request));
    request->id = id;
    request->file = file;
    request->key = key;
    request->thumb = thumb;
    request->thumb_key = thumb_key;
-   eobject->queue = eina_list_append(eobject->queue, request);
+   request->queued = ecore_time_get();
+
+   /* the same thumbnail requested again, just answer both at once */
+   pending = eina_hash_find(eobject->pending, file);
+   if ((pending) && (pending->key == key) &&
+       (pending->thumb == thumb) && (pending->thumb_key == thumb_key))
+     {
+        DBG("request %d for \"%s\" joins request %d", id, file, pending->id);
+        pending->dups = eina_list_append(pending->dups, request);
+        goto end;
+     }
+
+   eina_hash_set(eobject->pending, file, request);
+   eobject->queue = _ethumbd_request_insert
+     (eobject->queue, eina_list_last(eobject->queue), request);
    eobject->nqueue++;
    ed->queue.nqueue++;
-   _ethumb_dbus_inc_max_id(eobject, id);
 
    _process_queue_start(ed);
 
@@ -1109,14 +1337,31 @@ end:
    return reply;
 }
 
+static Eina_Bool
+_ethumbd_request_dup_remove(Ethumbd_Request *request, int id)
+{
+   Ethumbd_Request *dup;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(request->dups, l, dup)
+     if (dup->id == id)
+       {
+          request->dups = eina_list_remove_list(request->dups, l);
+          _ethumbd_request_free(dup);
+          return EINA_TRUE;
+       }
+
+   return EINA_FALSE;
+}
+
 static Eldbus_Message *
 _ethumb_dbus_queue_remove_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg)
 {
    Eldbus_Message *reply;
-   int id;
+   int id, i;
    Ethumbd_Object_Data *odata;
    Ethumbd_Object *eobject;
-   Ethumbd_Request *request;
+   Ethumbd_Request *request = NULL;
    Ethumbd *ed;
    Eina_Bool r = EINA_FALSE;
    Eina_List *l;
@@ -1141,21 +1386,51 @@ _ethumb_dbus_queue_remove_cb(const Eldbus_Service_Interface *iface, const Eldbus
 	request = l->data;
 	if (id == request->id)
 	  break;
+	if ((request->id >= 0) && (_ethumbd_request_dup_remove(request, id)))
+	  {
+	     r = EINA_TRUE;
+	     goto end;
+	  }
 	l = l->next;
      }
 
    if (l)
      {
+	Ethumbd_Request *dup = eina_list_data_get(request->dups);
+
 	r = EINA_TRUE;
-	eina_stringshare_del(request->file);
-	eina_stringshare_del(request->key);
-	eina_stringshare_del(request->thumb);
-	eina_stringshare_del(request->thumb_key);
-	free(request);
-	eobject->queue = eina_list_remove_list(eobject->queue, l);
-	eobject->nqueue--;
-	ed->queue.nqueue--;
+	if (dup)
+	  {
+	     /* someone else still wants it, keep its place in the queue */
+	     dup->dups = eina_list_remove_list(request->dups, request->dups);
+	     dup->priority = request->priority;
+	     request->dups = NULL;
+	     eina_list_data_set(l, dup);
+	     eina_hash_set(eobject->pending, dup->file, dup);
+	  }
+	else
+	  {
+	     _ethumbd_request_pending_del(eobject, request);
+	     eobject->queue = eina_list_remove_list(eobject->queue, l);
+	     eobject->nqueue--;
+	     ed->queue.nqueue--;
+	  }
+	_ethumbd_request_free(request);
 	_ethumb_dbus_inc_min_id(eobject);
+	goto end;
+     }
+
+   /* the generation may have started already, just drop the duplicate */
+   for (i = 0; i < ed->nslaves; i++)
+     {
+        Ethumbd_Slave *slave = &ed->slaves[i];
+
+        if ((slave->processing) && (slave->idx == odata->idx) &&
+            (_ethumbd_request_dup_remove(slave->processing, id)))
+          {
+             r = EINA_TRUE;
+             break;
+          }
      }
 
  end:
@@ -1164,6 +1439,61 @@ _ethumb_dbus_queue_remove_cb(const Eldbus_Service_Interface *iface, const Eldbus
    return reply;
 }
 
+static Eldbus_Message *
+_ethumb_dbus_queue_priority_set_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg)
+{
+   Eldbus_Message *reply;
+   int id, priority;
+   Ethumbd_Object_Data *odata;
+   Ethumbd_Object *eobject;
+   Ethumbd_Request *request = NULL;
+   Eina_Bool r = EINA_FALSE;
+   Eina_List *l, *last;
+
+   if (!eldbus_message_arguments_get(msg, "ii", &id, &priority))
+     {
+        ERR("Error getting arguments.");
+        goto end;
+     }
+   odata = eldbus_service_object_data_get(iface, ODATA);
+   if (!odata)
+     {
+	ERR("could not get dbus_object data.");
+	goto end;
+     }
+
+   eobject = &odata->ed->queue.table[odata->idx];
+   EINA_LIST_FOREACH(eobject->queue, l, request)
+     if (request->id == id)
+       break;
+
+   if (!l)
+     goto end;
+
+   r = EINA_TRUE;
+   if (request->priority == priority)
+     goto end;
+
+   /* it may only move among the requests sharing its setup */
+   for (last = l; eina_list_next(last); last = eina_list_next(last))
+     {
+        Ethumbd_Request *next = eina_list_data_get(eina_list_next(last));
+
+        if (next->id < 0) break;
+     }
+   if (last == l)
+     last = eina_list_prev(l);
+
+   eobject->queue = eina_list_remove_list(eobject->queue, l);
+   request->priority = priority;
+   eobject->queue = _ethumbd_request_insert(eobject->queue, last, request);
+
+ end:
+   reply = eldbus_message_method_return_new(msg);
+   eldbus_message_arguments_append(reply, "b", r);
+   return reply;
+}
+
 static Eldbus_Message *
 _ethumb_dbus_queue_clear_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg)
 {
@@ -1185,13 +1515,11 @@ _ethumb_dbus_queue_clear_cb(const Eldbus_Service_Interface *iface, const Eldbus_
    while (l)
      {
 	Ethumbd_Request *request = l->data;
-	eina_stringshare_del(request->file);
-	eina_stringshare_del(request->key);
-	eina_stringshare_del(request->thumb);
-	eina_stringshare_del(request->thumb_key);
-	free(request);
+	_ethumbd_request_pending_del(eobject, request);
+	_ethumbd_request_free(request);
 	l = eina_list_remove_list(l, l);
      }
+   eobject->queue = NULL;
    ed->queue.nqueue -= eobject->nqueue;
    eobject->nqueue = 0;
 
@@ -1636,6 +1964,8 @@ _ethumb_dbus_ethumb_setup_cb(const Eldbus_Service_Interface *iface, const Eldbus
           r = EINA_FALSE;
      }
 
+   /* files added from now on give a different thumbnail */
+   eina_hash_free_buckets(eobject->pending);
    eobject->queue = eina_list_append(eobject->queue, request);
    eobject->nqueue++;
    ed->queue.nqueue++;
@@ -1647,7 +1977,7 @@ end:
 }
 
 static void
-_ethumb_dbus_generated_signal(Ethumbd *ed, int *id, const char *thumb_path, const char *thumb_key, Eina_Bool success)
+_ethumb_dbus_generated_signal(Ethumbd *ed, int idx, int *id, const char *thumb_path, const char *thumb_key, Eina_Bool success)
 {
    Eldbus_Message *sig;
    Eldbus_Service_Interface *iface;
@@ -1656,7 +1986,7 @@ _ethumb_dbus_generated_signal(Ethumbd *ed, int *id, const char *thumb_path, cons
 
    id32 = *id;
 
-   iface = ed->queue.table[ed->queue.current].iface;
+   iface = ed->queue.table[idx].iface;
    sig = eldbus_service_signal_new(iface, ETHUMB_DBUS_OBJECTS_SIGNAL_GENERATED);
 
    iter = eldbus_message_iter_get(sig);
@@ -1669,6 +1999,16 @@ _ethumb_dbus_generated_signal(Ethumbd *ed, int *id, const char *thumb_path, cons
    eldbus_service_signal_send(iface, sig);
 }
 
+static void
+_ethumb_dbus_generated_timing_signal(Ethumbd *ed, int idx, int id, double queued, double generation)
+{
+   Eldbus_Service_Interface *iface;
+
+   iface = ed->queue.table[idx].iface;
+   eldbus_service_signal_emit(iface, ETHUMB_DBUS_OBJECTS_SIGNAL_GENERATED_TIMING,
+                              id, queued, generation);
+}
+
 static const Eldbus_Service_Interface_Desc server_desc = {
    _ethumb_dbus_interface, _ethumb_dbus_methods, NULL, NULL, NULL, NULL
 };
@@ -1715,19 +2055,22 @@ _ethumb_dbus_finish(Ethumbd *ed)
 }
 
 static Eina_Bool
-_ethumbd_slave_spawn(Ethumbd_Slave *slave, Ethumbd *ed)
+_ethumbd_slave_spawn(Ethumbd_Slave *slave)
 {
    char buf[PATH_MAX];
 
    slave->bufcmd = NULL;
    slave->scmd = 0;
+   slave->processing = NULL;
+   slave->idx = -1;
 
-   snprintf(buf, sizeof(buf),
-            "%s/ethumb_client/utils/"MODULE_ARCH"/ethumbd_slave",
-            eina_prefix_lib_get(_pfx));
+   if (!bs_binary_get(buf, sizeof(buf), "ethumb_client", "ethumbd_slave"))
+     snprintf(buf, sizeof(buf),
+              "%s/ethumb_client/utils/"MODULE_ARCH"/ethumbd_slave",
+              eina_prefix_lib_get(_pfx));
 
    slave->exe = ecore_exe_pipe_run(buf,
-      ECORE_EXE_PIPE_READ | ECORE_EXE_PIPE_WRITE, ed);
+      ECORE_EXE_PIPE_READ | ECORE_EXE_PIPE_WRITE, slave);
    if (!slave->exe)
      {
 	ERR("could not create slave.");
@@ -1744,8 +2087,9 @@ main(int argc, char *argv[])
    int exit_value = 0;
    int arg_idx;
    Ethumbd ed;
-   int child;
+   int i;
    double timeout = 30.0;
+   int nslaves = 0;
 
 #ifdef HAVE_SYS_RESOURCE_H
    setpriority(PRIO_PROCESS, 0, 19);
@@ -1770,6 +2114,27 @@ main(int argc, char *argv[])
 	  }
      }
 
+   Ecore_Getopt_Value values[] = {
+     ECORE_GETOPT_VALUE_DOUBLE(timeout),
+     ECORE_GETOPT_VALUE_INT(nslaves),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_NONE
+   };
+
+   arg_idx = ecore_getopt_parse(&optdesc, values, argc, argv);
+   if (arg_idx < 0)
+     {
+	ERR("Could not parse arguments.");
+	exit_value = -2;
+	goto finish;
+     }
+
+   if (quit_option)
+     goto finish;
+
    _pfx = eina_prefix_new(argv[0], ethumb_client_init,
                           "ETHUMB_CLIENT", "ethumb_client", "checkme",
                           PACKAGE_BIN_DIR, PACKAGE_LIB_DIR,
@@ -1786,18 +2151,29 @@ main(int argc, char *argv[])
    ed.del_cb = ecore_event_handler_add(ECORE_EXE_EVENT_DEL,
 				       _ethumbd_slave_del_cb, &ed);
 
-   child = _ethumbd_slave_spawn(&ed.slave, &ed);
-   if (!child)
+   if (nslaves <= 0)
+     nslaves = eina_cpu_count();
+   if (nslaves <= 0)
+     nslaves = 1;
+
+   ed.slaves = calloc(nslaves, sizeof(Ethumbd_Slave));
+   if (!ed.slaves)
      {
 	exit_value = -6;
 	goto finish;
      }
+   ed.nslaves = nslaves;
 
-   if (child == 2)
+   for (i = 0; i < ed.nslaves; i++)
      {
-	exit_value = 0;
-	goto finish;
+	ed.slaves[i].ed = &ed;
+	if (!_ethumbd_slave_spawn(&ed.slaves[i]))
+	  {
+	     exit_value = -6;
+	     goto finish;
+	  }
      }
+   DBG("using %d slaves", ed.nslaves);
 
    if (!eldbus_init())
      {
@@ -1806,26 +2182,6 @@ main(int argc, char *argv[])
 	goto finish;
      }
 
-   Ecore_Getopt_Value values[] = {
-     ECORE_GETOPT_VALUE_DOUBLE(timeout),
-     ECORE_GETOPT_VALUE_BOOL(quit_option),
-     ECORE_GETOPT_VALUE_BOOL(quit_option),
-     ECORE_GETOPT_VALUE_BOOL(quit_option),
-     ECORE_GETOPT_VALUE_BOOL(quit_option),
-     ECORE_GETOPT_VALUE_NONE
-   };
-
-   arg_idx = ecore_getopt_parse(&optdesc, values, argc, argv);
-   if (arg_idx < 0)
-     {
-	ERR("Could not parse arguments.");
-	exit_value = -2;
-	goto finish;
-     }
-
-   if (quit_option)
-     goto finish;
-
    ed.conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
    if (!ed.conn)
      {
@@ -1856,8 +2212,13 @@ main(int argc, char *argv[])
 
    eldbus_shutdown();
  finish:
-   if (ed.slave.exe)
-     ecore_exe_quit(ed.slave.exe);
+   for (i = 0; i < ed.nslaves; i++)
+     {
+	_ethumbd_hang_stop(&ed.slaves[i]);
+	if (ed.slaves[i].exe)
+	  ecore_exe_quit(ed.slaves[i].exe);
+     }
+   free(ed.slaves);
 
    if (_pfx) eina_prefix_free(_pfx);
    ethumb_shutdown();
@@ -556,6 +556,7 @@ ecore_fork_reset(void)
    Ecore_Fork_Cb *fcb;
 
    eina_debug_fork_reset();
+   eina_file_fork_reset();
 
    eina_main_loop_define();
    eina_lock_take(&_thread_safety);
@@ -145,10 +145,13 @@ struct _Efl_Loop_Data
    int                  timer_fd;
 
    double               last_check;
-   Eina_Inlist         *timers;
+   Efl_Loop_Timer_Data **timers; /* 4-ary min heap on expiry time */
+   unsigned int         timers_count;
+   unsigned int         timers_size;
+   unsigned int         timers_serial;
+   Eina_Inlist         *timers_added;
    Eina_Inlist         *suspended;
    Efl_Loop_Timer_Data *timer_current;
-   int                  timers_added;
 
    Eina_Value           exit_code;
 
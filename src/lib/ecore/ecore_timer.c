@@ -36,6 +36,15 @@ struct _Ecore_Timer_Legacy
    Eina_Bool delete_me   : 1;
 };
 typedef struct _Ecore_Timer_Legacy Ecore_Timer_Legacy;
+
+typedef enum _Efl_Loop_Timer_Queue
+{
+   EFL_LOOP_TIMER_QUEUE_NONE = 0,
+   EFL_LOOP_TIMER_QUEUE_ACTIVE, // in the loop heap, ready to expire
+   EFL_LOOP_TIMER_QUEUE_ADDED, // waiting for the next loop iteration
+   EFL_LOOP_TIMER_QUEUE_SUSPENDED
+} Efl_Loop_Timer_Queue;
+
 struct _Efl_Loop_Timer_Data
 {
    EINA_INLIST;
@@ -50,7 +59,10 @@ struct _Efl_Loop_Timer_Data
    double     pending;
 
    int        listening;
+   unsigned int heap_index;
+   unsigned int serial;
 
+   Efl_Loop_Timer_Queue queue;
    Eina_Bool  just_added  : 1;
    Eina_Bool  frozen      : 1;
    Eina_Bool  initialized : 1;
@@ -60,11 +72,130 @@ struct _Efl_Loop_Timer_Data
 };
 
 static void _efl_loop_timer_util_delay(Efl_Loop_Timer_Data *timer, double add);
+static void _efl_loop_timer_util_loop_clear(Efl_Loop_Timer_Data *pd);
 static void _efl_loop_timer_util_instanciate(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer);
 static void _efl_loop_timer_set(Efl_Loop_Timer_Data *timer, double at, double in);
 
 static double precision = 10.0 / 1000000.0;
 
+/* The active timers are kept in a 4-ary min heap ordered by expiry
+ * time, so adding, removing and rescheduling one of them is O(log n)
+ * whatever the number of timers. Timers expiring at the same time
+ * expire in the order they were scheduled.
+ */
+#define TIMER_HEAP_ARITY 4
+
+static inline Eina_Bool
+_efl_loop_timer_before(const Efl_Loop_Timer_Data *a, const Efl_Loop_Timer_Data *b)
+{
+   if (a->at < b->at) return EINA_TRUE;
+   if (a->at > b->at) return EINA_FALSE;
+   return (int)(a->serial - b->serial) < 0;
+}
+
+static void
+_efl_loop_timer_heap_up(Efl_Loop_Data *loop, unsigned int i)
+{
+   Efl_Loop_Timer_Data **heap = loop->timers;
+   Efl_Loop_Timer_Data *timer = heap[i];
+
+   while (i > 0)
+     {
+        unsigned int parent = (i - 1) / TIMER_HEAP_ARITY;
+
+        if (!_efl_loop_timer_before(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+     }
+   heap[i] = timer;
+   timer->heap_index = i;
+}
+
+static void
+_efl_loop_timer_heap_down(Efl_Loop_Data *loop, unsigned int i)
+{
+   Efl_Loop_Timer_Data **heap = loop->timers;
+   Efl_Loop_Timer_Data *timer = heap[i];
+   unsigned int count = loop->timers_count;
+
+   for (;;)
+     {
+        unsigned int child = (i * TIMER_HEAP_ARITY) + 1;
+        unsigned int best, end;
+
+        if (child >= count) break;
+        end = child + TIMER_HEAP_ARITY;
+        if (end > count) end = count;
+        for (best = child++; child < end; child++)
+          {
+             if (_efl_loop_timer_before(heap[child], heap[best]))
+               best = child;
+          }
+        if (!_efl_loop_timer_before(heap[best], timer)) break;
+        heap[i] = heap[best];
+        heap[i]->heap_index = i;
+        i = best;
+     }
+   heap[i] = timer;
+   timer->heap_index = i;
+}
+
+static Eina_Bool
+_efl_loop_timer_heap_insert(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer)
+{
+   if (loop->timers_count == loop->timers_size)
+     {
+        Efl_Loop_Timer_Data **tmp;
+        unsigned int size = loop->timers_size ? loop->timers_size * 2 : 64;
+
+        tmp = realloc(loop->timers, size * sizeof(Efl_Loop_Timer_Data *));
+        if (!tmp) return EINA_FALSE;
+        loop->timers = tmp;
+        loop->timers_size = size;
+     }
+
+   loop->timers[loop->timers_count] = timer;
+   _efl_loop_timer_heap_up(loop, loop->timers_count++);
+   return EINA_TRUE;
+}
+
+static void
+_efl_loop_timer_heap_remove(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer)
+{
+   Efl_Loop_Timer_Data *last;
+   unsigned int i = timer->heap_index;
+
+   last = loop->timers[--loop->timers_count];
+   if (i == loop->timers_count) return;
+
+   loop->timers[i] = last;
+   last->heap_index = i;
+   if ((i > 0) &&
+       _efl_loop_timer_before(last, loop->timers[(i - 1) / TIMER_HEAP_ARITY]))
+     _efl_loop_timer_heap_up(loop, i);
+   else
+     _efl_loop_timer_heap_down(loop, i);
+}
+
+/* only walks the part of the heap expiring before maxtime */
+static void
+_efl_loop_timer_heap_latest_get(const Efl_Loop_Data *loop, unsigned int i,
+                                double maxtime, double *latest)
+{
+   const Efl_Loop_Timer_Data *timer = loop->timers[i];
+   unsigned int child, end;
+
+   if (timer->at >= maxtime) return;
+   if (timer->at > *latest) *latest = timer->at;
+
+   child = (i * TIMER_HEAP_ARITY) + 1;
+   end = child + TIMER_HEAP_ARITY;
+   if (end > loop->timers_count) end = loop->timers_count;
+   for (; child < end; child++)
+     _efl_loop_timer_heap_latest_get(loop, child, maxtime, latest);
+}
+
 EAPI double
 ecore_timer_precision_get(void)
 {
@@ -390,11 +521,7 @@ _efl_loop_timer_efl_object_event_thaw(Eo *obj, Efl_Loop_Timer_Data *timer)
    if (!timer->frozen) return; // Timer not frozen
    timer->frozen = 0;
 
-   if (timer->loop_data)
-     {
-        timer->loop_data->suspended = eina_inlist_remove
-          (timer->loop_data->suspended, EINA_INLIST_GET(timer));
-     }
+   _efl_loop_timer_util_loop_clear(timer);
    now = ecore_time_get();
    _efl_loop_timer_set(timer, timer->pending + now, timer->in);
 }
@@ -408,29 +535,41 @@ ecore_timer_dump(void)
 static void
 _efl_loop_timer_util_loop_clear(Efl_Loop_Timer_Data *pd)
 {
-   Eina_Inlist *first;
+   Efl_Loop_Data *loop = pd->loop_data;
 
-   if (!pd->loop_data) return;
-   // Check if we are the current timer, if so move along
-   if (pd->loop_data->timer_current == pd)
-     pd->loop_data->timer_current = (Efl_Loop_Timer_Data *)
-       EINA_INLIST_GET(pd)->next;
+   if (!loop) return;
 
-   // Remove the timer from all possible pending list
-   first = eina_inlist_first(EINA_INLIST_GET(pd));
-   if (first == pd->loop_data->timers)
-     pd->loop_data->timers = eina_inlist_remove
-       (pd->loop_data->timers, EINA_INLIST_GET(pd));
-   else if (first == pd->loop_data->suspended)
-     pd->loop_data->suspended = eina_inlist_remove
-       (pd->loop_data->suspended, EINA_INLIST_GET(pd));
+   // Remove the timer from the queue it is in
+   switch (pd->queue)
+     {
+      case EFL_LOOP_TIMER_QUEUE_ACTIVE:
+        _efl_loop_timer_heap_remove(loop, pd);
+        break;
+      case EFL_LOOP_TIMER_QUEUE_ADDED:
+        loop->timers_added = eina_inlist_remove
+          (loop->timers_added, EINA_INLIST_GET(pd));
+        break;
+      case EFL_LOOP_TIMER_QUEUE_SUSPENDED:
+        loop->suspended = eina_inlist_remove
+          (loop->suspended, EINA_INLIST_GET(pd));
+        break;
+      default:
+        break;
+     }
+   pd->queue = EFL_LOOP_TIMER_QUEUE_NONE;
 }
 
 static void
-_efl_loop_timer_util_instanciate(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer)
+_efl_loop_timer_util_suspend(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer)
 {
-   Efl_Loop_Timer_Data *t2;
+   loop->suspended = eina_inlist_prepend(loop->suspended,
+                                         EINA_INLIST_GET(timer));
+   timer->queue = EFL_LOOP_TIMER_QUEUE_SUSPENDED;
+}
 
+static void
+_efl_loop_timer_util_instanciate(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer)
+{
    if (!loop) return;
    _efl_loop_timer_util_loop_clear(timer);
 
@@ -438,8 +577,7 @@ _efl_loop_timer_util_instanciate(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer
    if ((!timer->listening) || (timer->frozen) ||
        (timer->at <= 0.0) || (timer->in < 0.0))
      {
-        loop->suspended = eina_inlist_prepend(loop->suspended,
-                                              EINA_INLIST_GET(timer));
+        _efl_loop_timer_util_suspend(loop, timer);
         return;
      }
 
@@ -449,17 +587,20 @@ _efl_loop_timer_util_instanciate(Efl_Loop_Data *loop, Efl_Loop_Timer_Data *timer
         return;
      }
 
-   EINA_INLIST_REVERSE_FOREACH(loop->timers, t2)
+   timer->serial = loop->timers_serial++;
+   if (timer->just_added)
      {
-        if (timer->at > t2->at)
-          {
-             loop->timers = eina_inlist_append_relative(loop->timers,
-                                                        EINA_INLIST_GET(timer),
-                                                        EINA_INLIST_GET(t2));
-             return;
-          }
+        loop->timers_added = eina_inlist_append(loop->timers_added,
+                                                EINA_INLIST_GET(timer));
+        timer->queue = EFL_LOOP_TIMER_QUEUE_ADDED;
+     }
+   else if (_efl_loop_timer_heap_insert(loop, timer))
+     timer->queue = EFL_LOOP_TIMER_QUEUE_ACTIVE;
+   else
+     {
+        ERR("Could not schedule timer %p.", timer->object);
+        _efl_loop_timer_util_suspend(loop, timer);
      }
-   loop->timers = eina_inlist_prepend(loop->timers, EINA_INLIST_GET(timer));
 }
 
 static void
@@ -481,24 +622,12 @@ _efl_loop_timer_util_delay(Efl_Loop_Timer_Data *timer, double add)
 EOLIAN static void
 _efl_loop_timer_efl_object_parent_set(Eo *obj, Efl_Loop_Timer_Data *pd, Efl_Object *parent)
 {
-   Eina_Inlist *first;
-
    efl_parent_set(efl_super(obj, EFL_LOOP_TIMER_CLASS), parent);
 
    if ((!pd->constructed) || (!pd->finalized)) return;
 
    // Remove the timer from all possible pending list
-   first = eina_inlist_first(EINA_INLIST_GET(pd));
-   if (first == pd->loop_data->timers)
-     {
-        /* if this timer is currently being processed, update the pointer here so it is not lost */
-        if (pd == pd->loop_data->timer_current)
-          pd->loop_data->timer_current = (Efl_Loop_Timer_Data*)EINA_INLIST_GET(pd)->next;
-        pd->loop_data->timers = eina_inlist_remove(pd->loop_data->timers, EINA_INLIST_GET(pd));
-     }
-   else if (first == pd->loop_data->suspended)
-     pd->loop_data->suspended = eina_inlist_remove
-       (pd->loop_data->suspended, EINA_INLIST_GET(pd));
+   _efl_loop_timer_util_loop_clear(pd);
 
    if (efl_invalidated_get(obj)) return;
 
@@ -520,67 +649,46 @@ EOLIAN static void
 _efl_loop_timer_efl_object_destructor(Eo *obj, Efl_Loop_Timer_Data *pd)
 {
    _efl_loop_timer_util_loop_clear(pd);
+   if (pd->loop_data && (pd->loop_data->timer_current == pd))
+     pd->loop_data->timer_current = NULL;
    efl_destructor(efl_super(obj, MY_CLASS));
 }
 
 void
 _efl_loop_timer_enable_new(Eo *obj EINA_UNUSED, Efl_Loop_Data *pd)
 {
-   Efl_Loop_Timer_Data *timer;
+   while (pd->timers_added)
+     {
+        Efl_Loop_Timer_Data *timer;
 
-   if (!pd->timers_added) return;
-   pd->timers_added = 0;
-   EINA_INLIST_FOREACH(pd->timers, timer) timer->just_added = 0;
+        timer = EINA_INLIST_CONTAINER_GET(pd->timers_added, Efl_Loop_Timer_Data);
+        pd->timers_added = eina_inlist_remove(pd->timers_added,
+                                              pd->timers_added);
+        timer->queue = EFL_LOOP_TIMER_QUEUE_NONE;
+        timer->just_added = 0;
+        _efl_loop_timer_util_instanciate(pd, timer);
+     }
 }
 
 int
 _efl_loop_timers_exists(Eo *obj EINA_UNUSED, Efl_Loop_Data *pd)
 {
-   return !!pd->timers;
-}
-
-static inline Ecore_Timer *
-_efl_loop_timer_first_get(Eo *ob EINA_UNUSED, Efl_Loop_Data *pd)
-{
-   Efl_Loop_Timer_Data *timer;
-
-   EINA_INLIST_FOREACH(pd->timers, timer)
-     {
-        if (!timer->just_added) return timer->object;
-     }
-   return NULL;
-}
-
-static inline Efl_Loop_Timer_Data *
-_efl_loop_timer_after_get(Efl_Loop_Timer_Data *base)
-{
-   Efl_Loop_Timer_Data *timer;
-   Efl_Loop_Timer_Data *valid_timer = base;
-   double maxtime = base->at + precision;
-
-   EINA_INLIST_FOREACH(EINA_INLIST_GET(base)->next, timer)
-     {
-        if (EINA_UNLIKELY(!timer->initialized)) continue; // This shouldn't happen
-        if (timer->at >= maxtime) break;
-        if (!timer->just_added) valid_timer = timer;
-     }
-   return valid_timer;
+   return (pd->timers_count > 0) || (pd->timers_added != NULL);
 }
 
 double
 _efl_loop_timer_next_get(Eo *obj, Efl_Loop_Data *pd)
 {
-   Ecore_Timer *object;
-   Efl_Loop_Timer_Data *first;
-   double now;
-   double in;
+   double now, at, in;
+
+   if (!pd->timers_count) return -1;
 
-   object = _efl_loop_timer_first_get(obj, pd);
-   if (!object) return -1;
+   // wake up for all the timers expiring within precision at once
+   at = pd->timers[0]->at;
+   _efl_loop_timer_heap_latest_get(pd, 0, at + precision, &at);
 
-   first = _efl_loop_timer_after_get(efl_data_scope_get(object, MY_CLASS));
    now = efl_loop_time_get(obj);
-   in = first->at - now;
+   in = at - now;
    if (in < 0) in = 0;
    return in;
 }
@@ -591,14 +699,6 @@ _efl_loop_timer_reschedule(Efl_Loop_Timer_Data *timer, double when)
    if (timer->frozen || efl_invalidated_get(timer->object) ||
        (timer->legacy && timer->legacy->delete_me)) return;
 
-   if (timer->loop_data &&
-       (EINA_INLIST_GET(timer)->next || EINA_INLIST_GET(timer)->prev))
-     {
-        if (timer->loop_data->timers && (!timer->noparent))
-          timer->loop_data->timers = eina_inlist_remove
-            (timer->loop_data->timers, EINA_INLIST_GET(timer));
-     }
-
    /* if the timer would have gone off more than 15 seconds ago,
     * assume that the system hung and set the timer to go off
     * timer->in from now. this handles system hangs, suspends
@@ -624,66 +724,50 @@ _efl_loop_timer_expired_timers_call(Eo *obj, Efl_Loop_Data *pd, double when)
 int
 _efl_loop_timer_expired_call(Eo *obj EINA_UNUSED, Efl_Loop_Data *pd, double when)
 {
-   if (!pd->timers) return 0;
+   if ((!pd->timers_count) && (!pd->timer_current)) return 0;
    if (pd->last_check > when)
      {
         Efl_Loop_Timer_Data *timer;
-        // User set time backwards
-        EINA_INLIST_FOREACH(pd->timers, timer)
+        unsigned int i;
+
+        // User set time backwards, the heap order does not change
+        for (i = 0; i < pd->timers_count; i++)
+          pd->timers[i]->at -= (pd->last_check - when);
+        EINA_INLIST_FOREACH(pd->timers_added, timer)
           timer->at -= (pd->last_check - when);
      }
    pd->last_check = when;
 
-   if (!pd->timer_current) // regular main loop, start from head
-     pd->timer_current = (Efl_Loop_Timer_Data *)pd->timers;
-   else
+   if (pd->timer_current)
      {
-        // recursive main loop, continue from where we were
+        // recursive main loop, the timer being called was already taken
+        // out of the heap, schedule it again before going on
         Efl_Loop_Timer_Data *timer_old = pd->timer_current;
 
-        pd->timer_current = (Efl_Loop_Timer_Data *)
-          EINA_INLIST_GET(pd->timer_current)->next;
+        pd->timer_current = NULL;
         _efl_loop_timer_reschedule(timer_old, when);
      }
 
-   while (pd->timer_current)
+   while (pd->timers_count)
      {
-        Efl_Loop_Timer_Data *timer = pd->timer_current;
+        Efl_Loop_Timer_Data *timer = pd->timers[0];
 
-        if (timer->at > when)
-          {
-             pd->timer_current = NULL; // ended walk, next should restart.
-             return 0;
-          }
+        if (timer->at > when) return 0;
 
-        if (timer->just_added)
-          {
-             pd->timer_current = (Efl_Loop_Timer_Data *)
-               EINA_INLIST_GET(pd->timer_current)->next;
-             continue;
-          }
+        _efl_loop_timer_util_loop_clear(timer);
+        pd->timer_current = timer;
 
         efl_ref(timer->object);
         eina_evlog("+timer", timer, 0.0, NULL);
-        /* this can remove timer from its inlist in the legacy codepath */
         efl_event_callback_call(timer->object, EFL_LOOP_TIMER_EVENT_TIMER_TICK, NULL);
         eina_evlog("-timer", timer, 0.0, NULL);
 
-        // may have changed in recursive main loops
-        // this current timer can not die yet as we hold a reference on it
-        /* this is tricky: the current timer cannot be deleted, but it CAN be removed from its inlist,
-         * thus breaking timer processing
-         */
-        if (pd->timer_current)
+        // a recursive main loop already rescheduled it
+        if (pd->timer_current == timer)
           {
-             if (pd->timer_current == timer)
-               pd->timer_current = (Efl_Loop_Timer_Data *)EINA_INLIST_GET(pd->timer_current)->next;
-             /* assume this has otherwise been modified either due to recursive mainloop processing or
-              * the timer being removed from its inlist and carefully updating pd->timer_current in the
-              * process as only the most elite of engineers would think to do
-              */
+             pd->timer_current = NULL;
+             _efl_loop_timer_reschedule(timer, when);
           }
-        _efl_loop_timer_reschedule(timer, when);
         efl_unref(timer->object);
      }
    return 0;
@@ -693,7 +777,6 @@ static void
 _efl_loop_timer_set(Efl_Loop_Timer_Data *timer, double at, double in)
 {
    if (!timer->loop_data) return;
-   timer->loop_data->timers_added = 1;
    timer->in = in;
    timer->just_added = 1;
    timer->initialized = 1;
@@ -327,6 +327,9 @@ _efl_loop_efl_object_destructor(Eo *obj, Efl_Loop_Data *pd)
    while (pd->thread_children)
      _efl_thread_child_remove(obj, pd, pd->thread_children->data);
    efl_destructor(efl_super(obj, EFL_LOOP_CLASS));
+   free(pd->timers);
+   pd->timers = NULL;
+   pd->timers_size = 0;
 }
 
 static Eina_Value
@@ -12,6 +12,8 @@ typedef struct _Efl_Loop_Fd_Data Efl_Loop_Fd_Data;
 struct _Efl_Loop_Fd_Data
 {
    Ecore_Fd_Handler *handler;
+   Eo *loop;
+   Efl_Loop_Data *loop_data;
 
    struct {
       unsigned int read;
@@ -45,6 +47,14 @@ _efl_loop_fd_read_cb(void *data, Ecore_Fd_Handler *fd_handler)
    return ECORE_CALLBACK_RENEW;
 }
 
+static void
+_efl_loop_fd_handler_del(Efl_Loop_Fd_Data *pd)
+{
+   if (!pd->handler) return;
+   _ecore_main_fd_handler_del(pd->loop, pd->loop_data, pd->handler);
+   pd->handler = NULL;
+}
+
 static void
 _efl_loop_fd_reset(Eo *obj, Efl_Loop_Fd_Data *pd)
 {
@@ -52,11 +62,7 @@ _efl_loop_fd_reset(Eo *obj, Efl_Loop_Fd_Data *pd)
 
    if (pd->fd < 0)
      {
-        if (pd->handler)
-          {
-             ecore_main_fd_handler_del(pd->handler);
-             pd->handler = NULL;
-          }
+        _efl_loop_fd_handler_del(pd);
         return;
      }
    flags |= pd->references.read > 0 ? ECORE_FD_READ : 0;
@@ -64,20 +70,25 @@ _efl_loop_fd_reset(Eo *obj, Efl_Loop_Fd_Data *pd)
    flags |= pd->references.error > 0 ? ECORE_FD_ERROR : 0;
    if (flags == 0)
      {
-        if (pd->handler)
-          {
-             ecore_main_fd_handler_del(pd->handler);
-             pd->handler = NULL;
-          }
+        _efl_loop_fd_handler_del(pd);
         return;
      }
 
    if (pd->handler)
-     ecore_main_fd_handler_active_set(pd->handler, flags);
-   else if (pd->file)
-     pd->handler = ecore_main_fd_handler_file_add(pd->fd, flags, _efl_loop_fd_read_cb, obj, NULL, NULL);
-   else
-     pd->handler = ecore_main_fd_handler_add(pd->fd, flags, _efl_loop_fd_read_cb, obj, NULL, NULL);
+     {
+        ecore_main_fd_handler_active_set(pd->handler, flags);
+        return;
+     }
+
+   /* watch from the loop we belong to, it may not be the main one */
+   pd->loop = efl_provider_find(obj, EFL_LOOP_CLASS);
+   pd->loop_data = efl_data_scope_get(pd->loop, EFL_LOOP_CLASS);
+   if (!pd->loop_data) return;
+
+   pd->handler = _ecore_main_fd_handler_add(pd->loop, pd->loop_data, NULL,
+                                            pd->fd, flags,
+                                            _efl_loop_fd_read_cb, obj,
+                                            NULL, NULL, pd->file);
 }
 
 static void
@@ -189,8 +200,7 @@ _efl_loop_fd_efl_object_constructor(Eo *obj, Efl_Loop_Fd_Data *pd)
 static void
 _efl_loop_fd_efl_object_parent_set(Eo *obj, Efl_Loop_Fd_Data *pd, Efl_Object *parent)
 {
-   if (pd->handler) ecore_main_fd_handler_del(pd->handler);
-   pd->handler = NULL;
+   _efl_loop_fd_handler_del(pd);
 
    efl_parent_set(efl_super(obj, MY_CLASS), parent);
 
@@ -202,7 +212,7 @@ _efl_loop_fd_efl_object_parent_set(Eo *obj, Efl_Loop_Fd_Data *pd, Efl_Object *pa
 static void
 _efl_loop_fd_efl_object_invalidate(Eo *obj, Efl_Loop_Fd_Data *pd)
 {
-   ecore_main_fd_handler_del(pd->handler);
+   _efl_loop_fd_handler_del(pd);
 
    efl_invalidate(efl_super(obj, MY_CLASS));
 }
@@ -256,6 +256,7 @@ extern EWAPI Eina_Error EFL_NET_HTTP_ERROR_WRITE_ERROR;
 #include "efl_net_socket_tcp.eo.h"
 #include "efl_net_dialer_tcp.eo.h"
 #include "efl_net_server_tcp.eo.h"
+#include "efl_net_server_tcp_sharded.eo.h"
 
 #ifdef _WIN32
 #include "efl_net_socket_windows.eo.h"
@@ -274,6 +275,7 @@ extern EWAPI Eina_Error EFL_NET_HTTP_ERROR_WRITE_ERROR;
 
 #include "efl_net_http_types.eot.h"
 
+#include "efl_net_dialer_http_share.eo.h"
 #include "efl_net_dialer_http.eo.h"
 #include "efl_net_dialer_websocket.eo.h"
 
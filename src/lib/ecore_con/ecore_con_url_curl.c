@@ -313,6 +313,10 @@ _c_init(void)
    SYM(curl_slist_free_all);
    SYM(curl_slist_append);
    SYM(curl_version_info);
+   SYM(curl_share_init);
+   SYM(curl_share_setopt);
+   SYM(curl_share_cleanup);
+   SYM(curl_share_strerror);
    SYM(curl_getdate);
 
    _c_init_errors();
@@ -261,6 +261,7 @@ typedef enum
    CINIT(CAPATH, STRINGPOINT, 97),
    CINIT(BUFFERSIZE, LONG, 98),
    CINIT(NOSIGNAL, LONG, 99),
+   CINIT(SHARE, OBJECTPOINT, 100),
    CINIT(PROXYTYPE, LONG, 101),
    CINIT(ACCEPT_ENCODING, OBJECTPOINT, 102),
    CINIT(PRIVATE, OBJECTPOINT, 103),
@@ -278,6 +279,7 @@ typedef enum
    CINIT(CLOSESOCKETFUNCTION, FUNCTIONPOINT, 208),
    CINIT(CLOSESOCKETDATA, OBJECTPOINT, 209),
    CINIT(XFERINFOFUNCTION, FUNCTIONPOINT, 219),
+   CINIT(PIPEWAIT, LONG, 237),
 #define CURLOPT_XFERINFODATA CURLOPT_PROGRESSDATA
 } CURLoption;
 #define CURLINFO_STRING   0x100000
@@ -314,8 +316,30 @@ typedef enum
    CINIT(SOCKETDATA, OBJECTPOINT, 2),
    CINIT(PIPELINING, LONG, 3),
    CINIT(TIMERFUNCTION, FUNCTIONPOINT, 4),
-   CINIT(TIMERDATA, OBJECTPOINT, 5)
+   CINIT(TIMERDATA, OBJECTPOINT, 5),
+   CINIT(MAX_HOST_CONNECTIONS, LONG, 7),
+   CINIT(MAX_TOTAL_CONNECTIONS, LONG, 13)
 } CURLMoption;
+#define CURLPIPE_NOTHING   0L
+#define CURLPIPE_MULTIPLEX 2L
+typedef enum
+{
+   CURLSHE_OK = 0
+} CURLSHcode;
+typedef enum
+{
+   CURLSHOPT_SHARE = 1,
+   CURLSHOPT_UNSHARE = 2
+} CURLSHoption;
+typedef enum
+{
+   CURL_LOCK_DATA_NONE = 0,
+   CURL_LOCK_DATA_SHARE,
+   CURL_LOCK_DATA_COOKIE,
+   CURL_LOCK_DATA_DNS,
+   CURL_LOCK_DATA_SSL_SESSION,
+   CURL_LOCK_DATA_CONNECT
+} curl_lock_data;
 typedef enum
 {
    CURL_TIMECOND_NONE = 0,
@@ -369,6 +393,7 @@ typedef enum
 
 typedef void CURLM;
 typedef void CURL;
+typedef void CURLSH;
 struct curl_slist
 {
    char              *data;
@@ -451,6 +476,11 @@ struct _Ecore_Con_Curl
    void                    (*curl_slist_free_all)(struct curl_slist *);
    struct curl_slist      *(*curl_slist_append)(struct curl_slist *list,
                                                 const char *string);
+   CURLSH                 *(*curl_share_init)(void);
+   CURLSHcode              (*curl_share_setopt)(CURLSH *share,
+                                                CURLSHoption option, ...);
+   CURLSHcode              (*curl_share_cleanup)(CURLSH *share);
+   const char             *(*curl_share_strerror)(CURLSHcode);
    time_t                  (*curl_getdate)(const char *p, const time_t *unused);
    curl_version_info_data *(*curl_version_info)(CURLversion);
 
@@ -472,4 +502,25 @@ Eina_Error _curlmcode_to_eina_error(const CURLMcode code);
 /* only for legacy support to implement behavior that we're not exposing anymore */
 CURL *efl_net_dialer_http_curl_get(const Eo *o);
 
+/* one per loop for standalone dialers, one per Efl.Net.Dialer_Http_Share */
+typedef struct _Efl_Net_Dialer_Http_Curlm Efl_Net_Dialer_Http_Curlm;
+struct _Efl_Net_Dialer_Http_Curlm
+{
+   Eo *loop;
+   CURLM *multi;
+   CURLSH *share; /* only if owned by Efl.Net.Dialer_Http_Share */
+   Eina_List *users;
+   Eina_List *fdhandlers;
+   Eo *timer;
+   int running;
+   unsigned int pending_init;
+   long max_host_connections;
+   long max_total_connections;
+   Eina_Bool multiplex;
+};
+
+void efl_net_dialer_http_curlm_options_apply(Efl_Net_Dialer_Http_Curlm *cm);
+void efl_net_dialer_http_curlm_cleanup(Efl_Net_Dialer_Http_Curlm *cm);
+Efl_Net_Dialer_Http_Curlm *efl_net_dialer_http_share_curlm_get(const Eo *o);
+
 #endif
@@ -158,20 +158,11 @@ __extension__ ({                                                              \
 
 #define MY_CLASS EFL_NET_DIALER_HTTP_CLASS
 
-typedef struct _Efl_Net_Dialer_Http_Curlm {
-   Eo *loop;
-   CURLM *multi;
-   Eina_List *users;
-   Eo *timer;
-   int running;
-   unsigned int pending_init;
-} Efl_Net_Dialer_Http_Curlm;
-
-
 typedef struct
 {
    CURL *easy;
    Efl_Net_Dialer_Http_Curlm *cm;
+   Eo *share;
    Eo *fdhandler;
    Eina_Stringshare *address_dial;
    Eina_Stringshare *proxy;
@@ -412,65 +403,79 @@ _efl_net_dialer_http_curlm_socket_manage(CURL *e, curl_socket_t fd, int what, vo
    Eo *dialer, *fdhandler = fdhandler_data;
    char *priv;
    CURLcode re;
+   int flags;
+   Eina_Bool was_read, is_read, was_write, is_write;
 
    re = curl_easy_getinfo(e, CURLINFO_PRIVATE, &priv);
    EINA_SAFETY_ON_TRUE_RETURN_VAL(re != CURLE_OK, -1);
+
+   /* sockets of cached or multiplexed connections outlive the
+    * transfer that created them, they may go away with another one.
+    */
+   if (what == CURL_POLL_REMOVE)
+     {
+        if (priv)
+          {
+             pd = efl_data_scope_get((Eo *)priv, MY_CLASS);
+             if (pd && (pd->fdhandler == fdhandler)) pd->fdhandler = NULL;
+          }
+        if (fdhandler)
+          {
+             cm->fdhandlers = eina_list_remove(cm->fdhandlers, fdhandler);
+             efl_del(fdhandler);
+          }
+        return 0;
+     }
+
    if (!priv) return -1;
    dialer = (Eo *)priv;
    pd = efl_data_scope_get(dialer, MY_CLASS);
    EINA_SAFETY_ON_NULL_RETURN_VAL(pd, -1);
 
-   if (what == CURL_POLL_REMOVE)
-     {
-        pd->fdhandler = NULL;
-        efl_del(fdhandler);
-     }
+   if (fdhandler)
+     flags = (intptr_t)efl_key_data_get(fdhandler, "curl_flags");
    else
      {
-        int flags;
-        Eina_Bool was_read, is_read, was_write, is_write;
-
-        if (fdhandler)
-          flags = (intptr_t)efl_key_data_get(fdhandler, "curl_flags");
-        else
-          {
-             pd->fdhandler = fdhandler = efl_add(EFL_LOOP_FD_CLASS, cm->loop,
-                                                 efl_loop_fd_set(efl_added, fd));
-             EINA_SAFETY_ON_NULL_RETURN_VAL(fdhandler, -1);
-             curl_multi_assign(cm->multi, fd, fdhandler);
-             flags = 0;
-          }
+        pd->fdhandler = fdhandler = efl_add(EFL_LOOP_FD_CLASS, cm->loop,
+                                            efl_loop_fd_set(efl_added, fd));
+        EINA_SAFETY_ON_NULL_RETURN_VAL(fdhandler, -1);
+        curl_multi_assign(cm->multi, fd, fdhandler);
+        cm->fdhandlers = eina_list_append(cm->fdhandlers, fdhandler);
+        flags = 0;
+     }
 
-        if (what == flags)
-          return 0;
+   /* reused connections never go through _efl_net_dialer_http_socket_open() */
+   pd->fd = fd;
 
-        was_read = !!(flags & CURL_POLL_IN);
-        was_write = !!(flags & CURL_POLL_OUT);
+   if (what == flags)
+     return 0;
 
-        is_read = !!(what & CURL_POLL_IN);
-        is_write = !!(what & CURL_POLL_OUT);
+   was_read = !!(flags & CURL_POLL_IN);
+   was_write = !!(flags & CURL_POLL_OUT);
 
-        if (was_read && !is_read)
-          {
-             efl_event_callback_del(fdhandler, EFL_LOOP_FD_EVENT_READ, _efl_net_dialer_http_curlm_event_fd_read, cm);
-          }
-        else if (!was_read && is_read)
-          {
-             efl_event_callback_add(fdhandler, EFL_LOOP_FD_EVENT_READ, _efl_net_dialer_http_curlm_event_fd_read, cm);
-          }
+   is_read = !!(what & CURL_POLL_IN);
+   is_write = !!(what & CURL_POLL_OUT);
 
-        if (was_write && !is_write)
-          {
-             efl_event_callback_del(fdhandler, EFL_LOOP_FD_EVENT_WRITE, _efl_net_dialer_http_curlm_event_fd_write, cm);
-          }
-        else if (!was_write && is_write)
-          {
-             efl_event_callback_add(fdhandler, EFL_LOOP_FD_EVENT_WRITE, _efl_net_dialer_http_curlm_event_fd_write, cm);
-          }
+   if (was_read && !is_read)
+     {
+        efl_event_callback_del(fdhandler, EFL_LOOP_FD_EVENT_READ, _efl_net_dialer_http_curlm_event_fd_read, cm);
+     }
+   else if (!was_read && is_read)
+     {
+        efl_event_callback_add(fdhandler, EFL_LOOP_FD_EVENT_READ, _efl_net_dialer_http_curlm_event_fd_read, cm);
+     }
 
-        efl_key_data_set(fdhandler, "curl_flags", (void *)(intptr_t)what);
+   if (was_write && !is_write)
+     {
+        efl_event_callback_del(fdhandler, EFL_LOOP_FD_EVENT_WRITE, _efl_net_dialer_http_curlm_event_fd_write, cm);
+     }
+   else if (!was_write && is_write)
+     {
+        efl_event_callback_add(fdhandler, EFL_LOOP_FD_EVENT_WRITE, _efl_net_dialer_http_curlm_event_fd_write, cm);
      }
 
+   efl_key_data_set(fdhandler, "curl_flags", (void *)(intptr_t)what);
+
    return 0;
 }
 
@@ -492,6 +497,7 @@ _efl_net_dialer_http_curlm_add(Efl_Net_Dialer_Http_Curlm *cm, Eo *o, CURL *handl
         curl_multi_setopt(cm->multi, CURLMOPT_SOCKETDATA, cm);
         curl_multi_setopt(cm->multi, CURLMOPT_TIMERFUNCTION, _efl_net_dialer_http_curlm_timer_schedule);
         curl_multi_setopt(cm->multi, CURLMOPT_TIMERDATA, cm);
+        efl_net_dialer_http_curlm_options_apply(cm);
      }
 
    r = curl_multi_add_handle(cm->multi, handle);
@@ -521,17 +527,57 @@ _efl_net_dialer_http_curlm_remove(Efl_Net_Dialer_Http_Curlm *cm, Eo *o, CURL *ha
      }
 
    cm->users = eina_list_remove(cm->users, o);
-   if (!cm->users)
+
+   /* a share keeps its connections and caches until it is deleted */
+   if ((!cm->users) && (!cm->share))
+     efl_net_dialer_http_curlm_cleanup(cm);
+}
+
+void
+efl_net_dialer_http_curlm_options_apply(Efl_Net_Dialer_Http_Curlm *cm)
+{
+   CURLMcode r;
+
+   if ((!cm->multi) || (!cm->share)) return;
+
+   r = curl_multi_setopt(cm->multi, CURLMOPT_PIPELINING,
+                         cm->multiplex ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+   if (r != CURLM_OK)
+     WRN("cm=%p could not set multiplexing %d: %s",
+         cm, cm->multiplex, curl_multi_strerror(r));
+
+   r = curl_multi_setopt(cm->multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                         cm->max_host_connections);
+   if (r != CURLM_OK)
+     WRN("cm=%p could not limit connections per host to %ld: %s",
+         cm, cm->max_host_connections, curl_multi_strerror(r));
+
+   r = curl_multi_setopt(cm->multi, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                         cm->max_total_connections);
+   if (r != CURLM_OK)
+     WRN("cm=%p could not limit connections to %ld: %s",
+         cm, cm->max_total_connections, curl_multi_strerror(r));
+}
+
+void
+efl_net_dialer_http_curlm_cleanup(Efl_Net_Dialer_Http_Curlm *cm)
+{
+   Eo *fdhandler;
+
+   if (cm->multi)
      {
         DBG("cleaned up cm=%p multi=%p", cm, cm->multi);
         curl_multi_cleanup(cm->multi);
         cm->multi = NULL;
+     }
 
-        if (cm->timer)
-          {
-             efl_del(cm->timer);
-             cm->timer = NULL;
-          }
+   EINA_LIST_FREE(cm->fdhandlers, fdhandler)
+     efl_del(fdhandler);
+
+   if (cm->timer)
+     {
+        efl_del(cm->timer);
+        cm->timer = NULL;
      }
 }
 
@@ -1172,6 +1218,13 @@ _efl_net_dialer_http_efl_object_destructor(Eo *o, Efl_Net_Dialer_Http_Data *pd)
         pd->easy = NULL;
      }
 
+   /* the easy handle must be gone before the share can be cleaned up */
+   if (pd->share)
+     {
+        efl_unref(pd->share);
+        pd->share = NULL;
+     }
+
    efl_destructor(efl_super(o, MY_CLASS));
 
    if (pd->recv.bytes)
@@ -1205,9 +1258,15 @@ _efl_net_dialer_http_curl_start(Eo *o, Efl_Net_Dialer_Http_Data *pd)
 {
    Efl_Net_Dialer_Http_Curlm *cm;
 
-   // TODO: move this to be per-loop once multiple mainloops are supported
-   // this would need to attach something to the loop
-   cm = &_cm_global;
+   if (pd->share)
+     cm = efl_net_dialer_http_share_curlm_get(pd->share);
+   else
+     {
+        // TODO: move this to be per-loop once multiple mainloops are supported
+        // this would need to attach something to the loop
+        cm = &_cm_global;
+     }
+   EINA_SAFETY_ON_NULL_RETURN(cm);
    cm->loop = efl_loop_get(o);
    if (!_efl_net_dialer_http_curlm_add(cm, o, pd->easy))
      {
@@ -1722,6 +1781,7 @@ static Eina_Value _efl_net_dialer_http_pending_close(Eo *o, void *data, Eina_Val
 EOLIAN static Eina_Error
 _efl_net_dialer_http_efl_io_closer_close(Eo *o, Efl_Net_Dialer_Http_Data *pd)
 {
+   Efl_Net_Dialer_Http_Curlm *cm = pd->cm;
    Eina_Error err = 0;
 
    EINA_SAFETY_ON_TRUE_RETURN_VAL(efl_io_closer_closed_get(o), EBADF);
@@ -1750,8 +1810,13 @@ _efl_net_dialer_http_efl_io_closer_close(Eo *o, Efl_Net_Dialer_Http_Data *pd)
      }
    if (pd->fdhandler)
      {
-        ERR("dialer=%p fdhandler=%p still alive!", o, pd->fdhandler);
-        efl_del(pd->fdhandler);
+        /* shared connections are kept open for the next requests */
+        if (!pd->share)
+          {
+             ERR("dialer=%p fdhandler=%p still alive!", o, pd->fdhandler);
+             if (cm) cm->fdhandlers = eina_list_remove(cm->fdhandlers, pd->fdhandler);
+             efl_del(pd->fdhandler);
+          }
         pd->fdhandler = NULL;
      }
 
@@ -1982,6 +2047,50 @@ _efl_net_dialer_http_http_version_get(const Eo *o EINA_UNUSED, Efl_Net_Dialer_Ht
    return pd->version;
 }
 
+EOLIAN static void
+_efl_net_dialer_http_share_set(Eo *o, Efl_Net_Dialer_Http_Data *pd, Efl_Net_Dialer_Http_Share *share)
+{
+   Efl_Net_Dialer_Http_Curlm *cm = NULL;
+   CURLcode r;
+
+   EINA_SAFETY_ON_TRUE_RETURN(pd->cm != NULL);
+
+   if (pd->share == share) return;
+
+   if (share)
+     {
+        cm = efl_net_dialer_http_share_curlm_get(share);
+        EINA_SAFETY_ON_NULL_RETURN(cm);
+     }
+
+   r = curl_easy_setopt(pd->easy, CURLOPT_SHARE, cm ? cm->share : NULL);
+   if (r != CURLE_OK)
+     {
+        ERR("dialer=%p could not attach to share=%p: %s",
+            o, share, curl_easy_strerror(r));
+        return;
+     }
+
+   /* wait for a multiplexed connection instead of opening another one */
+   r = curl_easy_setopt(pd->easy, CURLOPT_PIPEWAIT, (long)(cm && cm->multiplex));
+   if (r != CURLE_OK)
+     DBG("dialer=%p could not set pipewait: %s", o, curl_easy_strerror(r));
+
+   if (share)
+     {
+        efl_ref(share);
+        efl_net_dialer_http_version_set(o, efl_net_dialer_http_share_http_version_get(share));
+     }
+   if (pd->share) efl_unref(pd->share);
+   pd->share = share;
+}
+
+EOLIAN static Efl_Net_Dialer_Http_Share *
+_efl_net_dialer_http_share_get(const Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Data *pd)
+{
+   return pd->share;
+}
+
 EOLIAN static void
 _efl_net_dialer_http_authentication_set(Eo *o, Efl_Net_Dialer_Http_Data *pd, const char *username, const char *password, Efl_Net_Http_Authentication_Method method, Eina_Bool restricted)
 {
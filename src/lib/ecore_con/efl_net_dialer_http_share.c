@@ -0,0 +1,138 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include "Ecore.h"
+#include "Ecore_Con.h"
+#include "ecore_con_private.h"
+
+#include "ecore_con_url_curl.h"
+
+typedef struct
+{
+   Efl_Net_Dialer_Http_Curlm cm;
+   Efl_Net_Http_Version version;
+} Efl_Net_Dialer_Http_Share_Data;
+
+#define MY_CLASS EFL_NET_DIALER_HTTP_SHARE_CLASS
+
+static void
+_efl_net_dialer_http_share_lock_data(Eo *o, CURLSH *share, curl_lock_data data, const char *name)
+{
+   CURLSHcode r;
+
+   r = _c->curl_share_setopt(share, CURLSHOPT_SHARE, data);
+   if (r != CURLSHE_OK)
+     WRN("share=%p could not share %s: %s",
+         o, name, _c->curl_share_strerror(r));
+}
+
+EOLIAN static Efl_Object *
+_efl_net_dialer_http_share_efl_object_constructor(Eo *o, Efl_Net_Dialer_Http_Share_Data *pd)
+{
+   if (!_c_init())
+     {
+        ERR("share=%p failed to initialize CURL", o);
+        return NULL;
+     }
+
+   pd->cm.share = _c->curl_share_init();
+   EINA_SAFETY_ON_NULL_RETURN_VAL(pd->cm.share, NULL);
+
+   /* all the users are in the same loop, so no lock functions are needed */
+   _efl_net_dialer_http_share_lock_data(o, pd->cm.share, CURL_LOCK_DATA_DNS, "DNS cache");
+   _efl_net_dialer_http_share_lock_data(o, pd->cm.share, CURL_LOCK_DATA_SSL_SESSION, "SSL sessions");
+   /* connections live in the multi handle anyway, sharing them
+    * also keeps them if the multi handle goes away (curl >= 7.57)
+    */
+   _efl_net_dialer_http_share_lock_data(o, pd->cm.share, CURL_LOCK_DATA_CONNECT, "connections");
+
+   pd->cm.multiplex = EINA_TRUE;
+   pd->version = EFL_NET_HTTP_VERSION_V2_0;
+
+   return efl_constructor(efl_super(o, MY_CLASS));
+}
+
+EOLIAN static void
+_efl_net_dialer_http_share_efl_object_destructor(Eo *o, Efl_Net_Dialer_Http_Share_Data *pd)
+{
+   /* dialers keep a reference, none may still be using it */
+   if (pd->cm.users)
+     ERR("share=%p still used by %u dialers", o, eina_list_count(pd->cm.users));
+
+   efl_net_dialer_http_curlm_cleanup(&pd->cm);
+
+   if (pd->cm.share)
+     {
+        CURLSHcode r = _c->curl_share_cleanup(pd->cm.share);
+        if (r != CURLSHE_OK)
+          ERR("share=%p could not cleanup curl share: %s",
+              o, _c->curl_share_strerror(r));
+        pd->cm.share = NULL;
+     }
+
+   efl_destructor(efl_super(o, MY_CLASS));
+
+   _c_shutdown();
+}
+
+EOLIAN static void
+_efl_net_dialer_http_share_http_version_set(Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd, Efl_Net_Http_Version http_version)
+{
+   pd->version = http_version;
+}
+
+EOLIAN static Efl_Net_Http_Version
+_efl_net_dialer_http_share_http_version_get(const Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd)
+{
+   return pd->version;
+}
+
+EOLIAN static void
+_efl_net_dialer_http_share_multiplex_set(Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd, Eina_Bool multiplex)
+{
+   pd->cm.multiplex = !!multiplex;
+   efl_net_dialer_http_curlm_options_apply(&pd->cm);
+}
+
+EOLIAN static Eina_Bool
+_efl_net_dialer_http_share_multiplex_get(const Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd)
+{
+   return pd->cm.multiplex;
+}
+
+EOLIAN static void
+_efl_net_dialer_http_share_max_host_connections_set(Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd, unsigned int max)
+{
+   pd->cm.max_host_connections = max;
+   efl_net_dialer_http_curlm_options_apply(&pd->cm);
+}
+
+EOLIAN static unsigned int
+_efl_net_dialer_http_share_max_host_connections_get(const Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd)
+{
+   return pd->cm.max_host_connections;
+}
+
+EOLIAN static void
+_efl_net_dialer_http_share_max_connections_set(Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd, unsigned int max)
+{
+   pd->cm.max_total_connections = max;
+   efl_net_dialer_http_curlm_options_apply(&pd->cm);
+}
+
+EOLIAN static unsigned int
+_efl_net_dialer_http_share_max_connections_get(const Eo *o EINA_UNUSED, Efl_Net_Dialer_Http_Share_Data *pd)
+{
+   return pd->cm.max_total_connections;
+}
+
+Efl_Net_Dialer_Http_Curlm *
+efl_net_dialer_http_share_curlm_get(const Eo *o)
+{
+   Efl_Net_Dialer_Http_Share_Data *pd = efl_data_scope_safe_get(o, MY_CLASS);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(pd, NULL);
+   return &pd->cm;
+}
+
+#include "efl_net_dialer_http_share.eo.c"
@@ -81,7 +81,7 @@ _efl_net_server_tcp_resolved_bind(Eo *o, Efl_Net_Server_Tcp_Data *pd EINA_UNUSED
         goto error;
      }
 
-   r = listen(fd, 0);
+   r = listen(fd, SOMAXCONN);
    if (r != 0)
      {
         err = efl_net_socket_error_get();
@@ -167,7 +167,7 @@ _efl_net_server_tcp_efl_net_server_fd_socket_activate(Eo *o, Efl_Net_Server_Tcp_
 
       if (!listening)
         {
-           if (listen(fd, 0) != 0)
+           if (listen(fd, SOMAXCONN) != 0)
              {
                 err = efl_net_socket_error_get();
                 DBG("listen(" SOCKET_FMT "): %s", fd, eina_error_msg_get(err));
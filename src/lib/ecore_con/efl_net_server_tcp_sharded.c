@@ -0,0 +1,392 @@
+#define EFL_NET_SERVER_FD_PROTECTED 1
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include "Ecore.h"
+#include "Ecore_Con.h"
+#include "ecore_con_private.h"
+
+#define MY_CLASS EFL_NET_SERVER_TCP_SHARDED_CLASS
+
+typedef struct _Efl_Net_Server_Tcp_Shard Efl_Net_Server_Tcp_Shard;
+typedef struct _Efl_Net_Server_Tcp_Sharded_Data Efl_Net_Server_Tcp_Sharded_Data;
+
+/*
+ * Once the thread is running only the following members are read by
+ * it: address, index and the setup function. The bound address is
+ * written by the thread before it calls back the main loop, every
+ * other member belongs to the main loop.
+ */
+struct _Efl_Net_Server_Tcp_Shard
+{
+   Eo *sharded;
+   Eo *thread;
+   Eina_Stringshare *address;
+   Efl_Net_Server_Tcp_Sharded_Data *pd;
+   unsigned int index;
+   Eina_Bool serving;
+   char bound[INET6_ADDRSTRLEN + sizeof("[]:65536")];
+};
+
+struct _Efl_Net_Server_Tcp_Sharded_Data
+{
+   Efl_Net_Server_Tcp_Shard *shards;
+   unsigned int shards_count;
+   unsigned int serving_count;
+   struct {
+      EflNetServerTcpShardSetup func;
+      void *data;
+      Eina_Free_Cb free_cb;
+   } setup;
+   Eina_Stringshare *address;
+   Ecore_Thread *resolver;
+   Eina_Bool started;
+};
+
+/* shard thread side */
+
+static void _efl_net_server_tcp_sharded_shard_serving_notify(void *data, const Efl_Event *event);
+
+static void
+_efl_net_server_tcp_sharded_shard_serving(void *data, const Efl_Event *event)
+{
+   Efl_Net_Server_Tcp_Shard *shard = data;
+   Eo *loop = efl_provider_find(event->object, EFL_LOOP_CLASS);
+
+   eina_strlcpy(shard->bound, efl_net_server_address_get(event->object),
+                sizeof(shard->bound));
+   efl_threadio_call(loop, shard, _efl_net_server_tcp_sharded_shard_serving_notify, NULL);
+}
+
+static void
+_efl_net_server_tcp_sharded_shard_error(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Eina_Error *perr = event->info;
+   Eo *loop = efl_provider_find(event->object, EFL_LOOP_CLASS);
+
+   /* the exit code is reported as "shard,error" on the main loop */
+   efl_loop_quit(loop, eina_value_int_init(*perr));
+}
+
+EFL_CALLBACKS_ARRAY_DEFINE(_efl_net_server_tcp_sharded_shard_cbs,
+                           { EFL_NET_SERVER_EVENT_SERVING, _efl_net_server_tcp_sharded_shard_serving },
+                           { EFL_NET_SERVER_EVENT_SERVER_ERROR, _efl_net_server_tcp_sharded_shard_error });
+
+static void
+_efl_net_server_tcp_sharded_shard_main(void *data, const Efl_Event *event)
+{
+   Efl_Net_Server_Tcp_Sharded_Data *pd = data;
+   Eo *loop = event->object;
+   Efl_Net_Server_Tcp_Shard *shard = efl_threadio_indata_get(loop);
+   Eina_Error err;
+   Eo *server;
+
+   server = efl_add(EFL_NET_SERVER_TCP_CLASS, loop,
+                    efl_net_server_fd_reuse_address_set(efl_added, EINA_TRUE),
+                    efl_net_server_fd_reuse_port_set(efl_added, EINA_TRUE),
+                    efl_event_callback_array_add(efl_added, _efl_net_server_tcp_sharded_shard_cbs(), shard));
+   if (!server)
+     {
+        efl_loop_quit(loop, eina_value_int_init(ENOMEM));
+        return;
+     }
+
+   if (pd->setup.func) pd->setup.func(pd->setup.data, server, shard->index);
+
+   err = efl_net_server_serve(server, shard->address);
+   if (err) efl_loop_quit(loop, eina_value_int_init(err));
+}
+
+/* main loop side */
+
+static Eina_Error _efl_net_server_tcp_sharded_shard_start(Eo *o, Efl_Net_Server_Tcp_Sharded_Data *pd, Efl_Net_Server_Tcp_Shard *shard, const char *address);
+
+static void
+_efl_net_server_tcp_sharded_shard_serving_notify(void *data, const Efl_Event *event EINA_UNUSED)
+{
+   Efl_Net_Server_Tcp_Shard *shard = data;
+   Efl_Net_Server_Tcp_Sharded_Data *pd = shard->pd;
+   Eo *o = shard->sharded;
+   unsigned int i;
+
+   if (shard->serving) return;
+   shard->serving = EINA_TRUE;
+   pd->serving_count++;
+
+   if (shard->index == 0)
+     {
+        /* others bind to the resolved address, so port 0 works */
+        eina_stringshare_replace(&pd->address, shard->bound);
+        DBG("server=%p shard 0 serving at %s, starting %u more",
+            o, pd->address, pd->shards_count - 1);
+
+        for (i = 1; i < pd->shards_count; i++)
+          {
+             Eina_Error err;
+
+             err = _efl_net_server_tcp_sharded_shard_start(o, pd, pd->shards + i, pd->address);
+             if (err) efl_event_callback_call(o, EFL_NET_SERVER_TCP_SHARDED_EVENT_SHARD_ERROR, &err);
+          }
+     }
+
+   if (pd->serving_count == pd->shards_count)
+     efl_event_callback_call(o, EFL_NET_SERVER_TCP_SHARDED_EVENT_SERVING, NULL);
+}
+
+static void
+_efl_net_server_tcp_sharded_shard_exit(void *data, const Efl_Event *event)
+{
+   Efl_Net_Server_Tcp_Shard *shard = data;
+   Efl_Net_Server_Tcp_Sharded_Data *pd = shard->pd;
+   Eina_Error err = efl_task_exit_code_get(event->object);
+
+   if (shard->serving)
+     {
+        shard->serving = EINA_FALSE;
+        pd->serving_count--;
+     }
+
+   if (err)
+     {
+        WRN("server=%p shard %u exited: %s",
+            shard->sharded, shard->index, eina_error_msg_get(err));
+        efl_event_callback_call(shard->sharded, EFL_NET_SERVER_TCP_SHARDED_EVENT_SHARD_ERROR, &err);
+     }
+}
+
+static void
+_efl_net_server_tcp_sharded_shard_del(void *data, const Efl_Event *event EINA_UNUSED)
+{
+   Efl_Net_Server_Tcp_Shard *shard = data;
+
+   shard->thread = NULL;
+}
+
+EFL_CALLBACKS_ARRAY_DEFINE(_efl_net_server_tcp_sharded_thread_cbs,
+                           { EFL_TASK_EVENT_EXIT, _efl_net_server_tcp_sharded_shard_exit },
+                           { EFL_EVENT_DEL, _efl_net_server_tcp_sharded_shard_del });
+
+static Eina_Error
+_efl_net_server_tcp_sharded_shard_start(Eo *o, Efl_Net_Server_Tcp_Sharded_Data *pd, Efl_Net_Server_Tcp_Shard *shard, const char *address)
+{
+   char name[16];
+
+   eina_stringshare_replace(&shard->address, address);
+   snprintf(name, sizeof(name), "Eflnetshard%u", shard->index);
+
+   shard->thread = efl_add(EFL_THREAD_CLASS, o,
+                           efl_name_set(efl_added, name),
+                           efl_threadio_indata_set(efl_added, shard),
+                           /* not exit_with_parent: that ends the shards
+                            * whenever a main loop begin returns, they
+                            * are ended on invalidate instead */
+                           efl_task_flags_set(efl_added, EFL_TASK_FLAGS_NONE),
+                           efl_event_callback_add(efl_added, EFL_LOOP_EVENT_ARGUMENTS, _efl_net_server_tcp_sharded_shard_main, pd),
+                           efl_event_callback_array_add(efl_added, _efl_net_server_tcp_sharded_thread_cbs(), shard));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(shard->thread, ENOMEM);
+
+   if (!efl_task_run(shard->thread))
+     {
+        ERR("server=%p could not start shard %u", o, shard->index);
+        efl_del(shard->thread);
+        return ENOMEM;
+     }
+
+   return 0;
+}
+
+EOLIAN static Efl_Object *
+_efl_net_server_tcp_sharded_efl_object_constructor(Eo *o, Efl_Net_Server_Tcp_Sharded_Data *pd)
+{
+   pd->shards_count = eina_cpu_count();
+   if (pd->shards_count < 1) pd->shards_count = 1;
+
+   return efl_constructor(efl_super(o, MY_CLASS));
+}
+
+EOLIAN static void
+_efl_net_server_tcp_sharded_efl_object_invalidate(Eo *o, Efl_Net_Server_Tcp_Sharded_Data *pd)
+{
+   unsigned int i;
+
+   /* threads are our children, they are joined when deleted so ask
+    * all of them to quit first, in parallel.
+    */
+   for (i = 0; i < pd->shards_count; i++)
+     {
+        if (pd->shards && pd->shards[i].thread)
+          efl_task_end(pd->shards[i].thread);
+     }
+
+   efl_invalidate(efl_super(o, MY_CLASS));
+}
+
+EOLIAN static void
+_efl_net_server_tcp_sharded_efl_object_destructor(Eo *o, Efl_Net_Server_Tcp_Sharded_Data *pd)
+{
+   unsigned int i;
+
+   if (pd->resolver)
+     {
+        ecore_thread_cancel(pd->resolver);
+        pd->resolver = NULL;
+     }
+
+   if (pd->shards)
+     {
+        for (i = 0; i < pd->shards_count; i++)
+          eina_stringshare_del(pd->shards[i].address);
+        free(pd->shards);
+        pd->shards = NULL;
+     }
+
+   if (pd->setup.free_cb) pd->setup.free_cb(pd->setup.data);
+   pd->setup.free_cb = NULL;
+   pd->setup.data = NULL;
+   pd->setup.func = NULL;
+
+   eina_stringshare_replace(&pd->address, NULL);
+
+   efl_destructor(efl_super(o, MY_CLASS));
+}
+
+EOLIAN static void
+_efl_net_server_tcp_sharded_shards_set(Eo *o EINA_UNUSED, Efl_Net_Server_Tcp_Sharded_Data *pd, unsigned int shards)
+{
+   EINA_SAFETY_ON_TRUE_RETURN(pd->started);
+   EINA_SAFETY_ON_TRUE_RETURN(shards < 1);
+   pd->shards_count = shards;
+}
+
+EOLIAN static unsigned int
+_efl_net_server_tcp_sharded_shards_get(const Eo *o EINA_UNUSED, Efl_Net_Server_Tcp_Sharded_Data *pd)
+{
+   return pd->shards_count;
+}
+
+EOLIAN static void
+_efl_net_server_tcp_sharded_shard_setup_set(Eo *o EINA_UNUSED, Efl_Net_Server_Tcp_Sharded_Data *pd, void *setup_data, EflNetServerTcpShardSetup setup, Eina_Free_Cb setup_free_cb)
+{
+   EINA_SAFETY_ON_TRUE_RETURN(pd->started);
+
+   if (pd->setup.free_cb) pd->setup.free_cb(pd->setup.data);
+   pd->setup.func = setup;
+   pd->setup.data = setup_data;
+   pd->setup.free_cb = setup_free_cb;
+}
+
+/* efl_net_server_serve() of a host name resolves it from a thread
+ * feedback, which can only be started from the main loop, so names are
+ * resolved here once and the shards are only given numeric addresses.
+ */
+static void
+_efl_net_server_tcp_sharded_resolved(void *data, const char *host EINA_UNUSED, const char *port EINA_UNUSED, const struct addrinfo *hints EINA_UNUSED, struct addrinfo *result, int gai_error)
+{
+   Eo *o = data;
+   Efl_Net_Server_Tcp_Sharded_Data *pd = efl_data_scope_get(o, MY_CLASS);
+   char buf[INET6_ADDRSTRLEN + sizeof("[]:65536")];
+   Eina_Error err = EFL_NET_ERROR_COULDNT_RESOLVE_HOST;
+
+   pd->resolver = NULL;
+
+   if (!gai_error)
+     {
+        if (efl_net_ip_port_fmt(buf, sizeof(buf), result->ai_addr))
+          {
+             DBG("server=%p resolved %s:%s to %s", o, host, port, buf);
+             err = _efl_net_server_tcp_sharded_shard_start(o, pd, pd->shards, buf);
+          }
+        freeaddrinfo(result);
+     }
+
+   if (err) efl_event_callback_call(o, EFL_NET_SERVER_TCP_SHARDED_EVENT_SHARD_ERROR, &err);
+}
+
+EOLIAN static Eina_Error
+_efl_net_server_tcp_sharded_serve(Eo *o, Efl_Net_Server_Tcp_Sharded_Data *pd, const char *address)
+{
+   char *str;
+   const char *host, *port;
+   struct addrinfo hints = {
+     .ai_socktype = SOCK_STREAM,
+     .ai_protocol = IPPROTO_TCP,
+     .ai_family = AF_UNSPEC,
+     .ai_flags = AI_ADDRCONFIG | AI_V4MAPPED,
+   };
+   struct sockaddr_storage ss;
+   unsigned int i;
+   Eina_Error err = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(address, EINVAL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(pd->started, EALREADY);
+
+   str = strdup(address);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(str, ENOMEM);
+   if (!efl_net_ip_port_split(str, &host, &port))
+     {
+        free(str);
+        return EINVAL;
+     }
+   if (!port) port = "0";
+
+#ifndef SO_REUSEPORT
+   if (pd->shards_count > 1)
+     {
+        WRN("server=%p SO_REUSEPORT is not supported, serving a single shard", o);
+        pd->shards_count = 1;
+     }
+#endif
+
+   pd->shards = calloc(pd->shards_count, sizeof(Efl_Net_Server_Tcp_Shard));
+   if (!pd->shards)
+     {
+        free(str);
+        return ENOMEM;
+     }
+
+   for (i = 0; i < pd->shards_count; i++)
+     {
+        pd->shards[i].sharded = o;
+        pd->shards[i].pd = pd;
+        pd->shards[i].index = i;
+     }
+
+   pd->started = EINA_TRUE;
+
+   /* the others are started once the first one is bound */
+   if (efl_net_ip_port_parse_split(host, port, &ss))
+     err = _efl_net_server_tcp_sharded_shard_start(o, pd, pd->shards, address);
+   else
+     {
+        pd->resolver = efl_net_ip_resolve_async_new(host, port, &hints,
+                                                    _efl_net_server_tcp_sharded_resolved, o);
+        if (!pd->resolver) err = EINVAL;
+     }
+   free(str);
+
+   if (err)
+     {
+        eina_stringshare_del(pd->shards[0].address);
+        free(pd->shards);
+        pd->shards = NULL;
+        pd->started = EINA_FALSE;
+     }
+
+   return err;
+}
+
+EOLIAN static const char *
+_efl_net_server_tcp_sharded_address_get(const Eo *o EINA_UNUSED, Efl_Net_Server_Tcp_Sharded_Data *pd)
+{
+   return pd->address;
+}
+
+EOLIAN static Eina_Bool
+_efl_net_server_tcp_sharded_serving_get(const Eo *o EINA_UNUSED, Efl_Net_Server_Tcp_Sharded_Data *pd)
+{
+   return pd->started && (pd->serving_count == pd->shards_count);
+}
+
+#include "efl_net_server_tcp_sharded.eo.c"
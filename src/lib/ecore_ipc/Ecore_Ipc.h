@@ -499,6 +499,40 @@ EAPI const char       *ecore_ipc_server_ip_get(Ecore_Ipc_Server *svr);
  */
 EAPI void              ecore_ipc_server_flush(Ecore_Ipc_Server *svr);
 
+/**
+ * @ingroup Ecore_IPC_Server_Group
+ * @brief Sets the payload size from which messages go through shared memory.
+ *
+ * Payloads of at least @p size bytes are written to a shared memory
+ * segment and only its name is sent over the socket, so big buffers are
+ * not copied through the kernel. Events and their data are the same
+ * whatever the transport.
+ *
+ * This applies to ecore_ipc_server_send() on a connected server and to
+ * ecore_ipc_client_send() on the clients of a listening one. It is only
+ * used for #ECORE_IPC_LOCAL_USER servers, on platforms providing
+ * shm_open().
+ *
+ * The other end must understand these messages, it must use Ecore_Ipc
+ * 1.24 or newer.
+ *
+ * @param   svr           The given server.
+ * @param   size          The payload size threshold in bytes, 0 (default)
+ *                        to always use the socket.
+ * @since 1.24
+ */
+EAPI void              ecore_ipc_server_shm_threshold_set(Ecore_Ipc_Server *svr, int size);
+
+/**
+ * @ingroup Ecore_IPC_Server_Group
+ * @brief Gets the payload size from which messages go through shared memory.
+ *
+ * @param   svr           The given server.
+ * @return  The payload size threshold in bytes, 0 if disabled.
+ * @since 1.24
+ */
+EAPI int               ecore_ipc_server_shm_threshold_get(Ecore_Ipc_Server *svr);
+
 /**
  * @defgroup Ecore_IPC_Client_Group IPC Client Functions
  * @ingroup Ecore_IPC_Group
@@ -3,6 +3,7 @@
 #endif
 
 #include <string.h>
+#include <limits.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -10,6 +11,13 @@
 # include <arpa/inet.h>
 #endif
 
+#ifdef HAVE_SHM_OPEN
+# include <errno.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+#endif
+
 #include <Ecore.h>
 #include <ecore_private.h>
 #include <Ecore_Con.h>
@@ -377,6 +385,171 @@ static void _ecore_ipc_server_client_add(void *data, const Efl_Event *event);
 EFL_CALLBACKS_ARRAY_DEFINE(_ecore_ipc_server_cbs,
                            { EFL_NET_SERVER_EVENT_CLIENT_ADD, _ecore_ipc_server_client_add });
 
+/* Payloads above the threshold are written to a shared memory segment
+ * and only its size and name are sent, as the message payload with
+ * ECORE_IPC_HEAD_SHM. The receiver copies it out and replies with an
+ * empty ECORE_IPC_HEAD_SHM_ACK message, as messages are processed in
+ * order the sender then unlinks the oldest segment it has pending.
+ * Segments still pending when the connection goes away are unlinked.
+ *
+ * Segments are only sent to a peer known to read them: on local
+ * connections the other messages carry ECORE_IPC_HEAD_SHM_OK, bits that
+ * older versions never look at. Until one of them was received the
+ * payloads go in the message.
+ */
+#define ECORE_IPC_SHM_DESC_MAX (4 + 64)
+
+static int
+_ecore_ipc_shm_put(const void *data, int size, unsigned char *desc, Eina_Stringshare **name)
+{
+#ifdef HAVE_SHM_OPEN
+   static unsigned int serial = 0;
+   char file[64];
+   unsigned int v;
+   void *addr;
+   int fd = -1, tries, len;
+
+   for (tries = 0; tries < 8; tries++)
+     {
+        snprintf(file, sizeof(file), "/ecore-ipc-%i-%u-%x",
+                 (int)getpid(), serial++, (unsigned int)rand());
+        fd = shm_open(file, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if ((fd >= 0) || (errno != EEXIST)) break;
+     }
+   if (fd < 0)
+     {
+        WRN("could not create shared memory segment %s: %s", file, strerror(errno));
+        return 0;
+     }
+
+   if (ftruncate(fd, size) < 0) goto error;
+   addr = mmap(NULL, size, PROT_WRITE, MAP_SHARED, fd, 0);
+   if (addr == MAP_FAILED) goto error;
+   memcpy(addr, data, size);
+   munmap(addr, size);
+   close(fd);
+
+   v = eina_htonl(size);
+   memcpy(desc, &v, 4);
+   len = strlen(file) + 1;
+   memcpy(desc + 4, file, len);
+   *name = eina_stringshare_add(file);
+   return 4 + len;
+
+ error:
+   WRN("could not write %d bytes to shared memory segment %s: %s",
+       size, file, strerror(errno));
+   shm_unlink(file);
+   close(fd);
+   return 0;
+#else
+   (void)data;
+   (void)size;
+   (void)desc;
+   (void)name;
+   return 0;
+#endif
+}
+
+static void
+_ecore_ipc_shm_sent(Eina_List **pending, Eina_Stringshare *name, Eina_Bool sent)
+{
+   if (sent)
+     {
+        *pending = eina_list_append(*pending, name);
+        return;
+     }
+#ifdef HAVE_SHM_OPEN
+   shm_unlink(name);
+#endif
+   eina_stringshare_del(name);
+}
+
+static Eina_Bool
+_ecore_ipc_shm_release(Eina_List **pending)
+{
+   Eina_Stringshare *name;
+
+   if (!*pending)
+     {
+        ERR("shared memory segment acknowledged but none is pending");
+        return EINA_FALSE;
+     }
+
+   name = eina_list_data_get(*pending);
+   *pending = eina_list_remove_list(*pending, *pending);
+#ifdef HAVE_SHM_OPEN
+   shm_unlink(name);
+#endif
+   eina_stringshare_del(name);
+   return EINA_TRUE;
+}
+
+static void
+_ecore_ipc_shm_release_all(Eina_List **pending)
+{
+   while (*pending) _ecore_ipc_shm_release(pending);
+}
+
+/* returns the size of the described payload, -1 if invalid */
+static int
+_ecore_ipc_shm_size_get(const unsigned char *desc, int desc_size)
+{
+   unsigned int v;
+
+   if ((desc_size <= 4 + 1) || (desc_size > ECORE_IPC_SHM_DESC_MAX) ||
+       (desc[4] != '/') || (desc[desc_size - 1] != '\0'))
+     return -1;
+
+   memcpy(&v, desc, 4);
+   v = eina_ntohl(v);
+   if ((v == 0) || (v > INT_MAX)) return -1;
+   return v;
+}
+
+static void *
+_ecore_ipc_shm_read(const unsigned char *desc, int size)
+{
+#ifdef HAVE_SHM_OPEN
+   const char *file = (const char *)desc + 4;
+   struct stat st;
+   void *addr, *buf = NULL;
+   int fd;
+
+   fd = shm_open(file, O_RDONLY, 0);
+   if (fd < 0)
+     {
+        WRN("could not open shared memory segment %s: %s", file, strerror(errno));
+        return NULL;
+     }
+
+   if ((fstat(fd, &st) != 0) || (st.st_size < size))
+     {
+        WRN("shared memory segment %s is smaller than %d bytes", file, size);
+        goto end;
+     }
+
+   addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+   if (addr == MAP_FAILED)
+     {
+        WRN("could not map shared memory segment %s: %s", file, strerror(errno));
+        goto end;
+     }
+
+   buf = malloc(size);
+   if (buf) memcpy(buf, addr, size);
+   munmap(addr, size);
+
+ end:
+   close(fd);
+   return buf;
+#else
+   (void)desc;
+   (void)size;
+   return NULL;
+#endif
+}
+
 /* FIXME: need to add protocol type parameter */
 EAPI Ecore_Ipc_Server *
 ecore_ipc_server_add(Ecore_Ipc_Type type, const char *name, int port, const void *data)
@@ -407,6 +580,9 @@ ecore_ipc_server_add(Ecore_Ipc_Type type, const char *name, int port, const void
         svr->server = efl_add(EFL_NET_SERVER_UNIX_CLASS, efl_main_loop_get(),
                               efl_net_server_unix_leading_directories_create_set(efl_added, EINA_TRUE, S_IRUSR | S_IWUSR | S_IXUSR));
         EINA_SAFETY_ON_NULL_GOTO(svr->server, error_server);
+#ifdef HAVE_SHM_OPEN
+        svr->shm_usable = EINA_TRUE;
+#endif
      }
    else if ((type & ECORE_IPC_TYPE) == ECORE_IPC_LOCAL_SYSTEM)
      {
@@ -546,6 +722,8 @@ _ecore_ipc_dialer_del(Ecore_Ipc_Server *svr)
 {
    DBG("dialer %p del", svr);
 
+   _ecore_ipc_shm_release_all(&svr->shm_pending);
+
    if (svr->dialer.recv_copier)
      {
         efl_del(svr->dialer.recv_copier);
@@ -689,6 +867,9 @@ ecore_ipc_server_connect(Ecore_Ipc_Type type, char *name, int port, const void *
 
         svr->dialer.dialer = efl_add(EFL_NET_DIALER_UNIX_CLASS, efl_main_loop_get());
         EINA_SAFETY_ON_NULL_GOTO(svr->dialer.dialer, error_dialer);
+#ifdef HAVE_SHM_OPEN
+        svr->shm_usable = EINA_TRUE;
+#endif
      }
    else if ((type & ECORE_IPC_TYPE) == ECORE_IPC_LOCAL_SYSTEM)
      {
@@ -916,20 +1097,13 @@ ecore_ipc_server_clients_get(Ecore_Ipc_Server *svr)
         s += 1; \
      }
 
-/* FIXME: this needs to become an ipc message */
-EAPI int
-ecore_ipc_server_send(Ecore_Ipc_Server *svr, int major, int minor, int ref, int ref_to, int response, const void *data, int size)
+static int
+_ecore_ipc_server_msg_send(Ecore_Ipc_Server *svr, int flags, int major, int minor, int ref, int ref_to, int response, const void *data, int size)
 {
    Ecore_Ipc_Msg_Head msg;
    int *head, md = 0, d, s;
    unsigned char dat[sizeof(Ecore_Ipc_Msg_Head)];
 
-   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_IPC_SERVER))
-     {
-        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_IPC_SERVER,
-                         "ecore_ipc_server_send");
-        return 0;
-     }
    if (size < 0) size = 0;
    msg.major    = major;
    msg.minor    = minor;
@@ -951,6 +1125,7 @@ ecore_ipc_server_send(Ecore_Ipc_Server *svr, int major, int minor, int ref, int
    *head |= md << (4 * 4);
    SVENC(size);
    *head |= md << (4 * 5);
+   *head |= flags;
    *head = eina_htonl(*head);
    svr->prev.o = msg;
 
@@ -1004,6 +1179,41 @@ ecore_ipc_server_send(Ecore_Ipc_Server *svr, int major, int minor, int ref, int
    return 0;
 }
 
+/* FIXME: this needs to become an ipc message */
+EAPI int
+ecore_ipc_server_send(Ecore_Ipc_Server *svr, int major, int minor, int ref, int ref_to, int response, const void *data, int size)
+{
+   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_IPC_SERVER))
+     {
+        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_IPC_SERVER,
+                         "ecore_ipc_server_send");
+        return 0;
+     }
+
+   if ((svr->shm_peer) && (svr->shm_threshold > 0) &&
+       (data) && (size >= svr->shm_threshold) && (svr->dialer.input))
+     {
+        unsigned char desc[ECORE_IPC_SHM_DESC_MAX];
+        Eina_Stringshare *name;
+        int desc_size, r;
+
+        desc_size = _ecore_ipc_shm_put(data, size, desc, &name);
+        if (desc_size > 0)
+          {
+             r = _ecore_ipc_server_msg_send(svr, ECORE_IPC_HEAD_SHM, major, minor,
+                                            ref, ref_to, response, desc, desc_size);
+             _ecore_ipc_shm_sent(&svr->shm_pending, name, r > 0);
+             /* what the message would have been with the payload */
+             if (r > 0) r += size - desc_size;
+             return r;
+          }
+        /* could not create a segment, fallback to the socket */
+     }
+
+   return _ecore_ipc_server_msg_send(svr, svr->shm_usable ? ECORE_IPC_HEAD_SHM_OK : 0,
+                                     major, minor, ref, ref_to, response, data, size);
+}
+
 EAPI void
 ecore_ipc_server_client_limit_set(Ecore_Ipc_Server *svr, int client_limit, char reject_excess_clients)
 {
@@ -1099,6 +1309,33 @@ ecore_ipc_server_flush(Ecore_Ipc_Server *svr)
      }
 }
 
+EAPI void
+ecore_ipc_server_shm_threshold_set(Ecore_Ipc_Server *svr, int size)
+{
+   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_IPC_SERVER))
+     {
+        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_IPC_SERVER,
+                         "ecore_ipc_server_shm_threshold_set");
+        return;
+     }
+   if (size < 0) size = 0;
+   if ((size > 0) && (!svr->shm_usable))
+     DBG("server %p is not local to the user, shared memory is not used", svr);
+   svr->shm_threshold = size;
+}
+
+EAPI int
+ecore_ipc_server_shm_threshold_get(Ecore_Ipc_Server *svr)
+{
+   if (!ECORE_MAGIC_CHECK(svr, ECORE_MAGIC_IPC_SERVER))
+     {
+        ECORE_MAGIC_FAIL(svr, ECORE_MAGIC_IPC_SERVER,
+                         "ecore_ipc_server_shm_threshold_get");
+        return 0;
+     }
+   return svr->shm_threshold;
+}
+
 #define CLENC(_member) \
    d = _ecore_ipc_dlt_int(msg._member, cl->prev.o._member, &md); \
    if (md >= DLT_SET) \
@@ -1131,20 +1368,13 @@ ecore_ipc_server_flush(Ecore_Ipc_Server *svr)
         s += 1; \
      }
 
-/* FIXME: this needs to become an ipc message */
-EAPI int
-ecore_ipc_client_send(Ecore_Ipc_Client *cl, int major, int minor, int ref, int ref_to, int response, const void *data, int size)
+static int
+_ecore_ipc_client_msg_send(Ecore_Ipc_Client *cl, int flags, int major, int minor, int ref, int ref_to, int response, const void *data, int size)
 {
    Ecore_Ipc_Msg_Head msg;
    int *head, md = 0, d, s;
    unsigned char dat[sizeof(Ecore_Ipc_Msg_Head)];
 
-   if (!ECORE_MAGIC_CHECK(cl, ECORE_MAGIC_IPC_CLIENT))
-     {
-        ECORE_MAGIC_FAIL(cl, ECORE_MAGIC_IPC_CLIENT,
-                         "ecore_ipc_client_send");
-        return 0;
-     }
    if (cl->socket.socket)
      EINA_SAFETY_ON_TRUE_RETURN_VAL(efl_io_closer_closed_get(cl->socket.socket), 0);
    else
@@ -1174,6 +1404,7 @@ ecore_ipc_client_send(Ecore_Ipc_Client *cl, int major, int minor, int ref, int r
    *head |= md << (4 * 4);
    CLENC(size);
    *head |= md << (4 * 5);
+   *head |= flags;
    *head = eina_htonl(*head);
    cl->prev.o = msg;
 
@@ -1221,6 +1452,44 @@ ecore_ipc_client_send(Ecore_Ipc_Client *cl, int major, int minor, int ref, int r
    return 0;
 }
 
+/* FIXME: this needs to become an ipc message */
+EAPI int
+ecore_ipc_client_send(Ecore_Ipc_Client *cl, int major, int minor, int ref, int ref_to, int response, const void *data, int size)
+{
+   Ecore_Ipc_Server *svr;
+
+   if (!ECORE_MAGIC_CHECK(cl, ECORE_MAGIC_IPC_CLIENT))
+     {
+        ECORE_MAGIC_FAIL(cl, ECORE_MAGIC_IPC_CLIENT,
+                         "ecore_ipc_client_send");
+        return 0;
+     }
+
+   svr = cl->svr;
+   if ((svr) && (cl->shm_peer) && (svr->shm_threshold > 0) &&
+       (data) && (size >= svr->shm_threshold) && (cl->socket.input))
+     {
+        unsigned char desc[ECORE_IPC_SHM_DESC_MAX];
+        Eina_Stringshare *name;
+        int desc_size, r;
+
+        desc_size = _ecore_ipc_shm_put(data, size, desc, &name);
+        if (desc_size > 0)
+          {
+             r = _ecore_ipc_client_msg_send(cl, ECORE_IPC_HEAD_SHM, major, minor,
+                                            ref, ref_to, response, desc, desc_size);
+             _ecore_ipc_shm_sent(&cl->shm_pending, name, r > 0);
+             /* what the message would have been with the payload */
+             if (r > 0) r += size - desc_size;
+             return r;
+          }
+        /* could not create a segment, fallback to the socket */
+     }
+
+   return _ecore_ipc_client_msg_send(cl, ((svr) && (svr->shm_usable)) ? ECORE_IPC_HEAD_SHM_OK : 0,
+                                     major, minor, ref, ref_to, response, data, size);
+}
+
 EAPI Ecore_Ipc_Server *
 ecore_ipc_client_server_get(Ecore_Ipc_Client *cl)
 {
@@ -1240,6 +1509,8 @@ _ecore_ipc_client_socket_del(Ecore_Ipc_Client *cl)
 {
    DBG("client %p socket del", cl);
 
+   _ecore_ipc_shm_release_all(&cl->shm_pending);
+
    if (cl->socket.recv_copier)
      {
         efl_del(cl->socket.recv_copier);
@@ -1605,7 +1876,7 @@ ecore_ipc_client_data_process(Ecore_Ipc_Client *cl, void *data, int size, Eina_B
              if ((cl->buf_size - offset) >= (s + msg.size))
                {
                   Ecore_Ipc_Event_Client_Data *e2;
-                  int max, max2;
+                  int max, max2, data_size, shm;
 
                   buf = NULL;
                   max = svr->max_buf_size;
@@ -1618,17 +1889,43 @@ ecore_ipc_client_data_process(Ecore_Ipc_Client *cl, void *data, int size, Eina_B
                     {
                        if (max < 0) max = max2;
                     }
-                  if ((max < 0) || (msg.size <= max))
+                  /* shared memory only goes over local connections, and
+                   * only for segments we are waiting for */
+                  shm = head & ECORE_IPC_HEAD_SHM_OK;
+                  if (((shm) && (!svr->shm_usable)) ||
+                      ((shm == ECORE_IPC_HEAD_SHM_ACK) &&
+                       (!_ecore_ipc_shm_release(&cl->shm_pending))))
+                    {
+                       ERR("client %p sent an unexpected shared memory message, closing it", cl);
+                       free(cl->buf);
+                       cl->buf = NULL;
+                       cl->buf_size = 0;
+                       if (!efl_io_closer_closed_get(cl->socket.socket))
+                         efl_io_closer_close(cl->socket.socket);
+                       return ECORE_CALLBACK_CANCEL;
+                    }
+                  if (shm) cl->shm_peer = EINA_TRUE;
+                  data_size = msg.size;
+                  if (shm == ECORE_IPC_HEAD_SHM)
+                    data_size = _ecore_ipc_shm_size_get(cl->buf + offset + s, msg.size);
+                  if ((shm != ECORE_IPC_HEAD_SHM_ACK) &&
+                      (data_size >= 0) && ((max < 0) || (data_size <= max)))
                     {
                        Eina_Bool need_free = EINA_FALSE;
-                       if (msg.size > 0)
+                       if (shm == ECORE_IPC_HEAD_SHM)
+                         {
+                            buf = _ecore_ipc_shm_read(cl->buf + offset + s, data_size);
+                            need_free = !!buf;
+                         }
+                       else if (msg.size > 0)
                          {
                             buf = malloc(msg.size);
                             if (!buf) return ECORE_CALLBACK_CANCEL;
                             memcpy(buf, cl->buf + offset + s, msg.size);
                             need_free = EINA_TRUE;
                          }
-                       if (!cl->delete_me)
+                       if ((!cl->delete_me) &&
+                           ((buf) || (shm != ECORE_IPC_HEAD_SHM)))
                          {
                             e2 = calloc(1, sizeof(Ecore_Ipc_Event_Client_Data));
                             if (e2)
@@ -1640,7 +1937,7 @@ ecore_ipc_client_data_process(Ecore_Ipc_Client *cl, void *data, int size, Eina_B
                                  e2->ref      = msg.ref;
                                  e2->ref_to   = msg.ref_to;
                                  e2->response = msg.response;
-                                 e2->size     = msg.size;
+                                 e2->size     = data_size;
                                  e2->data     = buf;
                                  ecore_event_add(ECORE_IPC_EVENT_CLIENT_DATA, e2,
                                                  _ecore_ipc_event_client_data_free,
@@ -1650,6 +1947,12 @@ ecore_ipc_client_data_process(Ecore_Ipc_Client *cl, void *data, int size, Eina_B
                          }
                        if (need_free) free(buf);
                     }
+                  /* acknowledge even if dropped, the sender unlinks it */
+                  if (shm == ECORE_IPC_HEAD_SHM)
+                    _ecore_ipc_client_msg_send(cl, ECORE_IPC_HEAD_SHM_ACK,
+                                               cl->prev.o.major, cl->prev.o.minor,
+                                               cl->prev.o.ref, cl->prev.o.ref_to,
+                                               cl->prev.o.response, NULL, 0);
                   cl->prev.i = msg;
                   offset += (s + msg.size);
                   if (cl->buf_size == offset)
@@ -1796,20 +2099,43 @@ ecore_ipc_server_data_process(Ecore_Ipc_Server *svr, void *data, int size, Eina_
              if ((svr->buf_size - offset) >= (s + msg.size))
                {
                   Ecore_Ipc_Event_Server_Data *e2;
-                  int max;
+                  int max, data_size, shm;
 
                   if (buf != svr->buf) free(buf);
                   buf = NULL;
                   max = svr->max_buf_size;
-                  if ((max < 0) || (msg.size <= max))
+                  /* shared memory only goes over local connections, and
+                   * only for segments we are waiting for */
+                  shm = head & ECORE_IPC_HEAD_SHM_OK;
+                  if (((shm) && (!svr->shm_usable)) ||
+                      ((shm == ECORE_IPC_HEAD_SHM_ACK) &&
+                       (!_ecore_ipc_shm_release(&svr->shm_pending))))
+                    {
+                       ERR("server %p sent an unexpected shared memory message, closing it", svr);
+                       free(svr->buf);
+                       svr->buf = NULL;
+                       svr->buf_size = 0;
+                       if (!efl_io_closer_closed_get(svr->dialer.dialer))
+                         efl_io_closer_close(svr->dialer.dialer);
+                       return ECORE_CALLBACK_CANCEL;
+                    }
+                  if (shm) svr->shm_peer = EINA_TRUE;
+                  data_size = msg.size;
+                  if (shm == ECORE_IPC_HEAD_SHM)
+                    data_size = _ecore_ipc_shm_size_get(svr->buf + offset + s, msg.size);
+                  if ((shm != ECORE_IPC_HEAD_SHM_ACK) &&
+                      (data_size >= 0) && ((max < 0) || (data_size <= max)))
                     {
-                       if (msg.size > 0)
+                       if (shm == ECORE_IPC_HEAD_SHM)
+                         buf = _ecore_ipc_shm_read(svr->buf + offset + s, data_size);
+                       else if (msg.size > 0)
                          {
                             buf = malloc(msg.size);
                             if (!buf) return ECORE_CALLBACK_CANCEL;
                             memcpy(buf, svr->buf + offset + s, msg.size);
                          }
-                       if (!svr->delete_me)
+                       if ((!svr->delete_me) &&
+                           ((buf) || (shm != ECORE_IPC_HEAD_SHM)))
                          {
                             e2 = calloc(1, sizeof(Ecore_Ipc_Event_Server_Data));
                             if (e2)
@@ -1821,7 +2147,7 @@ ecore_ipc_server_data_process(Ecore_Ipc_Server *svr, void *data, int size, Eina_
                                  e2->ref      = msg.ref;
                                  e2->ref_to   = msg.ref_to;
                                  e2->response = msg.response;
-                                 e2->size     = msg.size;
+                                 e2->size     = data_size;
                                  e2->data     = buf;
                                  if (buf == svr->buf)
                                    {
@@ -1845,6 +2171,12 @@ ecore_ipc_server_data_process(Ecore_Ipc_Server *svr, void *data, int size, Eina_
                             buf = NULL;
                          }
                     }
+                  /* acknowledge even if dropped, the sender unlinks it */
+                  if (shm == ECORE_IPC_HEAD_SHM)
+                    _ecore_ipc_server_msg_send(svr, ECORE_IPC_HEAD_SHM_ACK,
+                                               svr->prev.o.major, svr->prev.o.minor,
+                                               svr->prev.o.ref, svr->prev.o.ref_to,
+                                               svr->prev.o.response, NULL, 0);
                   svr->prev.i = msg;
                   offset += (s + msg.size);
                   if ((svr->buf_size == offset) && (svr->buf))
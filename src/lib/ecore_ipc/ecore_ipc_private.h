@@ -38,6 +38,13 @@ typedef struct _Ecore_Ipc_Msg_Head Ecore_Ipc_Msg_Head;
 #define ECORE_IPC_TYPE 0x0f
 #define ECORE_IPC_SSL  0xf0
 
+/* flags in the unused high bits of the message head, only 24 bits are
+ * needed to encode the 6 members
+ */
+#define ECORE_IPC_HEAD_SHM     (1 << 24) /* payload describes a shared memory segment */
+#define ECORE_IPC_HEAD_SHM_ACK (1 << 25) /* peer is done with the oldest segment sent */
+#define ECORE_IPC_HEAD_SHM_OK  (ECORE_IPC_HEAD_SHM | ECORE_IPC_HEAD_SHM_ACK) /* plain message, the sender reads segments */
+
 #if (defined (__SUNPRO_C) && __SUNPRO_C < 0x5100)
 # pragma pack(1)
 # define ECORE_IPC_STRUCT_PACKED
@@ -83,9 +90,12 @@ struct _Ecore_Ipc_Client
    struct {
       Ecore_Ipc_Msg_Head i, o;
    } prev;
+
+   Eina_List        *shm_pending;
    
    int               event_count;
    Eina_Bool         delete_me : 1;
+   Eina_Bool         shm_peer : 1;
 };
    
 struct _Ecore_Ipc_Server
@@ -112,9 +122,14 @@ struct _Ecore_Ipc_Server
    struct {
       Ecore_Ipc_Msg_Head i, o;
    } prev;
+
+   Eina_List        *shm_pending;
+   int               shm_threshold;
    
    int               event_count;
    Eina_Bool         delete_me : 1;
+   Eina_Bool         shm_usable : 1;
+   Eina_Bool         shm_peer : 1;
 };
 
 #endif
@@ -222,11 +222,8 @@ _edje_part_pos_set(Edje *ed, Edje_Real_Part *ep, int mode, FLOAT_T pos, FLOAT_T
 
    ep->description_pos = npos;
 
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   ep->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, ep);
 }
 
 /**
@@ -877,11 +874,8 @@ _edje_part_description_apply(Edje *ed, Edje_Real_Part *ep, const char *d1, doubl
      }
 
    ed->recalc_hints = EINA_TRUE;
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   ep->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, ep);
 }
 
 void
@@ -908,6 +902,223 @@ _edje_recalc(Edje *ed)
    evas_object_smart_changed(ed->obj);
 }
 
+void
+_edje_part_dirty(Edje *ed, Edje_Real_Part *ep)
+{
+#ifdef EDJE_CALC_CACHE
+   ep->invalidate = EINA_TRUE;
+   ed->dirty_parts = EINA_TRUE;
+#else
+   (void)ep;
+   ed->dirty = EINA_TRUE;
+#endif
+}
+
+static void
+_edje_calc_deps_part_add(unsigned int *offsets, unsigned short *dependents,
+                         unsigned int count, int from, unsigned short to)
+{
+   unsigned int idx;
+
+   if (from < 0) return;
+   from %= count;
+   if ((unsigned int)from == to) return;
+   if (dependents)
+     {
+        idx = offsets[from]++;
+        dependents[idx] = to;
+     }
+   else offsets[from + 1]++;
+}
+
+static void
+_edje_calc_deps_desc_add(unsigned int *offsets, unsigned short *dependents,
+                         unsigned int count, Edje_Part *ep,
+                         Edje_Part_Description_Common *desc)
+{
+   unsigned short to = ep->id;
+
+   if (!desc) return;
+   _edje_calc_deps_part_add(offsets, dependents, count, desc->rel1.id_x, to);
+   _edje_calc_deps_part_add(offsets, dependents, count, desc->rel1.id_y, to);
+   _edje_calc_deps_part_add(offsets, dependents, count, desc->rel2.id_x, to);
+   _edje_calc_deps_part_add(offsets, dependents, count, desc->rel2.id_y, to);
+   _edje_calc_deps_part_add(offsets, dependents, count, desc->clip_to_id, to);
+   if (desc->map.on)
+     {
+        _edje_calc_deps_part_add(offsets, dependents, count, desc->map.id_persp, to);
+        _edje_calc_deps_part_add(offsets, dependents, count, desc->map.id_light, to);
+        _edje_calc_deps_part_add(offsets, dependents, count, desc->map.rot.id_center, to);
+        _edje_calc_deps_part_add(offsets, dependents, count, desc->map.zoom.id_center, to);
+     }
+   switch (ep->type)
+     {
+      case EDJE_PART_TYPE_PROXY:
+        _edje_calc_deps_part_add(offsets, dependents, count,
+                                 ((Edje_Part_Description_Proxy *)desc)->proxy.id, to);
+        break;
+
+      case EDJE_PART_TYPE_TEXT:
+      case EDJE_PART_TYPE_TEXTBLOCK:
+        _edje_calc_deps_part_add(offsets, dependents, count,
+                                 ((Edje_Part_Description_Text *)desc)->text.id_source, to);
+        _edje_calc_deps_part_add(offsets, dependents, count,
+                                 ((Edje_Part_Description_Text *)desc)->text.id_text_source, to);
+        break;
+
+      default:
+        break;
+     }
+}
+
+static void
+_edje_calc_deps_walk(Edje_Part_Collection *edc,
+                     unsigned int *offsets, unsigned short *dependents)
+{
+   unsigned int i, j;
+
+   for (i = 0; i < edc->parts_count; i++)
+     {
+        Edje_Part *ep = edc->parts[i];
+
+        _edje_calc_deps_part_add(offsets, dependents, edc->parts_count,
+                                 ep->clip_to_id, ep->id);
+        _edje_calc_deps_part_add(offsets, dependents, edc->parts_count,
+                                 ep->dragable.confine_id, ep->id);
+        _edje_calc_deps_part_add(offsets, dependents, edc->parts_count,
+                                 ep->dragable.threshold_id, ep->id);
+        _edje_calc_deps_desc_add(offsets, dependents, edc->parts_count,
+                                 ep, ep->default_desc);
+        for (j = 0; j < ep->other.desc_count; j++)
+          _edje_calc_deps_desc_add(offsets, dependents, edc->parts_count,
+                                   ep, ep->other.desc[j]);
+     }
+}
+
+/*
+ * Build, once per collection, the reverse dependency graph of its parts:
+ * for every part the list of parts whose geometry is computed from it in
+ * any of their states. It is stored in CSR form, dependents of part i
+ * being dependents[offsets[i] .. offsets[i + 1]].
+ */
+void
+_edje_collection_calc_deps_build(Edje_Part_Collection *edc)
+{
+   unsigned int *offsets;
+   unsigned short *dependents;
+   unsigned int i;
+
+   if (edc->calc_deps.offsets) return;
+   if ((!edc->parts_count) || (edc->parts_count > USHRT_MAX)) return;
+
+   offsets = calloc(edc->parts_count + 1, sizeof (unsigned int));
+   if (!offsets) return;
+
+   /* First pass counts, second pass fills using offsets as cursors. */
+   _edje_calc_deps_walk(edc, offsets, NULL);
+   for (i = 0; i < edc->parts_count; i++)
+     offsets[i + 1] += offsets[i];
+
+   dependents = malloc(sizeof (unsigned short) * (offsets[edc->parts_count] + 1));
+   if (!dependents)
+     {
+        free(offsets);
+        return;
+     }
+
+   _edje_calc_deps_walk(edc, offsets, dependents);
+   /* Cursors now point at the end of each list, shift them back. */
+   for (i = edc->parts_count; i > 0; i--)
+     offsets[i] = offsets[i - 1];
+   offsets[0] = 0;
+
+   edc->calc_deps.offsets = offsets;
+   edc->calc_deps.dependents = dependents;
+}
+
+void
+_edje_collection_calc_deps_free(Edje_Part_Collection *edc)
+{
+   free(edc->calc_deps.offsets);
+   free(edc->calc_deps.dependents);
+   edc->calc_deps.offsets = NULL;
+   edc->calc_deps.dependents = NULL;
+}
+
+#ifdef EDJE_CALC_CACHE
+static int _edje_partial_recalc = -1;
+
+/*
+ * Only recalc the parts flagged with _edje_part_dirty() and everything
+ * depending on them. The other parts keep their cached geometry and
+ * evas state and are marked calculated, so that walking the relations
+ * of a dirty part stops at them.
+ */
+static Eina_Bool
+_edje_recalc_table_parts_partial(Edje *ed)
+{
+   const unsigned int *offsets = ed->collection->calc_deps.offsets;
+   const unsigned short *dependents = ed->collection->calc_deps.dependents;
+   unsigned short *stack;
+   unsigned int top = 0, k;
+   unsigned short i;
+   Edje_Real_Part *ep;
+
+   if (_edje_partial_recalc == -1)
+     {
+        const char *s = getenv("EDJE_PARTIAL_RECALC");
+
+        if (s) _edje_partial_recalc = !!atoi(s);
+        else _edje_partial_recalc = 1;
+     }
+   if (!_edje_partial_recalc) return EINA_FALSE;
+   if ((!offsets) || (ed->collection->parts_count != ed->table_parts_size))
+     return EINA_FALSE;
+
+   stack = alloca(sizeof (unsigned short) * ed->table_parts_size);
+   for (i = 0; i < ed->table_parts_size; i++)
+     {
+        ep = ed->table_parts[i];
+        ep->calculating = FLAG_NONE;
+        /* a nested edje has to be recalculated with its parent, its own
+         * parts may have changed without dirtying the swallowing part */
+        if ((ep->invalidate) ||
+            ((ep->type == EDJE_RP_TYPE_SWALLOW) && (ep->typedata.swallow) &&
+             (ep->typedata.swallow->swallowed_object) &&
+             (efl_isa(ep->typedata.swallow->swallowed_object,
+                      EFL_CANVAS_LAYOUT_CLASS))))
+          {
+             ep->calculated = FLAG_NONE;
+             stack[top++] = i;
+          }
+        else
+          ep->calculated = FLAG_XY;
+     }
+
+   /* Every part is pushed at most once, when it leaves FLAG_XY. */
+   while (top > 0)
+     {
+        i = stack[--top];
+        for (k = offsets[i]; k < offsets[i + 1]; k++)
+          {
+             ep = ed->table_parts[dependents[k]];
+             if (ep->calculated == FLAG_NONE) continue;
+             ep->calculated = FLAG_NONE;
+             ep->invalidate = EINA_TRUE;
+             stack[top++] = dependents[k];
+          }
+     }
+
+   for (i = 0; i < ed->table_parts_size; i++)
+     {
+        ep = ed->table_parts[i];
+        if (ep->calculated != FLAG_XY)
+          _edje_part_recalc(ed, ep, (~ep->calculated) & FLAG_XY, NULL);
+     }
+   return EINA_TRUE;
+}
+#endif
+
 static
 #ifdef EDJE_CALC_CACHE
 Eina_Bool
@@ -956,14 +1167,19 @@ _edje_recalc_do(Edje *ed)
    Eina_Bool need_calc;
 #ifdef EDJE_CALC_CACHE
    Eina_Bool need_reinit_state = EINA_FALSE;
+   Eina_Bool partial = EINA_FALSE;
 #endif
 
    ed->has_size = EINA_TRUE;
 
    need_calc = evas_object_smart_need_recalculate_get(ed->obj);
    evas_object_smart_need_recalculate_set(ed->obj, 0);
-   if (!ed->dirty) return;
+   if ((!ed->dirty) && (!ed->dirty_parts)) return;
+#ifdef EDJE_CALC_CACHE
+   partial = !ed->dirty;
+#endif
    ed->dirty = EINA_FALSE;
+   ed->dirty_parts = EINA_FALSE;
    ed->state++;
 
    /* Avoid overflow problem */
@@ -975,7 +1191,16 @@ _edje_recalc_do(Edje *ed)
 #endif
      }
 
+#ifdef EDJE_CALC_CACHE
+   if (partial &&
+       (need_reinit_state || ed->all_part_change || ed->text_part_change ||
+        ed->need_map_update || ed->calc_only || ed->no_partial_recalc))
+     partial = EINA_FALSE;
+   if (EINA_LIKELY(ed->table_parts_size > 0) &&
+       !(partial && _edje_recalc_table_parts_partial(ed)))
+#else
    if (EINA_LIKELY(ed->table_parts_size > 0))
+#endif
 #ifdef EDJE_CALC_CACHE
      need_reinit_state =
 #endif
@@ -1155,7 +1380,7 @@ _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y)
         ep->drag->x = x;
         ep->drag->tmp.x = 0;
         ep->drag->need_reset = 0;
-        ed->dirty = EINA_TRUE;
+        _edje_part_dirty(ed, ep);
         ed->recalc_call = EINA_TRUE;
      }
 
@@ -1164,7 +1389,7 @@ _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y)
         ep->drag->y = y;
         ep->drag->tmp.y = 0;
         ep->drag->need_reset = 0;
-        ed->dirty = EINA_TRUE;
+        _edje_part_dirty(ed, ep);
         ed->recalc_call = EINA_TRUE;
      }
 
@@ -206,10 +206,7 @@ _edje_mouse_up_signal_cb(void *data, const Efl_Event *event)
                   rp->drag->threshold_started_y = EINA_FALSE;
                   rp->drag->need_reset = 1;
                   ed->recalc_call = EINA_TRUE;
-                  ed->dirty = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-                  rp->invalidate = EINA_TRUE;
-#endif
+                  _edje_part_dirty(ed, rp);
                   if (!ignored && rp->drag->started)
                     _edje_seat_emit(ed, ev->device, "drag,stop",
                                     rp->part->name);
@@ -305,10 +302,7 @@ _edje_mouse_move_signal_cb(void *data, const Efl_Event *event)
              if (rp->part->dragable.y)
                rp->drag->tmp.y = ev->cur.y - rp->drag->down.y;
              ed->recalc_call = EINA_TRUE;
-             ed->dirty = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-             rp->invalidate = EINA_TRUE;
-#endif
+             _edje_part_dirty(ed, rp);
           }
         _edje_recalc_do(ed);
 
@@ -330,10 +324,7 @@ _edje_mouse_move_signal_cb(void *data, const Efl_Event *event)
                        rp->drag->started = EINA_TRUE;
                     }
                   ed->recalc_call = EINA_TRUE;
-                  ed->dirty = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-                  rp->invalidate = EINA_TRUE;
-#endif
+                  _edje_part_dirty(ed, rp);
                   _edje_recalc_do(ed);
                }
           }
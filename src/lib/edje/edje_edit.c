@@ -249,6 +249,11 @@ _edje_edit_efl_file_load(Eo *obj, Edje_Edit *eed)
 
    err = efl_file_load(efl_super(obj, MY_CLASS));
    if (err) return err;
+   /* Part relations can be rewritten at any time from here on, so the
+    * dependency graph and the part templates built at load can't be
+    * trusted anymore. */
+   eed->base->no_partial_recalc = EINA_TRUE;
+   if (eed->base->file) _edje_file_proto_disable(eed->base->file);
    /* TODO and maybes:
     *  * The whole point of this thing is keep track of stuff such as
     *    strings to free and who knows what, so we need to take care
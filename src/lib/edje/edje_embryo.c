@@ -2328,6 +2328,7 @@ _edje_embryo_fn_set_state_val(Embryo_Program *ep, Embryo_Cell *params)
 
         GETINT(rp->custom->description->rel1.id_x, params[3]);
         GETINT(rp->custom->description->rel1.id_y, params[4]);
+        ed->no_partial_recalc = EINA_TRUE;
 
         break;
 
@@ -2352,6 +2353,7 @@ _edje_embryo_fn_set_state_val(Embryo_Program *ep, Embryo_Cell *params)
 
         GETINT(rp->custom->description->rel2.id_x, params[3]);
         GETINT(rp->custom->description->rel2.id_y, params[4]);
+        ed->no_partial_recalc = EINA_TRUE;
 
         break;
 
@@ -2634,6 +2636,7 @@ _edje_embryo_fn_set_state_val(Embryo_Program *ep, Embryo_Cell *params)
         CHKPARAM(3);
 
         GETINT(rp->custom->description->map.id_persp, params[3]);
+        ed->no_partial_recalc = EINA_TRUE;
 
         break;
 
@@ -2641,6 +2644,7 @@ _edje_embryo_fn_set_state_val(Embryo_Program *ep, Embryo_Cell *params)
         CHKPARAM(3);
 
         GETINT(rp->custom->description->map.id_light, params[3]);
+        ed->no_partial_recalc = EINA_TRUE;
 
         break;
 
@@ -2648,6 +2652,7 @@ _edje_embryo_fn_set_state_val(Embryo_Program *ep, Embryo_Cell *params)
         CHKPARAM(3);
 
         GETINT(rp->custom->description->map.rot.id_center, params[3]);
+        ed->no_partial_recalc = EINA_TRUE;
 
         break;
 
@@ -714,11 +714,8 @@ _edje_object_part_text_raw_append(Edje *ed, Evas_Object *obj, Edje_Real_Part *rp
              eina_stringshare_replace(&rp->typedata.text->text, text);
           }
      }
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = 1;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -739,12 +736,9 @@ edje_object_part_text_append(Eo *obj, const char *part, const char *text)
    if (!rp) return;
    if ((rp->part->type != EDJE_PART_TYPE_TEXTBLOCK)) return;
    _edje_object_part_text_raw_append(ed, obj, rp, part, text);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
    ed->recalc_hints = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -1012,12 +1006,9 @@ _edje_object_part_text_insert(Edje *ed, Edje_Real_Part *rp, const char *text)
    if ((rp->part->type != EDJE_PART_TYPE_TEXTBLOCK)) return;
    if (rp->part->entry_mode <= EDJE_ENTRY_EDIT_MODE_NONE) return;
    _edje_entry_text_markup_insert(rp, text);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
    ed->recalc_hints = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
 }
 
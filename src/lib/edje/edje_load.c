@@ -754,6 +754,49 @@ _edje_process_physics(Edje *ed)
 }
 #endif
 
+static void
+_edje_part_protos_free(Edje_Part_Proto *protos, unsigned int count)
+{
+   unsigned int i;
+
+   if (!protos) return;
+   for (i = 0; i < count; i++)
+     free(protos[i].styles);
+   free(protos);
+}
+
+void
+_edje_collection_proto_free(Edje_Part_Collection *edc)
+{
+   _edje_part_protos_free(edc->proto.parts, edc->parts_count);
+   edc->proto.parts = NULL;
+   edc->proto.has_state_clip = 0;
+}
+
+static Eina_Bool
+_edje_file_proto_disable_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED,
+                            void *data, void *fdata EINA_UNUSED)
+{
+   Edje_Part_Collection_Directory_Entry *ce = data;
+
+   if (ce->ref) _edje_collection_proto_free(ce->ref);
+   return EINA_TRUE;
+}
+
+void
+_edje_file_proto_disable(Edje_File *edf)
+{
+   Edje_Part_Collection *edc;
+   Eina_List *l;
+
+   if (edf->no_proto) return;
+   edf->no_proto = 1;
+   if (edf->collection)
+     eina_hash_foreach(edf->collection, _edje_file_proto_disable_cb, NULL);
+   EINA_LIST_FOREACH(edf->collection_cache, l, edc)
+     _edje_collection_proto_free(edc);
+}
+
 Eina_Error
 _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const char *group, const char *parent, Eina_List *group_path, Eina_Array *nested)
 {
@@ -771,6 +814,7 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
    char lang[PATH_MAX];
    Eina_Bool had_file;
    Eina_Hash *part_match = NULL;
+   Edje_Part_Proto *proto = NULL, *rec = NULL;
 
    /* Get data pointer of top-of-stack */
    int idx = eina_array_count(nested) - 1;
@@ -865,6 +909,19 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
              /* sizeclass stuff */
              _edje_process_sizeclass(ed);
 
+             /* left to right instances of a collection start all the same,
+              * record what they derive from the collection once and reuse it
+              * for the following ones. Only that lookup work is shared: the
+              * real parts, their evas objects and callbacks are still made
+              * one by one for each instance as evas can't clone objects. */
+             if ((!ed->file->no_proto) && (!edje_object_mirrored_get(obj)))
+               {
+                  if (ed->collection->proto.parts)
+                    proto = ed->collection->proto.parts;
+                  else
+                    rec = calloc(ed->collection->parts_count, sizeof (Edje_Part_Proto));
+               }
+
              /* build real parts */
              for (n = 0; n < ed->collection->parts_count; n++)
                {
@@ -952,6 +1009,7 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
 
                   if (memerr)
                     {
+                       _edje_part_protos_free(rec, n);
                        if (rp->drag) free(rp->drag);
                        ed->load_error = EDJE_LOAD_ERROR_RESOURCE_ALLOCATION_FAILED;
                        eina_mempool_free(_edje_real_part_mp, rp);
@@ -963,8 +1021,11 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
                   _edje_ref(ed);
                   rp->part = ep;
                   eina_array_push(&parts, rp);
-                  rp->param1.description =
-                    _edje_part_description_find(ed, rp, "default", 0.0, EINA_TRUE);
+                  if (proto)
+                    rp->param1.description = proto[n].desc;
+                  else
+                    rp->param1.description =
+                      _edje_part_description_find(ed, rp, "default", 0.0, EINA_TRUE);
                   rp->chosen_description = rp->param1.description;
                   if (!rp->param1.description)
                     ERR("no default part description for '%s'!",
@@ -1014,7 +1075,14 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
                        break;
 
                      case EDJE_PART_TYPE_TEXTBLOCK:
-                       _edje_textblock_styles_add(ed, rp);
+                       if (rec)
+                         rec[n].styles = _edje_textblock_styles_collect(ed, ep, &rec[n].styles_count);
+                       if (proto)
+                         _edje_textblock_styles_proto_add(ed, proto[n].styles, proto[n].styles_count);
+                       else if (rec && rec[n].styles)
+                         _edje_textblock_styles_proto_add(ed, rec[n].styles, rec[n].styles_count);
+                       else
+                         _edje_textblock_styles_add(ed, rp);
                        textblocks = eina_list_append(textblocks, rp);
                        rp->object = evas_object_textblock_add(ed->base.evas);
                        break;
@@ -1134,28 +1202,42 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
                   for (i = 0; i < ed->table_parts_size; i++)
                     {
                        Edje_Real_Part *clip_to = NULL;
+                       int clip_id = -1;
 
                        rp = ed->table_parts[i];
-                       if (rp->param1.description)   /* FIXME: prevent rel to gone radient part to go wrong. You may
-                                                        be able to remove this when all theme are correctly rewritten. */
+                       if (proto)
+                         clip_id = proto[i].clip_to;
+                       else
                          {
-                            if (rp->param1.description->rel1.id_x >= 0)
-                              rp->param1.description->rel1.id_x %= ed->table_parts_size;
-                            if (rp->param1.description->rel1.id_y >= 0)
-                              rp->param1.description->rel1.id_y %= ed->table_parts_size;
-                            if (rp->param1.description->rel2.id_x >= 0)
-                              rp->param1.description->rel2.id_x %= ed->table_parts_size;
-                            if (rp->param1.description->rel2.id_y >= 0)
-                              rp->param1.description->rel2.id_y %= ed->table_parts_size;
-                         }
+                            if (rp->param1.description)   /* FIXME: prevent rel to gone radient part to go wrong. You may
+                                                             be able to remove this when all theme are correctly rewritten. */
+                              {
+                                 if (rp->param1.description->rel1.id_x >= 0)
+                                   rp->param1.description->rel1.id_x %= ed->table_parts_size;
+                                 if (rp->param1.description->rel1.id_y >= 0)
+                                   rp->param1.description->rel1.id_y %= ed->table_parts_size;
+                                 if (rp->param1.description->rel2.id_x >= 0)
+                                   rp->param1.description->rel2.id_x %= ed->table_parts_size;
+                                 if (rp->param1.description->rel2.id_y >= 0)
+                                   rp->param1.description->rel2.id_y %= ed->table_parts_size;
+                              }
 
-                       if (rp->param1.description && (rp->param1.description->clip_to_id >= 0))
-                         {
-                            clip_to = ed->table_parts[rp->param1.description->clip_to_id % ed->table_parts_size];
-                            ed->has_state_clip = EINA_TRUE;
+                            if (rp->param1.description && (rp->param1.description->clip_to_id >= 0))
+                              {
+                                 clip_id = rp->param1.description->clip_to_id % ed->table_parts_size;
+                                 ed->has_state_clip = EINA_TRUE;
+                              }
+                            else if (rp->part->clip_to_id >= 0)
+                              clip_id = rp->part->clip_to_id % ed->table_parts_size;
+                            if (rec)
+                              {
+                                 rec[i].desc = rp->param1.description;
+                                 rec[i].clip_to = clip_id;
+                                 rec[i].text_source = -1;
+                                 rec[i].text_text_source = -1;
+                              }
                          }
-                       else if (rp->part->clip_to_id >= 0)
-                         clip_to = ed->table_parts[rp->part->clip_to_id % ed->table_parts_size];
+                       if (clip_id >= 0) clip_to = ed->table_parts[clip_id];
                        if (clip_to && clip_to->object && rp->object)
                          {
                             evas_object_pass_events_set(clip_to->object, 1);
@@ -1186,7 +1268,20 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
                             Edje_Part_Description_Text *text;
 
                             text = (Edje_Part_Description_Text *)rp->param1.description;
-                            if (text)
+                            if (proto)
+                              {
+                                 if ((rp->type == EDJE_RP_TYPE_TEXT) &&
+                                     (rp->typedata.text))
+                                   {
+                                      if (proto[i].text_source >= 0)
+                                        rp->typedata.text->source =
+                                          ed->table_parts[proto[i].text_source];
+                                      if (proto[i].text_text_source >= 0)
+                                        rp->typedata.text->text_source =
+                                          ed->table_parts[proto[i].text_text_source];
+                                   }
+                              }
+                            else if (text)
                               {
                                  if (ed->file->feature_ver < 1)
                                    {
@@ -1201,12 +1296,14 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
                                         {
                                            rp->typedata.text->source =
                                              ed->table_parts[text->text.id_source % ed->table_parts_size];
+                                           if (rec) rec[i].text_source = text->text.id_source % ed->table_parts_size;
                                         }
 
                                       if (text->text.id_text_source >= 0)
                                         {
                                            rp->typedata.text->text_source =
                                              ed->table_parts[text->text.id_text_source % ed->table_parts_size];
+                                           if (rec) rec[i].text_text_source = text->text.id_text_source % ed->table_parts_size;
                                         }
                                    }
                               }
@@ -1221,6 +1318,16 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
                          }
                     }
                }
+             if (proto)
+               ed->has_state_clip = ed->collection->proto.has_state_clip;
+             else if (rec)
+               {
+                  ed->collection->proto.parts = rec;
+                  ed->collection->proto.has_state_clip = ed->has_state_clip;
+                  rec = NULL;
+               }
+
+             _edje_collection_calc_deps_build(ed->collection);
 
              _edje_ref(ed);
              _edje_block(ed);
@@ -1659,6 +1766,7 @@ _edje_object_file_set_internal(Evas_Object *obj, const Eina_File *file, const ch
    return EFL_GFX_IMAGE_LOAD_ERROR_GENERIC;
 
 on_error:
+   if (ed->collection) _edje_part_protos_free(rec, ed->collection->parts_count);
    eina_list_free(textblocks);
    eina_list_free(externals);
    eina_list_free(sources);
@@ -2267,6 +2375,8 @@ _edje_collection_free(Edje_File *edf, Edje_Part_Collection *ec, Edje_Part_Collec
    unsigned int i;
 
    _edje_embryo_script_shutdown(ec);
+   _edje_collection_calc_deps_free(ec);
+   _edje_collection_proto_free(ec);
 
 #define EDJE_LOAD_PROGRAM_FREE(Array, Ec, It, FreeStrings)    \
   for (It = 0; It < Ec->programs.Array##_count; ++It)         \
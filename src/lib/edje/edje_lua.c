@@ -3138,6 +3138,7 @@ _edje_lua_description_set_rel1_to(lua_State *L)
    lua_rawgeti(L, 2, 2);
    obj->rp->custom->description->rel1.id_x = luaL_checknumber(L, -2);
    obj->rp->custom->description->rel1.id_y = luaL_checknumber(L, -1);
+   obj->ed->no_partial_recalc = EINA_TRUE;
    if (obj->rp->param1.description->rel1.id_x >= 0)
      obj->rp->param1.rel1_to_x = obj->ed->table_parts[obj->rp->param1.description->rel1.id_x % obj->ed->table_parts_size];
    if (obj->rp->param1.description->rel1.id_y >= 0)
@@ -3184,6 +3185,7 @@ _edje_lua_description_set_rel2_to(lua_State *L)
    lua_rawgeti(L, 2, 2);
    obj->rp->custom->description->rel2.id_x = luaL_checknumber(L, -2);
    obj->rp->custom->description->rel2.id_y = luaL_checknumber(L, -1);
+   obj->ed->no_partial_recalc = EINA_TRUE;
    if (obj->rp->param1.description->rel2.id_x >= 0)
      obj->rp->param1.rel2_to_x = obj->ed->table_parts[obj->rp->param1.description->rel2.id_x % obj->ed->table_parts_size];
    if (obj->rp->param1.description->rel2.id_y >= 0)
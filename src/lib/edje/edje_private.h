@@ -306,6 +306,7 @@ typedef struct _Edje_String                          Edje_String;
 
 typedef struct _Edje_File                            Edje_File;
 typedef struct _Edje_Style                           Edje_Style;
+typedef struct _Edje_Part_Proto                      Edje_Part_Proto;
 typedef struct _Edje_Style_Tag                       Edje_Style_Tag;
 typedef struct _Edje_External_Directory              Edje_External_Directory;
 typedef struct _Edje_External_Directory_Entry        Edje_External_Directory_Entry;
@@ -596,6 +597,7 @@ struct _Edje_File
    unsigned char                   dangling : 1;
    unsigned char                   warning : 1;
    unsigned char                   has_textblock_min_max : 1;
+   unsigned char                   no_proto : 1; /* collections may be edited, don't template them */
 };
 
 struct _Edje_Style
@@ -1072,6 +1074,20 @@ struct _Edje_Signal_Callback_Group
 
 /*----------*/
 
+/* What an instance computes for a part out of the collection at load time,
+ * before any user change. It only depends on the collection, so it is
+ * recorded once and reused by the following left to right instances. The
+ * descriptions it points to belong to the collection, nothing is copied. */
+struct _Edje_Part_Proto
+{
+   Edje_Part_Description_Common *desc; /* default state */
+   Edje_Style                  **styles; /* textblock styles of every state */
+   unsigned int                  styles_count;
+   int                           clip_to; /* real part id, -1 for the edje clipper */
+   int                           text_source; /* -1 if none */
+   int                           text_text_source; /* -1 if none */
+};
+
 struct _Edje_Part_Collection
 {
    Edje_Part **parts; /* an array of Edje_Part */
@@ -1147,6 +1163,16 @@ struct _Edje_Part_Collection
       Edje_Program **table_programs;
       int            table_programs_size;
    } patterns;
+
+   struct { /* real parts template, recorded by the first instance */
+      Edje_Part_Proto *parts; /* parts_count entries */
+      unsigned char    has_state_clip : 1;
+   } proto;
+
+   struct { /* reverse part dependencies (rel, clip, map, proxy, text source, drag) */
+      unsigned int   *offsets; /* parts_count + 1 entries into dependents */
+      unsigned short *dependents;
+   } calc_deps;
    /* *** *** */
 
    struct {
@@ -1645,6 +1671,7 @@ struct _Edje
 
    Eina_Bool          is_rtl : 1;
    Eina_Bool          dirty : 1;
+   Eina_Bool          dirty_parts : 1; /* only parts flagged by _edje_part_dirty() changed */
    Eina_Bool          recalc : 1;
    Eina_Bool          delete_callbacks : 1;
    Eina_Bool          just_added_callbacks : 1;
@@ -1676,6 +1703,7 @@ struct _Edje
    Eina_Bool          all_part_change : 1;
 #endif
    Eina_Bool          has_size : 1;
+   Eina_Bool          no_partial_recalc : 1; /* relations may change under us (edje_edit, custom states) */
 };
 
 struct _Edje_Calc_Params_Map
@@ -2429,6 +2457,11 @@ Edje_Part_Description_Common *_edje_part_description_find(Edje *ed,
 void  _edje_part_description_apply(Edje *ed, Edje_Real_Part *ep, const char  *d1, double v1, const char *d2, double v2);
 void  _edje_recalc(Edje *ed);
 void  _edje_recalc_do(Edje *ed);
+void  _edje_part_dirty(Edje *ed, Edje_Real_Part *ep);
+void  _edje_collection_calc_deps_build(Edje_Part_Collection *edc);
+void  _edje_collection_calc_deps_free(Edje_Part_Collection *edc);
+void  _edje_collection_proto_free(Edje_Part_Collection *edc);
+void  _edje_file_proto_disable(Edje_File *edf);
 int   _edje_part_dragable_calc(Edje *ed, Edje_Real_Part *ep, FLOAT_T *x, FLOAT_T *y);
 void  _edje_dragable_pos_set(Edje *ed, Edje_Real_Part *ep, FLOAT_T x, FLOAT_T y);
 
@@ -2662,6 +2695,8 @@ void          _edje_message_del             (Edje *ed);
 // Edje object level textblock style api
 Evas_Textblock_Style * _edje_textblock_style_get(Edje *ed, const char *style);
 void _edje_textblock_styles_add(Edje *ed, Edje_Real_Part *ep);
+Edje_Style **_edje_textblock_styles_collect(Edje *ed, Edje_Part *pt, unsigned int *count);
+void _edje_textblock_styles_proto_add(Edje *ed, Edje_Style **styles, unsigned int count);
 void _edje_textblock_styles_del(Edje *ed, Edje_Part *pt);
 void _edje_object_textblock_style_all_update_text_class(Edje *ed, const char *text_class);
 void _edje_object_textblock_styles_cache_cleanup(Edje *ed);
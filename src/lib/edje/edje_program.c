@@ -2079,10 +2079,7 @@ _edje_param_native_set(Edje *ed, Edje_Real_Part *rp, const char *name, const Edj
                     return EINA_FALSE;
                   rp->drag->size.x = FROM_DOUBLE(CLAMP(param->d, 0.0, 1.0));
                   ed->recalc_call = EINA_TRUE;
-                  ed->dirty = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-                  rp->invalidate = EINA_TRUE;
-#endif
+                  _edje_part_dirty(ed, rp);
                   _edje_recalc(ed);
                   return EINA_TRUE;
                }
@@ -2092,10 +2089,7 @@ _edje_param_native_set(Edje *ed, Edje_Real_Part *rp, const char *name, const Edj
                     return EINA_FALSE;
                   rp->drag->size.y = FROM_DOUBLE(CLAMP(param->d, 0.0, 1.0));
                   ed->recalc_call = EINA_TRUE;
-                  ed->dirty = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-                  rp->invalidate = EINA_TRUE;
-#endif
+                  _edje_part_dirty(ed, rp);
                   _edje_recalc(ed);
                   return EINA_TRUE;
                }
@@ -386,6 +386,44 @@ _edje_textblock_styles_add(Edje *ed, Edje_Real_Part *ep)
      }
 }
 
+/* Resolve once the styles _edje_textblock_styles_add() looks up, in the
+ * same order and with the same duplicates, for a part template. */
+Edje_Style **
+_edje_textblock_styles_collect(Edje *ed, Edje_Part *pt, unsigned int *count)
+{
+   Edje_Part_Description_Text *desc;
+   Edje_Style **styles;
+   unsigned int i, n = 0;
+
+   *count = 0;
+   if (pt->type != EDJE_PART_TYPE_TEXTBLOCK) return NULL;
+
+   styles = malloc(sizeof (Edje_Style *) * (pt->other.desc_count + 1));
+   if (!styles) return NULL;
+
+   desc = (Edje_Part_Description_Text *)pt->default_desc;
+   styles[n] = _edje_textblock_style_search(ed, edje_string_get(&desc->text.style));
+   if (styles[n]) n++;
+   for (i = 0; i < pt->other.desc_count; ++i)
+     {
+        desc = (Edje_Part_Description_Text *)pt->other.desc[i];
+        styles[n] = _edje_textblock_style_search(ed, edje_string_get(&desc->text.style));
+        if (styles[n]) n++;
+     }
+
+   *count = n;
+   return styles;
+}
+
+void
+_edje_textblock_styles_proto_add(Edje *ed, Edje_Style **styles, unsigned int count)
+{
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     _edje_textblock_style_add(ed, styles[i]);
+}
+
 void
 _edje_textblock_styles_del(Edje *ed, Edje_Part *pt)
 {
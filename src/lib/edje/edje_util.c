@@ -150,11 +150,8 @@ _edje_user_definition_free(Edje_User_Defined *eud)
                   rp->typedata.swallow->swallow_params.max.w = 0;
                   rp->typedata.swallow->swallow_params.max.h = 0;
                }
-             eud->ed->dirty = EINA_TRUE;
              eud->ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-             rp->invalidate = EINA_TRUE;
-#endif
+             _edje_part_dirty(eud->ed, rp);
              /* this seems to be as unnecessary as the one in part_unswallow()
               * cedric, 1 February 2016
               */
@@ -2169,12 +2166,9 @@ _edje_object_part_text_raw_generic_set(Edje *ed, Evas_Object *obj, Edje_Real_Par
              free(mkup);
           }
      }
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
    ed->recalc_hints = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
    if (ed->text_change.func)
      ed->text_change.func(ed->text_change.data, obj, part);
@@ -3571,11 +3565,8 @@ _efl_canvas_layout_content_remove(Eo *obj EINA_UNUSED, Edje *ed, Evas_Object *ob
    rp->typedata.swallow->swallow_params.min.h = 0;
    rp->typedata.swallow->swallow_params.max.w = 0;
    rp->typedata.swallow->swallow_params.max.h = 0;
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    /* this seems to be as unnecessary as the calc in part_swallow()
     * -zmike, 6 April 2015
     */
@@ -4234,11 +4225,8 @@ _edje_object_part_drag_size_set(Edje *ed, const char *part, double dw, double dh
      }
    rp->drag->size.x = FROM_DOUBLE(dw);
    rp->drag->size.y = FROM_DOUBLE(dh);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
 
    return EINA_TRUE;
@@ -4901,11 +4889,8 @@ _edje_child_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *child, void *ei
             }
        }
 
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
 }
 
@@ -4916,11 +4901,8 @@ _edje_child_add(Edje *ed, Edje_Real_Part *rp, Evas_Object *child)
    evas_object_data_set(child, ".edje", ed);
    if (!ed) return;
    efl_parent_set(child, ed->obj);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
 }
 
@@ -4950,11 +4932,8 @@ _edje_child_remove(Edje *ed, Edje_Real_Part *rp, Evas_Object *child)
    evas_object_data_del(child, ".edje");
    if (!ed) return;
    _eo_unparent_helper(child, ed->obj);
-   ed->dirty = EINA_TRUE;
    ed->recalc_call = EINA_TRUE;
-#ifdef EDJE_CALC_CACHE
-   rp->invalidate = EINA_TRUE;
-#endif
+   _edje_part_dirty(ed, rp);
    _edje_recalc(ed);
 }
 
@@ -242,6 +242,7 @@ typedef enum _Eet_Compression
    EET_COMPRESSION_HI        = 9,  /**< Slow but high compression level (Zlib) @since 1.7 */
    EET_COMPRESSION_VERYFAST  = 10, /**< Very fast, but lower compression ratio (LZ4HC) @since 1.7 */
    EET_COMPRESSION_SUPERFAST = 11, /**< Very fast, but lower compression ratio (faster to compress than EET_COMPRESSION_VERYFAST)  (LZ4) @since 1.7 */
+   EET_COMPRESSION_ZSTD      = 12, /**< Better ratio than Zlib, decompresses almost as fast as LZ4 (Zstandard) @since 1.24 */
 
    EET_COMPRESSION_LOW2      = 3,  /**< Space filler for compatibility. Don't use it @since 1.7 */
    EET_COMPRESSION_MED1      = 4,  /**< Space filler for compatibility. Don't use it @since 1.7 */
@@ -951,6 +952,39 @@ EAPI Eina_Iterator *eet_list_entries(Eet_File *ef);
 EAPI int
 eet_num_entries(Eet_File *ef);
 
+/**
+ * @def EET_COMPRESSION_DICT_KEY
+ * Name of the entry holding the dictionary set by
+ * eet_compression_dict_set().
+ * @since 1.24
+ */
+#define EET_COMPRESSION_DICT_KEY "eet/compression/dictionary"
+
+/**
+ * @ingroup Eet_File_Group
+ * @brief Sets the dictionary shared by the compressed entries of an eet file.
+ * @param ef A valid eet file handle opened for writing.
+ * @param data The dictionary, as built by emile_compress_dict_train().
+ * @param size Length in bytes of the dictionary.
+ * @return EINA_TRUE on success, EINA_FALSE if the file already has a
+ *         dictionary or if Zstandard support was not built in.
+ *
+ * The dictionary is stored in the file as the #EET_COMPRESSION_DICT_KEY
+ * entry and used by all following writes with #EET_COMPRESSION_ZSTD.
+ * It pays off for files made of many small and similar entries, like
+ * edje collections or configuration blobs. Readers find it on their
+ * own.
+ *
+ * It can only be set once per file, so set it before writing the
+ * entries it is meant for. Entries written before it still read fine.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Bool
+eet_compression_dict_set(Eet_File   *ef,
+                         const void *data,
+                         int         size);
+
 /**
  * @defgroup Eet_File_Cipher_Group Eet File Ciphered Main Functions
  * @ingroup Eet_File_Group
@@ -95,9 +95,12 @@ struct _Eet_File
 
    Eina_Lock            file_lock;
 
+   Emile_Compress_Dict *zdict; /* shared by the Zstandard entries */
+
    unsigned char        writes_pending : 1;
    unsigned char        delete_me_now : 1;
    unsigned char        readfp_owned : 1;
+   unsigned char        zdict_loaded : 1;
 };
 
 struct _Eet_File_Header
@@ -334,6 +337,7 @@ eet_2_emile_compressor(int comp)
      {
       case EET_COMPRESSION_VERYFAST: return EMILE_LZ4HC;
       case EET_COMPRESSION_SUPERFAST: return EMILE_LZ4;
+      case EET_COMPRESSION_ZSTD: return EMILE_ZSTD;
       default: return EMILE_ZLIB;
      }
 }
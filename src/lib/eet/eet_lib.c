@@ -79,6 +79,13 @@ static Eet_File_Node *
 static Eina_Binbuf *
 read_binbuf_from_disk(Eet_File      *ef,
                       Eet_File_Node *efn);
+static Emile_Compress_Dict *
+eet_compression_dict_find(Eet_File *ef,
+                          int       comp);
+static Eina_Binbuf *
+eet_decompress(Eet_File      *ef,
+               Eet_File_Node *efn,
+               Eina_Binbuf   *in);
 
 static Eet_Error
 eet_internal_close(Eet_File *ef, Eina_Bool locked, Eina_Bool shutdown);
@@ -774,6 +781,12 @@ eet_internal_read2(Eet_File *ef)
                       ef->data_size, ef))
      return NULL;
 
+   /* the whole directory and dictionary are walked right below, fault them
+    * in with one call instead of a page at a time */
+   if (ef->readfp)
+     eina_file_map_populate(ef->readfp, EINA_FILE_POPULATE, ef->data, 0,
+                            bytes_directory_entries + bytes_dictionary_entries);
+
    /* allocate header */
    ef->header = eet_file_header_calloc(1);
    if (eet_test_close(!ef->header, ef))
@@ -1355,6 +1368,7 @@ eet_internal_close(Eet_File *ef,
      }
 
    eet_dictionary_free(ef->ed);
+   emile_compress_dict_free(ef->zdict);
 
    if (ef->sha1)
      free(ef->sha1);
@@ -1413,6 +1427,8 @@ eet_memopen_read(const void *data,
    ef->data_size = size;
    ef->sha1 = NULL;
    ef->sha1_length = 0;
+   ef->zdict = NULL;
+   ef->zdict_loaded = 0;
    ef->readfp_owned = EINA_FALSE;
 
    ef = eet_internal_read(ef);
@@ -1472,6 +1488,8 @@ eet_mmap(const Eina_File *file)
    ef->data_size = 0;
    ef->sha1 = NULL;
    ef->sha1_length = 0;
+   ef->zdict = NULL;
+   ef->zdict_loaded = 0;
    ef->readfp_owned = EINA_TRUE;
 
    ef->data_size = eina_file_size_get(ef->readfp);
@@ -1619,6 +1637,8 @@ open_error:
    ef->data_size = 0;
    ef->sha1 = NULL;
    ef->sha1_length = 0;
+   ef->zdict = NULL;
+   ef->zdict_loaded = 0;
    ef->readfp_owned = EINA_TRUE;
 
    ef->ed = (mode == EET_FILE_MODE_WRITE)
@@ -1962,9 +1982,7 @@ eet_read_cipher(Eet_File   *ef,
      {
         Eina_Binbuf *out;
 
-        out = emile_decompress(in,
-                               eet_2_emile_compressor(efn->compression_type),
-                               efn->data_size);
+        out = eet_decompress(ef, efn, in);
 
         eina_binbuf_free(in);
         if (!out) goto on_error;
@@ -2063,9 +2081,7 @@ eet_read_direct(Eet_File   *ef,
              in = read_binbuf_from_disk(ef, efn);
              if (!in) goto on_error;
 
-             out = emile_decompress(in,
-                                    eet_2_emile_compressor(efn->compression_type),
-                                    efn->data_size);
+             out = eet_decompress(ef, efn, in);
              eina_binbuf_free(in);
              if (!out) goto on_error;
 
@@ -2165,9 +2181,7 @@ eet_alias_get(Eet_File   *ef,
         in = read_binbuf_from_disk(ef, efn);
         if (!in) goto on_error;
 
-        out = emile_decompress(in,
-                               eet_2_emile_compressor(efn->compression_type),
-                               efn->data_size);
+        out = eet_decompress(ef, efn, in);
         eina_binbuf_free(in);
         if (!out) goto on_error;
 
@@ -2283,9 +2297,10 @@ eet_alias(Eet_File   *ef,
      {
         Eina_Binbuf *out;
 
-        out = emile_compress(in,
-                             eet_2_emile_compressor(comp),
-                             EMILE_COMPRESSOR_BEST);
+        out = emile_compress_dict(in,
+                                  eet_2_emile_compressor(comp),
+                                  EMILE_COMPRESSOR_BEST,
+                                  eet_compression_dict_find(ef, comp));
         eina_binbuf_free(in);
         if (!out) goto on_error;
 
@@ -2346,6 +2361,7 @@ eet_write_cipher(Eet_File   *ef,
                  int         comp,
                  const char *cipher_key)
 {
+   Emile_Compress_Dict *zdict;
    Eina_Binbuf *in;
    Eet_File_Node *efn;
    int exists_already = 0;
@@ -2398,6 +2414,8 @@ eet_write_cipher(Eet_File   *ef,
    /* figure hash bucket */
    hash = _eet_hash_gen(name, ef->header->directory->size);
 
+   zdict = eet_compression_dict_find(ef, comp);
+
    UNLOCK_FILE(ef);
 
    in = eina_binbuf_manage_new(data, size, EINA_TRUE);
@@ -2405,7 +2423,8 @@ eet_write_cipher(Eet_File   *ef,
      {
         Eina_Binbuf *out;
 
-        out = emile_compress(in, eet_2_emile_compressor(comp), EMILE_COMPRESSOR_BEST);
+        out = emile_compress_dict(in, eet_2_emile_compressor(comp),
+                                  EMILE_COMPRESSOR_BEST, zdict);
         if (out)
           {
              if (eina_binbuf_length_get(out) < eina_binbuf_length_get(in))
@@ -2498,6 +2517,51 @@ eet_write(Eet_File   *ef,
    return eet_write_cipher(ef, name, data, size, comp, NULL);
 }
 
+EAPI Eina_Bool
+eet_compression_dict_set(Eet_File   *ef,
+                         const void *data,
+                         int         size)
+{
+   Emile_Compress_Dict *zdict;
+   Eina_Binbuf *in;
+
+   /* check to see its' an eet file pointer */
+   if (eet_check_pointer(ef))
+     return EINA_FALSE;
+
+   if ((!data) || (size <= 0))
+     return EINA_FALSE;
+
+   if ((ef->mode != EET_FILE_MODE_WRITE) &&
+       (ef->mode != EET_FILE_MODE_READ_WRITE))
+     return EINA_FALSE;
+
+   /* entries written with the previous one would not decompress anymore */
+   LOCK_FILE(ef);
+   zdict = eet_compression_dict_find(ef, EET_COMPRESSION_ZSTD);
+   UNLOCK_FILE(ef);
+   if (zdict) return EINA_FALSE;
+
+   in = eina_binbuf_manage_new(data, size, EINA_TRUE);
+   if (!in) return EINA_FALSE;
+   zdict = emile_compress_dict_new(EMILE_ZSTD, in);
+   eina_binbuf_free(in);
+   if (!zdict) return EINA_FALSE;
+
+   if (!eet_write_cipher(ef, EET_COMPRESSION_DICT_KEY, data, size, 0, NULL))
+     {
+        emile_compress_dict_free(zdict);
+        return EINA_FALSE;
+     }
+
+   LOCK_FILE(ef);
+   ef->zdict = zdict;
+   ef->zdict_loaded = 1;
+   UNLOCK_FILE(ef);
+
+   return EINA_TRUE;
+}
+
 EAPI int
 eet_delete(Eet_File   *ef,
            const char *name)
@@ -2815,6 +2879,44 @@ find_node_by_name(Eet_File   *ef,
    return NULL;
 }
 
+/* The dictionary lives in the file as a plain entry and is only loaded
+ * the first time a Zstandard entry needs it. Called with the file lock
+ * held. */
+static Emile_Compress_Dict *
+eet_compression_dict_find(Eet_File *ef,
+                          int       comp)
+{
+   Eet_File_Node *efn;
+   Eina_Binbuf *in;
+
+   if (comp != EET_COMPRESSION_ZSTD) return NULL;
+   if (ef->zdict_loaded) return ef->zdict;
+
+   ef->zdict_loaded = 1;
+   if (!ef->header || !ef->header->directory) return NULL;
+
+   efn = find_node_by_name(ef, EET_COMPRESSION_DICT_KEY);
+   if ((!efn) || (efn->compression) || (efn->ciphered)) return NULL;
+
+   in = read_binbuf_from_disk(ef, efn);
+   if (!in) return NULL;
+   ef->zdict = emile_compress_dict_new(EMILE_ZSTD, in);
+   eina_binbuf_free(in);
+
+   return ef->zdict;
+}
+
+static Eina_Binbuf *
+eet_decompress(Eet_File      *ef,
+               Eet_File_Node *efn,
+               Eina_Binbuf   *in)
+{
+   return emile_decompress_dict(in,
+                                eet_2_emile_compressor(efn->compression_type),
+                                efn->data_size,
+                                eet_compression_dict_find(ef, efn->compression_type));
+}
+
 static Eina_Binbuf *
 read_binbuf_from_disk(Eet_File      *ef,
                       Eet_File_Node *efn)
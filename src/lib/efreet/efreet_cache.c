@@ -7,6 +7,7 @@
  *       browsing.
  */
 
+#include <stdio.h>
 #include <libgen.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -29,11 +30,28 @@ static int _efreet_cache_log_dom = -1;
 #define NON_EXISTING (void *)-1
 
 typedef struct _Efreet_Old_Cache Efreet_Old_Cache;
+typedef struct _Efreet_Icon_Index Efreet_Icon_Index;
+typedef struct _Efreet_Ipc_Message Efreet_Ipc_Message;
+
+struct _Efreet_Icon_Index
+{
+    Eina_File *f;
+    const unsigned char *map;
+    const Efreet_Icon_Index_Header *header;
+};
 
 struct _Efreet_Old_Cache
 {
     Eina_Hash *hash;
     Eet_File *ef;
+    Efreet_Icon_Index *index;
+};
+
+struct _Efreet_Ipc_Message
+{
+    int major;
+    int size;
+    unsigned char data[];
 };
 
 static Ecore_Ipc_Server    *ipc = NULL;
@@ -59,6 +77,9 @@ static Eet_File            *icon_cache = NULL;
 static Eet_File            *fallback_cache = NULL;
 static Eet_File            *icon_theme_cache = NULL;
 
+static Efreet_Icon_Index   *icon_index = NULL;
+static Efreet_Icon_Index   *fallback_index = NULL;
+
 static Eina_Hash           *themes = NULL;
 static Eina_Hash           *icons = NULL;
 static Eina_Hash           *fallbacks = NULL;
@@ -80,6 +101,8 @@ static const char          *desktop_cache_file = NULL;
 
 static Eina_List           *old_desktop_caches = NULL;
 
+static Eina_List           *ipc_pending = NULL;
+
 static const char                *util_cache_file = NULL;
 static Eet_File                  *util_cache = NULL;
 static Efreet_Cache_Hash         *util_cache_hash = NULL;
@@ -95,6 +118,11 @@ static void efreet_cache_icon_theme_free(Efreet_Icon_Theme *theme);
 static Eina_Bool efreet_cache_check(Eet_File **ef, const char *path, int major);
 static void *efreet_cache_close(Eet_File *ef);
 
+static Eina_Bool efreet_icon_index_check(Efreet_Icon_Index **idx, const char *path);
+static void *efreet_icon_index_close(Efreet_Icon_Index *idx);
+static Efreet_Cache_Icon *efreet_icon_index_icon_get(const Efreet_Icon_Index *idx, const char *key);
+static Efreet_Cache_Fallback_Icon *efreet_icon_index_fallback_get(const Efreet_Icon_Index *idx, const char *key);
+
 static void icon_cache_update_free(void *data, void *ev);
 
 static void *hash_array_string_add(void *hash, const char *key, void *data);
@@ -112,31 +140,41 @@ EAPI int EFREET_EVENT_DESKTOP_CACHE_BUILD = 0;
      return ECORE_CALLBACK_PASS_ON
 
 static void
-_ipc_launch(void)
+_ipc_exe_run(int *tries, int *try_gap)
 {
    char buf[PATH_MAX];
    int num;
-   int try_gap = 10000; // 10ms
-   int tries = 1000; // 1000 * 10ms == 10sec
    const char *s;
 
+   *try_gap = 10000; // 10ms
+   *tries = 1000; // 1000 * 10ms == 10sec
    s = getenv("EFREETD_CONNECT_TRIES");
    if (s)
      {
         num = atoi(s);
-        if (num >= 0) tries = num;
+        if (num >= 0) *tries = num;
      }
    s = getenv("EFREETD_CONNECT_TRY_GAP");
    if (s)
      {
         num = atoi(s);
-        if (num >= 0) try_gap = num;
+        if (num >= 0) *try_gap = num;
      }
    if (run_in_tree)
      bs_binary_get(buf, sizeof(buf), "efreet", "efreetd");
    else
      snprintf(buf, sizeof(buf), PACKAGE_BIN_DIR "/efreetd");
    ecore_exe_run(buf, NULL);
+}
+
+static void
+_ipc_launch(void)
+{
+   int num;
+   int try_gap;
+   int tries;
+
+   _ipc_exe_run(&tries, &try_gap);
    num = 0;
    while ((!ipc) && (num < tries))
      {
@@ -147,6 +185,96 @@ _ipc_launch(void)
    if (!ipc) ERR("Timeout in trying to start and then connect to efreetd");
 }
 
+static Ecore_Timer *launch_timer = NULL;
+static int launch_tries = 0;
+
+static void
+_ipc_pending_free(void)
+{
+   Efreet_Ipc_Message *msg;
+
+   EINA_LIST_FREE(ipc_pending, msg)
+     free(msg);
+}
+
+/* While efreetd is connected to from the launch timer, requests are kept
+ * and sent in order once the connection is up. */
+static void
+_ipc_send(int major, const void *data, int size)
+{
+   Efreet_Ipc_Message *msg;
+
+   if (ipc)
+     {
+        ecore_ipc_server_send(ipc, major, 0, 0, 0, 0, data, size);
+        return;
+     }
+   if (!launch_timer) return;
+   msg = malloc(sizeof(Efreet_Ipc_Message) + size);
+   if (!msg) return;
+   msg->major = major;
+   msg->size = size;
+   if (size > 0) memcpy(msg->data, data, size);
+   ipc_pending = eina_list_append(ipc_pending, msg);
+}
+
+static void
+_ipc_pending_flush(void)
+{
+   Efreet_Ipc_Message *msg;
+
+   EINA_LIST_FREE(ipc_pending, msg)
+     {
+        ecore_ipc_server_send(ipc, msg->major, 0, 0, 0, 0, msg->data, msg->size);
+        free(msg);
+     }
+}
+
+static Eina_Bool
+_cb_launch_timer(void *data EINA_UNUSED)
+{
+   /* connected from somewhere else meanwhile */
+   if (ipc)
+     {
+        launch_timer = NULL;
+        _ipc_pending_flush();
+        return EINA_FALSE;
+     }
+   ipc = ecore_ipc_server_connect(ECORE_IPC_LOCAL_USER, "efreetd", 0, NULL);
+   if (ipc)
+     {
+        const char *s;
+        int len = 0;
+
+        launch_timer = NULL;
+        s = efreet_language_get();
+        if (s) len = strlen(s);
+        ecore_ipc_server_send(ipc, 1, 0, 0, 0, 0, s, len);
+        efreet_icon_extensions_refresh();
+        _ipc_pending_flush();
+        return EINA_FALSE;
+     }
+   if (--launch_tries > 0) return EINA_TRUE;
+
+   ERR("Timeout in trying to start and then connect to efreetd");
+   launch_timer = NULL;
+   _ipc_pending_free();
+   return EINA_FALSE;
+}
+
+/* Same as _ipc_launch() but doesn't block: the caches are already on disk
+ * and usable without efreetd, so only connect once it is up to get told
+ * about changes. */
+static void
+_ipc_launch_async(void)
+{
+   int try_gap;
+
+   _ipc_exe_run(&launch_tries, &try_gap);
+   if (launch_tries <= 0) return;
+   launch_timer = ecore_timer_add(try_gap / 1000000.0, _cb_launch_timer, NULL);
+}
+
 static Eina_Bool
 _cb_server_add(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
 {
@@ -212,16 +340,23 @@ _efreet_cache_reset()
    const char *s;
    int len = 0;
 
+   if (launch_timer) ecore_timer_del(launch_timer);
+   launch_timer = NULL;
    if (ipc) ecore_ipc_server_del(ipc);
    ipc = NULL;
    if (!disable_cache)
      ipc = ecore_ipc_server_connect(ECORE_IPC_LOCAL_USER, "efreetd", 0, NULL);
-   if (!ipc) return;
+   if (!ipc)
+     {
+        _ipc_pending_free();
+        return;
+     }
 
    s = efreet_language_get();
    if (s) len = strlen(s);
    ecore_ipc_server_send(ipc, 1, 0, 0, 0, 0, s, len);
    efreet_icon_extensions_refresh();
+   _ipc_pending_flush();
 }
 
 static void
@@ -252,6 +387,7 @@ _icon_desktop_cache_update_event_add(int event_type)
      {
         d->hash = icons;
         d->ef = icon_cache;
+        d->index = icon_index;
         l = eina_list_append(l, d);
      }
 
@@ -260,6 +396,7 @@ _icon_desktop_cache_update_event_add(int event_type)
      {
         d->hash = fallbacks;
         d->ef = fallback_cache;
+        d->index = fallback_index;
         l = eina_list_append(l, d);
      }
 
@@ -271,6 +408,8 @@ _icon_desktop_cache_update_event_add(int event_type)
    icon_theme_cache = NULL;
    icon_cache = NULL;
    fallback_cache = NULL;
+   icon_index = NULL;
+   fallback_index = NULL;
 
    // Send event
    ecore_event_add(event_type, ev, icon_cache_update_free, l);
@@ -347,9 +486,16 @@ efreet_cache_init(void)
        else
          {
             ipc = ecore_ipc_server_connect(ECORE_IPC_LOCAL_USER, "efreetd", 0, NULL);
-            if (!ipc) _ipc_launch();
+            if (!ipc)
+              {
+                 if (ecore_file_exists(efreet_icon_theme_cache_file()) &&
+                     ecore_file_exists(efreet_desktop_cache_file()))
+                   _ipc_launch_async();
+                 else
+                   _ipc_launch();
+              }
          }
-       if (ipc)
+       if ((ipc) || (launch_timer))
          {
             const char *s;
             int len = 0;
@@ -360,9 +506,12 @@ efreet_cache_init(void)
                                               _cb_server_del, NULL);
             hnd_data = ecore_event_handler_add(ECORE_IPC_EVENT_SERVER_DATA,
                                                _cb_server_data, NULL);
-            s = efreet_language_get();
-            if (s) len = strlen(s);
-            ecore_ipc_server_send(ipc, 1, 0, 0, 0, 0, s, len);
+            if (ipc)
+              {
+                 s = efreet_language_get();
+                 if (s) len = strlen(s);
+                 ecore_ipc_server_send(ipc, 1, 0, 0, 0, 0, s, len);
+              }
          }
        else
          {
@@ -414,6 +563,9 @@ efreet_cache_shutdown(void)
     IF_FREE_HASH(icons);
     IF_FREE_HASH(fallbacks);
 
+    icon_index = efreet_icon_index_close(icon_index);
+    fallback_index = efreet_icon_index_close(fallback_index);
+
     IF_FREE_HASH_CB(desktops, EINA_FREE_CB(efreet_cache_desktop_free));
     desktop_cache = efreet_cache_close(desktop_cache);
     IF_RELEASE(desktop_cache_file);
@@ -445,6 +597,9 @@ efreet_cache_shutdown(void)
     util_cache = efreet_cache_close(util_cache);
     IF_RELEASE(util_cache_file);
 
+   if (launch_timer) ecore_timer_del(launch_timer);
+   launch_timer = NULL;
+   _ipc_pending_free();
    if (ipc) ecore_ipc_server_del(ipc);
    if (hnd_add) ecore_event_handler_del(hnd_add);
    if (hnd_del) ecore_event_handler_del(hnd_del);
@@ -481,6 +636,24 @@ efreet_icon_cache_file(const char *theme)
     return cache_file;
 }
 
+/*
+ * Needs EAPI because of helper binaries
+ */
+EAPI const char *
+efreet_icon_index_file(const char *theme)
+{
+    static char index_file[PATH_MAX] = { '\0' };
+    const char *cache;
+
+    EINA_SAFETY_ON_NULL_RETURN_VAL(theme, NULL);
+
+    cache = efreet_cache_home_get();
+
+    snprintf(index_file, sizeof(index_file), "%s/efreet/icons_%s_%s.idx", cache, theme, efreet_hostname_get());
+
+    return index_file;
+}
+
 /*
  * Needs EAPI because of helper binaries
  */
@@ -885,11 +1058,13 @@ efreet_cache_icon_find(Efreet_Icon_Theme *theme, const char *icon)
         INF("theme_name change from '%s' to '%s'", theme_name, theme->name.internal);
         IF_RELEASE(theme_name);
         icon_cache = efreet_cache_close(icon_cache);
+        icon_index = efreet_icon_index_close(icon_index);
         eina_hash_free(icons);
         icons = eina_hash_string_superfast_new(EINA_FREE_CB(efreet_cache_icon_free));
     }
 
-    if (!efreet_cache_check(&icon_cache, efreet_icon_cache_file(theme->name.internal), EFREET_ICON_CACHE_MAJOR)) return NULL;
+    if (!efreet_icon_index_check(&icon_index, efreet_icon_index_file(theme->name.internal)) &&
+        !efreet_cache_check(&icon_cache, efreet_icon_cache_file(theme->name.internal), EFREET_ICON_CACHE_MAJOR)) return NULL;
     if (!theme_name)
         theme_name = eina_stringshare_add(theme->name.internal);
 
@@ -897,7 +1072,10 @@ efreet_cache_icon_find(Efreet_Icon_Theme *theme, const char *icon)
     if (cache == NON_EXISTING) return NULL;
     if (cache) return cache;
 
-    cache = eet_data_read(icon_cache, efreet_icon_edd(), icon);
+    if (icon_index != NON_EXISTING)
+        cache = efreet_icon_index_icon_get(icon_index, icon);
+    else
+        cache = eet_data_read(icon_cache, efreet_icon_edd(), icon);
     if (cache)
         eina_hash_add(icons, icon, cache);
     else
@@ -910,13 +1088,17 @@ efreet_cache_icon_fallback_find(const char *icon)
 {
     Efreet_Cache_Fallback_Icon *cache;
 
-    if (!efreet_cache_check(&fallback_cache, efreet_icon_cache_file(EFREET_CACHE_ICON_FALLBACK), EFREET_ICON_CACHE_MAJOR)) return NULL;
+    if (!efreet_icon_index_check(&fallback_index, efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK)) &&
+        !efreet_cache_check(&fallback_cache, efreet_icon_cache_file(EFREET_CACHE_ICON_FALLBACK), EFREET_ICON_CACHE_MAJOR)) return NULL;
 
     cache = eina_hash_find(fallbacks, icon);
     if (cache == NON_EXISTING) return NULL;
     if (cache) return cache;
 
-    cache = eet_data_read(fallback_cache, efreet_icon_fallback_edd(), icon);
+    if (fallback_index != NON_EXISTING)
+        cache = efreet_icon_index_fallback_get(fallback_index, icon);
+    else
+        cache = eet_data_read(fallback_cache, efreet_icon_fallback_edd(), icon);
     if (cache)
         eina_hash_add(fallbacks, icon, cache);
     else
@@ -1143,7 +1325,7 @@ efreet_cache_desktop_add(Efreet_Desktop *desktop)
 {
    char *path;
 
-   if ((!efreet_cache_update) || (!ipc)) return;
+   if ((!efreet_cache_update) || ((!ipc) && (!launch_timer))) return;
    if (!eina_main_loop_is()) return;
     /*
      * TODO: Call in thread with:
@@ -1152,7 +1334,7 @@ efreet_cache_desktop_add(Efreet_Desktop *desktop)
     */
    path = ecore_file_dir_get(desktop->orig_path);
    if (!path) return;
-   ecore_ipc_server_send(ipc, 2, 0, 0, 0, 0, path, strlen(path));
+   _ipc_send(2, path, strlen(path));
    free(path);
 }
 
@@ -1189,7 +1371,7 @@ efreet_cache_icon_dirs_add(Eina_List *dirs)
    int num = 0;
    unsigned char nil[1] = { 0 };
 
-   if ((!efreet_cache_update) || (!ipc)) return;
+   if ((!efreet_cache_update) || ((!ipc) && (!launch_timer))) return;
    buf = eina_binbuf_new();
    if (!buf) return;
    EINA_LIST_FOREACH(dirs, l, s)
@@ -1198,9 +1380,8 @@ efreet_cache_icon_dirs_add(Eina_List *dirs)
         eina_binbuf_append_length(buf, (unsigned char *)s, strlen(s));
         num++;
      }
-   ecore_ipc_server_send(ipc, 4 /* add icon dirs */, 0, 0, 0, 0,
-                         eina_binbuf_string_get(buf),
-                         eina_binbuf_length_get(buf));
+   _ipc_send(4 /* add icon dirs */, eina_binbuf_string_get(buf),
+             eina_binbuf_length_get(buf));
    eina_binbuf_free(buf);
 }
 
@@ -1246,10 +1427,10 @@ efreet_cache_desktop_build(void)
 {
    const char *s;
    int len = 0;
-   if ((!efreet_cache_update) || (!ipc)) return;
+   if ((!efreet_cache_update) || ((!ipc) && (!launch_timer))) return;
    s = efreet_language_get();
    if (s) len = strlen(s);
-   ecore_ipc_server_send(ipc, 3 /* build desktop cache */, 0, 0, 0, 0, s, len);
+   _ipc_send(3 /* build desktop cache */, s, len);
 }
 
 static Eina_Bool
@@ -1287,6 +1468,361 @@ efreet_cache_close(Eet_File *ef)
     return NULL;
 }
 
+/*
+ * Icon index
+ *
+ * The index is written once by efreet_icon_cache_create and atomically
+ * renamed into place, so a mapping is never modified once it is opened.
+ * Lookups are plain reads of the map and need no locking, no eet decoding
+ * and no round-trip to efreetd.
+ */
+static unsigned int
+efreet_icon_index_string_add(Eina_Binbuf *strings, Eina_Hash *offsets, const char *str)
+{
+    uintptr_t offset;
+
+    if (!str) return 0;
+    offset = (uintptr_t)eina_hash_find(offsets, str);
+    if (offset) return offset;
+
+    offset = eina_binbuf_length_get(strings);
+    eina_binbuf_append_length(strings, (const unsigned char *)str, strlen(str) + 1);
+    eina_hash_add(offsets, str, (void *)offset);
+    return offset;
+}
+
+static void
+efreet_icon_index_uint_add(Eina_Binbuf *buf, unsigned int val)
+{
+    eina_binbuf_append_length(buf, (const unsigned char *)&val, sizeof(val));
+}
+
+static unsigned int
+efreet_icon_index_record_add(Eina_Binbuf *records, Eina_Binbuf *strings,
+                             Eina_Hash *offsets, void *data, Eina_Bool fallback)
+{
+    Efreet_Icon_Index_Icon rec;
+    unsigned int offset, i, j;
+
+    offset = eina_binbuf_length_get(records);
+    if (fallback)
+    {
+        Efreet_Cache_Fallback_Icon *icon = data;
+
+        rec.theme = efreet_icon_index_string_add(strings, offsets, icon->theme);
+        rec.count = icon->icons_count;
+        eina_binbuf_append_length(records, (const unsigned char *)&rec, sizeof(rec));
+        for (i = 0; i < icon->icons_count; i++)
+            efreet_icon_index_uint_add(records,
+                                       efreet_icon_index_string_add(strings, offsets, icon->icons[i]));
+        return offset;
+    }
+    else
+    {
+        Efreet_Cache_Icon *icon = data;
+
+        rec.theme = efreet_icon_index_string_add(strings, offsets, icon->theme);
+        rec.count = icon->icons_count;
+        eina_binbuf_append_length(records, (const unsigned char *)&rec, sizeof(rec));
+        for (i = 0; i < icon->icons_count; i++)
+        {
+            Efreet_Cache_Icon_Element *elem = icon->icons[i];
+            Efreet_Icon_Index_Element el;
+
+            el.type = elem->type;
+            el.normal = elem->normal;
+            el.min = elem->min;
+            el.max = elem->max;
+            el.paths_count = elem->paths_count;
+            eina_binbuf_append_length(records, (const unsigned char *)&el, sizeof(el));
+            for (j = 0; j < elem->paths_count; j++)
+                efreet_icon_index_uint_add(records,
+                                           efreet_icon_index_string_add(strings, offsets, elem->paths[j]));
+        }
+    }
+    return offset;
+}
+
+/*
+ * Needs EAPI because of helper binaries
+ */
+EAPI Eina_Bool
+efreet_icon_index_write(const char *file, Eina_Hash *entries, Eina_Bool fallback)
+{
+    Efreet_Icon_Index_Header header;
+    Efreet_Icon_Index_Bucket *buckets = NULL;
+    Eina_Binbuf *records = NULL, *strings = NULL;
+    Eina_Hash *offsets = NULL;
+    Eina_Iterator *it;
+    Eina_Hash_Tuple *tuple;
+    char tmp[PATH_MAX];
+    FILE *f = NULL;
+    unsigned int mask;
+    Eina_Bool ret = EINA_FALSE;
+
+    EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+    EINA_SAFETY_ON_NULL_RETURN_VAL(entries, EINA_FALSE);
+
+    memset(&header, 0, sizeof(header));
+    header.magic = EFREET_ICON_INDEX_MAGIC;
+    header.version = EFREET_ICON_INDEX_VERSION;
+    header.count = eina_hash_population(entries);
+    /* keep the table at most half full so most lookups hit the first slot */
+    header.buckets = 16;
+    while (header.buckets < (header.count * 2))
+        header.buckets <<= 1;
+    mask = header.buckets - 1;
+
+    buckets = NEW(Efreet_Icon_Index_Bucket, header.buckets);
+    records = eina_binbuf_new();
+    strings = eina_binbuf_new();
+    offsets = eina_hash_string_superfast_new(NULL);
+    if ((!buckets) || (!records) || (!strings) || (!offsets)) goto error;
+
+    /* offset 0 of the string section is NULL */
+    eina_binbuf_append_char(strings, '\0');
+
+    it = eina_hash_iterator_tuple_new(entries);
+    EINA_ITERATOR_FOREACH(it, tuple)
+    {
+        const char *key = tuple->key;
+        unsigned int hash, i;
+
+        hash = (unsigned int)eina_hash_superfast(key, strlen(key));
+        for (i = hash & mask; buckets[i].key; i = (i + 1) & mask)
+            ;
+        buckets[i].hash = hash;
+        buckets[i].key = efreet_icon_index_string_add(strings, offsets, key);
+        buckets[i].record = efreet_icon_index_record_add(records, strings, offsets,
+                                                         tuple->data, fallback);
+    }
+    eina_iterator_free(it);
+
+    header.records = sizeof(header) + (header.buckets * sizeof(Efreet_Icon_Index_Bucket));
+    header.strings = header.records + eina_binbuf_length_get(records);
+    header.size = header.strings + eina_binbuf_length_get(strings);
+
+    /* write to a temporary file and rename it in place, clients may have
+     * the previous index mapped */
+    snprintf(tmp, sizeof(tmp), "%s.tmp", file);
+    f = fopen(tmp, "wb");
+    if (!f) goto error;
+    if ((fwrite(&header, sizeof(header), 1, f) != 1) ||
+        (fwrite(buckets, sizeof(Efreet_Icon_Index_Bucket), header.buckets, f) != header.buckets) ||
+        (fwrite(eina_binbuf_string_get(records), 1, eina_binbuf_length_get(records), f) != eina_binbuf_length_get(records)) ||
+        (fwrite(eina_binbuf_string_get(strings), 1, eina_binbuf_length_get(strings), f) != eina_binbuf_length_get(strings)))
+    {
+        fclose(f);
+        unlink(tmp);
+        goto error;
+    }
+    if (fclose(f) != 0)
+    {
+        unlink(tmp);
+        goto error;
+    }
+    if (rename(tmp, file) < 0)
+    {
+        ERR("Could not rename icon index '%s' to '%s'", tmp, file);
+        unlink(tmp);
+        goto error;
+    }
+    ret = EINA_TRUE;
+
+error:
+    if (offsets) eina_hash_free(offsets);
+    if (strings) eina_binbuf_free(strings);
+    if (records) eina_binbuf_free(records);
+    free(buckets);
+    return ret;
+}
+
+static Eina_Bool
+efreet_icon_index_check(Efreet_Icon_Index **idx, const char *path)
+{
+    const Efreet_Icon_Index_Header *header;
+    Efreet_Icon_Index *index;
+    size_t size;
+
+    if (*idx == NON_EXISTING) return EINA_FALSE;
+    if (*idx) return EINA_TRUE;
+
+    *idx = NON_EXISTING;
+    index = NEW(Efreet_Icon_Index, 1);
+    if (!index) return EINA_FALSE;
+
+    index->f = eina_file_open(path, EINA_FALSE);
+    if (!index->f) goto error;
+    size = eina_file_size_get(index->f);
+    if (size < sizeof(Efreet_Icon_Index_Header)) goto error;
+    index->map = eina_file_map_all(index->f, EINA_FILE_RANDOM);
+    if (!index->map) goto error;
+
+    header = (const Efreet_Icon_Index_Header *)index->map;
+    if ((header->magic != EFREET_ICON_INDEX_MAGIC) ||
+        (header->version != EFREET_ICON_INDEX_VERSION) ||
+        (header->size != size) ||
+        (!header->buckets) || (header->buckets & (header->buckets - 1)) ||
+        (header->records != sizeof(Efreet_Icon_Index_Header) +
+         ((size_t)header->buckets * sizeof(Efreet_Icon_Index_Bucket))) ||
+        (header->strings < header->records) || (header->strings >= size) ||
+        (index->map[size - 1] != '\0'))
+    {
+        ERR("Invalid icon index '%s'", path);
+        goto error;
+    }
+    index->header = header;
+    *idx = index;
+    return EINA_TRUE;
+
+error:
+    efreet_icon_index_close(index);
+    return EINA_FALSE;
+}
+
+static void *
+efreet_icon_index_close(Efreet_Icon_Index *idx)
+{
+    if ((!idx) || (idx == NON_EXISTING)) return NULL;
+
+    if (idx->f)
+    {
+        if (idx->map) eina_file_map_free(idx->f, (void *)idx->map);
+        eina_file_close(idx->f);
+    }
+    free(idx);
+    return NULL;
+}
+
+static const char *
+efreet_icon_index_string(const Efreet_Icon_Index *idx, unsigned int offset)
+{
+    if (!offset) return NULL;
+    if (offset >= (idx->header->size - idx->header->strings)) return NULL;
+    return (const char *)(idx->map + idx->header->strings + offset);
+}
+
+static const void *
+efreet_icon_index_record(const Efreet_Icon_Index *idx, unsigned int offset, size_t len)
+{
+    size_t end = (size_t)idx->header->records + offset + len;
+
+    if (end > idx->header->strings) return NULL;
+    return idx->map + idx->header->records + offset;
+}
+
+static const Efreet_Icon_Index_Icon *
+efreet_icon_index_lookup(const Efreet_Icon_Index *idx, const char *key)
+{
+    const Efreet_Icon_Index_Bucket *buckets;
+    unsigned int hash, mask, i, n;
+
+    buckets = (const Efreet_Icon_Index_Bucket *)(idx->map + sizeof(Efreet_Icon_Index_Header));
+    mask = idx->header->buckets - 1;
+    hash = (unsigned int)eina_hash_superfast(key, strlen(key));
+
+    for (i = hash & mask, n = 0; n < idx->header->buckets; i = (i + 1) & mask, n++)
+    {
+        const char *str;
+
+        if (!buckets[i].key) break;
+        if (buckets[i].hash != hash) continue;
+        str = efreet_icon_index_string(idx, buckets[i].key);
+        if ((str) && (!strcmp(str, key)))
+            return efreet_icon_index_record(idx, buckets[i].record,
+                                            sizeof(Efreet_Icon_Index_Icon));
+    }
+    return NULL;
+}
+
+static Efreet_Cache_Icon *
+efreet_icon_index_icon_get(const Efreet_Icon_Index *idx, const char *key)
+{
+    const Efreet_Icon_Index_Icon *rec;
+    const unsigned char *p;
+    Efreet_Cache_Icon *icon;
+    unsigned int i, j, offset;
+
+    rec = efreet_icon_index_lookup(idx, key);
+    if (!rec) return NULL;
+
+    icon = NEW(Efreet_Cache_Icon, 1);
+    if (!icon) return NULL;
+    icon->theme = efreet_icon_index_string(idx, rec->theme);
+    icon->icons = NEW(Efreet_Cache_Icon_Element *, rec->count);
+    if ((rec->count) && (!icon->icons)) goto error;
+
+    /* paths point straight into the map which lives as long as the cache */
+    p = (const unsigned char *)(rec + 1);
+    for (i = 0; i < rec->count; i++)
+    {
+        const Efreet_Icon_Index_Element *el;
+        const unsigned int *paths;
+        Efreet_Cache_Icon_Element *elem;
+
+        offset = p - (idx->map + idx->header->records);
+        el = efreet_icon_index_record(idx, offset, sizeof(*el));
+        if (!el) goto error;
+        paths = efreet_icon_index_record(idx, offset + sizeof(*el),
+                                         el->paths_count * sizeof(unsigned int));
+        if (!paths) goto error;
+
+        elem = NEW(Efreet_Cache_Icon_Element, 1);
+        if (!elem) goto error;
+        icon->icons[icon->icons_count++] = elem;
+        elem->type = el->type;
+        elem->normal = el->normal;
+        elem->min = el->min;
+        elem->max = el->max;
+        elem->paths = NEW(const char *, el->paths_count);
+        if ((el->paths_count) && (!elem->paths)) goto error;
+        for (j = 0; j < el->paths_count; j++)
+        {
+            elem->paths[j] = efreet_icon_index_string(idx, paths[j]);
+            if (elem->paths[j]) elem->paths_count++;
+        }
+        p = (const unsigned char *)(paths + el->paths_count);
+    }
+    return icon;
+
+error:
+    ERR("Corrupt icon index record for '%s'", key);
+    efreet_cache_icon_free(icon);
+    return NULL;
+}
+
+static Efreet_Cache_Fallback_Icon *
+efreet_icon_index_fallback_get(const Efreet_Icon_Index *idx, const char *key)
+{
+    const Efreet_Icon_Index_Icon *rec;
+    const unsigned int *paths;
+    Efreet_Cache_Fallback_Icon *icon;
+    unsigned int i, offset;
+
+    rec = efreet_icon_index_lookup(idx, key);
+    if (!rec) return NULL;
+
+    offset = (const unsigned char *)(rec + 1) - (idx->map + idx->header->records);
+    paths = efreet_icon_index_record(idx, offset, rec->count * sizeof(unsigned int));
+    if (!paths) return NULL;
+
+    icon = NEW(Efreet_Cache_Fallback_Icon, 1);
+    if (!icon) return NULL;
+    icon->theme = efreet_icon_index_string(idx, rec->theme);
+    icon->icons = NEW(const char *, rec->count);
+    if ((rec->count) && (!icon->icons))
+    {
+        free(icon);
+        return NULL;
+    }
+    for (i = 0; i < rec->count; i++)
+    {
+        icon->icons[icon->icons_count] = efreet_icon_index_string(idx, paths[i]);
+        if (icon->icons[icon->icons_count]) icon->icons_count++;
+    }
+    return icon;
+}
+
 Efreet_Cache_Hash *
 efreet_cache_util_hash_string(const char *key)
 {
@@ -1355,6 +1891,7 @@ icon_cache_update_free(void *data, void *ev)
         if (d->hash)
             eina_hash_free(d->hash);
         efreet_cache_close(d->ef);
+        efreet_icon_index_close(d->index);
         free(d);
     }
     free(ev);
@@ -1380,6 +1917,12 @@ efreet_cache_disable(void)
 
    if (_efreet_cache_log_dom < 0) return; // not yet initialized
    if (prev == disable_cache) return; // same value
+   if (launch_timer)
+     {
+        ecore_timer_del(launch_timer);
+        launch_timer = NULL;
+     }
+   _ipc_pending_free();
    if (ipc)
      {
         ecore_ipc_server_del(ipc);
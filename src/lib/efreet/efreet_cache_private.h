@@ -10,6 +10,10 @@
 #define EFREET_ICON_CACHE_MINOR 0
 
 #define EFREET_CACHE_VERSION "__efreet//version"
+
+/* compact icon index, mmap'ed by clients next to the eet icon caches */
+#define EFREET_ICON_INDEX_MAGIC 0x58444945 /* "EIDX" */
+#define EFREET_ICON_INDEX_VERSION 1
 #define EFREET_CACHE_ICON_FALLBACK "__efreet_fallback"
 
 #ifdef EAPI
@@ -42,6 +46,9 @@ EAPI const char *efreet_desktop_util_cache_file(void);
 EAPI const char *efreet_desktop_cache_file(void);
 EAPI const char *efreet_icon_cache_file(const char *theme);
 EAPI const char *efreet_icon_theme_cache_file(void);
+EAPI const char *efreet_icon_index_file(const char *theme);
+
+EAPI Eina_Bool efreet_icon_index_write(const char *file, Eina_Hash *entries, Eina_Bool fallback);
 
 EAPI Eet_Data_Descriptor *efreet_version_edd(void);
 EAPI Eet_Data_Descriptor *efreet_desktop_edd(void);
@@ -52,6 +59,58 @@ EAPI Eet_Data_Descriptor *efreet_icon_theme_edd(Eina_Bool cache);
 EAPI Eet_Data_Descriptor *efreet_icon_edd(void);
 EAPI Eet_Data_Descriptor *efreet_icon_fallback_edd(void);
 
+typedef struct _Efreet_Icon_Index_Header Efreet_Icon_Index_Header;
+typedef struct _Efreet_Icon_Index_Bucket Efreet_Icon_Index_Bucket;
+typedef struct _Efreet_Icon_Index_Icon Efreet_Icon_Index_Icon;
+typedef struct _Efreet_Icon_Index_Element Efreet_Icon_Index_Element;
+
+/*
+ * Icon index file layout, in host byte order (cache files are per host):
+ *
+ * [header][buckets * Efreet_Icon_Index_Bucket][records][strings]
+ *
+ * Record offsets are relative to the record section and strings are
+ * offsets relative to the string section, 0 being NULL.
+ *
+ * Buckets are an open addressing table indexed by
+ * eina_hash_superfast(key) & (buckets - 1) with linear probing, a bucket
+ * with a NULL key ends the probe. A record is an Efreet_Icon_Index_Icon
+ * followed by its elements, each followed by its path offsets. Fallback
+ * indexes store the fallback paths directly after the record header.
+ */
+struct _Efreet_Icon_Index_Header
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int size;      /**< Total file size */
+    unsigned int count;     /**< Number of icons */
+    unsigned int buckets;   /**< Number of buckets, power of two */
+    unsigned int records;   /**< Offset of the record section */
+    unsigned int strings;   /**< Offset of the string section */
+};
+
+struct _Efreet_Icon_Index_Bucket
+{
+    unsigned int hash;
+    unsigned int key;
+    unsigned int record;
+};
+
+struct _Efreet_Icon_Index_Icon
+{
+    unsigned int theme;
+    unsigned int count;     /**< Number of elements or fallback paths */
+};
+
+struct _Efreet_Icon_Index_Element
+{
+    unsigned short type;
+    unsigned short normal;
+    unsigned short min;
+    unsigned short max;
+    unsigned int paths_count;
+};
+
 typedef struct _Efreet_Cache_Icon_Theme Efreet_Cache_Icon_Theme;
 typedef struct _Efreet_Cache_Directory Efreet_Cache_Directory;
 typedef struct _Efreet_Cache_Desktop Efreet_Cache_Desktop;
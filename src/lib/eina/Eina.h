@@ -225,6 +225,7 @@ extern "C" {
 #include <eina_error.h>
 #include <eina_log.h>
 #include <eina_inarray.h>
+#include <eina_chunk_list.h>
 #include <eina_array.h>
 #include <eina_binshare.h>
 #include <eina_stringshare.h>
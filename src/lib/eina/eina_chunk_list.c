@@ -0,0 +1,297 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "eina_config.h"
+#include "eina_private.h"
+
+/* undefs EINA_ARG_NONULL() so NULL checks are not compiled out! */
+#include "eina_safety_checks.h"
+#include "eina_chunk_list.h"
+
+/*============================================================================*
+*                                  Local                                     *
+*============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+typedef struct _Eina_Iterator_Chunk_List Eina_Iterator_Chunk_List;
+
+/* slot of a removed item, chunks are never that big */
+#define EINA_CHUNK_LIST_SLOT_NONE 0xff
+
+struct _Eina_Iterator_Chunk_List
+{
+   Eina_Iterator iterator;
+   const Eina_Chunk_List *list;
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int index;
+};
+
+/* A chunk is allocated with its index bytes, its slot bytes and its data
+ * slots right after it, see EINA_CHUNK_LIST_ITEM_CHUNK(). */
+static Eina_Chunk_List_Chunk *
+_eina_chunk_list_chunk_new(unsigned int size)
+{
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned char *index;
+   unsigned int offset;
+   unsigned int i;
+
+   offset = (2 * size + sizeof (void *) - 1) & ~(sizeof (void *) - 1);
+   chunk = malloc(sizeof (Eina_Chunk_List_Chunk) + offset +
+                  size * sizeof (void *));
+   if (!chunk) return NULL;
+
+   index = (unsigned char *)(chunk + 1);
+   for (i = 0; i < size; i++)
+     {
+        index[i] = i;
+        index[size + i] = EINA_CHUNK_LIST_SLOT_NONE;
+     }
+
+   chunk->next = NULL;
+   chunk->prev = NULL;
+   chunk->data = (void **)(index + offset);
+   chunk->size = size;
+   chunk->fill = 0;
+   chunk->count = 0;
+   chunk->used = 0;
+
+   return chunk;
+}
+
+/* Moves the items down over the holes, the slots only ever grow with the
+ * handles so walking the handles in order keeps the items in order. */
+static void
+_eina_chunk_list_chunk_compact(Eina_Chunk_List_Chunk *chunk)
+{
+   unsigned char *slots;
+   unsigned int fill = 0;
+   unsigned int i;
+
+   slots = ((unsigned char *)(chunk + 1)) + chunk->size;
+   for (i = 0; i < chunk->used; i++)
+     {
+        if (slots[i] == EINA_CHUNK_LIST_SLOT_NONE) continue;
+        chunk->data[fill] = chunk->data[slots[i]];
+        slots[i] = fill++;
+     }
+
+   chunk->fill = fill;
+   if (!fill) chunk->used = 0;
+}
+
+static Eina_Bool
+_eina_chunk_list_iterator_next(Eina_Iterator_Chunk_List *it, void **data)
+{
+   void *item;
+
+   item = eina_chunk_list_walk_next(&it->chunk, &it->index);
+   if (!item) return EINA_FALSE;
+
+   *data = item;
+   return EINA_TRUE;
+}
+
+static void *
+_eina_chunk_list_iterator_get_container(Eina_Iterator_Chunk_List *it)
+{
+   return (void *)it->list;
+}
+
+static void
+_eina_chunk_list_iterator_free(Eina_Iterator_Chunk_List *it)
+{
+   free(it);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+*                                   API                                      *
+*============================================================================*/
+
+EAPI Eina_Chunk_List *
+eina_chunk_list_new(void)
+{
+   return calloc(1, sizeof (Eina_Chunk_List));
+}
+
+EAPI void
+eina_chunk_list_free(Eina_Chunk_List *list)
+{
+   Eina_Chunk_List_Chunk *chunk, *next;
+
+   if (!list) return;
+
+   for (chunk = list->first; chunk; chunk = next)
+     {
+        next = chunk->next;
+        free(chunk);
+     }
+   for (chunk = list->pending; chunk; chunk = next)
+     {
+        next = chunk->prev;
+        free(chunk);
+     }
+   free(list);
+}
+
+EAPI Eina_Chunk_List_Item *
+eina_chunk_list_append(Eina_Chunk_List *list, const void *data)
+{
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned char *index;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(list, NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(data, NULL);
+
+   chunk = list->last;
+   if (chunk && (chunk->used == chunk->size) && (!chunk->count))
+     {
+        /* A full tail where everything got removed, start it over. */
+        chunk->fill = 0;
+        chunk->used = 0;
+     }
+   else if ((!chunk) || (chunk->used == chunk->size))
+     {
+        unsigned int size = EINA_CHUNK_LIST_CHUNK_MIN;
+
+        if (chunk)
+          {
+             size = chunk->size * 2;
+             if (size > EINA_CHUNK_LIST_CHUNK_MAX)
+               size = EINA_CHUNK_LIST_CHUNK_MAX;
+          }
+
+        chunk = _eina_chunk_list_chunk_new(size);
+        if (!chunk) return NULL;
+
+        chunk->prev = list->last;
+        if (list->last) list->last->next = chunk;
+        else list->first = chunk;
+        list->last = chunk;
+     }
+
+   index = ((unsigned char *)(chunk + 1)) + chunk->used++;
+   index[chunk->size] = chunk->fill;
+   chunk->data[chunk->fill++] = (void *)data;
+   chunk->count++;
+   list->count++;
+
+   return (Eina_Chunk_List_Item *)index;
+}
+
+EAPI void
+eina_chunk_list_remove(Eina_Chunk_List *list, Eina_Chunk_List_Item *item)
+{
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int slot;
+
+   EINA_SAFETY_ON_NULL_RETURN(list);
+   EINA_SAFETY_ON_NULL_RETURN(item);
+
+   chunk = EINA_CHUNK_LIST_ITEM_CHUNK(item);
+   slot = EINA_CHUNK_LIST_ITEM_SLOT(chunk, item);
+   EINA_SAFETY_ON_TRUE_RETURN(slot >= chunk->fill);
+
+   ((unsigned char *)item)[chunk->size] = EINA_CHUNK_LIST_SLOT_NONE;
+   chunk->data[slot] = NULL;
+   chunk->count--;
+   list->count--;
+   list->removed++;
+
+   if (chunk->count) return;
+
+   if (chunk == list->last)
+     {
+        /* The tail is kept around for the next append, only rewinding it
+         * when nothing could be walking past its end. */
+        if (chunk->fill == slot + 1)
+          {
+             chunk->fill = 0;
+             chunk->used = 0;
+          }
+        return;
+     }
+
+   /* Unlink the chunk, but keep it alive until eina_chunk_list_compact()
+    * as an EINA_CHUNK_LIST_FOREACH() may be walking it. Its next is left
+    * alone for that walk to carry on, the pending chunks are chained by
+    * their prev. */
+   if (chunk->prev) chunk->prev->next = chunk->next;
+   else list->first = chunk->next;
+   chunk->next->prev = chunk->prev;
+
+   chunk->prev = list->pending;
+   list->pending = chunk;
+}
+
+EAPI void
+eina_chunk_list_compact(Eina_Chunk_List *list)
+{
+   Eina_Chunk_List_Chunk *chunk, *next;
+
+   EINA_SAFETY_ON_NULL_RETURN(list);
+
+   if (!list->removed) return;
+
+   for (chunk = list->pending; chunk; chunk = next)
+     {
+        next = chunk->prev;
+        free(chunk);
+     }
+   list->pending = NULL;
+
+   for (chunk = list->first; chunk; chunk = chunk->next)
+     if (chunk->count * 2 < chunk->fill)
+       _eina_chunk_list_chunk_compact(chunk);
+
+   list->removed = 0;
+}
+
+EAPI Eina_Iterator *
+eina_chunk_list_iterator_new(const Eina_Chunk_List *list)
+{
+   Eina_Iterator_Chunk_List *it;
+
+   it = calloc(1, sizeof (Eina_Iterator_Chunk_List));
+   if (!it) return NULL;
+
+   EINA_MAGIC_SET(&it->iterator, EINA_MAGIC_ITERATOR);
+
+   it->list = list;
+   it->chunk = list ? list->first : NULL;
+
+   it->iterator.version = EINA_ITERATOR_VERSION;
+   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_chunk_list_iterator_next);
+   it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER
+     (_eina_chunk_list_iterator_get_container);
+   it->iterator.free = FUNC_ITERATOR_FREE(_eina_chunk_list_iterator_free);
+
+   return &it->iterator;
+}
@@ -0,0 +1,278 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EINA_CHUNK_LIST_H_
+#define EINA_CHUNK_LIST_H_
+
+#include "eina_types.h"
+#include "eina_iterator.h"
+
+/**
+ * @defgroup Eina_Chunk_List_Group Chunk List
+ * @ingroup Eina_Containers_Group
+ * @since 1.24
+ *
+ * @brief Chunk list is an ordered container of pointers stored in small
+ * arrays linked together.
+ *
+ * It is meant for long lists that are mostly walked and where items are
+ * added at the end and removed from anywhere, like the objects clipped by a
+ * given clipper in Evas. Compared to #Eina_List, walking it reads pointers
+ * that sit next to each other in memory instead of chasing one node per
+ * item, and removing an item is O(1) given the #Eina_Chunk_List_Item handle
+ * returned when it was appended.
+ *
+ * Handles stay valid until their item is removed. Removing items only
+ * leaves holes that are skipped while walking, so that removing is safe in
+ * the middle of a walk. Emptied chunks and holes are only dealt with by
+ * eina_chunk_list_compact(), which has to be called from time to time when
+ * nothing walks the list.
+ *
+ * Only appending is supported, if items have to be inserted at arbitrary
+ * positions use #Eina_List or #Eina_Inlist instead.
+ *
+ * @{
+ */
+
+/**
+ * @def EINA_CHUNK_LIST_CHUNK_MIN
+ * @brief Number of items stored in the first chunk of a list.
+ *
+ * Each new chunk is twice as big as the previous one, up to
+ * #EINA_CHUNK_LIST_CHUNK_MAX items, so short lists stay small.
+ *
+ * @since 1.24
+ */
+#define EINA_CHUNK_LIST_CHUNK_MIN 4
+
+/**
+ * @def EINA_CHUNK_LIST_CHUNK_MAX
+ * @brief Maximum number of items stored in a chunk.
+ *
+ * @since 1.24
+ */
+#define EINA_CHUNK_LIST_CHUNK_MAX 128
+
+/**
+ * @typedef Eina_Chunk_List
+ * @brief Type for a chunk list.
+ *
+ * @since 1.24
+ */
+typedef struct _Eina_Chunk_List Eina_Chunk_List;
+
+/**
+ * @typedef Eina_Chunk_List_Chunk
+ * @brief Type for one chunk of a chunk list.
+ *
+ * @since 1.24
+ */
+typedef struct _Eina_Chunk_List_Chunk Eina_Chunk_List_Chunk;
+
+/**
+ * @typedef Eina_Chunk_List_Item
+ * @brief Opaque handle to an item of a chunk list, used to remove it.
+ *
+ * @since 1.24
+ */
+typedef struct _Eina_Chunk_List_Item Eina_Chunk_List_Item;
+
+/**
+ * @brief Chunk of a chunk list.
+ *
+ * @note Do not modify these fields directly, they are only public for
+ *       EINA_CHUNK_LIST_FOREACH().
+ *
+ * @since 1.24
+ */
+struct _Eina_Chunk_List_Chunk
+{
+   Eina_Chunk_List_Chunk *next; /**< Next chunk in the list */
+   Eina_Chunk_List_Chunk *prev; /**< Previous chunk in the list */
+   void **data; /**< The items, @c NULL once removed */
+   unsigned short size; /**< Number of slots in this chunk */
+   unsigned short fill; /**< Number of slots used so far, removed or not */
+   unsigned short count; /**< Number of items still in this chunk */
+   unsigned short used; /**< Number of handles given so far, removed or not */
+};
+
+/**
+ * @brief Chunk list structure.
+ *
+ * @note Do not modify these fields directly, they are only public for
+ *       EINA_CHUNK_LIST_FOREACH() and eina_chunk_list_count().
+ *
+ * @since 1.24
+ */
+struct _Eina_Chunk_List
+{
+   Eina_Chunk_List_Chunk *first; /**< First chunk */
+   Eina_Chunk_List_Chunk *last; /**< Last chunk, the one being appended to */
+   Eina_Chunk_List_Chunk *pending; /**< Emptied chunks not given back yet, chained by their prev */
+   unsigned int count; /**< Number of items in the list */
+   unsigned int removed; /**< Number of items removed since the last eina_chunk_list_compact() */
+};
+
+/**
+ * @brief Creates a new chunk list.
+ *
+ * @return A new empty list, otherwise @c NULL on failure
+ *
+ * @see eina_chunk_list_free()
+ *
+ * @since 1.24
+ */
+EAPI Eina_Chunk_List *eina_chunk_list_new(void) EINA_MALLOC EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @brief Frees a chunk list.
+ *
+ * @param[in] list The list to free
+ *
+ * @note The items themselves are not freed, and all the handles given by
+ *       eina_chunk_list_append() become invalid.
+ *
+ * @since 1.24
+ */
+EAPI void eina_chunk_list_free(Eina_Chunk_List *list);
+
+/**
+ * @brief Appends an item at the end of a chunk list.
+ *
+ * @param[in] list The list
+ * @param[in] data The item to append, it can't be @c NULL
+ * @return The handle to give to eina_chunk_list_remove(), otherwise @c NULL
+ *         on failure
+ *
+ * @since 1.24
+ */
+EAPI Eina_Chunk_List_Item *eina_chunk_list_append(Eina_Chunk_List *list, const void *data) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Removes an item from a chunk list.
+ *
+ * @param[in] list The list
+ * @param[in] item The handle returned when the item was appended
+ *
+ * This is O(1) and can be done while walking the list with
+ * EINA_CHUNK_LIST_FOREACH(), for any item. The slot of the item is left
+ * empty and a chunk that gets emptied is unlinked but not freed, until
+ * eina_chunk_list_compact() is called.
+ *
+ * @since 1.24
+ */
+EAPI void eina_chunk_list_remove(Eina_Chunk_List *list, Eina_Chunk_List_Item *item) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Gives back the emptied chunks of a chunk list and fills its holes.
+ *
+ * @param[in] list The list
+ *
+ * Chunks where less than half of the used slots still hold an item get
+ * their items moved down, in the same order, so that walking them does not
+ * skip over holes anymore. The handles of these items stay valid.
+ *
+ * This does nothing if no item was removed since the last call.
+ *
+ * @warning This must not be called while the list is walked, as the walk
+ *          may be in a chunk that gets freed or compacted.
+ *
+ * @since 1.24
+ */
+EAPI void eina_chunk_list_compact(Eina_Chunk_List *list) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Returns a new iterator over a chunk list, from head to tail.
+ *
+ * @param[in] list The list
+ * @return A new iterator, otherwise @c NULL on failure
+ *
+ * @note The list must not be modified while the iterator is in use.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Iterator *eina_chunk_list_iterator_new(const Eina_Chunk_List *list) EINA_MALLOC EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @brief Gets the number of items in a chunk list.
+ *
+ * @param[in] list The list
+ * @return The number of items, @c 0 if @p list is @c NULL
+ *
+ * @since 1.24
+ */
+static inline unsigned int eina_chunk_list_count(const Eina_Chunk_List *list);
+
+/**
+ * @brief Gets the item an handle refers to.
+ *
+ * @param[in] item The handle returned by eina_chunk_list_append()
+ * @return The item
+ *
+ * @since 1.24
+ */
+static inline void *eina_chunk_list_item_data_get(const Eina_Chunk_List_Item *item);
+
+/**
+ * @brief Gets the first item of a chunk list.
+ *
+ * @param[in] list The list
+ * @return The first item, @c NULL if the list is empty or @c NULL
+ *
+ * @since 1.24
+ */
+static inline void *eina_chunk_list_first_get(const Eina_Chunk_List *list);
+
+/**
+ * @brief Gets the next item of a chunk list walk.
+ *
+ * @param[in,out] chunk The chunk being walked, moves to the next one at its end
+ * @param[in,out] index The next slot to look at in @p chunk
+ * @return The next item, @c NULL at the end of the list
+ *
+ * @note This is the building block of EINA_CHUNK_LIST_FOREACH().
+ *
+ * @since 1.24
+ */
+static inline void *eina_chunk_list_walk_next(Eina_Chunk_List_Chunk **chunk, unsigned int *index);
+
+/**
+ * @def EINA_CHUNK_LIST_FOREACH
+ * @brief Walks through a chunk list from head to tail.
+ *
+ * @param[in] list The list, can be @c NULL
+ * @param[out] chunk An #Eina_Chunk_List_Chunk pointer used for the walk
+ * @param[out] index An unsigned int used for the walk
+ * @param[out] data The current item
+ *
+ * @note Any item can be removed from the list during the walk, but
+ *       eina_chunk_list_compact() must not be called until it is over.
+ *
+ * @since 1.24
+ */
+#define EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)              \
+  for ((chunk) = (list) ? (list)->first : NULL, (index) = 0;            \
+       ((data) = eina_chunk_list_walk_next(&(chunk), &(index)));        \
+       )
+
+#include "eina_inline_chunk_list.x"
+
+/**
+ * @}
+ */
+
+#endif /* EINA_CHUNK_LIST_H_ */
@@ -53,7 +53,9 @@
 #include "eina_stringshare.h"
 #include "eina_hash.h"
 #include "eina_list.h"
+#include "eina_inlist.h"
 #include "eina_lock.h"
+#include "eina_thread.h"
 #include "eina_mmap.h"
 #include "eina_log.h"
 #include "eina_xattr.h"
@@ -73,6 +75,28 @@
 #define EINA_HUGE_PAGE (2 * 1024 * 1024)
 #define EINA_HUGE_PAGE_MIN (8 * EINA_HUGE_PAGE)
 
+// Prefetch requests are split so that shutdown never waits on a big one
+#define EINA_FILE_PREFETCH_CHUNK (1024 * 1024)
+
+typedef struct _Eina_File_Prefetch Eina_File_Prefetch;
+struct _Eina_File_Prefetch
+{
+   EINA_INLIST;
+
+   Eina_File *file;
+   unsigned long int offset;
+   unsigned long int length;
+};
+
+static Eina_Lock _eina_file_prefetch_lock;
+static Eina_Condition _eina_file_prefetch_cond;
+static Eina_Inlist *_eina_file_prefetch_queue = NULL;
+static Eina_Thread _eina_file_prefetch_thread;
+static Eina_Bool _eina_file_prefetch_running = EINA_FALSE;
+static Eina_Bool _eina_file_prefetch_exit = EINA_FALSE;
+// EINA_FILE_NOADVISE turns the policies above off, to compare with and without
+static Eina_Bool _eina_file_noadvise = EINA_FALSE;
+
 #ifdef HAVE_DIRENT_H
 typedef struct _Eina_File_Iterator Eina_File_Iterator;
 struct _Eina_File_Iterator
@@ -357,7 +381,14 @@ _eina_file_map_rule_apply(Eina_File_Populate rule, const void *map, unsigned lon
      {
       case EINA_FILE_RANDOM: flag = MADV_RANDOM; break;
       case EINA_FILE_SEQUENTIAL: flag = MADV_SEQUENTIAL; break;
+#ifdef MADV_POPULATE_READ
+      // fault the pages in right away instead of on first access
+      case EINA_FILE_POPULATE:
+         flag = _eina_file_noadvise ? MADV_WILLNEED : MADV_POPULATE_READ;
+         break;
+#else
       case EINA_FILE_POPULATE: flag = MADV_WILLNEED; break;
+#endif
       case EINA_FILE_WILLNEED: flag = MADV_WILLNEED; break;
       case EINA_FILE_DONTNEED: flag = MADV_DONTNEED; break;
 #ifdef MADV_REMOVE
@@ -367,6 +398,13 @@ _eina_file_map_rule_apply(Eina_File_Populate rule, const void *map, unsigned lon
 #else
 # warning "EINA_FILE_REMOVE does not have system support"
 #endif        
+#ifdef MADV_HUGEPAGE
+      case EINA_FILE_HUGEPAGE:
+         // HugeTLB maps are already made of huge pages
+         if (hugetlb) return tmp;
+         flag = MADV_HUGEPAGE;
+         break;
+#endif
       default: return tmp; break;
      }
 
@@ -385,7 +423,13 @@ _eina_file_map_rule_apply(Eina_File_Populate rule, const void *map, unsigned lon
           }
      }
 
+#ifdef MADV_POPULATE_READ
+   // kernels older than 5.14 don't know about it, just read ahead then
+   if ((madvise(addr, size, flag) != 0) && (flag == MADV_POPULATE_READ))
+     madvise(addr, size, MADV_WILLNEED);
+#else
    madvise(addr, size, flag);
+#endif
 
 #ifndef MAP_POPULATE
    if (rule == EINA_FILE_POPULATE)
@@ -397,6 +441,90 @@ _eina_file_map_rule_apply(Eina_File_Populate rule, const void *map, unsigned lon
    return tmp;
 }
 
+static void
+_eina_file_map_hugepage(void *map, unsigned long long length, Eina_Bool hugetlb)
+{
+#ifdef MADV_HUGEPAGE
+   // large read only maps are where transparent huge pages pay off, fewer
+   // faults and TLB misses, smaller ones would mostly waste memory
+   if ((!hugetlb) && (!_eina_file_noadvise) && (length >= EINA_HUGE_PAGE_MIN))
+     madvise(map, length, MADV_HUGEPAGE);
+#else
+   (void) map;
+   (void) length;
+   (void) hugetlb;
+#endif
+}
+
+static void
+_eina_file_prefetch_range(Eina_File *file, unsigned long int offset, unsigned long int length)
+{
+#if defined (HAVE_READAHEAD)
+   readahead(file->fd, offset, length);
+#elif defined (HAVE_POSIX_FADVISE)
+   posix_fadvise(file->fd, offset, length, POSIX_FADV_WILLNEED);
+#else
+   char buf[16 * 1024];
+   unsigned long int done;
+
+   // the data ends up in the page cache as a side effect of reading it
+   for (done = 0; done < length; )
+     {
+        ssize_t r;
+
+        r = pread(file->fd, buf, length - done > sizeof (buf) ? sizeof (buf) : length - done,
+                  offset + done);
+        if (r <= 0) break;
+        done += r;
+     }
+#endif
+}
+
+static void *
+_eina_file_prefetch_worker(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   eina_lock_take(&_eina_file_prefetch_lock);
+   while (!_eina_file_prefetch_exit)
+     {
+        Eina_File_Prefetch *pf;
+        unsigned long int length;
+
+        if (!_eina_file_prefetch_queue)
+          {
+             eina_condition_wait(&_eina_file_prefetch_cond);
+             continue;
+          }
+
+        pf = EINA_INLIST_CONTAINER_GET(_eina_file_prefetch_queue, Eina_File_Prefetch);
+        _eina_file_prefetch_queue = eina_inlist_remove(_eina_file_prefetch_queue,
+                                                       _eina_file_prefetch_queue);
+        eina_lock_release(&_eina_file_prefetch_lock);
+
+        length = pf->length;
+        if (length > EINA_FILE_PREFETCH_CHUNK) length = EINA_FILE_PREFETCH_CHUNK;
+        _eina_file_prefetch_range(pf->file, pf->offset, length);
+        pf->offset += length;
+        pf->length -= length;
+
+        eina_lock_take(&_eina_file_prefetch_lock);
+        if ((pf->length > 0) && (!_eina_file_prefetch_exit))
+          {
+             _eina_file_prefetch_queue = eina_inlist_prepend(_eina_file_prefetch_queue,
+                                                             EINA_INLIST_GET(pf));
+             continue;
+          }
+        eina_lock_release(&_eina_file_prefetch_lock);
+
+        eina_file_close(pf->file);
+        free(pf);
+
+        eina_lock_take(&_eina_file_prefetch_lock);
+     }
+   eina_lock_release(&_eina_file_prefetch_lock);
+
+   return NULL;
+}
+
 static Eina_Bool
 _eina_file_timestamp_compare(Eina_File *f, struct stat *st)
 {
@@ -977,7 +1105,10 @@ eina_file_map_all(Eina_File *file, Eina_File_Populate rule)
         hugetlb = !!(flags & MAP_HUGETLB);
 #endif
         if (!file->global_refcount)
-          file->global_hugetlb = hugetlb;
+          {
+             file->global_hugetlb = hugetlb;
+             _eina_file_map_hugepage(file->global_map, file->length, hugetlb);
+          }
         else
           hugetlb = file->global_hugetlb;
 
@@ -1049,6 +1180,7 @@ eina_file_map_new(Eina_File *file, Eina_File_Populate rule,
         map->refcount = 0;
 
         if (map->map == MAP_FAILED) goto on_error;
+        _eina_file_map_hugepage(map->map, map->length, map->hugetlb);
 
         eina_hash_add(file->map, &key, map);
         eina_hash_direct_add(file->rmap, &map->map, map);
@@ -1115,6 +1247,99 @@ eina_file_map_populate(Eina_File *file, Eina_File_Populate rule, const void *map
    eina_lock_release(&file->lock);
 }
 
+EAPI void
+eina_file_prefetch(Eina_File *file, unsigned long int offset, unsigned long int length)
+{
+   Eina_File_Prefetch *pf;
+
+   EINA_SAFETY_ON_NULL_RETURN(file);
+
+   if ((file->virtual) || (_eina_file_noadvise)) return;
+   if (offset >= file->length) return;
+   if ((length == 0) || (length > file->length - offset))
+     length = file->length - offset;
+
+   pf = malloc(sizeof (Eina_File_Prefetch));
+   if (!pf) return;
+   pf->file = eina_file_dup(file);
+   pf->offset = offset;
+   pf->length = length;
+
+   eina_lock_take(&_eina_file_prefetch_lock);
+   if (!_eina_file_prefetch_running)
+     {
+        _eina_file_prefetch_running =
+          eina_thread_create(&_eina_file_prefetch_thread, EINA_THREAD_BACKGROUND, -1,
+                             _eina_file_prefetch_worker, NULL);
+        if (!_eina_file_prefetch_running)
+          {
+             eina_lock_release(&_eina_file_prefetch_lock);
+             // no worker, not worth blocking the caller on it
+             eina_file_close(pf->file);
+             free(pf);
+             return;
+          }
+        eina_thread_name_set(_eina_file_prefetch_thread, "Eprefetch");
+     }
+   _eina_file_prefetch_queue = eina_inlist_append(_eina_file_prefetch_queue,
+                                                  EINA_INLIST_GET(pf));
+   eina_condition_signal(&_eina_file_prefetch_cond);
+   eina_lock_release(&_eina_file_prefetch_lock);
+}
+
+void
+eina_file_prefetch_init(void)
+{
+   eina_lock_new(&_eina_file_prefetch_lock);
+   eina_condition_new(&_eina_file_prefetch_cond, &_eina_file_prefetch_lock);
+   _eina_file_prefetch_exit = EINA_FALSE;
+   _eina_file_noadvise = !!getenv("EINA_FILE_NOADVISE");
+}
+
+EAPI void
+eina_file_fork_reset(void)
+{
+   extern Eina_Bool fork_resetting;
+
+   // only the forking thread survives in the child: the worker is gone and
+   // may have been holding the lock, the queue is picked up again by the
+   // worker started on the next request
+   fork_resetting = EINA_TRUE;
+   _eina_file_prefetch_running = EINA_FALSE;
+   eina_condition_free(&_eina_file_prefetch_cond);
+   eina_lock_free(&_eina_file_prefetch_lock);
+   eina_file_prefetch_init();
+   fork_resetting = EINA_FALSE;
+}
+
+void
+eina_file_prefetch_shutdown(void)
+{
+   Eina_File_Prefetch *pf;
+
+   eina_lock_take(&_eina_file_prefetch_lock);
+   _eina_file_prefetch_exit = EINA_TRUE;
+   eina_condition_signal(&_eina_file_prefetch_cond);
+   eina_lock_release(&_eina_file_prefetch_lock);
+
+   if (_eina_file_prefetch_running)
+     {
+        eina_thread_join(_eina_file_prefetch_thread);
+        _eina_file_prefetch_running = EINA_FALSE;
+     }
+
+   EINA_INLIST_FREE(_eina_file_prefetch_queue, pf)
+     {
+        _eina_file_prefetch_queue = eina_inlist_remove(_eina_file_prefetch_queue,
+                                                       EINA_INLIST_GET(pf));
+        eina_file_close(pf->file);
+        free(pf);
+     }
+
+   eina_condition_free(&_eina_file_prefetch_cond);
+   eina_lock_free(&_eina_file_prefetch_lock);
+}
+
 EAPI Eina_Bool
 eina_file_map_faulted(Eina_File *file, void *map)
 {
@@ -145,7 +145,8 @@ typedef enum {
   EINA_FILE_WILLNEED,   /**< Advise need for all the mapped memory */
   EINA_FILE_POPULATE,   /**< Request for all the mapped memory */
   EINA_FILE_DONTNEED,   /**< Indicate that the memory is no longer needed. This may result in the memory being removed from any caches if applicable. @since 1.8 */
-  EINA_FILE_REMOVE      /**< This memory is to be released and any content will be lost. Subsequent accesses will succeed but return fresh memory as if accessed for the first time. This may not succeed if the filesystem does not support it. @since 1.8 */
+  EINA_FILE_REMOVE,     /**< This memory is to be released and any content will be lost. Subsequent accesses will succeed but return fresh memory as if accessed for the first time. This may not succeed if the filesystem does not support it. @since 1.8 */
+  EINA_FILE_HUGEPAGE    /**< Advise backing the mapped memory with transparent huge pages, maps of at least 16Mb get this by default. @since 1.24 */
 } Eina_File_Populate;
 
 /* Why do this? Well PATH_MAX may vary from when eina itself is compiled
@@ -687,6 +688,40 @@ EAPI void
 eina_file_map_populate(Eina_File *file, Eina_File_Populate rule, const void *map,
                        unsigned long int offset, unsigned long int length);
 
+/**
+ * @brief Asks for a part of a file to be read ahead in the background.
+ * @details This queues a request to a worker thread that reads the given
+ *          range of @p file into the system page cache, so that a later
+ *          eina_file_map_all() or eina_file_map_new() of it does not wait on
+ *          the disk when touching it. It returns immediately and does not
+ *          map anything, the request may not be honored if the system
+ *          chooses to ignore it.
+ *
+ * @param[in] file The file handle to read ahead
+ * @param[in] offset The offset inside the file
+ * @param[in] length The length in bytes of the range to read, @c 0 means up
+ *            to the end of the file
+ *
+ * @note The file is referenced until the request is done, it is fine to
+ *       close it right after calling this.
+ * @note Setting EINA_FILE_NOADVISE in the environment disables this, the
+ *       default #EINA_FILE_HUGEPAGE advice and the faulting in done by
+ *       #EINA_FILE_POPULATE, so their effect can be measured.
+ *
+ * @since 1.24
+ */
+EAPI void eina_file_prefetch(Eina_File *file, unsigned long int offset, unsigned long int length);
+
+/**
+ * @brief Resets the state of the eina_file_prefetch() worker after a fork.
+ * @details The worker thread does not exist in the child of a fork, this
+ *          must be called in the child before using eina_file_prefetch() or
+ *          shutting down eina. ecore_fork_reset() calls it.
+ *
+ * @since 1.24
+ */
+EAPI void eina_file_fork_reset(void);
+
 /**
  * @brief Maps line by line in the memory efficiently using an #Eina_Iterator.
  * @details This function returns an iterator that acts like fgets without
@@ -1115,6 +1115,7 @@ eina_file_init(void)
    eina_spinlock_release(&_eina_statgen_lock);
    eina_lock_recursive_new(&_eina_file_lock_cache);
    eina_magic_string_set(EINA_FILE_MAGIC, "Eina_File");
+   eina_file_prefetch_init();
 
    return EINA_TRUE;
 }
@@ -1122,6 +1123,8 @@ eina_file_init(void)
 Eina_Bool
 eina_file_shutdown(void)
 {
+   eina_file_prefetch_shutdown();
+
    if (eina_hash_population(_eina_file_cache) > 0)
      {
         Eina_Iterator *it;
@@ -257,6 +257,20 @@ void eina_file_flush(Eina_File *file, unsigned long int length);
 void eina_file_common_map_free(Eina_File *file, void *map,
                                void (*free_func)(Eina_File_Map *map));
 
+/**
+ * @brief Sets up the background read ahead of eina_file_prefetch().
+ *
+ */
+void eina_file_prefetch_init(void);
+
+/**
+ * @brief Stops the read ahead worker and drops the requests it did not handle.
+ * This must happen before the file cache goes away as the pending requests
+ * hold a reference on their file.
+ *
+ */
+void eina_file_prefetch_shutdown(void);
+
 /** A pointer to the global Eina file cache. */
 extern Eina_Hash *_eina_file_cache;
 
@@ -843,6 +843,27 @@ eina_file_map_populate(Eina_File *file EINA_UNUSED, Eina_File_Populate rule EINA
 {
 }
 
+EAPI void
+eina_file_prefetch(Eina_File *file EINA_UNUSED, unsigned long int offset EINA_UNUSED,
+                   unsigned long int length EINA_UNUSED)
+{
+}
+
+EAPI void
+eina_file_fork_reset(void)
+{
+}
+
+void
+eina_file_prefetch_init(void)
+{
+}
+
+void
+eina_file_prefetch_shutdown(void)
+{
+}
+
 EAPI void *
 eina_file_map_all(Eina_File *file, Eina_File_Populate rule EINA_UNUSED)
 {
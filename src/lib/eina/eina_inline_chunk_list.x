@@ -0,0 +1,85 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EINA_INLINE_CHUNK_LIST_X_
+#define EINA_INLINE_CHUNK_LIST_X_
+
+/**
+ * @cond LOCAL
+ */
+
+/* Each chunk is followed by an array of bytes holding their own index,
+ * an handle points to one of them so its chunk is found back without any
+ * lookup. Another array of as many bytes comes right after it, giving the
+ * slot of the item of each handle, as compacting a chunk moves its items. */
+#define EINA_CHUNK_LIST_ITEM_CHUNK(Item)                                \
+  (((Eina_Chunk_List_Chunk *)(((unsigned char *)(Item)) -               \
+                              *((const unsigned char *)(Item)))) - 1)
+
+#define EINA_CHUNK_LIST_ITEM_SLOT(Chunk, Item)                          \
+  (((const unsigned char *)(Item))[(Chunk)->size])
+
+/**
+ * @endcond
+ */
+
+static inline unsigned int
+eina_chunk_list_count(const Eina_Chunk_List *list)
+{
+   if (!list) return 0;
+   return list->count;
+}
+
+static inline void *
+eina_chunk_list_item_data_get(const Eina_Chunk_List_Item *item)
+{
+   Eina_Chunk_List_Chunk *chunk;
+
+   if (!item) return NULL;
+   chunk = EINA_CHUNK_LIST_ITEM_CHUNK(item);
+   return chunk->data[EINA_CHUNK_LIST_ITEM_SLOT(chunk, item)];
+}
+
+static inline void *
+eina_chunk_list_walk_next(Eina_Chunk_List_Chunk **chunk, unsigned int *index)
+{
+   while (*chunk)
+     {
+        while (*index < (*chunk)->fill)
+          {
+             void *data = (*chunk)->data[(*index)++];
+
+             if (data) return data;
+          }
+        *chunk = (*chunk)->next;
+        *index = 0;
+     }
+   return NULL;
+}
+
+static inline void *
+eina_chunk_list_first_get(const Eina_Chunk_List *list)
+{
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int index = 0;
+
+   if (!list) return NULL;
+   chunk = list->first;
+   return eina_chunk_list_walk_next(&chunk, &index);
+}
+
+#endif
@@ -9,6 +9,8 @@
 #include "eina_private.h"
 #include "eina_str.h"
 #include "eina_magic.h"
+#include "eina_lock.h"
+#include "eina_mempool.h"
 #include "eina_safety_checks.h"
 #include "eina_strbuf.h"
 #include "eina_strbuf_common.h"
@@ -21,9 +23,67 @@
  * @cond LOCAL
  */
 
-#define EINA_STRBUF_INIT_SIZE 32
 #define EINA_STRBUF_INIT_STEP 32
 #define EINA_STRBUF_MAX_STEP 4096
+/* above this many characters the buffer grows by half its size at a time,
+ * keeping big appends linear instead of copying everything every 4096 */
+#define EINA_STRBUF_LARGE_SIZE (16 * EINA_STRBUF_MAX_STEP)
+
+/* most buffers are short lived, recycling them avoids going to malloc for
+ * each of them */
+static Eina_Mempool *_eina_strbuf_mp = NULL;
+/* buffers still taken from the pool, while there are some it is kept past
+ * eina_shutdown() and only serves to give them back, the next init picks
+ * it up again */
+static Eina_Spinlock _eina_strbuf_mp_lock;
+static unsigned int _eina_strbuf_mp_usage = 0;
+static Eina_Bool _eina_strbuf_mp_orphan = EINA_FALSE;
+static int _eina_strbuf_common_init_count = 0;
+
+static inline Eina_Strbuf *
+_eina_strbuf_common_alloc(void)
+{
+   Eina_Strbuf *buf = NULL;
+
+   // strbuf can be used before eina_init() or after eina_shutdown()
+   if ((_eina_strbuf_mp) && (!_eina_strbuf_mp_orphan))
+     {
+        eina_spinlock_take(&_eina_strbuf_mp_lock);
+        buf = eina_mempool_calloc(_eina_strbuf_mp, sizeof(Eina_Strbuf));
+        if (buf) _eina_strbuf_mp_usage++;
+        eina_spinlock_release(&_eina_strbuf_mp_lock);
+     }
+   if (buf)
+     {
+        buf->pooled = EINA_TRUE;
+        return buf;
+     }
+   return calloc(1, sizeof(Eina_Strbuf));
+}
+
+static inline void
+_eina_strbuf_common_release(Eina_Strbuf *buf)
+{
+   if (!buf->pooled)
+     {
+        free(buf);
+        return;
+     }
+
+   // a pooled buffer keeps the pool around, so it can't be gone here
+   EINA_SAFETY_ON_NULL_RETURN(_eina_strbuf_mp);
+
+   eina_spinlock_take(&_eina_strbuf_mp_lock);
+   eina_mempool_free(_eina_strbuf_mp, buf);
+   _eina_strbuf_mp_usage--;
+   eina_spinlock_release(&_eina_strbuf_mp_lock);
+}
+
+static inline void
+_eina_strbuf_common_storage_free(Eina_Strbuf *buf, void *storage)
+{
+   if (storage != buf->inline_buf) free(storage);
+}
 
 /**
  * @endcond
@@ -47,6 +107,37 @@
 Eina_Bool
 eina_strbuf_common_init(void)
 {
+   const char *choice, *tmp;
+
+   // strbuf and ustrbuf both get here
+   if ((_eina_strbuf_common_init_count++) > 0)
+     return EINA_TRUE;
+
+   // buffers from before the last shutdown are still out, keep their pool
+   if (_eina_strbuf_mp)
+     {
+        eina_spinlock_take(&_eina_strbuf_mp_lock);
+        _eina_strbuf_mp_orphan = EINA_FALSE;
+        eina_spinlock_release(&_eina_strbuf_mp_lock);
+        return EINA_TRUE;
+     }
+
+#ifdef EINA_DEFAULT_MEMPOOL
+   choice = "pass_through";
+#else
+   choice = "chained_mempool";
+#endif
+   tmp = getenv("EINA_MEMPOOL");
+   if (tmp && tmp[0])
+     choice = tmp;
+
+   _eina_strbuf_mp = eina_mempool_add(choice, "strbuf", NULL,
+                                      sizeof(Eina_Strbuf), 32);
+   if (!_eina_strbuf_mp)
+     EINA_LOG_ERR("Mempool for strbuf cannot be allocated, falling back to malloc.");
+   else
+     eina_spinlock_new(&_eina_strbuf_mp_lock);
+
    return EINA_TRUE;
 }
 
@@ -64,6 +155,26 @@ eina_strbuf_common_init(void)
 Eina_Bool
 eina_strbuf_common_shutdown(void)
 {
+   if ((--_eina_strbuf_common_init_count) > 0)
+     return EINA_TRUE;
+
+   if (_eina_strbuf_mp)
+     {
+        Eina_Bool used;
+
+        eina_spinlock_take(&_eina_strbuf_mp_lock);
+        used = (_eina_strbuf_mp_usage > 0);
+        if (used) _eina_strbuf_mp_orphan = EINA_TRUE;
+        eina_spinlock_release(&_eina_strbuf_mp_lock);
+
+        if (!used)
+          {
+             eina_mempool_del(_eina_strbuf_mp);
+             _eina_strbuf_mp = NULL;
+             eina_spinlock_free(&_eina_strbuf_mp_lock);
+          }
+     }
+
    return EINA_TRUE;
 }
 
@@ -81,11 +192,11 @@ _eina_strbuf_common_init(size_t csize, Eina_Strbuf *buf)
 {
    buf->ro = EINA_FALSE;
    buf->len = 0;
-   buf->size = EINA_STRBUF_INIT_SIZE;
+   buf->size = EINA_STRBUF_INLINE_SIZE / csize;
    buf->step = EINA_STRBUF_INIT_STEP;
 
-   buf->buf = calloc(csize, buf->size);
-   if (EINA_UNLIKELY(!buf->buf)) return EINA_FALSE;
+   buf->buf = buf->inline_buf;
+   memset(buf->buf, 0, csize);
    return EINA_TRUE;
 }
 
@@ -147,10 +258,23 @@ _eina_strbuf_common_resize(size_t csize, Eina_Strbuf *buf, size_t size)
      }
 
    new_size = (((size / new_step) + 1) * new_step);
+   if ((size > buf->size) && (size > EINA_STRBUF_LARGE_SIZE) &&
+       (new_size < buf->size + (buf->size >> 1)))
+     new_size = buf->size + (buf->size >> 1);
 
    if (buf->size == new_size * csize) return EINA_TRUE;
 
    copy = buf->buf;
+   if (buf->buf == buf->inline_buf)
+     {
+        /* still fits, no need to go to the heap for shrinking */
+        if (new_size <= buf->size) return EINA_TRUE;
+        buffer = malloc(new_size * csize);
+        if (EINA_UNLIKELY(!buffer)) return EINA_FALSE;
+        memcpy(buffer, copy, buf->size * csize);
+        goto done;
+     }
+
    if (EINA_UNLIKELY(buf->ro))
      buf->buf = NULL;
 
@@ -164,6 +288,7 @@ _eina_strbuf_common_resize(size_t csize, Eina_Strbuf *buf, size_t size)
         buf->ro = EINA_FALSE;
      }
 
+ done:
    buf->buf = buffer;
    buf->size = new_size;
    buf->step = new_step;
@@ -252,7 +377,7 @@ eina_strbuf_common_new(size_t csize)
 {
    Eina_Strbuf *buf;
 
-   buf = calloc(1, sizeof(Eina_Strbuf));
+   buf = _eina_strbuf_common_alloc();
    if (EINA_UNLIKELY(!buf)) return NULL;
    if (EINA_UNLIKELY(!_eina_strbuf_common_init(csize, buf)))
      {
@@ -286,7 +411,7 @@ eina_strbuf_common_manage_new(size_t csize,
 {
    Eina_Strbuf *buf;
 
-   buf = calloc(1, sizeof(Eina_Strbuf));
+   buf = _eina_strbuf_common_alloc();
    if (EINA_UNLIKELY(!buf)) return NULL;
    if (EINA_UNLIKELY(!_eina_strbuf_common_manage_init(csize, buf, str, len)))
      {
@@ -320,7 +445,7 @@ eina_strbuf_common_manage_ro_new(size_t csize,
 {
    Eina_Strbuf *buf;
 
-   buf = calloc(1, sizeof(Eina_Strbuf));
+   buf = _eina_strbuf_common_alloc();
    if (EINA_UNLIKELY(!buf)) return NULL;
    if (EINA_UNLIKELY(!_eina_strbuf_common_manage_init(csize, buf,
                                                       (void*) str, len)))
@@ -344,8 +469,8 @@ eina_strbuf_common_manage_ro_new(size_t csize,
 void
 eina_strbuf_common_free(Eina_Strbuf *buf)
 {
-   if (!buf->ro) free(buf->buf);
-   free(buf);
+   if (!buf->ro) _eina_strbuf_common_storage_free(buf, buf->buf);
+   _eina_strbuf_common_release(buf);
 }
 
 /**
@@ -762,7 +887,7 @@ eina_strbuf_common_remove(size_t csize,
    remove_len = end - start;
    if (remove_len == buf->len)
      {
-        free(buf->buf);
+        _eina_strbuf_common_storage_free(buf, buf->buf);
         return _eina_strbuf_common_init(csize, buf);
      }
 
@@ -826,6 +951,15 @@ eina_strbuf_common_string_steal(size_t csize, Eina_Strbuf *buf)
         memcpy(dest, buf->buf, buf->len);
         buf->buf = dest;
      }
+   else if (buf->buf == buf->inline_buf)
+     {
+        // the string has to outlive the buffer
+        ret = malloc((buf->len + 1) * csize);
+        if (!ret) return NULL;
+        memcpy(ret, buf->buf, (buf->len + 1) * csize);
+        _eina_strbuf_common_init(csize, buf);
+        return ret;
+     }
 
    ret = buf->buf;
    // TODO: Check return value and do something clever
@@ -846,7 +980,7 @@ eina_strbuf_common_string_steal(size_t csize, Eina_Strbuf *buf)
 void
 eina_strbuf_common_string_free(size_t csize, Eina_Strbuf *buf)
 {
-   free(buf->buf);
+   _eina_strbuf_common_storage_free(buf, buf->buf);
    _eina_strbuf_common_init(csize, buf);
 }
 
@@ -1060,6 +1194,6 @@ eina_strbuf_replace_all(Eina_Strbuf *buf, const char *str, const char *with)
           len - start);
    buf->len = len;
    memset(((unsigned char *)(buf->buf)) + buf->len, 0, 1);
-   free(tmp_buf);
+   _eina_strbuf_common_storage_free(buf, tmp_buf);
    return n;
 }
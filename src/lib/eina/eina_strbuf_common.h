@@ -7,6 +7,10 @@
 #include "eina_magic.h"
 #include "eina_strbuf.h"
 
+/* Bytes of string kept inside the buffer itself, so that short strings
+ * don't need an allocation of their own */
+#define EINA_STRBUF_INLINE_SIZE 64
+
 /**
  * @struct _Eina_Strbuf
  * String buffer to facilitate string operations.
@@ -18,9 +22,14 @@ struct _Eina_Strbuf
    size_t size;
    size_t step;
 
+   /* buf points here until the string outgrows it, kept right after the
+    * size_t fields so that it is aligned for any character size */
+   unsigned char inline_buf[EINA_STRBUF_INLINE_SIZE];
+
    EINA_MAGIC
 
    Eina_Bool ro : 1;
+   Eina_Bool pooled : 1;
 };
 
 #define EINA_MAGIC_CHECK_STRBUF(d, ...)                         \
@@ -54,6 +54,7 @@ struct list
 {
    struct list_node *head;
    struct list_node *tail;
+   unsigned int count;
 };
 
 struct rect
@@ -79,6 +80,15 @@ typedef struct splitter
    list_t rects;
 } splitter_t;
 
+typedef struct grid
+{
+   unsigned char *cells; /* one byte per tile, non zero when dirty */
+   int w, h; /* size in tiles */
+   int tw, th; /* size of a tile in pixels */
+   unsigned int count; /* number of dirty tiles */
+   Eina_Bool need_rects; /* rects are out of date with cells */
+} grid_t;
+
 typedef struct list_node_pool
 {
    list_node_t *node;
@@ -88,7 +98,7 @@ typedef struct list_node_pool
 
 
 static const list_node_t list_node_zeroed = { NULL };
-static const list_t list_zeroed = { NULL, NULL };
+static const list_t list_zeroed = { NULL, NULL, 0 };
 static list_node_pool_t list_node_pool = { NULL, 0, 1024 };
 
 
@@ -115,6 +125,10 @@ struct _Eina_Tiler
    Eina_Rectangle area;
    EINA_MAGIC
    splitter_t splitter;
+   grid_t grid;
+
+   Eina_Tiler_Strategy strategy;
+   Eina_Tiler_Stats stats;
 
    Eina_Bool rounding : 1;
    Eina_Bool strict : 1;
@@ -187,6 +201,7 @@ static inline void rect_list_concat(list_t *rects, list_t *other)
         rects->head = other->head;
         rects->tail = other->tail;
      }
+   rects->count += other->count;
 
    *other = list_zeroed;
 }
@@ -203,6 +218,7 @@ static inline void rect_list_append_node(list_t *rects, list_node_t *node)
         rects->head = node;
         rects->tail = node;
      }
+   rects->count++;
 }
 
 static inline void rect_list_append(list_t *rects, const rect_t r)
@@ -578,6 +594,7 @@ rect_list_unlink_next(list_t *rects, list_node_t *parent_node)
 
    if (rects->tail == node)
       rects->tail = parent_node;
+   rects->count--;
 
    *node = list_node_zeroed;
    return node;
@@ -982,10 +999,15 @@ static void rect_list_add_split_fuzzy_and_merge(list_t *rects,
    if (n && n->next)
      {
         list_t to_merge;
+        list_node_t *m;
 
         /* split list into 2 segments, already merged and to merge */
         to_merge.head = n->next;
         to_merge.tail = rects->tail;
+        to_merge.count = 0;
+        for (m = to_merge.head; m; m = m->next)
+          to_merge.count++;
+        rects->count -= to_merge.count;
         rects->tail = n;
         n->next = NULL;
 
@@ -1013,9 +1035,34 @@ static inline void _splitter_tile_size_set(Eina_Tiler *t,
    t->splitter.rects = list_zeroed;
 }
 
+static Eina_Bool _grid_rect_add(Eina_Tiler *t, const Eina_Rectangle *rect);
+static void _grid_rect_del(Eina_Tiler *t, const Eina_Rectangle *rect);
+
+/* Rounding only applies to the rectangles stored by the splitter, the grid
+ * always works on real coordinates. */
+static inline Eina_Bool _tiler_rounding(const Eina_Tiler *t)
+{
+   return t->rounding && (t->strategy != EINA_TILER_STRATEGY_GRID);
+}
+
+/* Accepted error of the cost strategy: merging two rectangles is worth it
+ * as long as the extra pixels drawn cost less than handling one more
+ * rectangle, and each rectangle becomes more expensive the more there is. */
+static inline int _splitter_accepted_error(const Eina_Tiler *t)
+{
+   if (t->strategy != EINA_TILER_STRATEGY_COST)
+     return t->tile.w * t->tile.h;
+
+   return t->tile.w * t->tile.h * (1 + (t->splitter.rects.count / 8));
+}
+
 static inline Eina_Bool _splitter_rect_add(Eina_Tiler *t, Eina_Rectangle *rect)
 {
    rect_node_t *rn;
+   int error;
+
+   if (t->strategy == EINA_TILER_STRATEGY_GRID)
+     return _grid_rect_add(t, rect);
 
    //printf("ACCOUNTING[1]: add_redraw: %4d,%4d %3dx%3d\n", x, y, w, h);
    if (t->rounding)
@@ -1035,10 +1082,10 @@ static inline Eina_Bool _splitter_rect_add(Eina_Tiler *t, Eina_Rectangle *rect)
    rect_init(&rn->rect, rect->x, rect->y, rect->w, rect->h);
    //printf("ACCOUNTING[2]: add_redraw: %4d,%4d %3dx%3d\n", x, y, w, h);
    //testing on my core2 duo desktop - fuzz of 32 or 48 is best.
+   error = _splitter_accepted_error(t);
    rect_list_add_split_fuzzy_and_merge(&t->splitter.rects,
                                        (list_node_t *)rn,
-                                       t->tile.w * t->tile.h,
-                                       t->tile.w * t->tile.h);
+                                       error, error);
    return EINA_TRUE;
 }
 
@@ -1046,6 +1093,12 @@ static inline void _splitter_rect_del(Eina_Tiler *t, Eina_Rectangle *rect)
 {
    rect_t r;
 
+   if (t->strategy == EINA_TILER_STRATEGY_GRID)
+     {
+        _grid_rect_del(t, rect);
+        return;
+     }
+
    if (!t->splitter.rects.head)
       return;
 
@@ -1079,6 +1132,170 @@ static inline void _splitter_clear(Eina_Tiler *t)
 }
 /* end of splitter algorithm */
 
+/* The grid algorithm: every tile touched by a rectangle is marked dirty in
+ * a bitmap, and rectangles are only rebuilt from it when iterating. Adding
+ * a rectangle has a cost proportional to its size in tiles, no matter how
+ * many rectangles were already added, and the overdraw is bounded by the
+ * tile size. */
+#define EINA_TILER_GRID_TILE_MIN 8
+
+static void _grid_free(Eina_Tiler *t)
+{
+   free(t->grid.cells);
+   t->grid.cells = NULL;
+   t->grid.w = t->grid.h = 0;
+   t->grid.count = 0;
+   t->grid.need_rects = EINA_FALSE;
+}
+
+static Eina_Bool _grid_setup(Eina_Tiler *t)
+{
+   if (t->grid.cells) return EINA_TRUE;
+
+   t->grid.tw = MAX(t->tile.w, EINA_TILER_GRID_TILE_MIN);
+   t->grid.th = MAX(t->tile.h, EINA_TILER_GRID_TILE_MIN);
+   t->grid.w = (t->area.w + t->grid.tw - 1) / t->grid.tw;
+   t->grid.h = (t->area.h + t->grid.th - 1) / t->grid.th;
+   t->grid.count = 0;
+   t->grid.cells = calloc(t->grid.w * t->grid.h, sizeof (unsigned char));
+   return !!t->grid.cells;
+}
+
+static Eina_Bool _grid_rect_add(Eina_Tiler *t, const Eina_Rectangle *rect)
+{
+   int x1, y1, x2, y2, x, y;
+
+   if (!_grid_setup(t)) return EINA_FALSE;
+
+   x1 = rect->x / t->grid.tw;
+   y1 = rect->y / t->grid.th;
+   x2 = MIN((rect->x + rect->w - 1) / t->grid.tw, t->grid.w - 1);
+   y2 = MIN((rect->y + rect->h - 1) / t->grid.th, t->grid.h - 1);
+
+   for (y = y1; y <= y2; y++)
+     {
+        unsigned char *cell = t->grid.cells + y * t->grid.w + x1;
+
+        for (x = x1; x <= x2; x++, cell++)
+          {
+             if (*cell) continue;
+             *cell = 1;
+             t->grid.count++;
+             t->grid.need_rects = EINA_TRUE;
+          }
+     }
+   return EINA_TRUE;
+}
+
+static void _grid_rect_del(Eina_Tiler *t, const Eina_Rectangle *rect)
+{
+   int x1, y1, x2, y2, x, y;
+
+   if (!t->grid.count) return;
+
+   // Only tiles that are completely covered can be cleaned
+   x1 = (rect->x + t->grid.tw - 1) / t->grid.tw;
+   y1 = (rect->y + t->grid.th - 1) / t->grid.th;
+   x2 = (rect->x + rect->w) / t->grid.tw;
+   y2 = (rect->y + rect->h) / t->grid.th;
+   // The last partial tile is only covered if it is on the area border
+   if (rect->x + rect->w >= t->area.w) x2 = t->grid.w;
+   if (rect->y + rect->h >= t->area.h) y2 = t->grid.h;
+   x2 = MIN(x2, t->grid.w);
+   y2 = MIN(y2, t->grid.h);
+
+   for (y = y1; y < y2; y++)
+     {
+        unsigned char *cell = t->grid.cells + y * t->grid.w + x1;
+
+        for (x = x1; x < x2; x++, cell++)
+          {
+             if (!*cell) continue;
+             *cell = 0;
+             t->grid.count--;
+             t->grid.need_rects = EINA_TRUE;
+          }
+     }
+}
+
+static void _grid_clear(Eina_Tiler *t)
+{
+   if (t->grid.cells)
+     memset(t->grid.cells, 0, t->grid.w * t->grid.h);
+   t->grid.count = 0;
+   t->grid.need_rects = EINA_FALSE;
+   rect_list_clear(&t->splitter.rects);
+}
+
+/* Turn the dirty tiles into rectangles: horizontal runs of dirty tiles,
+ * extended down as long as the next row has a run with the same span. */
+static void _grid_rects_build(Eina_Tiler *t)
+{
+   rect_node_t **runs, **prev, **cur;
+   int prev_count = 0, x, y;
+
+   rect_list_clear(&t->splitter.rects);
+   t->grid.need_rects = EINA_FALSE;
+   if (!t->grid.count) return;
+
+   runs = malloc(sizeof (rect_node_t *) * (t->grid.w + 1) * 2);
+   if (!runs) return;
+   prev = runs;
+   cur = runs + t->grid.w + 1;
+
+   for (y = 0; y < t->grid.h; y++)
+     {
+        const unsigned char *row = t->grid.cells + y * t->grid.w;
+        rect_node_t **swap;
+        int cur_count = 0, p = 0;
+
+        for (x = 0; x < t->grid.w; )
+          {
+             rect_node_t *rn = NULL;
+             int start;
+
+             if (!row[x])
+               {
+                  x++;
+                  continue;
+               }
+
+             start = x;
+             while ((x < t->grid.w) && row[x]) x++;
+
+             // Runs of the previous row are sorted, look for the same span
+             while ((p < prev_count) &&
+                    (prev[p]->rect.left < start * t->grid.tw))
+               p++;
+             if ((p < prev_count) &&
+                 (prev[p]->rect.left == start * t->grid.tw) &&
+                 (prev[p]->rect.right == x * t->grid.tw))
+               {
+                  rn = prev[p++];
+                  rect_init(&rn->rect, rn->rect.left, rn->rect.top,
+                            rn->rect.width, rn->rect.height + t->grid.th);
+               }
+             else
+               {
+                  rn = (rect_node_t *)rect_list_node_pool_get();
+                  rn->_lst = list_node_zeroed;
+                  rect_init(&rn->rect, start * t->grid.tw, y * t->grid.th,
+                            (x - start) * t->grid.tw, t->grid.th);
+                  rect_list_append_node(&t->splitter.rects, (list_node_t *)rn);
+               }
+             cur[cur_count++] = rn;
+          }
+
+        swap = prev;
+        prev = cur;
+        cur = swap;
+        prev_count = cur_count;
+     }
+
+   free(runs);
+}
+/* end of grid algorithm */
+
 static Eina_Bool _iterator_next(Eina_Iterator_Tiler *it, void **data)
 {
    list_node_t *n;
@@ -1089,7 +1306,7 @@ static Eina_Bool _iterator_next(Eina_Iterator_Tiler *it, void **data)
 
         cur = ((rect_node_t *)n)->rect;
 
-        if (it->tiler->rounding)
+        if (_tiler_rounding(it->tiler))
           {
              it->r.x = cur.left << 1;
              it->r.y = cur.top << 1;
@@ -1129,6 +1346,27 @@ static void _iterator_free(Eina_Iterator_Tiler *it)
    free(it);
 }
 
+static void _tiler_stats_output(Eina_Tiler *t)
+{
+   const list_node_t *n;
+
+   t->stats.iterations++;
+   for (n = t->splitter.rects.head; n; n = n->next)
+     {
+        Eina_Rectangle r;
+        rect_t cur;
+
+        cur = ((rect_node_t *)n)->rect;
+        EINA_RECTANGLE_SET(&r, cur.left, cur.top, cur.width, cur.height);
+        if (_tiler_rounding(t))
+          EINA_RECTANGLE_SET(&r, r.x << 1, r.y << 1, r.w << 1, r.h << 1);
+        if (!eina_rectangle_intersection(&r, &t->area)) continue;
+
+        t->stats.rects++;
+        t->stats.rects_area += (unsigned long long)r.w * r.h;
+     }
+}
+
 /*============================================================================*
 *                                 Global                                     *
 *============================================================================*/
@@ -1165,6 +1403,7 @@ EAPI void eina_tiler_free(Eina_Tiler *t)
 
    EINA_MAGIC_CHECK_TILER(t);
    _splitter_del(t);
+   _grid_free(t);
    free(t);
 }
 
@@ -1176,6 +1415,11 @@ EAPI void eina_tiler_area_size_set(Eina_Tiler *t, int w, int h)
 
    t->area.w = w;
    t->area.h = h;
+   if (t->strategy == EINA_TILER_STRATEGY_GRID)
+     {
+        rect_list_clear(&t->splitter.rects);
+        _grid_free(t);
+     }
 }
 
 EAPI void eina_tiler_area_size_get(const Eina_Tiler *t, int *w, int *h)
@@ -1196,12 +1440,15 @@ EAPI void eina_tiler_tile_size_set(Eina_Tiler *t, int w, int h)
    t->tile.w = w;
    t->tile.h = h;
    _splitter_tile_size_set(t, w, h);
+   _grid_free(t);
 }
 
 EAPI Eina_Bool
 eina_tiler_empty(const Eina_Tiler *t)
 {
    EINA_MAGIC_CHECK_TILER(t, EINA_TRUE);
+   if (t->strategy == EINA_TILER_STRATEGY_GRID)
+     return !t->grid.count;
    return ((!t->splitter.rects.head) && (!t->splitter.rects.tail));
 }
 
@@ -1239,6 +1486,9 @@ EAPI Eina_Bool eina_tiler_rect_add(Eina_Tiler *t, const Eina_Rectangle *r)
    if (_rect_same(&tmp, &t->last.add))
       return EINA_TRUE;
 
+   t->stats.added++;
+   t->stats.added_area += (unsigned long long)tmp.w * tmp.h;
+
    t->last.add = tmp;
    t->last.del.w = t->last.del.h = -1;
 
@@ -1265,6 +1515,8 @@ EAPI void eina_tiler_rect_del(Eina_Tiler *t, const Eina_Rectangle *r)
    if (_rect_same(&tmp, &t->last.del))
       return;
 
+   t->stats.deleted++;
+
    t->last.del = tmp;
    t->last.add.w = t->last.add.h = -1;
 
@@ -1275,6 +1527,7 @@ EAPI void eina_tiler_clear(Eina_Tiler *t)
 {
    EINA_MAGIC_CHECK_TILER(t);
    _splitter_clear(t);
+   _grid_clear(t);
    t->last.add.w = -1;
    t->last.add.h = -1;
    t->last.del.w = -1;
@@ -1288,6 +1541,41 @@ eina_tiler_strict_set(Eina_Tiler *t, Eina_Bool strict)
    t->strict = strict;
 }
 
+EAPI void
+eina_tiler_strategy_set(Eina_Tiler *t, Eina_Tiler_Strategy strategy)
+{
+   EINA_MAGIC_CHECK_TILER(t);
+   EINA_SAFETY_ON_TRUE_RETURN(strategy > EINA_TILER_STRATEGY_COST);
+
+   if (t->strategy == strategy) return;
+
+   eina_tiler_clear(t);
+   _grid_free(t);
+   t->strategy = strategy;
+}
+
+EAPI Eina_Tiler_Strategy
+eina_tiler_strategy_get(const Eina_Tiler *t)
+{
+   EINA_MAGIC_CHECK_TILER(t, EINA_TILER_STRATEGY_FUZZY);
+   return t->strategy;
+}
+
+EAPI void
+eina_tiler_stats_get(const Eina_Tiler *t, Eina_Tiler_Stats *stats)
+{
+   EINA_MAGIC_CHECK_TILER(t);
+   EINA_SAFETY_ON_NULL_RETURN(stats);
+   *stats = t->stats;
+}
+
+EAPI void
+eina_tiler_stats_reset(Eina_Tiler *t)
+{
+   EINA_MAGIC_CHECK_TILER(t);
+   memset(&t->stats, 0, sizeof (t->stats));
+}
+
 EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
 {
    Eina_Iterator_Tiler *it;
@@ -1302,7 +1590,12 @@ EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
 
    it->tiler = t;
 
-   if (t->splitter.need_merge == EINA_TRUE)
+   if (t->strategy == EINA_TILER_STRATEGY_GRID)
+     {
+        if (t->grid.need_rects)
+          _grid_rects_build((Eina_Tiler *)t);
+     }
+   else if (t->splitter.need_merge == EINA_TRUE)
      {
         splitter_t *sp;
         list_t to_merge;
@@ -1351,6 +1644,8 @@ EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
         return NULL;
      }
 
+   _tiler_stats_output((Eina_Tiler *)t);
+
    it->iterator.version = EINA_ITERATOR_VERSION;
    it->iterator.next = FUNC_ITERATOR_NEXT(_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
@@ -1389,7 +1684,7 @@ eina_tiler_union(Eina_Tiler *dst,
    EINA_ITERATOR_FOREACH(itr, rect)
      {
         _rect = *rect;
-        if (src->rounding)
+        if (_tiler_rounding(src))
           {
              _rect.w -= 1;
              _rect.h -= 1;
@@ -1428,7 +1723,7 @@ eina_tiler_subtract(Eina_Tiler *dst,
    EINA_ITERATOR_FOREACH(itr, rect)
      {
         _rect = *rect;
-        if (src->rounding)
+        if (_tiler_rounding(src))
           {
              _rect.w -= 1;
              _rect.h -= 1;
@@ -1484,7 +1779,7 @@ eina_tiler_intersection(Eina_Tiler *t1,
              rect.w = MIN(rect1->x + rect1->w, rect2->x + rect2->w) - rect.x;
              rect.h = MIN(rect1->y + rect1->h, rect2->y + rect2->h) - rect.y;
 
-             if ((t1->rounding) || (t2->rounding))
+             if (_tiler_rounding(t1) || _tiler_rounding(t2))
                {
                   rect.w -= 1;
                   rect.h -= 1;
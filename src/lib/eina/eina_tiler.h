@@ -174,6 +174,43 @@ struct Eina_Tile_Grid_Info
 
 typedef struct _Eina_Tile_Grid_Slicer Eina_Tile_Grid_Slicer;
 
+/**
+ * @typedef Eina_Tiler_Strategy
+ * How a tiler merges the rectangles it is given.
+ *
+ * @since 1.24
+ */
+typedef enum _Eina_Tiler_Strategy
+{
+   EINA_TILER_STRATEGY_FUZZY = 0, /**< Split and merge rectangles, accepting up to one tile of overdraw per merge. This is the default. */
+   EINA_TILER_STRATEGY_GRID, /**< Mark dirty tiles in a grid and output spans of them. Adding a rectangle doesn't depend on how many were already added, overdraw is bounded by the tile size (at least 8x8). */
+   EINA_TILER_STRATEGY_COST /**< Like #EINA_TILER_STRATEGY_FUZZY, but the accepted overdraw grows with the number of rectangles, trading more pixels for less rectangles. */
+} Eina_Tiler_Strategy;
+
+/**
+ * @typedef Eina_Tiler_Stats
+ * Damage statistics of a tiler.
+ *
+ * @since 1.24
+ */
+typedef struct _Eina_Tiler_Stats Eina_Tiler_Stats;
+
+/**
+ * @struct _Eina_Tiler_Stats
+ * Damage statistics of a tiler, accumulated until eina_tiler_stats_reset().
+ *
+ * @since 1.24
+ */
+struct _Eina_Tiler_Stats
+{
+   unsigned int       added; /**< number of rectangles added */
+   unsigned int       deleted; /**< number of rectangles deleted */
+   unsigned long long added_area; /**< sum of the area of the added rectangles, overlaps included */
+   unsigned int       iterations; /**< number of iterators created over the tiler */
+   unsigned int       rects; /**< number of rectangles given out by those iterators */
+   unsigned long long rects_area; /**< sum of the area of the rectangles given out */
+};
+
 /**
  * @brief Creates a new tiler with @p w width and @p h height.
  *
@@ -244,6 +281,53 @@ EAPI void               eina_tiler_area_size_get(const Eina_Tiler *t, int *w, in
  */
 EAPI void               eina_tiler_strict_set(Eina_Tiler *t, Eina_Bool strict);
 
+/**
+ * @brief Sets the strategy used by a tiler to merge rectangles.
+ *
+ * @param[in,out] t The tiler.
+ * @param[in] strategy The strategy to use.
+ *
+ * Changing the strategy clears the tiler. With #EINA_TILER_STRATEGY_GRID,
+ * changing the area or tile size of the tiler also clears it.
+ *
+ * @since 1.24
+ */
+EAPI void               eina_tiler_strategy_set(Eina_Tiler *t, Eina_Tiler_Strategy strategy);
+
+/**
+ * @brief Gets the strategy used by a tiler to merge rectangles.
+ *
+ * @param[in] t The tiler.
+ * @return The strategy of @p t, #EINA_TILER_STRATEGY_FUZZY by default.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Tiler_Strategy eina_tiler_strategy_get(const Eina_Tiler *t);
+
+/**
+ * @brief Gets the damage statistics of a tiler.
+ *
+ * @param[in] t The tiler.
+ * @param[out] stats Where to store the statistics.
+ *
+ * Comparing the area added to the area given out by the iterators tells how
+ * much overdraw the strategy in use costs, while the number of rectangles
+ * tells how much the merging saved.
+ *
+ * @see eina_tiler_stats_reset()
+ * @since 1.24
+ */
+EAPI void               eina_tiler_stats_get(const Eina_Tiler *t, Eina_Tiler_Stats *stats);
+
+/**
+ * @brief Resets the damage statistics of a tiler.
+ *
+ * @param[in,out] t The tiler.
+ *
+ * @since 1.24
+ */
+EAPI void               eina_tiler_stats_reset(Eina_Tiler *t);
+
 /**
  * @brief Tells if a tiler is empty or not.
  *
@@ -320,13 +320,17 @@ _efl_io_model_info_build(const Efl_Io_Model *model, Efl_Io_Model_Data *pd)
 }
 
 static void
-_eio_build_st_done(void *data, Eio_File *handler EINA_UNUSED, const Eina_Stat *stat)
+_eio_build_st_done(void *data, Eio_File *handler, const Eina_Stat *stat)
 {
    Efl_Io_Model *model = data;
    Efl_Io_Model_Data *pd = efl_data_scope_get(model, EFL_IO_MODEL_CLASS);
 
    if (!pd) return ;
-   pd->request.stat = NULL;
+   if (handler) pd->request.stat = NULL;
+   else pd->stat_queued = EINA_FALSE;
+
+   // A batch and a direct request may race, first one wins
+   if (pd->st) goto end;
 
    pd->st = malloc(sizeof (Eina_Stat));
    if (!pd->st) return ;
@@ -348,6 +352,7 @@ _eio_build_st_done(void *data, Eio_File *handler EINA_UNUSED, const Eina_Stat *s
         efl_model_children_count_get(model);
      }
 
+ end:
    efl_unref(model);
 }
 
@@ -365,12 +370,13 @@ _eio_build_st_done_clobber(void *data, Eio_File *handler, const Eina_Stat *stat)
 }
 
 static void
-_eio_build_st_error(void *data, Eio_File *handler EINA_UNUSED, int error)
+_eio_build_st_error(void *data, Eio_File *handler, int error)
 {
    Efl_Io_Model *model = data;
    Efl_Io_Model_Data *pd = efl_data_scope_get(model, EFL_IO_MODEL_CLASS);
 
-   pd->request.stat = NULL;
+   if (handler) pd->request.stat = NULL;
+   else pd->stat_queued = EINA_FALSE;
    pd->error = error;
 
    efl_model_properties_changed(model, "direct_info", "mtime", "atime", "ctime", "is_dir", "is_lnk", "size", "stat");
@@ -388,17 +394,226 @@ _eio_build_st_error_clobber(void *data, Eio_File *handler, int error)
    efl_unref(model); // From the async thread early ref
 }
 
+/*
+ * Stat requests are not sent one by one to eio. They are accumulated in a
+ * batch that is flushed from a job, or as soon as it is full, and run on a
+ * single thread. Consecutive entries of the same directory are resolved with
+ * fstatat() relative to that directory, and all the results of a batch are
+ * delivered at once back in the main loop. Listing a large directory this
+ * way costs a few thread jobs instead of one per child.
+ */
+#define EFL_IO_MODEL_STAT_BATCH 256
+
+typedef struct _Efl_Io_Model_Stat_Request Efl_Io_Model_Stat_Request;
+typedef struct _Efl_Io_Model_Stat_Batch Efl_Io_Model_Stat_Batch;
+
+struct _Efl_Io_Model_Stat_Request
+{
+   Efl_Io_Model *model;
+   Eina_Stringshare *path;
+   Eina_Stat st;
+   int error;
+};
+
+struct _Efl_Io_Model_Stat_Batch
+{
+   Ecore_Thread *thread;
+   unsigned int count;
+   Efl_Io_Model_Stat_Request requests[EFL_IO_MODEL_STAT_BATCH];
+};
+
+static Efl_Io_Model_Stat_Batch *stat_batch = NULL;
+static Eina_List *stat_batch_running = NULL;
+static Ecore_Job *stat_batch_job = NULL;
+
+static void
+_eio_stat_batch_heavy(void *data, Ecore_Thread *thread)
+{
+   Efl_Io_Model_Stat_Batch *batch = data;
+   const char *dir = NULL;
+   size_t dir_length = 0;
+   unsigned int i;
+   int fd = -1;
+
+   for (i = 0; i < batch->count; i++)
+     {
+        Efl_Io_Model_Stat_Request *r = &batch->requests[i];
+#ifdef HAVE_ATFILE_SOURCE
+        const char *name;
+#endif
+        _eio_stat_t buf;
+        int ret = -1;
+
+        if (ecore_thread_check(thread)) break;
+
+#ifdef HAVE_ATFILE_SOURCE
+        name = strrchr(r->path, '/');
+        if (name && name != r->path)
+          {
+             size_t length = name - r->path;
+
+             if (!dir || dir_length != length ||
+                 strncmp(dir, r->path, length))
+               {
+                  char tmp[PATH_MAX];
+
+                  if (fd >= 0) close(fd);
+                  fd = -1;
+                  dir = r->path;
+                  dir_length = length;
+
+                  if (length < sizeof (tmp))
+                    {
+                       memcpy(tmp, r->path, length);
+                       tmp[length] = '\0';
+                       fd = open(tmp, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                    }
+               }
+             if (fd >= 0)
+               ret = fstatat(fd, name + 1, &buf, 0);
+          }
+#else
+        (void) dir;
+        (void) dir_length;
+#endif
+
+        // fstatat() can fail on a directory we can traverse but not open
+        if (ret && _eio_stat(r->path, &buf))
+          {
+             r->error = errno ? errno : EIO;
+             continue ;
+          }
+
+        eio_file_struct_2_eina(&r->st, &buf);
+     }
+
+   if (fd >= 0) close(fd);
+}
+
+static void
+_eio_stat_batch_free(Efl_Io_Model_Stat_Batch *batch, Eina_Bool deliver)
+{
+   unsigned int i;
+
+   for (i = 0; i < batch->count; i++)
+     {
+        Efl_Io_Model_Stat_Request *r = &batch->requests[i];
+        Efl_Io_Model_Data *pd;
+
+        pd = efl_data_scope_safe_get(r->model, MY_CLASS);
+        eina_stringshare_del(r->path);
+
+        if (!pd || !deliver ||
+            efl_invalidated_get(r->model) ||
+            efl_invalidating_get(r->model))
+          {
+             if (pd) pd->stat_queued = EINA_FALSE;
+             efl_unref(r->model);
+             continue ;
+          }
+
+        // Both callbacks consume the reference taken by _eio_build_st
+        if (r->error)
+          _eio_build_st_error(r->model, NULL, r->error);
+        else
+          _eio_build_st_done(r->model, NULL, &r->st);
+     }
+
+   free(batch);
+}
+
+static void
+_eio_stat_batch_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Efl_Io_Model_Stat_Batch *batch = data;
+
+   stat_batch_running = eina_list_remove(stat_batch_running, batch);
+   _eio_stat_batch_free(batch, EINA_TRUE);
+}
+
+static void
+_eio_stat_batch_cancel(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Efl_Io_Model_Stat_Batch *batch = data;
+
+   stat_batch_running = eina_list_remove(stat_batch_running, batch);
+   _eio_stat_batch_free(batch, EINA_FALSE);
+}
+
+static void
+_eio_stat_batch_flush(void)
+{
+   Efl_Io_Model_Stat_Batch *batch = stat_batch;
+   Ecore_Thread *thread;
+
+   if (!batch) return ;
+   stat_batch = NULL;
+
+   // ecore_thread_run call the cancel callback itself on failure, which
+   // frees the batch, so only touch it once the thread exists
+   thread = ecore_thread_run(_eio_stat_batch_heavy,
+                             _eio_stat_batch_end,
+                             _eio_stat_batch_cancel,
+                             batch);
+   if (!thread) return ;
+
+   batch->thread = thread;
+   stat_batch_running = eina_list_append(stat_batch_running, batch);
+}
+
+static void
+_eio_stat_batch_job(void *data EINA_UNUSED)
+{
+   stat_batch_job = NULL;
+   _eio_stat_batch_flush();
+}
+
+void
+eio_model_shutdown(void)
+{
+   Efl_Io_Model_Stat_Batch *batch;
+   Eina_List *l, *ll;
+
+   if (stat_batch_job) ecore_job_del(stat_batch_job);
+   stat_batch_job = NULL;
+
+   if (stat_batch) _eio_stat_batch_free(stat_batch, EINA_FALSE);
+   stat_batch = NULL;
+
+   EINA_LIST_FOREACH_SAFE(stat_batch_running, l, ll, batch)
+     {
+        if (!batch->thread) continue ;
+        ecore_thread_cancel(batch->thread);
+        if (!ecore_thread_wait(batch->thread, 0.5))
+          CRI("Pending stat batch didn't terminate in time. This can led to some crash.");
+     }
+}
+
 static void
 _eio_build_st(const Efl_Io_Model *model, Efl_Io_Model_Data *pd)
 {
+   Efl_Io_Model_Stat_Request *r;
+
    if (pd->st) return ;
    if (pd->request.stat) return ;
+   if (pd->stat_queued) return ;
    if (pd->error) return ;
 
-   pd->request.stat = eio_file_direct_stat(pd->path,
-                                           _eio_build_st_done,
-                                           _eio_build_st_error,
-                                           efl_ref(model));
+   if (!stat_batch)
+     {
+        stat_batch = calloc(1, sizeof (Efl_Io_Model_Stat_Batch));
+        if (!stat_batch) return ;
+     }
+
+   r = &stat_batch->requests[stat_batch->count++];
+   r->model = efl_ref(model);
+   r->path = eina_stringshare_ref(pd->path);
+   pd->stat_queued = EINA_TRUE;
+
+   if (stat_batch->count == EFL_IO_MODEL_STAT_BATCH)
+     _eio_stat_batch_flush();
+   else if (!stat_batch_job)
+     stat_batch_job = ecore_job_add(_eio_stat_batch_job, NULL);
 }
 
 static void
@@ -1024,6 +1239,9 @@ _efl_io_model_efl_model_children_slice_get(Eo *obj, Efl_Io_Model_Data *pd,
           efl_ref(info->object);
         eina_value_array_append(&array, info->object);
 
+        // Queue the stat of the whole requested range, it is resolved as one batch
+        _eio_build_st(info->object, efl_data_scope_get(info->object, EFL_IO_MODEL_CLASS));
+
         efl_wref_add(info->object, &info->object);
         efl_unref(info->object);
 
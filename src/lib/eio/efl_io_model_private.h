@@ -67,6 +67,7 @@ struct _Efl_Io_Model_Data
    Eina_Error error;
 
    Eina_Bool listed : 1;
+   Eina_Bool stat_queued : 1; // Waiting in a stat batch
 };
 
 #endif
@@ -358,6 +358,8 @@ eio_shutdown(void)
                    EINA_LOG_STATE_START,
                    EINA_LOG_STATE_SHUTDOWN);
 
+   eio_model_shutdown();
+
    efl_provider_unregister(efl_main_loop_get(), EFL_IO_MANAGER_CLASS, io_manager);
    efl_del(io_manager);
    io_manager = NULL;
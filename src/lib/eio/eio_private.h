@@ -459,6 +459,7 @@ void eio_file_container_set(Eio_File *common, void *container);
 
 void eio_file_error(Eio_File *common);
 void eio_file_thread_error(Eio_File *common, Ecore_Thread *thread);
+void eio_file_struct_2_eina(Eina_Stat *es, _eio_stat_t *st);
 
 Eio_File_Direct_Info *eio_direct_info_malloc(void);
 void eio_direct_info_free(Eio_File_Direct_Info *data);
@@ -483,6 +484,7 @@ void eio_monitor_backend_init(void);
 void eio_monitor_fallback_init(void);
 
 void eio_monitor_shutdown(void);
+void eio_model_shutdown(void);
 void eio_monitor_backend_shutdown(void);
 void eio_monitor_fallback_shutdown(void);
 void eio_monitor_backend_add(Eio_Monitor *monitor);
@@ -106,8 +106,8 @@ _eio_file_unlink_error(void *data, Ecore_Thread *thread EINA_UNUSED)
    _eio_unlink_free(l);
 }
 
-static void
-_eio_file_struct_2_eina(Eina_Stat *es, _eio_stat_t *st)
+void
+eio_file_struct_2_eina(Eina_Stat *es, _eio_stat_t *st)
 {
    es->dev = st->st_dev;
    es->ino = st->st_ino;
@@ -153,7 +153,7 @@ _eio_file_stat(void *data, Ecore_Thread *thread)
    if (_eio_stat(s->path, &buf) != 0)
      eio_file_thread_error(&s->common, thread);
 
-   _eio_file_struct_2_eina(&s->buffer, &buf);
+   eio_file_struct_2_eina(&s->buffer, &buf);
 }
 
 static void
@@ -165,7 +165,7 @@ _eio_file_lstat(void *data, Ecore_Thread *thread)
    if (_eio_lstat(s->path, &buf) != 0)
      eio_file_thread_error(&s->common, thread);
 
-   _eio_file_struct_2_eina(&s->buffer, &buf);
+   eio_file_struct_2_eina(&s->buffer, &buf);
 }
 
 static void
@@ -3,7 +3,13 @@
 #include <dbus/dbus.h>
 #include <stdint.h>
 
-/* TODO: mempool of Eldbus_Message and Eldbus_Message_Iter */
+static Eina_Mempool *_message_mp = NULL;
+static Eina_Mempool *_message_iter_mp = NULL;
+/* messages and iterators taken from the pools, while there are some left
+ * the pools outlive eldbus_shutdown() so that they can still be given
+ * back, the next init picks them up again */
+static unsigned int _message_pool_usage = 0;
+static Eina_Bool _message_pool_orphan = EINA_FALSE;
 
 #define ELDBUS_MESSAGE_CHECK(msg)                        \
   do                                                    \
@@ -57,15 +63,75 @@
 
 static Eina_Bool append_basic(char type, va_list *vl, DBusMessageIter *iter);
 
+static void
+_message_pools_del(void)
+{
+   eina_mempool_del(_message_iter_mp);
+   _message_iter_mp = NULL;
+   eina_mempool_del(_message_mp);
+   _message_mp = NULL;
+   _message_pool_orphan = EINA_FALSE;
+}
+
+static void
+_message_pool_release(Eina_Mempool *mp, void *ptr)
+{
+   // what was taken from a pool keeps it around, so it can't be gone here
+   EINA_SAFETY_ON_NULL_RETURN(mp);
+
+   eina_mempool_free(mp, ptr);
+   _message_pool_usage--;
+   if ((!_message_pool_usage) && (_message_pool_orphan))
+     _message_pools_del();
+}
+
 Eina_Bool
 eldbus_message_init(void)
 {
+   const char *choice = getenv("EINA_MEMPOOL");
+
+   // messages from before the last shutdown are still out, keep their pools
+   if (_message_mp)
+     {
+        _message_pool_orphan = EINA_FALSE;
+        return EINA_TRUE;
+     }
+
+   if ((!choice) || (!choice[0])) choice = "chained_mempool";
+
+   /* messages carrying arrays and dicts create one iterator per
+    * container entry, recycle them instead of going through malloc */
+   _message_mp = eina_mempool_add(choice, "Eldbus_Message", NULL,
+                                  sizeof(Eldbus_Message), 16);
+   if (!_message_mp)
+     _message_mp = eina_mempool_add("pass_through", "Eldbus_Message", NULL,
+                                    sizeof(Eldbus_Message), 16);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(_message_mp, EINA_FALSE);
+
+   _message_iter_mp = eina_mempool_add(choice, "Eldbus_Message_Iter", NULL,
+                                       sizeof(Eldbus_Message_Iter), 64);
+   if (!_message_iter_mp)
+     _message_iter_mp = eina_mempool_add("pass_through", "Eldbus_Message_Iter",
+                                         NULL, sizeof(Eldbus_Message_Iter), 64);
+   EINA_SAFETY_ON_NULL_GOTO(_message_iter_mp, error);
+
    return EINA_TRUE;
+
+error:
+   eina_mempool_del(_message_mp);
+   _message_mp = NULL;
+   return EINA_FALSE;
 }
 
 void
 eldbus_message_shutdown(void)
 {
+   if (_message_pool_usage > 0)
+     {
+        _message_pool_orphan = EINA_TRUE;
+        return;
+     }
+   _message_pools_del();
 }
 
 static Eldbus_Message_Iter *
@@ -73,8 +139,10 @@ _message_iterator_new(Eina_Bool writable)
 {
    Eldbus_Message_Iter *iter;
 
-   iter = calloc(1, sizeof(Eldbus_Message_Iter));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(_message_iter_mp, NULL);
+   iter = eina_mempool_calloc(_message_iter_mp, sizeof(Eldbus_Message_Iter));
    EINA_SAFETY_ON_NULL_RETURN_VAL(iter, NULL);
+   _message_pool_usage++;
    EINA_MAGIC_SET(iter, ELDBUS_MESSAGE_ITERATOR_MAGIC);
    iter->writable = writable;
 
@@ -83,8 +151,12 @@ _message_iterator_new(Eina_Bool writable)
 
 Eldbus_Message *eldbus_message_new(Eina_Bool writable)
 {
-   Eldbus_Message *msg = calloc(1, sizeof(Eldbus_Message));
+   Eldbus_Message *msg;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(_message_mp, NULL);
+   msg = eina_mempool_calloc(_message_mp, sizeof(Eldbus_Message));
    EINA_SAFETY_ON_NULL_RETURN_VAL(msg, NULL);
+   _message_pool_usage++;
    EINA_MAGIC_SET(msg, ELDBUS_MESSAGE_MAGIC);
    msg->refcount = 1;
 
@@ -165,7 +237,8 @@ _message_iterator_free(Eldbus_Message_Iter *iter)
         _message_iterator_free(sub);
         lst = next;
      }
-   free(iter);
+   EINA_MAGIC_SET(iter, EINA_MAGIC_NONE);
+   _message_pool_release(_message_iter_mp, iter);
 }
 
 EAPI void
@@ -184,7 +257,7 @@ eldbus_message_unref(Eldbus_Message *msg)
    msg->dbus_msg = NULL;
 
    _message_iterator_free(msg->iterator);
-   free(msg);
+   _message_pool_release(_message_mp, msg);
 }
 
 EAPI const char *
@@ -540,7 +613,7 @@ eldbus_message_iter_container_new(Eldbus_Message_Iter *iter, int type, const cha
    return sub;
 
 cleanup:
-   free(sub);
+   _message_iterator_free(sub);
    return NULL;
 }
 
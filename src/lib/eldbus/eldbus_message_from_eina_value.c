@@ -3,6 +3,8 @@
 
 #include <dbus/dbus-protocol.h>
 
+static Eina_Bool _message_iter_from_eina_value_types(const char **types, Eldbus_Message_Iter *iter, const Eina_Value *value);
+
 static Eina_Bool
 _compatible_type(int dbus_type, const Eina_Value_Type *value_type)
 {
@@ -43,6 +45,89 @@ _compatible_type(int dbus_type, const Eina_Value_Type *value_type)
      }
 }
 
+/*
+ * Splits a signature in its complete types, so the members of an array
+ * of structs are parsed once and not for every entry. The result is a
+ * single allocation: the NULL terminated array of types followed by the
+ * strings. Release it with free().
+ */
+static char **
+_signature_split(const char *signature)
+{
+   DBusSignatureIter signature_iter;
+   unsigned int count = 0, i;
+   char **types, *p;
+
+   dbus_signature_iter_init(&signature_iter, signature);
+   if (dbus_signature_iter_get_current_type(&signature_iter) != DBUS_TYPE_INVALID)
+     {
+        do count++;
+        while (dbus_signature_iter_next(&signature_iter));
+     }
+
+   types = malloc(sizeof(char *) * (count + 1) +
+                  strlen(signature) + count);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(types, NULL);
+
+   p = (char *)(types + count + 1);
+   dbus_signature_iter_init(&signature_iter, signature);
+   for (i = 0; i < count; i++)
+     {
+        char *type = dbus_signature_iter_get_signature(&signature_iter);
+        size_t len;
+
+        if (!type)
+          {
+             free(types);
+             return NULL;
+          }
+        len = strlen(type) + 1;
+        memcpy(p, type, len);
+        dbus_free(type);
+        types[i] = p;
+        p += len;
+        dbus_signature_iter_next(&signature_iter);
+     }
+   types[count] = NULL;
+
+   return types;
+}
+
+/*
+ * Byte and numeric arrays are stored packed in the Eina_Inarray of the
+ * value, just like D-Bus wants them, so they are appended in one go.
+ * Booleans are 32 bits on the wire and file descriptors must be
+ * duplicated one by one, those go through the generic path.
+ */
+static Eina_Bool
+_array_fixed_append(char type, const Eina_Value *value_array, Eldbus_Message_Iter *array)
+{
+   Eina_Value_Array desc;
+
+   switch (type)
+     {
+      case 'y':
+      case 'n':
+      case 'q':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 't':
+      case 'd':
+         break;
+      default:
+         return EINA_FALSE;
+     }
+
+   if (!eina_value_pget(value_array, &desc)) return EINA_FALSE;
+   if (!_compatible_type(type, desc.subtype)) return EINA_FALSE;
+   if ((!desc.array) || (desc.array->len == 0)) return EINA_TRUE;
+
+   return eldbus_message_iter_fixed_array_append(array, type,
+                                                 desc.array->members,
+                                                 desc.array->len);
+}
+
 static Eina_Bool
 _array_append(const char *type, const Eina_Value *value_array, Eldbus_Message_Iter *iter)
 {
@@ -50,27 +135,38 @@ _array_append(const char *type, const Eina_Value *value_array, Eldbus_Message_It
    Eina_Bool ok = eldbus_message_iter_arguments_append(iter, type, &array);
    EINA_SAFETY_ON_FALSE_RETURN_VAL(ok, EINA_FALSE);
    DBG("array of type %c", type[1]);
+   if (_array_fixed_append(type[1], value_array, array))
+     goto end;
    switch (type[1])
      {
       case '{':
       case '(':
         {
            unsigned i = strlen(type+2);//remove 'a()' of len a(sv)
+           int container = (type[1] == '{') ? DBUS_TYPE_DICT_ENTRY : DBUS_TYPE_STRUCT;
            char *entry_sig = malloc(sizeof(char) * i);
+           char **entry_types;
            memcpy(entry_sig, type+2, i);
            entry_sig[i-1] = 0;
+           entry_types = _signature_split(entry_sig);
+           free(entry_sig);
+           EINA_SAFETY_ON_NULL_RETURN_VAL(entry_types, EINA_FALSE);
 
            for (i = 0; i < eina_value_array_count(value_array); i++)
              {
                 Eina_Value st;
                 Eldbus_Message_Iter *entry;
                 eina_value_array_value_get(value_array, i, &st);
-                eldbus_message_iter_arguments_append(array, type+1, &entry);
-                _message_iter_from_eina_value_struct(entry_sig, entry, &st);
-                eldbus_message_iter_container_close(array, entry);
+                entry = eldbus_message_iter_container_new(array, container, NULL);
+                if (entry)
+                  {
+                     _message_iter_from_eina_value_types((const char **)entry_types,
+                                                         entry, &st);
+                     eldbus_message_iter_container_close(array, entry);
+                  }
                 eina_value_flush(&st);
              }
-           free(entry_sig);
+           free(entry_types);
            break;
         }
       case 'a':
@@ -212,6 +308,7 @@ _array_append(const char *type, const Eina_Value *value_array, Eldbus_Message_It
            return EINA_FALSE;
         }
      }
+end:
    eldbus_message_iter_container_close(iter, array);
    return EINA_TRUE;
 }
@@ -303,13 +400,12 @@ _basic_append_value_struct(char type, const Eina_Value *value, const Eina_Value_
    return EINA_TRUE;
 }
 
-Eina_Bool
-_message_iter_from_eina_value_struct(const char *signature, Eldbus_Message_Iter *iter, const Eina_Value *value)
+static Eina_Bool
+_message_iter_from_eina_value_types(const char **types, Eldbus_Message_Iter *iter, const Eina_Value *value)
 {
    unsigned i;
-   DBusSignatureIter signature_iter;
    Eina_Bool r = EINA_TRUE;
-   char *type;
+   const char *type;
    Eina_Value_Struct st;
 
    EINA_SAFETY_ON_FALSE_RETURN_VAL(
@@ -317,9 +413,7 @@ _message_iter_from_eina_value_struct(const char *signature, Eldbus_Message_Iter
    EINA_SAFETY_ON_FALSE_RETURN_VAL(
       eina_value_pget(value, &st), EINA_FALSE);
 
-   dbus_signature_iter_init(&signature_iter, signature);
-   i = 0;
-   while ((type = dbus_signature_iter_get_signature(&signature_iter)))
+   for (i = 0; (type = types[i]); i++)
      {
         DBG("type: %s", type);
         if (type[0] != 'v' && !type[1])
@@ -364,13 +458,24 @@ _message_iter_from_eina_value_struct(const char *signature, Eldbus_Message_Iter
              ERR("Unknown type %c", type[0]);
              r = EINA_FALSE;
           }
-        i++;
-        dbus_free(type);
-        if (!r || !dbus_signature_iter_next(&signature_iter)) break;
+        if (!r) break;
      }
    return r;
 }
 
+Eina_Bool
+_message_iter_from_eina_value_struct(const char *signature, Eldbus_Message_Iter *iter, const Eina_Value *value)
+{
+   char **types;
+   Eina_Bool r;
+
+   types = _signature_split(signature);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(types, EINA_FALSE);
+   r = _message_iter_from_eina_value_types((const char **)types, iter, value);
+   free(types);
+   return r;
+}
+
 EAPI Eina_Bool
 eldbus_message_from_eina_value(const char *signature, Eldbus_Message *msg, const Eina_Value *value)
 {
@@ -142,9 +142,49 @@ _message_iter_array_to_eina_value(Eldbus_Message_Iter *iter)
    return array_value;
 }
 
+/*
+ * Fixed size elements are read straight from the message buffer and
+ * copied at once into the Eina_Inarray, which has the same layout.
+ */
+static Eina_Bool
+_message_iter_fixed_array_to_eina_value(char type, Eina_Value *value, Eldbus_Message_Iter *iter)
+{
+   Eina_Value_Array desc;
+   const void *mem = NULL;
+   int n = 0;
+
+   switch (type)
+     {
+      case 'y':
+      case 'n':
+      case 'q':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 't':
+      case 'd':
+         break;
+      default:
+         return EINA_FALSE;
+     }
+
+   if ((!eina_value_pget(value, &desc)) || (!desc.array)) return EINA_FALSE;
+   if (desc.array->member_size != _type_size(type)) return EINA_FALSE;
+   if (!eldbus_message_iter_fixed_array_get(iter, type, &mem, &n))
+     return EINA_FALSE;
+   if (n <= 0) return EINA_TRUE;
+
+   if (!eina_inarray_resize(desc.array, n)) return EINA_FALSE;
+   memcpy(desc.array->members, mem, (size_t)n * desc.array->member_size);
+   return EINA_TRUE;
+}
+
 static void
 _message_iter_basic_array_to_eina_value(char type, Eina_Value *value, Eldbus_Message_Iter *iter)
 {
+   if (_message_iter_fixed_array_to_eina_value(type, value, iter))
+     return;
+
    switch (type)
     {
        case 'i':
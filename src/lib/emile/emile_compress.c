@@ -12,9 +12,206 @@
 #include "lz4hc.h"
 #endif
 
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
 #include <Eina.h>
 
 #include "Emile.h"
+#include "emile_private.h"
+
+#ifdef HAVE_ZSTD
+/* A decompression context is a large allocation, way more than most of
+ * the buffers eet hands us, so keep one around instead of letting zstd
+ * allocate it on every call. */
+typedef struct _Emile_Zstd_Cache Emile_Zstd_Cache;
+struct _Emile_Zstd_Cache
+{
+   Eina_Spinlock lock;
+   ZSTD_DCtx *dctx;
+};
+
+static Emile_Zstd_Cache _emile_zstd_cache;
+#endif
+
+struct _Emile_Compress_Dict
+{
+   Emile_Compressor_Type type;
+   Eina_Binbuf *data;
+   Eina_Lock lock;
+#ifdef HAVE_ZSTD
+   Emile_Zstd_Cache cache;
+   ZSTD_CDict *cdict;
+   ZSTD_DDict *ddict;
+   int level;
+#endif
+};
+
+#ifdef HAVE_ZSTD
+static int
+_emile_zstd_level(Emile_Compressor_Level l)
+{
+   int level = l;
+
+   /* stretch the zlib like 1-9 scale, BEST ends up at 17 */
+   if (level <= 0) return 3;
+   level = (level * 2) - 1;
+   if (level > ZSTD_maxCLevel()) level = ZSTD_maxCLevel();
+   return level;
+}
+
+static ZSTD_DCtx *
+_emile_zstd_dctx_take(Emile_Zstd_Cache *cache)
+{
+   ZSTD_DCtx *dctx;
+
+   eina_spinlock_take(&cache->lock);
+   dctx = cache->dctx;
+   cache->dctx = NULL;
+   eina_spinlock_release(&cache->lock);
+
+   if (!dctx) dctx = ZSTD_createDCtx();
+   return dctx;
+}
+
+static void
+_emile_zstd_dctx_give(Emile_Zstd_Cache *cache, ZSTD_DCtx *dctx)
+{
+   eina_spinlock_take(&cache->lock);
+   if (!cache->dctx)
+     {
+        cache->dctx = dctx;
+        dctx = NULL;
+     }
+   eina_spinlock_release(&cache->lock);
+
+   if (dctx) ZSTD_freeDCtx(dctx);
+}
+
+static size_t
+_emile_zstd_compress(const Eina_Binbuf *data, void *compact, size_t length,
+                     Emile_Compressor_Level l, const Emile_Compress_Dict *d)
+{
+   Emile_Compress_Dict *dict = (Emile_Compress_Dict *)d;
+   ZSTD_CDict *cdict = NULL;
+   ZSTD_CCtx *cctx;
+   int level;
+   size_t r;
+
+   level = _emile_zstd_level(l);
+   if (!dict)
+     {
+        r = ZSTD_compress(compact, length,
+                          eina_binbuf_string_get(data),
+                          eina_binbuf_length_get(data), level);
+        return ZSTD_isError(r) ? 0 : r;
+     }
+
+   /* Digesting the dictionary costs more than compressing a small
+    * buffer, do it once for the first level asked. */
+   eina_lock_take(&dict->lock);
+   if (!dict->cdict)
+     {
+        dict->cdict = ZSTD_createCDict(eina_binbuf_string_get(dict->data),
+                                       eina_binbuf_length_get(dict->data),
+                                       level);
+        dict->level = level;
+     }
+   if (dict->level == level) cdict = dict->cdict;
+   eina_lock_release(&dict->lock);
+
+   cctx = ZSTD_createCCtx();
+   if (!cctx) return 0;
+
+   if (cdict)
+     r = ZSTD_compress_usingCDict(cctx, compact, length,
+                                  eina_binbuf_string_get(data),
+                                  eina_binbuf_length_get(data),
+                                  cdict);
+   else
+     r = ZSTD_compress_usingDict(cctx, compact, length,
+                                 eina_binbuf_string_get(data),
+                                 eina_binbuf_length_get(data),
+                                 eina_binbuf_string_get(dict->data),
+                                 eina_binbuf_length_get(dict->data),
+                                 level);
+   ZSTD_freeCCtx(cctx);
+
+   return ZSTD_isError(r) ? 0 : r;
+}
+
+static Eina_Bool
+_emile_zstd_expand(const Eina_Binbuf *in, Eina_Binbuf *out,
+                   const Emile_Compress_Dict *d)
+{
+   Emile_Compress_Dict *dict = (Emile_Compress_Dict *)d;
+   Emile_Zstd_Cache *cache = &_emile_zstd_cache;
+   ZSTD_DDict *ddict = NULL;
+   ZSTD_DCtx *dctx;
+   size_t r;
+
+   /* buffers compressed before the dictionary existed don't use it */
+   if (dict && !ZSTD_getDictID_fromFrame(eina_binbuf_string_get(in),
+                                         eina_binbuf_length_get(in)))
+     dict = NULL;
+
+   if (dict)
+     {
+        eina_lock_take(&dict->lock);
+        if (!dict->ddict)
+          dict->ddict = ZSTD_createDDict(eina_binbuf_string_get(dict->data),
+                                         eina_binbuf_length_get(dict->data));
+        ddict = dict->ddict;
+        eina_lock_release(&dict->lock);
+        if (!ddict) return EINA_FALSE;
+        cache = &dict->cache;
+     }
+
+   dctx = _emile_zstd_dctx_take(cache);
+   if (!dctx) return EINA_FALSE;
+
+   if (ddict)
+     r = ZSTD_decompress_usingDDict(dctx,
+                                    (void *)eina_binbuf_string_get(out),
+                                    eina_binbuf_length_get(out),
+                                    eina_binbuf_string_get(in),
+                                    eina_binbuf_length_get(in),
+                                    ddict);
+   else
+     r = ZSTD_decompressDCtx(dctx,
+                             (void *)eina_binbuf_string_get(out),
+                             eina_binbuf_length_get(out),
+                             eina_binbuf_string_get(in),
+                             eina_binbuf_length_get(in));
+
+   _emile_zstd_dctx_give(cache, dctx);
+
+   if (ZSTD_isError(r)) return EINA_FALSE;
+   return r == eina_binbuf_length_get(out);
+}
+#endif
+
+Eina_Bool
+_emile_compress_init(void)
+{
+#ifdef HAVE_ZSTD
+   if (!eina_spinlock_new(&_emile_zstd_cache.lock))
+     return EINA_FALSE;
+#endif
+   return EINA_TRUE;
+}
+
+void
+_emile_compress_shutdown(void)
+{
+#ifdef HAVE_ZSTD
+   ZSTD_freeDCtx(_emile_zstd_cache.dctx);
+   _emile_zstd_cache.dctx = NULL;
+   eina_spinlock_free(&_emile_zstd_cache.lock);
+#endif
+}
 
 static int
 _emile_compress_buffer_size(const Eina_Binbuf *data, Emile_Compressor_Type t)
@@ -28,6 +225,11 @@ _emile_compress_buffer_size(const Eina_Binbuf *data, Emile_Compressor_Type t)
       case EMILE_LZ4HC:
         return LZ4_compressBound(eina_binbuf_length_get(data));
 
+#ifdef HAVE_ZSTD
+      case EMILE_ZSTD:
+        return ZSTD_compressBound(eina_binbuf_length_get(data));
+#endif
+
       default:
         return -1;
      }
@@ -37,13 +239,27 @@ EAPI Eina_Binbuf *
 emile_compress(const Eina_Binbuf *data,
                Emile_Compressor_Type t,
                Emile_Compressor_Level l)
+{
+   return emile_compress_dict(data, t, l, NULL);
+}
+
+EAPI Eina_Binbuf *
+emile_compress_dict(const Eina_Binbuf *data,
+                    Emile_Compressor_Type t,
+                    Emile_Compressor_Level l,
+                    const Emile_Compress_Dict *dict)
 {
    void *compact, *temp;
    int length;
    int level = l;
    Eina_Bool ok = EINA_FALSE;
 
+   if (dict && (dict->type != t))
+     return NULL;
+
    length = _emile_compress_buffer_size(data, t);
+   if (length < 0)
+     return NULL;
 
    compact = malloc(length);
    if (!compact)
@@ -74,6 +290,18 @@ emile_compress(const Eina_Binbuf *data,
           ok = EINA_TRUE;
         break;
 
+#ifdef HAVE_ZSTD
+      case EMILE_ZSTD:
+        length = _emile_zstd_compress(data, compact, length, l, dict);
+        if (length > 0)
+          {
+             temp = realloc(compact, length);
+             if (temp) compact = temp;
+             ok = EINA_TRUE;
+          }
+        break;
+#endif
+
       case EMILE_ZLIB:
       {
          uLongf buflen = (uLongf)length;
@@ -81,7 +309,11 @@ emile_compress(const Eina_Binbuf *data,
          if (compress2((Bytef *)compact, &buflen, (Bytef *)eina_binbuf_string_get(data), (uLong)eina_binbuf_length_get(data), level) == Z_OK)
            ok = EINA_TRUE;
          length = (int)buflen;
+         break;
       }
+
+      default:
+        break;
      }
 
    if (!ok)
@@ -95,9 +327,18 @@ emile_compress(const Eina_Binbuf *data,
 
 EAPI Eina_Bool
 emile_expand(const Eina_Binbuf *in, Eina_Binbuf *out, Emile_Compressor_Type t)
+{
+   return emile_expand_dict(in, out, t, NULL);
+}
+
+EAPI Eina_Bool
+emile_expand_dict(const Eina_Binbuf *in, Eina_Binbuf *out,
+                  Emile_Compressor_Type t, const Emile_Compress_Dict *dict)
 {
    if (!in || !out)
      return EINA_FALSE;
+   if (dict && (dict->type != t))
+     return EINA_FALSE;
 
    switch (t)
      {
@@ -124,6 +365,11 @@ emile_expand(const Eina_Binbuf *in, Eina_Binbuf *out, Emile_Compressor_Type t)
          break;
       }
 
+#ifdef HAVE_ZSTD
+      case EMILE_ZSTD:
+        return _emile_zstd_expand(in, out, dict);
+#endif
+
       default:
         return EINA_FALSE;
      }
@@ -135,6 +381,15 @@ EAPI Eina_Binbuf *
 emile_decompress(const Eina_Binbuf *data,
                  Emile_Compressor_Type t,
                  unsigned int dest_length)
+{
+   return emile_decompress_dict(data, t, dest_length, NULL);
+}
+
+EAPI Eina_Binbuf *
+emile_decompress_dict(const Eina_Binbuf *data,
+                      Emile_Compressor_Type t,
+                      unsigned int dest_length,
+                      const Emile_Compress_Dict *dict)
 {
    Eina_Binbuf *out;
    void *expanded;
@@ -147,7 +402,7 @@ emile_decompress(const Eina_Binbuf *data,
    if (!out)
      goto on_error;
 
-   if (!emile_expand(data, out, t))
+   if (!emile_expand_dict(data, out, t, dict))
      goto on_error;
 
    return out;
@@ -159,3 +414,133 @@ on_error:
      eina_binbuf_free(out);
    return NULL;
 }
+
+EAPI Eina_Binbuf *
+emile_compress_dict_train(Emile_Compressor_Type t,
+                          const Eina_Array *samples,
+                          unsigned int max_size)
+{
+#ifdef HAVE_ZSTD
+   Eina_Binbuf *sample;
+   unsigned char *buffer, *p;
+   size_t *sizes;
+   size_t total = 0;
+   unsigned int count, i;
+   void *dict;
+   size_t r;
+
+   if (t != EMILE_ZSTD) return NULL;
+   EINA_SAFETY_ON_NULL_RETURN_VAL(samples, NULL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(max_size == 0, NULL);
+
+   count = eina_array_count(samples);
+   if (!count) return NULL;
+
+   for (i = 0; i < count; i++)
+     {
+        sample = eina_array_data_get(samples, i);
+        total += eina_binbuf_length_get(sample);
+     }
+
+   /* zdict wants all the samples back to back */
+   buffer = malloc(total);
+   sizes = malloc(count * sizeof (size_t));
+   dict = malloc(max_size);
+   if (!buffer || !sizes || !dict) goto on_error;
+
+   for (i = 0, p = buffer; i < count; i++)
+     {
+        sample = eina_array_data_get(samples, i);
+        sizes[i] = eina_binbuf_length_get(sample);
+        memcpy(p, eina_binbuf_string_get(sample), sizes[i]);
+        p += sizes[i];
+     }
+
+   r = ZDICT_trainFromBuffer(dict, max_size, buffer, sizes, count);
+   if (ZDICT_isError(r))
+     {
+        INF("Could not train a dictionary out of %u samples: %s",
+            count, ZDICT_getErrorName(r));
+        goto on_error;
+     }
+
+   free(buffer);
+   free(sizes);
+   return eina_binbuf_manage_new(dict, r, EINA_FALSE);
+
+on_error:
+   free(buffer);
+   free(sizes);
+   free(dict);
+   return NULL;
+#else
+   (void)t;
+   (void)samples;
+   (void)max_size;
+   return NULL;
+#endif
+}
+
+EAPI Emile_Compress_Dict *
+emile_compress_dict_new(Emile_Compressor_Type t, const Eina_Binbuf *data)
+{
+   Emile_Compress_Dict *dict;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(data, NULL);
+#ifdef HAVE_ZSTD
+   if (t != EMILE_ZSTD) return NULL;
+   /* Frames only record which dictionary they need if it has an id, raw
+    * content would be impossible to tell apart from no dictionary. */
+   if (!ZSTD_getDictID_fromDict(eina_binbuf_string_get(data),
+                                eina_binbuf_length_get(data)))
+     return NULL;
+#else
+   return NULL;
+#endif
+
+   dict = calloc(1, sizeof (Emile_Compress_Dict));
+   if (!dict) return NULL;
+
+   dict->type = t;
+   dict->data = eina_binbuf_new();
+   if (!dict->data) goto on_error;
+   if (!eina_binbuf_append_buffer(dict->data, data)) goto on_error;
+   if (!eina_lock_new(&dict->lock)) goto on_error;
+#ifdef HAVE_ZSTD
+   if (!eina_spinlock_new(&dict->cache.lock))
+     {
+        eina_lock_free(&dict->lock);
+        goto on_error;
+     }
+#endif
+
+   return dict;
+
+on_error:
+   if (dict->data) eina_binbuf_free(dict->data);
+   free(dict);
+   return NULL;
+}
+
+EAPI void
+emile_compress_dict_free(Emile_Compress_Dict *dict)
+{
+   if (!dict) return;
+
+#ifdef HAVE_ZSTD
+   ZSTD_freeCDict(dict->cdict);
+   ZSTD_freeDDict(dict->ddict);
+   ZSTD_freeDCtx(dict->cache.dctx);
+   eina_spinlock_free(&dict->cache.lock);
+#endif
+   eina_lock_free(&dict->lock);
+   eina_binbuf_free(dict->data);
+   free(dict);
+}
+
+EAPI const Eina_Binbuf *
+emile_compress_dict_data_get(const Emile_Compress_Dict *dict)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(dict, NULL);
+   return dict->data;
+}
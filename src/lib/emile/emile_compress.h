@@ -22,7 +22,8 @@ typedef enum
 {
   EMILE_ZLIB,
   EMILE_LZ4,
-  EMILE_LZ4HC
+  EMILE_LZ4HC,
+  EMILE_ZSTD /**< Zstandard, only available if efl was built with it @since 1.24 */
 } Emile_Compressor_Type;
 
 /**
@@ -39,6 +40,17 @@ typedef enum
   EMILE_COMPRESSOR_BEST = 9
 } Emile_Compressor_Level;
 
+/**
+ * @typedef Emile_Compress_Dict
+ * A dictionary of content shared by many small buffers, used to
+ * improve their compression ratio.
+ * @since 1.24
+ *
+ * @see emile_compress_dict_new()
+ * @see emile_compress_dict_train()
+ */
+typedef struct _Emile_Compress_Dict Emile_Compress_Dict;
+
 /**
  * @brief Compress an Eina_Binbuf into a new Eina_Binbuf
  *
@@ -84,6 +96,107 @@ EAPI Eina_Binbuf *emile_decompress(const Eina_Binbuf * in, Emile_Compressor_Type
  * could fill the out buffer.
  */
 EAPI Eina_Bool emile_expand(const Eina_Binbuf * in, Eina_Binbuf * out, Emile_Compressor_Type t);
+
+/**
+ * @brief Build a dictionary out of sample buffers.
+ *
+ * @param t Type of compression logic the dictionary is for.
+ * @param samples Array of Eina_Binbuf representative of the data that
+ * will later be compressed.
+ * @param max_size Maximum size of the resulting dictionary.
+ *
+ * @return A buffer with the dictionary content, @c NULL if the
+ * compression logic doesn't support dictionaries or if there was not
+ * enough samples to learn from.
+ *
+ * @note Only #EMILE_ZSTD support dictionaries. A few hundred samples
+ * and a @p max_size around 100 times smaller than their total size give
+ * the best results.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Binbuf *emile_compress_dict_train(Emile_Compressor_Type t, const Eina_Array *samples, unsigned int max_size);
+
+/**
+ * @brief Create a dictionary from its content.
+ *
+ * @param t Type of compression logic the dictionary is for.
+ * @param data Content of the dictionary, as given by
+ * emile_compress_dict_train(). It is copied.
+ *
+ * @return A new dictionary, @c NULL on error or if @p data is not a
+ * trained dictionary.
+ *
+ * @since 1.24
+ */
+EAPI Emile_Compress_Dict *emile_compress_dict_new(Emile_Compressor_Type t, const Eina_Binbuf *data);
+
+/**
+ * @brief Free a dictionary.
+ *
+ * @param dict The dictionary to free.
+ *
+ * @since 1.24
+ */
+EAPI void emile_compress_dict_free(Emile_Compress_Dict *dict);
+
+/**
+ * @brief Get the content of a dictionary.
+ *
+ * @param dict The dictionary.
+ * @return The content the dictionary was created with.
+ *
+ * @since 1.24
+ */
+EAPI const Eina_Binbuf *emile_compress_dict_data_get(const Emile_Compress_Dict *dict);
+
+/**
+ * @brief Compress an Eina_Binbuf using a dictionary.
+ *
+ * @param in Buffer to compress.
+ * @param t Type of compression logic to use.
+ * @param level Level of compression to apply.
+ * @param dict Dictionary to use, or @c NULL to behave like
+ * emile_compress().
+ *
+ * @return On success it will return a buffer that contains
+ * the compressed data, @c NULL otherwise.
+ *
+ * @note The same dictionary must be given to decompress the result.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Binbuf *emile_compress_dict(const Eina_Binbuf *in, Emile_Compressor_Type t, Emile_Compressor_Level level, const Emile_Compress_Dict *dict);
+
+/**
+ * @brief Uncompress a buffer compressed with a dictionary into a newly
+ * allocated buffer.
+ *
+ * @param in Buffer to uncompress.
+ * @param t Type of compression logic to use.
+ * @param dest_length Expected length of the decompressed data.
+ * @param dict Dictionary used to compress @p in, or @c NULL.
+ *
+ * @return a newly allocated buffer with the uncompressed data,
+ * @c NULL if it failed.
+ *
+ * @since 1.24
+ */
+EAPI Eina_Binbuf *emile_decompress_dict(const Eina_Binbuf *in, Emile_Compressor_Type t, unsigned int dest_length, const Emile_Compress_Dict *dict);
+
+/**
+ * @brief Uncompress a buffer compressed with a dictionary into an
+ * existing buffer.
+ *
+ * @param in Buffer to uncompress.
+ * @param out Buffer to expand data into.
+ * @param t Type of compression logic to use.
+ * @param dict Dictionary used to compress @p in, or @c NULL.
+ *
+ * @return EINA_TRUE if it succeed, EINA_FALSE if it failed.
+ * @since 1.24
+ */
+EAPI Eina_Bool emile_expand_dict(const Eina_Binbuf *in, Eina_Binbuf *out, Emile_Compressor_Type t, const Emile_Compress_Dict *dict);
 /**
  * @}
  */
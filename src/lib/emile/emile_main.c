@@ -67,10 +67,19 @@ emile_init(void)
         goto shutdown_eina;
      }
 
+   if (!_emile_compress_init())
+     {
+        EINA_LOG_ERR("Emile can not initialize compression.");
+        goto unregister_log_domain;
+     }
+
    eina_log_timing(_emile_log_dom_global, EINA_LOG_STATE_STOP, EINA_LOG_STATE_INIT);
 
    return _emile_init_count;
 
+unregister_log_domain:
+   eina_log_domain_unregister(_emile_log_dom_global);
+   _emile_log_dom_global = -1;
 shutdown_eina:
    eina_shutdown();
 
@@ -109,6 +118,8 @@ emile_shutdown(void)
 #endif /* if defined(HAVE_OPENSSL) && (OPENSSL_VERSION_NUMBER < 0x10100000L || defined(LIBRESSL_VERSION_NUMBER)) */
      }
 
+   _emile_compress_shutdown();
+
    eina_log_domain_unregister(_emile_log_dom_global);
    _emile_log_dom_global = -1;
 
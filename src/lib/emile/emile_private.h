@@ -34,6 +34,9 @@ typedef enum
 
 Eina_Bool _emile_cipher_init(void);
 
+Eina_Bool _emile_compress_init(void);
+void _emile_compress_shutdown(void);
+
 Eina_Bool
 emile_pbkdf2_sha1(const char *key,
                   unsigned int key_len,
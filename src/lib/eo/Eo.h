@@ -1281,9 +1281,12 @@ typedef struct _Efl_Object_Op_Call_Data
 
 // cache OP id, get real fct and object data then do the call
 #define EFL_FUNC_COMMON_OP(Obj, Name, DefRet) \
+   Efl_Object_Op_Call_Data ___call; \
+   EFL_FUNC_COMMON_OP_RESOLVE(Obj, Name, DefRet)
+
+#define EFL_FUNC_COMMON_OP_RESOLVE(Obj, Name, DefRet) \
    static Efl_Object_Op ___op = 0; \
    static unsigned int ___generation = 0; \
-   Efl_Object_Op_Call_Data ___call; \
    _Eo_##Name##_func _func_;                                            \
    if (EINA_UNLIKELY((___op == EFL_NOOP) ||                       \
                      (___generation != _efl_object_init_generation))) \
@@ -1397,6 +1400,123 @@ __##Name##_failed: EINA_COLD; \
 #define EFL_FUNC_BODYV_CONST_FALLBACK(Name, Ret, DefRet, FallbackCall, Arguments, ...) _EFL_OBJECT_FUNC_BODYV(Name, const Eo *, Ret, DefRet, FallbackCall, EFL_FUNC_CALL(Arguments), __VA_ARGS__)
 #define EFL_VOID_FUNC_BODYV_CONST_FALLBACK(Name, FallbackCall, Arguments, ...) _EFL_OBJECT_VOID_FUNC_BODYV(Name, const Eo *, FallbackCall, EFL_FUNC_CALL(Arguments), __VA_ARGS__)
 
+// Direct call fast path for functions declared in a @final class. Klass
+// can not be inherited from, so a plain instance of Klass always resolves
+// the call to Impl: skip the op and vtable lookup and call Impl directly,
+// falling back to the regular resolution for everything else (efl_super,
+// overrides, classes). Generated by eolian, not meant to be used by hand.
+#define EFL_FUNC_FINAL_OP(Obj, Klass) \
+   if (EINA_LIKELY(_efl_object_call_resolve_direct((Eo *) Obj, Klass, &___call))) \
+     goto __direct_call; /* yes a goto - see below */
+
+#define _EFL_OBJECT_FINAL_FUNC_BODY(Name, Klass, Impl, ObjType, Ret, DefRet, ErrorCase) \
+  Ret \
+  Name(ObjType obj) \
+  { \
+     typedef Ret (*_Eo_##Name##_func)(Eo *, void *obj_data); \
+     Ret _r; \
+     Efl_Object_Op_Call_Data ___call; \
+     EFL_FUNC_FINAL_OP(obj, Klass); \
+     EFL_FUNC_COMMON_OP_RESOLVE(obj, Name, DefRet); \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _r = _EFL_OBJECT_API_CALL_HOOK(_func_(___call.eo_id, ___call.data)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+     return _r; \
+     EFL_FUNC_COMMON_OP_END(obj, Name, DefRet, ErrorCase); \
+__direct_call: EINA_HOT; \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _r = _EFL_OBJECT_API_CALL_HOOK(Impl(___call.eo_id, ___call.data)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+     return _r; \
+  }
+
+#define _EFL_OBJECT_FINAL_VOID_FUNC_BODY(Name, Klass, Impl, ObjType, ErrorCase) \
+  void \
+  Name(ObjType obj) \
+  { \
+     typedef void (*_Eo_##Name##_func)(Eo *, void *obj_data); \
+     Efl_Object_Op_Call_Data ___call; \
+     EFL_FUNC_FINAL_OP(obj, Klass); \
+     EFL_FUNC_COMMON_OP_RESOLVE(obj, Name, ); \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _EFL_OBJECT_API_CALL_HOOK(_func_(___call.eo_id, ___call.data)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+     return; \
+     EFL_FUNC_COMMON_OP_END(obj, Name, , ErrorCase); \
+__direct_call: EINA_HOT; \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _EFL_OBJECT_API_CALL_HOOK(Impl(___call.eo_id, ___call.data)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+  }
+
+#define _EFL_OBJECT_FINAL_FUNC_BODYV(Name, Klass, Impl, ObjType, Ret, DefRet, ErrorCase, Arguments, ...) \
+  Ret \
+  Name(ObjType obj, __VA_ARGS__) \
+  { \
+     typedef Ret (*_Eo_##Name##_func)(Eo *, void *obj_data, __VA_ARGS__); \
+     Ret _r; \
+     Efl_Object_Op_Call_Data ___call; \
+     EFL_FUNC_FINAL_OP(obj, Klass); \
+     EFL_FUNC_COMMON_OP_RESOLVE(obj, Name, DefRet); \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _r = _EFL_OBJECT_API_CALL_HOOK(_func_(___call.eo_id, ___call.data, Arguments)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+     return _r; \
+     EFL_FUNC_COMMON_OP_END(obj, Name, DefRet, ErrorCase); \
+__direct_call: EINA_HOT; \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _r = _EFL_OBJECT_API_CALL_HOOK(Impl(___call.eo_id, ___call.data, Arguments)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+     return _r; \
+  }
+
+#define _EFL_OBJECT_FINAL_VOID_FUNC_BODYV(Name, Klass, Impl, ObjType, ErrorCase, Arguments, ...) \
+  void \
+  Name(ObjType obj, __VA_ARGS__) \
+  { \
+     typedef void (*_Eo_##Name##_func)(Eo *, void *obj_data, __VA_ARGS__); \
+     Efl_Object_Op_Call_Data ___call; \
+     EFL_FUNC_FINAL_OP(obj, Klass); \
+     EFL_FUNC_COMMON_OP_RESOLVE(obj, Name, ); \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _EFL_OBJECT_API_CALL_HOOK(_func_(___call.eo_id, ___call.data, Arguments)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+     return; \
+     EFL_FUNC_COMMON_OP_END(obj, Name, , ErrorCase); \
+__direct_call: EINA_HOT; \
+     _EFL_OBJECT_API_BEFORE_HOOK \
+     _EFL_OBJECT_API_CALL_HOOK(Impl(___call.eo_id, ___call.data, Arguments)); \
+     _efl_object_call_end(&___call); \
+     _EFL_OBJECT_API_AFTER_HOOK \
+  }
+
+#define EFL_FUNC_BODY_FINAL(Name, Klass, Impl, Ret, DefRet) _EFL_OBJECT_FINAL_FUNC_BODY(Name, Klass, Impl, Eo *, Ret, DefRet, )
+#define EFL_VOID_FUNC_BODY_FINAL(Name, Klass, Impl) _EFL_OBJECT_FINAL_VOID_FUNC_BODY(Name, Klass, Impl, Eo *, )
+#define EFL_FUNC_BODYV_FINAL(Name, Klass, Impl, Ret, DefRet, Arguments, ...) _EFL_OBJECT_FINAL_FUNC_BODYV(Name, Klass, Impl, Eo *, Ret, DefRet, , EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+#define EFL_VOID_FUNC_BODYV_FINAL(Name, Klass, Impl, Arguments, ...) _EFL_OBJECT_FINAL_VOID_FUNC_BODYV(Name, Klass, Impl, Eo *, , EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+
+#define EFL_FUNC_BODY_CONST_FINAL(Name, Klass, Impl, Ret, DefRet) _EFL_OBJECT_FINAL_FUNC_BODY(Name, Klass, Impl, const Eo *, Ret, DefRet, )
+#define EFL_VOID_FUNC_BODY_CONST_FINAL(Name, Klass, Impl) _EFL_OBJECT_FINAL_VOID_FUNC_BODY(Name, Klass, Impl, const Eo *, )
+#define EFL_FUNC_BODYV_CONST_FINAL(Name, Klass, Impl, Ret, DefRet, Arguments, ...) _EFL_OBJECT_FINAL_FUNC_BODYV(Name, Klass, Impl, const Eo *, Ret, DefRet, , EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+#define EFL_VOID_FUNC_BODYV_CONST_FINAL(Name, Klass, Impl, Arguments, ...) _EFL_OBJECT_FINAL_VOID_FUNC_BODYV(Name, Klass, Impl, const Eo *, , EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+
+#define EFL_FUNC_BODY_FALLBACK_FINAL(Name, Klass, Impl, Ret, DefRet, FallbackCall) _EFL_OBJECT_FINAL_FUNC_BODY(Name, Klass, Impl, Eo *, Ret, DefRet, FallbackCall)
+#define EFL_VOID_FUNC_BODY_FALLBACK_FINAL(Name, Klass, Impl, FallbackCall) _EFL_OBJECT_FINAL_VOID_FUNC_BODY(Name, Klass, Impl, Eo *, FallbackCall)
+#define EFL_FUNC_BODYV_FALLBACK_FINAL(Name, Klass, Impl, Ret, DefRet, FallbackCall, Arguments, ...) _EFL_OBJECT_FINAL_FUNC_BODYV(Name, Klass, Impl, Eo *, Ret, DefRet, FallbackCall, EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+#define EFL_VOID_FUNC_BODYV_FALLBACK_FINAL(Name, Klass, Impl, FallbackCall, Arguments, ...) _EFL_OBJECT_FINAL_VOID_FUNC_BODYV(Name, Klass, Impl, Eo *, FallbackCall, EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+
+#define EFL_FUNC_BODY_CONST_FALLBACK_FINAL(Name, Klass, Impl, Ret, DefRet, FallbackCall) _EFL_OBJECT_FINAL_FUNC_BODY(Name, Klass, Impl, const Eo *, Ret, DefRet, FallbackCall)
+#define EFL_VOID_FUNC_BODY_CONST_FALLBACK_FINAL(Name, Klass, Impl, FallbackCall) _EFL_OBJECT_FINAL_VOID_FUNC_BODY(Name, Klass, Impl, const Eo *, FallbackCall)
+#define EFL_FUNC_BODYV_CONST_FALLBACK_FINAL(Name, Klass, Impl, Ret, DefRet, FallbackCall, Arguments, ...) _EFL_OBJECT_FINAL_FUNC_BODYV(Name, Klass, Impl, const Eo *, Ret, DefRet, FallbackCall, EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+#define EFL_VOID_FUNC_BODYV_CONST_FALLBACK_FINAL(Name, Klass, Impl, FallbackCall, Arguments, ...) _EFL_OBJECT_FINAL_VOID_FUNC_BODYV(Name, Klass, Impl, const Eo *, FallbackCall, EFL_FUNC_CALL(Arguments), __VA_ARGS__)
+
 #ifndef _WIN32
 # define _EFL_OBJECT_OP_API_ENTRY(a) (void*)a
 #else
@@ -1412,6 +1532,9 @@ EAPI Efl_Object_Op _efl_object_op_api_id_get(const void *api_func, const Eo *obj
 // gets the real function pointer and the object data
 EAPI Eina_Bool _efl_object_call_resolve(Eo *obj, const char *func_name, Efl_Object_Op_Call_Data *call, Efl_Object_Op op, const char *file, int line);
 
+// gets the object data for a direct call on a plain instance of klass
+EAPI Eina_Bool _efl_object_call_resolve_direct(Eo *obj, const Efl_Class *klass, Efl_Object_Op_Call_Data *call);
+
 // end of the eo call barrier, unref the obj
 EAPI void _efl_object_call_end(Efl_Object_Op_Call_Data *call);
 
@@ -706,6 +706,32 @@ on_null:
    return EINA_FALSE;
 }
 
+EAPI Eina_Bool
+_efl_object_call_resolve_direct(Eo *eo_id, const Efl_Class *klass_id, Efl_Object_Op_Call_Data *call)
+{
+   _Eo_Object *obj;
+
+   // only plain instances of klass qualify for the direct call, anything
+   // else (classes, efl_super, overrides, subclasses made by hand) goes
+   // through _efl_object_call_resolve() which handles all of that
+   if (EINA_UNLIKELY(!eo_id || !_eo_is_a_obj(eo_id))) return EINA_FALSE;
+
+   obj = _eo_obj_pointer_get((Eo_Id)eo_id, __FUNCTION__, __FILE__, __LINE__);
+   if (EINA_UNLIKELY(!obj)) return EINA_FALSE;
+   if (EINA_UNLIKELY((_eo_class_id_get(obj->klass) != klass_id) ||
+                     (obj->cur_klass != NULL) || _obj_is_override(obj)))
+     {
+        _eo_obj_pointer_done((Eo_Id)eo_id);
+        return EINA_FALSE;
+     }
+
+   call->eo_id = eo_id;
+   call->obj = _efl_ref(obj);
+   call->func = NULL;
+   call->data = _efl_data_scope_get(obj, obj->klass);
+   return EINA_TRUE;
+}
+
 EAPI void
 _efl_object_call_end(Efl_Object_Op_Call_Data *call)
 {
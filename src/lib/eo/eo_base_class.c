@@ -1803,14 +1803,19 @@ struct _Efl_Future_Scheduler
    const Efl_Callback_Array_Item *array;
    const Eo *self;
 
-   Eina_List *futures;
+   Eina_Inlist *futures;
+   Eina_Inlist *dispatching; // batch being dispatched
 
    Eina_Bool listener : 1;
+   Eina_Bool in_dispatch : 1;
+   Eina_Bool dead : 1; // cancelled while dispatching, freed once done
 };
 
 struct _Efl_Future_Scheduler_Entry
 {
    Eina_Future_Schedule_Entry base;
+   EINA_INLIST;
+   Eina_Inlist **queue; // futures or dispatching, NULL once taken out
    Eina_Future_Scheduler_Cb cb;
    Eina_Future *future;
    Eina_Value value;
@@ -1829,53 +1834,88 @@ _future_scheduler_cleanup(Efl_Object_Data *pd)
    _efl_object_extension_noneed(pd);
 }
 
+static void
+_future_scheduler_release(Efl_Future_Scheduler *sched)
+{
+   if (schedulers_count > 8)
+     {
+        free(sched);
+     }
+   else
+     {
+        eina_trash_push(&schedulers_trash, sched);
+        schedulers_count++;
+     }
+}
+
+static Efl_Future_Scheduler_Entry *
+_future_scheduler_pop(Eina_Inlist **queue)
+{
+   Efl_Future_Scheduler_Entry *entry;
+
+   entry = EINA_INLIST_CONTAINER_GET(*queue, Efl_Future_Scheduler_Entry);
+   *queue = eina_inlist_remove(*queue, *queue);
+   entry->queue = NULL;
+   return entry;
+}
+
 static void
 _futures_dispatch_cb(void *data, const Efl_Event *ev EINA_UNUSED)
 {
    Efl_Future_Scheduler *sched = data;
-   Eina_List *entries = sched->futures;
    Efl_Future_Scheduler_Entry *entry;
+   Eina_Bool nested = sched->in_dispatch;
 
-   sched->futures = NULL;
+   // The batch stays reachable from sched, so a callback can recall any
+   // entry of it, and a nested dispatch just adds to it.
+   while (sched->futures)
+     {
+        entry = _future_scheduler_pop(&sched->futures);
+        entry->queue = &sched->dispatching;
+        sched->dispatching = eina_inlist_append(sched->dispatching,
+                                                EINA_INLIST_GET(entry));
+     }
 
    efl_event_callback_array_del((Eo *) sched->self, sched->array, sched);
    sched->listener = EINA_FALSE;
+   sched->in_dispatch = EINA_TRUE;
 
-   // Now trigger callbacks
-   EINA_LIST_FREE(entries, entry)
+   // Now trigger callbacks, the whole batch scheduled since the last event
+   while (sched->dispatching)
      {
+        entry = _future_scheduler_pop(&sched->dispatching);
         entry->cb(entry->future, entry->value);
         eina_mempool_free(_efl_future_scheduler_entry_mempool, entry);
      }
+
+   if (nested) return;
+   sched->in_dispatch = EINA_FALSE;
+   if (sched->dead) _future_scheduler_release(sched);
 }
 
 static void
 _futures_cancel_cb(void *data)
 {
    Efl_Future_Scheduler *sched = data;
-   Eina_List *entries = sched->futures;
    Efl_Future_Scheduler_Entry *entry;
 
    efl_event_callback_array_del((Eo *) sched->self, sched->array, sched);
    sched->listener = EINA_FALSE;
-   sched->futures = NULL;
 
-   EINA_LIST_FREE(entries, entry)
+   while (sched->futures || sched->dispatching)
      {
+        entry = _future_scheduler_pop(sched->dispatching ?
+                                      &sched->dispatching : &sched->futures);
         eina_future_cancel(entry->future);
         eina_value_flush(&entry->value);
         eina_mempool_free(_efl_future_scheduler_entry_mempool, entry);
      }
 
-   if (schedulers_count > 8)
-     {
-        free(sched);
-     }
+   // The dispatch loop still holds on sched, it will release it
+   if (sched->in_dispatch)
+     sched->dead = EINA_TRUE;
    else
-     {
-        eina_trash_push(&schedulers_trash, sched);
-        schedulers_count++;
-     }
+     _future_scheduler_release(sched);
 }
 
 static Eina_Future_Schedule_Entry *
@@ -1894,6 +1934,7 @@ _efl_event_future_scheduler(Eina_Future_Scheduler *s_sched,
    entry->cb = cb;
    entry->future = future;
    entry->value = value;
+   entry->queue = &sched->futures;
 
    if (!sched->listener)
      {
@@ -1901,7 +1942,7 @@ _efl_event_future_scheduler(Eina_Future_Scheduler *s_sched,
         sched->listener = EINA_TRUE;
      }
 
-   sched->futures = eina_list_append(sched->futures, entry);
+   sched->futures = eina_inlist_append(sched->futures, EINA_INLIST_GET(entry));
    return &entry->base;
 }
 
@@ -1910,15 +1951,15 @@ _efl_event_future_recall(Eina_Future_Schedule_Entry *s_entry)
 {
    Efl_Future_Scheduler_Entry *entry = (Efl_Future_Scheduler_Entry *)s_entry;
    Efl_Future_Scheduler *sched;
-   Eina_List *lookup;
 
    sched = (Efl_Future_Scheduler *) entry->base.scheduler;
 
-   lookup = eina_list_data_find_list(sched->futures, entry);
-   if (!lookup) return;
+   // The entry running its callback or being cancelled is out of both lists
+   if (!entry->queue) return;
 
-   sched->futures = eina_list_remove_list(sched->futures, lookup);
-   if (!sched->futures)
+   *entry->queue = eina_inlist_remove(*entry->queue, EINA_INLIST_GET(entry));
+   entry->queue = NULL;
+   if (!sched->futures && !sched->dispatching)
      {
         Efl_Object_Data *pd = efl_data_scope_get(sched->self, EFL_OBJECT_CLASS);
 
@@ -1966,6 +2007,11 @@ _efl_object_event_future_scheduler_get(const Eo *obj, Efl_Object_Data *pd, Efl_C
    sched->scheduler.recall = _efl_event_future_recall;
    sched->array = array;
    sched->self = obj;
+   sched->futures = NULL;
+   sched->dispatching = NULL;
+   sched->listener = EINA_FALSE;
+   sched->in_dispatch = EINA_FALSE;
+   sched->dead = EINA_FALSE;
 
    eina_hash_add(ext->schedulers, &array, sched);
 
@@ -2374,6 +2374,20 @@ EAPI Eina_Bool eolian_class_ctor_enable_get(const Eolian_Class *klass);
  */
 EAPI Eina_Bool eolian_class_dtor_enable_get(const Eolian_Class *klass);
 
+/*
+ * @brief Indicates if the class is final, i.e. marked with @final.
+ *
+ * Final classes cannot be inherited from, which lets generators call
+ * the implementation of methods declared in them directly instead of
+ * resolving them through the object's vtable.
+ *
+ * @param[in] klass the class.
+ * @return EINA_TRUE if the class is final, EINA_FALSE otherwise.
+ *
+ * @ingroup Eolian
+ */
+EAPI Eina_Bool eolian_class_is_final_get(const Eolian_Class *klass);
+
 /*
  * @brief Returns the name of the C function used to get the Efl_Class pointer.
  *
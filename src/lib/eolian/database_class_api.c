@@ -148,6 +148,13 @@ eolian_class_dtor_enable_get(const Eolian_Class *cl)
    return cl->class_dtor_enable;
 }
 
+EAPI Eina_Bool
+eolian_class_is_final_get(const Eolian_Class *cl)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cl, EINA_FALSE);
+   return cl->is_final;
+}
+
 EAPI Eina_Stringshare *
 eolian_class_c_get_function_name_get(const Eolian_Class *cl)
 {
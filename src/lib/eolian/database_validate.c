@@ -1522,6 +1522,12 @@ _validate_class(Validate_State *vals, Eolian_Class *cl,
              _eo_parser_log(&cl->base, "non-beta class cannot have beta parent");
              return EINA_FALSE;
           }
+        if (cl->parent->is_final)
+          {
+             _eo_parser_log(&cl->base, "class '%s' cannot inherit from final class '%s'",
+                            cl->base.name, cl->parent->base.name);
+             return EINA_FALSE;
+          }
         if (!_validate_class(vals, cl->parent, nhash, ehash, phash, chash))
           return EINA_FALSE;
      }
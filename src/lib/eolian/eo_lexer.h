@@ -34,7 +34,7 @@ enum Tokens
     KW(parse), KW(parts), KW(ptr), KW(set), KW(type), KW(values), KW(requires), \
     \
     KWAT(auto), KWAT(beta), KWAT(by_ref), KWAT(c_name), KWAT(const), \
-    KWAT(empty), KWAT(extern), KWAT(free), KWAT(hot), KWAT(in), KWAT(inout), \
+    KWAT(empty), KWAT(extern), KWAT(final), KWAT(free), KWAT(hot), KWAT(in), KWAT(inout), \
     KWAT(move), KWAT(no_unused), KWAT(nullable), KWAT(optional), KWAT(out), \
     KWAT(private), KWAT(property), KWAT(protected), KWAT(restart), \
     KWAT(pure_virtual), KWAT(static), \
@@ -2230,7 +2230,8 @@ parse_class(Eo_Lexer *ls, Eolian_Class_Type type)
    ls->klass->type = type;
    eo_lexer_context_push(ls);
    Eina_Stringshare *cname = NULL;
-   Eina_Bool has_beta = EINA_FALSE, has_c_name = EINA_FALSE;
+   Eina_Bool has_beta = EINA_FALSE, has_c_name = EINA_FALSE,
+             has_final = EINA_FALSE;
    for (;;) switch (ls->t.kw)
      {
       case KW_at_beta:
@@ -2238,6 +2239,13 @@ parse_class(Eo_Lexer *ls, Eolian_Class_Type type)
         ls->klass->base.is_beta = EINA_TRUE;
         eo_lexer_get(ls);
         break;
+      case KW_at_final:
+        CASE_LOCK(ls, final, "final qualifier");
+        if (type != EOLIAN_CLASS_REGULAR)
+          eo_lexer_syntax_error(ls, "only regular classes can be final");
+        ls->klass->is_final = EINA_TRUE;
+        eo_lexer_get(ls);
+        break;
       case KW_at_c_name:
         CASE_LOCK(ls, c_name, "@c_name specifier");
         cname = parse_c_name(ls);
@@ -125,6 +125,19 @@ typedef void (*Ethumb_Client_Thumb_Exists_Cb)(void *data, Ethumb_Client *client,
  */
 typedef void (*Ethumb_Client_Generate_Cancel_Cb)(void *data, Eina_Bool success);
 
+/**
+ * @brief reports how long the server took for a thumbnail.
+ *
+ * @param data extra context given to ethumb_client_generate_timing_callback_set()
+ * @param client handle of the current connection to server.
+ * @param id identifier returned by ethumb_client_generate()
+ * @param queued seconds the request waited in the server queue.
+ * @param generation seconds the thumbnail generation took.
+ *
+ * @since 1.24
+ */
+typedef void (*Ethumb_Client_Generate_Timing_Cb)(void *data, Ethumb_Client *client, int id, double queued, double generation);
+
 EAPI int ethumb_client_init(void);
 EAPI int ethumb_client_shutdown(void);
 
@@ -194,6 +207,8 @@ EAPI Eina_Bool ethumb_client_thumb_exists_check(Ethumb_Exists *exists);
 EAPI int  ethumb_client_generate(Ethumb_Client *client, Ethumb_Client_Generate_Cb generated_cb, const void *data, Eina_Free_Cb free_data);
 EAPI void ethumb_client_generate_cancel(Ethumb_Client *client, int id, Ethumb_Client_Generate_Cancel_Cb cancel_cb, const void *data, Eina_Free_Cb free_data);
 EAPI void ethumb_client_generate_cancel_all(Ethumb_Client *client);
+EAPI void ethumb_client_generate_priority_set(Ethumb_Client *client, int id, int priority);
+EAPI void ethumb_client_generate_timing_callback_set(Ethumb_Client *client, Ethumb_Client_Generate_Timing_Cb timing_cb, const void *data, Eina_Free_Cb free_data);
 
 typedef void (*Ethumb_Client_Async_Done_Cb)(Ethumb_Client *ethumbd, const char *thumb_path, const char *thumb_key, void *data);
 typedef void (*Ethumb_Client_Async_Error_Cb)(Ethumb_Client *ethumbd, void *data);
@@ -205,6 +220,7 @@ EAPI Ethumb_Client_Async *ethumb_client_thumb_async_get(Ethumb_Client *client,
                                                         Ethumb_Client_Async_Error_Cb error,
                                                         const void *data);
 EAPI void ethumb_client_thumb_async_cancel(Ethumb_Client *client, Ethumb_Client_Async *request);
+EAPI void ethumb_client_thumb_async_priority_set(Ethumb_Client *client, Ethumb_Client_Async *request, int priority);
   /**
  * @}
  */
@@ -117,8 +117,15 @@ struct _Ethumb_Client
       void                *data;
       Eina_Free_Cb         free_data;
    } die;
+   struct
+   {
+      Ethumb_Client_Generate_Timing_Cb cb;
+      void                            *data;
+      Eina_Free_Cb                     free_data;
+   } timing;
    Eldbus_Proxy           *proxy;
    Eldbus_Signal_Handler  *generated_sig_handler;
+   Eldbus_Signal_Handler  *generated_timing_sig_handler;
    EINA_REFCOUNT;
    Eina_Bool              connected : 1;
    Eina_Bool              server_started : 1;
@@ -192,6 +199,7 @@ static int _initcount = 0;
 static Eina_Hash *_exists_request = NULL;
 
 static void _ethumb_client_generated_cb(void *data, const Eldbus_Message *msg);
+static void _ethumb_client_generated_timing_cb(void *data, const Eldbus_Message *msg);
 static void _ethumb_client_call_new(Ethumb_Client *client);
 static void _ethumb_client_name_owner_changed(void *context, const char *bus, const char *old_id, const char *new_id);
 
@@ -277,6 +285,11 @@ _ethumb_client_free(Ethumb_Client *client)
         eldbus_signal_handler_del(client->generated_sig_handler);
         client->generated_sig_handler = NULL;
      }
+   if (client->generated_timing_sig_handler)
+     {
+        eldbus_signal_handler_del(client->generated_timing_sig_handler);
+        client->generated_timing_sig_handler = NULL;
+     }
    if (client->proxy)
      {
         obj = eldbus_proxy_object_get(client->proxy);
@@ -294,6 +307,8 @@ _ethumb_client_free(Ethumb_Client *client)
      client->connect.free_data(client->connect.data);
    if (client->die.free_data)
      client->die.free_data(client->die.data);
+   if (client->timing.free_data)
+     client->timing.free_data(client->timing.data);
 
    free(client);
 }
@@ -399,6 +414,11 @@ _ethumb_client_new_cb(void *data, const Eldbus_Message *msg, Eldbus_Pending *pen
         eldbus_signal_handler_del(client->generated_sig_handler);
         client->generated_sig_handler = NULL;
      }
+   if (client->generated_timing_sig_handler)
+     {
+        eldbus_signal_handler_del(client->generated_timing_sig_handler);
+        client->generated_timing_sig_handler = NULL;
+     }
    if (!client->proxy)
      {
         obj = eldbus_object_get(client->conn, _ethumb_dbus_bus_name, opath);
@@ -407,6 +427,9 @@ _ethumb_client_new_cb(void *data, const Eldbus_Message *msg, Eldbus_Pending *pen
    client->generated_sig_handler =
      eldbus_proxy_signal_handler_add(client->proxy, "generated",
                                      _ethumb_client_generated_cb, client);
+   client->generated_timing_sig_handler =
+     eldbus_proxy_signal_handler_add(client->proxy, "generated_timing",
+                                     _ethumb_client_generated_timing_cb, client);
    _ethumb_client_report_connect(client, 1);
 }
 
@@ -701,6 +724,37 @@ ethumb_client_on_server_die_callback_set(Ethumb_Client *client, Ethumb_Client_Di
    client->die.free_data = free_data;
 }
 
+/**
+ * Sets the callback to report how long each thumbnail took.
+ *
+ * It is called once per thumbnail generated by the server, right
+ * after the callback given to ethumb_client_generate(), with the
+ * seconds the request waited in the queue and the seconds its
+ * generation took.
+ *
+ * @param client the client instance to monitor. Must @b not be @c
+ *        NULL.
+ * @param timing_cb function to call back for each thumbnail. May be
+ *        @c NULL to stop reporting.
+ * @param data context to give back to @a timing_cb. May be @c NULL.
+ * @param free_data used to release @a data resources when another
+ *        callback is set or user calls ethumb_client_disconnect().
+ *
+ * @since 1.24
+ */
+EAPI void
+ethumb_client_generate_timing_callback_set(Ethumb_Client *client, Ethumb_Client_Generate_Timing_Cb timing_cb, const void *data, Eina_Free_Cb free_data)
+{
+   EINA_SAFETY_ON_NULL_RETURN(client);
+
+   if (client->timing.free_data)
+     client->timing.free_data(client->timing.data);
+
+   client->timing.cb = timing_cb;
+   client->timing.data = (void *)data;
+   client->timing.free_data = free_data;
+}
+
 /**
  * @cond LOCAL
  */
@@ -971,6 +1025,24 @@ _ethumb_client_generated_cb(void *data, const Eldbus_Message *msg)
      }
 }
 
+static void
+_ethumb_client_generated_timing_cb(void *data, const Eldbus_Message *msg)
+{
+   Ethumb_Client *client = data;
+   double queued, generation;
+   int id = -1;
+
+   if (!client) return;
+   if (!client->timing.cb) return;
+   if (!eldbus_message_arguments_get(msg, "idd", &id, &queued, &generation))
+     {
+        ERR("Error getting data from signal.");
+        return;
+     }
+
+   client->timing.cb(client->timing.data, client, id, queued, generation);
+}
+
 static void
 _ethumb_client_queue_add_cb(void *data, const Eldbus_Message *msg, Eldbus_Pending *eldbus_pending EINA_UNUSED)
 {
@@ -1222,6 +1294,30 @@ ethumb_client_generate_cancel_all(Ethumb_Client *client)
    eldbus_proxy_call(client->proxy, "queue_clear", NULL, NULL, -1, "");
 }
 
+/**
+ * Change the priority of a thumbnail not being generated yet.
+ *
+ * Requests with higher priority are generated first, the ones with
+ * the same priority in the order they were requested. The default
+ * priority is 0.
+ *
+ * @param client client instance. Must @b not be @c NULL and client
+ *        must be connected (after connected_cb is called).
+ * @param id valid id returned by ethumb_client_generate()
+ * @param priority the new priority, may be negative.
+ *
+ * @since 1.24
+ */
+EAPI void
+ethumb_client_generate_priority_set(Ethumb_Client *client, int id, int priority)
+{
+   EINA_SAFETY_ON_NULL_RETURN(client);
+   EINA_SAFETY_ON_FALSE_RETURN(id >= 0);
+
+   eldbus_proxy_call(client->proxy, "queue_priority_set", NULL, NULL, -1,
+                     "ii", id, priority);
+}
+
 /**
  * Configure future requests to use FreeDesktop.Org preset.
  *
@@ -2142,12 +2238,28 @@ struct _Ethumb_Client_Async
    const void                  *data;
 
    int                          id;
+   int                          priority;
 };
 
 static Ecore_Idler *idler[2] = { NULL, NULL };
 static Eina_List *pending = NULL;
 static Eina_List *idle_tasks[2] = { NULL, NULL };
 
+/* idlers take tasks from the head: keep the highest priority first and
+ * the tasks of the same priority in the order they were queued */
+static Eina_List *
+_ethumb_client_async_queue(Eina_List *tasks, Ethumb_Client_Async *async)
+{
+   Ethumb_Client_Async *other;
+   Eina_List *l;
+
+   EINA_LIST_REVERSE_FOREACH(tasks, l, other)
+     if (other->priority >= async->priority)
+       return eina_list_append_relative_list(tasks, async, l);
+
+   return eina_list_prepend(tasks, async);
+}
+
 static void
 _ethumb_client_async_free(Ethumb_Client_Async *async)
 {
@@ -2210,6 +2322,9 @@ _ethumb_client_thumb_generate_idler(void *data EINA_UNUSED)
         else
           {
              async->client->ethumb = tmp;
+             if (async->priority)
+               ethumb_client_generate_priority_set(async->client, async->id,
+                                                   async->priority);
           }
 
         if (async)
@@ -2247,7 +2362,7 @@ _ethumb_client_thumb_exists(void *data, Ethumb_Client *client, Ethumb_Exists *re
      }
    else
      {
-        idle_tasks[1] = eina_list_append(idle_tasks[1], async);
+        idle_tasks[1] = _ethumb_client_async_queue(idle_tasks[1], async);
 
         if (!idler[1])
           idler[1] = ecore_idler_add(_ethumb_client_thumb_generate_idler, NULL);
@@ -2315,8 +2430,9 @@ ethumb_client_thumb_async_get(Ethumb_Client *client,
    async->data = data;
    async->exists = NULL;
    async->id = -1;
+   async->priority = 0;
 
-   idle_tasks[0] = eina_list_append(idle_tasks[0], async);
+   idle_tasks[0] = _ethumb_client_async_queue(idle_tasks[0], async);
 
    if (!idler[0])
      idler[0] = ecore_idler_add(_ethumb_client_thumb_exists_idler, NULL);
@@ -2360,3 +2476,46 @@ ethumb_client_thumb_async_cancel(Ethumb_Client *client, Ethumb_Client_Async *req
 
    _ethumb_client_async_free(request);
 }
+
+/**
+ * Change the priority of a request made with
+ * ethumb_client_thumb_async_get().
+ *
+ * Requests with higher priority are checked and generated first, the
+ * ones with the same priority in the order they were requested. The
+ * default priority is 0. Once the request reached the server this
+ * forwards to ethumb_client_generate_priority_set().
+ *
+ * @param client client instance. Must @b not be @c NULL.
+ * @param request request returned by ethumb_client_thumb_async_get().
+ * @param priority the new priority, may be negative.
+ *
+ * @since 1.24
+ */
+EAPI void
+ethumb_client_thumb_async_priority_set(Ethumb_Client *client, Ethumb_Client_Async *request, int priority)
+{
+   Eina_List *l;
+   int i;
+
+   EINA_SAFETY_ON_NULL_RETURN(client);
+   EINA_SAFETY_ON_NULL_RETURN(request);
+
+   if (request->priority == priority) return;
+   request->priority = priority;
+
+   if (request->id != -1)
+     {
+        ethumb_client_generate_priority_set(request->client, request->id,
+                                            priority);
+        return;
+     }
+
+   for (i = 0; i < 2; i++)
+     {
+        l = eina_list_data_find_list(idle_tasks[i], request);
+        if (!l) continue;
+        idle_tasks[i] = eina_list_remove_list(idle_tasks[i], l);
+        idle_tasks[i] = _ethumb_client_async_queue(idle_tasks[i], request);
+     }
+}
@@ -3065,6 +3065,56 @@ EAPI Eina_Bool   evas_cserve_config_set(const Evas_Cserve_Config *config) EINA_W
  */
 EAPI void        evas_cserve_disconnect(void);
 
+/**
+ * @defgroup Evas_Damage_Stats Damage Statistics
+ * @ingroup Evas
+ *
+ * Counters about the regions the software engines are asked to redraw and
+ * the regions they actually render after merging them. They are meant to
+ * tune tile sizes and merging on a given output, not as exact accounting.
+ * Setting EVAS_TILER_STRATEGY to fuzzy, grid or cost in the environment
+ * makes the engines merge them with the matching #Eina_Tiler_Strategy.
+ *
+ * @since 1.24
+ */
+typedef struct _Evas_Damage_Stats Evas_Damage_Stats;
+
+/**
+ * Statistics about the damage regions of all the canvases of the process.
+ * @ingroup Evas_Damage_Stats
+ * @since 1.24
+ */
+struct _Evas_Damage_Stats
+{
+   unsigned long long redraws;      /**< number of redraw rectangles added */
+   unsigned long long redraws_area; /**< sum of the area of the redraw rectangles, overlaps included, in pixels */
+   unsigned long long frames;       /**< number of times the update regions were computed */
+   unsigned long long updates;      /**< number of update rectangles given to render */
+   unsigned long long updates_area; /**< sum of the area of the update rectangles, in pixels */
+   unsigned long long bounded;      /**< number of frames with too many regions, rendered as their bounding box */
+};
+
+/**
+ * Retrieves the damage statistics accumulated since the last reset.
+ *
+ * @param stats pointer to structure to fill with the statistics.
+ * @return @c EINA_TRUE if @p stats were filled with data,
+ *         @c EINA_FALSE otherwise (when @p stats is untouched)
+ *
+ * @see evas_damage_stats_reset()
+ * @ingroup Evas_Damage_Stats
+ * @since 1.24
+ */
+EAPI Eina_Bool   evas_damage_stats_get(Evas_Damage_Stats *stats);
+
+/**
+ * Resets the damage statistics.
+ *
+ * @ingroup Evas_Damage_Stats
+ * @since 1.24
+ */
+EAPI void        evas_damage_stats_reset(void);
+
 /**
  * @defgroup Evas_Utils General Utilities
  * @ingroup Evas
@@ -5,6 +5,7 @@ typedef struct _Evas_Cache_Image                Evas_Cache_Image;
 typedef struct _Evas_Cache_Image_Func           Evas_Cache_Image_Func;
 typedef struct _Evas_Cache_Engine_Image         Evas_Cache_Engine_Image;
 typedef struct _Evas_Cache_Engine_Image_Func    Evas_Cache_Engine_Image_Func;
+typedef struct _Evas_Cache_Image_Monitor        Evas_Cache_Image_Monitor;
 
 struct _Evas_Cache_Image_Func
 {
@@ -62,6 +63,15 @@ struct _Evas_Cache_Image
    int                           usage;
    unsigned int                  limit;
    int                           references;
+
+   double                        revalidate;
+   Evas_Cache_Image_Monitor     *monitor;
+
+   struct {
+      unsigned int               hits;
+      unsigned int               misses;
+      unsigned int               stats;
+   } counters;
 };
 
 struct _Evas_Cache_Engine_Image_Func
@@ -128,6 +138,10 @@ EAPI void*                    evas_cache_private_from_image_entry_get(Image_Entr
 EAPI int                      evas_cache_image_usage_get(Evas_Cache_Image *cache);
 EAPI int                      evas_cache_image_get(Evas_Cache_Image *cache);
 EAPI void                     evas_cache_image_set(Evas_Cache_Image *cache, unsigned int size);
+EAPI double                   evas_cache_image_revalidate_get(Evas_Cache_Image *cache);
+EAPI void                     evas_cache_image_revalidate_set(Evas_Cache_Image *cache, double interval);
+EAPI void                     evas_cache_image_file_invalidate(Evas_Cache_Image *cache, const char *file);
+EAPI void                     evas_cache_image_stats_get(Evas_Cache_Image *cache, unsigned int *hits, unsigned int *misses, unsigned int *stats);
 
 EAPI Image_Entry*             evas_cache_image_alone(Image_Entry *im);
 EAPI Image_Entry*             evas_cache_image_dirty(Image_Entry *im, unsigned int x, unsigned int y, unsigned int w, unsigned int h);
@@ -6,11 +6,19 @@
 #include <assert.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/time.h>
+#include <time.h>
 #include <errno.h>
+#ifdef HAVE_SYS_INOTIFY_H
+# include <sys/inotify.h>
+# include <unistd.h>
+#endif
 
 #include "evas_common_private.h"
 #include "evas_private.h"
 
+#include "Ecore.h"
+
 //#define CACHEDUMP 1
 
 typedef struct _Evas_Cache_Preload Evas_Cache_Preload;
@@ -84,7 +92,7 @@ _evas_cache_image_activ_add(Image_Entry *im)
    if (im->flags.given_mmap)
      eina_hash_direct_add(im->cache->mmap_activ, im->cache_key, im);
    else
-     eina_hash_direct_add(im->cache->activ, im->cache_key, im);
+     eina_hash_direct_add(im->cache->activ, &im->hkey, im);
 }
 
 static void
@@ -98,7 +106,7 @@ _evas_cache_image_activ_del(Image_Entry *im)
    if (im->flags.given_mmap)
      eina_hash_del(im->cache->mmap_activ, im->cache_key, im);
    else
-     eina_hash_del(im->cache->activ, im->cache_key, im);
+     eina_hash_del(im->cache->activ, &im->hkey, im);
 }
 
 static void
@@ -115,7 +123,7 @@ _evas_cache_image_lru_add(Image_Entry *im)
    if (im->flags.given_mmap)
      eina_hash_direct_add(im->cache->mmap_inactiv, im->cache_key, im);
    else
-     eina_hash_direct_add(im->cache->inactiv, im->cache_key, im);
+     eina_hash_direct_add(im->cache->inactiv, &im->hkey, im);
    im->cache->lru = eina_inlist_prepend(im->cache->lru, EINA_INLIST_GET(im));
    im->cache->usage += im->cache->func.mem_size_get(im);
 }
@@ -131,7 +139,7 @@ _evas_cache_image_lru_del(Image_Entry *im)
    if (im->flags.given_mmap)
      eina_hash_del(im->cache->mmap_inactiv, im->cache_key, im);
    else
-     eina_hash_del(im->cache->inactiv, im->cache_key, im);
+     eina_hash_del(im->cache->inactiv, &im->hkey, im);
    im->cache->lru = eina_inlist_remove(im->cache->lru, EINA_INLIST_GET(im));
    im->cache->usage -= im->cache->func.mem_size_get(im);
 }
@@ -227,9 +235,26 @@ _timestamp_build(Image_Timestamp *tstamp, struct stat *st)
 #endif
 }
 
+static double
+_evas_cache_image_time_get(void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + (((double)t.tv_nsec) / 1000000000.0);
+#else
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double)tv.tv_sec + (((double)tv.tv_usec) / 1000000.0);
+#endif
+}
+
 static Image_Entry *
 _evas_cache_image_entry_new(Evas_Cache_Image *cache,
                             const char *hkey,
+                            const Image_Entry_Key *ekey,
                             Image_Timestamp *tstamp,
                             Eina_File *f,
                             const char *file,
@@ -263,6 +288,13 @@ _evas_cache_image_entry_new(Evas_Cache_Image *cache,
    if (ie->f) ie->flags.given_mmap = EINA_TRUE;
    if (file) ie->file = eina_stringshare_add(file);
    if (key) ie->key = eina_stringshare_add(key);
+   if (ekey)
+     {
+        /* keep the padding of the copied opts as memcmp() sees it */
+        memcpy(&ie->hkey, ekey, sizeof (Image_Entry_Key));
+        ie->hkey.file = ie->file;
+        ie->hkey.key = ie->key;
+     }
    if (tstamp) ie->tstamp = *tstamp;
    else memset(&ie->tstamp, 0, sizeof(Image_Timestamp));
 
@@ -496,6 +528,7 @@ _evas_cache_image_entry_preload_add(Image_Entry *ie, const Eo *target, void (*pr
         ie->cache->preload = eina_list_append(ie->cache->preload, ie);
         ie->flags.pending = 0;
         ie->flags.preload_pending = 1;
+        evas_common_load_rgba_image_data_prefetch(ie);
         ie->preload = evas_preload_thread_run(_evas_cache_image_async_heavy,
                                               _evas_cache_image_async_end,
                                               _evas_cache_image_async_cancel,
@@ -573,10 +606,250 @@ evas_cache_image_set(Evas_Cache_Image *cache, unsigned int limit)
    evas_cache_image_flush(cache);
 }
 
+EAPI double
+evas_cache_image_revalidate_get(Evas_Cache_Image *cache)
+{
+   if (!cache) return 0.0;
+   return cache->revalidate;
+}
+
+static Eina_Bool
+_evas_cache_image_invalidate_cb(EINA_UNUSED const Eina_Hash *hash, EINA_UNUSED const void *key, void *data, void *fdata)
+{
+   Image_Entry *im = data;
+
+   if (im->file == fdata) im->validated = 0.0;
+   return EINA_TRUE;
+}
+
+/* sfile is stringshared, engine_lock is held */
+static void
+_evas_cache_image_file_invalidate(Evas_Cache_Image *cache, const char *sfile)
+{
+   eina_hash_foreach(cache->activ, _evas_cache_image_invalidate_cb, (void *)sfile);
+   eina_hash_foreach(cache->inactiv, _evas_cache_image_invalidate_cb, (void *)sfile);
+}
+
+#ifdef HAVE_SYS_INOTIFY_H
+/* While a revalidation interval is set, the files that were checked are
+ * watched with inotify so that a change on disk invalidates them at once
+ * instead of at the end of the interval. */
+# define MONITOR_EVENTS (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF)
+
+struct _Evas_Cache_Image_Monitor
+{
+   Ecore_Fd_Handler *handler;
+   Eina_Hash        *watches; /* watch descriptor -> stringshared file */
+   Eina_Hash        *files; /* stringshared file -> watch descriptor */
+   int               fd;
+};
+
+static void
+_evas_cache_image_monitor_unwatch(Evas_Cache_Image_Monitor *mon, int wd, Eina_Bool rm)
+{
+   const char *file;
+
+   file = eina_hash_find(mon->watches, &wd);
+   if (!file) return;
+   if (rm) inotify_rm_watch(mon->fd, wd);
+   eina_hash_del_by_key(mon->files, file);
+   eina_hash_del_by_key(mon->watches, &wd);
+}
+
+static Eina_Bool
+_evas_cache_image_monitor_cb(void *data, Ecore_Fd_Handler *fdh EINA_UNUSED)
+{
+   Evas_Cache_Image *cache = data;
+   Evas_Cache_Image_Monitor *mon = cache->monitor;
+   char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+   struct inotify_event *ev;
+   const char *file;
+   ssize_t len, i;
+
+   SLKL(engine_lock);
+   while ((len = read(mon->fd, buf, sizeof(buf))) > 0)
+     {
+        for (i = 0; i < len; i += sizeof(struct inotify_event) + ev->len)
+          {
+             ev = (struct inotify_event *)(buf + i);
+             file = eina_hash_find(mon->watches, &ev->wd);
+             if (!file) continue;
+
+             _evas_cache_image_file_invalidate(cache, file);
+             /* the watch follows the inode, a file that was replaced or
+              * removed is watched again on its next check */
+             if (ev->mask & IN_IGNORED)
+               _evas_cache_image_monitor_unwatch(mon, ev->wd, EINA_FALSE);
+             else if (ev->mask & (IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF))
+               _evas_cache_image_monitor_unwatch(mon, ev->wd, EINA_TRUE);
+          }
+     }
+   SLKU(engine_lock);
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_evas_cache_image_monitor_new(Evas_Cache_Image *cache)
+{
+   Evas_Cache_Image_Monitor *mon;
+
+   if (cache->monitor) return;
+   mon = calloc(1, sizeof(Evas_Cache_Image_Monitor));
+   if (!mon) return;
+   mon->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+   if (mon->fd < 0) goto on_error;
+   mon->handler = ecore_main_fd_handler_add(mon->fd, ECORE_FD_READ,
+                                            _evas_cache_image_monitor_cb,
+                                            cache, NULL, NULL);
+   if (!mon->handler) goto on_error;
+   mon->watches = eina_hash_int32_new(EINA_FREE_CB(eina_stringshare_del));
+   mon->files = eina_hash_stringshared_new(NULL);
+
+   SLKL(engine_lock);
+   cache->monitor = mon;
+   SLKU(engine_lock);
+   return;
+
+ on_error:
+   WRN("Could not watch the image files, changes are seen after %f seconds",
+       cache->revalidate);
+   if (mon->fd >= 0) close(mon->fd);
+   free(mon);
+}
+
+static void
+_evas_cache_image_monitor_free(Evas_Cache_Image *cache)
+{
+   Evas_Cache_Image_Monitor *mon = cache->monitor;
+
+   if (!mon) return;
+   SLKL(engine_lock);
+   cache->monitor = NULL;
+   SLKU(engine_lock);
+   ecore_main_fd_handler_del(mon->handler);
+   close(mon->fd);
+   eina_hash_free(mon->files);
+   eina_hash_free(mon->watches);
+   free(mon);
+}
+
+/* engine_lock is held */
+static void
+_evas_cache_image_monitor_watch(Evas_Cache_Image *cache, Image_Entry *im)
+{
+   Evas_Cache_Image_Monitor *mon = cache->monitor;
+   const char *file;
+   int wd;
+
+   if ((!mon) || (!im->file)) return;
+   if (eina_hash_find(mon->files, im->file)) return;
+   wd = inotify_add_watch(mon->fd, im->file, MONITOR_EVENTS);
+   /* another path to an already watched file is only revalidated by the
+    * interval */
+   if ((wd < 0) || (eina_hash_find(mon->watches, &wd))) return;
+   file = eina_stringshare_ref(im->file);
+   eina_hash_add(mon->watches, &wd, file);
+   eina_hash_add(mon->files, file, (void *)(intptr_t)wd);
+}
+#else
+static void
+_evas_cache_image_monitor_new(Evas_Cache_Image *cache EINA_UNUSED)
+{
+}
+
+static void
+_evas_cache_image_monitor_free(Evas_Cache_Image *cache EINA_UNUSED)
+{
+}
+
+static void
+_evas_cache_image_monitor_watch(Evas_Cache_Image *cache EINA_UNUSED, Image_Entry *im EINA_UNUSED)
+{
+}
+#endif
+
+EAPI void
+evas_cache_image_revalidate_set(Evas_Cache_Image *cache, double interval)
+{
+   if (!cache) return;
+   if (interval < 0.0) interval = 0.0;
+   cache->revalidate = interval;
+   if (interval > 0.0) _evas_cache_image_monitor_new(cache);
+   else _evas_cache_image_monitor_free(cache);
+}
+
+/* for the file monitors the cache doesn't have: the next request of file
+ * checks it on disk whatever the revalidation interval */
+EAPI void
+evas_cache_image_file_invalidate(Evas_Cache_Image *cache, const char *file)
+{
+   const char *sfile;
+
+   if ((!cache) || (!file)) return;
+   sfile = eina_stringshare_add(file);
+   SLKL(engine_lock);
+   _evas_cache_image_file_invalidate(cache, sfile);
+   SLKU(engine_lock);
+   eina_stringshare_del(sfile);
+}
+
+EAPI void
+evas_cache_image_stats_get(Evas_Cache_Image *cache, unsigned int *hits,
+                           unsigned int *misses, unsigned int *stats)
+{
+   if (hits) *hits = cache ? cache->counters.hits : 0;
+   if (misses) *misses = cache ? cache->counters.misses : 0;
+   if (stats) *stats = cache ? cache->counters.stats : 0;
+}
+
+static unsigned int
+_evas_cache_image_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof (Image_Entry_Key);
+}
+
+static int
+_evas_cache_image_key_cmp(const void *key1, int key1_length EINA_UNUSED,
+                          const void *key2, int key2_length EINA_UNUSED)
+{
+   const Image_Entry_Key *k1 = key1;
+   const Image_Entry_Key *k2 = key2;
+   int r;
+
+   if (k1->file_len != k2->file_len)
+     return (int)k1->file_len - (int)k2->file_len;
+   if (k1->key_len != k2->key_len)
+     return (int)k1->key_len - (int)k2->key_len;
+   r = memcmp(&k1->opts, &k2->opts, sizeof (k1->opts));
+   if (r) return r;
+   if (k1->file != k2->file)
+     {
+        r = memcmp(k1->file, k2->file, k1->file_len);
+        if (r) return r;
+     }
+   if ((k1->key_len) && (k1->key != k2->key))
+     return memcmp(k1->key, k2->key, k1->key_len);
+   return 0;
+}
+
+static int
+_evas_cache_image_key_hash(const void *key, int key_length EINA_UNUSED)
+{
+   const Image_Entry_Key *k = key;
+   int r;
+
+   r = eina_hash_superfast(k->file, k->file_len);
+   if (k->key_len)
+     r = (r * 31) ^ eina_hash_superfast(k->key, k->key_len);
+   r = (r * 31) ^ eina_hash_superfast((const char *)&k->opts, sizeof (k->opts));
+   return r;
+}
+
 EAPI Evas_Cache_Image *
 evas_cache_image_init(const Evas_Cache_Image_Func *cb)
 {
    Evas_Cache_Image *cache;
+   const char *s;
 
    if (_evas_cache_mutex_init++ == 0)
      {
@@ -586,11 +859,20 @@ evas_cache_image_init(const Evas_Cache_Image_Func *cb)
    cache = calloc(1, sizeof(Evas_Cache_Image));
    if (!cache) return NULL;
    cache->func = *cb;
-   cache->inactiv = eina_hash_string_superfast_new(NULL);
-   cache->activ = eina_hash_string_superfast_new(NULL);
+   cache->inactiv = eina_hash_new(EINA_KEY_LENGTH(_evas_cache_image_key_length),
+                                  EINA_KEY_CMP(_evas_cache_image_key_cmp),
+                                  EINA_KEY_HASH(_evas_cache_image_key_hash),
+                                  NULL, 8);
+   cache->activ = eina_hash_new(EINA_KEY_LENGTH(_evas_cache_image_key_length),
+                                EINA_KEY_CMP(_evas_cache_image_key_cmp),
+                                EINA_KEY_HASH(_evas_cache_image_key_hash),
+                                NULL, 8);
    cache->mmap_activ = eina_hash_string_superfast_new(NULL);
    cache->mmap_inactiv = eina_hash_string_superfast_new(NULL);
    cache->references = 1;
+   /* seconds during which a file is trusted without stat()ing it again */
+   s = getenv("EVAS_IMAGE_CACHE_REVALIDATE");
+   if (s) evas_cache_image_revalidate_set(cache, atof(s));
    return cache;
 }
 
@@ -662,6 +944,7 @@ evas_cache_image_shutdown(Evas_Cache_Image *cache)
           }
      }
 
+   _evas_cache_image_monitor_free(cache);
    eina_hash_free(cache->activ);
    eina_hash_free(cache->inactiv);
    eina_hash_free(cache->mmap_activ);
@@ -693,20 +976,46 @@ static const Evas_Image_Load_Opts prevent = {
    EINA_FALSE
 };
 
+static Eina_Bool
+_evas_cache_image_loadopts_empty(const Evas_Image_Load_Opts *lo)
+{
+   return ((!lo) ||
+           ((lo->emile.scale_down_by == 0) &&
+            (EINA_DBL_EQ(lo->emile.dpi, 0.0)) &&
+            ((lo->emile.w == 0) || (lo->emile.h == 0)) &&
+            ((lo->emile.region.w == 0) || (lo->emile.region.h == 0)) &&
+            (lo->emile.orientation == 0)));
+}
+
+static void
+_evas_cache_image_loadopts_key(Image_Entry_Key *ekey, Evas_Image_Load_Opts **plo)
+{
+   Evas_Image_Load_Opts *lo = *plo;
+
+   memset(&ekey->opts, 0, sizeof (ekey->opts));
+   if (_evas_cache_image_loadopts_empty(lo))
+     {
+        *plo = (Evas_Image_Load_Opts*) &prevent;
+        return;
+     }
+   ekey->opts.dpi = lo->emile.dpi;
+   ekey->opts.scale_down_by = lo->emile.scale_down_by;
+   ekey->opts.w = lo->emile.w;
+   ekey->opts.h = lo->emile.h;
+   ekey->opts.region_x = lo->emile.region.x;
+   ekey->opts.region_y = lo->emile.region.y;
+   ekey->opts.region_w = lo->emile.region.w;
+   ekey->opts.region_h = lo->emile.region.h;
+   ekey->opts.orientation = !!lo->emile.orientation;
+}
+
 static size_t
 _evas_cache_image_loadopts_append(char *hkey, Evas_Image_Load_Opts **plo)
 {
    Evas_Image_Load_Opts *lo = *plo;
    size_t offset = 0;
 
-   if ((!lo) ||
-       (lo &&
-           (lo->emile.scale_down_by == 0) &&
-           (EINA_DBL_EQ(lo->emile.dpi, 0.0)) &&
-           ((lo->emile.w == 0) || (lo->emile.h == 0)) &&
-           ((lo->emile.region.w == 0) || (lo->emile.region.h == 0)) &&
-           (lo->emile.orientation == 0)
-       ))
+   if (_evas_cache_image_loadopts_empty(lo))
      {
         *plo = (Evas_Image_Load_Opts*) &prevent;
      }
@@ -834,7 +1143,7 @@ evas_cache_image_mmap_request(Evas_Cache_Image *cache,
           }
      }
 
-   im = _evas_cache_image_entry_new(cache, hkey, NULL, f, NULL, key, lo, error);
+   im = _evas_cache_image_entry_new(cache, hkey, NULL, NULL, f, NULL, key, lo, error);
    if (!im)
      {
         SLKU(engine_lock);
@@ -849,6 +1158,35 @@ evas_cache_image_mmap_request(Evas_Cache_Image *cache,
 }
 
 
+/* check that im still matches what is on disk, stat()ing the file at most
+ * once per request and not at all if it was checked less than
+ * cache->revalidate seconds ago */
+static Eina_Bool
+_evas_cache_image_entry_file_valid(Evas_Cache_Image *cache, Image_Entry *im,
+                                   const char *file, struct stat *st,
+                                   int *stat_done, int *stat_failed,
+                                   double now)
+{
+   if ((cache->revalidate > 0.0) && (im->validated > 0.0) &&
+       ((now - im->validated) < cache->revalidate))
+     return EINA_TRUE;
+   if (!*stat_done)
+     {
+        *stat_done = 1;
+        cache->counters.stats++;
+        if (stat(file, st) < 0)
+          {
+             *stat_failed = 1;
+             return EINA_FALSE;
+          }
+     }
+   else if (*stat_failed) return EINA_FALSE;
+   if (!_timestamp_compare(&(im->tstamp), st)) return EINA_FALSE;
+   im->validated = now;
+   _evas_cache_image_monitor_watch(cache, im);
+   return EINA_TRUE;
+}
+
 EAPI Image_Entry *
 evas_cache_image_request(Evas_Cache_Image *cache, const char *file, 
                          const char *key, Evas_Image_Load_Opts *lo, int *error)
@@ -856,6 +1194,7 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
    const char           *ckey = "(null)";
    char                 *hkey;
    Image_Entry          *im;
+   Image_Entry_Key       ekey;
    size_t                size;
    int                   stat_done = 0, stat_failed = 0;
    size_t                file_length;
@@ -864,6 +1203,7 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
    Image_Timestamp       tstamp;
    Eina_Bool             skip = lo->skip_head;
    Evas_Image_Load_Opts  tlo;
+   double                now = 0.0;
 
    if (!file)
      {
@@ -871,40 +1211,28 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
         return NULL;
      }
 
-   /* generate hkey from file+key+load opts */
-   file_length = strlen(file);
-   key_length = key ? strlen(key) : 6;
-   size = file_length + key_length + 132;
-   hkey = alloca(sizeof (char) * size);
-   memcpy(hkey, file, file_length);
-   size = file_length;
-   memcpy(hkey + size, "//://", 5);
-   size += 5;
-   if (key) ckey = key;
-   memcpy(hkey + size, ckey, key_length);
-   size += key_length;
-   size += _evas_cache_image_loadopts_append(hkey + size, &lo);
+   /* lookup key from file+key+load opts, the string one is only needed
+    * when a new entry is created */
+   ekey.file = file;
+   ekey.file_len = strlen(file);
+   ekey.key = key;
+   ekey.key_len = key ? strlen(key) : 0;
+   _evas_cache_image_loadopts_key(&ekey, &lo);
    tlo = *lo;
    tlo.skip_head = skip;
+   if ((!skip) && (cache->revalidate > 0.0))
+     now = _evas_cache_image_time_get();
 
    /* find image by key in active hash */
    SLKL(engine_lock);
-   im = eina_hash_find(cache->activ, hkey);
+   im = eina_hash_find(cache->activ, &ekey);
    if ((im) && (!im->load_failed))
      {
-        int ok = 1;
-
-        stat_done = 1;
-        if (!skip)
-          {
-             if (stat(file, &st) < 0)
-               {
-                  stat_failed = 1;
-                  ok = 0;
-               }
-             else if (!_timestamp_compare(&(im->tstamp), &st)) ok = 0;
-          }
-        if (ok) goto on_ok;
+        if ((skip) ||
+            (_evas_cache_image_entry_file_valid(cache, im, file, &st,
+                                                &stat_done, &stat_failed,
+                                                now)))
+          goto on_hit;
         /* image we found doesn't match what's on disk (stat info wise)
          * so dirty the active cache entry so we never find it again. this
          * also implicitly guarantees that we only have 1 active copy
@@ -920,32 +1248,18 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
      }
 
    /* find image by key in inactive/lru hash */
-   im = eina_hash_find(cache->inactiv, hkey);
+   im = eina_hash_find(cache->inactiv, &ekey);
    if ((im) && (!im->load_failed))
      {
-        int ok = 1;
-
-        if (!skip)
-          {
-             if (!stat_done)
-               {
-                  stat_done = 1;
-                  if (stat(file, &st) < 0)
-                    {
-                       stat_failed = 1;
-                       ok = 0;
-                    }
-                  else if (!_timestamp_compare(&(im->tstamp), &st)) ok = 0;
-               }
-             else if (!_timestamp_compare(&(im->tstamp), &st)) ok = 0;
-          }
-
-        if (ok)
+        if ((skip) ||
+            (_evas_cache_image_entry_file_valid(cache, im, file, &st,
+                                                &stat_done, &stat_failed,
+                                                now)))
           {
              /* remove from lru and make it active again */
              _evas_cache_image_lru_del(im);
              _evas_cache_image_activ_add(im);
-             goto on_ok;
+             goto on_hit;
           }
         /* as active cache find - if we match in lru and its invalid, dirty */
         _evas_cache_image_dirty_add(im);
@@ -961,26 +1275,50 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file,
         _evas_cache_image_entry_delete(cache, im);
         im = NULL;
      }
+   cache->counters.misses++;
    if (stat_failed) goto on_stat_error;
 
+   /* generate hkey from file+key+load opts */
+   file_length = ekey.file_len;
+   key_length = key ? ekey.key_len : 6;
+   size = file_length + key_length + 132;
+   hkey = alloca(sizeof (char) * size);
+   memcpy(hkey, file, file_length);
+   size = file_length;
+   memcpy(hkey + size, "//://", 5);
+   size += 5;
+   if (key) ckey = key;
+   memcpy(hkey + size, ckey, key_length);
+   size += key_length;
+   size += _evas_cache_image_loadopts_append(hkey + size, &lo);
+
    if (!skip)
      {
         if (!stat_done)
           {
+             cache->counters.stats++;
              if (stat(file, &st) < 0) goto on_stat_error;
           }
         _timestamp_build(&tstamp, &st);
-        im = _evas_cache_image_entry_new(cache, hkey, &tstamp, NULL,
+        im = _evas_cache_image_entry_new(cache, hkey, &ekey, &tstamp, NULL,
                                          file, key, &tlo, error);
+        if (im)
+          {
+             im->validated = now;
+             _evas_cache_image_monitor_watch(cache, im);
+          }
      }
    else
      {
-        im = _evas_cache_image_entry_new(cache, hkey, NULL, NULL,
+        im = _evas_cache_image_entry_new(cache, hkey, &ekey, NULL, NULL,
                                          file, key, &tlo, error);
      }
    if (!im) goto on_stat_error;
    if (cache->func.debug) cache->func.debug("request", im);
+   goto on_ok;
 
+on_hit:
+   cache->counters.hits++;
 on_ok:
    *error = EVAS_LOAD_ERROR_NONE;
 ////   SLKL(im->lock);
@@ -1166,7 +1504,7 @@ evas_cache_image_copied_data(Evas_Cache_Image *cache,
      w &= ~0x1;
 
    SLKL(engine_lock);
-   im = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, &err);
+   im = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &err);
    SLKU(engine_lock);
    if (!im) return NULL;
    im->space = cspace;
@@ -1199,7 +1537,7 @@ evas_cache_image_data(Evas_Cache_Image *cache, unsigned int w, unsigned int h,
      w &= ~0x1;
 
    SLKL(engine_lock);
-   im = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, &err);
+   im = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &err);
    SLKU(engine_lock);
    if (!im) return NULL;
    im->w = w;
@@ -1254,7 +1592,7 @@ evas_cache_image_size_set(Image_Entry *im, unsigned int w, unsigned int h)
 
    cache = im->cache;
    SLKL(engine_lock);
-   im2 = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, &error);
+   im2 = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &error);
    SLKU(engine_lock);
    if (!im2) goto on_error;
 
@@ -1494,6 +1832,10 @@ _dump_cache(Evas_Cache_Image *cache)
    printf("cache: %ikb / %ikb\n",
           cache->usage / 1024,
           cache->limit / 1024);
+   printf("hits: %u, misses: %u, stats: %u\n",
+          cache->counters.hits,
+          cache->counters.misses,
+          cache->counters.stats);
    printf("................................................................\n");
    total = 0;
    SLKL(engine_lock);
@@ -1552,7 +1894,7 @@ evas_cache_image_empty(Evas_Cache_Image *cache)
 
    if (!cache) return NULL;
    SLKL(engine_lock);
-   im = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, &err);
+   im = _evas_cache_image_entry_new(cache, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &err);
    SLKU(engine_lock);
    if (!im) return NULL;
    im->references = 1;
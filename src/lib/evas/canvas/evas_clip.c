@@ -7,7 +7,8 @@ void
 evas_object_clip_dirty_do(Evas_Object_Protected_Data *obj)
 {
    Evas_Object_Protected_Data *clipee;
-   Eina_List *l;
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int i;
 
    EINA_COW_STATE_WRITE_BEGIN(obj, state_write, cur)
      {
@@ -15,7 +16,7 @@ evas_object_clip_dirty_do(Evas_Object_Protected_Data *obj)
      }
    EINA_COW_STATE_WRITE_END(obj, state_write, cur);
 
-   EINA_LIST_FOREACH(obj->clip.clipees, l, clipee)
+   EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, clipee)
      {
         evas_object_clip_dirty(clipee->object, clipee);
      }
@@ -25,13 +26,14 @@ void
 evas_object_recalc_clippees(Evas_Object_Protected_Data *obj)
 {
    Evas_Object_Protected_Data *clipee;
-   Eina_List *l;
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int i;
 
    EVAS_OBJECT_DATA_VALID_CHECK(obj);
    if (obj->cur->cache.clip.dirty)
      {
         evas_object_clip_recalc(obj);
-        EINA_LIST_FOREACH(obj->clip.clipees, l, clipee)
+        EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, clipee)
           {
              evas_object_recalc_clippees(clipee);
           }
@@ -116,9 +118,10 @@ evas_object_child_map_across_mark(Evas_Object *eo_obj, Evas_Object_Protected_Dat
         else if (obj->clip.clipees)
           {
              Evas_Object_Protected_Data *obj2;
-             Eina_List *l;
+             Eina_Chunk_List_Chunk *chunk;
+             unsigned int i;
 
-             EINA_LIST_FOREACH(obj->clip.clipees, l, obj2)
+             EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, obj2)
                {
                   evas_object_child_map_across_mark(obj2->object, obj2,
                                                     map_obj, force, visited);
@@ -146,7 +149,8 @@ evas_object_clip_across_clippees_check(Evas_Object *eo_obj, Evas_Object_Protecte
 {
 #ifdef MAP_ACROSS
    Evas_Object_Protected_Data *obj2;
-   Eina_List *l;
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int i;
 
    if (!obj->clip.clipees) return;
 // schloooooooooooow:
@@ -156,7 +160,7 @@ evas_object_clip_across_clippees_check(Evas_Object *eo_obj, Evas_Object_Protecte
                                     NULL);
    if (obj->cur->cache.clip.dirty)
      {
-	EINA_LIST_FOREACH(obj->clip.clipees, l, obj2)
+	EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, obj2)
           {
              evas_object_clip_across_clippees_check(obj2->object, obj2);
           }
@@ -262,9 +266,11 @@ _efl_canvas_object_clipper_unset_common(Evas_Object_Protected_Data *obj, Eina_Bo
    if (EVAS_OBJECT_DATA_VALID(clip))
      {
         clip->clip.cache_clipees_answer = eina_list_free(clip->clip.cache_clipees_answer);
-        clip->clip.clipees = eina_list_remove(clip->clip.clipees, obj);
-        if (!clip->clip.clipees)
+        if (obj->clip.clipee_item)
+          eina_chunk_list_remove(clip->clip.clipees_list, obj->clip.clipee_item);
+        if (!eina_chunk_list_count(clip->clip.clipees_list))
           {
+             clip->clip.clipees = NULL;
              EINA_COW_STATE_WRITE_BEGIN(clip, state_write, cur)
                {
                   state_write->have_clipees = 0;
@@ -305,6 +311,7 @@ _efl_canvas_object_clipper_unset_common(Evas_Object_Protected_Data *obj, Eina_Bo
           efl_event_callback_del(clip->object, EFL_EVENT_INVALIDATE, _clipper_invalidated_cb, obj->object);
      }
 
+   obj->clip.clipee_item = NULL;
    EINA_COW_STATE_WRITE_BEGIN(obj, state_write, cur)
      state_write->clipper = NULL;
    EINA_COW_STATE_WRITE_END(obj, state_write, cur);
@@ -377,9 +384,13 @@ _efl_canvas_object_clipper_set(Eo *eo_obj, Evas_Object_Protected_Data *obj, Evas
      efl_event_callback_add(clip->object, EFL_EVENT_INVALIDATE, _clipper_invalidated_cb, eo_obj);
 
    clip->clip.cache_clipees_answer = eina_list_free(clip->clip.cache_clipees_answer);
-   clip->clip.clipees = eina_list_append(clip->clip.clipees, obj);
-   if (clip->clip.clipees)
+   if (!clip->clip.clipees_list)
+     clip->clip.clipees_list = eina_chunk_list_new();
+   if (clip->clip.clipees_list)
+     obj->clip.clipee_item = eina_chunk_list_append(clip->clip.clipees_list, obj);
+   if (obj->clip.clipee_item)
      {
+        clip->clip.clipees = clip->clip.clipees_list;
         EINA_COW_STATE_WRITE_BEGIN(clip, state_write, cur)
           {
              state_write->have_clipees = 1;
@@ -505,13 +516,14 @@ EAPI const Eina_List *
 evas_object_clipees_get(const Evas_Object *eo_obj)
 {
    const Evas_Object_Protected_Data *tmp;
-   Eina_List *l;
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int i;
    Eina_List *answer = NULL;
 
    Evas_Object_Protected_Data *obj = EVAS_OBJ_GET_OR_RETURN(eo_obj, NULL);
    obj->clip.cache_clipees_answer = eina_list_free(obj->clip.cache_clipees_answer);
 
-   EINA_LIST_FOREACH(obj->clip.clipees, l, tmp)
+   EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, tmp)
      answer = eina_list_append(answer, tmp->object);
 
    obj->clip.cache_clipees_answer = answer;
@@ -528,7 +540,6 @@ evas_object_clipees_has(const Evas_Object *eo_obj)
 typedef struct
 {
    Eina_Iterator  iterator;
-   Eina_List     *list;
    Eina_Iterator *real_iterator;
    Evas_Object   *object;
 } Clipee_Iterator;
@@ -568,8 +579,7 @@ _efl_canvas_object_clipped_objects_get(const Eo *eo_obj, Evas_Object_Protected_D
 
    EINA_MAGIC_SET(&it->iterator, EINA_MAGIC_ITERATOR);
 
-   it->list = obj->clip.clipees;
-   it->real_iterator = eina_list_iterator_new(it->list);
+   it->real_iterator = eina_chunk_list_iterator_new(obj->clip.clipees);
    it->iterator.version = EINA_ITERATOR_VERSION;
    it->iterator.next = FUNC_ITERATOR_NEXT(_clipee_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(_clipee_iterator_get_container);
@@ -582,7 +592,7 @@ _efl_canvas_object_clipped_objects_get(const Eo *eo_obj, Evas_Object_Protected_D
 EOLIAN unsigned int
 _efl_canvas_object_clipped_objects_count(Eo *eo_obj EINA_UNUSED, Evas_Object_Protected_Data *obj)
 {
-   return eina_list_count(obj->clip.clipees);
+   return eina_chunk_list_count(obj->clip.clipees);
 }
 
 EOLIAN void
@@ -313,6 +313,8 @@ list_free(void *list)
 EOLIAN static Eo *
 _evas_canvas_efl_object_constructor(Eo *eo_obj, Evas_Public_Data *e)
 {
+   const char *s;
+
    eo_obj = efl_constructor(efl_super(eo_obj, MY_CLASS));
 
    e->evas = eo_obj;
@@ -325,6 +327,8 @@ _evas_canvas_efl_object_constructor(Eo *eo_obj, Evas_Public_Data *e)
    e->framespace.h = 0;
    e->hinting = EVAS_FONT_HINTING_BYTECODE;
    e->current_event = EVAS_CALLBACK_LAST;
+   s = getenv("EVAS_RENDER_SUBTREE_CULL");
+   e->subtree_cull = (s) && (atoi(s) > 0);
    e->name_hash = eina_hash_string_superfast_new(list_free);
    eina_clist_init(&e->calc_list);
    eina_clist_init(&e->calc_done);
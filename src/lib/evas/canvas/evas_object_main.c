@@ -496,8 +496,9 @@ evas_object_free(Evas_Object_Protected_Data *obj, Eina_Bool clean_layer)
           }
      }
    if (!was_smart_child) evas_object_release(eo_obj, obj, !!clean_layer);
-   if (obj->clip.clipees)
-     obj->clip.clipees = eina_list_free(obj->clip.clipees);
+   eina_chunk_list_free(obj->clip.clipees_list);
+   obj->clip.clipees_list = NULL;
+   obj->clip.clipees = NULL;
    obj->clip.cache_clipees_answer = eina_list_free(obj->clip.cache_clipees_answer);
    evas_object_clip_changes_clean(obj);
    evas_object_event_callback_all_del(eo_obj);
@@ -558,7 +559,10 @@ evas_object_change(Evas_Object *eo_obj EINA_UNUSED, Evas_Object_Protected_Data *
    /* set changed flag on all objects this one clips too */
    if (!((movch) && (obj->is_static_clip)))
      {
-        EINA_LIST_FOREACH(obj->clip.clipees, l, obj2)
+        Eina_Chunk_List_Chunk *chunk;
+        unsigned int i;
+
+        EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, obj2)
           {
              evas_object_change(obj2->object, obj2);
           }
@@ -1144,13 +1148,13 @@ _efl_canvas_object_efl_object_destructor(Eo *eo_obj, Evas_Object_Protected_Data
    if (obj->clip.clipees)
      {
         ERR("object %p of type '%s' still has %d clippees after del callback",
-            eo_obj, efl_class_name_get(eo_obj), eina_list_count(obj->clip.clipees));
+            eo_obj, efl_class_name_get(eo_obj), eina_chunk_list_count(obj->clip.clipees));
         /* "while" should be used for null check of obj->clip.clipees,
            because evas_objct_clip_unset can set null to obj->clip.clipees */
         while (obj->clip.clipees)
           {
              Evas_Object_Protected_Data *tmp;
-             tmp = eina_list_data_get(obj->clip.clipees);
+             tmp = eina_chunk_list_first_get(obj->clip.clipees);
              evas_object_clip_unset(tmp->object);
           }
      }
@@ -1294,10 +1298,11 @@ _efl_canvas_object_efl_gfx_entity_size_set(Eo *eo_obj, Evas_Object_Protected_Dat
 
    if (obj->cur->have_clipees)
      {
-        const Eina_List *l;
         Evas_Object_Protected_Data *clipee;
+        Eina_Chunk_List_Chunk *chunk;
+        unsigned int i;
 
-        EINA_LIST_FOREACH(obj->clip.clipees, l, clipee)
+        EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, clipee)
           {
              if (clipee->cur->has_fixed_size)
                ERR("resizing static clipper! this is a bug!!!!");
@@ -406,7 +406,8 @@ _evas_mask_redraw_set(Evas_Public_Data *e EINA_UNUSED,
                       Evas_Object_Protected_Data *obj)
 {
    Evas_Object_Protected_Data *clippee;
-   Eina_List *l;
+   Eina_Chunk_List_Chunk *chunk;
+   unsigned int i;
 
    if (!(obj->mask->redraw))
      {
@@ -423,7 +424,7 @@ _evas_mask_redraw_set(Evas_Public_Data *e EINA_UNUSED,
         EINA_COW_STATE_WRITE_END(obj, state_write, cur);
      }
 
-   EINA_LIST_FOREACH(obj->clip.clipees, l, clippee)
+   EINA_CHUNK_LIST_FOREACH(obj->clip.clipees, chunk, i, clippee)
      {
         evas_object_clip_recalc(clippee);
      }
@@ -1091,6 +1092,7 @@ _evas_render_phase1_object_process(Phase1_Context *p1ctx,
    Eina_Bool clean_them = EINA_FALSE;
    Eina_Bool map, hmap, can_map, map_not_can_map, obj_changed, is_active;
    Evas_Object *eo_obj = obj->object;
+   int active_idx = -1;
 
    EINA_PREFETCH(&(obj->cur->clipper));
 
@@ -1105,6 +1107,10 @@ _evas_render_phase1_object_process(Phase1_Context *p1ctx,
 
    obj_changed = obj->changed;
 
+   /* Nothing walks the clipees while rendering, give back what their
+    * removal left behind. */
+   if (obj->clip.clipees_list) eina_chunk_list_compact(obj->clip.clipees_list);
+
    if (obj->is_static_clip) goto done;
 
    //Need pre render for the children of mapped object.
@@ -1146,7 +1152,8 @@ _evas_render_phase1_object_process(Phase1_Context *p1ctx,
           }
 #endif
         ent.obj = obj;
-        eina_inarray_push(p1ctx->active_objects, &ent);
+        ent.subtree_len = 0;
+        active_idx = eina_inarray_push(p1ctx->active_objects, &ent);
      }
    if (is_active && obj->cur->snapshot && !obj->delete_me &&
        evas_object_is_visible(obj))
@@ -1235,6 +1242,13 @@ _evas_render_phase1_object_process(Phase1_Context *p1ctx,
    if (!is_active) obj->restack = EINA_FALSE;
    RD(level, "---]\n");
 done:
+   if ((active_idx >= 0) && obj->is_smart)
+     {
+        Evas_Active_Entry *ent;
+
+        ent = eina_inarray_nth(p1ctx->active_objects, active_idx);
+        ent->subtree_len = p1ctx->active_objects->len - active_idx - 1;
+     }
    if (obj_changed) obj->no_change_render = 0;
    else
      {
@@ -2807,6 +2821,66 @@ _cb_always_call(Evas *eo_e, Evas_Public_Data *e, Evas_Callback_Type type, void *
    for (i = 0; i < freeze_num; i++) efl_event_freeze(eo_e);
 }
 
+static inline void
+_evas_render_rect_union(Eina_Rectangle *dst, const Eina_Rectangle *src)
+{
+   if ((dst->w <= 0) || (dst->h <= 0)) *dst = *src;
+   else eina_rectangle_union(dst, src);
+}
+
+/* Compute the area covered by the subtree of every smart object in the active
+ * list, so that the render of an update region can jump over the subtrees
+ * that are completely outside of it instead of testing every member. Walking
+ * the list backward, the subtrees of all the members of a smart object are
+ * already known when reaching it. */
+static void
+_evas_render_active_subtrees_update(Evas_Public_Data *evas)
+{
+   int i;
+
+   for (i = (int)evas->active_objects.len - 1; i >= 0; i--)
+     {
+        Evas_Active_Entry *ent = eina_inarray_nth(&evas->active_objects, i);
+        unsigned int j, end;
+
+        if (!ent->subtree_len) continue;
+
+        ent->subtree_rect.x = ent->subtree_rect.y = 0;
+        ent->subtree_rect.w = ent->subtree_rect.h = 0;
+        end = i + ent->subtree_len;
+        for (j = i + 1; j <= end; )
+          {
+             Evas_Active_Entry *child = eina_inarray_nth(&evas->active_objects, j);
+             const Eina_Rectangle clip = {
+                child->obj->cur->cache.clip.x, child->obj->cur->cache.clip.y,
+                child->obj->cur->cache.clip.w, child->obj->cur->cache.clip.h
+             };
+
+             if ((clip.w > 0) && (clip.h > 0))
+               _evas_render_rect_union(&ent->subtree_rect, &clip);
+             if (child->subtree_len)
+               _evas_render_rect_union(&ent->subtree_rect, &child->subtree_rect);
+             j += child->subtree_len + 1;
+          }
+     }
+}
+
+static inline Eina_Bool
+_evas_render_active_subtree_skip(const Evas_Active_Entry *ent,
+                                 int x, int y, int w, int h)
+{
+   const Evas_Object_Protected_Data *obj = ent->obj;
+
+   if (!ent->subtree_len) return EINA_FALSE;
+   // A mapped smart object renders its members itself, and a mask may
+   // still need to be rendered for the members
+   if (_evas_render_has_map((Evas_Object_Protected_Data *)obj)) return EINA_FALSE;
+   if (obj->clip.mask) return EINA_FALSE;
+   return !RECTS_INTERSECT(x, y, w, h,
+                           ent->subtree_rect.x, ent->subtree_rect.y,
+                           ent->subtree_rect.w, ent->subtree_rect.h);
+}
+
 #ifndef INLINE_ACTIVE_GEOM
 static inline Eina_Bool
 _is_obj_in_rect(Evas_Object *eo_obj, Evas_Object_Protected_Data *obj,
@@ -3025,6 +3099,16 @@ evas_render_updates_internal_loop(Evas *eo_e, Evas_Public_Data *evas,
 
         if (obj == top) break;
 
+        /* skip whole smart subtrees out of the update, unless rendering
+           a snapshot as it has to stop at its own entry */
+        if (evas->subtree_cull && !top &&
+            _evas_render_active_subtree_skip(ent, ux - fx, uy - fy, uw, uh))
+          {
+             RD(level, "    SKIP SUBTREE: %s (%u objects)\n", RDNAME(obj), ent->subtree_len);
+             i += ent->subtree_len;
+             continue;
+          }
+
         /* if it's in our outpout rect and it doesn't clip anything */
         RD(level, "    OBJ: %s %i %i %ix%i\n", RDNAME(obj), obj->cur->geometry.x, obj->cur->geometry.y, obj->cur->geometry.w, obj->cur->geometry.h);
         if (
@@ -3504,6 +3588,9 @@ evas_render_updates_internal(Evas *eo_e,
                  out->geometry.x, out->geometry.y,
                  out->geometry.w, out->geometry.h);
 
+             if (e->subtree_cull)
+               _evas_render_active_subtrees_update(e);
+
              if (do_async) _evas_render_busy_begin();
              eina_evlog("+render_surface", eo_e, 0.0, NULL);
              while ((surface =
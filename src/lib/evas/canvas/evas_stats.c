@@ -47,3 +47,17 @@ EAPI void
 evas_cserve_disconnect(void)
 {
 }
+
+EAPI Eina_Bool
+evas_damage_stats_get(Evas_Damage_Stats *stats)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(stats, EINA_FALSE);
+   evas_common_tilebuf_stats_get(stats);
+   return EINA_TRUE;
+}
+
+EAPI void
+evas_damage_stats_reset(void)
+{
+   evas_common_tilebuf_stats_reset();
+}
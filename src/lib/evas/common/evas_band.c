@@ -0,0 +1,207 @@
+#include "evas_common_private.h"
+
+#include "Ecore.h"
+
+#define BAND_THREADS 3
+
+typedef struct _Evas_Band_Msg Evas_Band_Msg;
+typedef struct _Evas_Band_Worker Evas_Band_Worker;
+
+struct _Evas_Band_Msg
+{
+   Eina_Thread_Queue_Msg head;
+   Evas_Band_Func func;
+   void *band;
+};
+
+struct _Evas_Band_Worker
+{
+   Eina_Thread thread;
+   Eina_Thread_Queue *queue;
+};
+
+static LK(_band_lock);
+static Evas_Band_Worker _band_workers[BAND_THREADS];
+static Eina_Thread_Queue *_band_done_queue = NULL;
+static int _band_workers_count = -1; /* -1 until the first banded job */
+
+static void *
+_evas_common_band_worker(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Evas_Band_Worker *wk = data;
+   Evas_Band_Func func;
+   Evas_Band_Msg *msg;
+   void *band, *ref;
+
+   eina_thread_name_set(eina_thread_self(), "Evas-band");
+   do
+     {
+        func = NULL;
+        band = NULL;
+
+        msg = eina_thread_queue_wait(wk->queue, &ref);
+        if (msg)
+          {
+             func = msg->func;
+             band = msg->band;
+             eina_thread_queue_wait_done(wk->queue, ref);
+          }
+        if (func) func(band);
+
+        msg = eina_thread_queue_send(_band_done_queue, sizeof (Evas_Band_Msg), &ref);
+        msg->func = func;
+        msg->band = band;
+        eina_thread_queue_send_done(_band_done_queue, ref);
+     }
+   while (func);
+
+   return NULL;
+}
+
+static void
+_evas_common_band_workers_start(void)
+{
+   int i = 0;
+
+   _band_workers_count = 0;
+//Eina_Thread_Queue doesn't work on WIN32.
+#ifndef _WIN32
+   int count = eina_cpu_count() - 1;
+
+   if (count > BAND_THREADS) count = BAND_THREADS;
+   if (count <= 0) return;
+
+   _band_done_queue = eina_thread_queue_new();
+   if (EINA_UNLIKELY(!_band_done_queue))
+     {
+        ERR("Failed to create thread queue");
+        return;
+     }
+
+   for (i = 0; i < count; i++)
+     {
+        Evas_Band_Worker *wk = _band_workers + i;
+
+        wk->queue = eina_thread_queue_new();
+        if (EINA_UNLIKELY(!wk->queue))
+          {
+             ERR("Failed to create thread queue");
+             break;
+          }
+        if (!eina_thread_create(&wk->thread, EINA_THREAD_NORMAL, -1,
+                                _evas_common_band_worker, wk))
+          {
+             ERR("Failed to create band thread");
+             eina_thread_queue_free(wk->queue);
+             break;
+          }
+     }
+   if (!i)
+     {
+        eina_thread_queue_free(_band_done_queue);
+        _band_done_queue = NULL;
+     }
+#endif
+   _band_workers_count = i;
+}
+
+static void
+_evas_common_band_workers_stop(void)
+{
+   Evas_Band_Msg *msg;
+   void *ref;
+   int i;
+
+   for (i = 0; i < _band_workers_count; i++)
+     {
+        msg = eina_thread_queue_send(_band_workers[i].queue, sizeof (Evas_Band_Msg), &ref);
+        msg->func = NULL;
+        msg->band = NULL;
+        eina_thread_queue_send_done(_band_workers[i].queue, ref);
+
+        msg = eina_thread_queue_wait(_band_done_queue, &ref);
+        if (msg) eina_thread_queue_wait_done(_band_done_queue, ref);
+
+        eina_thread_join(_band_workers[i].thread);
+        eina_thread_queue_free(_band_workers[i].queue);
+     }
+   if (_band_done_queue) eina_thread_queue_free(_band_done_queue);
+   _band_done_queue = NULL;
+   _band_workers_count = -1;
+}
+
+static void
+_evas_common_band_fork_reset(void *data EINA_UNUSED)
+{
+   int i;
+
+   /* the workers did not survive the fork, start them again when needed */
+   for (i = 0; i < _band_workers_count; i++)
+     eina_thread_queue_free(_band_workers[i].queue);
+   if (_band_done_queue) eina_thread_queue_free(_band_done_queue);
+   _band_done_queue = NULL;
+   _band_workers_count = -1;
+}
+
+EAPI int
+evas_common_band_begin(void)
+{
+   /* another thread already runs a job on the workers */
+   if (LKT(_band_lock) != EINA_LOCK_SUCCEED) return 1;
+
+   if (_band_workers_count < 0) _evas_common_band_workers_start();
+   if (!_band_workers_count)
+     {
+        LKU(_band_lock);
+        return 1;
+     }
+   return _band_workers_count + 1;
+}
+
+EAPI void
+evas_common_band_run(Evas_Band_Func func, void **bands, int count)
+{
+   Evas_Band_Msg *msg;
+   void *ref;
+   int i;
+
+   if (count <= 0) return;
+   if (count > _band_workers_count + 1) count = _band_workers_count + 1;
+
+   for (i = 1; i < count; i++)
+     {
+        msg = eina_thread_queue_send(_band_workers[i - 1].queue, sizeof (Evas_Band_Msg), &ref);
+        msg->func = func;
+        msg->band = bands[i];
+        eina_thread_queue_send_done(_band_workers[i - 1].queue, ref);
+     }
+
+   func(bands[0]);
+
+   for (i = 1; i < count; i++)
+     {
+        msg = eina_thread_queue_wait(_band_done_queue, &ref);
+        if (msg) eina_thread_queue_wait_done(_band_done_queue, ref);
+     }
+}
+
+EAPI void
+evas_common_band_end(void)
+{
+   LKU(_band_lock);
+}
+
+EAPI void
+evas_common_band_init(void)
+{
+   LKI(_band_lock);
+   ecore_fork_reset_callback_add(_evas_common_band_fork_reset, NULL);
+}
+
+EAPI void
+evas_common_band_shutdown(void)
+{
+   ecore_fork_reset_callback_del(_evas_common_band_fork_reset, NULL);
+   _evas_common_band_workers_stop();
+   LKD(_band_lock);
+}
@@ -0,0 +1,29 @@
+#ifndef _EVAS_BAND_H
+#define _EVAS_BAND_H
+
+/* Band-parallel helper for the software converters and scalers: a job is
+ * cut in bands (usually of destination lines) that are independent of
+ * each other, the first one is run by the calling thread and the others
+ * by a small pool of worker threads started on first use.
+ *
+ *    count = evas_common_band_begin();
+ *    if (count > 1)
+ *      {
+ *         ... prepare at most count bands ...
+ *         evas_common_band_run(func, bands, n);
+ *         evas_common_band_end();
+ *      }
+ *    else
+ *      ... do it all in the calling thread ...
+ */
+typedef void (*Evas_Band_Func)(void *band);
+
+EAPI void evas_common_band_init     (void);
+EAPI void evas_common_band_shutdown (void);
+
+/* the number of bands that can run at once, the pool is held when > 1 */
+EAPI int  evas_common_band_begin    (void);
+EAPI void evas_common_band_run      (Evas_Band_Func func, void **bands, int count);
+EAPI void evas_common_band_end      (void);
+
+#endif /* _EVAS_BAND_H */
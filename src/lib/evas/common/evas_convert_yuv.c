@@ -5,6 +5,10 @@
 # include "evas_mmx.h"
 #endif
 
+#ifdef BUILD_NEON_INTRINSICS
+# include <arm_neon.h>
+#endif
+
 #ifdef HAVE_ALTIVEC_H
 # include <altivec.h>
 #ifdef CONFIG_DARWIN
@@ -31,6 +35,7 @@ static void _evas_yv12torgb_raster (unsigned char **yuv, unsigned char *rgb, int
 static void _evas_yuy2torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_nv12torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h);
+static inline void _evas_yuv2rgb_420_raster(unsigned char *yp1, unsigned char *yp2, unsigned char *up, unsigned char *vp, unsigned char *dp1, unsigned char *dp2);
 
 #define CRV    104595
 #define CBU    132251
@@ -152,6 +157,463 @@ static unsigned char _clip_lut[1024];
 
 static int initted = 0;
 
+/* The simd row kernels give the same pixels as the lookup tables of the
+ * C code: every table entry is (int)(d * f), so it is computed as
+ * n * |d| + ((|d| * k) >> 16) with the sign of d put back, n being the
+ * integer part of f and k a 0.16 fixed point fraction picked so that the
+ * result is exact for all the d of the table. The integer parts are 1 for
+ * luma and v in red, 0 for green and 2 for u in blue.
+ * In order: 1.164 (y), 1.596 (v), 0.391 (u), 0.813 (v), 2.018 (u) for
+ * bt601 and 1.164, 1.793, 0.213, 0.534, 2.115 for bt709. */
+static const unsigned short _coefs_601[5] = { 10746, 39063, 25631, 53264, 1175 };
+static const unsigned short _coefs_709[5] = { 10746, 51966, 13961, 34998, 7536 };
+
+/* nv12 is done in 16.16 fixed point by _evas_yuv2rgb_420_raster(), the
+ * whole sum is shifted once. The kernels take each constant as an integer
+ * part, applied with adds (1 for luma, 2 for v in red, -1 for v in green,
+ * 2 for u in blue), and the signed 16 bits remainder below. */
+static const short _coefs_nv12[5] =
+{
+   YMUL - (1 << BITRES),
+   CRV - (2 << BITRES),
+   (1 << BITRES) - CGV,
+   -CGU,
+   CBU - (2 << BITRES)
+};
+
+typedef int (*Evas_Yuv_420_Row_Func)(const DATA8 *yp1, const DATA8 *yp2, const DATA8 *up, const DATA8 *vp, DATA32 *dp1, DATA32 *dp2, int w, const unsigned short *coefs);
+typedef int (*Evas_Yuv_Nv12_Row_Func)(const DATA8 *yp1, const DATA8 *yp2, const DATA8 *uv, DATA32 *dp1, DATA32 *dp2, int w, const short *coefs);
+typedef int (*Evas_Yuv_422_Row_Func)(const DATA8 *yuyv, DATA32 *dp, int w, const unsigned short *coefs);
+
+static Evas_Yuv_420_Row_Func _yuv_420_row = NULL;
+static Evas_Yuv_Nv12_Row_Func _yuv_nv12_row = NULL;
+static Evas_Yuv_422_Row_Func _yuv_422_row = NULL;
+
+#ifdef BUILD_NEON_INTRINSICS
+/* same math as evas_convert_yuv_sse3.c, but luma is loaded as even and odd
+ * pixels so the chroma samples don't need to be duplicated */
+static inline int16x8_t
+_evas_yuv_mul_neon(int16x8_t d, uint16_t k, int n)
+{
+   int16x8_t m = vshrq_n_s16(d, 15);
+   int16x8_t a = vabsq_s16(d);
+   uint32x4_t lo = vmull_n_u16(vget_low_u16(vreinterpretq_u16_s16(a)), k);
+   uint32x4_t hi = vmull_n_u16(vget_high_u16(vreinterpretq_u16_s16(a)), k);
+   int16x8_t t;
+
+   t = vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+   for (; n > 0; n--) t = vaddq_s16(t, a);
+   return vsubq_s16(veorq_s16(t, m), m);
+}
+
+static inline int16x8_t
+_evas_yuv_widen_neon(uint8x8_t v, int16_t sub)
+{
+   return vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(sub));
+}
+
+static inline void
+_evas_yuv_chroma_neon(uint8x8_t u8, uint8x8_t v8, const unsigned short *coefs,
+                      int16x8_t *rv, int16x8_t *guv, int16x8_t *bu)
+{
+   int16x8_t u = _evas_yuv_widen_neon(u8, 128);
+   int16x8_t v = _evas_yuv_widen_neon(v8, 128);
+
+   *rv = _evas_yuv_mul_neon(v, coefs[1], 1);
+   *guv = vaddq_s16(_evas_yuv_mul_neon(u, coefs[2], 0),
+                    _evas_yuv_mul_neon(v, coefs[3], 0));
+   *bu = _evas_yuv_mul_neon(u, coefs[4], 2);
+}
+
+static inline void
+_evas_yuv_write16_neon(DATA32 *dp, int16x8_t re, int16x8_t ro,
+                       int16x8_t ge, int16x8_t go, int16x8_t be, int16x8_t bo)
+{
+   uint8x8x2_t r, g, b;
+   uint8x16x4_t px;
+
+   r = vzip_u8(vqmovun_s16(re), vqmovun_s16(ro));
+   g = vzip_u8(vqmovun_s16(ge), vqmovun_s16(go));
+   b = vzip_u8(vqmovun_s16(be), vqmovun_s16(bo));
+
+   px.val[0] = vcombine_u8(b.val[0], b.val[1]);
+   px.val[1] = vcombine_u8(g.val[0], g.val[1]);
+   px.val[2] = vcombine_u8(r.val[0], r.val[1]);
+   px.val[3] = vdupq_n_u8(0xff);
+   vst4q_u8((uint8_t *)dp, px);
+}
+
+static inline void
+_evas_yuv_store16_neon(DATA32 *dp, uint8x8x2_t y, int16x8_t rv,
+                       int16x8_t guv, int16x8_t bu, const unsigned short *coefs)
+{
+   int16x8_t ye, yo;
+
+   ye = _evas_yuv_mul_neon(_evas_yuv_widen_neon(y.val[0], 16), coefs[0], 1);
+   yo = _evas_yuv_mul_neon(_evas_yuv_widen_neon(y.val[1], 16), coefs[0], 1);
+
+   _evas_yuv_write16_neon(dp, vaddq_s16(ye, rv), vaddq_s16(yo, rv),
+                          vsubq_s16(ye, guv), vsubq_s16(yo, guv),
+                          vaddq_s16(ye, bu), vaddq_s16(yo, bu));
+}
+
+static int
+_evas_yuv_420_row_neon(const DATA8 *yp1, const DATA8 *yp2,
+                       const DATA8 *up, const DATA8 *vp,
+                       DATA32 *dp1, DATA32 *dp2,
+                       int w, const unsigned short *coefs)
+{
+   int xx;
+
+   for (xx = 0; xx < (w - 15); xx += 16)
+     {
+        int16x8_t rv, guv, bu;
+
+        _evas_yuv_chroma_neon(vld1_u8(up + (xx >> 1)), vld1_u8(vp + (xx >> 1)),
+                              coefs, &rv, &guv, &bu);
+
+        _evas_yuv_store16_neon(dp1 + xx, vld2_u8(yp1 + xx), rv, guv, bu, coefs);
+        _evas_yuv_store16_neon(dp2 + xx, vld2_u8(yp2 + xx), rv, guv, bu, coefs);
+     }
+
+   return xx;
+}
+
+/* nv12 follows the 16.16 math of _evas_yuv2rgb_420_raster(), see
+ * _coefs_nv12: (off + y * ky + x * kx + u * ku) >> 16 for 8 pixels */
+static inline int16x8_t
+_evas_yuv_q16_neon(int32_t off, int16x8_t y, int16_t ky, int16x8_t x,
+                   int16_t kx, int16x8_t u, int16_t ku)
+{
+   int32x4_t lo = vdupq_n_s32(off);
+   int32x4_t hi = vdupq_n_s32(off);
+
+   lo = vmlal_n_s16(lo, vget_low_s16(y), ky);
+   hi = vmlal_n_s16(hi, vget_high_s16(y), ky);
+   lo = vmlal_n_s16(lo, vget_low_s16(x), kx);
+   hi = vmlal_n_s16(hi, vget_high_s16(x), kx);
+   lo = vmlal_n_s16(lo, vget_low_s16(u), ku);
+   hi = vmlal_n_s16(hi, vget_high_s16(u), ku);
+   return vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16));
+}
+
+static inline void
+_evas_yuv_nv12_px8_neon(int16x8_t y, int16x8_t u, int16x8_t v,
+                        const short *coefs,
+                        int16x8_t *r, int16x8_t *g, int16x8_t *b)
+{
+   *r = vaddq_s16(vaddq_s16(y, vaddq_s16(v, v)),
+                  _evas_yuv_q16_neon(0, y, coefs[0], v, coefs[1], u, 0));
+   *g = vaddq_s16(vsubq_s16(y, v),
+                  _evas_yuv_q16_neon(OFF, y, coefs[0], v, coefs[2], u, coefs[3]));
+   *b = vaddq_s16(vaddq_s16(y, vaddq_s16(u, u)),
+                  _evas_yuv_q16_neon(OFF, y, coefs[0], u, coefs[4], u, 0));
+}
+
+static inline void
+_evas_yuv_nv12_store16_neon(DATA32 *dp, uint8x8x2_t y, int16x8_t u,
+                            int16x8_t v, const short *coefs)
+{
+   int16x8_t re, ro, ge, go, be, bo;
+
+   _evas_yuv_nv12_px8_neon(_evas_yuv_widen_neon(y.val[0], 16), u, v, coefs,
+                           &re, &ge, &be);
+   _evas_yuv_nv12_px8_neon(_evas_yuv_widen_neon(y.val[1], 16), u, v, coefs,
+                           &ro, &go, &bo);
+   _evas_yuv_write16_neon(dp, re, ro, ge, go, be, bo);
+}
+
+static int
+_evas_yuv_nv12_row_neon(const DATA8 *yp1, const DATA8 *yp2, const DATA8 *uv,
+                        DATA32 *dp1, DATA32 *dp2, int w, const short *coefs)
+{
+   int xx;
+
+   for (xx = 0; xx < (w - 15); xx += 16)
+     {
+        uint8x8x2_t c = vld2_u8(uv + xx);
+        int16x8_t u = _evas_yuv_widen_neon(c.val[0], 128);
+        int16x8_t v = _evas_yuv_widen_neon(c.val[1], 128);
+
+        _evas_yuv_nv12_store16_neon(dp1 + xx, vld2_u8(yp1 + xx), u, v, coefs);
+        _evas_yuv_nv12_store16_neon(dp2 + xx, vld2_u8(yp2 + xx), u, v, coefs);
+     }
+
+   return xx;
+}
+
+static int
+_evas_yuv_422_row_neon(const DATA8 *yuyv, DATA32 *dp, int w,
+                       const unsigned short *coefs)
+{
+   int xx;
+
+   for (xx = 0; xx < (w - 15); xx += 16)
+     {
+        int16x8_t rv, guv, bu;
+        uint8x8x4_t p;
+        uint8x8x2_t y;
+
+        /* y0 u y1 v */
+        p = vld4_u8(yuyv + (xx * 2));
+        _evas_yuv_chroma_neon(p.val[1], p.val[3], coefs, &rv, &guv, &bu);
+
+        y.val[0] = p.val[0];
+        y.val[1] = p.val[2];
+        _evas_yuv_store16_neon(dp + xx, y, rv, guv, bu, coefs);
+     }
+
+   return xx;
+}
+#endif
+
+/* scalar version of the simd math, for what is left at the end of a row */
+static inline int
+_evas_yuv_mul_fixed(int d, unsigned short k, int n)
+{
+   int a = (d < 0) ? -d : d;
+
+   a = (n * a) + ((a * k) >> 16);
+   return (d < 0) ? -a : a;
+}
+
+static inline void
+_evas_yuv_chroma_fixed(int u, int v, const unsigned short *coefs,
+                       int *rv, int *guv, int *bu)
+{
+   u -= 128;
+   v -= 128;
+
+   *rv = _evas_yuv_mul_fixed(v, coefs[1], 1);
+   *guv = _evas_yuv_mul_fixed(u, coefs[2], 0) + _evas_yuv_mul_fixed(v, coefs[3], 0);
+   *bu = _evas_yuv_mul_fixed(u, coefs[4], 2);
+}
+
+static inline DATA32
+_evas_yuv_px_fixed(int y, int rv, int guv, int bu, const unsigned short *coefs)
+{
+   y = _evas_yuv_mul_fixed(y - 16, coefs[0], 1);
+
+   return 0xff000000 + RGB_JOIN(LUT_CLIP(y + rv), LUT_CLIP(y - guv),
+                                LUT_CLIP(y + bu));
+}
+
+static void
+_evas_yuv_420torgb_simd(unsigned char **yuv, unsigned char *rgb, int w, int h,
+                        const unsigned short *coefs)
+{
+   int stride = w * sizeof (DATA32);
+   int xx, yy;
+
+   for (yy = 0; yy < (h - 1); yy += 2)
+     {
+        const DATA8 *yp1, *yp2, *up, *vp;
+        DATA32 *dp1, *dp2;
+
+        yp1 = yuv[yy];
+        yp2 = yuv[yy + 1];
+        up = yuv[h + (yy / 2)];
+        vp = yuv[h + (h / 2) + (yy / 2)];
+        dp1 = (DATA32 *)(rgb + (yy * stride));
+        dp2 = (DATA32 *)(rgb + ((yy + 1) * stride));
+
+        xx = _yuv_420_row(yp1, yp2, up, vp, dp1, dp2, w, coefs);
+        for (; xx < (w - 1); xx += 2)
+          {
+             int rv, guv, bu;
+
+             _evas_yuv_chroma_fixed(up[xx >> 1], vp[xx >> 1], coefs, &rv, &guv, &bu);
+             dp1[xx] = _evas_yuv_px_fixed(yp1[xx], rv, guv, bu, coefs);
+             dp1[xx + 1] = _evas_yuv_px_fixed(yp1[xx + 1], rv, guv, bu, coefs);
+             dp2[xx] = _evas_yuv_px_fixed(yp2[xx], rv, guv, bu, coefs);
+             dp2[xx + 1] = _evas_yuv_px_fixed(yp2[xx + 1], rv, guv, bu, coefs);
+          }
+     }
+}
+
+static void
+_evas_yv12torgb_simd(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   _evas_yuv_420torgb_simd(yuv, rgb, w, h, _coefs_601);
+}
+
+static void
+_evas_yv12_709torgb_simd(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   _evas_yuv_420torgb_simd(yuv, rgb, w, h, _coefs_709);
+}
+
+static void
+_evas_nv12torgb_simd(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   int stride = w * sizeof (DATA32);
+   int xx, yy;
+
+   for (yy = 0; yy < (h - 1); yy += 2)
+     {
+        DATA8 *yp1, *yp2, *uv;
+        DATA8 *dp1, *dp2;
+
+        yp1 = yuv[yy];
+        yp2 = yuv[yy + 1];
+        uv = yuv[h + (yy >> 1)];
+        dp1 = rgb + (yy * stride);
+        dp2 = dp1 + stride;
+
+        xx = _yuv_nv12_row(yp1, yp2, uv, (DATA32 *)dp1, (DATA32 *)dp2, w,
+                           _coefs_nv12);
+        for (; xx < (w - 1); xx += 2)
+          _evas_yuv2rgb_420_raster(yp1 + xx, yp2 + xx, uv + xx, uv + xx + 1,
+                                   dp1 + (xx * 4), dp2 + (xx * 4));
+     }
+}
+
+static void
+_evas_yuy2torgb_simd(unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   int stride = w * sizeof (DATA32);
+   int xx, yy;
+
+   for (yy = 0; yy < h; yy++)
+     {
+        const DATA8 *line = yuv[yy];
+        DATA32 *dp = (DATA32 *)(rgb + (yy * stride));
+
+        xx = _yuv_422_row(line, dp, w, _coefs_601);
+        for (; xx < (w - 1); xx += 2)
+          {
+             const DATA8 *p = line + (xx * 2);
+             int rv, guv, bu;
+
+             _evas_yuv_chroma_fixed(p[1], p[3], _coefs_601, &rv, &guv, &bu);
+             dp[xx] = _evas_yuv_px_fixed(p[0], rv, guv, bu, _coefs_601);
+             dp[xx + 1] = _evas_yuv_px_fixed(p[2], rv, guv, bu, _coefs_601);
+          }
+     }
+}
+
+/* Large frames are cut in bands of rows, converted in parallel with
+ * evas_common_band_run(). A band gets its own table of row pointers laid
+ * out like a whole frame, so every converter works on it unchanged. */
+#define YUV_BANDS_MAX 4
+#define YUV_THREAD_MIN_PIXELS (320 * 240)
+
+typedef void (*Evas_Yuv_Func)(unsigned char **yuv, unsigned char *rgb, int w, int h);
+
+typedef enum _Evas_Yuv_Layout
+{
+   EVAS_YUV_LAYOUT_PACKED, /* h rows (yuy2) */
+   EVAS_YUV_LAYOUT_SEMI_PLANAR, /* h luma rows, h / 2 interleaved chroma rows (nv12) */
+   EVAS_YUV_LAYOUT_PLANAR /* h luma rows, h / 2 u rows, h / 2 v rows (yv12) */
+} Evas_Yuv_Layout;
+
+typedef struct _Evas_Yuv_Band Evas_Yuv_Band;
+
+struct _Evas_Yuv_Band
+{
+   Evas_Yuv_Func func;
+   unsigned char **yuv;
+   unsigned char *rgb;
+   int w, h;
+};
+
+static void
+_evas_yuv_band_run(void *data)
+{
+   Evas_Yuv_Band *band = data;
+
+   band->func(band->yuv, band->rgb, band->w, band->h);
+}
+
+static void
+_evas_yuv_convert(Evas_Yuv_Func func, Evas_Yuv_Layout layout,
+                  unsigned char **yuv, unsigned char *rgb, int w, int h)
+{
+   Evas_Yuv_Band bands[YUV_BANDS_MAX];
+   void *todo[YUV_BANDS_MAX];
+   unsigned char **rows, **rp;
+   int count, bh, y0, i, j;
+
+   if ((w * h < YUV_THREAD_MIN_PIXELS) ||
+       ((count = evas_common_band_begin()) == 1))
+     {
+        /* small or another thread is already using the workers */
+        func(yuv, rgb, w, h);
+        return;
+     }
+   if (count > YUV_BANDS_MAX) count = YUV_BANDS_MAX;
+
+   /* even band height, each band needs at most 2 row pointers per line */
+   bh = (((h + count - 1) / count) + 1) & ~1;
+   rows = malloc(sizeof (unsigned char *) * 2 * bh * count);
+   if (!rows)
+     {
+        evas_common_band_end();
+        func(yuv, rgb, w, h);
+        return;
+     }
+
+   rp = rows;
+   for (i = 0, y0 = 0; (i < count) && (y0 < h); i++, y0 += bh)
+     {
+        Evas_Yuv_Band *band = bands + i;
+
+        band->func = func;
+        band->w = w;
+        band->h = MIN(bh, h - y0);
+        band->rgb = rgb + (y0 * w * sizeof (DATA32));
+        switch (layout)
+          {
+           case EVAS_YUV_LAYOUT_PACKED:
+              band->yuv = yuv + y0;
+              break;
+           case EVAS_YUV_LAYOUT_SEMI_PLANAR:
+              band->yuv = rp;
+              for (j = 0; j < band->h; j++) *rp++ = yuv[y0 + j];
+              for (j = 0; j < (band->h + 1) / 2; j++) *rp++ = yuv[h + (y0 / 2) + j];
+              break;
+           case EVAS_YUV_LAYOUT_PLANAR:
+              band->yuv = rp;
+              for (j = 0; j < band->h; j++) *rp++ = yuv[y0 + j];
+              for (j = 0; j < band->h / 2; j++) *rp++ = yuv[h + (y0 / 2) + j];
+              for (j = 0; j < band->h / 2; j++) *rp++ = yuv[h + (h / 2) + (y0 / 2) + j];
+              break;
+          }
+        todo[i] = band;
+     }
+
+   evas_common_band_run(_evas_yuv_band_run, todo, i);
+   evas_common_band_end();
+   free(rows);
+}
+
+EAPI void
+evas_common_convert_yuv_reference(Evas_Colorspace cspace, DATA8 **src, DATA8 *dst, int w, int h)
+{
+   if (!initted) _evas_yuv_init();
+   initted = 1;
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+         _evas_yv12torgb_raster(src, dst, w, h);
+         break;
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+         _evas_yv12_709torgb_raster(src, dst, w, h);
+         break;
+      case EVAS_COLORSPACE_YCBCR422601_PL:
+         _evas_yuy2torgb_raster(src, dst, w, h);
+         break;
+      case EVAS_COLORSPACE_YCBCR420NV12601_PL:
+         _evas_nv12torgb_raster(src, dst, w, h);
+         break;
+      case EVAS_COLORSPACE_YCBCR420TM12601_PL:
+         _evas_nv12tiledtorgb_raster(src, dst, w, h);
+         break;
+      default:
+         break;
+     }
+}
+
 void
 evas_common_convert_yuv_422p_709_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
@@ -164,25 +626,33 @@ evas_common_convert_yuv_422p_709_rgba(DATA8 **src, DATA8 *dst, int w, int h)
      _evas_yv12_709torgb_mmx(src, dst, w, h);
    else
  */
-     _evas_yv12_709torgb_raster(src, dst, w, h);
+   if (_yuv_420_row)
+     _evas_yuv_convert(_evas_yv12_709torgb_simd, EVAS_YUV_LAYOUT_PLANAR,
+                       src, dst, w, h);
+   else
+     _evas_yuv_convert(_evas_yv12_709torgb_raster, EVAS_YUV_LAYOUT_PLANAR,
+                       src, dst, w, h);
 }
 
 
 void
 evas_common_convert_yuv_422p_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
+   Evas_Yuv_Func func = _evas_yv12torgb_raster;
+
    if (!initted) _evas_yuv_init();
    initted = 1;
-   if (evas_common_cpu_has_feature(CPU_FEATURE_MMX2))
-     _evas_yv12torgb_sse(src, dst, w, h);
+   if (_yuv_420_row)
+     func = _evas_yv12torgb_simd;
+   else if (evas_common_cpu_has_feature(CPU_FEATURE_MMX2))
+     func = _evas_yv12torgb_sse;
    else if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
-     _evas_yv12torgb_mmx(src, dst, w, h);
+     func = _evas_yv12torgb_mmx;
 #ifdef BUILD_ALTIVEC
-   if (evas_common_cpu_has_feature(CPU_FEATURE_ALTIVEC))
-     _evas_yv12torgb_altivec(src, dst, w, h);
+   else if (evas_common_cpu_has_feature(CPU_FEATURE_ALTIVEC))
+     func = _evas_yv12torgb_altivec;
 #endif
-   else
-     _evas_yv12torgb_raster(src, dst, w, h);
+   _evas_yuv_convert(func, EVAS_YUV_LAYOUT_PLANAR, src, dst, w, h);
 }
 
 /* Thanks to Diz for this code. i've munged it a little and turned it into */
@@ -1097,6 +1567,23 @@ _evas_yuv_init(void)
      {
 	_clip_lut[i+384] = i < 0 ? 0 : (i > 255) ? 255 : i;
      }
+
+#ifdef BUILD_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     {
+        _yuv_420_row = evas_common_convert_yuv_420_row_sse3;
+        _yuv_nv12_row = evas_common_convert_yuv_nv12_row_sse3;
+        _yuv_422_row = evas_common_convert_yuv_422_row_sse3;
+     }
+#endif
+#ifdef BUILD_NEON_INTRINSICS
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     {
+        _yuv_420_row = _evas_yuv_420_row_neon;
+        _yuv_nv12_row = _evas_yuv_nv12_row_neon;
+        _yuv_422_row = _evas_yuv_422_row_neon;
+     }
+#endif
 }
 
 #ifdef BUILD_ALTIVEC
@@ -1309,7 +1796,8 @@ evas_common_convert_yuv_422_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
    if (!initted) _evas_yuv_init();
    initted = 1;
-   _evas_yuy2torgb_raster(src, dst, w, h);
+   _evas_yuv_convert(_yuv_422_row ? _evas_yuy2torgb_simd : _evas_yuy2torgb_raster,
+                     EVAS_YUV_LAYOUT_PACKED, src, dst, w, h);
 }
 
 void
@@ -1317,13 +1805,14 @@ evas_common_convert_yuv_420_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
    if (!initted) _evas_yuv_init();
    initted = 1;
-   _evas_nv12torgb_raster(src, dst, w, h);
+   _evas_yuv_convert(_yuv_nv12_row ? _evas_nv12torgb_simd : _evas_nv12torgb_raster,
+                     EVAS_YUV_LAYOUT_SEMI_PLANAR, src, dst, w, h);
 }
 
 void
 evas_common_convert_yuv_420T_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
-   if (initted) _evas_yuv_init();
+   if (!initted) _evas_yuv_init();
    initted = 1;
    _evas_nv12tiledtorgb_raster(src, dst, w, h);
 }
@@ -8,4 +8,14 @@ EAPI void evas_common_convert_yuv_422_601_rgba      (DATA8 **src, DATA8 *dst, in
 EAPI void evas_common_convert_yuv_420_601_rgba      (DATA8 **src, DATA8 *dst, int w, int h);
 EAPI void evas_common_convert_yuv_420T_601_rgba     (DATA8 **src, DATA8 *dst, int w, int h);
 
+/* the plain C converters, what the SIMD ones are checked against */
+EAPI void evas_common_convert_yuv_reference         (Evas_Colorspace cspace, DATA8 **src, DATA8 *dst, int w, int h);
+
+#ifdef BUILD_SSE3
+/* row kernels, return how many pixels were converted (a multiple of 16) */
+int evas_common_convert_yuv_420_row_sse3(const DATA8 *yp1, const DATA8 *yp2, const DATA8 *up, const DATA8 *vp, DATA32 *dp1, DATA32 *dp2, int w, const unsigned short *coefs);
+int evas_common_convert_yuv_nv12_row_sse3(const DATA8 *yp1, const DATA8 *yp2, const DATA8 *uv, DATA32 *dp1, DATA32 *dp2, int w, const short *coefs);
+int evas_common_convert_yuv_422_row_sse3(const DATA8 *yuyv, DATA32 *dp, int w, const unsigned short *coefs);
+#endif
+
 #endif /* _EVAS_CONVERT_YUV_H */
@@ -0,0 +1,285 @@
+#include "evas_common_private.h"
+#include "evas_convert_yuv.h"
+
+#ifdef BUILD_SSE3
+# include <immintrin.h>
+
+/* Same math as the NEON path in evas_convert_yuv.c, exact to the lookup
+ * tables of the C code: each product is n * |d| + ((|d| * k) >> 16) with
+ * the sign of d put back, so it truncates towards zero like them. */
+
+typedef struct _Evas_Yuv_Sse3_Coefs Evas_Yuv_Sse3_Coefs;
+
+struct _Evas_Yuv_Sse3_Coefs
+{
+   __m128i ymul, crv, cgu, cgv, cbu;
+   __m128i c16, c128, ff;
+};
+
+static inline void
+_evas_yuv_coefs_sse3(Evas_Yuv_Sse3_Coefs *k, const unsigned short *coefs)
+{
+   k->ymul = _mm_set1_epi16(coefs[0]);
+   k->crv = _mm_set1_epi16(coefs[1]);
+   k->cgu = _mm_set1_epi16(coefs[2]);
+   k->cgv = _mm_set1_epi16(coefs[3]);
+   k->cbu = _mm_set1_epi16(coefs[4]);
+   k->c16 = _mm_set1_epi16(16);
+   k->c128 = _mm_set1_epi16(128);
+   k->ff = _mm_set1_epi8(-1);
+}
+
+static inline __m128i
+_evas_yuv_mul_sse3(__m128i d, __m128i k, int n)
+{
+   __m128i m = _mm_srai_epi16(d, 15);
+   __m128i a = _mm_sub_epi16(_mm_xor_si128(d, m), m);
+   __m128i t = _mm_mulhi_epu16(a, k);
+
+   for (; n > 0; n--) t = _mm_add_epi16(t, a);
+   return _mm_sub_epi16(_mm_xor_si128(t, m), m);
+}
+
+/* u and v are 8 chroma samples as 16 bits each, every one of them shared
+ * by 2 horizontal pixels */
+static inline void
+_evas_yuv_chroma_sse3(const Evas_Yuv_Sse3_Coefs *k, __m128i u, __m128i v,
+                      __m128i *rv, __m128i *guv, __m128i *bu)
+{
+   u = _mm_sub_epi16(u, k->c128);
+   v = _mm_sub_epi16(v, k->c128);
+
+   *rv = _evas_yuv_mul_sse3(v, k->crv, 1);
+   *guv = _mm_add_epi16(_evas_yuv_mul_sse3(u, k->cgu, 0),
+                        _evas_yuv_mul_sse3(v, k->cgv, 0));
+   *bu = _evas_yuv_mul_sse3(u, k->cbu, 2);
+}
+
+static inline __m128i
+_evas_yuv_channel_sse3(__m128i ylo, __m128i yhi, __m128i c, Eina_Bool sub)
+{
+   __m128i lo, hi;
+
+   if (sub)
+     {
+        lo = _mm_sub_epi16(ylo, _mm_unpacklo_epi16(c, c));
+        hi = _mm_sub_epi16(yhi, _mm_unpackhi_epi16(c, c));
+     }
+   else
+     {
+        lo = _mm_add_epi16(ylo, _mm_unpacklo_epi16(c, c));
+        hi = _mm_add_epi16(yhi, _mm_unpackhi_epi16(c, c));
+     }
+   return _mm_packus_epi16(lo, hi);
+}
+
+/* interleave 16 pixels worth of 8 bits r, g and b as ARGB */
+static inline void
+_evas_yuv_write16_sse3(DATA32 *dp, __m128i r, __m128i g, __m128i b, __m128i ff)
+{
+   __m128i bg, ra;
+
+   bg = _mm_unpacklo_epi8(b, g);
+   ra = _mm_unpacklo_epi8(r, ff);
+   _mm_storeu_si128((__m128i *)(dp + 0), _mm_unpacklo_epi16(bg, ra));
+   _mm_storeu_si128((__m128i *)(dp + 4), _mm_unpackhi_epi16(bg, ra));
+   bg = _mm_unpackhi_epi8(b, g);
+   ra = _mm_unpackhi_epi8(r, ff);
+   _mm_storeu_si128((__m128i *)(dp + 8), _mm_unpacklo_epi16(bg, ra));
+   _mm_storeu_si128((__m128i *)(dp + 12), _mm_unpackhi_epi16(bg, ra));
+}
+
+/* write 16 ARGB pixels from 16 luma samples (as 2 x 8 16 bits) */
+static inline void
+_evas_yuv_store16_sse3(const Evas_Yuv_Sse3_Coefs *k, DATA32 *dp,
+                       __m128i ylo, __m128i yhi,
+                       __m128i rv, __m128i guv, __m128i bu)
+{
+   ylo = _evas_yuv_mul_sse3(_mm_sub_epi16(ylo, k->c16), k->ymul, 1);
+   yhi = _evas_yuv_mul_sse3(_mm_sub_epi16(yhi, k->c16), k->ymul, 1);
+
+   _evas_yuv_write16_sse3(dp,
+                          _evas_yuv_channel_sse3(ylo, yhi, rv, EINA_FALSE),
+                          _evas_yuv_channel_sse3(ylo, yhi, guv, EINA_TRUE),
+                          _evas_yuv_channel_sse3(ylo, yhi, bu, EINA_FALSE),
+                          k->ff);
+}
+
+int
+evas_common_convert_yuv_420_row_sse3(const DATA8 *yp1, const DATA8 *yp2,
+                                     const DATA8 *up, const DATA8 *vp,
+                                     DATA32 *dp1, DATA32 *dp2,
+                                     int w, const unsigned short *coefs)
+{
+   Evas_Yuv_Sse3_Coefs k;
+   __m128i zero = _mm_setzero_si128();
+   int xx;
+
+   _evas_yuv_coefs_sse3(&k, coefs);
+   for (xx = 0; xx < (w - 15); xx += 16)
+     {
+        __m128i u, v, y, rv, guv, bu;
+
+        u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(up + (xx >> 1))), zero);
+        v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(vp + (xx >> 1))), zero);
+        _evas_yuv_chroma_sse3(&k, u, v, &rv, &guv, &bu);
+
+        y = _mm_loadu_si128((const __m128i *)(yp1 + xx));
+        _evas_yuv_store16_sse3(&k, dp1 + xx,
+                               _mm_unpacklo_epi8(y, zero), _mm_unpackhi_epi8(y, zero),
+                               rv, guv, bu);
+        y = _mm_loadu_si128((const __m128i *)(yp2 + xx));
+        _evas_yuv_store16_sse3(&k, dp2 + xx,
+                               _mm_unpacklo_epi8(y, zero), _mm_unpackhi_epi8(y, zero),
+                               rv, guv, bu);
+     }
+
+   return xx;
+}
+
+/* nv12 follows the 16.16 math of _evas_yuv2rgb_420_raster(): for every
+ * channel the remainders are summed in 32 bits with _mm_madd_epi16(), the
+ * last pair being the u term of green and the rounding offset (against a
+ * -1 lane), then shifted and added to the integer parts. */
+typedef struct _Evas_Yuv_Nv12_Sse3_Coefs Evas_Yuv_Nv12_Sse3_Coefs;
+
+struct _Evas_Yuv_Nv12_Sse3_Coefs
+{
+   __m128i r0, r1, g0, g1, b0, b1;
+   __m128i c16, c128, ones, ff;
+};
+
+static inline __m128i
+_evas_yuv_pair_sse3(short a, short b)
+{
+   return _mm_unpacklo_epi16(_mm_set1_epi16(a), _mm_set1_epi16(b));
+}
+
+static inline void
+_evas_yuv_nv12_coefs_sse3(Evas_Yuv_Nv12_Sse3_Coefs *k, const short *coefs)
+{
+   k->r0 = _evas_yuv_pair_sse3(coefs[0], coefs[1]);
+   k->r1 = _mm_setzero_si128();
+   k->g0 = _evas_yuv_pair_sse3(coefs[0], coefs[2]);
+   k->g1 = _evas_yuv_pair_sse3(coefs[3], -32768);
+   k->b0 = _evas_yuv_pair_sse3(coefs[0], coefs[4]);
+   k->b1 = _evas_yuv_pair_sse3(0, -32768);
+   k->c16 = _mm_set1_epi16(16);
+   k->c128 = _mm_set1_epi16(128);
+   k->ones = _mm_set1_epi16(-1);
+   k->ff = _mm_set1_epi8(-1);
+}
+
+/* (y * k0[0] + x * k0[1] + u * k1[0] - k1[1]) >> 16 for 8 pixels */
+static inline __m128i
+_evas_yuv_q16_sse3(const Evas_Yuv_Nv12_Sse3_Coefs *k, __m128i y, __m128i x,
+                   __m128i u, __m128i k0, __m128i k1)
+{
+   __m128i lo, hi;
+
+   lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(y, x), k0),
+                      _mm_madd_epi16(_mm_unpacklo_epi16(u, k->ones), k1));
+   hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(y, x), k0),
+                      _mm_madd_epi16(_mm_unpackhi_epi16(u, k->ones), k1));
+   return _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+}
+
+/* r, g and b of 8 pixels as 16 bits, u and v already have one sample per
+ * pixel */
+static inline void
+_evas_yuv_nv12_px8_sse3(const Evas_Yuv_Nv12_Sse3_Coefs *k, __m128i y,
+                        __m128i u, __m128i v,
+                        __m128i *r, __m128i *g, __m128i *b)
+{
+   __m128i v2 = _mm_add_epi16(v, v);
+   __m128i u2 = _mm_add_epi16(u, u);
+
+   *r = _mm_add_epi16(_mm_add_epi16(y, v2),
+                      _evas_yuv_q16_sse3(k, y, v, u, k->r0, k->r1));
+   *g = _mm_add_epi16(_mm_sub_epi16(y, v),
+                      _evas_yuv_q16_sse3(k, y, v, u, k->g0, k->g1));
+   *b = _mm_add_epi16(_mm_add_epi16(y, u2),
+                      _evas_yuv_q16_sse3(k, y, u, u, k->b0, k->b1));
+}
+
+static inline void
+_evas_yuv_nv12_store16_sse3(const Evas_Yuv_Nv12_Sse3_Coefs *k, DATA32 *dp,
+                            __m128i y, __m128i u, __m128i v)
+{
+   __m128i zero = _mm_setzero_si128();
+   __m128i ylo, yhi, rlo, rhi, glo, ghi, blo, bhi;
+
+   ylo = _mm_sub_epi16(_mm_unpacklo_epi8(y, zero), k->c16);
+   yhi = _mm_sub_epi16(_mm_unpackhi_epi8(y, zero), k->c16);
+   _evas_yuv_nv12_px8_sse3(k, ylo, _mm_unpacklo_epi16(u, u),
+                           _mm_unpacklo_epi16(v, v), &rlo, &glo, &blo);
+   _evas_yuv_nv12_px8_sse3(k, yhi, _mm_unpackhi_epi16(u, u),
+                           _mm_unpackhi_epi16(v, v), &rhi, &ghi, &bhi);
+
+   _evas_yuv_write16_sse3(dp,
+                          _mm_packus_epi16(rlo, rhi),
+                          _mm_packus_epi16(glo, ghi),
+                          _mm_packus_epi16(blo, bhi),
+                          k->ff);
+}
+
+int
+evas_common_convert_yuv_nv12_row_sse3(const DATA8 *yp1, const DATA8 *yp2,
+                                      const DATA8 *uv, DATA32 *dp1, DATA32 *dp2,
+                                      int w, const short *coefs)
+{
+   Evas_Yuv_Nv12_Sse3_Coefs k;
+   __m128i lo = _mm_set1_epi16(0xff);
+   int xx;
+
+   _evas_yuv_nv12_coefs_sse3(&k, coefs);
+   for (xx = 0; xx < (w - 15); xx += 16)
+     {
+        /* 8 interleaved u/v pairs */
+        __m128i c = _mm_loadu_si128((const __m128i *)(uv + xx));
+        __m128i u = _mm_sub_epi16(_mm_and_si128(c, lo), k.c128);
+        __m128i v = _mm_sub_epi16(_mm_srli_epi16(c, 8), k.c128);
+
+        _evas_yuv_nv12_store16_sse3(&k, dp1 + xx,
+                                    _mm_loadu_si128((const __m128i *)(yp1 + xx)),
+                                    u, v);
+        _evas_yuv_nv12_store16_sse3(&k, dp2 + xx,
+                                    _mm_loadu_si128((const __m128i *)(yp2 + xx)),
+                                    u, v);
+     }
+
+   return xx;
+}
+
+int
+evas_common_convert_yuv_422_row_sse3(const DATA8 *yuyv, DATA32 *dp, int w,
+                                     const unsigned short *coefs)
+{
+   Evas_Yuv_Sse3_Coefs k;
+   __m128i lo = _mm_set1_epi16(0xff);
+   __m128i lo32 = _mm_set1_epi32(0xffff);
+   int xx;
+
+   _evas_yuv_coefs_sse3(&k, coefs);
+   for (xx = 0; xx < (w - 15); xx += 16)
+     {
+        __m128i p0, p1, c0, c1, u, v, rv, guv, bu;
+
+        /* 8 pixels each: y0 u0 y1 v0 y2 u1 y3 v1 ... */
+        p0 = _mm_loadu_si128((const __m128i *)(yuyv + (xx * 2)));
+        p1 = _mm_loadu_si128((const __m128i *)(yuyv + (xx * 2) + 16));
+
+        c0 = _mm_srli_epi16(p0, 8);
+        c1 = _mm_srli_epi16(p1, 8);
+        u = _mm_packs_epi32(_mm_and_si128(c0, lo32), _mm_and_si128(c1, lo32));
+        v = _mm_packs_epi32(_mm_srli_epi32(c0, 16), _mm_srli_epi32(c1, 16));
+        _evas_yuv_chroma_sse3(&k, u, v, &rv, &guv, &bu);
+
+        _evas_yuv_store16_sse3(&k, dp + xx,
+                               _mm_and_si128(p0, lo), _mm_and_si128(p1, lo),
+                               rv, guv, bu);
+     }
+
+   return xx;
+}
+#endif
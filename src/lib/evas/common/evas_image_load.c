@@ -10,6 +10,9 @@
 #include "evas_private.h"
 //#include "evas_cs.h"
 
+/* bigger files are rather videos or documents handled by generic loaders */
+#define EVAS_IMAGE_PREFETCH_MAX (32 * 1024 * 1024)
+
 struct ext_loader_s
 {
    unsigned int length;
@@ -491,6 +494,19 @@ end:
    return ret;
 }
 
+EAPI void
+evas_common_load_rgba_image_data_prefetch(Image_Entry *ie)
+{
+   /* the pixels are going to be decoded, have the file read from disk in the
+    * background while the decode waits for its turn. Images inside an eet
+    * file are left alone, eet already asks for all its data. */
+   if ((!ie->f) || (ie->key) || (!ie->info.module) || (ie->flags.loaded))
+     return;
+   if (eina_file_size_get(ie->f) > EVAS_IMAGE_PREFETCH_MAX) return;
+
+   eina_file_prefetch(ie->f, 0, 0);
+}
+
 EAPI double
 evas_common_load_rgba_image_frame_duration_from_file(Image_Entry *ie, const int start, const int frame_num)
 {
@@ -33,6 +33,7 @@ struct _ScaleitemKey
    unsigned int src_w, src_h;
    unsigned int dst_w, dst_h;
    Eina_Bool smooth : 1;
+   Eina_Bool mipmap : 1;
 };
 
 struct _Scaleitem
@@ -105,6 +106,7 @@ _evas_common_scalecache_key_cmp(const void *key1, int key1_length EINA_UNUSED,
    CMP_SKEY(sk1, sk2, src_x);
    CMP_SKEY(sk1, sk2, src_y);
    CMP_SKEY(sk1, sk2, smooth);
+   CMP_SKEY(sk1, sk2, mipmap);
 
    return 0;
 }
@@ -300,7 +302,7 @@ _sci_fix_newest(RGBA_Image *im)
 
 static Scaleitem *
 _sci_find(RGBA_Image *im,
-          RGBA_Draw_Context *dc EINA_UNUSED, int smooth,
+          RGBA_Draw_Context *dc EINA_UNUSED, int smooth, Eina_Bool mipmap,
           int src_x, int src_y,
           unsigned int src_w, unsigned int src_h,
           unsigned int dst_w, unsigned int dst_h)
@@ -321,6 +323,7 @@ _sci_find(RGBA_Image *im,
         SET_SKEY(key, src_x);
         SET_SKEY(key, src_y);
         SET_SKEY(key, smooth);
+        SET_SKEY(key, mipmap);
 
         sci = eina_hash_find(im->cache.hash, &key);
         if (sci)
@@ -375,6 +378,7 @@ try_alloc:
    sci->usage_count = 0;
    sci->populate_me = 0;
    sci->key.smooth = smooth;
+   sci->key.mipmap = mipmap;
    sci->forced_unload = 0;
    sci->flop = 0;
    sci->im = NULL;
@@ -588,7 +592,7 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst EINA_
         return EINA_FALSE;
      }
    SLKL(cache_lock);
-   sci = _sci_find(im, dc, smooth, 
+   sci = _sci_find(im, dc, smooth, EINA_FALSE, 
                    src_region_x, src_region_y, src_region_w, src_region_h, 
                    dst_region_w, dst_region_h);
    if (!sci)
@@ -691,7 +695,7 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
         return EINA_FALSE;
      }
    SLKL(cache_lock);
-   sci = _sci_find(im, dc, smooth,
+   sci = _sci_find(im, dc, smooth, EINA_FALSE,
                    src_region_x, src_region_y, src_region_w, src_region_h,
                    dst_region_w, dst_region_h);
    SLKU(cache_lock);
@@ -969,3 +973,170 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
      evas_common_scale_rgba_in_to_out_clip_smooth);
    evas_common_rgba_image_scalecache_prune();
 }
+
+#ifdef SCALECACHE
+// box filter src down by 1 << shift, dst is at least 1x1 so edge boxes may
+// be partial. returns EINA_FALSE and leaves dst untouched on failure
+static Eina_Bool
+_mipmap_reduce(const DATA32 *src, int sw, int sh,
+               DATA32 *dst, int dw, int dh, int shift)
+{
+   unsigned int *sums;
+   int x, y, yy, i, f = 1 << shift;
+
+   sums = malloc(dw * 4 * sizeof(unsigned int));
+   if (!sums) return EINA_FALSE;
+   for (y = 0; y < dh; y++)
+     {
+        int y0 = y << shift, y1 = y0 + f;
+        unsigned int *t;
+
+        if (y1 > sh) y1 = sh;
+        memset(sums, 0, dw * 4 * sizeof(unsigned int));
+        for (yy = y0; yy < y1; yy++)
+          {
+             const DATA32 *s = src + (yy * sw);
+
+             for (t = sums, x = 0; x < dw; x++, t += 4)
+               {
+                  int x0 = x << shift, x1 = x0 + f;
+
+                  if (x1 > sw) x1 = sw;
+                  for (i = x0; i < x1; i++)
+                    {
+                       t[0] += s[i] >> 24;
+                       t[1] += (s[i] >> 16) & 0xff;
+                       t[2] += (s[i] >> 8) & 0xff;
+                       t[3] += s[i] & 0xff;
+                    }
+               }
+          }
+        for (t = sums, x = 0; x < dw; x++, t += 4)
+          {
+             int x1 = (x + 1) << shift;
+             unsigned int n;
+
+             if (x1 > sw) x1 = sw;
+             n = (x1 - (x << shift)) * (y1 - y0);
+             *dst++ = (((t[0] + (n >> 1)) / n) << 24) |
+                      (((t[1] + (n >> 1)) / n) << 16) |
+                      (((t[2] + (n >> 1)) / n) << 8) |
+                      ((t[3] + (n >> 1)) / n);
+          }
+     }
+   free(sums);
+   return EINA_TRUE;
+}
+#endif
+
+/* receives original Image_Entry with its data loaded, returns level (1 is
+ * half the size, 2 a quarter...) with a reference held or NULL if it can't
+ * be cached (yet) */
+RGBA_Image *
+evas_common_rgba_image_scalecache_mipmap_ref(Image_Entry *ie, int level)
+{
+#ifdef SCALECACHE
+   RGBA_Image *im = (RGBA_Image *)ie;
+   RGBA_Image *from = im, *ret = NULL;
+   Scaleitem *sci;
+   unsigned int w, h;
+   int l;
+
+   if ((level < 1) || (level > EVAS_MIPMAP_LEVELS) || (!im->image.data)) return NULL;
+   if ((ie->space != EVAS_COLORSPACE_ARGB8888) ||
+       (ie->scale_hint == EVAS_IMAGE_SCALE_HINT_DYNAMIC) ||
+       (ie->animated.animated))
+     return NULL;
+   w = ie->w >> level;
+   h = ie->h >> level;
+   if (w < 1) w = 1;
+   if (h < 1) h = 1;
+
+   SLKL(im->cache.lock);
+   SLKL(cache_lock);
+   use_counter++;
+   sci = _sci_find(im, NULL, 1, EINA_TRUE, 0, 0, ie->w, ie->h, w, h);
+   if (!sci) goto done;
+   sci->usage++;
+   sci->usage_count = use_counter;
+   if ((!sci->im) && (sci->usage >= min_scale_uses) &&
+       (sci->flop <= max_flop_count) &&
+       ((cache_size + (w * h * 4)) <= max_cache_size))
+     {
+        ScaleitemKey key;
+
+        // start from the smallest level still cached, if any
+        memset(&key, 0, sizeof(key));
+        key.src_w = ie->w;
+        key.src_h = ie->h;
+        key.smooth = 1;
+        key.mipmap = 1;
+        for (l = level - 1; l > 0; l--)
+          {
+             Scaleitem *sci2;
+
+             key.dst_w = ie->w >> l;
+             key.dst_h = ie->h >> l;
+             if (key.dst_w < 1) key.dst_w = 1;
+             if (key.dst_h < 1) key.dst_h = 1;
+             sci2 = eina_hash_find(im->cache.hash, &key);
+             if ((sci2) && (sci2->im))
+               {
+                  from = sci2->im;
+                  break;
+               }
+          }
+        sci->im = evas_common_image_new(w, h, ie->flags.alpha);
+        if ((sci->im) &&
+            (!_mipmap_reduce(from->image.data,
+                             from->cache_entry.w, from->cache_entry.h,
+                             sci->im->image.data, w, h, level - l)))
+          {
+             // nothing to cache, the next request tries again
+             evas_common_rgba_image_free(&sci->im->cache_entry);
+             sci->im = NULL;
+          }
+        if (sci->im)
+          {
+             if (sci->flop >= FLOP_DEL) sci->flop -= FLOP_DEL;
+             cache_size += w * h * 4;
+             cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
+          }
+     }
+   else if (sci->im)
+     {
+        cache_list = eina_inlist_remove(cache_list, (Eina_Inlist *)sci);
+        cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
+     }
+   if (sci->im)
+     {
+        sci->im->cache_entry.references++;
+        ret = sci->im;
+     }
+done:
+   SLKU(cache_lock);
+   SLKU(im->cache.lock);
+   return ret;
+#else
+   (void)ie;
+   (void)level;
+   return NULL;
+#endif
+}
+
+/* receives original Image_Entry and a level from the above */
+void
+evas_common_rgba_image_scalecache_mipmap_unref(Image_Entry *ie, RGBA_Image *mip)
+{
+#ifdef SCALECACHE
+   RGBA_Image *im = (RGBA_Image *)ie;
+
+   SLKL(im->cache.lock);
+   mip->cache_entry.references--;
+   assert(mip->cache_entry.references >= 0);
+   SLKU(im->cache.lock);
+#else
+   (void)ie;
+   (void)mip;
+#endif
+}
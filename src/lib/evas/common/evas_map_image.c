@@ -622,6 +622,99 @@ evas_common_map_rgba_prepare(RGBA_Image *src, RGBA_Image *dst,
    return EINA_TRUE;
 }
 
+/* smooth maps that shrink the source sample cached box filtered levels of
+ * it (see evas_common_rgba_image_scalecache_mipmap_ref()) so bilinear
+ * filtering never skips source pixels */
+typedef struct _Map_Mipmaps Map_Mipmaps;
+
+struct _Map_Mipmaps
+{
+   RGBA_Image *level[EVAS_MIPMAP_LEVELS + 1];
+   int count;
+};
+
+// source pixels walked per destination pixel, as a level
+static inline int
+_map_mipmap_span_level(const Span *span)
+{
+   FPc d, dv;
+   int l = 0;
+
+   dv = span->o2 - span->o1;
+   if (dv <= 0) return 0;
+   d = abs(span->u[1] - span->u[0]);
+   if (abs(span->v[1] - span->v[0]) > d) d = abs(span->v[1] - span->v[0]);
+   for (d /= dv; d > 1; d >>= 1) l++;
+   return l;
+}
+
+static void
+_map_mipmaps_get(Map_Mipmaps *mm, RGBA_Image *src, int smooth,
+                 const Line *spans, int nspans)
+{
+   unsigned int used = 0;
+   int i, j, l;
+
+   mm->level[0] = src;
+   mm->count = 1;
+   if (!smooth) return;
+
+   for (i = 0; i < nspans; i++)
+     {
+        for (j = 0; j < 2; j++)
+          {
+             if (spans[i].span[j].x[0] < 0) break;
+             l = _map_mipmap_span_level(&spans[i].span[j]);
+             if (l > EVAS_MIPMAP_LEVELS) l = EVAS_MIPMAP_LEVELS;
+             used |= 1 << l;
+          }
+     }
+   // only the levels spans ask for, missing ones (cache full or not used
+   // enough yet) make spans fall back to the closest bigger level
+   for (l = 1; (used >> l); l++)
+     {
+        mm->level[l] = NULL;
+        if (used & (1 << l))
+          mm->level[l] = evas_common_rgba_image_scalecache_mipmap_ref(&src->cache_entry, l);
+        mm->count = l + 1;
+     }
+}
+
+static void
+_map_mipmaps_release(Map_Mipmaps *mm)
+{
+   int l;
+
+   for (l = 1; l < mm->count; l++)
+     {
+        if (mm->level[l])
+          evas_common_rgba_image_scalecache_mipmap_unref(&mm->level[0]->cache_entry,
+                                                         mm->level[l]);
+     }
+}
+
+// switch the source to the level matching the span, moving its u,v there
+static inline void
+_map_mipmap_span_select(const Map_Mipmaps *mm, Span *span, DATA32 **sp,
+                        int *sw, int *swp, int *shp)
+{
+   RGBA_Image *im;
+   int l;
+
+   l = _map_mipmap_span_level(span);
+   if (l >= mm->count) l = mm->count - 1;
+   while ((l > 0) && (!mm->level[l])) l--;
+   im = mm->level[l];
+   *sp = im->image.data;
+   *sw = im->cache_entry.w;
+   *swp = *sw << (FP + FPI);
+   *shp = im->cache_entry.h << (FP + FPI);
+   span->u[0] >>= l;
+   span->u[1] >>= l;
+   span->v[0] >>= l;
+   span->v[1] >>= l;
+}
+
 #ifdef BUILD_MMX
 # undef FUNC_NAME
 # undef FUNC_NAME_DO
@@ -35,6 +35,8 @@
 
                   dv = (span->o2 - span->o1);
                   if (dv <= 0) continue;
+                  if (mips.count > 1)
+                    _map_mipmap_span_select(&mips, span, &sp, &sw, &swp, &shp);
 
                   ww = w;
 
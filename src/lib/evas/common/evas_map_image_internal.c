@@ -12,6 +12,7 @@ FUNC_NAME(RGBA_Image *src, RGBA_Image *dst,
    int cx, cy, cw, ch;
    int ytop, ybottom, ystart, yend, y, sw, shp, swp, direct;
    Line *spans;
+   Map_Mipmaps mips;
    DATA32 *buf = NULL, *sp;
    RGBA_Gfx_Func func = NULL, func2 = NULL;
    Eina_Bool havea = EINA_FALSE;
@@ -83,6 +84,7 @@ FUNC_NAME(RGBA_Image *src, RGBA_Image *dst,
 
    // calculate the spans list
    _calc_spans(p, spans, ystart, yend, cx, cy, cw, ch);
+   _map_mipmaps_get(&mips, src, smooth, spans, yend - ystart + 1);
 
    // walk through spans and render
 
@@ -130,6 +132,7 @@ FUNC_NAME(RGBA_Image *src, RGBA_Image *dst,
 #define COLMUL 1
 #include "evas_map_image_core.c"
      }
+   _map_mipmaps_release(&mips);
 }
 
 static void
@@ -139,6 +142,7 @@ FUNC_NAME_DO(RGBA_Image *src, RGBA_Image *dst,
              int smooth, int anti_alias EINA_UNUSED, int level EINA_UNUSED) // level unused for now - for future use
 {
    Line *spans;
+   Map_Mipmaps mips;
    DATA32 *buf = NULL, *sp;
    RGBA_Gfx_Func func = NULL, func2 = NULL;
    int cx, cy, cw, ch;
@@ -182,6 +186,7 @@ FUNC_NAME_DO(RGBA_Image *src, RGBA_Image *dst,
    memcpy(spans, &ms->spans[ystart - ms->ystart],
           (yend - ystart + 3) * sizeof(Line));
    _clip_spans(spans, ystart, yend, cx, cw, EINA_TRUE);
+   _map_mipmaps_get(&mips, src, smooth, spans, yend - ystart + 1);
 
    // if operation is solid, bypass buf and draw func and draw direct to dst
    if (!direct)
@@ -217,4 +222,5 @@ FUNC_NAME_DO(RGBA_Image *src, RGBA_Image *dst,
 #define COLMUL 1
 #include "evas_map_image_core.c"
      }
+   _map_mipmaps_release(&mips);
 }
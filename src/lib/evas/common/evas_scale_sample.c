@@ -1,19 +1,13 @@
 #include "evas_common_private.h"
 #include "evas_blend_private.h"
 
-#include "Ecore.h"
-
 static Eina_Bool scale_rgba_in_to_out_clip_sample_internal(RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_Context *dc, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h);
 
-typedef struct _Evas_Scale_Thread Evas_Scale_Thread;
-typedef struct _Evas_Scale_Msg Evas_Scale_Msg;
+#define SAMPLE_BANDS_MAX 4
 
-struct _Evas_Scale_Msg
-{
-   Eina_Thread_Queue_Msg head;
-   Evas_Scale_Thread *task;
-};
+typedef struct _Evas_Scale_Thread Evas_Scale_Thread;
 
+/* the lines [y, end) of a scale, run by evas_common_band_run() */
 struct _Evas_Scale_Thread
 {
    RGBA_Image *mask8;
@@ -34,12 +28,9 @@ struct _Evas_Scale_Thread
    int mask_y;
 
    unsigned int mul_col;
-};
 
-static Eina_Bool use_thread = EINA_FALSE;
-static Eina_Thread scaling_thread;
-static Eina_Thread_Queue *thread_queue = NULL;
-static Eina_Thread_Queue *main_queue = NULL;
+   int y, end;
+};
 
 EAPI Eina_Bool
 evas_common_scale_rgba_in_to_out_clip_sample(RGBA_Image *src, RGBA_Image *dst,
@@ -197,6 +188,30 @@ _evas_common_scale_rgba_sample_scale_mask(int y,
      }
 }
 
+static void
+_evas_common_scale_sample_band_run(void *data)
+{
+   Evas_Scale_Thread *todo = data;
+
+   if (todo->mask8)
+     _evas_common_scale_rgba_sample_scale_mask(todo->y,
+                                               todo->dst_clip_x, todo->dst_clip_y,
+                                               todo->dst_clip_w, todo->end,
+                                               todo->dst_w,
+                                               todo->mask_x, todo->mask_y,
+                                               todo->row_ptr, todo->lin_ptr, todo->mask8,
+                                               todo->dptr, todo->func, todo->func2,
+                                               todo->mul_col,
+                                               NULL, 0);
+   else
+     _evas_common_scale_rgba_sample_scale_nomask(todo->y,
+                                                 todo->dst_clip_w, todo->end,
+                                                 todo->dst_w,
+                                                 todo->row_ptr, todo->lin_ptr,
+                                                 todo->dptr, todo->func, todo->mul_col,
+                                                 NULL, 0);
+}
+
 EAPI void
 evas_common_scale_rgba_sample_draw(RGBA_Image *src, RGBA_Image *dst, int dst_clip_x, int dst_clip_y, int dst_clip_w, int dst_clip_h, DATA32 mul_col, int render_op, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h, RGBA_Image *mask_ie, int mask_x, int mask_y)
 {
@@ -649,59 +664,46 @@ scale_rgba_in_to_out_clip_sample_internal(RGBA_Image *src, RGBA_Image *dst,
 #endif
           {
              unsigned int mul_col;
+             int count;
 
              mul_col = dc->mul.use ? dc->mul.col : 0xFFFFFFFF;
 
              /* do we have enough data to start some additional thread ? */
-             if (use_thread && dst_clip_h > 32 && dst_clip_w * dst_clip_h > 4096)
+             if ((dst_clip_h > 32) && (dst_clip_w * dst_clip_h > 4096) &&
+                 ((count = evas_common_band_begin()) > 1))
                {
                   /* Yes, we do ! */
-                  Evas_Scale_Msg *msg;
-                  void *ref;
-                  Evas_Scale_Thread local;
-
-                  local.mask8 = dc->clip.mask;
-                  local.row_ptr = row_ptr;
-                  local.dptr = dptr;
-                  local.lin_ptr = lin_ptr;
-                  local.func = func;
-                  local.func2 = func2;
-                  local.dst_clip_x = dst_clip_x;
-                  local.dst_clip_y = dst_clip_y;
-                  local.dst_clip_h = dst_clip_h;
-                  local.dst_clip_w = dst_clip_w;
-                  local.dst_w = dst_w;
-                  local.mask_x = mask_x;
-                  local.mask_y = mask_y;
-                  local.mul_col = mul_col;
-
-                  msg = eina_thread_queue_send(thread_queue, sizeof (Evas_Scale_Msg), &ref);
-                  msg->task = &local;
-                  eina_thread_queue_send_done(thread_queue, ref);
+                  Evas_Scale_Thread bands[SAMPLE_BANDS_MAX];
+                  void *todo[SAMPLE_BANDS_MAX];
+                  int i, bh;
 
-                  /* image masking */
-                  if (dc->clip.mask)
+                  if (count > SAMPLE_BANDS_MAX) count = SAMPLE_BANDS_MAX;
+                  bh = (dst_clip_h + count - 1) / count;
+                  for (i = 0; (i < count) && (i * bh < dst_clip_h); i++)
                     {
-                       _evas_common_scale_rgba_sample_scale_mask(0,
-                                                                 dst_clip_x, dst_clip_y,
-                                                                 dst_clip_w, dst_clip_h >> 1, dst_w,
-                                                                 dc->clip.mask_x, dc->clip.mask_y,
-                                                                 row_ptr, lin_ptr, dc->clip.mask,
-                                                                 dptr, func, func2, mul_col,
-                                                                 NULL, 0);
-
-                    }
-                  else
-                    {
-                       _evas_common_scale_rgba_sample_scale_nomask(0,
-                                                                   dst_clip_w, dst_clip_h >> 1, dst_w,
-                                                                   row_ptr, lin_ptr,
-                                                                   dptr, func, mul_col,
-                                                                   NULL, 0);
+                       Evas_Scale_Thread *band = bands + i;
+
+                       band->mask8 = dc->clip.mask;
+                       band->row_ptr = row_ptr;
+                       band->dptr = dptr;
+                       band->lin_ptr = lin_ptr;
+                       band->func = func;
+                       band->func2 = func2;
+                       band->dst_clip_x = dst_clip_x;
+                       band->dst_clip_y = dst_clip_y;
+                       band->dst_clip_h = dst_clip_h;
+                       band->dst_clip_w = dst_clip_w;
+                       band->dst_w = dst_w;
+                       band->mask_x = dc->clip.mask_x;
+                       band->mask_y = dc->clip.mask_y;
+                       band->mul_col = mul_col;
+                       band->y = i * bh;
+                       band->end = MIN((i + 1) * bh, dst_clip_h);
+                       todo[i] = band;
                     }
 
-                  msg = eina_thread_queue_wait(main_queue, &ref);
-                  if (msg) eina_thread_queue_wait_done(main_queue, ref);
+                  evas_common_band_run(_evas_common_scale_sample_band_run, todo, i);
+                  evas_common_band_end();
                }
              else
                {
@@ -733,140 +735,3 @@ scale_rgba_in_to_out_clip_sample_internal(RGBA_Image *src, RGBA_Image *dst,
 
    return EINA_TRUE;
 }
-
-static void *
-_evas_common_scale_sample_thread(void *data EINA_UNUSED,
-                                 Eina_Thread t EINA_UNUSED)
-{
-   Evas_Scale_Msg *msg;
-   Evas_Scale_Thread *todo = NULL;
-
-   eina_thread_name_set(eina_thread_self(), "Evas-scale-sam");
-   do
-     {
-        void *ref;
-
-        todo = NULL;
-
-        msg = eina_thread_queue_wait(thread_queue, &ref);
-        if (msg)
-          {
-             int h;
-
-             todo = msg->task;
-             eina_thread_queue_wait_done(thread_queue, ref);
-
-             if (!todo) goto end;
-
-             h = todo->dst_clip_h >> 1;
-
-             if (todo->mask8)
-               _evas_common_scale_rgba_sample_scale_mask(h,
-                                                         todo->dst_clip_x, todo->dst_clip_y,
-                                                         todo->dst_clip_w, todo->dst_clip_h,
-                                                         todo->dst_w,
-                                                         todo->mask_x, todo->mask_y,
-                                                         todo->row_ptr, todo->lin_ptr, todo->mask8,
-                                                         todo->dptr, todo->func, todo->func2,
-                                                         todo->mul_col,
-                                                         NULL, 0);
-             else
-               _evas_common_scale_rgba_sample_scale_nomask(h,
-                                                           todo->dst_clip_w, todo->dst_clip_h,
-                                                           todo->dst_w,
-                                                           todo->row_ptr, todo->lin_ptr,
-                                                           todo->dptr, todo->func, todo->mul_col,
-                                                           NULL, 0);
-          }
-
-     end:
-        msg = eina_thread_queue_send(main_queue, sizeof (Evas_Scale_Msg), &ref);
-        msg->task = NULL;
-        eina_thread_queue_send_done(main_queue, ref);
-     }
-   while (todo);
-
-   return NULL;
-}
-
-static void
-evas_common_scale_sample_fork_reset(void *data EINA_UNUSED)
-{
-   eina_thread_queue_free(thread_queue);
-   eina_thread_queue_free(main_queue);
-
-   thread_queue = eina_thread_queue_new();
-   main_queue = eina_thread_queue_new();
-
-   if (!eina_thread_create(&scaling_thread, EINA_THREAD_NORMAL, -1,
-                           _evas_common_scale_sample_thread, NULL))
-     {
-        CRI("We failed to recreate the upscaling thread.");
-        use_thread = EINA_FALSE;
-     }
-}
-
-EAPI void
-evas_common_scale_sample_init(void)
-{
-   if (eina_cpu_count() <= 2) return ;
-
-//Eina_Thread_Queue doesn't work on WIN32.
-#ifdef _WIN32
-   return;
-#endif
-
-   ecore_fork_reset_callback_add(evas_common_scale_sample_fork_reset, NULL);
-
-   thread_queue = eina_thread_queue_new();
-   if (EINA_UNLIKELY(!thread_queue))
-     {
-        ERR("Failed to create thread queue");
-        goto cleanup;
-     }
-   main_queue = eina_thread_queue_new();
-   if (EINA_UNLIKELY(!thread_queue))
-     {
-        ERR("Failed to create thread queue");
-        goto cleanup;
-     }
-
-   if (!eina_thread_create(&scaling_thread, EINA_THREAD_NORMAL, -1,
-                           _evas_common_scale_sample_thread, NULL))
-     {
-        CRI("We failed to create the upscaling thread.");
-        goto cleanup;
-     }
-
-   use_thread = EINA_TRUE;
-   return;
-
-cleanup:
-   if (thread_queue) eina_thread_queue_free(thread_queue);
-   if (main_queue) eina_thread_queue_free(main_queue);
-}
-
-EAPI void
-evas_common_scale_sample_shutdown(void)
-{
-   Evas_Scale_Msg *msg;
-   void *ref;
-
-   if (!use_thread) return ;
-
-   ecore_fork_reset_callback_del(evas_common_scale_sample_fork_reset, NULL);
-
-   msg = eina_thread_queue_send(thread_queue, sizeof (Evas_Scale_Msg), &ref);
-   msg->task = NULL;
-   eina_thread_queue_send_done(thread_queue, ref);
-
-   /* Here is the thread commiting succide*/
-
-   msg = eina_thread_queue_wait(main_queue, &ref);
-   if (msg) eina_thread_queue_wait_done(main_queue, ref);
-
-   eina_thread_join(scaling_thread);
-
-   eina_thread_queue_free(thread_queue);
-   eina_thread_queue_free(main_queue);
-}
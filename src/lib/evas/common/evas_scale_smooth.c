@@ -109,199 +109,265 @@ scale_calc_a_points(int *p, int s, int d, int c, int cc)
 # undef SCALE_USING_NEON
 #endif
 
+#ifdef BUILD_SSE3
+/* the mmx scaler with the SSE3 kernels of evas_scale_smooth_sse3.c for
+ * bilinear upscaling and box downscaling */
+# undef SCALE_FUNC
+# define SCALE_FUNC _evas_common_scale_rgba_in_to_out_clip_smooth_sse3
+# define SCALE_USING_SSE3
+# include "evas_scale_smooth_scaler.c"
+# undef SCALE_USING_SSE3
+#endif
+
 #undef SCALE_FUNC
 #define SCALE_FUNC _evas_common_scale_rgba_in_to_out_clip_smooth_c
 #undef SCALE_USING_MMX
 #include "evas_scale_smooth_scaler.c"
 
-#ifdef BUILD_MMX
-Eina_Bool
-evas_common_scale_rgba_in_to_out_clip_smooth_mmx(RGBA_Image *src, RGBA_Image *dst,
-                                                 RGBA_Draw_Context *dc,
-                                                 int src_region_x, int src_region_y,
-                                                 int src_region_w, int src_region_h,
-                                                 int dst_region_x, int dst_region_y,
-                                                 int dst_region_w, int dst_region_h)
-{
-   int clip_x, clip_y, clip_w, clip_h;
-   DATA32 mul_col;
+typedef void (*Evas_Scale_Smooth_Func)(RGBA_Image *src, RGBA_Image *dst, int dst_clip_x, int dst_clip_y, int dst_clip_w, int dst_clip_h, DATA32 mul_col, int render_op, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h, RGBA_Image *mask_ie, int mask_x, int mask_y);
 
-   if (dc->clip.use)
-     {
-	clip_x = dc->clip.x;
-	clip_y = dc->clip.y;
-	clip_w = dc->clip.w;
-	clip_h = dc->clip.h;
-     }
-   else
-     {
-	clip_x = 0;
-	clip_y = 0;
-	clip_w = dst->cache_entry.w;
-	clip_h = dst->cache_entry.h;
-     }
+/* Large scales are split in horizontal bands of the destination, run in
+ * parallel with evas_common_band_run(). Every scaler computes its lines
+ * from their distance to dst_region, so a band gives the same pixels as
+ * the whole clip would.
+ */
+#define SMOOTH_BANDS_MAX 4
+#define SMOOTH_THREAD_MIN_PIXELS (256 * 256)
+#define SMOOTH_THREAD_MIN_LINES 64
 
-   mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
+typedef struct _Evas_Scale_Smooth_Job Evas_Scale_Smooth_Job;
+typedef struct _Evas_Scale_Smooth_Band Evas_Scale_Smooth_Band;
 
-   _evas_common_scale_rgba_in_to_out_clip_smooth_mmx
-     (src, dst,
-      clip_x, clip_y, clip_w, clip_h,
-      mul_col, dc->render_op,
-      src_region_x, src_region_y, src_region_w, src_region_h,
-      dst_region_x, dst_region_y, dst_region_w, dst_region_h,
-      dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
+struct _Evas_Scale_Smooth_Job
+{
+   Evas_Scale_Smooth_Func func;
+   RGBA_Image *src, *dst;
+   int dst_clip_x, dst_clip_w;
+   DATA32 mul_col;
+   int render_op;
+   int src_region_x, src_region_y, src_region_w, src_region_h;
+   int dst_region_x, dst_region_y, dst_region_w, dst_region_h;
+};
 
-   return EINA_TRUE;
-}
-#endif
+struct _Evas_Scale_Smooth_Band
+{
+   const Evas_Scale_Smooth_Job *job;
+   int y, h;
+};
 
-#ifdef BUILD_NEON
-Eina_Bool
-evas_common_scale_rgba_in_to_out_clip_smooth_neon(RGBA_Image *src, RGBA_Image *dst,
-                                                 RGBA_Draw_Context *dc,
-                                                 int src_region_x, int src_region_y,
-                                                 int src_region_w, int src_region_h,
-                                                 int dst_region_x, int dst_region_y,
-                                                 int dst_region_w, int dst_region_h)
+static void
+_evas_common_scale_smooth_band_run(void *data)
 {
-   int clip_x, clip_y, clip_w, clip_h;
-   DATA32 mul_col;
+   const Evas_Scale_Smooth_Band *band = data;
+   const Evas_Scale_Smooth_Job *job = band->job;
+
+   job->func(job->src, job->dst,
+             job->dst_clip_x, band->y, job->dst_clip_w, band->h,
+             job->mul_col, job->render_op,
+             job->src_region_x, job->src_region_y,
+             job->src_region_w, job->src_region_h,
+             job->dst_region_x, job->dst_region_y,
+             job->dst_region_w, job->dst_region_h,
+             NULL, 0, 0);
+}
 
-   if (dc->clip.use)
-     {
-	clip_x = dc->clip.x;
-	clip_y = dc->clip.y;
-	clip_w = dc->clip.w;
-	clip_h = dc->clip.h;
-     }
-   else
+static void
+_evas_common_scale_rgba_smooth_run(Evas_Scale_Smooth_Func func,
+                                   RGBA_Image *src, RGBA_Image *dst,
+                                   int dst_clip_x, int dst_clip_y,
+                                   int dst_clip_w, int dst_clip_h,
+                                   DATA32 mul_col, int render_op,
+                                   int src_region_x, int src_region_y,
+                                   int src_region_w, int src_region_h,
+                                   int dst_region_x, int dst_region_y,
+                                   int dst_region_w, int dst_region_h,
+                                   RGBA_Image *mask_ie, int mask_x, int mask_y)
+{
+   Evas_Scale_Smooth_Band bands[SMOOTH_BANDS_MAX];
+   void *todo[SMOOTH_BANDS_MAX];
+   Evas_Scale_Smooth_Job job;
+   int y0, y1, w, bh, count, i;
+
+   /* only the lines both in the clip and the region are drawn */
+   y0 = MAX(MAX(dst_clip_y, dst_region_y), 0);
+   y1 = MIN(MIN(dst_clip_y + dst_clip_h, dst_region_y + dst_region_h),
+            (int)dst->cache_entry.h);
+   w = MIN(dst_clip_w, dst_region_w);
+
+   /* the mask clipping of the scalers is not band safe */
+   if (mask_ie || ((y1 - y0) < SMOOTH_THREAD_MIN_LINES) ||
+       ((w * (y1 - y0)) < SMOOTH_THREAD_MIN_PIXELS))
+     goto single;
+
+   count = evas_common_band_begin();
+   if (count == 1) goto single;
+   if (count > SMOOTH_BANDS_MAX) count = SMOOTH_BANDS_MAX;
+
+   job.func = func;
+   job.src = src;
+   job.dst = dst;
+   job.dst_clip_x = dst_clip_x;
+   job.dst_clip_w = dst_clip_w;
+   job.mul_col = mul_col;
+   job.render_op = render_op;
+   job.src_region_x = src_region_x;
+   job.src_region_y = src_region_y;
+   job.src_region_w = src_region_w;
+   job.src_region_h = src_region_h;
+   job.dst_region_x = dst_region_x;
+   job.dst_region_y = dst_region_y;
+   job.dst_region_w = dst_region_w;
+   job.dst_region_h = dst_region_h;
+
+   bh = ((y1 - y0) + count - 1) / count;
+   for (i = 0; (i < count) && (y0 < y1); i++, y0 += bh)
      {
-	clip_x = 0;
-	clip_y = 0;
-	clip_w = dst->cache_entry.w;
-	clip_h = dst->cache_entry.h;
+        bands[i].job = &job;
+        bands[i].y = y0;
+        bands[i].h = MIN(bh, y1 - y0);
+        todo[i] = bands + i;
      }
 
-   mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
+   evas_common_band_run(_evas_common_scale_smooth_band_run, todo, i);
+   evas_common_band_end();
+   return;
 
-   _evas_common_scale_rgba_in_to_out_clip_smooth_neon
-     (src, dst,
-      clip_x, clip_y, clip_w, clip_h,
-      mul_col, dc->render_op,
-      src_region_x, src_region_y, src_region_w, src_region_h,
-      dst_region_x, dst_region_y, dst_region_w, dst_region_h,
-      dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
-
-   return EINA_TRUE;
+ single:
+   func(src, dst,
+        dst_clip_x, dst_clip_y, dst_clip_w, dst_clip_h,
+        mul_col, render_op,
+        src_region_x, src_region_y, src_region_w, src_region_h,
+        dst_region_x, dst_region_y, dst_region_w, dst_region_h,
+        mask_ie, mask_x, mask_y);
 }
-#endif
 
-Eina_Bool
-evas_common_scale_rgba_in_to_out_clip_smooth_c(RGBA_Image *src, RGBA_Image *dst,
-                                               RGBA_Draw_Context *dc,
-                                               int src_region_x, int src_region_y,
-                                               int src_region_w, int src_region_h,
-                                               int dst_region_x, int dst_region_y,
-                                               int dst_region_w, int dst_region_h)
+static Evas_Scale_Smooth_Func
+_evas_common_scale_rgba_smooth_func_get(void)
 {
-   int clip_x, clip_y, clip_w, clip_h;
-   DATA32 mul_col;
+#ifdef BUILD_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     return _evas_common_scale_rgba_in_to_out_clip_smooth_sse3;
+#endif
+#ifdef BUILD_MMX
+   int mmx, sse, sse2;
 
-   if (dc->clip.use)
-     {
-	clip_x = dc->clip.x;
-	clip_y = dc->clip.y;
-	clip_w = dc->clip.w;
-	clip_h = dc->clip.h;
-     }
-   else
-     {
-	clip_x = 0;
-	clip_y = 0;
-	clip_w = dst->cache_entry.w;
-	clip_h = dst->cache_entry.h;
-     }
+   evas_common_cpu_can_do(&mmx, &sse, &sse2);
+   if (mmx)
+     return _evas_common_scale_rgba_in_to_out_clip_smooth_mmx;
+#endif
+#ifdef BUILD_NEON
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     return _evas_common_scale_rgba_in_to_out_clip_smooth_neon;
+#endif
+   return _evas_common_scale_rgba_in_to_out_clip_smooth_c;
+}
 
-   mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;
+#define SMOOTH_CLIP_CB(Name, Func)                                      \
+Eina_Bool                                                               \
+Name(RGBA_Image *src, RGBA_Image *dst,                                  \
+     RGBA_Draw_Context *dc,                                             \
+     int src_region_x, int src_region_y,                                \
+     int src_region_w, int src_region_h,                                \
+     int dst_region_x, int dst_region_y,                                \
+     int dst_region_w, int dst_region_h)                                \
+{                                                                       \
+   int clip_x, clip_y, clip_w, clip_h;                                  \
+   DATA32 mul_col;                                                      \
+                                                                        \
+   if (dc->clip.use)                                                    \
+     {                                                                  \
+        clip_x = dc->clip.x;                                            \
+        clip_y = dc->clip.y;                                            \
+        clip_w = dc->clip.w;                                            \
+        clip_h = dc->clip.h;                                            \
+     }                                                                  \
+   else                                                                 \
+     {                                                                  \
+        clip_x = 0;                                                     \
+        clip_y = 0;                                                     \
+        clip_w = dst->cache_entry.w;                                    \
+        clip_h = dst->cache_entry.h;                                    \
+     }                                                                  \
+                                                                        \
+   mul_col = dc->mul.use ? dc->mul.col : 0xffffffff;                    \
+                                                                        \
+   _evas_common_scale_rgba_smooth_run                                   \
+     (Func, src, dst,                                                   \
+      clip_x, clip_y, clip_w, clip_h,                                   \
+      mul_col, dc->render_op,                                           \
+      src_region_x, src_region_y, src_region_w, src_region_h,           \
+      dst_region_x, dst_region_y, dst_region_w, dst_region_h,           \
+      dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);                 \
+                                                                        \
+   return EINA_TRUE;                                                    \
+}
 
-   _evas_common_scale_rgba_in_to_out_clip_smooth_c
-     (src, dst,
-      clip_x, clip_y, clip_w, clip_h,
-      mul_col, dc->render_op,
-      src_region_x, src_region_y, src_region_w, src_region_h,
-      dst_region_x, dst_region_y, dst_region_w, dst_region_h,
-      dc->clip.mask, dc->clip.mask_x, dc->clip.mask_y);
+#ifdef BUILD_SSE3
+SMOOTH_CLIP_CB(evas_common_scale_rgba_in_to_out_clip_smooth_sse3,
+               _evas_common_scale_rgba_in_to_out_clip_smooth_sse3)
+#endif
 
-   return EINA_TRUE;
-}
+#ifdef BUILD_MMX
+SMOOTH_CLIP_CB(evas_common_scale_rgba_in_to_out_clip_smooth_mmx,
+               _evas_common_scale_rgba_in_to_out_clip_smooth_mmx)
+#endif
 
-EAPI Eina_Bool
-evas_common_scale_rgba_in_to_out_clip_smooth(RGBA_Image *src, RGBA_Image *dst,
-                                             RGBA_Draw_Context *dc,
-                                             int src_region_x, int src_region_y,
-                                             int src_region_w, int src_region_h,
-                                             int dst_region_x, int dst_region_y,
-                                             int dst_region_w, int dst_region_h)
+#ifdef BUILD_NEON
+SMOOTH_CLIP_CB(evas_common_scale_rgba_in_to_out_clip_smooth_neon,
+               _evas_common_scale_rgba_in_to_out_clip_smooth_neon)
+#endif
+
+SMOOTH_CLIP_CB(evas_common_scale_rgba_in_to_out_clip_smooth_c,
+               _evas_common_scale_rgba_in_to_out_clip_smooth_c)
+
+static Evas_Common_Scale_In_To_Out_Clip_Cb
+_evas_common_scale_rgba_in_to_out_clip_smooth_cb_get(void)
 {
-   Evas_Common_Scale_In_To_Out_Clip_Cb cb;
+#ifdef BUILD_SSE3
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
+     return evas_common_scale_rgba_in_to_out_clip_smooth_sse3;
+#endif
 #ifdef BUILD_MMX
    int mmx, sse, sse2;
 
    evas_common_cpu_can_do(&mmx, &sse, &sse2);
    if (mmx)
-     cb = evas_common_scale_rgba_in_to_out_clip_smooth_mmx;
-   else
+     return evas_common_scale_rgba_in_to_out_clip_smooth_mmx;
 #endif
 #ifdef BUILD_NEON
-     if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
-       cb = evas_common_scale_rgba_in_to_out_clip_smooth_neon;
-   else
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     return evas_common_scale_rgba_in_to_out_clip_smooth_neon;
 #endif
-     cb = evas_common_scale_rgba_in_to_out_clip_smooth_c;
+   return evas_common_scale_rgba_in_to_out_clip_smooth_c;
+}
 
+EAPI Eina_Bool
+evas_common_scale_rgba_in_to_out_clip_smooth(RGBA_Image *src, RGBA_Image *dst,
+                                             RGBA_Draw_Context *dc,
+                                             int src_region_x, int src_region_y,
+                                             int src_region_w, int src_region_h,
+                                             int dst_region_x, int dst_region_y,
+                                             int dst_region_w, int dst_region_h)
+{
    return evas_common_scale_rgba_in_to_out_clip_cb(src, dst, dc,
                                                    src_region_x, src_region_y,
                                                    src_region_w, src_region_h,
                                                    dst_region_x, dst_region_y,
                                                    dst_region_w, dst_region_h,
-                                                   cb);
+                                                   _evas_common_scale_rgba_in_to_out_clip_smooth_cb_get());
 }
 
 EAPI void
 evas_common_scale_rgba_smooth_draw(RGBA_Image *src, RGBA_Image *dst, int dst_clip_x, int dst_clip_y, int dst_clip_w, int dst_clip_h, DATA32 mul_col, int render_op, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h, RGBA_Image *mask_ie, int mask_x, int mask_y)
 {
-#ifdef BUILD_MMX
-   int mmx, sse, sse2;
-
-   evas_common_cpu_can_do(&mmx, &sse, &sse2);
-   if (mmx)
-     _evas_common_scale_rgba_in_to_out_clip_smooth_mmx
-       (src, dst,
-        dst_clip_x, dst_clip_y, dst_clip_w, dst_clip_h,
-        mul_col, render_op,
-        src_region_x, src_region_y, src_region_w, src_region_h,
-        dst_region_x, dst_region_y, dst_region_w, dst_region_h,
-        mask_ie, mask_x, mask_y);
-   else
-#endif
-#ifdef BUILD_NEON
-     if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
-       _evas_common_scale_rgba_in_to_out_clip_smooth_neon
-     (src, dst,
-         dst_clip_x, dst_clip_y, dst_clip_w, dst_clip_h,
-         mul_col, render_op,
-         src_region_x, src_region_y, src_region_w, src_region_h,
-         dst_region_x, dst_region_y, dst_region_w, dst_region_h,
-         mask_ie, mask_x, mask_y);
-   else
-#endif
-     _evas_common_scale_rgba_in_to_out_clip_smooth_c
-       (src, dst,
-        dst_clip_x, dst_clip_y, dst_clip_w, dst_clip_h,
-        mul_col, render_op,
-        src_region_x, src_region_y, src_region_w, src_region_h,
-        dst_region_x, dst_region_y, dst_region_w, dst_region_h,
-        mask_ie, mask_x, mask_y);
+   _evas_common_scale_rgba_smooth_run
+     (_evas_common_scale_rgba_smooth_func_get(),
+      src, dst,
+      dst_clip_x, dst_clip_y, dst_clip_w, dst_clip_h,
+      mul_col, render_op,
+      src_region_x, src_region_y, src_region_w, src_region_h,
+      dst_region_x, dst_region_y, dst_region_w, dst_region_h,
+      mask_ie, mask_x, mask_y);
 }
 
 EAPI void
@@ -314,42 +380,20 @@ evas_common_scale_rgba_in_to_out_clip_smooth_do(const Cutout_Rects *reuse,
 						int dst_region_x, int dst_region_y,
 						int dst_region_w, int dst_region_h)
 {
-# ifdef BUILD_MMX
-   int mmx, sse, sse2;
-# endif
+   Evas_Common_Scale_In_To_Out_Clip_Cb cb;
    Eina_Rectangle area;
    Cutout_Rect *r;
    int i;
 
-# ifdef BUILD_MMX
-   evas_common_cpu_can_do(&mmx, &sse, &sse2);
-# endif
+   cb = _evas_common_scale_rgba_in_to_out_clip_smooth_cb_get();
    if (!reuse)
      {
         evas_common_draw_context_clip_clip(dc, clip->x, clip->y, clip->w, clip->h);
-# ifdef BUILD_MMX
-	if (mmx)
-	  evas_common_scale_rgba_in_to_out_clip_smooth_mmx(src, dst, dc,
-					       src_region_x, src_region_y,
-					       src_region_w, src_region_h,
-					       dst_region_x, dst_region_y,
-					       dst_region_w, dst_region_h);
-	else
-# endif
-#ifdef BUILD_NEON
-          if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
-            evas_common_scale_rgba_in_to_out_clip_smooth_neon(src, dst, dc,
-                                                              src_region_x, src_region_y,
-                                                              src_region_w, src_region_h,
-                                                              dst_region_x, dst_region_y,
-                                                              dst_region_w, dst_region_h);
-        else
-#endif
-	  evas_common_scale_rgba_in_to_out_clip_smooth_c(src, dst, dc,
-                                                         src_region_x, src_region_y,
-                                                         src_region_w, src_region_h,
-                                                         dst_region_x, dst_region_y,
-                                                         dst_region_w, dst_region_h);
+        cb(src, dst, dc,
+           src_region_x, src_region_y,
+           src_region_w, src_region_h,
+           dst_region_x, dst_region_y,
+           dst_region_w, dst_region_h);
         return;
      }
 
@@ -360,28 +404,10 @@ evas_common_scale_rgba_in_to_out_clip_smooth_do(const Cutout_Rects *reuse,
         EINA_RECTANGLE_SET(&area, r->x, r->y, r->w, r->h);
         if (!eina_rectangle_intersection(&area, clip)) continue ;
         evas_common_draw_context_set_clip(dc, area.x, area.y, area.w, area.h);
-# ifdef BUILD_MMX
-	if (mmx)
-	  evas_common_scale_rgba_in_to_out_clip_smooth_mmx(src, dst, dc,
-					       src_region_x, src_region_y,
-					       src_region_w, src_region_h,
-					       dst_region_x, dst_region_y,
-					       dst_region_w, dst_region_h);
-	else
-# endif
-#ifdef BUILD_NEON
-          if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
-            evas_common_scale_rgba_in_to_out_clip_smooth_neon(src, dst, dc,
-                                                              src_region_x, src_region_y,
-                                                              src_region_w, src_region_h,
-                                                              dst_region_x, dst_region_y,
-                                                              dst_region_w, dst_region_h);
-        else
-#endif
-            evas_common_scale_rgba_in_to_out_clip_smooth_c(src, dst, dc,
-                                                         src_region_x, src_region_y,
-                                                         src_region_w, src_region_h,
-                                                         dst_region_x, dst_region_y,
-                                                         dst_region_w, dst_region_h);
+        cb(src, dst, dc,
+           src_region_x, src_region_y,
+           src_region_w, src_region_h,
+           dst_region_x, dst_region_y,
+           dst_region_w, dst_region_h);
      }
 }
@@ -2,6 +2,13 @@
 #define _EVAS_SCALE_SMOOTH_H
 
 EAPI Eina_Bool evas_common_scale_rgba_in_to_out_clip_smooth_mmx  (RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_Context *dc, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h);
+EAPI Eina_Bool evas_common_scale_rgba_in_to_out_clip_smooth_sse3 (RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_Context *dc, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h);
 EAPI Eina_Bool evas_common_scale_rgba_in_to_out_clip_smooth_c    (RGBA_Image *src, RGBA_Image *dst, RGBA_Draw_Context *dc, int src_region_x, int src_region_y, int src_region_w, int src_region_h, int dst_region_x, int dst_region_y, int dst_region_w, int dst_region_h);
 
+#ifdef BUILD_SSE3
+/* return the number of pixels done, the rest is left to the caller */
+int  evas_common_scale_rgba_smooth_up_row_sse3 (const DATA32 *psrc, int src_w, int srw, DATA32 *dst, int w, int sxx, int dsxx, int ay);
+void evas_common_scale_rgba_box_row_sse3       (DATA32 *dst, int w, const DATA32 *row, const int *xp, const int *xapp, int Cy, int yap, int src_w, Eina_Bool alpha);
+#endif
+
 #endif /* _EVAS_SCALE_SMOOTH_H */
@@ -4,7 +4,10 @@
    int Cx, Cy, i, j;
    DATA32 *dptr, *sptr, *pix, *pbuf;
    DATA8 *mask;
-   int a, r, g, b, rx, gx, bx, ax;
+   int a, r, g, b, rx, gx, bx;
+#ifndef SCALE_USING_SSE3
+   int ax;
+#endif
    int xap, yap, pos;
    int y = 0;
 #ifdef BILINEAR_HALF_TO_FULL_SCALE
@@ -162,6 +165,10 @@
                   Cy = *yapp >> 16;
                   yap = *yapp & 0xffff;
 
+#ifdef SCALE_USING_SSE3
+                  evas_common_scale_rgba_box_row_sse3(pbuf, w, *yp + pos, xp, xapp,
+                                                      Cy, yap, src_w, EINA_TRUE);
+#else
                   while (dst_clip_w--)
                     {
                        Cx = *xapp >> 16;
@@ -263,6 +270,7 @@
                                            ((b + (1 << 4)) >> 5));
                        xp++;  xapp++;
                     }
+#endif
 
                   if (!mask_ie)
                     func(buf, NULL, mul_col, dptr, w);
@@ -607,6 +615,10 @@
                        Cy = *yapp >> 16;
                        yap = *yapp & 0xffff;
 
+#ifdef SCALE_USING_SSE3
+                       evas_common_scale_rgba_box_row_sse3(pbuf, w, *yp + pos, xp, xapp,
+                                                           Cy, yap, src_w, EINA_FALSE);
+#else
                        while (dst_clip_w--)
                          {
                             Cx = *xapp >> 16;
@@ -696,6 +708,7 @@
                                                 ((b + (1 << 4)) >> 5));
                             xp++;  xapp++;
                          }
+#endif
 
                        if (!mask_ie)
                          func(buf, NULL, mul_col, dptr, w);
@@ -220,6 +220,19 @@
 #endif
 	    pbuf = buf;  pbuf_end = buf + dst_clip_w;
 	    sxx = sxx0;
+#ifdef SCALE_USING_SSE3
+	    /* the kernel needs the line below, the last one is left to C */
+	    if ((sy + 1) < srh)
+	      {
+		 int done;
+
+		 done = evas_common_scale_rgba_smooth_up_row_sse3(psrc, src_w, srw,
+								   pbuf, dst_clip_w,
+								   sxx, dsxx, ay);
+		 pbuf += done;
+		 sxx += done * dsxx;
+	      }
+#endif
 #ifdef SCALE_USING_NEON
 	    while (pbuf+1 < pbuf_end) // 2 iterations only for NEON
 #else
@@ -0,0 +1,132 @@
+#include "evas_common_private.h"
+#include "evas_scale_smooth.h"
+
+#ifdef BUILD_SSE3
+# include <immintrin.h>
+
+/* Both kernels give the exact same result as the C scalers: the bilinear
+ * one computes INTERP_256() as (c0 * a + c1 * (256 - a)) >> 8 which never
+ * overflows 16 bits, the box one keeps the per channel truncations of
+ * evas_scale_smooth_scaler_downx_downy.c with 4 channels in 32 bits lanes.
+ */
+
+static inline __m128i
+_evas_scale_interp_weights(int a)
+{
+   return _mm_set_epi16(a, a, a, a, 256 - a, 256 - a, 256 - a, 256 - a);
+}
+
+/* horizontal interpolation of 2 pixels, p points to the 2 source pixels
+ * needed by each of them */
+static inline __m128i
+_evas_scale_interp_x2(const DATA32 *p0, const DATA32 *p1, __m128i w0, __m128i w1)
+{
+   __m128i zero = _mm_setzero_si128();
+   __m128i m0, m1;
+
+   m0 = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p0), zero), w0);
+   m1 = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p1), zero), w1);
+   return _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(m0, m1),
+                                       _mm_unpackhi_epi64(m0, m1)), 8);
+}
+
+int
+evas_common_scale_rgba_smooth_up_row_sse3(const DATA32 *psrc, int src_w, int srw,
+                                          DATA32 *dst, int w,
+                                          int sxx, int dsxx, int ay)
+{
+   const DATA32 *q = psrc + src_w;
+   __m128i way = _mm_set1_epi16(ay), wiay = _mm_set1_epi16(256 - ay);
+   int xx;
+
+   for (xx = 0; xx < (w - 3); xx += 4)
+     {
+        __m128i wx[4], h01, h23, v01, v23;
+        int sx[4], k;
+
+        for (k = 0; k < 4; k++)
+          {
+             sx[k] = sxx >> 16;
+             wx[k] = _evas_scale_interp_weights(1 + ((sxx - (sx[k] << 16)) >> 8));
+             sxx += dsxx;
+          }
+        /* the last pixels of a line have no right neighbour, leave them
+         * to the caller */
+        if ((sx[3] + 1) >= srw) break;
+
+        h01 = _evas_scale_interp_x2(psrc + sx[0], psrc + sx[1], wx[0], wx[1]);
+        h23 = _evas_scale_interp_x2(psrc + sx[2], psrc + sx[3], wx[2], wx[3]);
+        v01 = _evas_scale_interp_x2(q + sx[0], q + sx[1], wx[0], wx[1]);
+        v23 = _evas_scale_interp_x2(q + sx[2], q + sx[3], wx[2], wx[3]);
+
+        h01 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(h01, wiay),
+                                           _mm_mullo_epi16(v01, way)), 8);
+        h23 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(h23, wiay),
+                                           _mm_mullo_epi16(v23, way)), 8);
+        _mm_storeu_si128((__m128i *)(dst + xx), _mm_packus_epi16(h01, h23));
+     }
+
+   return xx;
+}
+
+/* one source line of a box: lanes hold (channel * weight) >> 9 */
+static inline __m128i
+_evas_scale_box_line(const DATA32 *pix, int xap, int Cx)
+{
+   __m128i zero = _mm_setzero_si128();
+   __m128i p, acc;
+   int i;
+
+   p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*pix), zero), zero);
+   acc = _mm_srai_epi32(_mm_madd_epi16(p, _mm_set1_epi32(xap)), 9);
+   pix++;
+   for (i = (1 << 14) - xap; i > Cx; i -= Cx)
+     {
+        p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*pix), zero), zero);
+        acc = _mm_add_epi32(acc, _mm_srai_epi32(_mm_madd_epi16(p, _mm_set1_epi32(Cx)), 9));
+        pix++;
+     }
+   if (i > 0)
+     {
+        p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*pix), zero), zero);
+        acc = _mm_add_epi32(acc, _mm_srai_epi32(_mm_madd_epi16(p, _mm_set1_epi32(i)), 9));
+     }
+   return acc;
+}
+
+void
+evas_common_scale_rgba_box_row_sse3(DATA32 *dst, int w, const DATA32 *row,
+                                    const int *xp, const int *xapp,
+                                    int Cy, int yap, int src_w, Eina_Bool alpha)
+{
+   __m128i round = _mm_set1_epi32(1 << 4);
+   __m128i opaque = _mm_set1_epi32(alpha ? 0 : 0xff000000);
+   int xx, j;
+
+   for (xx = 0; xx < w; xx++)
+     {
+        const DATA32 *sptr = row + xp[xx];
+        int Cx = xapp[xx] >> 16;
+        int xap = xapp[xx] & 0xffff;
+        __m128i acc;
+
+        /* the line sums are below 1 << 13, madd can weight them again */
+        acc = _mm_srai_epi32(_mm_madd_epi16(_evas_scale_box_line(sptr, xap, Cx),
+                                            _mm_set1_epi32(yap)), 14);
+        sptr += src_w;
+        for (j = (1 << 14) - yap; j > Cy; j -= Cy)
+          {
+             acc = _mm_add_epi32(acc, _mm_srai_epi32(_mm_madd_epi16(_evas_scale_box_line(sptr, xap, Cx),
+                                                                    _mm_set1_epi32(Cy)), 14));
+             sptr += src_w;
+          }
+        if (j > 0)
+          acc = _mm_add_epi32(acc, _mm_srai_epi32(_mm_madd_epi16(_evas_scale_box_line(sptr, xap, Cx),
+                                                                 _mm_set1_epi32(j)), 14));
+
+        acc = _mm_srai_epi32(_mm_add_epi32(acc, round), 5);
+        acc = _mm_packus_epi16(_mm_packs_epi32(acc, acc), acc);
+        dst[xx] = _mm_cvtsi128_si32(_mm_or_si128(acc, opaque));
+     }
+}
+#endif
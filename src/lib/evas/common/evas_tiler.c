@@ -1,6 +1,34 @@
 #include "evas_common_private.h"
 #include "region.h"
 
+// Damage statistics shared by all tilebufs, see evas_damage_stats_get()
+static Evas_Damage_Stats _tilebuf_stats = { 0 };
+
+static inline void
+_tilebuf_stats_redraw(int w, int h)
+{
+   _tilebuf_stats.redraws++;
+   _tilebuf_stats.redraws_area += (unsigned long long)w * h;
+}
+
+static inline void
+_tilebuf_stats_update(int w, int h)
+{
+   _tilebuf_stats.updates++;
+   _tilebuf_stats.updates_area += (unsigned long long)w * h;
+}
+
+EAPI void
+evas_common_tilebuf_stats_get(Evas_Damage_Stats *stats)
+{
+   *stats = _tilebuf_stats;
+}
+
+EAPI void
+evas_common_tilebuf_stats_reset(void)
+{
+   memset(&_tilebuf_stats, 0, sizeof (_tilebuf_stats));
+}
 
 #ifdef NEWTILER
 EAPI void
@@ -45,6 +73,7 @@ evas_common_tilebuf_tile_strict_set(Tilebuf *tb EINA_UNUSED, Eina_Bool strict EI
 EAPI int
 evas_common_tilebuf_add_redraw(Tilebuf *tb, int x, int y, int w, int h)
 {
+   _tilebuf_stats_redraw(w, h);
    region_rect_add(tb->region, x, y, w, h);
    return 1;
 }
@@ -124,6 +153,7 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
         return NULL;
      }
 
+   _tilebuf_stats.frames++;
    rend = rbuf + n;
    rs = rects2;
    for (r = rbuf; r < rend; r++)
@@ -135,6 +165,7 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
         r->y = rs->y1;
         r->w = rs->x2 - rs->x1;
         r->h = rs->y2 - rs->y1;
+        _tilebuf_stats_update(r->w, r->h);
         rs++;
         rects = (Tilebuf_Rect *)
           eina_inlist_append(EINA_INLIST_GET(rects),
@@ -830,11 +861,75 @@ _add_redraw(list_t *rects, int x, int y, int w, int h, int fuzz)
    return 1;
 }
 
+// EVAS_TILER_STRATEGY=fuzzy|grid|cost makes the tilebufs hand their
+// rectangles to an eina_tiler using that strategy instead of merging them
+// here, -1 keeps the built in merging
+static int _tilebuf_strategy = -1;
+
+static Tilebuf_Rect *
+_tilebuf_tiler_render_rects(Tilebuf *tb)
+{
+   Eina_Rectangle buf[MAXREG], *rect;
+   Eina_Iterator *it;
+   Tilebuf_Rect *rects = NULL, *rbuf, *r;
+   int bx1 = 0, bx2 = 0, by1 = 0, by2 = 0, num = 0, i;
+
+   it = eina_tiler_iterator_new(tb->tiler);
+   if (!it) return NULL;
+   EINA_ITERATOR_FOREACH(it, rect)
+     {
+        if (num < MAXREG) buf[num] = *rect;
+        if ((!num) || (rect->x < bx1)) bx1 = rect->x;
+        if ((!num) || (rect->y < by1)) by1 = rect->y;
+        if ((!num) || (rect->x + rect->w > bx2)) bx2 = rect->x + rect->w;
+        if ((!num) || (rect->y + rect->h > by2)) by2 = rect->y + rect->h;
+        num++;
+     }
+   eina_iterator_free(it);
+   if (!num) return NULL;
+
+   _tilebuf_stats.frames++;
+
+   if (num > MAXREG)
+     {
+        _tilebuf_stats.bounded++;
+        EINA_RECTANGLE_SET(&buf[0], bx1, by1, bx2 - bx1, by2 - by1);
+        num = 1;
+     }
+
+   rbuf = malloc(sizeof(Tilebuf_Rect) * num);
+   if (!rbuf) return NULL;
+
+   for (i = 0; i < num; i++)
+     {
+        r = &(rbuf[i]);
+        EINA_INLIST_GET(r)->next = NULL;
+        EINA_INLIST_GET(r)->prev = NULL;
+        EINA_INLIST_GET(r)->last = NULL;
+        r->x = buf[i].x;
+        r->y = buf[i].y;
+        r->w = buf[i].w;
+        r->h = buf[i].h;
+        _tilebuf_stats_update(r->w, r->h);
+        rects = (Tilebuf_Rect *)
+          eina_inlist_append(EINA_INLIST_GET(rects), EINA_INLIST_GET(r));
+     }
+   return rects;
+}
+
 /////////////////////////////////////////////////////////////////
 
 EAPI void
 evas_common_tilebuf_init(void)
 {
+   const char *s = getenv("EVAS_TILER_STRATEGY");
+
+   _tilebuf_strategy = -1;
+   if (!s) return;
+   if (!strcmp(s, "fuzzy")) _tilebuf_strategy = EINA_TILER_STRATEGY_FUZZY;
+   else if (!strcmp(s, "grid")) _tilebuf_strategy = EINA_TILER_STRATEGY_GRID;
+   else if (!strcmp(s, "cost")) _tilebuf_strategy = EINA_TILER_STRATEGY_COST;
+   else ERR("Unknown EVAS_TILER_STRATEGY '%s', use fuzzy, grid or cost", s);
 }
 
 EAPI Tilebuf *
@@ -848,12 +943,23 @@ evas_common_tilebuf_new(int w, int h)
    tb->tile_size.h = 8;
    tb->outbuf_w = w;
    tb->outbuf_h = h;
+   if (_tilebuf_strategy >= 0)
+     {
+        tb->tiler = eina_tiler_new(w, h);
+        if (tb->tiler)
+          {
+             eina_tiler_tile_size_set(tb->tiler,
+                                      tb->tile_size.w, tb->tile_size.h);
+             eina_tiler_strategy_set(tb->tiler, _tilebuf_strategy);
+          }
+     }
    return tb;
 }
 
 EAPI void
 evas_common_tilebuf_free(Tilebuf *tb)
 {
+   if (tb->tiler) eina_tiler_free(tb->tiler);
    rect_list_clear(&tb->rects);
    rect_list_node_pool_flush();
    free(tb);
@@ -864,6 +970,7 @@ evas_common_tilebuf_set_tile_size(Tilebuf *tb, int tw, int th)
 {
    tb->tile_size.w = tw;
    tb->tile_size.h = th;
+   if (tb->tiler) eina_tiler_tile_size_set(tb->tiler, tw, th);
 }
 
 EAPI void
@@ -877,6 +984,7 @@ EAPI void
 evas_common_tilebuf_tile_strict_set(Tilebuf *tb, Eina_Bool strict)
 {
    tb->strict_tiles = strict;
+   if (tb->tiler) eina_tiler_strict_set(tb->tiler, strict);
 }
 
 EAPI int
@@ -891,6 +999,14 @@ evas_common_tilebuf_add_redraw(Tilebuf *tb, int x, int y, int w, int h)
    tb->prev_add.x = x; tb->prev_add.y = y;
    tb->prev_add.w = w; tb->prev_add.h = h;
    tb->prev_del.w = 0; tb->prev_del.h = 0;
+   _tilebuf_stats_redraw(w, h);
+   if (tb->tiler)
+     {
+        Eina_Rectangle r;
+
+        EINA_RECTANGLE_SET(&r, x, y, w, h);
+        return eina_tiler_rect_add(tb->tiler, &r);
+     }
    return _add_redraw(&tb->rects, x, y, w, h, FUZZ * FUZZ);
 }
 
@@ -899,7 +1015,11 @@ evas_common_tilebuf_del_redraw(Tilebuf *tb, int x, int y, int w, int h)
 {
    rect_t r;
 
-   if (!tb->rects.head) return 0;
+   if (tb->tiler)
+     {
+        if (eina_tiler_empty(tb->tiler)) return 0;
+     }
+   else if (!tb->rects.head) return 0;
    if ((w <= 0) || (h <= 0)) return 0;
    RECTS_CLIP_TO_RECT(x, y, w, h, 0, 0, tb->outbuf_w, tb->outbuf_h);
    if ((w <= 0) || (h <= 0)) return 0;
@@ -909,6 +1029,14 @@ evas_common_tilebuf_del_redraw(Tilebuf *tb, int x, int y, int w, int h)
    tb->prev_del.x = x; tb->prev_del.y = y;
    tb->prev_del.w = w; tb->prev_del.h = h;
    tb->prev_add.w = 0; tb->prev_add.h = 0;
+   if (tb->tiler)
+     {
+        Eina_Rectangle er;
+
+        EINA_RECTANGLE_SET(&er, x, y, w, h);
+        eina_tiler_rect_del(tb->tiler, &er);
+        return 0;
+     }
    rect_init(&r, x, y, w, h);
    rect_list_del_split_strict(&tb->rects, r);
    tb->need_merge = 1;
@@ -928,6 +1056,7 @@ evas_common_tilebuf_clear(Tilebuf *tb)
    tb->prev_del.x = tb->prev_del.y = tb->prev_del.w = tb->prev_del.h = 0;
    rect_list_clear(&tb->rects);
    tb->need_merge = 0;
+   if (tb->tiler) eina_tiler_clear(tb->tiler);
 }
 
 EAPI Tilebuf_Rect *
@@ -938,6 +1067,8 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
    Tilebuf_Rect *rects = NULL, *rbuf, *r;
    int bx1 = 0, bx2 = 0, by1 = 0, by2 = 0, num = 0, x1, x2, y1, y2, i;
 
+   if (tb->tiler) return _tilebuf_tiler_render_rects(tb);
+
 /* don't need this since the below is now always on
    if (tb->need_merge)
      {
@@ -1003,10 +1134,13 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
      }
    else
      return NULL;
-   
+
+   _tilebuf_stats.frames++;
+
    /* magic number - if we have > MAXREG regions to update, take bounding */
    if (num > MAXREG)
      {
+        _tilebuf_stats.bounded++;
         r = malloc(sizeof(Tilebuf_Rect));
         if (r)
           {
@@ -1017,6 +1151,7 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
              r->y = by1;
              r->w = bx2 - bx1;
              r->h = by2 - by1;
+             _tilebuf_stats_update(r->w, r->h);
              rects = (Tilebuf_Rect *)
                eina_inlist_append(EINA_INLIST_GET(rects),
                                   EINA_INLIST_GET(r));
@@ -1042,6 +1177,7 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
              r->y = cur.top;
              r->w = cur.width;
              r->h = cur.height;
+             _tilebuf_stats_update(r->w, r->h);
              rects = (Tilebuf_Rect *)
                eina_inlist_append(EINA_INLIST_GET(rects),
                                   EINA_INLIST_GET(r));
@@ -386,6 +386,7 @@ typedef struct _Image_Entry             Image_Entry;
 typedef struct _Image_Entry_Flags       Image_Entry_Flags;
 typedef struct _Image_Entry_Frame       Image_Entry_Frame;
 typedef struct _Image_Timestamp         Image_Timestamp;
+typedef struct _Image_Entry_Key         Image_Entry_Key;
 typedef struct _Engine_Image_Entry      Engine_Image_Entry;
 typedef struct _Evas_Cache_Target       Evas_Cache_Target;
 typedef struct _Evas_Preload_Pthread    Evas_Preload_Pthread;
@@ -555,6 +556,24 @@ struct _Image_Timestamp
 #endif
 };
 
+/* binary lookup key of file backed entries, opts is zeroed when the load
+ * options do not matter so it can be compared with memcmp() */
+struct _Image_Entry_Key
+{
+   const char            *file;
+   const char            *key;
+   unsigned int           file_len;
+   unsigned int           key_len;
+   struct
+     {
+        double            dpi;
+        int               scale_down_by;
+        unsigned int      w, h;
+        int               region_x, region_y, region_w, region_h;
+        Eina_Bool         orientation;
+     } opts;
+};
+
 struct _Image_Entry
 {
    EINA_INLIST;
@@ -572,6 +591,8 @@ struct _Image_Entry
    Evas_Preload_Pthread  *preload;
 
    Image_Timestamp        tstamp;
+   Image_Entry_Key        hkey;
+   double                 validated; // last time tstamp was checked on disk
 
    int                    references;
 
@@ -956,6 +977,7 @@ struct _Tilebuf
    struct {
       int x, y, w, h;
    } prev_add, prev_del;
+   Eina_Tiler *tiler; // set when EVAS_TILER_STRATEGY picks an eina_tiler strategy
    Eina_Bool strict_tiles : 1;
 #endif
 };
@@ -1065,6 +1087,7 @@ EAPI void evas_common_cpu_end_opt                       (void);
 EAPI Gfx_Func_Copy        evas_common_draw_func_copy_get        (int pixels, int reverse);
 
 /****/
+#include "../common/evas_band.h"
 #include "../common/evas_convert_color.h"
 #include "../common/evas_convert_colorspace.h"
 #include "../common/evas_convert_main.h"
@@ -1102,6 +1125,8 @@ EAPI int           evas_common_tilebuf_add_motion_vector (Tilebuf *tb, int x, in
 EAPI void          evas_common_tilebuf_clear             (Tilebuf *tb);
 EAPI Tilebuf_Rect *evas_common_tilebuf_get_render_rects  (Tilebuf *tb);
 EAPI void          evas_common_tilebuf_free_render_rects (Tilebuf_Rect *rects);
+EAPI void          evas_common_tilebuf_stats_get         (Evas_Damage_Stats *stats);
+EAPI void          evas_common_tilebuf_stats_reset       (void);
 
 /*
 Regionbuf    *evas_common_regionbuf_new       (int w, int h);
@@ -1143,6 +1168,10 @@ typedef enum _Evas_Render_Mode
 
 void evas_common_rgba_image_scalecache_items_ref(Image_Entry *ie, Eina_Array *ret);
 void evas_common_rgba_image_scalecache_item_unref(Image_Entry *ie);
+/* deepest level, boxes are at most 256x256 source pixels */
+#define EVAS_MIPMAP_LEVELS 8
+RGBA_Image *evas_common_rgba_image_scalecache_mipmap_ref(Image_Entry *ie, int level);
+void evas_common_rgba_image_scalecache_mipmap_unref(Image_Entry *ie, RGBA_Image *mip);
 
 // Generic Cache
 typedef struct _Generic_Cache          Generic_Cache;
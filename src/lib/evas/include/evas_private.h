@@ -756,6 +756,10 @@ typedef struct
    Eina_Rectangle        rect;
 #endif
    Evas_Object_Protected_Data *obj;
+   // Smart members are pushed right after their parent, so a smart object
+   // and its whole subtree form a contiguous run of entries.
+   Eina_Rectangle        subtree_rect; // union of the clip of the subtree
+   unsigned int          subtree_len; // entries following that are in the subtree
 } Evas_Active_Entry;
 
 typedef struct Evas_Pointer_Seat
@@ -920,6 +924,7 @@ struct _Evas_Public_Data
    Eina_Bool      cb_render_post : 1;
    Eina_Bool      cb_render_flush_pre : 1;
    Eina_Bool      cb_render_flush_post : 1;
+   Eina_Bool      subtree_cull : 1; // opt-in, EVAS_RENDER_SUBTREE_CULL=1
 };
 
 struct _Evas_Layer
@@ -1123,7 +1128,9 @@ struct _Evas_Object_Protected_Data
    Eina_Inlist                *callbacks;
 
    struct {
-      Eina_List               *clipees;
+      Eina_Chunk_List         *clipees; /* clipees_list when not empty, NULL otherwise */
+      Eina_Chunk_List         *clipees_list;
+      Eina_Chunk_List_Item    *clipee_item; /* in cur->clipper's clipees */
       Eina_List               *cache_clipees_answer;
       Eina_List               *changes;
       Evas_Object_Protected_Data *mask, *prev_mask;
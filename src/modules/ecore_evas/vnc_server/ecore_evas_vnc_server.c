@@ -73,10 +73,13 @@ typedef struct _Ecore_Evas_Vnc_Server {
    Evas_Object *snapshot;
    Ecore_Evas *ee;
    Eina_Tiler *t;
+   Eina_Tiler *damage;
+   Ecore_Thread *encoder;
    Ecore_Evas_Vnc_Key_Info_Get key_info_get_func;
    double double_click_time;
    int last_w;
    int last_h;
+   Eina_Bool delete_me;
 } Ecore_Evas_Vnc_Server;
 
 typedef struct _Ecore_Evas_Vnc_Server_Client_Data {
@@ -97,6 +100,8 @@ typedef struct _Ecore_Evas_Vnc_Server_Client_Data {
 
 static void _ecore_evas_vnc_server_ecore_event_generic_free(void *user_data,
                                                             void *func_data);
+static void _ecore_evas_vnc_server_encode_start(Ecore_Evas_Vnc_Server *server);
+static void _ecore_evas_vnc_server_flush(Ecore_Evas_Vnc_Server *server);
 
 static void
 _ecore_evas_vnc_server_update_clients(rfbScreenInfoPtr vnc_screen)
@@ -129,6 +134,52 @@ _ecore_evas_vnc_server_update_clients(rfbScreenInfoPtr vnc_screen)
    rfbReleaseClientIterator(itr);
 }
 
+static void
+_ecore_evas_vnc_server_clients_prune(rfbScreenInfoPtr vnc_screen)
+{
+   rfbClientIteratorPtr itr;
+   rfbClientRec *client;
+
+   itr = rfbGetClientIterator(vnc_screen);
+   if (!itr) return;
+
+   while ((client = rfbClientIteratorNext(itr)))
+     {
+        //Client disconnected
+        if (client->sock == -1) rfbClientConnectionGone(client);
+     }
+
+   rfbReleaseClientIterator(itr);
+}
+
+//Nothing but the encoder may touch the clients while it runs.
+static void
+_ecore_evas_vnc_server_handlers_active_set(Ecore_Evas_Vnc_Server *server,
+                                           Eina_Bool active)
+{
+   Ecore_Fd_Handler_Flags flags = active ? ECORE_FD_READ : 0;
+   rfbClientIteratorPtr itr;
+   rfbClientRec *client;
+
+   if (server->vnc_listen_handler)
+     ecore_main_fd_handler_active_set(server->vnc_listen_handler, flags);
+   if (server->vnc_listen6_handler)
+     ecore_main_fd_handler_active_set(server->vnc_listen6_handler, flags);
+
+   itr = rfbGetClientIterator(server->vnc_screen);
+   if (!itr) return;
+
+   while ((client = rfbClientIteratorNext(itr)))
+     {
+        Ecore_Evas_Vnc_Server_Client_Data *cdata = client->clientData;
+
+        if (cdata && cdata->handler)
+          ecore_main_fd_handler_active_set(cdata->handler, flags);
+     }
+
+   rfbReleaseClientIterator(itr);
+}
+
 static void
 _ecore_evas_vnc_server_format_setup(rfbScreenInfoPtr vnc_screen)
 {
@@ -193,10 +244,6 @@ _ecore_evas_vnc_server_client_activity(void *data,
 
    rfbProcessClientMessage(client);
 
-   //macro from rfb.h
-   if (screen->frameBuffer && FB_UPDATE_PENDING(client))
-     rfbSendFramebufferUpdate(client, client->modifiedRegion);
-
    //Client disconnected.
    if (client->sock == -1)
      {
@@ -204,6 +251,10 @@ _ecore_evas_vnc_server_client_activity(void *data,
         return ECORE_CALLBACK_DONE;
      }
 
+   //macro from rfb.h
+   if (screen->frameBuffer && FB_UPDATE_PENDING(client))
+     _ecore_evas_vnc_server_encode_start(screen->screenData);
+
    return ECORE_CALLBACK_RENEW;
 }
 
@@ -600,6 +651,73 @@ _ecore_evas_vnc_server_shutdown(void)
    eina_shutdown();
 }
 
+static void
+_ecore_evas_vnc_server_free(Ecore_Evas_Vnc_Server *server)
+{
+   ecore_main_fd_handler_del(server->vnc_listen6_handler);
+   ecore_main_fd_handler_del(server->vnc_listen_handler);
+   rfbShutdownServer(server->vnc_screen, TRUE);
+   free(server->frame_buffer);
+   rfbScreenCleanup(server->vnc_screen);
+   eina_tiler_free(server->damage);
+   eina_tiler_free(server->t);
+   free(server);
+}
+
+static void
+_ecore_evas_vnc_server_encode(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Ecore_Evas_Vnc_Server *server = data;
+   rfbClientIteratorPtr itr;
+   rfbClientRec *client;
+
+   itr = rfbGetClientIterator(server->vnc_screen);
+   if (!itr) return;
+
+   while ((client = rfbClientIteratorNext(itr)))
+     {
+        if (client->sock == -1) continue;
+        if (!rfbUpdateClient(client))
+          WRN("Could not update the VNC client '%s'", client->host);
+     }
+
+   rfbReleaseClientIterator(itr);
+}
+
+static void
+_ecore_evas_vnc_server_encode_done(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Ecore_Evas_Vnc_Server *server = data;
+
+   server->encoder = NULL;
+   if (server->delete_me)
+     {
+        _ecore_evas_vnc_server_free(server);
+        return;
+     }
+
+   _ecore_evas_vnc_server_handlers_active_set(server, EINA_TRUE);
+   _ecore_evas_vnc_server_clients_prune(server->vnc_screen);
+
+   //Frames rendered meanwhile were only recorded, send them now.
+   _ecore_evas_vnc_server_flush(server);
+}
+
+static void
+_ecore_evas_vnc_server_encode_start(Ecore_Evas_Vnc_Server *server)
+{
+   if (server->encoder) return;
+
+   _ecore_evas_vnc_server_handlers_active_set(server, EINA_FALSE);
+   server->encoder = ecore_thread_run(_ecore_evas_vnc_server_encode,
+                                      _ecore_evas_vnc_server_encode_done,
+                                      _ecore_evas_vnc_server_encode_done,
+                                      server);
+   //No thread available, the cancel callback already restored everything.
+   if (!server->encoder)
+     _ecore_evas_vnc_server_update_clients(server->vnc_screen);
+}
+
 static inline int
 align4(int v)
 {
@@ -607,94 +725,105 @@ align4(int v)
 }
 
 static void
-_ecore_evas_vnc_server_draw(void *data, Evas *e EINA_UNUSED, void *event_info)
+_ecore_evas_vnc_server_fb_copy(Ecore_Evas_Vnc_Server *server,
+                               const char *pixels, int stride,
+                               const Eina_Rectangle *r)
 {
-   Evas_Event_Render_Post *post = event_info;
-   Evas_Object *snapshot = data;
-   Ecore_Evas_Vnc_Server *server;
-   const void *pixels;
-   Eina_List *l;
+   size_t dst_stride, len;
+   char *dst;
+   int dy;
+
+   //Same layout on both sides, see _ecore_evas_vnc_server_format_setup()
+   dst_stride = server->last_w * VNC_BYTES_PER_PIXEL;
+   len = r->w * VNC_BYTES_PER_PIXEL;
+   pixels += (r->y * stride) + (r->x * VNC_BYTES_PER_PIXEL);
+   dst = server->frame_buffer + (r->y * dst_stride) + (r->x * VNC_BYTES_PER_PIXEL);
+
+   for (dy = 0; dy < r->h; dy++)
+     {
+        memcpy(dst, pixels, len);
+        pixels += stride;
+        dst += dst_stride;
+     }
+}
+
+static void
+_ecore_evas_vnc_server_flush(Ecore_Evas_Vnc_Server *server)
+{
+   Eina_Rectangle snapshot_pos = { 0, 0, 0, 0 };
+   Eina_Iterator *it;
    Eina_Rectangle *r;
+   const void *pixels;
    size_t size;
+   int stride;
    Eina_Bool new_buf = EINA_FALSE;
-   Eina_Rectangle snapshot_pos;
 
-   // Nothing was updated, so let's not bother sending nothingness
-   if (!post->updated_area) return ;
+   if (eina_tiler_empty(server->damage)) return;
 
-   server = evas_object_data_get(snapshot, "_ecore_evas.vnc");
-   EINA_SAFETY_ON_NULL_RETURN(server);
+   pixels = evas_object_image_data_get(server->snapshot, EINA_FALSE);
+   evas_object_image_size_get(server->snapshot,
+                              &snapshot_pos.w, &snapshot_pos.h);
+   stride = evas_object_image_stride_get(server->snapshot);
+   if (!pixels || (snapshot_pos.w <= 0) || (snapshot_pos.h <= 0))
+     {
+        eina_tiler_clear(server->damage);
+        return;
+     }
 
-   pixels = evas_object_image_data_get(snapshot, EINA_FALSE);
-   evas_object_geometry_get(snapshot,
-                            &snapshot_pos.x,
-                            &snapshot_pos.y,
-                            &snapshot_pos.w,
-                            &snapshot_pos.h);
+   DBG("Preparing sending of buffer {%i, %i}.", snapshot_pos.w, snapshot_pos.h);
 
    // Align size on 4 pixels for vnc library stability
-   snapshot_pos.w = align4(snapshot_pos.w);
-   snapshot_pos.h = align4(snapshot_pos.h);
-
-   DBG("Preparing sending of buffer {%i, %i} with %i updates.", snapshot_pos.w, snapshot_pos.h, eina_list_count(post->updated_area));
-
    if (!server->frame_buffer ||
-       server->last_w != snapshot_pos.w ||
-       server->last_h != snapshot_pos.h)
+       server->last_w != align4(snapshot_pos.w) ||
+       server->last_h != align4(snapshot_pos.h))
      {
-        Eina_Rectangle tmp = { 0, 0, snapshot_pos.w, snapshot_pos.h };
+        Eina_Rectangle tmp = { 0, 0, align4(snapshot_pos.w), align4(snapshot_pos.h) };
         char *new_fb;
 
-        size = snapshot_pos.w * snapshot_pos.h * VNC_BYTES_PER_PIXEL;
+        size = tmp.w * tmp.h * VNC_BYTES_PER_PIXEL;
         new_fb = malloc(size);
-        EINA_SAFETY_ON_NULL_RETURN(new_fb);
+        if (!new_fb)
+          {
+             //Do not keep the damage around, it would be sent again later.
+             WRN("Could not allocate a %ix%i frame buffer.", tmp.w, tmp.h);
+             eina_tiler_clear(server->damage);
+             return;
+          }
         free(server->frame_buffer);
         server->frame_buffer = new_fb;
-        server->last_w = snapshot_pos.w;
-        server->last_h = snapshot_pos.h;
+        server->last_w = tmp.w;
+        server->last_h = tmp.h;
         new_buf = EINA_TRUE;
-        eina_tiler_area_size_set(server->t, snapshot_pos.w, snapshot_pos.h);
+        eina_tiler_area_size_set(server->t, tmp.w, tmp.h);
         eina_tiler_rect_add(server->t, &tmp);
 
         rfbNewFramebuffer(server->vnc_screen, server->frame_buffer,
-                          snapshot_pos.w, snapshot_pos.h,
+                          tmp.w, tmp.h,
                           VNC_BITS_PER_SAMPLE, VNC_SAMPLES_PER_PIXEL, VNC_BYTES_PER_PIXEL);
         _ecore_evas_vnc_server_format_setup(server->vnc_screen);
      }
 
-   EINA_LIST_FOREACH(post->updated_area, l, r)
+   //Only what changed is copied, libvncserver sends just the marked region.
+   it = eina_tiler_iterator_new(server->damage);
+   EINA_ITERATOR_FOREACH(it, r)
      {
         Eina_Rectangle tmp = *r;
-        size_t src_stride;
-        int dy;
-
-        if (tmp.x > snapshot_pos.w ||
-            tmp.y > snapshot_pos.h)
-          continue ;
 
         if (!eina_rectangle_intersection(&tmp, &snapshot_pos))
           continue ;
 
-        src_stride = tmp.w * VNC_BYTES_PER_PIXEL;
-
-        for (dy = 0; dy < tmp.h; dy++)
-          {
-             memcpy(server->frame_buffer + (tmp.x * VNC_BYTES_PER_PIXEL)
-                    + ((dy + tmp.y) * (snapshot_pos.w * VNC_BYTES_PER_PIXEL)),
-                    (char *)pixels + (dy * src_stride), src_stride);
-          }
-
+        _ecore_evas_vnc_server_fb_copy(server, pixels, stride, &tmp);
         rfbMarkRectAsModified(server->vnc_screen,
                               tmp.x, tmp.y, tmp.x + tmp.w, tmp.y + tmp.h);
 
         if (new_buf) eina_tiler_rect_del(server->t, &tmp);
      }
+   eina_iterator_free(it);
+   eina_tiler_clear(server->damage);
 
    //We did not receive the whole buffer yet, zero the missing bytes for now.
    if (new_buf)
      {
-        Eina_Iterator *it;
-
         it = eina_tiler_iterator_new(server->t);
         EINA_ITERATOR_FOREACH(it, r)
           {
@@ -707,7 +836,7 @@ _ecore_evas_vnc_server_draw(void *data, Evas *e EINA_UNUSED, void *event_info)
              for (dy = 0; dy < tmp.h; dy++)
                {
                   memset(server->frame_buffer + (tmp.x * VNC_BYTES_PER_PIXEL)
-                         + ((dy + tmp.y) * (snapshot_pos.w * VNC_BYTES_PER_PIXEL)),
+                         + ((dy + tmp.y) * (server->last_w * VNC_BYTES_PER_PIXEL)),
                          0, src_stride);
                }
           }
@@ -715,7 +844,49 @@ _ecore_evas_vnc_server_draw(void *data, Evas *e EINA_UNUSED, void *event_info)
         eina_tiler_clear(server->t);
      }
 
-   _ecore_evas_vnc_server_update_clients(server->vnc_screen);
+   _ecore_evas_vnc_server_encode_start(server);
+}
+
+static void
+_ecore_evas_vnc_server_draw(void *data, Evas *e EINA_UNUSED, void *event_info)
+{
+   Evas_Event_Render_Post *post = event_info;
+   Evas_Object *snapshot = data;
+   Ecore_Evas_Vnc_Server *server;
+   Eina_List *l;
+   Eina_Rectangle *r;
+   Eina_Rectangle snapshot_pos;
+
+   // Nothing was updated, so let's not bother sending nothingness
+   if (!post->updated_area) return ;
+
+   server = evas_object_data_get(snapshot, "_ecore_evas.vnc");
+   EINA_SAFETY_ON_NULL_RETURN(server);
+
+   evas_object_geometry_get(snapshot,
+                            &snapshot_pos.x,
+                            &snapshot_pos.y,
+                            &snapshot_pos.w,
+                            &snapshot_pos.h);
+   eina_tiler_area_size_set(server->damage, snapshot_pos.w, snapshot_pos.h);
+
+   EINA_LIST_FOREACH(post->updated_area, l, r)
+     {
+        Eina_Rectangle tmp = *r;
+
+        if (!eina_rectangle_intersection(&tmp, &snapshot_pos))
+          continue ;
+
+        tmp.x -= snapshot_pos.x;
+        tmp.y -= snapshot_pos.y;
+        eina_tiler_rect_add(server->damage, &tmp);
+     }
+
+   DBG("Recorded %i updates.", eina_list_count(post->updated_area));
+
+   //The encoder reads the frame buffer, it is updated once it is done.
+   if (!server->encoder)
+     _ecore_evas_vnc_server_flush(server);
 }
 
 static void
@@ -723,13 +894,18 @@ _ecore_evas_vnc_server_del(void *data, const Efl_Event *ev EINA_UNUSED)
 {
    Ecore_Evas_Vnc_Server *server = data;
 
-   ecore_main_fd_handler_del(server->vnc_listen6_handler);
-   ecore_main_fd_handler_del(server->vnc_listen_handler);
-   evas_object_del(server->snapshot);
-   rfbShutdownServer(server->vnc_screen, TRUE);
-   free(server->frame_buffer);
-   rfbScreenCleanup(server->vnc_screen);
-   free(server);
+   evas_event_callback_del_full(server->ee->evas, EVAS_CALLBACK_RENDER_POST,
+                                _ecore_evas_vnc_server_draw, server->snapshot);
+   server->snapshot = NULL;
+
+   if (server->encoder)
+     {
+        server->delete_me = EINA_TRUE;
+        ecore_thread_cancel(server->encoder);
+        return;
+     }
+
+   _ecore_evas_vnc_server_free(server);
 }
 
 EAPI Evas_Object *
@@ -750,7 +926,6 @@ ecore_evas_vnc_server_new(Ecore_Evas *ee, int port, const char *addr,
    snapshot = evas_object_image_filled_add(ee->evas);
    EINA_SAFETY_ON_NULL_RETURN_VAL(snapshot, NULL);
    evas_object_image_snapshot_set(snapshot, EINA_TRUE);
-   efl_event_callback_del(snapshot, EFL_EVENT_DEL, _ecore_evas_vnc_server_del, server);
 
    server->key_info_get_func = _ecore_evas_vnc_server_fb_key_info_get;
 
@@ -815,9 +990,13 @@ ecore_evas_vnc_server_new(Ecore_Evas *ee, int port, const char *addr,
    server->t = eina_tiler_new(1, 1);
    eina_tiler_tile_size_set(server->t, 1, 1);
    eina_tiler_strict_set(server->t, EINA_TRUE);
+   server->damage = eina_tiler_new(1, 1);
+   eina_tiler_tile_size_set(server->damage, 1, 1);
+   eina_tiler_strict_set(server->damage, EINA_TRUE);
 
    evas_object_data_set(snapshot, "_ecore_evas.vnc", server);
    evas_event_callback_add(ee->evas, EVAS_CALLBACK_RENDER_POST, _ecore_evas_vnc_server_draw, snapshot);
+   efl_event_callback_add(snapshot, EFL_EVENT_DEL, _ecore_evas_vnc_server_del, server);
 
    return snapshot;
 
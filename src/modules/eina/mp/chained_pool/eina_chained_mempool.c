@@ -82,7 +82,7 @@ struct _Chained_Pool
    unsigned int usage;
 
    unsigned char *last;
-   unsigned char *limit;
+   unsigned char *limit; // followed by one bit per item, set while in use
 };
 
 typedef struct _Chained_Mempool Chained_Mempool;
@@ -125,6 +125,12 @@ _eina_chained_mp_pool_key_cmp(const Eina_Rbtree *node, const void *key,
    return 0;
 }
 
+static inline unsigned int
+_eina_chained_mp_pool_index(Chained_Mempool *pool, Chained_Pool *p, void *ptr)
+{
+   return (((unsigned char *)ptr) - (unsigned char *)(p + 1)) / pool->item_alloc;
+}
+
 static inline Chained_Pool *
 _eina_chained_mp_pool_new(Chained_Mempool *pool)
 {
@@ -152,10 +158,11 @@ _eina_chained_mp_pool_new(Chained_Mempool *pool)
    p->base = NULL;
 
    p->last = ptr;
-   p->limit = ptr + pool->item_alloc * pool->pool_size;
+   p->limit = ptr + pool->group_size;
+   memset(p->limit, 0, (pool->pool_size + 7) / 8);
 
 #ifndef NVALGRIND
-   VALGRIND_MAKE_MEM_NOACCESS(ptr, pool->alloc_size - aligned_chained_pool);
+   VALGRIND_MAKE_MEM_NOACCESS(ptr, pool->group_size);
 #endif
 
    return p;
@@ -183,6 +190,7 @@ static void *
 _eina_chained_mempool_alloc_in(Chained_Mempool *pool, Chained_Pool *p)
 {
   void *mem = NULL;
+  unsigned int idx;
 
   // Let's try to first recycle memory
   if (p->base)
@@ -205,6 +213,9 @@ _eina_chained_mempool_alloc_in(Chained_Mempool *pool, Chained_Pool *p)
   if (!p->base && !p->last)
     pool->first = eina_inlist_demote(pool->first, EINA_INLIST_GET(p));
 
+  idx = _eina_chained_mp_pool_index(pool, p, mem);
+  p->limit[idx >> 3] |= 1 << (idx & 7);
+
   p->usage++;
   pool->usage++;
 
@@ -218,6 +229,8 @@ _eina_chained_mempool_alloc_in(Chained_Mempool *pool, Chained_Pool *p)
 static Eina_Bool
 _eina_chained_mempool_free_in(Chained_Mempool *pool, Chained_Pool *p, void *ptr)
 {
+   unsigned int idx;
+
 #ifdef DEBUG
    void *pmem;
   
@@ -240,14 +253,19 @@ _eina_chained_mempool_free_in(Chained_Mempool *pool, Chained_Pool *p, void *ptr)
      }
 #endif
 
+   idx = _eina_chained_mp_pool_index(pool, p, ptr);
+   p->limit[idx >> 3] &= ~(1 << (idx & 7));
+
    // freed node points to prev free node
    eina_trash_push(&p->base, ptr);
    // next free node is now the one we freed
    p->usage--;
    pool->usage--;
-   if (p->usage == 0)
+   if ((p->usage == 0) &&
+       ((pool->first != EINA_INLIST_GET(p)) || (EINA_INLIST_GET(p)->next)))
      {
-        // free bucket
+        // free bucket, but keep the last one around so short lived items
+        // don't allocate and free a whole bucket each time
         pool->first = eina_inlist_remove(pool->first, EINA_INLIST_GET(p));
         pool->root = eina_rbtree_inline_remove(pool->root, EINA_RBTREE_GET(p),
                                                _eina_chained_mp_pool_cmp, NULL);
@@ -427,11 +445,8 @@ eina_chained_mempool_from(void *data, void *ptr)
    Chained_Mempool *pool = data;
    Eina_Rbtree *r;
    Chained_Pool *p;
-   Eina_Trash *t;
-#ifndef NVALGRIND
-   Eina_Trash *last = NULL;
-#endif
    void *pmem;
+   unsigned int idx;
    Eina_Bool ret = EINA_FALSE;
 
    // look 4 pool
@@ -482,19 +497,9 @@ eina_chained_mempool_from(void *data, void *ptr)
      }
 
    // Check if the pointer was freed
-   for (t = p->base; t != NULL; t = t->next)
-     {
-#ifndef NVALGRIND
-        VALGRIND_MAKE_MEM_DEFINED(t, pool->item_alloc);
-        if (last) VALGRIND_MAKE_MEM_NOACCESS(last, pool->item_alloc);
-        last = t;
-#endif
-
-        if (t == ptr) goto end;
-     }
-#ifndef NVALGRIND
-     if (last) VALGRIND_MAKE_MEM_NOACCESS(last, pool->item_alloc);
-#endif
+   if ((unsigned char *)ptr >= p->limit) goto end;
+   idx = _eina_chained_mp_pool_index(pool, p, ptr);
+   if (!(p->limit[idx >> 3] & (1 << (idx & 7)))) goto end;
 
    // Seems like we have a valid pointer actually
    ret = EINA_TRUE;
@@ -712,7 +717,7 @@ eina_chained_mempool_init(const char *context,
 #endif
 
    mp->group_size = mp->item_alloc * mp->pool_size;
-   mp->alloc_size = mp->group_size + aligned_chained_pool;
+   mp->alloc_size = mp->group_size + aligned_chained_pool + (mp->pool_size + 7) / 8;
 
 #ifndef NVALGRIND
    VALGRIND_CREATE_MEMPOOL(mp, 0, 1);
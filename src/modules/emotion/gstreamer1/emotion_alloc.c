@@ -22,7 +22,16 @@ emotion_gstreamer_buffer_alloc(EmotionVideoSink *sink,
    send->sink = gst_object_ref(sink);
    send->frame = gst_buffer_ref(buffer);
    send->info = *info;
-   if (gst_video_frame_map(&(send->vframe), info, buffer, GST_MAP_READ))
+#ifdef HAVE_GSTREAMER_ALLOCATORS
+   /* single plane BGRx dma-buf frames can be shown without mapping them */
+   if ((!sink->priv->native_failed) &&
+       (GST_VIDEO_INFO_FORMAT(info) == GST_VIDEO_FORMAT_BGRx) &&
+       (gst_buffer_n_memory(buffer) == 1) &&
+       (gst_is_dmabuf_memory(gst_buffer_peek_memory(buffer, 0))))
+     send->dmabuf = EINA_TRUE;
+#endif
+   if ((!send->dmabuf) &&
+       (gst_video_frame_map(&(send->vframe), info, buffer, GST_MAP_READ)))
      send->vfmapped = EINA_TRUE;
    else
      send->vfmapped = EINA_FALSE;
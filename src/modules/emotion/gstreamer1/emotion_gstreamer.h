@@ -10,6 +10,9 @@
 #include <gst/audio/audio.h>
 #include <gst/tag/tag.h>
 #include <gst/pbutils/pbutils.h>
+#ifdef HAVE_GSTREAMER_ALLOCATORS
+# include <gst/allocators/gstdmabuf.h>
+#endif
 
 #include <unistd.h>
 #include <fcntl.h>
@@ -44,6 +47,29 @@ struct _Emotion_Convert_Info
    unsigned char *plane_ptr[4];
 };
 
+#ifdef HAVE_GSTREAMER_ALLOCATORS
+/* This must exactly match struct dmabuf_attributes in the evas engines,
+ * it is what an EVAS_NATIVE_SURFACE_WL_DMABUF surface points to. */
+#define EMOTION_DMABUF_ATTRIBUTE_VERSION 1
+#define EMOTION_DRM_FORMAT_XRGB8888 0x34325258
+
+typedef struct _Emotion_Dmabuf_Attributes Emotion_Dmabuf_Attributes;
+
+struct _Emotion_Dmabuf_Attributes
+{
+   int version;
+   int32_t width;
+   int32_t height;
+   uint32_t format;
+   uint32_t flags;
+   int n_planes;
+   int fd[4];
+   uint32_t offset[4];
+   uint32_t stride[4];
+   uint64_t modifier[4];
+};
+#endif
+
 struct _Emotion_Gstreamer_Metadata
 {
    char *title;
@@ -124,6 +150,15 @@ struct _EmotionVideoSinkPrivate {
 
    GstVideoFrame last_vframe;
 
+   /* RGB frames are only converted when evas asks for the pixels of the
+    * last one, see emotion_video_sink_pixels_get() */
+   struct {
+      Evas_Video_Convert_Cb func;
+      const unsigned char *data;
+      Emotion_Convert_Info info;
+      unsigned int w, h, eheight;
+   } convert;
+
    int frames;
    int flapse;
    double rtime;
@@ -140,6 +175,11 @@ struct _EmotionVideoSinkPrivate {
    Eina_Bool unlocked : 1;
    Eina_Bool mapped : 1;
    Eina_Bool vfmapped : 1;
+   Eina_Bool convert_pending : 1;
+   // last_buffer is shown as a dma-buf native surface, nothing is mapped
+   Eina_Bool native : 1;
+   // the evas engine can't take dma-buf native surfaces
+   Eina_Bool native_failed : 1;
 };
 
 struct _Emotion_Gstreamer_Buffer
@@ -152,6 +192,7 @@ struct _Emotion_Gstreamer_Buffer
    Evas_Colorspace eformat;
    int eheight;
    Eina_Bool vfmapped : 1;
+   Eina_Bool dmabuf : 1;
 };
 
 struct _Emotion_Gstreamer_Message
@@ -4,9 +4,19 @@
 
 #include "emotion_gstreamer.h"
 
+#ifdef HAVE_GSTREAMER_ALLOCATORS
+/* dma-buf BGRx frames are shown as native surfaces without copies */
+# define EMOTION_VIDEO_SINK_CAPS \
+   GST_VIDEO_CAPS_MAKE_WITH_FEATURES(GST_CAPS_FEATURE_MEMORY_DMABUF, "BGRx") "; " \
+   GST_VIDEO_CAPS_MAKE("{ I420, YV12, YUY2, NV12, BGRx, BGR, BGRA }")
+#else
+# define EMOTION_VIDEO_SINK_CAPS \
+   GST_VIDEO_CAPS_MAKE("{ I420, YV12, YUY2, NV12, BGRx, BGR, BGRA }")
+#endif
+
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE("sink",
                                                                    GST_PAD_SINK, GST_PAD_ALWAYS,
-                                                                   GST_STATIC_CAPS(GST_VIDEO_CAPS_MAKE("{ I420, YV12, YUY2, NV12, BGRx, BGR, BGRA }"))); 
+                                                                   GST_STATIC_CAPS(EMOTION_VIDEO_SINK_CAPS));
 
 GST_DEBUG_CATEGORY_STATIC(emotion_video_sink_debug);
 #define GST_CAT_DEFAULT emotion_video_sink_debug
@@ -37,6 +47,7 @@ G_DEFINE_TYPE_WITH_CODE(EmotionVideoSink,
 
 static void unlock_buffer_mutex(EmotionVideoSinkPrivate* priv);
 static void emotion_video_sink_main_render(void *data);
+static void _emotion_video_sink_native_unset(EmotionVideoSinkPrivate *priv);
 
 static void
 emotion_video_sink_init(EmotionVideoSink* sink)
@@ -139,6 +150,10 @@ emotion_video_sink_dispose(GObject* object)
    priv = sink->priv;
 
    eina_lock_take(&priv->m);
+   priv->convert_pending = EINA_FALSE;
+   _emotion_video_sink_native_unset(priv);
+   if (priv->evas_object)
+     evas_object_image_pixels_get_callback_set(priv->evas_object, NULL, NULL);
    if (priv->vfmapped)
      {
         if (priv->evas_object)
@@ -247,6 +262,8 @@ emotion_video_sink_stop(GstBaseSink* base_sink)
    INF("sink stop");
 
    eina_lock_take(&priv->m);
+   priv->convert_pending = EINA_FALSE;
+   _emotion_video_sink_native_unset(priv);
    if (priv->vfmapped)
      {
         if (priv->evas_object)
@@ -383,6 +400,93 @@ _update_emotion_fps(EmotionVideoSinkPrivate *priv)
      }
 }
 
+/* Called by evas when it draws the object, priv->m must not be taken */
+static void
+emotion_video_sink_pixels_get(void *data, Evas_Object *obj)
+{
+   EmotionVideoSinkPrivate *priv = data;
+   unsigned char *evas_data;
+
+   eina_lock_take(&priv->m);
+   if ((priv->convert_pending) && (priv->evas_object == obj))
+     {
+        evas_data = evas_object_image_data_get(obj, 1);
+        if (evas_data)
+          {
+             priv->convert.func(evas_data, priv->convert.data,
+                                priv->convert.w, priv->convert.h,
+                                priv->convert.eheight, &(priv->convert.info));
+             evas_object_image_data_set(obj, evas_data);
+          }
+        priv->convert_pending = EINA_FALSE;
+     }
+   eina_lock_release(&priv->m);
+   evas_object_image_pixels_dirty_set(obj, 0);
+}
+
+/* Must be called with priv->m taken */
+static void
+_emotion_video_sink_native_unset(EmotionVideoSinkPrivate *priv)
+{
+   if (!priv->native) return;
+   if (priv->evas_object)
+     {
+        evas_object_image_native_surface_set(priv->evas_object, NULL);
+        evas_object_image_size_set(priv->evas_object, 1, 1);
+     }
+   priv->native = EINA_FALSE;
+}
+
+#ifdef HAVE_GSTREAMER_ALLOCATORS
+/* Show a BGRx dma-buf frame as a native surface, the engine only maps it
+ * if and when it draws it. Must be called with priv->m taken */
+static Eina_Bool
+_emotion_video_sink_native_set(EmotionVideoSinkPrivate *priv,
+                               Emotion_Gstreamer_Buffer *send)
+{
+   Emotion_Dmabuf_Attributes attr;
+   Evas_Native_Surface ns;
+   GstVideoMeta *meta;
+   GstMemory *mem;
+
+   mem = gst_buffer_peek_memory(send->frame, 0);
+   meta = gst_buffer_get_video_meta(send->frame);
+
+   memset(&attr, 0, sizeof(attr));
+   attr.version = EMOTION_DMABUF_ATTRIBUTE_VERSION;
+   attr.width = send->info.width;
+   attr.height = send->eheight;
+   attr.format = EMOTION_DRM_FORMAT_XRGB8888;
+   attr.n_planes = 1;
+   attr.fd[0] = gst_dmabuf_memory_get_fd(mem);
+   attr.offset[0] = mem->offset + (meta ? meta->offset[0] : send->info.offset[0]);
+   attr.stride[0] = meta ? meta->stride[0] : send->info.stride[0];
+   // software engines have no stride for native surfaces
+   if (attr.stride[0] != (uint32_t)attr.width * 4) return EINA_FALSE;
+
+   memset(&ns, 0, sizeof(ns));
+   ns.version = EVAS_NATIVE_SURFACE_VERSION;
+   ns.type = EVAS_NATIVE_SURFACE_WL_DMABUF;
+   ns.data.wl_dmabuf.attr = &attr;
+
+   if (!priv->native)
+     {
+        evas_object_image_alpha_set(priv->evas_object, 0);
+        evas_object_image_colorspace_set(priv->evas_object, EVAS_COLORSPACE_ARGB8888);
+        evas_object_image_size_set(priv->evas_object, send->info.width, send->eheight);
+     }
+   priv->native = EINA_TRUE;
+   evas_object_image_native_surface_set(priv->evas_object, &ns);
+   if (!evas_object_image_native_surface_get(priv->evas_object))
+     {
+        _emotion_video_sink_native_unset(priv);
+        return EINA_FALSE;
+     }
+   evas_object_image_data_update_add(priv->evas_object, 0, 0, send->info.width, send->eheight);
+   return EINA_TRUE;
+}
+#endif
+
 static void
 emotion_video_sink_main_render(void *data)
 {
@@ -393,6 +497,7 @@ emotion_video_sink_main_render(void *data)
    unsigned char *evas_data;
    double ratio;
    Emotion_Convert_Info info;
+   Eina_Bool native = EINA_FALSE;
 
    send = data;
 
@@ -419,6 +524,7 @@ emotion_video_sink_main_render(void *data)
           {
              evas_object_event_callback_add(priv->evas_object, EVAS_CALLBACK_DEL, _cleanup_priv, priv);
              evas_object_image_pixels_get_callback_set(priv->evas_object, NULL, NULL);
+             priv->native = EINA_FALSE;
           }
      }
 
@@ -427,101 +533,140 @@ emotion_video_sink_main_render(void *data)
 
    buffer = gst_buffer_ref(send->frame);
 
-   if (!send->vfmapped)
+   /* The previous frame may still be waiting for its conversion, it is
+    * dropped from here on */
+   priv->convert_pending = EINA_FALSE;
+
+#ifdef HAVE_GSTREAMER_ALLOCATORS
+   if (send->dmabuf)
      {
-        if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+        evas_object_image_pixels_get_callback_set(priv->evas_object, NULL, NULL);
+        native = _emotion_video_sink_native_set(priv, send);
+        if (!native)
           {
-             gst_buffer_unref(buffer);
-             ERR("Cannot map video buffer for read.\n");
-             goto exit_point;
+             INF("dma-buf frames not supported, mapping them from now on");
+             priv->native_failed = EINA_TRUE;
+             if (gst_video_frame_map(&(send->vframe), &(send->info), buffer, GST_MAP_READ))
+               send->vfmapped = EINA_TRUE;
           }
      }
+#endif
 
-   INF("sink main render [%i, %i] (source height: %i)", send->info.width, send->eheight, send->info.height);
-
-   evas_object_image_alpha_set(priv->evas_object, 0);
-   evas_object_image_colorspace_set(priv->evas_object, send->eformat);
-   evas_object_image_size_set(priv->evas_object, send->info.width, send->eheight);
-
-   evas_data = evas_object_image_data_get(priv->evas_object, 1);
-   if (!evas_data)
+   if (!native)
      {
+        _emotion_video_sink_native_unset(priv);
+
         if (!send->vfmapped)
           {
-             gst_buffer_unmap(buffer, &map);
-             priv->mapped = EINA_FALSE;
+             if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+               {
+                  gst_buffer_unref(buffer);
+                  ERR("Cannot map video buffer for read.\n");
+                  goto exit_point;
+               }
+          }
+
+        INF("sink main render [%i, %i] (source height: %i)", send->info.width, send->eheight, send->info.height);
+
+        evas_object_image_alpha_set(priv->evas_object, 0);
+        evas_object_image_colorspace_set(priv->evas_object, send->eformat);
+        evas_object_image_size_set(priv->evas_object, send->info.width, send->eheight);
+
+        // XXX: need to handle GstVideoCropMeta to get video cropping right
+        // XXX: can't get crop meta from buffer (always null)
+        //   GstVideoCropMeta *meta;
+        //   meta = gst_buffer_get_video_crop_meta(buffer);
+        //   printf("META: %p\n", meta);
+
+        /* this just is a demo of broken vaapi back-end values for stride and
+         * plane offset - the below is what i needed to fix them up for a few videos
+         */
+        /*
+           info.stride[0] = 64 * ((send->info.stride[0] + 63) / 64);
+           info.stride[1] = 64 * ((send->info.stride[1] + 63) / 64);
+           info.stride[2] = 64 * ((send->info.stride[2] + 63) / 64);
+           info.stride[3] = 64 * ((send->info.stride[3] + 63) / 64);
+           info.plane_offset[0] = send->info.offset[0];
+           info.plane_offset[1] = (((send->info.height + 15) / 16) * 16) * info.stride[1];
+           info.plane_offset[2] = send->info.offset[2];
+           info.plane_offset[3] = send->info.offset[3];
+         */
+        if (send->vfmapped)
+          {
+             GstVideoFrame *vframe = &(send->vframe);
+
+             map.data = GST_VIDEO_FRAME_PLANE_DATA(vframe, 0);
+             info.bpp[0] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 0);
+             info.bpp[1] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 1);
+             info.bpp[2] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 2);
+             info.bpp[3] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 3);
+             info.stride[0] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 0);
+             info.stride[1] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 1);
+             info.stride[2] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 2);
+             info.stride[3] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 3);
+             info.plane_ptr[0] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 0);
+             info.plane_ptr[1] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 1);
+             info.plane_ptr[2] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 2);
+             info.plane_ptr[3] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 3);
           }
         else
           {
-             gst_video_frame_unmap(&(send->vframe));
-             priv->vfmapped = EINA_FALSE;
+             info.bpp[0] = 1;
+             info.bpp[1] = 1;
+             info.bpp[2] = 1;
+             info.bpp[3] = 1;
+             info.stride[0] = send->info.stride[0];
+             info.stride[1] = send->info.stride[1];
+             info.stride[2] = send->info.stride[2];
+             info.stride[3] = send->info.stride[3];
+             info.plane_ptr[0] = ((unsigned char *)map.data) + send->info.offset[0];
+             info.plane_ptr[1] = ((unsigned char *)map.data) + send->info.offset[1];
+             info.plane_ptr[2] = ((unsigned char *)map.data) + send->info.offset[2];
+             info.plane_ptr[3] = ((unsigned char *)map.data) + send->info.offset[3];
           }
-        gst_buffer_unref(buffer);
-        goto exit_point;
-     }
 
-// XXX: need to handle GstVideoCropMeta to get video cropping right
-// XXX: can't get crop meta from buffer (always null)
-//   GstVideoCropMeta *meta;
-//   meta = gst_buffer_get_video_crop_meta(buffer);
-//   printf("META: %p\n", meta);
-
-/* this just is a demo of broken vaapi back-end values for stride and
- * plane offset - the below is what i needed to fix them up for a few videos
- */
-/*
-   info.stride[0] = 64 * ((send->info.stride[0] + 63) / 64);
-   info.stride[1] = 64 * ((send->info.stride[1] + 63) / 64);
-   info.stride[2] = 64 * ((send->info.stride[2] + 63) / 64);
-   info.stride[3] = 64 * ((send->info.stride[3] + 63) / 64);
-   info.plane_offset[0] = send->info.offset[0];
-   info.plane_offset[1] = (((send->info.height + 15) / 16) * 16) * info.stride[1];
-   info.plane_offset[2] = send->info.offset[2];
-   info.plane_offset[3] = send->info.offset[3];
- */
-   if (send->vfmapped)
-     {
-        GstVideoFrame *vframe = &(send->vframe);
-
-        map.data = GST_VIDEO_FRAME_PLANE_DATA(vframe, 0);
-        info.bpp[0] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 0);
-        info.bpp[1] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 1);
-        info.bpp[2] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 2);
-        info.bpp[3] = GST_VIDEO_FRAME_COMP_PSTRIDE(vframe, 3);
-        info.stride[0] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 0);
-        info.stride[1] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 1);
-        info.stride[2] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 2);
-        info.stride[3] = GST_VIDEO_FRAME_COMP_STRIDE(vframe, 3);
-        info.plane_ptr[0] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 0);
-        info.plane_ptr[1] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 1);
-        info.plane_ptr[2] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 2);
-        info.plane_ptr[3] = GST_VIDEO_FRAME_PLANE_DATA(vframe, 3);
-     }
-   else
-     {
-        info.bpp[0] = 1;
-        info.bpp[1] = 1;
-        info.bpp[2] = 1;
-        info.bpp[3] = 1;
-        info.stride[0] = send->info.stride[0];
-        info.stride[1] = send->info.stride[1];
-        info.stride[2] = send->info.stride[2];
-        info.stride[3] = send->info.stride[3];
-        info.plane_ptr[0] = ((unsigned char *)map.data) + send->info.offset[0];
-        info.plane_ptr[1] = ((unsigned char *)map.data) + send->info.offset[1];
-        info.plane_ptr[2] = ((unsigned char *)map.data) + send->info.offset[2];
-        info.plane_ptr[3] = ((unsigned char *)map.data) + send->info.offset[3];
+        if (!send->func)
+          {
+             WRN("No way to decode %x colorspace !", send->eformat);
+             evas_object_image_pixels_get_callback_set(priv->evas_object, NULL, NULL);
+          }
+        else if (send->eformat == EVAS_COLORSPACE_ARGB8888)
+          {
+             /* RGB frames need a full copy, only do it for the frame evas
+              * actually draws. The mapping stays valid as long as this is
+              * the last buffer */
+             priv->convert.func = send->func;
+             priv->convert.data = map.data;
+             priv->convert.info = info;
+             priv->convert.w = send->info.width;
+             priv->convert.h = send->info.height;
+             priv->convert.eheight = send->eheight;
+             priv->convert_pending = EINA_TRUE;
+             evas_object_image_pixels_get_callback_set(priv->evas_object, emotion_video_sink_pixels_get, priv);
+             evas_object_image_pixels_dirty_set(priv->evas_object, 1);
+          }
+        else
+          {
+             /* YUV frames only need the plane row pointers, evas converts
+              * them when drawing */
+             evas_object_image_pixels_get_callback_set(priv->evas_object, NULL, NULL);
+             evas_data = evas_object_image_data_get(priv->evas_object, 1);
+             if (!evas_data)
+               {
+                  if (!send->vfmapped)
+                    gst_buffer_unmap(buffer, &map);
+                  else
+                    gst_video_frame_unmap(&(send->vframe));
+                  gst_buffer_unref(buffer);
+                  goto exit_point;
+               }
+             send->func(evas_data, map.data, send->info.width, send->info.height, send->eheight, &info);
+             evas_object_image_data_set(priv->evas_object, evas_data);
+             evas_object_image_data_update_add(priv->evas_object, 0, 0, send->info.width, send->eheight);
+             evas_object_image_pixels_dirty_set(priv->evas_object, 0);
+          }
      }
 
-   if (send->func)
-     send->func(evas_data, map.data, send->info.width, send->info.height, send->eheight, &info);
-   else
-     WRN("No way to decode %x colorspace !", send->eformat);
-
-   evas_object_image_data_set(priv->evas_object, evas_data);
-   evas_object_image_data_update_add(priv->evas_object, 0, 0, send->info.width, send->eheight);
-   evas_object_image_pixels_dirty_set(priv->evas_object, 0);
-
    _update_emotion_fps(priv);
 
    ratio = (double) send->info.width / (double) send->eheight;
@@ -538,7 +683,12 @@ emotion_video_sink_main_render(void *data)
         if ((priv->mapped) && (priv->last_buffer))
           gst_buffer_unmap(priv->last_buffer, &(priv->map_info));
      }
-   if (send->vfmapped)
+   if (native)
+     {
+        priv->vfmapped = EINA_FALSE;
+        priv->mapped = EINA_FALSE;
+     }
+   else if (send->vfmapped)
      {
         priv->last_vframe = send->vframe;
         priv->vfmapped = EINA_TRUE;
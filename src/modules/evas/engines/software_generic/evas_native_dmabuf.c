@@ -22,6 +22,7 @@ _native_bind_cb(void *image, int x EINA_UNUSED, int y EINA_UNUSED, int w EINA_UN
 {
    struct dmabuf_attributes *a;
    int size;
+   void *ptr;
    RGBA_Image *im = image;
 
    if (!im) return;
@@ -35,14 +36,17 @@ _native_bind_cb(void *image, int x EINA_UNUSED, int y EINA_UNUSED, int w EINA_UN
    a = (struct dmabuf_attributes *)&n->ns_data.wl_surface_dmabuf;
    if (n->ns_data.wl_surface_dmabuf.ptr)
      {
-        im->image.data = n->ns_data.wl_surface_dmabuf.ptr;
+        im->image.data = (DATA32 *)((unsigned char *)n->ns_data.wl_surface_dmabuf.ptr + a->offset[0]);
         return;
      }
-   size = a->height * a->stride[0];
-   im->image.data = mmap(NULL, size, PROT_READ, MAP_SHARED, a->fd[0], 0);
-   if (im->image.data == MAP_FAILED) im->image.data = NULL;
+   /* the plane may not start at the beginning of the buffer (video frames
+    * from a pool for example), map from 0 as offsets aren't page aligned */
+   size = a->offset[0] + (a->height * a->stride[0]);
+   ptr = mmap(NULL, size, PROT_READ, MAP_SHARED, a->fd[0], 0);
+   if (ptr == MAP_FAILED) return;
    n->ns_data.wl_surface_dmabuf.size = size;
-   n->ns_data.wl_surface_dmabuf.ptr = im->image.data;
+   n->ns_data.wl_surface_dmabuf.ptr = ptr;
+   im->image.data = (DATA32 *)((unsigned char *)ptr + a->offset[0]);
 }
 
 static void
@@ -2,6 +2,14 @@
 # include <config.h>
 #endif
 
+#ifdef BUILD_ECORE_EVAS_VNC_SERVER
+# include <errno.h>
+# include <unistd.h>
+# include <sys/socket.h>
+# include <netinet/in.h>
+# include <arpa/inet.h>
+#endif
+
 #include <Ecore_Evas.h>
 #include <Efl_Core.h>
 
@@ -113,9 +121,274 @@ EFL_START_TEST(ecore_test_ecore_evas_fallback_selection)
 }
 EFL_END_TEST
 
+#ifdef BUILD_ECORE_EVAS_VNC_SERVER
+typedef struct _Vnc_Client
+{
+   int fd;
+   int port;
+   int w, h;
+   int big_endian;
+   unsigned int red_max, green_max, blue_max;
+   int red_shift, green_shift, blue_shift;
+   unsigned int *fb; /* 0xRRGGBB, as last received */
+} Vnc_Client;
+
+/* the server answers from the main loop, keep it running while waiting */
+static void
+_vnc_read(Vnc_Client *c, void *buf, size_t len)
+{
+   unsigned char *p = buf;
+   double limit = ecore_time_get() + 5.0;
+
+   while (len > 0)
+     {
+        ssize_t n = recv(c->fd, p, len, MSG_DONTWAIT);
+
+        if (n > 0)
+          {
+             p += n;
+             len -= n;
+             continue;
+          }
+        ck_assert_msg((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)),
+                      "VNC server closed the connection");
+        ck_assert_msg(ecore_time_get() < limit, "VNC server did not answer");
+        ecore_main_loop_iterate();
+        usleep(1000);
+     }
+}
+
+static void
+_vnc_write(Vnc_Client *c, const void *buf, size_t len)
+{
+   ck_assert_int_eq(send(c->fd, buf, len, 0), (ssize_t)len);
+}
+
+static unsigned int
+_vnc_u16(const unsigned char *p)
+{
+   return (p[0] << 8) | p[1];
+}
+
+static unsigned int
+_vnc_u32(const unsigned char *p)
+{
+   return ((unsigned int)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+/* let the system pick a port nothing listens on, so that parallel runs
+ * don't fight over a fixed one */
+static int
+_vnc_free_port(void)
+{
+   struct sockaddr_in addr = { 0 };
+   socklen_t len = sizeof(addr);
+   int fd;
+
+   fd = socket(AF_INET, SOCK_STREAM, 0);
+   ck_assert_int_ge(fd, 0);
+   addr.sin_family = AF_INET;
+   addr.sin_port = 0;
+   addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+   ck_assert_int_eq(bind(fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+   ck_assert_int_eq(getsockname(fd, (struct sockaddr *)&addr, &len), 0);
+   close(fd);
+
+   return eina_ntohs(addr.sin_port);
+}
+
+static void
+_vnc_connect(Vnc_Client *c)
+{
+   struct sockaddr_in addr = { 0 };
+   unsigned char buf[32];
+   unsigned int i, n;
+
+   c->fd = socket(AF_INET, SOCK_STREAM, 0);
+   ck_assert_int_ge(c->fd, 0);
+   addr.sin_family = AF_INET;
+   addr.sin_port = eina_htons(c->port);
+   addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+   ck_assert_int_eq(connect(c->fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+
+   /* version, no security and a shared session */
+   _vnc_read(c, buf, 12);
+   ck_assert(!memcmp(buf, "RFB 003.008\n", 12));
+   _vnc_write(c, "RFB 003.008\n", 12);
+   _vnc_read(c, buf, 1);
+   n = buf[0];
+   ck_assert_int_gt(n, 0);
+   for (i = 0; i < n; i++)
+     _vnc_read(c, buf + 1, 1);
+   buf[0] = 1;
+   _vnc_write(c, buf, 1);
+   _vnc_read(c, buf, 4);
+   ck_assert_int_eq(_vnc_u32(buf), 0);
+   buf[0] = 1;
+   _vnc_write(c, buf, 1);
+
+   /* server init: size, pixel format and name */
+   _vnc_read(c, buf, 24);
+   c->w = _vnc_u16(buf);
+   c->h = _vnc_u16(buf + 2);
+   ck_assert_int_eq(buf[4], 32);
+   c->big_endian = buf[6];
+   c->red_max = _vnc_u16(buf + 8);
+   c->green_max = _vnc_u16(buf + 10);
+   c->blue_max = _vnc_u16(buf + 12);
+   c->red_shift = buf[14];
+   c->green_shift = buf[15];
+   c->blue_shift = buf[16];
+   for (n = _vnc_u32(buf + 20); n > 0; n--)
+     _vnc_read(c, buf, 1);
+
+   c->fb = calloc(c->w * c->h, sizeof(unsigned int));
+   ck_assert_ptr_ne(c->fb, NULL);
+}
+
+static unsigned int
+_vnc_pixel_decode(const Vnc_Client *c, const unsigned char *p)
+{
+   unsigned int px;
+
+   if (c->big_endian)
+     px = _vnc_u32(p);
+   else
+     px = ((unsigned int)p[3] << 24) | (p[2] << 16) | (p[1] << 8) | p[0];
+
+   return ((((px >> c->red_shift) & c->red_max) * 255 / c->red_max) << 16) |
+          ((((px >> c->green_shift) & c->green_max) * 255 / c->green_max) << 8) |
+          (((px >> c->blue_shift) & c->blue_max) * 255 / c->blue_max);
+}
+
+/* request an update of the whole screen and apply the raw rects */
+static void
+_vnc_update(Vnc_Client *c, Eina_Bool incremental)
+{
+   unsigned char buf[12], *row;
+   unsigned int n, x, y, w, h, dx, dy;
+
+   buf[0] = 3;
+   buf[1] = incremental;
+   buf[2] = buf[3] = buf[4] = buf[5] = 0;
+   buf[6] = c->w >> 8;
+   buf[7] = c->w & 0xff;
+   buf[8] = c->h >> 8;
+   buf[9] = c->h & 0xff;
+   _vnc_write(c, buf, 10);
+
+   _vnc_read(c, buf, 4);
+   ck_assert_int_eq(buf[0], 0);
+   for (n = _vnc_u16(buf + 2); n > 0; n--)
+     {
+        _vnc_read(c, buf, 12);
+        x = _vnc_u16(buf);
+        y = _vnc_u16(buf + 2);
+        w = _vnc_u16(buf + 4);
+        h = _vnc_u16(buf + 6);
+        ck_assert_int_eq(_vnc_u32(buf + 8), 0);
+        ck_assert_int_le(x + w, c->w);
+        ck_assert_int_le(y + h, c->h);
+
+        row = malloc(w * 4);
+        ck_assert_ptr_ne(row, NULL);
+        for (dy = 0; dy < h; dy++)
+          {
+             _vnc_read(c, row, w * 4);
+             for (dx = 0; dx < w; dx++)
+               c->fb[(y + dy) * c->w + x + dx] = _vnc_pixel_decode(c, row + dx * 4);
+          }
+        free(row);
+     }
+}
+
+static void
+_vnc_render(Ecore_Evas *ee)
+{
+   int i;
+
+   ecore_evas_manual_render(ee);
+   /* let the encoder thread of the server finish */
+   for (i = 0; i < 50; i++)
+     {
+        ecore_main_loop_iterate();
+        usleep(1000);
+     }
+}
+
+EFL_START_TEST(ecore_test_ecore_evas_vnc_flush)
+{
+   Vnc_Client c = { 0 };
+   Ecore_Evas *ee;
+   Evas *canvas;
+   Evas_Object *bg, *rect, *snapshot;
+
+   ck_assert_int_eq(ecore_evas_init(), 1);
+
+   ee = ecore_evas_buffer_new(WINDOW_WIDTH, WINDOW_HEIGHT);
+   ck_assert_ptr_ne(ee, NULL);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   canvas = ecore_evas_get(ee);
+
+   bg = evas_object_rectangle_add(canvas);
+   evas_object_color_set(bg, 255, 0, 0, 255);
+   evas_object_geometry_set(bg, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+   evas_object_show(bg);
+
+   rect = evas_object_rectangle_add(canvas);
+   evas_object_color_set(rect, 0, 0, 255, 255);
+   evas_object_geometry_set(rect, 40, 50, 20, 30);
+
+   c.port = _vnc_free_port();
+   snapshot = ecore_evas_vnc_start(ee, "127.0.0.1", c.port, NULL, NULL, NULL);
+   ck_assert_ptr_ne(snapshot, NULL);
+   evas_object_geometry_set(snapshot, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+   evas_object_show(snapshot);
+   ecore_evas_show(ee);
+   _vnc_render(ee);
+
+   _vnc_connect(&c);
+   ck_assert_int_eq(c.w, WINDOW_WIDTH);
+   ck_assert_int_eq(c.h, WINDOW_HEIGHT);
+
+   /* the first frame is complete */
+   _vnc_update(&c, EINA_FALSE);
+   ck_assert_int_eq(c.fb[0], 0xff0000);
+   ck_assert_int_eq(c.fb[60 * WINDOW_WIDTH + 50], 0xff0000);
+   ck_assert_int_eq(c.fb[WINDOW_WIDTH * WINDOW_HEIGHT - 1], 0xff0000);
+
+   /* later ones bring the damaged rect, at its place in the frame */
+   evas_object_show(rect);
+   _vnc_render(ee);
+   _vnc_update(&c, EINA_TRUE);
+   ck_assert_int_eq(c.fb[50 * WINDOW_WIDTH + 40], 0x0000ff);
+   ck_assert_int_eq(c.fb[79 * WINDOW_WIDTH + 59], 0x0000ff);
+   ck_assert_int_eq(c.fb[49 * WINDOW_WIDTH + 40], 0xff0000);
+   ck_assert_int_eq(c.fb[50 * WINDOW_WIDTH + 60], 0xff0000);
+   ck_assert_int_eq(c.fb[0], 0xff0000);
+
+   /* and the area it left */
+   evas_object_move(rect, 100, 100);
+   _vnc_render(ee);
+   _vnc_update(&c, EINA_TRUE);
+   ck_assert_int_eq(c.fb[50 * WINDOW_WIDTH + 40], 0xff0000);
+   ck_assert_int_eq(c.fb[100 * WINDOW_WIDTH + 100], 0x0000ff);
+
+   close(c.fd);
+   free(c.fb);
+   ecore_evas_free(ee);
+
+   ck_assert_int_eq(ecore_evas_shutdown(), 0);
+}
+EFL_END_TEST
+#endif
+
 void ecore_test_ecore_evas(TCase *tc)
 {
    tcase_add_test(tc, ecore_test_ecore_evas_associate);
    tcase_add_test(tc, ecore_test_ecore_evas_cocoa);
    tcase_add_test(tc, ecore_test_ecore_evas_fallback_selection);
+#ifdef BUILD_ECORE_EVAS_VNC_SERVER
+   tcase_add_test(tc, ecore_test_ecore_evas_vnc_flush);
+#endif
 }
@@ -334,6 +334,51 @@ EFL_START_TEST(ecore_test_timer_iteration)
 }
 EFL_END_TEST
 
+#define HEAP_TIMERS 200
+#define HEAP_SLOTS 50
+
+static int heap_last = -1;
+static int heap_fired = 0;
+static int heap_expected = 0;
+
+static Eina_Bool
+_timer_heap_cb(void *data)
+{
+   int key = (intptr_t) data;
+
+   fail_if(key <= heap_last, "Error timer is called out of order");
+   heap_last = key;
+   if (++heap_fired == heap_expected) ecore_main_loop_quit();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+EFL_START_TEST(ecore_test_timer_heap_order)
+{
+   Ecore_Timer *timers[HEAP_TIMERS];
+   int i;
+
+   /* timers are added with the same loop time, so they must expire
+    * sorted by interval, and in the order they were added when the
+    * interval is the same */
+   for (i = 0; i < HEAP_TIMERS; i++)
+     {
+        int slot = (i * 7) % HEAP_SLOTS;
+
+        timers[i] = ecore_timer_loop_add(slot * 0.001, _timer_heap_cb,
+                                         (void *)(intptr_t)(slot * HEAP_TIMERS + i));
+        fail_if(timers[i] == NULL);
+     }
+
+   /* removing timers from the middle must keep the order of the others */
+   for (i = 0; i < HEAP_TIMERS; i += 3)
+     ecore_timer_del(timers[i]);
+   heap_expected = HEAP_TIMERS - ((HEAP_TIMERS + 2) / 3);
+
+   ecore_main_loop_begin();
+   ck_assert_int_eq(heap_fired, heap_expected);
+}
+EFL_END_TEST
+
 static Eina_Bool
 _recursion()
 {
@@ -425,4 +470,5 @@ void ecore_test_timer(TCase *tc)
   tcase_add_test(tc, ecore_test_timer_in_order);
   tcase_add_test(tc, ecore_test_timer_iteration);
   tcase_add_test(tc, ecore_test_timer_recursion);
+  tcase_add_test(tc, ecore_test_timer_heap_order);
 }
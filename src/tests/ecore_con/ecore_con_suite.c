@@ -12,6 +12,9 @@ static const Efl_Test_Case etc[] = {
   { "Ecore_Con_Url", ecore_con_test_ecore_con_url },
   { "Ecore_Con_Eet", ecore_con_test_ecore_con_eet },
   { "Efl_Net_Ip_Address", ecore_con_test_efl_net_ip_address },
+  { "Efl_Net_Dialer_Http", ecore_con_test_efl_net_dialer_http },
+  { "Efl_Net_Server_Tcp_Sharded", ecore_con_test_efl_net_server_tcp_sharded },
+  { "Ecore_Ipc", ecore_con_test_ecore_ipc },
   { NULL, NULL }
 };
 
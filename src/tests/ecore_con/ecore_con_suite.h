@@ -7,5 +7,8 @@ void ecore_con_test_ecore_con(TCase *tc);
 void ecore_con_test_ecore_con_url(TCase *tc);
 void ecore_con_test_ecore_con_eet(TCase *tc);
 void ecore_con_test_efl_net_ip_address(TCase *tc);
+void ecore_con_test_efl_net_dialer_http(TCase *tc);
+void ecore_con_test_efl_net_server_tcp_sharded(TCase *tc);
+void ecore_con_test_ecore_ipc(TCase *tc);
 
 #endif /* _ECORE_CON_SUITE_H */
@@ -0,0 +1,315 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Ecore.h>
+#include <Ecore_Con.h>
+#include <Ecore_Ipc.h>
+
+#include "ecore_con_suite.h"
+
+#define IPC_NAME "ecore_ipc_test_shm"
+#define IPC_PORT 28345
+#define PAYLOAD_SIZE (16 * 1024)
+
+/* same values as ECORE_IPC_HEAD_SHM and ECORE_IPC_HEAD_SHM_ACK */
+#define HEAD_SHM (1 << 24)
+#define HEAD_SHM_ACK (1 << 25)
+
+typedef struct _Ipc_Test
+{
+   unsigned char *payload;
+   Ecore_Ipc_Server *connected;
+   Eina_Binbuf *raw_received;
+   int client_received;
+   int server_received;
+   int raw_del;
+} Ipc_Test;
+
+static unsigned char *
+_payload_new(void)
+{
+   unsigned char *payload;
+   int i;
+
+   payload = malloc(PAYLOAD_SIZE);
+   ck_assert(payload != NULL);
+   for (i = 0; i < PAYLOAD_SIZE; i++)
+     payload[i] = (i * 7) & 0xff;
+   return payload;
+}
+
+static Eina_Bool
+_ipc_client_data(void *data, int type EINA_UNUSED, void *event)
+{
+   Ecore_Ipc_Event_Client_Data *e = event;
+   Ipc_Test *t = data;
+
+   ck_assert_int_eq(e->major, 1);
+   ck_assert_int_eq(e->size, PAYLOAD_SIZE);
+   ck_assert(!memcmp(e->data, t->payload, PAYLOAD_SIZE));
+   t->client_received++;
+
+   /* reply through the clients of the listening server, the size is the
+    * one of the message with its payload whatever the transport */
+   ck_assert_int_gt(ecore_ipc_client_send(e->client, 2, 0, 0, 0, 0,
+                                          t->payload, PAYLOAD_SIZE),
+                    PAYLOAD_SIZE);
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_ipc_old_client_data(void *data, int type EINA_UNUSED, void *event)
+{
+   Ecore_Ipc_Event_Client_Data *e = event;
+   Ipc_Test *t = data;
+
+   ck_assert_int_eq(e->size, 0);
+   t->client_received++;
+   ck_assert_int_gt(ecore_ipc_client_send(e->client, 2, 0, 0, 0, 0,
+                                          t->payload, PAYLOAD_SIZE),
+                    PAYLOAD_SIZE);
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_ipc_server_data(void *data, int type EINA_UNUSED, void *event)
+{
+   Ecore_Ipc_Event_Server_Data *e = event;
+   Ipc_Test *t = data;
+
+   ck_assert_int_eq(e->major, 2);
+   ck_assert_int_eq(e->size, PAYLOAD_SIZE);
+   ck_assert(!memcmp(e->data, t->payload, PAYLOAD_SIZE));
+   t->server_received++;
+
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_raw_server_del(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Ipc_Test *t = data;
+
+   t->raw_del++;
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_raw_server_data(void *data, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Server_Data *e = event;
+   Ipc_Test *t = data;
+
+   eina_binbuf_append_length(t->raw_received, e->data, e->size);
+   if (eina_binbuf_length_get(t->raw_received) >= sizeof(unsigned int) + PAYLOAD_SIZE)
+     ecore_main_loop_quit();
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_ipc_timeout(void *data)
+{
+   Ecore_Timer **timer = data;
+
+   *timer = NULL;
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_loop_run(double t)
+{
+   Ecore_Timer *timer;
+
+   timer = ecore_timer_add(t, _ipc_timeout, &timer);
+   ecore_main_loop_begin();
+   if (timer) ecore_timer_del(timer);
+}
+
+EFL_START_TEST(ecore_test_ecore_ipc_shm_threshold)
+{
+   Ecore_Ipc_Server *svr;
+
+   ck_assert_int_eq(ecore_ipc_init(), 1);
+
+   svr = ecore_ipc_server_add(ECORE_IPC_LOCAL_USER, IPC_NAME, 0, NULL);
+   ck_assert(svr != NULL);
+
+   ck_assert_int_eq(ecore_ipc_server_shm_threshold_get(svr), 0);
+   ecore_ipc_server_shm_threshold_set(svr, 4096);
+   ck_assert_int_eq(ecore_ipc_server_shm_threshold_get(svr), 4096);
+   ecore_ipc_server_shm_threshold_set(svr, -1);
+   ck_assert_int_eq(ecore_ipc_server_shm_threshold_get(svr), 0);
+
+   ecore_ipc_server_del(svr);
+
+   ck_assert_int_eq(ecore_ipc_shutdown(), 0);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_ecore_ipc_shm_round_trip)
+{
+   Ecore_Event_Handler *handlers[2];
+   Ecore_Ipc_Server *svr, *connected;
+   Ipc_Test t = { 0 };
+
+   ck_assert_int_eq(ecore_ipc_init(), 1);
+   t.payload = _payload_new();
+
+   svr = ecore_ipc_server_add(ECORE_IPC_LOCAL_USER, IPC_NAME, 0, NULL);
+   ck_assert(svr != NULL);
+   ecore_ipc_server_shm_threshold_set(svr, 4096);
+   _loop_run(0.1);
+
+   connected = ecore_ipc_server_connect(ECORE_IPC_LOCAL_USER, IPC_NAME, 0, NULL);
+   ck_assert(connected != NULL);
+   ecore_ipc_server_shm_threshold_set(connected, 4096);
+
+   handlers[0] = ecore_event_handler_add(ECORE_IPC_EVENT_CLIENT_DATA,
+                                         _ipc_client_data, &t);
+   handlers[1] = ecore_event_handler_add(ECORE_IPC_EVENT_SERVER_DATA,
+                                         _ipc_server_data, &t);
+
+   /* nothing came from the server yet, this one goes in the message */
+   ck_assert_int_gt(ecore_ipc_server_send(connected, 1, 0, 0, 0, 0,
+                                          t.payload, PAYLOAD_SIZE),
+                    PAYLOAD_SIZE);
+   _loop_run(5.0);
+
+   ck_assert_int_eq(t.client_received, 1);
+   ck_assert_int_eq(t.server_received, 1);
+
+   ecore_event_handler_del(handlers[0]);
+   ecore_event_handler_del(handlers[1]);
+   ecore_ipc_server_del(connected);
+   ecore_ipc_server_del(svr);
+   free(t.payload);
+
+   ck_assert_int_eq(ecore_ipc_shutdown(), 0);
+}
+EFL_END_TEST
+
+/* a peer that never says it reads shared memory, like an older
+ * Ecore_Ipc, gets the payload in the message */
+EFL_START_TEST(ecore_test_ecore_ipc_shm_old_peer)
+{
+   Ecore_Event_Handler *handlers[2];
+   Ecore_Ipc_Server *svr;
+   Ecore_Con_Server *raw;
+   Ipc_Test t = { 0 };
+   const unsigned char *received;
+   unsigned int v;
+
+   ck_assert_int_eq(ecore_ipc_init(), 1);
+   t.payload = _payload_new();
+   t.raw_received = eina_binbuf_new();
+
+   svr = ecore_ipc_server_add(ECORE_IPC_LOCAL_USER, IPC_NAME, 0, NULL);
+   ck_assert(svr != NULL);
+   ecore_ipc_server_shm_threshold_set(svr, 4096);
+   handlers[0] = ecore_event_handler_add(ECORE_IPC_EVENT_CLIENT_DATA,
+                                         _ipc_old_client_data, &t);
+   handlers[1] = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA,
+                                         _raw_server_data, &t);
+   _loop_run(0.1);
+
+   /* an empty message, with none of the high bits */
+   raw = ecore_con_server_connect(ECORE_CON_LOCAL_USER, IPC_NAME, 0, NULL);
+   ck_assert(raw != NULL);
+   v = 0;
+   ck_assert_int_eq(ecore_con_server_send(raw, &v, sizeof(v)), sizeof(v));
+
+   _loop_run(5.0);
+
+   ck_assert_int_eq(t.client_received, 1);
+   ck_assert_int_ge(eina_binbuf_length_get(t.raw_received),
+                    sizeof(unsigned int) + PAYLOAD_SIZE);
+   received = eina_binbuf_string_get(t.raw_received);
+   memcpy(&v, received, sizeof(v));
+   ck_assert_int_ne(eina_ntohl(v) & (HEAD_SHM | HEAD_SHM_ACK), HEAD_SHM);
+   ck_assert(!memcmp(received + eina_binbuf_length_get(t.raw_received) - PAYLOAD_SIZE,
+                     t.payload, PAYLOAD_SIZE));
+
+   ecore_event_handler_del(handlers[0]);
+   ecore_event_handler_del(handlers[1]);
+   ecore_con_server_del(raw);
+   ecore_ipc_server_del(svr);
+   eina_binbuf_free(t.raw_received);
+   free(t.payload);
+
+   ck_assert_int_eq(ecore_ipc_shutdown(), 0);
+}
+EFL_END_TEST
+
+/* a raw connection sending a single header with no payload */
+static void
+_forged_head_test(Ecore_Ipc_Type ipc_type, Ecore_Con_Type con_type,
+                  const char *name, int port, int head)
+{
+   Ecore_Event_Handler *handler;
+   Ecore_Ipc_Server *svr;
+   Ecore_Con_Server *raw;
+   Ipc_Test t = { 0 };
+   unsigned int v;
+
+   ck_assert_int_eq(ecore_ipc_init(), 1);
+
+   svr = ecore_ipc_server_add(ipc_type, name, port, NULL);
+   ck_assert(svr != NULL);
+   handler = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DEL,
+                                     _raw_server_del, &t);
+   _loop_run(0.1);
+
+   raw = ecore_con_server_connect(con_type, name, port, NULL);
+   ck_assert(raw != NULL);
+   v = eina_htonl(head);
+   ck_assert_int_eq(ecore_con_server_send(raw, &v, sizeof(v)), sizeof(v));
+
+   _loop_run(5.0);
+
+   /* the connection is dropped instead of trusting the peer */
+   ck_assert_int_eq(t.raw_del, 1);
+
+   ecore_event_handler_del(handler);
+   ecore_con_server_del(raw);
+   ecore_ipc_server_del(svr);
+
+   ck_assert_int_eq(ecore_ipc_shutdown(), 0);
+}
+
+EFL_START_TEST(ecore_test_ecore_ipc_shm_remote)
+{
+   _forged_head_test(ECORE_IPC_REMOTE_SYSTEM, ECORE_CON_REMOTE_TCP,
+                     "127.0.0.1", IPC_PORT, HEAD_SHM);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_ecore_ipc_shm_remote_ack)
+{
+   _forged_head_test(ECORE_IPC_REMOTE_SYSTEM, ECORE_CON_REMOTE_TCP,
+                     "127.0.0.1", IPC_PORT, HEAD_SHM_ACK);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_ecore_ipc_shm_unexpected_ack)
+{
+   _forged_head_test(ECORE_IPC_LOCAL_USER, ECORE_CON_LOCAL_USER,
+                     IPC_NAME, 0, HEAD_SHM_ACK);
+}
+EFL_END_TEST
+
+void ecore_con_test_ecore_ipc(TCase *tc)
+{
+   tcase_add_test(tc, ecore_test_ecore_ipc_shm_threshold);
+   tcase_add_test(tc, ecore_test_ecore_ipc_shm_round_trip);
+   tcase_add_test(tc, ecore_test_ecore_ipc_shm_old_peer);
+   tcase_add_test(tc, ecore_test_ecore_ipc_shm_remote);
+   tcase_add_test(tc, ecore_test_ecore_ipc_shm_remote_ack);
+   tcase_add_test(tc, ecore_test_ecore_ipc_shm_unexpected_ack);
+}
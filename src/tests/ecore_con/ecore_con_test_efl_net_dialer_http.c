@@ -0,0 +1,209 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <Ecore.h>
+#include <Ecore_Con.h>
+
+#include "ecore_con_suite.h"
+
+#define HTTP_PORT 12346
+#define HTTP_REQUESTS 5
+
+/* Minimal keep-alive HTTP/1.1 server answering "ok" to every request */
+static const char http_reply[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: text/plain\r\n"
+  "Content-Length: 2\r\n"
+  "\r\n"
+  "ok";
+
+typedef struct _Http_Test
+{
+   Ecore_Con_Server *server;
+   Eo *share;
+   Eo *dialers[HTTP_REQUESTS];
+   unsigned int connections;
+   unsigned int requests;
+   unsigned int done;
+} Http_Test;
+
+static Eina_Bool
+_server_client_add(void *data, int type EINA_UNUSED, void *event)
+{
+   Http_Test *t = data;
+   Ecore_Con_Event_Client_Add *ev = event;
+
+   if (ecore_con_client_server_get(ev->client) != t->server)
+     return ECORE_CALLBACK_PASS_ON;
+
+   ecore_con_client_data_set(ev->client, eina_strbuf_new());
+   t->connections++;
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_server_client_del(void *data, int type EINA_UNUSED, void *event)
+{
+   Http_Test *t = data;
+   Ecore_Con_Event_Client_Del *ev = event;
+
+   if (ecore_con_client_server_get(ev->client) != t->server)
+     return ECORE_CALLBACK_PASS_ON;
+
+   eina_strbuf_free(ecore_con_client_data_get(ev->client));
+   ecore_con_client_del(ev->client);
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_server_client_data(void *data, int type EINA_UNUSED, void *event)
+{
+   Http_Test *t = data;
+   Ecore_Con_Event_Client_Data *ev = event;
+   Eina_Strbuf *buf;
+   const char *end;
+
+   if (ecore_con_client_server_get(ev->client) != t->server)
+     return ECORE_CALLBACK_PASS_ON;
+
+   buf = ecore_con_client_data_get(ev->client);
+   eina_strbuf_append_length(buf, ev->data, ev->size);
+
+   /* requests have no body, answer each complete header block */
+   while ((end = strstr(eina_strbuf_string_get(buf), "\r\n\r\n")))
+     {
+        size_t len = end - eina_strbuf_string_get(buf) + 4;
+
+        eina_strbuf_remove(buf, 0, len);
+        ecore_con_client_send(ev->client, http_reply, sizeof(http_reply) - 1);
+        t->requests++;
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void _dialer_start(Http_Test *t);
+
+static void
+_dialer_can_read(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   char buf[64];
+   Eina_Rw_Slice rw_slice = {.mem = buf, .len = sizeof(buf)};
+
+   if (!efl_io_reader_can_read_get(event->object)) return;
+   efl_io_reader_read(event->object, &rw_slice);
+}
+
+static void
+_dialer_error(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Eina_Error *perr = event->info;
+
+   ck_abort_msg("dialer error: %s", eina_error_msg_get(*perr));
+}
+
+static void
+_dialer_closed(void *data, const Efl_Event *event)
+{
+   Http_Test *t = data;
+
+   ck_assert_int_eq(efl_net_dialer_http_response_status_get(event->object), 200);
+
+   t->done++;
+   if (t->done < HTTP_REQUESTS)
+     _dialer_start(t);
+   else
+     ecore_main_loop_quit();
+}
+
+EFL_CALLBACKS_ARRAY_DEFINE(dialer_cbs,
+                           { EFL_IO_READER_EVENT_CAN_READ_CHANGED, _dialer_can_read },
+                           { EFL_NET_DIALER_EVENT_DIALER_ERROR, _dialer_error },
+                           { EFL_IO_CLOSER_EVENT_CLOSED, _dialer_closed });
+
+static void
+_dialer_start(Http_Test *t)
+{
+   Eo *dialer;
+   char address[64];
+
+   dialer = efl_add(EFL_NET_DIALER_HTTP_CLASS, efl_main_loop_get(),
+                    efl_net_dialer_http_share_set(efl_added, t->share),
+                    efl_event_callback_array_add(efl_added, dialer_cbs(), t));
+   ck_assert_ptr_ne(dialer, NULL);
+   t->dialers[t->done] = dialer;
+
+   snprintf(address, sizeof(address), "http://127.0.0.1:%d/%u", HTTP_PORT, t->done);
+   ck_assert_int_eq(efl_net_dialer_dial(dialer, address), 0);
+}
+
+static void
+_http_test_run(Http_Test *t)
+{
+   Ecore_Event_Handler *handlers[3];
+   unsigned int i;
+
+   t->server = ecore_con_server_add(ECORE_CON_REMOTE_TCP, "127.0.0.1",
+                                    HTTP_PORT, NULL);
+   ck_assert_ptr_ne(t->server, NULL);
+
+   handlers[0] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_ADD,
+                                         _server_client_add, t);
+   handlers[1] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DEL,
+                                         _server_client_del, t);
+   handlers[2] = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA,
+                                         _server_client_data, t);
+
+   _dialer_start(t);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(t->done, HTTP_REQUESTS);
+   ck_assert_int_eq(t->requests, HTTP_REQUESTS);
+
+   for (i = 0; i < HTTP_REQUESTS; i++)
+     efl_del(t->dialers[i]);
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(handlers); i++)
+     ecore_event_handler_del(handlers[i]);
+   ecore_con_server_del(t->server);
+}
+
+EFL_START_TEST(ecore_test_efl_net_dialer_http_share_reuse)
+{
+   Http_Test t = { 0 };
+
+   t.share = efl_add(EFL_NET_DIALER_HTTP_SHARE_CLASS, efl_main_loop_get(),
+                     efl_net_dialer_http_share_http_version_set(efl_added, EFL_NET_HTTP_VERSION_V1_1),
+                     efl_net_dialer_http_share_max_host_connections_set(efl_added, 2));
+   ck_assert_ptr_ne(t.share, NULL);
+   ck_assert_int_eq(efl_net_dialer_http_share_http_version_get(t.share), EFL_NET_HTTP_VERSION_V1_1);
+   ck_assert_int_eq(efl_net_dialer_http_share_max_host_connections_get(t.share), 2);
+   ck_assert_int_eq(efl_net_dialer_http_share_multiplex_get(t.share), EINA_TRUE);
+
+   _http_test_run(&t);
+
+   /* all the requests went through the same kept alive connection */
+   ck_assert_int_eq(t.connections, 1);
+
+   efl_del(t.share);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_efl_net_dialer_http_share_none)
+{
+   Http_Test t = { 0 };
+
+   _http_test_run(&t);
+
+   /* without a share the connection does not outlive its dialer */
+   ck_assert_int_eq(t.connections, HTTP_REQUESTS);
+}
+EFL_END_TEST
+
+void ecore_con_test_efl_net_dialer_http(TCase *tc)
+{
+   tcase_add_test(tc, ecore_test_efl_net_dialer_http_share_reuse);
+   tcase_add_test(tc, ecore_test_efl_net_dialer_http_share_none);
+}
@@ -0,0 +1,182 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Ecore.h>
+#include <Ecore_Con.h>
+
+#include "ecore_con_suite.h"
+
+#define SHARDS 3
+#define CLIENTS 12
+
+typedef struct _Sharded_Test
+{
+   Eina_Spinlock lock;
+   unsigned int setup_mask; /* protected by lock, written by the shards */
+   unsigned int accepted; /* main loop only */
+   Eo *dialers[CLIENTS];
+   Eina_Error error;
+} Sharded_Test;
+
+static void
+_sharded_accepted(void *data)
+{
+   Sharded_Test *t = data;
+
+   t->accepted++;
+   if (t->accepted == CLIENTS) ecore_main_loop_quit();
+}
+
+/* runs in a shard thread */
+static void
+_sharded_client_add(void *data, const Efl_Event *event EINA_UNUSED)
+{
+   ecore_main_loop_thread_safe_call_async(_sharded_accepted, data);
+}
+
+/* runs in a shard thread */
+static void
+_sharded_setup(void *data, Eo *server, unsigned int shard)
+{
+   Sharded_Test *t = data;
+
+   ck_assert(efl_isa(server, EFL_NET_SERVER_TCP_CLASS));
+   ck_assert(efl_net_server_fd_reuse_port_get(server));
+   ck_assert(efl_provider_find(server, EFL_LOOP_CLASS) != efl_main_loop_get());
+
+   eina_spinlock_take(&t->lock);
+   t->setup_mask |= 1 << shard;
+   eina_spinlock_release(&t->lock);
+
+   efl_event_callback_add(server, EFL_NET_SERVER_EVENT_CLIENT_ADD,
+                          _sharded_client_add, t);
+}
+
+static void
+_sharded_serving(void *data EINA_UNUSED, const Efl_Event *event EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+static void
+_sharded_shard_error(void *data, const Efl_Event *event)
+{
+   Sharded_Test *t = data;
+   Eina_Error *perr = event->info;
+
+   t->error = *perr;
+   ecore_main_loop_quit();
+}
+
+EFL_CALLBACKS_ARRAY_DEFINE(sharded_cbs,
+                           { EFL_NET_SERVER_TCP_SHARDED_EVENT_SERVING, _sharded_serving },
+                           { EFL_NET_SERVER_TCP_SHARDED_EVENT_SHARD_ERROR, _sharded_shard_error });
+
+EFL_START_TEST(ecore_test_efl_net_server_tcp_sharded_serve)
+{
+   Sharded_Test t = { 0 };
+   const char *address;
+   unsigned int i;
+   Eo *server;
+
+   ck_assert(eina_spinlock_new(&t.lock));
+
+   server = efl_add(EFL_NET_SERVER_TCP_SHARDED_CLASS, efl_main_loop_get(),
+                    efl_net_server_tcp_sharded_shards_set(efl_added, SHARDS),
+                    efl_net_server_tcp_sharded_shard_setup_set(efl_added, &t, _sharded_setup, NULL),
+                    efl_event_callback_array_add(efl_added, sharded_cbs(), &t));
+   ck_assert_ptr_ne(server, NULL);
+   ck_assert_int_eq(efl_net_server_tcp_sharded_shards_get(server), SHARDS);
+
+   /* port 0: the first shard picks it, the others reuse it */
+   ck_assert_int_eq(efl_net_server_tcp_sharded_serve(server, "127.0.0.1:0"), 0);
+   ck_assert_int_eq(efl_net_server_tcp_sharded_serve(server, "127.0.0.1:0"), EALREADY);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(t.error, 0);
+   ck_assert(efl_net_server_tcp_sharded_serving_get(server));
+   ck_assert_int_eq(t.setup_mask, (1 << SHARDS) - 1);
+
+   address = efl_net_server_tcp_sharded_address_get(server);
+   ck_assert_ptr_ne(address, NULL);
+   ck_assert_str_ne(address, "127.0.0.1:0");
+
+   for (i = 0; i < CLIENTS; i++)
+     {
+        t.dialers[i] = efl_add(EFL_NET_DIALER_TCP_CLASS, efl_main_loop_get());
+        ck_assert_int_eq(efl_net_dialer_dial(t.dialers[i], address), 0);
+     }
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(t.accepted, CLIENTS);
+
+   for (i = 0; i < CLIENTS; i++)
+     efl_del(t.dialers[i]);
+   efl_del(server);
+   eina_spinlock_free(&t.lock);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_efl_net_server_tcp_sharded_resolve)
+{
+   Sharded_Test t = { 0 };
+   const char *address;
+   Eo *server;
+
+   ck_assert(eina_spinlock_new(&t.lock));
+
+   server = efl_add(EFL_NET_SERVER_TCP_SHARDED_CLASS, efl_main_loop_get(),
+                    efl_net_server_tcp_sharded_shards_set(efl_added, SHARDS),
+                    efl_net_server_tcp_sharded_shard_setup_set(efl_added, &t, _sharded_setup, NULL),
+                    efl_event_callback_array_add(efl_added, sharded_cbs(), &t));
+   ck_assert_ptr_ne(server, NULL);
+
+   /* the name is resolved on the main loop, shards get the address */
+   ck_assert_int_eq(efl_net_server_tcp_sharded_serve(server, "localhost:0"), 0);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(t.error, 0);
+   ck_assert(efl_net_server_tcp_sharded_serving_get(server));
+   ck_assert_int_eq(t.setup_mask, (1 << SHARDS) - 1);
+
+   address = efl_net_server_tcp_sharded_address_get(server);
+   ck_assert_ptr_ne(address, NULL);
+   ck_assert(strncmp(address, "localhost", strlen("localhost")) != 0);
+
+   efl_del(server);
+   eina_spinlock_free(&t.lock);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_efl_net_server_tcp_sharded_error)
+{
+   Sharded_Test t = { 0 };
+   Eo *server;
+
+   server = efl_add(EFL_NET_SERVER_TCP_SHARDED_CLASS, efl_main_loop_get(),
+                    efl_net_server_tcp_sharded_shards_set(efl_added, SHARDS),
+                    efl_event_callback_array_add(efl_added, sharded_cbs(), &t));
+   ck_assert_ptr_ne(server, NULL);
+
+   /* TEST-NET-1, not a local address so bind() fails in the first shard */
+   ck_assert_int_eq(efl_net_server_tcp_sharded_serve(server, "192.0.2.1:0"), 0);
+   ecore_main_loop_begin();
+
+   ck_assert_int_ne(t.error, 0);
+   ck_assert(!efl_net_server_tcp_sharded_serving_get(server));
+   ck_assert_ptr_eq(efl_net_server_tcp_sharded_address_get(server), NULL);
+
+   efl_del(server);
+}
+EFL_END_TEST
+
+void ecore_con_test_efl_net_server_tcp_sharded(TCase *tc)
+{
+   tcase_add_test(tc, ecore_test_efl_net_server_tcp_sharded_serve);
+   tcase_add_test(tc, ecore_test_efl_net_server_tcp_sharded_resolve);
+   tcase_add_test(tc, ecore_test_efl_net_server_tcp_sharded_error);
+}
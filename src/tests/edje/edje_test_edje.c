@@ -4,6 +4,7 @@
 
 #include <unistd.h>
 #include <stdio.h>
+#include <string.h>
 
 #define EFL_GFX_FILTER_BETA
 #define EFL_CANVAS_LAYOUT_BETA
@@ -293,6 +294,96 @@ EFL_START_TEST(edje_test_part_caching)
 }
 EFL_END_TEST
 
+static const char *_partial_recalc_parts[] = { "knob", "follow", "follow2", "other" };
+
+static void
+_partial_recalc_geometry_get(Evas_Object *obj, Eina_Rect *parts, Eina_Rect *objs)
+{
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_partial_recalc_parts); i++)
+     {
+        const Evas_Object *o;
+
+        fail_unless(edje_object_part_geometry_get(obj, _partial_recalc_parts[i],
+                                                  &parts[i].x, &parts[i].y,
+                                                  &parts[i].w, &parts[i].h));
+        o = edje_object_part_object_get(obj, _partial_recalc_parts[i]);
+        fail_if(!o);
+        evas_object_geometry_get(o, &objs[i].x, &objs[i].y, &objs[i].w, &objs[i].h);
+     }
+}
+
+EFL_START_TEST(edje_test_partial_recalc)
+{
+   Eina_Rect before[4], parts[4], objs[4], ref_parts[4], ref_objs[4];
+   Evas *evas = _setup_evas();
+   Evas_Object *obj, *ref;
+   unsigned int i;
+
+   obj = edje_object_add(evas);
+   fail_unless(edje_object_file_set(obj, test_layout_get("test_partial_recalc.edj"), "test_group"));
+   evas_object_resize(obj, 100, 100);
+   _partial_recalc_geometry_get(obj, before, objs);
+
+   /* Only knob is flagged dirty: the partial walk has to reach follow
+    * and follow2 through the dependency graph and leave other alone. */
+   fail_unless(edje_object_part_drag_value_set(obj, "knob", 0.5, 1.0));
+   _partial_recalc_geometry_get(obj, parts, objs);
+
+   /* Same drag value set before the first calc, so a full recalc. */
+   ref = edje_object_add(evas);
+   fail_unless(edje_object_file_set(ref, test_layout_get("test_partial_recalc.edj"), "test_group"));
+   evas_object_resize(ref, 100, 100);
+   fail_unless(edje_object_part_drag_value_set(ref, "knob", 0.5, 1.0));
+   _partial_recalc_geometry_get(ref, ref_parts, ref_objs);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_partial_recalc_parts); i++)
+     {
+        ck_assert(eina_rectangle_equal(&parts[i].rect, &ref_parts[i].rect));
+        ck_assert(eina_rectangle_equal(&objs[i].rect, &ref_objs[i].rect));
+        ck_assert(eina_rectangle_equal(&parts[i].rect, &objs[i].rect));
+     }
+
+   /* knob, follow and follow2 moved, other did not */
+   ck_assert_int_eq(parts[0].x, 45);
+   ck_assert_int_eq(parts[0].y, 90);
+   ck_assert_int_eq(parts[1].x, parts[0].x + parts[0].w);
+   ck_assert_int_eq(parts[1].y, parts[0].y + parts[0].h);
+   ck_assert_int_eq(parts[2].x, parts[1].x + parts[1].w);
+   ck_assert_int_eq(parts[2].y, parts[1].y);
+   for (i = 0; i < 3; i++)
+     ck_assert_int_ne(parts[i].x, before[i].x);
+   ck_assert(eina_rectangle_equal(&parts[3].rect, &before[3].rect));
+}
+EFL_END_TEST
+
+EFL_START_TEST(edje_test_cc_threads)
+{
+   Eina_File *serial, *threaded;
+   void *m1, *m2;
+   size_t size;
+
+   /* both are built from test_table.edc, with -threads 1 and -threads 4 */
+   serial = eina_file_open(test_layout_get("test_table_threads1.edj"), EINA_FALSE);
+   fail_if(!serial);
+   threaded = eina_file_open(test_layout_get("test_table_threads4.edj"), EINA_FALSE);
+   fail_if(!threaded);
+
+   size = eina_file_size_get(serial);
+   ck_assert_int_eq(size, eina_file_size_get(threaded));
+   m1 = eina_file_map_all(serial, EINA_FILE_SEQUENTIAL);
+   m2 = eina_file_map_all(threaded, EINA_FILE_SEQUENTIAL);
+   fail_if((!m1) || (!m2));
+   ck_assert(!memcmp(m1, m2, size));
+
+   eina_file_map_free(serial, m1);
+   eina_file_map_free(threaded, m2);
+   eina_file_close(serial);
+   eina_file_close(threaded);
+}
+EFL_END_TEST
+
 void edje_test_edje(TCase *tc)
 {
    tcase_add_test(tc, edje_test_edje_init);
@@ -305,4 +396,6 @@ void edje_test_edje(TCase *tc)
    tcase_add_test(tc, edje_test_access);
    tcase_add_test(tc, edje_test_combine_keywords);
    tcase_add_test(tc, edje_test_part_caching);
+   tcase_add_test(tc, edje_test_partial_recalc);
+   tcase_add_test(tc, edje_test_cc_threads);
 }
@@ -448,10 +448,124 @@ EFL_START_TEST(eet_test_file_fp)
 }
 EFL_END_TEST
 
+#ifdef HAVE_ZSTD
+EFL_START_TEST(eet_test_file_zstd)
+{
+   Eina_Array *samples;
+   Eina_Binbuf *dict;
+   Eet_File *ef;
+   char *file;
+   char *test;
+   char key[64];
+   char buf[256];
+   int tmpfd;
+   int size;
+   int i;
+
+   file = strdup("/tmp/eet_suite_testXXXXXX");
+
+   fail_if(-1 == (tmpfd = mkstemp(file)));
+   fail_if(!!close(tmpfd));
+
+   samples = eina_array_new(64);
+   for (i = 0; i < 1000; i++)
+     {
+        Eina_Binbuf *sample = eina_binbuf_new();
+
+        size = snprintf(buf, sizeof(buf),
+                        "collections { group { name: \"item/%i\"; "
+                        "parts { rect { \"bg\"; desc { color: %i %i %i 255; } } } } }",
+                        i, i & 0xff, (i * 3) & 0xff, (i * 7) & 0xff);
+        eina_binbuf_append_length(sample, (unsigned char *)buf, size + 1);
+        eina_array_push(samples, sample);
+     }
+   dict = emile_compress_dict_train(EMILE_ZSTD, samples, 4096);
+   fail_if(!dict);
+
+   ef = eet_open(file, EET_FILE_MODE_WRITE);
+   fail_if(!ef);
+
+   fail_if(!eet_write(ef, "keys/before", "written before the dictionary", 30,
+                      EET_COMPRESSION_ZSTD));
+   fail_if(!eet_compression_dict_set(ef, eina_binbuf_string_get(dict),
+                                     eina_binbuf_length_get(dict)));
+   /* only one per file */
+   fail_if(eet_compression_dict_set(ef, eina_binbuf_string_get(dict),
+                                    eina_binbuf_length_get(dict)));
+
+   for (i = 0; i < 100; i++)
+     {
+        Eina_Binbuf *sample = eina_array_data_get(samples, i);
+
+        snprintf(key, sizeof(key), "keys/%i", i);
+        fail_if(!eet_write(ef, key, eina_binbuf_string_get(sample),
+                           eina_binbuf_length_get(sample),
+                           EET_COMPRESSION_ZSTD));
+     }
+   fail_if(!eet_alias(ef, "keys/alias", "keys/42", EET_COMPRESSION_ZSTD));
+
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+
+   test = eet_read(ef, "keys/before", &size);
+   fail_if(!test);
+   fail_if(size != 30);
+   fail_if(strcmp(test, "written before the dictionary"));
+   free(test);
+
+   for (i = 0; i < 100; i++)
+     {
+        Eina_Binbuf *sample = eina_array_data_get(samples, i);
+
+        snprintf(key, sizeof(key), "keys/%i", i);
+        test = eet_read(ef, key, &size);
+        fail_if(!test);
+        fail_if(size != (int)eina_binbuf_length_get(sample));
+        fail_if(memcmp(test, eina_binbuf_string_get(sample), size));
+        free(test);
+     }
+   fail_if(strcmp(eet_alias_get(ef, "keys/alias"), "keys/42"));
+
+   eet_close(ef);
+
+   /* appending to the file keeps using the stored dictionary */
+   ef = eet_open(file, EET_FILE_MODE_READ_WRITE);
+   fail_if(!ef);
+   fail_if(eet_compression_dict_set(ef, eina_binbuf_string_get(dict),
+                                    eina_binbuf_length_get(dict)));
+   fail_if(!eet_write(ef, "keys/after", eina_binbuf_string_get(dict), 64,
+                      EET_COMPRESSION_ZSTD));
+   eet_close(ef);
+
+   ef = eet_open(file, EET_FILE_MODE_READ);
+   fail_if(!ef);
+   test = eet_read(ef, "keys/after", &size);
+   fail_if(!test);
+   fail_if(size != 64);
+   fail_if(memcmp(test, eina_binbuf_string_get(dict), 64));
+   free(test);
+   eet_close(ef);
+
+   eina_binbuf_free(dict);
+   while (eina_array_count(samples))
+     eina_binbuf_free(eina_array_pop(samples));
+   eina_array_free(samples);
+
+   fail_if(unlink(file) != 0);
+   free(file);
+}
+EFL_END_TEST
+#endif
+
 void eet_test_file(TCase *tc)
 {
    tcase_add_test(tc, eet_test_file_simple_write);
    tcase_add_test(tc, eet_test_file_data);
    tcase_add_test(tc, eet_test_file_data_dump);
    tcase_add_test(tc, eet_test_file_fp);
+#ifdef HAVE_ZSTD
+   tcase_add_test(tc, eet_test_file_zstd);
+#endif
 }
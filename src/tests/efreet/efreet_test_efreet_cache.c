@@ -2,10 +2,89 @@
 # include <config.h>
 #endif
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef _WIN32
+# include <evil_private.h> /* setenv */
+#endif
+
+#include <Eina.h>
+#include <Eet.h>
+
+#define EFREET_MODULE_LOG_DOM /* no logging in this file */
+
 #include <Efreet.h>
+#include "efreet_private.h"
+#include "efreet_cache_private.h"
 
 #include "efreet_suite.h"
 
+#define ICON_INDEX_COUNT 100
+
+static Eina_Tmpstr *_cache_home = NULL;
+
+/* Restart efreet on an empty cache home, without efreetd, so that the
+ * only icon caches are the ones written by the test. */
+static void
+_cache_home_setup(void)
+{
+   ck_assert_int_eq(efreet_shutdown(), 0);
+   ck_assert(eina_file_mkdtemp("efreet_cache_test_XXXXXX", &_cache_home));
+   setenv("XDG_CACHE_HOME", _cache_home, 1);
+   efreet_cache_disable();
+   ck_assert_int_eq(efreet_init(), 1);
+}
+
+static void
+_cache_home_teardown(void)
+{
+   char buf[PATH_MAX];
+
+   unlink(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK));
+   snprintf(buf, sizeof(buf), "%s/efreet", _cache_home);
+   rmdir(buf);
+   rmdir(_cache_home);
+   eina_tmpstr_del(_cache_home);
+   _cache_home = NULL;
+}
+
+static void
+_fallback_free(void *data)
+{
+   Efreet_Cache_Fallback_Icon *icon = data;
+
+   free((char *)icon->icons[0]);
+   free(icon->icons);
+   free(icon);
+}
+
+static Eina_Bool
+_fallback_index_write(void)
+{
+   Efreet_Cache_Fallback_Icon *icon;
+   Eina_Hash *entries;
+   Eina_Bool ret;
+   char buf[PATH_MAX];
+   int i;
+
+   entries = eina_hash_string_superfast_new(_fallback_free);
+   for (i = 0; i < ICON_INDEX_COUNT; i++)
+     {
+        icon = calloc(1, sizeof(Efreet_Cache_Fallback_Icon));
+        icon->icons = calloc(1, sizeof(const char *));
+        snprintf(buf, sizeof(buf), "/usr/share/pixmaps/icon%d.png", i);
+        icon->icons[0] = strdup(buf);
+        icon->icons_count = 1;
+        snprintf(buf, sizeof(buf), "icon%d", i);
+        eina_hash_add(entries, buf, icon);
+     }
+   ret = efreet_icon_index_write(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK),
+                                 entries, EINA_TRUE);
+   eina_hash_free(entries);
+   return ret;
+}
 
 EFL_START_TEST(efreet_test_efreet_cache_init)
 {
@@ -13,7 +92,59 @@ EFL_START_TEST(efreet_test_efreet_cache_init)
 }
 EFL_END_TEST
 
+EFL_START_TEST(efreet_test_efreet_cache_icon_index)
+{
+   const char *path;
+   char buf[PATH_MAX];
+   int i;
+
+   _cache_home_setup();
+
+   ck_assert(_fallback_index_write());
+   for (i = 0; i < ICON_INDEX_COUNT; i++)
+     {
+        snprintf(buf, sizeof(buf), "icon%d", i);
+        path = efreet_icon_path_find("no_such_theme", buf, 48);
+        ck_assert_ptr_ne(path, NULL);
+        snprintf(buf, sizeof(buf), "/usr/share/pixmaps/icon%d.png", i);
+        ck_assert_str_eq(path, buf);
+     }
+   ck_assert_ptr_eq(efreet_icon_path_find("no_such_theme", "icon", 48), NULL);
+   ck_assert_ptr_eq(efreet_icon_path_find("no_such_theme", "no_such_icon", 48), NULL);
+
+   _cache_home_teardown();
+}
+EFL_END_TEST
+
+EFL_START_TEST(efreet_test_efreet_cache_icon_index_invalid)
+{
+   FILE *f;
+
+   _cache_home_setup();
+
+   /* a truncated index is ignored, not trusted */
+   ck_assert(_fallback_index_write());
+   ck_assert_int_eq(truncate(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK),
+                             sizeof(Efreet_Icon_Index_Header) + 8), 0);
+   ck_assert_ptr_eq(efreet_icon_path_find("no_such_theme", "icon1", 48), NULL);
+
+   _cache_home_teardown();
+   _cache_home_setup();
+
+   /* so is anything that is not an index */
+   f = fopen(efreet_icon_index_file(EFREET_CACHE_ICON_FALLBACK), "wb");
+   ck_assert_ptr_ne(f, NULL);
+   fprintf(f, "not an icon index, but long enough to hold a header");
+   fclose(f);
+   ck_assert_ptr_eq(efreet_icon_path_find("no_such_theme", "icon1", 48), NULL);
+
+   _cache_home_teardown();
+}
+EFL_END_TEST
+
 void efreet_test_efreet_cache(TCase *tc)
 {
    tcase_add_test(tc, efreet_test_efreet_cache_init);
+   tcase_add_test(tc, efreet_test_efreet_cache_icon_index);
+   tcase_add_test(tc, efreet_test_efreet_cache_icon_index_invalid);
 }
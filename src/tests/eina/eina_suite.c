@@ -34,6 +34,7 @@
 static const Efl_Test_Case etc[] = {
    { "fp", eina_test_fp },
    { "Inarray", eina_test_inarray },
+   { "Chunk_List", eina_test_chunk_list },
    { "Array", eina_test_array },
    { "binshare", eina_test_binshare },
    { "stringshare", eina_test_stringshare },
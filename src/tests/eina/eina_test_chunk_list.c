@@ -0,0 +1,258 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include <Eina.h>
+
+#include "eina_suite.h"
+
+#define ITEMS (EINA_CHUNK_LIST_CHUNK_MAX * 3 + 7)
+
+/* the second chunk is twice as big as the first one */
+#define SECOND_START EINA_CHUNK_LIST_CHUNK_MIN
+#define SECOND_END (EINA_CHUNK_LIST_CHUNK_MIN * 3)
+#define THIRD_END (EINA_CHUNK_LIST_CHUNK_MIN * 7)
+
+EFL_START_TEST(eina_chunk_list_test_simple)
+{
+   Eina_Chunk_List *list;
+   Eina_Chunk_List_Item *items[ITEMS];
+   Eina_Chunk_List_Chunk *chunk;
+   Eina_Iterator *it;
+   int values[ITEMS];
+   unsigned int index;
+   int *data;
+   int i;
+
+   list = eina_chunk_list_new();
+   fail_if(!list);
+   ck_assert_int_eq(eina_chunk_list_count(list), 0);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), NULL);
+
+   for (i = 0; i < ITEMS; i++)
+     {
+        values[i] = i;
+        items[i] = eina_chunk_list_append(list, &values[i]);
+        fail_if(!items[i]);
+        ck_assert_ptr_eq(eina_chunk_list_item_data_get(items[i]), &values[i]);
+     }
+   ck_assert_int_eq(eina_chunk_list_count(list), ITEMS);
+
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     ck_assert_int_eq(*data, i++);
+   ck_assert_int_eq(i, ITEMS);
+
+   /* odd items and the whole second chunk */
+   for (i = 0; i < ITEMS; i++)
+     if ((i & 1) ||
+         ((i >= SECOND_START) && (i < SECOND_END)))
+       eina_chunk_list_remove(list, items[i]);
+
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     {
+        if (i == SECOND_START) i = SECOND_END;
+        ck_assert_int_eq(*data, i);
+        i += 2;
+     }
+   ck_assert_int_eq(eina_chunk_list_count(list), (ITEMS + 1) / 2 - (SECOND_END - SECOND_START) / 2);
+
+   /* the handles of the remaining items are still good */
+   ck_assert_ptr_eq(eina_chunk_list_item_data_get(items[ITEMS - 1]), &values[ITEMS - 1]);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), &values[0]);
+
+   it = eina_chunk_list_iterator_new(list);
+   fail_if(!it);
+   ck_assert_ptr_eq(eina_iterator_container_get(it), list);
+   i = 0;
+   EINA_ITERATOR_FOREACH(it, data)
+     {
+        if (i == SECOND_START) i = SECOND_END;
+        ck_assert_int_eq(*data, i);
+        i += 2;
+     }
+   eina_iterator_free(it);
+
+   eina_chunk_list_free(list);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_chunk_list_test_walk_remove)
+{
+   Eina_Chunk_List *list;
+   Eina_Chunk_List_Item *items[ITEMS];
+   Eina_Chunk_List_Chunk *chunk;
+   int values[ITEMS];
+   unsigned int index;
+   int *data;
+   int i;
+
+   list = eina_chunk_list_new();
+   fail_if(!list);
+
+   for (i = 0; i < ITEMS; i++)
+     {
+        values[i] = i;
+        items[i] = eina_chunk_list_append(list, &values[i]);
+     }
+
+   /* removing the current item empties and releases chunks under the walk */
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     {
+        ck_assert_int_eq(*data, i);
+        eina_chunk_list_remove(list, items[*data]);
+        i++;
+     }
+   ck_assert_int_eq(i, ITEMS);
+   ck_assert_int_eq(eina_chunk_list_count(list), 0);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), NULL);
+
+   /* the list is usable again once empty */
+   for (i = 0; i < ITEMS; i++)
+     items[i] = eina_chunk_list_append(list, &values[i]);
+   ck_assert_int_eq(eina_chunk_list_count(list), ITEMS);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), &values[0]);
+
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     ck_assert_int_eq(*data, i++);
+   ck_assert_int_eq(i, ITEMS);
+
+   eina_chunk_list_free(list);
+
+   i = 0;
+   list = NULL;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     i++;
+   ck_assert_int_eq(i, 0);
+   ck_assert_int_eq(eina_chunk_list_count(list), 0);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_chunk_list_test_walk_remove_others)
+{
+   Eina_Chunk_List *list;
+   Eina_Chunk_List_Item *items[ITEMS];
+   Eina_Chunk_List_Chunk *chunk;
+   int values[ITEMS];
+   unsigned int index;
+   int *data;
+   int i;
+
+   list = eina_chunk_list_new();
+   fail_if(!list);
+
+   for (i = 0; i < ITEMS; i++)
+     {
+        values[i] = i;
+        items[i] = eina_chunk_list_append(list, &values[i]);
+     }
+
+   /* the chunk being walked empties, then the third one while the walk is
+    * still in the first one */
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     {
+        int j;
+
+        if (i == SECOND_END) i = THIRD_END;
+        ck_assert_int_eq(*data, i);
+        eina_chunk_list_remove(list, items[*data]);
+        if (*data == SECOND_START - 1)
+          for (j = SECOND_END; j < THIRD_END; j++)
+            eina_chunk_list_remove(list, items[j]);
+        i++;
+     }
+   ck_assert_int_eq(i, ITEMS);
+   ck_assert_int_eq(eina_chunk_list_count(list), 0);
+
+   eina_chunk_list_compact(list);
+   ck_assert_ptr_eq(list->pending, NULL);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), NULL);
+
+   for (i = 0; i < ITEMS; i++)
+     items[i] = eina_chunk_list_append(list, &values[i]);
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     ck_assert_int_eq(*data, i++);
+   ck_assert_int_eq(i, ITEMS);
+
+   eina_chunk_list_free(list);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_chunk_list_test_compact)
+{
+   Eina_Chunk_List *list;
+   Eina_Chunk_List_Item *items[ITEMS];
+   Eina_Chunk_List_Chunk *chunk;
+   int values[ITEMS + 1];
+   unsigned int index;
+   int *data;
+   int i;
+
+   list = eina_chunk_list_new();
+   fail_if(!list);
+
+   for (i = 0; i < ITEMS; i++)
+     {
+        values[i] = i;
+        items[i] = eina_chunk_list_append(list, &values[i]);
+     }
+
+   /* keep one item out of four */
+   for (i = 0; i < ITEMS; i++)
+     if (i & 3) eina_chunk_list_remove(list, items[i]);
+
+   eina_chunk_list_compact(list);
+   for (chunk = list->first; chunk; chunk = chunk->next)
+     ck_assert_int_eq(chunk->fill, chunk->count);
+
+   /* order and handles are kept */
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     {
+        ck_assert_int_eq(*data, i);
+        ck_assert_ptr_eq(eina_chunk_list_item_data_get(items[i]), &values[i]);
+        i += 4;
+     }
+   ck_assert_int_eq(i, ((ITEMS + 3) / 4) * 4);
+
+   /* appending goes on after the compacted items */
+   values[ITEMS] = ITEMS;
+   fail_if(!eina_chunk_list_append(list, &values[ITEMS]));
+   i = 0;
+   EINA_CHUNK_LIST_FOREACH(list, chunk, index, data)
+     {
+        if (i > ITEMS) i = ITEMS;
+        ck_assert_int_eq(*data, i);
+        i += 4;
+     }
+
+   for (i = 0; i < ITEMS; i += 4)
+     eina_chunk_list_remove(list, items[i]);
+   ck_assert_int_eq(eina_chunk_list_count(list), 1);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), &values[ITEMS]);
+
+   /* nothing removed since, nothing to do */
+   eina_chunk_list_compact(list);
+   eina_chunk_list_compact(list);
+   ck_assert_int_eq(eina_chunk_list_count(list), 1);
+   ck_assert_ptr_eq(eina_chunk_list_first_get(list), &values[ITEMS]);
+
+   eina_chunk_list_free(list);
+}
+EFL_END_TEST
+
+void
+eina_test_chunk_list(TCase *tc)
+{
+   tcase_add_test(tc, eina_chunk_list_test_simple);
+   tcase_add_test(tc, eina_chunk_list_test_walk_remove);
+   tcase_add_test(tc, eina_chunk_list_test_walk_remove_others);
+   tcase_add_test(tc, eina_chunk_list_test_compact);
+}
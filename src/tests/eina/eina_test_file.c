@@ -29,6 +29,8 @@
 
 #ifdef _WIN32
 # include <evil_private.h> /* mkdir */
+#else
+# include <sys/wait.h>
 #endif
 
 #include <Eina.h>
@@ -417,6 +419,7 @@ EFL_START_TEST(eina_file_map_new_test)
    eina_file_map_populate(e_file, EINA_FILE_POPULATE, file_map, 0, file_length * 2);
    eina_file_map_populate(e_file, EINA_FILE_POPULATE, file_map, file_length / 2, big_buffer_size);
    eina_file_map_populate(e_file, EINA_FILE_POPULATE, file_map, big_buffer_size + 1, file_length);
+   eina_file_map_populate(e_file2, EINA_FILE_HUGEPAGE, file2_map, 0, map_length);
 
    eina_file_map_free(e_file, file_map);
    eina_file_map_free(e_file, file_map); // test no crash
@@ -862,6 +865,86 @@ EFL_START_TEST(eina_test_file_unlink)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_file_prefetch)
+{
+   Eina_Tmpstr *test_file_path;
+   Eina_File *e_file;
+   const char *map;
+   int fd;
+
+   fd = create_file_not_empty("eina_file_test_XXXXXX", &test_file_path, EINA_TRUE);
+   fail_if(fd != 0);
+
+   e_file = eina_file_open(test_file_path, EINA_FALSE);
+   fail_if(!e_file);
+
+   // out of range requests are clamped or dropped
+   eina_file_prefetch(e_file, 0, 0);
+   eina_file_prefetch(e_file, 4, 8);
+   eina_file_prefetch(e_file, 20, 4096);
+   eina_file_prefetch(e_file, 4096, 4096);
+
+   map = eina_file_map_all(e_file, EINA_FILE_POPULATE);
+   fail_if(!map);
+   fail_if(strncmp(map, "abcdefghijklmnopqrstuvwxyz", eina_file_size_get(e_file)));
+   eina_file_map_free(e_file, (void *)map);
+
+   // pending requests hold their own reference on the file
+   eina_file_prefetch(e_file, 0, 0);
+   eina_file_close(e_file);
+
+   unlink(test_file_path);
+   eina_tmpstr_del(test_file_path);
+}
+EFL_END_TEST
+
+#ifndef _WIN32
+EFL_START_TEST(eina_test_file_prefetch_fork)
+{
+   Eina_Tmpstr *test_file_path;
+   Eina_File *e_file;
+   pid_t pid;
+   int fd, status;
+
+   fd = create_file_not_empty("eina_file_test_XXXXXX", &test_file_path, EINA_TRUE);
+   fail_if(fd != 0);
+
+   e_file = eina_file_open(test_file_path, EINA_FALSE);
+   fail_if(!e_file);
+
+   // get the worker running in the parent
+   eina_file_prefetch(e_file, 0, 0);
+
+   pid = fork();
+   fail_if(pid < 0);
+   if (pid == 0)
+     {
+        const char *map;
+
+        // a hang on the lost worker gets the child killed
+        alarm(10);
+        eina_file_fork_reset();
+        eina_file_prefetch(e_file, 0, 0);
+        map = eina_file_map_all(e_file, EINA_FILE_POPULATE);
+        if ((!map) || strncmp(map, "abcdefghijklmnopqrstuvwxyz", eina_file_size_get(e_file)))
+          _exit(1);
+        eina_file_map_free(e_file, (void *)map);
+        eina_file_close(e_file);
+        eina_shutdown();
+        _exit(0);
+     }
+
+   fail_if(waitpid(pid, &status, 0) != pid);
+   fail_if(!WIFEXITED(status));
+   fail_if(WEXITSTATUS(status) != 0);
+
+   eina_file_close(e_file);
+   unlink(test_file_path);
+   eina_tmpstr_del(test_file_path);
+}
+EFL_END_TEST
+#endif
+
 void
 eina_test_file(TCase *tc)
 {
@@ -879,5 +962,9 @@ eina_test_file(TCase *tc)
    tcase_add_test(tc, eina_test_file_statat);
    tcase_add_test(tc, eina_test_file_mktemp);
    tcase_add_test(tc, eina_test_file_unlink);
+   tcase_add_test(tc, eina_test_file_prefetch);
+#ifndef _WIN32
+   tcase_add_test(tc, eina_test_file_prefetch_fork);
+#endif
 
 }
@@ -613,6 +613,53 @@ EFL_START_TEST(eina_test_strbuf_release_test)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_strbuf_inline_test)
+{
+   Eina_Strbuf *buf;
+   char *string;
+   char cbuf[128];
+   unsigned int i;
+
+   /* short strings live inside the buffer, check the moves in and out */
+   buf = eina_strbuf_new();
+   ck_assert_ptr_ne(buf, NULL);
+   for (i = 0; i < sizeof (cbuf) - 1; i++)
+     {
+        cbuf[i] = 'a' + (i % 26);
+        eina_strbuf_append_char(buf, cbuf[i]);
+     }
+   cbuf[i] = '\0';
+   ck_assert_str_eq(eina_strbuf_string_get(buf), cbuf);
+
+   eina_strbuf_remove(buf, 4, sizeof (cbuf) - 1);
+   ck_assert_str_eq(eina_strbuf_string_get(buf), "abcd");
+   eina_strbuf_remove(buf, 0, 4);
+   ck_assert_str_eq(eina_strbuf_string_get(buf), "");
+
+   eina_strbuf_append(buf, "short");
+   string = eina_strbuf_string_steal(buf);
+   ck_assert_str_eq(string, "short");
+   ck_assert_str_eq(eina_strbuf_string_get(buf), "");
+   eina_strbuf_append(buf, "again");
+   ck_assert_str_eq(string, "short");
+   free(string);
+
+   eina_strbuf_replace_all(buf, "a", "AAAA");
+   ck_assert_str_eq(eina_strbuf_string_get(buf), "AAAAgAAAAin");
+   eina_strbuf_string_free(buf);
+   ck_assert_int_eq(eina_strbuf_length_get(buf), 0);
+   eina_strbuf_free(buf);
+
+   /* big appends */
+   buf = eina_strbuf_new();
+   for (i = 0; i < 100000; i++)
+     eina_strbuf_append_length(buf, "0123456789", 10);
+   ck_assert_int_eq(eina_strbuf_length_get(buf), 1000000);
+   ck_assert_str_eq(eina_strbuf_string_get(buf) + 999990, "0123456789");
+   eina_strbuf_free(buf);
+}
+EFL_END_TEST
+
 EFL_START_TEST(eina_test_strbuf_strftime_test)
 {
    Eina_Strbuf *buf;
@@ -643,6 +690,33 @@ EFL_START_TEST(eina_test_strbuf_strftime_test)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_strbuf_shutdown_test)
+{
+   Eina_Strbuf *pooled, *buf;
+
+   /* buffers may outlive eina, they keep working and are freed later */
+   pooled = eina_strbuf_new();
+   eina_strbuf_append(pooled, "pooled");
+   ck_assert_int_eq(eina_shutdown(), 0);
+
+   buf = eina_strbuf_new();
+   eina_strbuf_append(buf, "after shutdown");
+   ck_assert_str_eq(eina_strbuf_string_get(buf), "after shutdown");
+   eina_strbuf_append(pooled, " and kept");
+   ck_assert_str_eq(eina_strbuf_string_get(pooled), "pooled and kept");
+   eina_strbuf_free(buf);
+
+   /* the pool is picked up again by the next init */
+   ck_assert_int_eq(eina_init(), 1);
+   buf = eina_strbuf_new();
+   eina_strbuf_free(pooled);
+   ck_assert_int_eq(eina_shutdown(), 0);
+   eina_strbuf_free(buf);
+
+   ck_assert_int_eq(eina_init(), 1);
+}
+EFL_END_TEST
+
 void
 eina_test_strbuf(TCase *tc)
 {
@@ -660,6 +734,8 @@ eina_test_strbuf(TCase *tc)
    tcase_add_test(tc, eina_test_strbuf_substr_get);
    tcase_add_test(tc, eina_test_strbuf_prepend_print);
    tcase_add_test(tc, eina_test_strbuf_release_test);
+   tcase_add_test(tc, eina_test_strbuf_inline_test);
    tcase_add_test(tc, eina_test_strbuf_strftime_test);
+   tcase_add_test(tc, eina_test_strbuf_shutdown_test);
 }
 
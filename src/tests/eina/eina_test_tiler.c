@@ -21,6 +21,8 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <Eina.h>
 
@@ -369,6 +371,126 @@ EFL_START_TEST(eina_test_tiler_size)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_tiler_strategy)
+{
+   Eina_Tiler_Stats stats;
+   Eina_Rectangle *r;
+   Eina_Iterator *it;
+   Eina_Tiler *t;
+   int count = 0;
+
+   t = eina_tiler_new(640, 480);
+   fail_if(!t);
+   eina_tiler_tile_size_set(t, 32, 32);
+   fail_if(eina_tiler_strategy_get(t) != EINA_TILER_STRATEGY_FUZZY);
+
+   eina_tiler_strategy_set(t, EINA_TILER_STRATEGY_GRID);
+   fail_if(eina_tiler_strategy_get(t) != EINA_TILER_STRATEGY_GRID);
+   fail_if(!eina_tiler_empty(t));
+
+   // Two tiles on the first row, the same two on the second one
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){10, 10, 40, 10}));
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){33, 40, 2, 2}));
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){0, 40, 2, 2}));
+   fail_if(eina_tiler_empty(t));
+
+   it = eina_tiler_iterator_new(t);
+   fail_if(!it);
+   EINA_ITERATOR_FOREACH(it, r)
+     {
+        fail_if(r->x != 0);
+        fail_if(r->y != 0);
+        fail_if(r->w != 64);
+        fail_if(r->h != 64);
+        count++;
+     }
+   eina_iterator_free(it);
+   fail_if(count != 1);
+
+   // Only the tiles completely covered are cleaned
+   eina_tiler_rect_del(t, &(Eina_Rectangle){0, 0, 40, 40});
+   fail_if(eina_tiler_empty(t));
+   eina_tiler_rect_del(t, &(Eina_Rectangle){0, 0, 64, 64});
+   fail_if(!eina_tiler_empty(t));
+
+   eina_tiler_stats_get(t, &stats);
+   fail_if(stats.added != 3);
+   fail_if(stats.deleted != 2);
+   fail_if(stats.added_area != 400 + 4 + 4);
+   fail_if(stats.iterations != 1);
+   fail_if(stats.rects != 1);
+   fail_if(stats.rects_area != 64 * 64);
+
+   eina_tiler_stats_reset(t);
+   eina_tiler_stats_get(t, &stats);
+   fail_if(stats.added || stats.rects);
+
+   eina_tiler_strategy_set(t, EINA_TILER_STRATEGY_COST);
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){0, 0, 10, 10}));
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){100, 100, 10, 10}));
+   it = eina_tiler_iterator_new(t);
+   fail_if(!it);
+   eina_iterator_free(it);
+
+   eina_tiler_free(t);
+}
+EFL_END_TEST
+
+static unsigned int
+_tiler_scattered_rects(Eina_Tiler_Strategy strategy)
+{
+   unsigned char *covered;
+   Eina_Rectangle *r;
+   Eina_Iterator *it;
+   Eina_Tiler *t;
+   unsigned int count = 0;
+   int i, x, y;
+
+   t = eina_tiler_new(1024, 1024);
+   fail_if(!t);
+   eina_tiler_tile_size_set(t, 8, 8);
+   eina_tiler_strategy_set(t, strategy);
+   for (i = 0; i < 200; i++)
+     fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){(i * 37) % 1000,
+                                                       (i * 91) % 1000,
+                                                       12, 12}));
+
+   covered = calloc(1024, 1024);
+   fail_if(!covered);
+   it = eina_tiler_iterator_new(t);
+   fail_if(!it);
+   EINA_ITERATOR_FOREACH(it, r)
+     {
+        for (y = r->y; y < r->y + r->h; y++)
+          memset(covered + y * 1024 + r->x, 1, r->w);
+        count++;
+     }
+   eina_iterator_free(it);
+
+   // Every rectangle added must still be covered by the output
+   for (i = 0; i < 200; i++)
+     for (y = (i * 91) % 1000; y < (i * 91) % 1000 + 12; y++)
+       for (x = (i * 37) % 1000; x < (i * 37) % 1000 + 12; x++)
+         fail_if(!covered[y * 1024 + x]);
+
+   free(covered);
+   eina_tiler_free(t);
+
+   return count;
+}
+
+EFL_START_TEST(eina_test_tiler_strategy_cost)
+{
+   unsigned int fuzzy, cost;
+
+   fuzzy = _tiler_scattered_rects(EINA_TILER_STRATEGY_FUZZY);
+   cost = _tiler_scattered_rects(EINA_TILER_STRATEGY_COST);
+   fail_if(!cost);
+   // Accepting more error as rectangles pile up never gives out more
+   fail_if(cost > fuzzy);
+}
+EFL_END_TEST
+
 void
 eina_test_tiler(TCase *tc)
 {
@@ -377,4 +499,6 @@ eina_test_tiler(TCase *tc)
    tcase_add_test(tc, eina_test_tiler_stable);
    tcase_add_test(tc, eina_test_tiler_calculation);
    tcase_add_test(tc, eina_test_tiler_size);
+   tcase_add_test(tc, eina_test_tiler_strategy);
+   tcase_add_test(tc, eina_test_tiler_strategy_cost);
 }
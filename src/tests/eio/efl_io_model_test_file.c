@@ -9,8 +9,16 @@
 #include <Ecore.h>
 #include <Efl.h>
 #include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+# include <evil_private.h> /* mkdir */
+#endif
 
 #include "eio_suite.h"
+#include "eio_test_common.h"
 #define EFL_MODEL_TEST_FILENAME_PATH "/tmp"
 #define EFL_MODEL_MAX_TEST_CHILDS 16
 
@@ -211,9 +219,181 @@ EFL_START_TEST(efl_io_model_test_del)
 }
 EFL_END_TEST
 
+/* More children than a single stat batch holds */
+#define STAT_BATCH_FILES 300
+
+typedef struct _Stat_Batch_Test Stat_Batch_Test;
+struct _Stat_Batch_Test
+{
+   Eina_Array *children;
+   unsigned int statted;
+   Eina_Bool sliced;
+};
+
+/* Returns EINA_FALSE while the stat of child is still pending */
+static Eina_Bool
+_stat_batch_check(Stat_Batch_Test *t, Eo *child)
+{
+   Eina_Value *filename, *size, *is_dir;
+   unsigned long sz = 0;
+   Eina_Bool dir = EINA_FALSE;
+   unsigned int i;
+   char *name;
+
+   size = efl_model_property_get(child, "size");
+   if (eina_value_type_get(size) != EINA_VALUE_TYPE_ULONG)
+     {
+        eina_value_free(size);
+        return EINA_FALSE;
+     }
+   fail_if(!eina_value_get(size, &sz));
+   eina_value_free(size);
+
+   is_dir = efl_model_property_get(child, "is_dir");
+   fail_if(eina_value_type_get(is_dir) != EINA_VALUE_TYPE_BOOL);
+   fail_if(!eina_value_get(is_dir, &dir));
+   eina_value_free(is_dir);
+
+   filename = efl_model_property_get(child, "filename");
+   name = eina_value_to_string(filename);
+   eina_value_free(filename);
+   fail_if(!name);
+
+   if (!strcmp(name, "subdir"))
+     fail_if(!dir);
+   else
+     {
+        fail_if(dir);
+        fail_if(sscanf(name, "file%u", &i) != 1);
+        ck_assert_int_eq(sz, i);
+     }
+   free(name);
+
+   if (++t->statted == STAT_BATCH_FILES + 1)
+     ecore_main_loop_quit();
+   return EINA_TRUE;
+}
+
+static void
+_stat_batch_property_changed(void *data, const Efl_Event *event)
+{
+   Stat_Batch_Test *t = data;
+
+   if (_stat_batch_check(t, event->object))
+     efl_event_callback_del(event->object, EFL_MODEL_EVENT_PROPERTIES_CHANGED,
+                            _stat_batch_property_changed, t);
+}
+
+static Eina_Value
+_stat_batch_slice(void *data, const Eina_Value v,
+                  const Eina_Future *dead_future EINA_UNUSED)
+{
+   Stat_Batch_Test *t = data;
+   Eo *child = NULL;
+   unsigned int i, len;
+
+   fail_if(eina_value_type_get(&v) != EINA_VALUE_TYPE_ARRAY);
+
+   // The slice already queued the stat of all of them
+   EINA_VALUE_ARRAY_FOREACH(&v, len, i, child)
+     {
+        eina_array_push(t->children, efl_ref(child));
+        if (!_stat_batch_check(t, child))
+          efl_event_callback_add(child, EFL_MODEL_EVENT_PROPERTIES_CHANGED,
+                                 _stat_batch_property_changed, t);
+     }
+
+   return v;
+}
+
+static void
+_stat_batch_child_added(void *data, const Efl_Event *event)
+{
+   Stat_Batch_Test *t = data;
+   Eina_Future *f;
+
+   if (t->sliced) return ;
+   if (efl_model_children_count_get(event->object) != STAT_BATCH_FILES + 1) return ;
+   t->sliced = EINA_TRUE;
+
+   f = efl_model_children_slice_get(event->object, 0, STAT_BATCH_FILES + 1);
+   eina_future_then(f, _stat_batch_slice, t, NULL);
+}
+
+static Eina_Bool
+_stat_batch_timeout(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+EFL_START_TEST(efl_io_model_test_stat_batch)
+{
+   Stat_Batch_Test t = { NULL, 0, EINA_FALSE };
+   Eina_Tmpstr *dir, *path;
+   Ecore_Timer *timer;
+   char name[32], buf[STAT_BATCH_FILES];
+   Eo *model, *child;
+   unsigned int i;
+   int fd;
+
+   dir = get_eio_test_file_tmp_dir();
+   fail_if(!dir);
+   memset(buf, 'x', sizeof(buf));
+   for (i = 0; i < STAT_BATCH_FILES; i++)
+     {
+        snprintf(name, sizeof(name), "file%03u", i);
+        path = get_full_path(dir, name);
+        fd = open(path, O_WRONLY | O_CREAT, default_rights);
+        fail_if(fd < 0);
+        fail_if(write(fd, buf, i) != (ssize_t)i);
+        close(fd);
+        eina_tmpstr_del(path);
+     }
+   path = get_full_path(dir, "subdir");
+   fail_if(mkdir(path, default_rights) != 0);
+   eina_tmpstr_del(path);
+
+   t.children = eina_array_new(STAT_BATCH_FILES + 1);
+   model = efl_add(EFL_IO_MODEL_CLASS, efl_main_loop_get(),
+                   efl_io_model_path_set(efl_added, dir));
+   fail_if(!model);
+   efl_event_callback_add(model, EFL_MODEL_EVENT_CHILD_ADDED,
+                          _stat_batch_child_added, &t);
+   efl_model_children_count_get(model);
+
+   timer = ecore_timer_add(10.0, _stat_batch_timeout, NULL);
+   ecore_main_loop_begin();
+   ecore_timer_del(timer);
+
+   // Every child got its stat from the batches, with the right values
+   ck_assert_int_eq(eina_array_count(t.children), STAT_BATCH_FILES + 1);
+   ck_assert_int_eq(t.statted, STAT_BATCH_FILES + 1);
+
+   while ((child = eina_array_pop(t.children)))
+     efl_unref(child);
+   eina_array_free(t.children);
+   efl_del(model);
+
+   for (i = 0; i < STAT_BATCH_FILES; i++)
+     {
+        snprintf(name, sizeof(name), "file%03u", i);
+        path = get_full_path(dir, name);
+        unlink(path);
+        eina_tmpstr_del(path);
+     }
+   path = get_full_path(dir, "subdir");
+   rmdir(path);
+   eina_tmpstr_del(path);
+   rmdir(dir);
+   eina_tmpstr_del(dir);
+}
+EFL_END_TEST
+
 void
 efl_io_model_test_file(TCase *tc)
 {
     tcase_add_test(tc, efl_io_model_test_test_file);
     tcase_add_test(tc, efl_io_model_test_del);
+    tcase_add_test(tc, efl_io_model_test_stat_batch);
 }
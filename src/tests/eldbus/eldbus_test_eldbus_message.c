@@ -1590,6 +1590,495 @@ EFL_START_TEST(utc_eldbus_hello_p)
 }
 EFL_END_TEST
 
+#define FIXED_ARRAY_COUNT 4096
+
+typedef struct _Fixed_Arrays
+{
+   Eina_Value_Array bytes;
+   Eina_Value_Array doubles;
+   Eina_Value_Array booleans;
+} Fixed_Arrays;
+
+static Eina_Bool is_fixed_array_ok = EINA_FALSE;
+
+static void
+_fixed_array_signal_cb(void *data EINA_UNUSED, const Eldbus_Message *msg)
+{
+   Eina_Value *value;
+   Eina_Value bytes, doubles, booleans;
+   unsigned int i;
+
+   if (timeout != NULL)
+     {
+        ecore_timer_del(timeout);
+        timeout = NULL;
+     }
+   ecore_main_loop_quit();
+
+   ck_assert_str_eq(eldbus_message_signature_get(msg), "ayadab");
+   value = eldbus_message_to_eina_value(msg);
+   ck_assert_ptr_ne(NULL, value);
+
+   ck_assert(eina_value_struct_value_get(value, "arg0", &bytes));
+   ck_assert(eina_value_struct_value_get(value, "arg1", &doubles));
+   ck_assert(eina_value_struct_value_get(value, "arg2", &booleans));
+   ck_assert_int_eq(eina_value_array_count(&bytes), FIXED_ARRAY_COUNT);
+   ck_assert_int_eq(eina_value_array_count(&doubles), FIXED_ARRAY_COUNT);
+   ck_assert_int_eq(eina_value_array_count(&booleans), 0);
+
+   for (i = 0; i < FIXED_ARRAY_COUNT; i++)
+     {
+        unsigned char b;
+        double d;
+
+        eina_value_array_get(&bytes, i, &b);
+        eina_value_array_get(&doubles, i, &d);
+        ck_assert_int_eq(b, i & 0xff);
+        ck_assert(EINA_DBL_EQ(d, i * 0.5));
+     }
+
+   eina_value_flush(&bytes);
+   eina_value_flush(&doubles);
+   eina_value_flush(&booleans);
+   eina_value_free(value);
+   is_fixed_array_ok = EINA_TRUE;
+}
+
+/**
+ * @addtogroup eldbus_message
+ * @{
+ * @defgroup eldbus_message_fixed_array_eina_value
+ * @li eldbus_message_from_eina_value()
+ * @li eldbus_message_to_eina_value()
+ * @{
+ * @objective Positive test case checks that large byte and double arrays, which
+ * go through the fixed array path, and an empty boolean array survive a round
+ * trip through the bus.
+ *
+ * @procedure
+ * @step 1 Listen to a signal on the session bus connection.
+ * @step 2 Emit that signal with three arrays converted from an Eina_Value.
+ * @step 3 Convert the received message back to an Eina_Value and compare.
+ *
+ * @passcondition The received arrays hold the sent values.
+ * @}
+ * @}
+ */
+EFL_START_TEST(utc_eldbus_message_fixed_array_eina_value_p)
+{
+   Eina_Value_Struct_Member members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Fixed_Arrays, bytes),
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Fixed_Arrays, doubles),
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Fixed_Arrays, booleans)
+   };
+   Eina_Value_Struct_Desc desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      members,
+      EINA_C_ARRAY_LENGTH(members),
+      sizeof(Fixed_Arrays)
+   };
+   Eina_Value *value;
+   Eina_Value bytes, doubles, booleans;
+   Eldbus_Connection *conn;
+   Eldbus_Signal_Handler *handler;
+   Eldbus_Message *msg;
+   unsigned int i;
+
+   is_fixed_array_ok = EINA_FALSE;
+
+   conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
+   ck_assert_ptr_ne(NULL, conn);
+
+   handler = eldbus_signal_handler_add(conn, NULL, dbus_session_path, interface_session,
+                                       "FixedArrays", _fixed_array_signal_cb, NULL);
+   ck_assert_ptr_ne(NULL, handler);
+
+   ck_assert(eina_value_array_setup(&bytes, EINA_VALUE_TYPE_UCHAR, 0));
+   ck_assert(eina_value_array_setup(&doubles, EINA_VALUE_TYPE_DOUBLE, 0));
+   ck_assert(eina_value_array_setup(&booleans, EINA_VALUE_TYPE_UCHAR, 0));
+   for (i = 0; i < FIXED_ARRAY_COUNT; i++)
+     {
+        eina_value_array_append(&bytes, (unsigned char)(i & 0xff));
+        eina_value_array_append(&doubles, i * 0.5);
+     }
+
+   value = eina_value_struct_new(&desc);
+   ck_assert_ptr_ne(NULL, value);
+   ck_assert(eina_value_struct_value_set(value, "bytes", &bytes));
+   ck_assert(eina_value_struct_value_set(value, "doubles", &doubles));
+   ck_assert(eina_value_struct_value_set(value, "booleans", &booleans));
+
+   msg = eldbus_message_signal_new(dbus_session_path, interface_session, "FixedArrays");
+   ck_assert_ptr_ne(NULL, msg);
+   ck_assert(eldbus_message_from_eina_value("ayadab", msg, value));
+   ck_assert_ptr_ne(NULL, eldbus_connection_send(conn, msg, NULL, NULL, -1));
+
+   timeout = ecore_timer_add(1.0, _ecore_loop_close, NULL);
+   ck_assert_ptr_ne(NULL, timeout);
+
+   ecore_main_loop_begin();
+
+   ck_assert_msg(is_fixed_array_ok, "Fixed arrays were not received");
+
+   eina_value_flush(&bytes);
+   eina_value_flush(&doubles);
+   eina_value_flush(&booleans);
+   eina_value_free(value);
+   eldbus_signal_handler_del(handler);
+   eldbus_connection_unref(conn);
+}
+EFL_END_TEST
+
+#define CONTAINER_ARRAY_COUNT 64
+
+typedef struct _Array_Entry
+{
+   const char *name;
+   int number;
+} Array_Entry;
+
+typedef struct _Container_Arrays
+{
+   Eina_Value_Array structs;
+   Eina_Value_Array dict;
+} Container_Arrays;
+
+typedef struct _Boolean_Arrays
+{
+   Eina_Value_Array booleans;
+   Eina_Value_Array bytes;
+} Boolean_Arrays;
+
+static Eina_Bool is_container_array_ok = EINA_FALSE;
+static Eina_Bool is_boolean_array_ok = EINA_FALSE;
+
+static void
+_container_array_check(const Eina_Value *array)
+{
+   unsigned int i;
+
+   ck_assert_int_eq(eina_value_array_count(array), CONTAINER_ARRAY_COUNT);
+   for (i = 0; i < CONTAINER_ARRAY_COUNT; i++)
+     {
+        Eina_Value st;
+        const char *name;
+        char buf[16];
+        int number;
+
+        ck_assert(eina_value_array_value_get(array, i, &st));
+        ck_assert(eina_value_struct_get(&st, "arg0", &name));
+        ck_assert(eina_value_struct_get(&st, "arg1", &number));
+        snprintf(buf, sizeof(buf), "entry%u", i);
+        ck_assert_str_eq(name, buf);
+        ck_assert_int_eq(number, (int)i * 3 - 7);
+        eina_value_flush(&st);
+     }
+}
+
+static void
+_container_array_signal_cb(void *data EINA_UNUSED, const Eldbus_Message *msg)
+{
+   Eina_Value *value;
+   Eina_Value structs, dict;
+
+   if (timeout != NULL)
+     {
+        ecore_timer_del(timeout);
+        timeout = NULL;
+     }
+   ecore_main_loop_quit();
+
+   ck_assert_str_eq(eldbus_message_signature_get(msg), "a(si)a{si}");
+   value = eldbus_message_to_eina_value(msg);
+   ck_assert_ptr_ne(NULL, value);
+
+   ck_assert(eina_value_struct_value_get(value, "arg0", &structs));
+   ck_assert(eina_value_struct_value_get(value, "arg1", &dict));
+   _container_array_check(&structs);
+   _container_array_check(&dict);
+
+   eina_value_flush(&structs);
+   eina_value_flush(&dict);
+   eina_value_free(value);
+   is_container_array_ok = EINA_TRUE;
+}
+
+/**
+ * @addtogroup eldbus_message
+ * @{
+ * @defgroup eldbus_message_container_array_eina_value
+ * @li eldbus_message_from_eina_value()
+ * @li eldbus_message_to_eina_value()
+ * @{
+ * @objective Positive test case checks that an array of structs and an array
+ * of dict entries, whose entry signature is split once per array, survive a
+ * round trip through the bus.
+ *
+ * @procedure
+ * @step 1 Listen to a signal on the session bus connection.
+ * @step 2 Emit that signal with both arrays converted from an Eina_Value.
+ * @step 3 Convert the received message back to an Eina_Value and compare.
+ *
+ * @passcondition Every received entry holds the sent string and number.
+ * @}
+ * @}
+ */
+EFL_START_TEST(utc_eldbus_message_container_array_eina_value_p)
+{
+   Eina_Value_Struct_Member entry_members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_STRING, Array_Entry, name),
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_INT, Array_Entry, number)
+   };
+   Eina_Value_Struct_Desc entry_desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      entry_members,
+      EINA_C_ARRAY_LENGTH(entry_members),
+      sizeof(Array_Entry)
+   };
+   Eina_Value_Struct_Member members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Container_Arrays, structs),
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Container_Arrays, dict)
+   };
+   Eina_Value_Struct_Desc desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      members,
+      EINA_C_ARRAY_LENGTH(members),
+      sizeof(Container_Arrays)
+   };
+   Eina_Value *value;
+   Eina_Value structs, dict;
+   Eldbus_Connection *conn;
+   Eldbus_Signal_Handler *handler;
+   Eldbus_Message *msg;
+   unsigned int i;
+
+   is_container_array_ok = EINA_FALSE;
+
+   conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
+   ck_assert_ptr_ne(NULL, conn);
+
+   handler = eldbus_signal_handler_add(conn, NULL, dbus_session_path, interface_session,
+                                       "ContainerArrays", _container_array_signal_cb, NULL);
+   ck_assert_ptr_ne(NULL, handler);
+
+   ck_assert(eina_value_array_setup(&structs, EINA_VALUE_TYPE_STRUCT, 0));
+   ck_assert(eina_value_array_setup(&dict, EINA_VALUE_TYPE_STRUCT, 0));
+   for (i = 0; i < CONTAINER_ARRAY_COUNT; i++)
+     {
+        Eina_Value entry;
+        Eina_Value_Struct st;
+        char buf[16];
+
+        snprintf(buf, sizeof(buf), "entry%u", i);
+        ck_assert(eina_value_struct_setup(&entry, &entry_desc));
+        ck_assert(eina_value_struct_set(&entry, "name", buf));
+        ck_assert(eina_value_struct_set(&entry, "number", (int)i * 3 - 7));
+        ck_assert(eina_value_pget(&entry, &st));
+        ck_assert(eina_value_array_append(&structs, st));
+        ck_assert(eina_value_array_append(&dict, st));
+        eina_value_flush(&entry);
+     }
+
+   value = eina_value_struct_new(&desc);
+   ck_assert_ptr_ne(NULL, value);
+   ck_assert(eina_value_struct_value_set(value, "structs", &structs));
+   ck_assert(eina_value_struct_value_set(value, "dict", &dict));
+
+   msg = eldbus_message_signal_new(dbus_session_path, interface_session, "ContainerArrays");
+   ck_assert_ptr_ne(NULL, msg);
+   ck_assert(eldbus_message_from_eina_value("a(si)a{si}", msg, value));
+   ck_assert_ptr_ne(NULL, eldbus_connection_send(conn, msg, NULL, NULL, -1));
+
+   timeout = ecore_timer_add(1.0, _ecore_loop_close, NULL);
+   ck_assert_ptr_ne(NULL, timeout);
+
+   ecore_main_loop_begin();
+
+   ck_assert_msg(is_container_array_ok, "Container arrays were not received");
+
+   eina_value_flush(&structs);
+   eina_value_flush(&dict);
+   eina_value_free(value);
+   eldbus_signal_handler_del(handler);
+   eldbus_connection_unref(conn);
+}
+EFL_END_TEST
+
+static void
+_boolean_array_signal_cb(void *data EINA_UNUSED, const Eldbus_Message *msg)
+{
+   Eina_Value *value;
+   Eina_Value booleans, bytes;
+   unsigned int i;
+
+   if (timeout != NULL)
+     {
+        ecore_timer_del(timeout);
+        timeout = NULL;
+     }
+   ecore_main_loop_quit();
+
+   ck_assert_str_eq(eldbus_message_signature_get(msg), "abay");
+   value = eldbus_message_to_eina_value(msg);
+   ck_assert_ptr_ne(NULL, value);
+
+   ck_assert(eina_value_struct_value_get(value, "arg0", &booleans));
+   ck_assert(eina_value_struct_value_get(value, "arg1", &bytes));
+   ck_assert_int_eq(eina_value_array_count(&booleans), CONTAINER_ARRAY_COUNT);
+   ck_assert_int_eq(eina_value_array_count(&bytes), CONTAINER_ARRAY_COUNT);
+
+   for (i = 0; i < CONTAINER_ARRAY_COUNT; i++)
+     {
+        unsigned char b, y;
+
+        eina_value_array_get(&booleans, i, &b);
+        eina_value_array_get(&bytes, i, &y);
+        ck_assert_int_eq(b, (i % 3) == 0);
+        ck_assert_int_eq(y, 0xff - i);
+     }
+
+   eina_value_flush(&booleans);
+   eina_value_flush(&bytes);
+   eina_value_free(value);
+   is_boolean_array_ok = EINA_TRUE;
+}
+
+/**
+ * @addtogroup eldbus_message
+ * @{
+ * @defgroup eldbus_message_boolean_array_eina_value
+ * @li eldbus_message_from_eina_value()
+ * @li eldbus_message_to_eina_value()
+ * @{
+ * @objective Positive test case checks that a non empty boolean array, stored
+ * in bytes but sent as 32 bits values, survives a round trip through the bus
+ * next to a byte array taking the fixed array path.
+ *
+ * @procedure
+ * @step 1 Listen to a signal on the session bus connection.
+ * @step 2 Emit that signal with both arrays converted from an Eina_Value.
+ * @step 3 Convert the received message back to an Eina_Value and compare.
+ *
+ * @passcondition The received arrays hold the sent values.
+ * @}
+ * @}
+ */
+EFL_START_TEST(utc_eldbus_message_boolean_array_eina_value_p)
+{
+   Eina_Value_Struct_Member members[] = {
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Boolean_Arrays, booleans),
+      EINA_VALUE_STRUCT_MEMBER(EINA_VALUE_TYPE_ARRAY, Boolean_Arrays, bytes)
+   };
+   Eina_Value_Struct_Desc desc = {
+      EINA_VALUE_STRUCT_DESC_VERSION,
+      NULL,
+      members,
+      EINA_C_ARRAY_LENGTH(members),
+      sizeof(Boolean_Arrays)
+   };
+   Eina_Value *value;
+   Eina_Value booleans, bytes;
+   Eldbus_Connection *conn;
+   Eldbus_Signal_Handler *handler;
+   Eldbus_Message *msg;
+   unsigned int i;
+
+   is_boolean_array_ok = EINA_FALSE;
+
+   conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
+   ck_assert_ptr_ne(NULL, conn);
+
+   handler = eldbus_signal_handler_add(conn, NULL, dbus_session_path, interface_session,
+                                       "BooleanArrays", _boolean_array_signal_cb, NULL);
+   ck_assert_ptr_ne(NULL, handler);
+
+   ck_assert(eina_value_array_setup(&booleans, EINA_VALUE_TYPE_UCHAR, 0));
+   ck_assert(eina_value_array_setup(&bytes, EINA_VALUE_TYPE_UCHAR, 0));
+   for (i = 0; i < CONTAINER_ARRAY_COUNT; i++)
+     {
+        eina_value_array_append(&booleans, (unsigned char)((i % 3) == 0));
+        eina_value_array_append(&bytes, (unsigned char)(0xff - i));
+     }
+
+   value = eina_value_struct_new(&desc);
+   ck_assert_ptr_ne(NULL, value);
+   ck_assert(eina_value_struct_value_set(value, "booleans", &booleans));
+   ck_assert(eina_value_struct_value_set(value, "bytes", &bytes));
+
+   msg = eldbus_message_signal_new(dbus_session_path, interface_session, "BooleanArrays");
+   ck_assert_ptr_ne(NULL, msg);
+   ck_assert(eldbus_message_from_eina_value("abay", msg, value));
+   ck_assert_ptr_ne(NULL, eldbus_connection_send(conn, msg, NULL, NULL, -1));
+
+   timeout = ecore_timer_add(1.0, _ecore_loop_close, NULL);
+   ck_assert_ptr_ne(NULL, timeout);
+
+   ecore_main_loop_begin();
+
+   ck_assert_msg(is_boolean_array_ok, "Boolean arrays were not received");
+
+   eina_value_flush(&booleans);
+   eina_value_flush(&bytes);
+   eina_value_free(value);
+   eldbus_signal_handler_del(handler);
+   eldbus_connection_unref(conn);
+}
+EFL_END_TEST
+
+/**
+ * @addtogroup eldbus_message
+ * @{
+ * @defgroup eldbus_message_unref_after_shutdown
+ * @li eldbus_message_unref()
+ * @li eldbus_shutdown()
+ * @{
+ * @objective Positive test case checks that messages created before
+ * eldbus_shutdown() can still be used and freed after it, and that eldbus
+ * can be initialized again meanwhile.
+ *
+ * @procedure
+ * @step 1 Create a message, shut eldbus down and initialize it again.
+ * @step 2 Create another message and shut eldbus down.
+ * @step 3 Use and free both messages.
+ * @step 4 Initialize eldbus again and create and free a message.
+ *
+ * @passcondition The messages are usable and freed without crash.
+ * @}
+ * @}
+ */
+EFL_START_TEST(utc_eldbus_message_unref_after_shutdown_p)
+{
+   Eldbus_Message *msg, *msg2;
+
+   /* keep eina up for the messages outliving eldbus */
+   ck_assert_int_ge(eina_init(), 1);
+
+   msg = eldbus_message_method_call_new(bus, path, interface, method_name);
+   ck_assert_ptr_ne(NULL, msg);
+   ck_assert_int_eq(eldbus_shutdown(), 0);
+   ck_assert_int_eq(eldbus_init(), 1);
+
+   msg2 = eldbus_message_method_call_new(bus, path, interface, method_name);
+   ck_assert_ptr_ne(NULL, msg2);
+   ck_assert_int_eq(eldbus_shutdown(), 0);
+
+   ck_assert_str_eq(eldbus_message_path_get(msg), path);
+   eldbus_message_unref(msg);
+   ck_assert_str_eq(eldbus_message_path_get(msg2), path);
+   eldbus_message_unref(msg2);
+
+   ck_assert_int_eq(eldbus_init(), 1);
+   msg = eldbus_message_method_call_new(bus, path, interface, method_name);
+   ck_assert_ptr_ne(NULL, msg);
+   eldbus_message_unref(msg);
+
+   eina_shutdown();
+}
+EFL_END_TEST
+
 void eldbus_test_eldbus_message(TCase *tc)
 {
    tcase_add_test(tc, utc_eldbus_message_iterator_activatable_list_p);
@@ -1605,5 +2094,9 @@ void eldbus_test_eldbus_message(TCase *tc)
    tcase_add_test(tc, utc_eldbus_message_error_new_p);
    tcase_add_test(tc, utc_eldbus_message_iter_del_p);
    tcase_add_test(tc, utc_eldbus_message_iter_fixed_array_get_p);
+   tcase_add_test(tc, utc_eldbus_message_fixed_array_eina_value_p);
+   tcase_add_test(tc, utc_eldbus_message_container_array_eina_value_p);
+   tcase_add_test(tc, utc_eldbus_message_boolean_array_eina_value_p);
+   tcase_add_test(tc, utc_eldbus_message_unref_after_shutdown_p);
    tcase_add_test(tc, utc_eldbus_hello_p);
 }
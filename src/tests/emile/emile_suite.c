@@ -9,6 +9,7 @@
 static const Efl_Test_Case etc[] = {
   { "Emile_Base", emile_test_base },
   { "Emile_Base64", emile_test_base64 },
+  { "Emile_Compress", emile_test_compress },
   { NULL, NULL }
 };
 
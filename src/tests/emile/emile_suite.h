@@ -5,5 +5,6 @@
 #include "../efl_check.h"
 void emile_test_base(TCase *tc);
 void emile_test_base64(TCase *tc);
+void emile_test_compress(TCase *tc);
 
 #endif /* _EMILE_SUITE_H */
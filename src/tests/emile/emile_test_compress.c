@@ -0,0 +1,147 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <Eina.h>
+#include <Emile.h>
+
+#include "emile_suite.h"
+
+#define SAMPLES 1000
+
+static Eina_Binbuf *
+_sample_new(int i)
+{
+   Eina_Binbuf *buf;
+   char tmp[256];
+   int len;
+
+   /* small and alike, like most of what ends up in an eet file */
+   len = snprintf(tmp, sizeof(tmp),
+                  "{ \"name\": \"item%i\", \"color\": [%i, %i, %i, 255], "
+                  "\"visible\": %s, \"geometry\": { \"x\": %i, \"y\": %i, "
+                  "\"w\": 64, \"h\": 64 } }",
+                  i, (i * 7) & 0xff, (i * 13) & 0xff, (i * 31) & 0xff,
+                  (i & 1) ? "true" : "false", i * 3, i * 5);
+   buf = eina_binbuf_new();
+   eina_binbuf_append_length(buf, (unsigned char *)tmp, len);
+   return buf;
+}
+
+static void
+_roundtrip(Emile_Compressor_Type t, const Eina_Binbuf *in)
+{
+   Eina_Binbuf *compressed, *expanded;
+
+   compressed = emile_compress(in, t, EMILE_COMPRESSOR_BEST);
+   fail_if(!compressed);
+
+   expanded = emile_decompress(compressed, t, eina_binbuf_length_get(in));
+   fail_if(!expanded);
+   fail_if(eina_binbuf_length_get(expanded) != eina_binbuf_length_get(in));
+   fail_if(memcmp(eina_binbuf_string_get(expanded),
+                  eina_binbuf_string_get(in),
+                  eina_binbuf_length_get(in)));
+
+   eina_binbuf_free(expanded);
+   eina_binbuf_free(compressed);
+}
+
+EFL_START_TEST(emile_test_compress_roundtrip)
+{
+   Eina_Binbuf *in;
+   int i;
+
+   in = eina_binbuf_new();
+   for (i = 0; i < 64; i++)
+     {
+        Eina_Binbuf *sample = _sample_new(i);
+
+        eina_binbuf_append_buffer(in, sample);
+        eina_binbuf_free(sample);
+     }
+
+   _roundtrip(EMILE_ZLIB, in);
+   _roundtrip(EMILE_LZ4, in);
+   _roundtrip(EMILE_LZ4HC, in);
+#ifdef HAVE_ZSTD
+   _roundtrip(EMILE_ZSTD, in);
+#else
+   fail_if(emile_compress(in, EMILE_ZSTD, EMILE_COMPRESSOR_BEST));
+#endif
+
+   eina_binbuf_free(in);
+}
+EFL_END_TEST
+
+#ifdef HAVE_ZSTD
+EFL_START_TEST(emile_test_compress_dict)
+{
+   Emile_Compress_Dict *dict;
+   Eina_Binbuf *content, *sample, *plain, *with, *out;
+   Eina_Array *samples;
+   int i;
+
+   samples = eina_array_new(64);
+   for (i = 0; i < SAMPLES; i++)
+     eina_array_push(samples, _sample_new(i));
+
+   content = emile_compress_dict_train(EMILE_ZSTD, samples, 4096);
+   fail_if(!content);
+   fail_if(eina_binbuf_length_get(content) > 4096);
+   fail_if(emile_compress_dict_train(EMILE_ZLIB, samples, 4096));
+
+   dict = emile_compress_dict_new(EMILE_ZSTD, content);
+   fail_if(!dict);
+   fail_if(eina_binbuf_length_get(emile_compress_dict_data_get(dict)) !=
+           eina_binbuf_length_get(content));
+   /* only trained dictionaries can be told apart from no dictionary */
+   fail_if(emile_compress_dict_new(EMILE_ZSTD, eina_array_data_get(samples, 0)));
+
+   sample = _sample_new(SAMPLES + 1);
+   plain = emile_compress(sample, EMILE_ZSTD, EMILE_COMPRESSOR_BEST);
+   with = emile_compress_dict(sample, EMILE_ZSTD, EMILE_COMPRESSOR_BEST, dict);
+   fail_if(!plain || !with);
+   fail_if(eina_binbuf_length_get(with) >= eina_binbuf_length_get(plain));
+   fail_if(emile_compress_dict(sample, EMILE_LZ4, EMILE_COMPRESSOR_BEST, dict));
+
+   out = emile_decompress_dict(with, EMILE_ZSTD,
+                               eina_binbuf_length_get(sample), dict);
+   fail_if(!out);
+   fail_if(memcmp(eina_binbuf_string_get(out), eina_binbuf_string_get(sample),
+                  eina_binbuf_length_get(sample)));
+   eina_binbuf_free(out);
+
+   /* needs the dictionary back */
+   fail_if(emile_decompress(with, EMILE_ZSTD, eina_binbuf_length_get(sample)));
+
+   /* buffers compressed without it still expand when given one */
+   out = emile_decompress_dict(plain, EMILE_ZSTD,
+                               eina_binbuf_length_get(sample), dict);
+   fail_if(!out);
+   fail_if(memcmp(eina_binbuf_string_get(out), eina_binbuf_string_get(sample),
+                  eina_binbuf_length_get(sample)));
+   eina_binbuf_free(out);
+
+   eina_binbuf_free(with);
+   eina_binbuf_free(plain);
+   eina_binbuf_free(sample);
+   emile_compress_dict_free(dict);
+   eina_binbuf_free(content);
+   while (eina_array_count(samples))
+     eina_binbuf_free(eina_array_pop(samples));
+   eina_array_free(samples);
+}
+EFL_END_TEST
+#endif
+
+void
+emile_test_compress(TCase *tc)
+{
+   tcase_add_test(tc, emile_test_compress_roundtrip);
+#ifdef HAVE_ZSTD
+   tcase_add_test(tc, emile_test_compress_dict);
+#endif
+}
@@ -0,0 +1,43 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "emotion_suite.h"
+#include "../efl_check.h"
+#include <Ecore_Evas.h>
+#include <Emotion.h>
+
+static const Efl_Test_Case etc[] = {
+  { "Emotion_Gstreamer1", emotion_test_gstreamer1 },
+  { NULL, NULL }
+};
+
+SUITE_INIT(emotion)
+{
+   ck_assert_int_eq(ecore_evas_init(), 1);
+   ck_assert(emotion_init());
+}
+
+SUITE_SHUTDOWN(emotion)
+{
+   emotion_shutdown();
+   ck_assert_int_eq(ecore_evas_shutdown(), 0);
+}
+
+int
+main(int argc, char *argv[])
+{
+   int failed_count;
+
+   if (!_efl_test_option_disp(argc, argv, etc))
+     return 0;
+
+#ifdef NEED_RUN_IN_TREE
+   putenv("EFL_RUN_IN_TREE=1");
+#endif
+
+   failed_count = _efl_suite_build_and_run(argc - 1, (const char **)argv + 1,
+                                           "Emotion", etc, SUITE_INIT_FN(emotion), SUITE_SHUTDOWN_FN(emotion));
+
+   return (failed_count == 0) ? 0 : 255;
+}
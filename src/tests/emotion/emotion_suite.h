@@ -0,0 +1,8 @@
+#ifndef _EMOTION_SUITE_H
+#define _EMOTION_SUITE_H
+
+#include <check.h>
+#include "../efl_check.h"
+void emotion_test_gstreamer1(TCase *tc);
+
+#endif /* _EMOTION_SUITE_H */
@@ -0,0 +1,99 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gst/gst.h>
+
+#include <Ecore.h>
+#include <Ecore_Evas.h>
+#include <Emotion.h>
+
+#include "emotion_suite.h"
+
+#define W 64
+#define H 48
+
+static void
+_frame_decode_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Eina_Bool *decoded = data;
+
+   *decoded = EINA_TRUE;
+   ecore_main_loop_quit();
+}
+
+static Eina_Bool
+_timeout_cb(void *data EINA_UNUSED)
+{
+   ck_abort_msg("timeout waiting for a frame");
+   return ECORE_CALLBACK_CANCEL;
+}
+
+EFL_START_TEST(emotion_test_gstreamer1_sink_rgb)
+{
+   GstElement *pipeline, *sink;
+   GError *error = NULL;
+   Ecore_Timer *timer;
+   Ecore_Evas *ee;
+   Evas_Object *o, *img;
+   Eina_Bool decoded = EINA_FALSE;
+   unsigned int *pixels;
+   int w, h, i;
+
+   ee = ecore_evas_buffer_new(W, H);
+   ck_assert(ee != NULL);
+   // only render when the test asks for it
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+
+   o = emotion_object_add(ecore_evas_get(ee));
+   ck_assert(o != NULL);
+   ck_assert(emotion_object_init(o, "gstreamer1"));
+   evas_object_resize(o, W, H);
+   evas_object_show(o);
+   evas_object_smart_callback_add(o, "frame_decode", _frame_decode_cb, &decoded);
+
+   // The module registered emotion-sink when it was initialized
+   pipeline = gst_parse_launch("videotestsrc num-buffers=1 pattern=red ! "
+                               "video/x-raw,format=BGRx,width=64,height=48 ! "
+                               "emotion-sink name=sink", &error);
+   ck_assert_msg(pipeline != NULL, "%s", error ? error->message : "");
+   sink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
+   ck_assert(sink != NULL);
+   g_object_set(G_OBJECT(sink), "emotion-object", o, NULL);
+
+   gst_element_set_state(pipeline, GST_STATE_PLAYING);
+   timer = ecore_timer_add(10.0, _timeout_cb, NULL);
+   ecore_main_loop_begin();
+   ecore_timer_del(timer);
+   ck_assert(decoded);
+
+   img = emotion_object_image_get(o);
+   evas_object_image_size_get(img, &w, &h);
+   ck_assert_int_eq(w, W);
+   ck_assert_int_eq(h, H);
+
+   // RGB frames are only converted when evas draws them, the image data
+   // is not initialized until then so only its dirty state can be checked
+   ck_assert(evas_object_image_pixels_dirty_get(img));
+
+   ecore_evas_manual_render(ee);
+   ck_assert(!evas_object_image_pixels_dirty_get(img));
+
+   pixels = evas_object_image_data_get(img, EINA_FALSE);
+   ck_assert(pixels != NULL);
+   for (i = 0; i < W * H; i++)
+     ck_assert_int_eq(pixels[i] & 0xffffff, 0xff0000);
+
+   gst_element_set_state(pipeline, GST_STATE_NULL);
+   gst_object_unref(sink);
+   gst_object_unref(pipeline);
+
+   evas_object_del(o);
+   ecore_evas_free(ee);
+}
+EFL_END_TEST
+
+void emotion_test_gstreamer1(TCase *tc)
+{
+   tcase_add_test(tc, emotion_test_gstreamer1_sink_rgb);
+}
@@ -3,6 +3,7 @@
 #endif
 
 #include <stdio.h>
+#include <errno.h>
 
 #include <Eo.h>
 
@@ -220,12 +221,184 @@ EFL_START_TEST(eo_event_fowarder_test)
 }
 EFL_END_TEST
 
+EFL_SCHEDULER_ARRAY_DEFINE(_test_scheduler_array,
+                           EFL_TEST_EVENT_EVENT_TESTER);
+
+typedef struct {
+   Eo *obj;
+   Eina_Future *other;
+   int success;
+   int cancelled;
+   Eina_Bool del;
+} Future_Data;
+
+static void
+_log_errors_cb(const Eina_Log_Domain *d EINA_UNUSED, Eina_Log_Level level,
+               const char *file EINA_UNUSED, const char *fnc EINA_UNUSED,
+               int line EINA_UNUSED, const char *fmt EINA_UNUSED, void *data,
+               va_list args EINA_UNUSED)
+{
+   int *errors = data;
+
+   if (level <= EINA_LOG_LEVEL_ERR) (*errors)++;
+}
+
+static Eina_Value
+_future_cancelled_cb(void *data, const Eina_Value v,
+                     const Eina_Future *dead EINA_UNUSED)
+{
+   Future_Data *d = data;
+   Eina_Error err = 0;
+
+   if (v.type == EINA_VALUE_TYPE_ERROR)
+     {
+        eina_value_error_get(&v, &err);
+        if (err == ECANCELED) d->cancelled++;
+     }
+   else d->success++;
+   return v;
+}
+
+static Eina_Value
+_future_cancel_other_cb(void *data, const Eina_Value v,
+                        const Eina_Future *dead EINA_UNUSED)
+{
+   Future_Data *d = data;
+
+   d->success++;
+   if (d->del) efl_unref(d->obj);
+   else eina_future_cancel(d->other);
+   return v;
+}
+
+EFL_START_TEST(eo_event_future_scheduler_cancel)
+{
+   Eina_Future_Scheduler *sched;
+   Future_Data data = { 0 };
+   Eina_Future *f;
+   int errors = 0;
+   Eo *obj;
+
+   eina_log_print_cb_set(_log_errors_cb, &errors);
+
+   obj = efl_add_ref(efl_test_event_class_get(), NULL);
+   sched = efl_event_future_scheduler_get(obj, _test_scheduler_array());
+   fail_if(!sched);
+
+   // resolved, but not dispatched yet
+   f = eina_future_then(eina_future_resolved(sched, eina_value_int_init(42)),
+                        _future_cancelled_cb, &data, NULL);
+   eina_future_cancel(f);
+   ck_assert_int_eq(data.cancelled, 1);
+
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_int_eq(data.success, 0);
+   ck_assert_int_eq(data.cancelled, 1);
+
+   efl_unref(obj);
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   ck_assert_int_eq(errors, 0);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eo_event_future_scheduler_cancel_in_dispatch)
+{
+   Eina_Future_Scheduler *sched;
+   Future_Data first = { 0 }, second = { 0 };
+   int errors = 0;
+   Eo *obj;
+
+   eina_log_print_cb_set(_log_errors_cb, &errors);
+
+   obj = efl_add_ref(efl_test_event_class_get(), NULL);
+   sched = efl_event_future_scheduler_get(obj, _test_scheduler_array());
+
+   // the first future of the batch cancels the second one
+   eina_future_then(eina_future_resolved(sched, eina_value_int_init(1)),
+                    _future_cancel_other_cb, &first, NULL);
+   first.other = eina_future_then(eina_future_resolved(sched, eina_value_int_init(2)),
+                                  _future_cancelled_cb, &second, NULL);
+
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_int_eq(first.success, 1);
+   ck_assert_int_eq(second.success, 0);
+   ck_assert_int_eq(second.cancelled, 1);
+
+   // the scheduler is still usable afterward
+   eina_future_then(eina_future_resolved(sched, eina_value_int_init(3)),
+                    _future_cancelled_cb, &second, NULL);
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_int_eq(second.success, 1);
+
+   efl_unref(obj);
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   ck_assert_int_eq(errors, 0);
+}
+EFL_END_TEST
+
+static Eina_Value
+_owner_success_cb(Eo *o EINA_UNUSED, void *data, const Eina_Value v)
+{
+   Future_Data *d = data;
+
+   d->success++;
+   return v;
+}
+
+static Eina_Value
+_owner_error_cb(Eo *o EINA_UNUSED, void *data, Eina_Error err)
+{
+   Future_Data *d = data;
+
+   if (err == ECANCELED) d->cancelled++;
+   return eina_value_error_init(err);
+}
+
+EFL_START_TEST(eo_event_future_scheduler_del_in_dispatch)
+{
+   Eina_Future_Scheduler *sched;
+   Future_Data first = { 0 }, second = { 0 };
+   int errors = 0;
+   Eo *obj, *owner;
+
+   eina_log_print_cb_set(_log_errors_cb, &errors);
+
+   obj = efl_add_ref(efl_test_event_class_get(), NULL);
+   owner = efl_add_ref(efl_test_event_class_get(), NULL);
+   sched = efl_event_future_scheduler_get(obj, _test_scheduler_array());
+
+   // deleting an owner cancels its futures still in the batch
+   first.obj = owner;
+   first.del = EINA_TRUE;
+   eina_future_then(eina_future_resolved(sched, eina_value_int_init(1)),
+                    _future_cancel_other_cb, &first, NULL);
+   efl_future_then(owner, eina_future_resolved(sched, eina_value_int_init(2)),
+                   .success = _owner_success_cb, .error = _owner_error_cb,
+                   .data = &second);
+
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_int_eq(first.success, 1);
+   ck_assert_int_eq(second.success, 0);
+   ck_assert_int_eq(second.cancelled, 1);
+
+   efl_unref(obj);
+
+   eina_log_print_cb_set(eina_log_print_cb_stderr, NULL);
+   ck_assert_int_eq(errors, 0);
+}
+EFL_END_TEST
+
 void eo_test_event(TCase *tc)
 {
    tcase_add_test(tc, eo_event);
    tcase_add_test(tc, eo_event_call_in_call);
    tcase_add_test(tc, eo_event_generation_bug);
    tcase_add_test(tc, eo_event_fowarder_test);
+   tcase_add_test(tc, eo_event_future_scheduler_cancel);
+   tcase_add_test(tc, eo_event_future_scheduler_cancel_in_dispatch);
+   tcase_add_test(tc, eo_event_future_scheduler_del_in_dispatch);
 }
 
 
@@ -0,0 +1,41 @@
+
+void _final_foo(Eo *obj, Final_Data *pd, int a);
+
+EOAPI EFL_VOID_FUNC_BODYV_FINAL(final_foo, FINAL_CLASS, _final_foo, EFL_FUNC_CALL(a), int a);
+
+int _final_bar(const Eo *obj, Final_Data *pd);
+
+EOAPI EFL_FUNC_BODY_CONST_FINAL(final_bar, FINAL_CLASS, _final_bar, int, 0);
+
+static Eina_Bool
+_final_class_initializer(Efl_Class *klass)
+{
+   const Efl_Object_Ops *opsp = NULL;
+
+   const Efl_Object_Property_Reflection_Ops *ropsp = NULL;
+
+#ifndef FINAL_EXTRA_OPS
+#define FINAL_EXTRA_OPS
+#endif
+
+   EFL_OPS_DEFINE(ops,
+      EFL_OBJECT_OP_FUNC(final_foo, _final_foo),
+      EFL_OBJECT_OP_FUNC(final_bar, _final_bar),
+      FINAL_EXTRA_OPS
+   );
+   opsp = &ops;
+
+   return efl_class_functions_set(klass, opsp, ropsp);
+}
+
+static const Efl_Class_Description _final_class_desc = {
+   EO_VERSION,
+   "Final",
+   EFL_CLASS_TYPE_REGULAR,
+   sizeof(Final_Data),
+   _final_class_initializer,
+   NULL,
+   NULL
+};
+
+EFL_DEFINE_CLASS(final_class_get, &_final_class_desc, NULL, NULL);
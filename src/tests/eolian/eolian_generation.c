@@ -228,6 +228,17 @@ EFL_START_TEST(owning)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eolian_final_generation)
+{
+   char output_filepath[PATH_MAX + 128] = "";
+   snprintf(output_filepath, PATH_MAX, "%s/eolian_final",
+            eina_environment_tmp_get());
+   _remove_ref(output_filepath, "eo.c");
+   fail_if(0 != _eolian_gen_execute(TESTS_SRC_DIR"/data/final.eo", "-gc", output_filepath));
+   fail_if(!_files_compare(TESTS_SRC_DIR"/data/final_ref.c", output_filepath, "eo.c"));
+}
+EFL_END_TEST
+
 void eolian_generation_test(TCase *tc)
 {
    tcase_add_test(tc, eolian_types_generation);
@@ -239,4 +250,5 @@ void eolian_generation_test(TCase *tc)
    tcase_add_test(tc, eolian_docs);
    tcase_add_test(tc, eolian_function_pointers);
    tcase_add_test(tc, owning);
+   tcase_add_test(tc, eolian_final_generation);
 }
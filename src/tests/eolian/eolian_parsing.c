@@ -1587,6 +1587,27 @@ EFL_START_TEST(eolian_class_unimpl)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eolian_class_final)
+{
+   const Eolian_Class *class;
+   const Eolian_Unit *unit;
+   Eolian_State *eos = eolian_state_new();
+
+   fail_if(!eolian_state_directory_add(eos, TESTS_SRC_DIR"/data"));
+
+   fail_if(!(unit = eolian_state_file_parse(eos, "final.eo")));
+   fail_if(!(class = eolian_unit_class_by_name_get(unit, "Final")));
+   fail_if(eolian_class_type_get(class) != EOLIAN_CLASS_REGULAR);
+   fail_if(!eolian_class_is_final_get(class));
+
+   fail_if(!(unit = eolian_state_file_parse(eos, "class_simple.eo")));
+   fail_if(!(class = eolian_unit_class_by_name_get(unit, "Class_Simple")));
+   fail_if(eolian_class_is_final_get(class));
+
+   eolian_state_free(eos);
+}
+EFL_END_TEST
+
 EFL_START_TEST(eolian_version)
 {
    Eolian_State *eos = eolian_state_new();
@@ -1629,5 +1650,6 @@ void eolian_parsing_test(TCase *tc)
    tcase_add_test(tc, eolian_mixins_require);
    tcase_add_test(tc, eolian_class_requires_classes);
    tcase_add_test(tc, eolian_class_unimpl);
+   tcase_add_test(tc, eolian_class_final);
    tcase_add_test(tc, eolian_version);
 }
@@ -0,0 +1,76 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <signal.h>
+#include <sys/types.h>
+
+#include "ethumb_client_suite.h"
+#include "../efl_check.h"
+#include <Ethumb_Client.h>
+
+static const Efl_Test_Case etc[] = {
+  { "Ethumb_Client", ethumb_client_test_ethumb_client },
+  { NULL, NULL }
+};
+
+/* The tests spawn ethumbd, which takes org.enlightenment.Ethumb: give them
+ * a bus of their own instead of the session bus of whoever runs them. */
+static pid_t
+_dbus_daemon_start(void)
+{
+   char addr[PATH_MAX], pid[32];
+   FILE *f;
+   int ok;
+
+   f = popen("dbus-daemon --session --fork --print-address=1 --print-pid=1", "r");
+   if (!f) return 0;
+   ok = (fgets(addr, sizeof(addr), f) && fgets(pid, sizeof(pid), f));
+   if ((pclose(f) != 0) || (!ok)) return 0;
+
+   addr[strcspn(addr, "\n")] = '\0';
+   setenv("DBUS_SESSION_BUS_ADDRESS", addr, 1);
+   return atoi(pid);
+}
+
+SUITE_INIT(ethumb_client)
+{
+   ck_assert_int_eq(ethumb_client_init(), 1);
+}
+
+SUITE_SHUTDOWN(ethumb_client)
+{
+   ck_assert_int_eq(ethumb_client_shutdown(), 0);
+}
+
+int
+main(int argc, char **argv)
+{
+   int failed_count;
+   pid_t dbus_pid;
+
+   if (!_efl_test_option_disp(argc, argv, etc))
+     return 0;
+
+#ifdef NEED_RUN_IN_TREE
+   putenv("EFL_RUN_IN_TREE=1");
+#endif
+
+   dbus_pid = _dbus_daemon_start();
+   if (dbus_pid <= 0)
+     {
+        fprintf(stderr, "could not start a private dbus-daemon, skipping\n");
+        return 77;
+     }
+
+   failed_count = _efl_suite_build_and_run(argc - 1, (const char **)argv + 1,
+                                           "Ethumb_Client", etc, SUITE_INIT_FN(ethumb_client), SUITE_SHUTDOWN_FN(ethumb_client));
+
+   kill(dbus_pid, SIGTERM);
+
+   return (failed_count == 0) ? 0 : 255;
+}
@@ -0,0 +1,8 @@
+#ifndef _ETHUMB_CLIENT_SUITE_H
+#define _ETHUMB_CLIENT_SUITE_H
+
+#include <check.h>
+#include "../efl_check.h"
+void ethumb_client_test_ethumb_client(TCase *tc);
+
+#endif /* _ETHUMB_CLIENT_SUITE_H */
@@ -0,0 +1,265 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+#include <Eldbus.h>
+#include <Ethumb_Client.h>
+
+#include "ethumb_client_suite.h"
+
+#define THUMB_COUNT 8
+#define THUMB_SOURCE TESTS_SRC_DIR "/../evas/images/Pic4.png"
+
+typedef struct _Thumb_Test
+{
+   Ethumb_Client *client;
+   Eina_Tmpstr *dir;
+   int ids[THUMB_COUNT];
+   int order[THUMB_COUNT];
+   int generated;
+   int timed;
+} Thumb_Test;
+
+static Ecore_Exe *_ethumbd = NULL;
+static Eina_Bool _connected = EINA_FALSE;
+
+static Eina_Bool
+_timeout(void *data)
+{
+   Ecore_Timer **timer = data;
+
+   *timer = NULL;
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_loop_run(double t)
+{
+   Ecore_Timer *timer;
+
+   timer = ecore_timer_add(t, _timeout, &timer);
+   ecore_main_loop_begin();
+   if (timer) ecore_timer_del(timer);
+}
+
+static void
+_name_owner_changed(void *data, const char *bus EINA_UNUSED,
+                    const char *old_id EINA_UNUSED, const char *new_id)
+{
+   Eina_Bool *owned = data;
+
+   if ((!new_id) || (!new_id[0])) return;
+   *owned = EINA_TRUE;
+   ecore_main_loop_quit();
+}
+
+static void
+_connect_cb(void *data EINA_UNUSED, Ethumb_Client *client EINA_UNUSED,
+            Eina_Bool success)
+{
+   _connected = success;
+   ecore_main_loop_quit();
+}
+
+/* run the daemon of the build tree with a single slave, so that the
+ * thumbnails are generated one at a time in queue order, on the private
+ * session bus started by the suite */
+static void
+_client_setup(Thumb_Test *t)
+{
+   Eldbus_Connection *conn;
+   Eina_Bool owned = EINA_FALSE;
+
+   _ethumbd = ecore_exe_run(ETHUMBD_BIN " -t 30 -s 1", NULL);
+   ck_assert_ptr_ne(_ethumbd, NULL);
+
+   conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
+   ck_assert_ptr_ne(conn, NULL);
+   eldbus_name_owner_changed_callback_add(conn, "org.enlightenment.Ethumb",
+                                          _name_owner_changed, &owned,
+                                          EINA_TRUE);
+   _loop_run(10.0);
+   eldbus_name_owner_changed_callback_del(conn, "org.enlightenment.Ethumb",
+                                          _name_owner_changed, &owned);
+   eldbus_connection_unref(conn);
+   ck_assert(owned);
+
+   _connected = EINA_FALSE;
+   t->client = ethumb_client_connect(_connect_cb, NULL, NULL);
+   ck_assert_ptr_ne(t->client, NULL);
+   _loop_run(10.0);
+   ck_assert(_connected);
+
+   ck_assert(eina_file_mkdtemp("ethumb_client_test_XXXXXX", &t->dir));
+   ck_assert(ethumb_client_file_set(t->client, THUMB_SOURCE, NULL));
+}
+
+static void
+_client_teardown(Thumb_Test *t)
+{
+   char buf[PATH_MAX];
+   int i;
+
+   ethumb_client_disconnect(t->client);
+   ecore_exe_terminate(_ethumbd);
+   ecore_exe_free(_ethumbd);
+   _ethumbd = NULL;
+
+   for (i = 0; i < THUMB_COUNT; i++)
+     {
+        snprintf(buf, sizeof(buf), "%s/thumb%d.png", t->dir, i);
+        unlink(buf);
+     }
+   rmdir(t->dir);
+   eina_tmpstr_del(t->dir);
+}
+
+static void
+_thumb_path_set(Thumb_Test *t, int i)
+{
+   char buf[PATH_MAX];
+
+   snprintf(buf, sizeof(buf), "%s/thumb%d.png", t->dir, i);
+   ethumb_client_thumb_path_set(t->client, buf, NULL);
+}
+
+static int
+_index_find(const Thumb_Test *t, int id)
+{
+   int i;
+
+   for (i = 0; i < THUMB_COUNT; i++)
+     if (t->ids[i] == id) return i;
+   return -1;
+}
+
+static int
+_position_find(const Thumb_Test *t, int idx)
+{
+   int i;
+
+   for (i = 0; i < t->generated; i++)
+     if (t->order[i] == idx) return i;
+   return -1;
+}
+
+static void
+_generated_cb(void *data, Ethumb_Client *client EINA_UNUSED, int id,
+              const char *file EINA_UNUSED, const char *key EINA_UNUSED,
+              const char *thumb_path EINA_UNUSED,
+              const char *thumb_key EINA_UNUSED, Eina_Bool success)
+{
+   Thumb_Test *t = data;
+
+   ck_assert(success);
+   ck_assert_int_ge(_index_find(t, id), 0);
+   t->order[t->generated++] = _index_find(t, id);
+   if ((t->generated == THUMB_COUNT) && (t->timed == THUMB_COUNT))
+     ecore_main_loop_quit();
+}
+
+static void
+_timing_cb(void *data, Ethumb_Client *client EINA_UNUSED, int id,
+           double queued, double generation)
+{
+   Thumb_Test *t = data;
+
+   ck_assert_int_ge(_index_find(t, id), 0);
+   ck_assert(queued >= 0.0);
+   ck_assert(generation >= 0.0);
+   t->timed++;
+   if ((t->generated == THUMB_COUNT) && (t->timed == THUMB_COUNT))
+     ecore_main_loop_quit();
+}
+
+EFL_START_TEST(ethumb_client_test_generate_priority)
+{
+   Thumb_Test t = { 0 };
+   int i;
+
+   _client_setup(&t);
+   ethumb_client_generate_timing_callback_set(t.client, _timing_cb, &t, NULL);
+
+   for (i = 0; i < THUMB_COUNT; i++)
+     {
+        _thumb_path_set(&t, i);
+        t.ids[i] = ethumb_client_generate(t.client, _generated_cb, &t, NULL);
+        ck_assert_int_ge(t.ids[i], 0);
+     }
+   /* the first ones may already be generating, the last ones are not */
+   ethumb_client_generate_priority_set(t.client, t.ids[THUMB_COUNT - 1], 10);
+
+   _loop_run(30.0);
+
+   ck_assert_int_eq(t.generated, THUMB_COUNT);
+   ck_assert_int_eq(t.timed, THUMB_COUNT);
+   ck_assert_int_lt(_position_find(&t, THUMB_COUNT - 1),
+                    _position_find(&t, THUMB_COUNT - 2));
+
+   _client_teardown(&t);
+}
+EFL_END_TEST
+
+typedef struct _Async_Test
+{
+   Thumb_Test *t;
+   int idx;
+} Async_Test;
+
+static void
+_async_done(Ethumb_Client *client EINA_UNUSED, const char *thumb_path EINA_UNUSED,
+            const char *thumb_key EINA_UNUSED, void *data)
+{
+   Async_Test *a = data;
+
+   a->t->order[a->t->generated++] = a->idx;
+   if (a->t->generated == THUMB_COUNT)
+     ecore_main_loop_quit();
+}
+
+static void
+_async_error(Ethumb_Client *client EINA_UNUSED, void *data EINA_UNUSED)
+{
+   ck_abort_msg("thumbnail generation failed");
+}
+
+EFL_START_TEST(ethumb_client_test_async_priority)
+{
+   Async_Test async[THUMB_COUNT];
+   Ethumb_Client_Async *requests[THUMB_COUNT];
+   Thumb_Test t = { 0 };
+   int i;
+
+   _client_setup(&t);
+
+   for (i = 0; i < THUMB_COUNT; i++)
+     {
+        async[i].t = &t;
+        async[i].idx = i;
+        _thumb_path_set(&t, i);
+        requests[i] = ethumb_client_thumb_async_get(t.client, _async_done,
+                                                    _async_error, &async[i]);
+        ck_assert_ptr_ne(requests[i], NULL);
+     }
+   /* nothing left the client yet, so the boosted one goes first */
+   ethumb_client_thumb_async_priority_set(t.client, requests[THUMB_COUNT - 1], 10);
+
+   _loop_run(30.0);
+
+   ck_assert_int_eq(t.generated, THUMB_COUNT);
+   ck_assert_int_eq(t.order[0], THUMB_COUNT - 1);
+
+   _client_teardown(&t);
+}
+EFL_END_TEST
+
+void ethumb_client_test_ethumb_client(TCase *tc)
+{
+   tcase_add_test(tc, ethumb_client_test_generate_priority);
+   tcase_add_test(tc, ethumb_client_test_async_priority);
+}
@@ -5,8 +5,10 @@
 #include <stdio.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <unistd.h>
 
+#include "../../lib/evas/include/evas_common_private.h"
 #include <Evas.h>
 #include <Ecore_Evas.h>
 #include <Ecore.h>
@@ -1204,6 +1206,389 @@ EFL_START_TEST(evas_object_image_load_head_skip)
 }
 EFL_END_TEST
 
+EFL_START_TEST(evas_object_image_cache_revalidate)
+{
+   Evas *e;
+   Evas_Cache_Image *cache;
+   Evas_Image_Load_Opts lo;
+   RGBA_Image *im1, *im2, *im3, *im4;
+   unsigned int hits0, misses0, stats0, hits, misses, stats;
+   const char *img_path;
+   int err;
+
+   e = _setup_evas();
+   img_path = TESTS_IMG_DIR "/Pic1.png";
+
+   cache = evas_common_image_cache_get();
+   ck_assert_ptr_ne(cache, NULL);
+   evas_cache_image_revalidate_set(cache, 3600.0);
+   ck_assert(EINA_DBL_EQ(evas_cache_image_revalidate_get(cache), 3600.0));
+
+   memset(&lo, 0, sizeof(lo));
+   im1 = evas_common_load_image_from_file(img_path, NULL, &lo, &err);
+   ck_assert_int_eq(err, EVAS_LOAD_ERROR_NONE);
+   ck_assert_ptr_ne(im1, NULL);
+   evas_cache_image_stats_get(cache, &hits0, &misses0, &stats0);
+
+   /* the file was just checked, it is trusted without stat() */
+   im2 = evas_common_load_image_from_file(img_path, NULL, &lo, &err);
+   ck_assert_ptr_eq(im1, im2);
+   evas_cache_image_stats_get(cache, &hits, &misses, &stats);
+   ck_assert_int_eq(hits, hits0 + 1);
+   ck_assert_int_eq(misses, misses0);
+   ck_assert_int_eq(stats, stats0);
+
+   /* once invalidated the next request checks the file again */
+   evas_cache_image_file_invalidate(cache, img_path);
+   im3 = evas_common_load_image_from_file(img_path, NULL, &lo, &err);
+   ck_assert_ptr_eq(im1, im3);
+   evas_cache_image_stats_get(cache, &hits, &misses, &stats);
+   ck_assert_int_eq(hits, hits0 + 2);
+   ck_assert_int_eq(stats, stats0 + 1);
+
+   /* without an interval every request checks the file again */
+   evas_cache_image_revalidate_set(cache, 0.0);
+   evas_cache_image_drop(&im3->cache_entry);
+   im3 = evas_common_load_image_from_file(img_path, NULL, &lo, &err);
+   ck_assert_ptr_eq(im1, im3);
+   evas_cache_image_stats_get(cache, &hits, &misses, &stats);
+   ck_assert_int_eq(hits, hits0 + 3);
+   ck_assert_int_eq(stats, stats0 + 2);
+
+   /* load options are part of the key */
+   lo.emile.scale_down_by = 2;
+   im4 = evas_common_load_image_from_file(img_path, NULL, &lo, &err);
+   ck_assert_ptr_ne(im4, NULL);
+   ck_assert_ptr_ne(im1, im4);
+   evas_cache_image_stats_get(cache, &hits, &misses, &stats);
+   ck_assert_int_eq(misses, misses0 + 1);
+
+   evas_cache_image_drop(&im4->cache_entry);
+   evas_cache_image_drop(&im3->cache_entry);
+   evas_cache_image_drop(&im2->cache_entry);
+   evas_cache_image_drop(&im1->cache_entry);
+   evas_cache_image_revalidate_set(cache, 0.0);
+
+   evas_free(e);
+}
+EFL_END_TEST
+
+EFL_START_TEST(evas_object_image_cache_monitor)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+   Evas *e;
+   Evas_Cache_Image *cache;
+   Evas_Image_Load_Opts lo;
+   RGBA_Image *im1, *im2;
+   unsigned int hits0, misses0, stats0, hits, misses, stats;
+   struct timeval tv[2] = { { 1000000, 0 }, { 1000000, 0 } };
+   Eina_Tmpstr *tmp;
+   Eina_File *f;
+   void *map;
+   int fd, err;
+
+   e = _setup_evas();
+
+   /* a copy of an image that can be changed */
+   f = eina_file_open(TESTS_IMG_DIR "/Pic1.png", EINA_FALSE);
+   ck_assert_ptr_ne(f, NULL);
+   map = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+   ck_assert_ptr_ne(map, NULL);
+   fd = eina_file_mkstemp("evas-test-monitor.XXXXXX.png", &tmp);
+   ck_assert_int_ge(fd, 0);
+   ck_assert_int_eq(write(fd, map, eina_file_size_get(f)), (int)eina_file_size_get(f));
+   close(fd);
+   eina_file_map_free(f, map);
+   eina_file_close(f);
+
+   cache = evas_common_image_cache_get();
+   ck_assert_ptr_ne(cache, NULL);
+   evas_cache_image_revalidate_set(cache, 3600.0);
+
+   memset(&lo, 0, sizeof(lo));
+   im1 = evas_common_load_image_from_file(tmp, NULL, &lo, &err);
+   ck_assert_int_eq(err, EVAS_LOAD_ERROR_NONE);
+   ck_assert_ptr_ne(im1, NULL);
+   evas_cache_image_stats_get(cache, &hits0, &misses0, &stats0);
+
+   /* a change on disk is seen before the interval is over */
+   ck_assert_int_eq(utimes(tmp, tv), 0);
+   ecore_main_loop_iterate();
+   im2 = evas_common_load_image_from_file(tmp, NULL, &lo, &err);
+   ck_assert_ptr_ne(im2, NULL);
+   ck_assert_ptr_ne(im1, im2);
+   evas_cache_image_stats_get(cache, &hits, &misses, &stats);
+   ck_assert_int_eq(stats, stats0 + 1);
+   ck_assert_int_eq(misses, misses0 + 1);
+   ck_assert_int_eq(hits, hits0);
+
+   evas_cache_image_drop(&im2->cache_entry);
+   evas_cache_image_drop(&im1->cache_entry);
+   evas_cache_image_revalidate_set(cache, 0.0);
+   unlink(tmp);
+   eina_tmpstr_del(tmp);
+
+   evas_free(e);
+#endif
+}
+EFL_END_TEST
+
+static void
+_smooth_scale_bands_check(RGBA_Image *src, int dw, int dh)
+{
+   RGBA_Image *whole, *bands;
+   int y;
+
+   whole = evas_common_image_new(dw, dh, 1);
+   bands = evas_common_image_new(dw, dh, 1);
+   ck_assert_ptr_ne(whole, NULL);
+   ck_assert_ptr_ne(bands, NULL);
+
+   /* large enough to be split between the scaling threads */
+   evas_common_scale_rgba_smooth_draw(src, whole, 0, 0, dw, dh,
+                                      0xffffffff, EVAS_RENDER_COPY,
+                                      0, 0, src->cache_entry.w, src->cache_entry.h,
+                                      0, 0, dw, dh, NULL, 0, 0);
+   /* small bands are always scaled by the calling thread */
+   for (y = 0; y < dh; y += 17)
+     evas_common_scale_rgba_smooth_draw(src, bands, 0, y, dw, MIN(17, dh - y),
+                                        0xffffffff, EVAS_RENDER_COPY,
+                                        0, 0, src->cache_entry.w, src->cache_entry.h,
+                                        0, 0, dw, dh, NULL, 0, 0);
+   ck_assert(!memcmp(whole->image.data, bands->image.data, dw * dh * sizeof (DATA32)));
+
+   evas_cache_image_drop(&bands->cache_entry);
+   evas_cache_image_drop(&whole->cache_entry);
+}
+
+EFL_START_TEST(evas_object_image_smooth_scale_bands)
+{
+   Evas *e;
+   RGBA_Image *src;
+   int i;
+
+   e = _setup_evas();
+
+   src = evas_common_image_new(1200, 800, 1);
+   ck_assert_ptr_ne(src, NULL);
+   for (i = 0; i < 1200 * 800; i++)
+     {
+        DATA32 a = (i * 13) & 0xff;
+
+        src->image.data[i] = (a << 24) | (((i * 7) % (a + 1)) << 16) |
+          (((i >> 2) % (a + 1)) << 8) | ((i ^ (i >> 5)) % (a + 1));
+     }
+
+   /* upscale, box downscale and bilinear downscale */
+   _smooth_scale_bands_check(src, 1501, 1003);
+   _smooth_scale_bands_check(src, 401, 263);
+   _smooth_scale_bands_check(src, 803, 601);
+
+   evas_cache_image_drop(&src->cache_entry);
+   evas_free(e);
+}
+EFL_END_TEST
+
+EFL_START_TEST(evas_object_image_map_mipmaps)
+{
+   Evas *e;
+   RGBA_Image *src, *dst;
+   RGBA_Map_Point p[4];
+   int i, x, y;
+
+   e = _setup_evas();
+
+   /* a 1 pixel checkerboard shrunk 8 times: plain bilinear only hits
+    * black or white pixels, the cached mipmap averages to grey */
+   src = evas_common_image_new(1024, 1024, 0);
+   dst = evas_common_image_new(128, 128, 0);
+   ck_assert_ptr_ne(src, NULL);
+   ck_assert_ptr_ne(dst, NULL);
+   for (y = 0; y < 1024; y++)
+     for (x = 0; x < 1024; x++)
+       src->image.data[(y * 1024) + x] = ((x ^ y) & 1) ? 0xffffffff : 0xff000000;
+
+   memset(p, 0, sizeof(p));
+   for (i = 0; i < 4; i++)
+     {
+        p[i].x = (((i == 1) || (i == 2)) ? 128 : 0) << FP;
+        p[i].y = ((i < 2) ? 0 : 128) << FP;
+        p[i].u = (((i == 1) || (i == 2)) ? 1024 : 0) << FP;
+        p[i].v = ((i < 2) ? 0 : 1024) << FP;
+        p[i].col = 0xffffffff;
+     }
+
+   /* levels are only cached once used often enough */
+   for (i = 0; i < 4; i++)
+     evas_common_map_rgba_draw(src, dst, 0, 0, 128, 128,
+                               0xffffffff, EVAS_RENDER_COPY,
+                               4, p, 1, EINA_FALSE, 0, NULL, 0, 0);
+
+   for (y = 8; y < 120; y += 7)
+     for (x = 8; x < 120; x += 7)
+       {
+          DATA32 c = dst->image.data[(y * 128) + x];
+
+          ck_assert_int_ge(c & 0xff, 0x70);
+          ck_assert_int_le(c & 0xff, 0x90);
+       }
+
+   evas_cache_image_drop(&dst->cache_entry);
+   evas_cache_image_drop(&src->cache_entry);
+   evas_free(e);
+}
+EFL_END_TEST
+
+#ifdef BUILD_SSE3
+static void
+_smooth_scale_sse3_check(RGBA_Image *src, int dw, int dh)
+{
+   RGBA_Draw_Context *dc;
+   RGBA_Image *c, *sse3;
+   int i;
+
+   c = evas_common_image_new(dw, dh, 1);
+   sse3 = evas_common_image_new(dw, dh, 1);
+   ck_assert_ptr_ne(c, NULL);
+   ck_assert_ptr_ne(sse3, NULL);
+   dc = evas_common_draw_context_new();
+   evas_common_draw_context_set_render_op(dc, EVAS_RENDER_COPY);
+
+   evas_common_scale_rgba_in_to_out_clip_smooth_c(src, c, dc, 0, 0,
+                                                  src->cache_entry.w, src->cache_entry.h,
+                                                  0, 0, dw, dh);
+   evas_common_scale_rgba_in_to_out_clip_smooth_sse3(src, sse3, dc, 0, 0,
+                                                     src->cache_entry.w, src->cache_entry.h,
+                                                     0, 0, dw, dh);
+   for (i = 0; i < dw * dh; i++)
+     ck_assert_msg(c->image.data[i] == sse3->image.data[i],
+                   "%dx%d: pixel %d,%d is %08x with C but %08x with SSE3",
+                   dw, dh, i % dw, i / dw, c->image.data[i], sse3->image.data[i]);
+
+   evas_common_draw_context_free(dc);
+   evas_cache_image_drop(&sse3->cache_entry);
+   evas_cache_image_drop(&c->cache_entry);
+}
+#endif
+
+EFL_START_TEST(evas_object_image_smooth_scale_sse3)
+{
+#ifdef BUILD_SSE3
+   Evas *e;
+   RGBA_Image *src;
+   int i;
+
+   if (!(eina_cpu_features_get() & EINA_CPU_SSE3)) return;
+
+   e = _setup_evas();
+
+   src = evas_common_image_new(1200, 800, 1);
+   ck_assert_ptr_ne(src, NULL);
+   for (i = 0; i < 1200 * 800; i++)
+     {
+        DATA32 a = (i * 13) & 0xff;
+
+        src->image.data[i] = (a << 24) | (((i * 7) % (a + 1)) << 16) |
+          (((i >> 2) % (a + 1)) << 8) | ((i ^ (i >> 5)) % (a + 1));
+     }
+
+   /* upscale, box downscale and bilinear downscale, with alpha */
+   _smooth_scale_sse3_check(src, 1501, 1003);
+   _smooth_scale_sse3_check(src, 401, 263);
+   _smooth_scale_sse3_check(src, 803, 601);
+
+   /* and the opaque variants */
+   for (i = 0; i < 1200 * 800; i++)
+     src->image.data[i] |= 0xff000000;
+   src->cache_entry.flags.alpha = 0;
+   _smooth_scale_sse3_check(src, 1501, 1003);
+   _smooth_scale_sse3_check(src, 401, 263);
+   _smooth_scale_sse3_check(src, 803, 601);
+
+   evas_cache_image_drop(&src->cache_entry);
+   evas_free(e);
+#endif
+}
+EFL_END_TEST
+
+#if defined(BUILD_SSE3) || defined(BUILD_NEON_INTRINSICS)
+typedef void (*Yuv_Convert)(DATA8 **src, DATA8 *dst, int w, int h);
+
+static void
+_yuv_convert_check(Evas_Colorspace cspace, Yuv_Convert convert, int w, int h)
+{
+   DATA8 *planes, **rows;
+   DATA32 *simd, *c;
+   int i, n = 0;
+
+   planes = malloc(w * h * 2);
+   rows = malloc(sizeof (DATA8 *) * h * 2);
+   simd = calloc(w * h, sizeof (DATA32));
+   c = calloc(w * h, sizeof (DATA32));
+   ck_assert_ptr_ne(planes, NULL);
+   ck_assert_ptr_ne(rows, NULL);
+   ck_assert_ptr_ne(simd, NULL);
+   ck_assert_ptr_ne(c, NULL);
+
+   for (i = 0; i < w * h * 2; i++)
+     planes[i] = (i * 7) ^ (i >> 5) ^ (i * i >> 11);
+
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_YCBCR422601_PL:
+         for (i = 0; i < h; i++) rows[n++] = planes + (i * w * 2);
+         break;
+      case EVAS_COLORSPACE_YCBCR420NV12601_PL:
+         for (i = 0; i < h; i++) rows[n++] = planes + (i * w);
+         for (i = 0; i < h / 2; i++) rows[n++] = planes + (w * h) + (i * w);
+         break;
+      default:
+         for (i = 0; i < h; i++) rows[n++] = planes + (i * w);
+         for (i = 0; i < h; i++) rows[n++] = planes + (w * h) + (i * w / 2);
+         break;
+     }
+
+   convert(rows, (DATA8 *)simd, w, h);
+   evas_common_convert_yuv_reference(cspace, rows, (DATA8 *)c, w, h);
+   for (i = 0; i < w * h; i++)
+     ck_assert_msg(simd[i] == c[i], "%dx%d: pixel %d,%d is %08x but %08x with C",
+                   w, h, i % w, i / w, simd[i], c[i]);
+
+   free(c);
+   free(simd);
+   free(rows);
+   free(planes);
+}
+#endif
+
+EFL_START_TEST(evas_object_image_yuv_convert_simd)
+{
+#if defined(BUILD_SSE3) || defined(BUILD_NEON_INTRINSICS)
+   /* small, with row tails, and big enough to be split between threads */
+   static const int sizes[][2] = { { 64, 48 }, { 18, 10 }, { 334, 242 }, { 640, 480 } };
+   unsigned int i;
+
+   if (!(eina_cpu_features_get() & (EINA_CPU_SSE3 | EINA_CPU_NEON))) return;
+
+   evas_common_cpu_init();
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     {
+        int w = sizes[i][0], h = sizes[i][1];
+
+        _yuv_convert_check(EVAS_COLORSPACE_YCBCR422P601_PL,
+                           evas_common_convert_yuv_422p_601_rgba, w, h);
+        _yuv_convert_check(EVAS_COLORSPACE_YCBCR422P709_PL,
+                           evas_common_convert_yuv_422p_709_rgba, w, h);
+        _yuv_convert_check(EVAS_COLORSPACE_YCBCR422601_PL,
+                           evas_common_convert_yuv_422_601_rgba, w, h);
+        _yuv_convert_check(EVAS_COLORSPACE_YCBCR420NV12601_PL,
+                           evas_common_convert_yuv_420_601_rgba, w, h);
+     }
+#endif
+}
+EFL_END_TEST
+
 void evas_test_image_object(TCase *tc)
 {
    tcase_add_test(tc, evas_object_image_api);
@@ -1232,6 +1617,12 @@ void evas_test_image_object(TCase *tc)
    tcase_add_test(tc, evas_object_image_9patch);
    tcase_add_test(tc, evas_object_image_save_from_proxy);
    tcase_add_test(tc, evas_object_image_load_head_skip);
+   tcase_add_test(tc, evas_object_image_cache_revalidate);
+   tcase_add_test(tc, evas_object_image_cache_monitor);
+   tcase_add_test(tc, evas_object_image_smooth_scale_bands);
+   tcase_add_test(tc, evas_object_image_smooth_scale_sse3);
+   tcase_add_test(tc, evas_object_image_yuv_convert_simd);
+   tcase_add_test(tc, evas_object_image_map_mipmaps);
 }
 
 
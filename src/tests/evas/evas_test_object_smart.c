@@ -8,6 +8,7 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <Eina.h>
 #include <Evas.h>
@@ -213,8 +214,104 @@ EFL_START_TEST(evas_object_smart_clipped_smart_move)
 }
 EFL_END_TEST
 
+#ifdef BUILD_ENGINE_BUFFER
+#define CULL_W 100
+#define CULL_H 100
+
+static unsigned int
+_cull_pixel_get(Ecore_Evas *ee, int x, int y)
+{
+   const unsigned int *pixels = ecore_evas_buffer_pixels_get(ee);
+
+   fail_if(!pixels);
+   return pixels[x + (y * CULL_W)];
+}
+
+static Evas_Object *
+_cull_rect_add(Evas *e, Evas_Object *parent, int x, int y, int w, int h,
+               int r, int g, int b)
+{
+   Evas_Object *o = evas_object_rectangle_add(e);
+
+   evas_object_color_set(o, r, g, b, 255);
+   evas_object_geometry_set(o, x, y, w, h);
+   evas_object_show(o);
+   evas_object_smart_member_add(o, parent);
+   return o;
+}
+
+static Evas_Object *
+_cull_smart_add(Evas *e, Evas_Smart *smart, Evas_Object *parent,
+                int x, int y, int w, int h)
+{
+   Evas_Object *o = evas_object_smart_add(e, smart);
+
+   evas_object_geometry_set(o, x, y, w, h);
+   evas_object_show(o);
+   if (parent) evas_object_smart_member_add(o, parent);
+   return o;
+}
+
+/* Smart members are not clipped to their parent, so a subtree can draw far
+ * away from its smart object geometry. Culling must use the area covered by
+ * the members, including nested ones, to decide what to skip. */
+EFL_START_TEST(evas_object_smart_subtree_cull)
+{
+   Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION("SubtreeCull");
+   Evas_Object *below, *above, *nested, *under, *far;
+   Evas_Smart *smart;
+   Ecore_Evas *ee;
+   Evas *e;
+
+   /* culling is opt-in, read when the canvas is created */
+   setenv("EVAS_RENDER_SUBTREE_CULL", "1", 1);
+   ee = ecore_evas_buffer_new(CULL_W, CULL_H);
+   unsetenv("EVAS_RENDER_SUBTREE_CULL");
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   smart = evas_smart_class_new(&sc);
+   fail_if(!smart);
+
+   below = _cull_smart_add(e, smart, NULL, 50, 50, 50, 50);
+   under = _cull_rect_add(e, below, 50, 50, 50, 50, 0, 0, 255);
+   above = _cull_smart_add(e, smart, NULL, 0, 0, 10, 10);
+   nested = _cull_smart_add(e, smart, above, 0, 0, 10, 10);
+   far = _cull_rect_add(e, nested, 60, 60, 20, 20, 0, 255, 0);
+
+   ecore_evas_manual_render(ee);
+   ck_assert_int_eq(_cull_pixel_get(ee, 55, 55), 0xff0000ff);
+   ck_assert_int_eq(_cull_pixel_get(ee, 70, 70), 0xff00ff00);
+
+   /* damage below only, far still has to be drawn on top of it */
+   evas_object_color_set(under, 255, 0, 0, 255);
+   ecore_evas_manual_render(ee);
+   ck_assert_int_eq(_cull_pixel_get(ee, 55, 55), 0xffff0000);
+   ck_assert_int_eq(_cull_pixel_get(ee, 70, 70), 0xff00ff00);
+
+   /* once far moves away, the subtree area follows it */
+   evas_object_move(far, 0, 60);
+   ecore_evas_manual_render(ee);
+   ck_assert_int_eq(_cull_pixel_get(ee, 70, 70), 0xffff0000);
+   ck_assert_int_eq(_cull_pixel_get(ee, 5, 65), 0xff00ff00);
+
+   evas_object_color_set(under, 0, 0, 255, 255);
+   ecore_evas_manual_render(ee);
+   ck_assert_int_eq(_cull_pixel_get(ee, 70, 70), 0xff0000ff);
+   ck_assert_int_eq(_cull_pixel_get(ee, 5, 65), 0xff00ff00);
+
+   ecore_evas_free(ee);
+   evas_smart_free(smart);
+}
+EFL_END_TEST
+#endif
+
 void evas_test_object_smart(TCase *tc)
 {
    tcase_add_test(tc, evas_object_smart_paragraph_direction);
    tcase_add_test(tc, evas_object_smart_clipped_smart_move);
+#ifdef BUILD_ENGINE_BUFFER
+   tcase_add_test(tc, evas_object_smart_subtree_cull);
+#endif
 }